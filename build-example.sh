@@ -43,6 +43,15 @@ for f in $sources; do
     # example/imageviewer is unusual in that needs additional libraries.
     echo "Building gen/bin/example-$f"
     $CC -O3 example/$f/*.c -lxcb -lxcb-image -o gen/bin/example-$f
+  elif [ $f = adler32 ] || [ $f = crc32 ]; then
+    # example/adler32 and example/crc32 are unusual in that their -threads=N
+    # flag uses std::thread.
+    echo "Building gen/bin/example-$f"
+    $CXX -O3 example/$f/*.cc -pthread -o gen/bin/example-$f
+  elif [ $f = zcat ]; then
+    # example/zcat is unusual in that its -threads=N flag uses pthreads.
+    echo "Building gen/bin/example-$f"
+    $CC -O3 example/$f/*.c -pthread -o gen/bin/example-$f
   elif [ $f = library ]; then
     # example/library is unusual in that it uses separately compiled libraries
     # (built by "wuffs genlib", e.g. by running build-all.sh) instead of
@@ -0,0 +1,226 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+adler32 prints the Adler-32 checksum of stdin.
+
+This example program differs from most other example Wuffs programs in that it
+is written in C++, not C.
+
+$CXX adler32.cc -pthread && ./a.out < ../../README.md; rm -f a.out
+
+for a C++ compiler $CXX, such as clang++ or g++.
+
+By default, stdin is hashed incrementally, as it is read. With the -threads=N
+flag (for N greater than 1), all of stdin is read into memory and then split
+into N contiguous chunks, each hashed on its own thread. The per-chunk
+checksums are merged by wuffs_adler32__hasher::combine. The same technique can
+verify the Adler-32 trailer of a large, already-decompressed zlib stream.
+*/
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <thread>
+#include <vector>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__STATIC_FUNCTIONS macro is optional, but it
+// demonstrates making all of Wuffs' functions have static storage. The
+// motivation is discussed in the "ALLOW STATIC IMPLEMENTATION" section of
+// https://raw.githubusercontent.com/nothings/stb/master/docs/stb_howto.txt
+#define WUFFS_CONFIG__STATIC_FUNCTIONS
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C++ file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (32 * 1024)
+#endif
+
+// MAX_THREADS is an arbitrary upper bound on the -threads=N flag value.
+#ifndef MAX_THREADS
+#define MAX_THREADS 1024
+#endif
+
+uint8_t src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
+
+struct {
+  size_t threads;
+} flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  flags.threads = 1;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      unsigned long n = strtoul(arg + 8, &end, 10);
+      if ((end == arg + 8) || (*end != '\x00') || (n < 1) ||
+          (n > MAX_THREADS)) {
+        return "main: bad -threads=N flag value";
+      }
+      flags.threads = n;
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  if (c != argc) {
+    return "main: unexpected non-flag argument";
+  }
+  return NULL;
+}
+
+// parallel_adler32 returns the Adler-32 checksum of the len bytes at ptr,
+// splitting the work into num_threads contiguous chunks, each hashed on its own
+// thread. The per-chunk checksums are then merged, in order, by
+// wuffs_adler32__hasher::combine.
+//
+// It returns false if a hasher could not be initialized.
+bool  //
+parallel_adler32(uint32_t* checksum,
+                 const uint8_t* ptr,
+                 size_t len,
+                 size_t num_threads) {
+  if (num_threads < 1) {
+    num_threads = 1;
+  }
+  size_t chunk_len = (len + num_threads - 1) / num_threads;
+
+  std::vector<wuffs_adler32__hasher> hashers(num_threads);
+  std::vector<uint32_t> checksums(num_threads);
+  for (size_t i = 0; i < num_threads; i++) {
+    wuffs_base__status status =
+        hashers[i].initialize(sizeof hashers[i], WUFFS_VERSION, 0);
+    if (!status.is_ok()) {
+      return false;
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; i++) {
+    size_t i0 = wuffs_base__u64__min(len, i * chunk_len);
+    size_t i1 = wuffs_base__u64__min(len, i0 + chunk_len);
+    threads.emplace_back([&hashers, &checksums, ptr, i, i0, i1]() {
+      checksums[i] = hashers[i].update_u32(
+          wuffs_base__make_slice_u8(const_cast<uint8_t*>(ptr + i0), i1 - i0));
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  // The Adler-32 checksum of the empty string is 1, not 0.
+  uint32_t ret = 1;
+  for (size_t i = 0; i < num_threads; i++) {
+    size_t i0 = wuffs_base__u64__min(len, i * chunk_len);
+    size_t i1 = wuffs_base__u64__min(len, i0 + chunk_len);
+    ret = hashers[0].combine(ret, checksums[i], i1 - i0);
+  }
+  *checksum = ret;
+  return true;
+}
+
+const char*  //
+main_serial() {
+  wuffs_adler32__hasher h;
+  wuffs_base__status status = h.initialize(sizeof h, WUFFS_VERSION, 0);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+
+  while (true) {
+    size_t n =
+        fread(src_buffer_array, sizeof(uint8_t), SRC_BUFFER_ARRAY_SIZE, stdin);
+    uint32_t checksum =
+        h.update_u32(wuffs_base__make_slice_u8(src_buffer_array, n));
+    if (feof(stdin)) {
+      printf("%08" PRIx32 "\n", checksum);
+      return NULL;
+    } else if (ferror(stdin)) {
+      return "main: read error";
+    }
+  }
+}
+
+const char*  //
+main_parallel() {
+  std::vector<uint8_t> data;
+  while (true) {
+    size_t n =
+        fread(src_buffer_array, sizeof(uint8_t), SRC_BUFFER_ARRAY_SIZE, stdin);
+    data.insert(data.end(), src_buffer_array, src_buffer_array + n);
+    if (feof(stdin)) {
+      break;
+    } else if (ferror(stdin)) {
+      return "main: read error";
+    }
+  }
+
+  uint32_t checksum = 0;
+  if (!parallel_adler32(&checksum, data.data(), data.size(), flags.threads)) {
+    return "main: could not initialize hasher";
+  }
+  printf("%08" PRIx32 "\n", checksum);
+  return NULL;
+}
+
+int  //
+main(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (!z) {
+    z = (flags.threads > 1) ? main_parallel() : main_serial();
+  }
+  if (z) {
+    fprintf(stderr, "%s\n", z);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,585 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+/*
+gzindex builds and uses a random access index for gzip'ed data, similar to
+zlib's examples/zran.c program. Extracting a range of the decompressed data
+then only decodes from the nearest checkpoint at or before that range, instead
+of from the start of the gzip'ed data.
+
+Building an index decodes all of stdin once, writing the index to stdout:
+
+$CC gzindex.c && ./a.out -build < ../../test/data/pi.txt.gz > /tmp/pi.gzi
+
+Using an index writes -length bytes, starting at -offset bytes into the
+decompressed data, to stdout. stdin must be seekable (e.g. a regular file, not
+a pipe):
+
+./a.out -offset=50000 -length=20 /tmp/pi.gzi < ../../test/data/pi.txt.gz
+
+for a C compiler $CC, such as clang or gcc.
+
+A checkpoint is made at a deflate block boundary (see the deflate decoder's
+set_report_block_boundaries method), once at least -spacing bytes (1 MiB by
+default) of decompressed data have passed since the previous checkpoint. For
+multi-member gzip'ed data (e.g. concatenated .gz files), a checkpoint is also
+made at the start of every member other than the first. The index file is a
+sequence of checkpoints, in increasing offset order, with no header. Each
+checkpoint is, with integers in little-endian order:
+
+ - 8 bytes: the "src position", the checkpoint's offset in the gzip'ed data.
+ - 8 bytes: the "dst position", the checkpoint's offset in the decompressed
+   data.
+ - 1 byte:  n_held_bits, a number in the range [0 ..= 7], or 0x80 for a
+   member start checkpoint.
+ - 1 byte:  held_bits, the low n_held_bits bits of which (the high bits of the
+   byte just before the src position) start the next deflate block.
+ - 2 bytes: the window length, W, a number in the range [0 ..= 32768].
+ - W bytes: the window, the W bytes of decompressed data before the dst
+   position.
+
+A member start checkpoint's src position is that of the member's gzip header.
+Its held_bits and W are both zero, as each member starts with an empty window.
+
+Unlike zcat, this program does not self-impose a SECCOMP_MODE_STRICT sandbox,
+as it needs to open the index file and to seek stdin.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c whitelist which parts of Wuffs to build. That file contains
+// the entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__DEFLATE
+#define WUFFS_CONFIG__MODULE__GZIP
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../release/c/wuffs-unsupported-snapshot.c"
+
+#ifndef DST_BUFFER_ARRAY_SIZE
+#define DST_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+#ifndef SRC_BUFFER_ARRAY_SIZE
+#define SRC_BUFFER_ARRAY_SIZE (128 * 1024)
+#endif
+#define WINDOW_ARRAY_SIZE (32 * 1024)
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+
+uint8_t dst_buffer_array[DST_BUFFER_ARRAY_SIZE];
+uint8_t src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
+uint8_t window_array[WINDOW_ARRAY_SIZE];
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t work_buffer_array[1];
+#endif
+
+// A checkpoint's fixed size part is 8 + 8 + 1 + 1 + 2 = 20 bytes.
+#define CHECKPOINT_HEADER_SIZE 20
+
+// MEMBER_START is the n_held_bits byte value of a member start checkpoint.
+#define MEMBER_START 0x80
+
+// ----
+
+struct {
+  int remaining_argc;
+  char** remaining_argv;
+
+  bool build;
+  uint64_t length;
+  uint64_t offset;
+  uint64_t spacing;
+} flags = {0};
+
+const char*  //
+parse_flags(int argc, char** argv) {
+  flags.spacing = 1024 * 1024;
+
+  int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
+  for (; c < argc; c++) {
+    char* arg = argv[c];
+    if (*arg++ != '-') {
+      break;
+    }
+
+    // A double-dash "--foo" is equivalent to a single-dash "-foo". As special
+    // cases, a bare "-" is not a flag (some programs may interpret it as
+    // stdin) and a bare "--" means to stop parsing flags.
+    if (*arg == '\x00') {
+      break;
+    } else if (*arg == '-') {
+      arg++;
+      if (*arg == '\x00') {
+        c++;
+        break;
+      }
+    }
+
+    if (!strcmp(arg, "build")) {
+      flags.build = true;
+      continue;
+    }
+    if (!strncmp(arg, "length=", 7)) {
+      flags.length = strtoull(arg + 7, NULL, 10);
+      continue;
+    }
+    if (!strncmp(arg, "offset=", 7)) {
+      flags.offset = strtoull(arg + 7, NULL, 10);
+      continue;
+    }
+    if (!strncmp(arg, "spacing=", 8)) {
+      flags.spacing = strtoull(arg + 8, NULL, 10);
+      continue;
+    }
+
+    return "main: unrecognized flag argument";
+  }
+
+  flags.remaining_argc = argc - c;
+  flags.remaining_argv = argv + c;
+  return NULL;
+}
+
+// ----
+
+// ignore_return_value suppresses errors from -Wall -Werror.
+static void  //
+ignore_return_value(int ignored) {}
+
+const char*  //
+read_fully(int fd, uint8_t* ptr, size_t len, bool* eof) {
+  size_t n_read = 0;
+  while (n_read < len) {
+    ssize_t n = read(fd, ptr + n_read, len - n_read);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    } else if (n == 0) {
+      if ((n_read == 0) && eof) {
+        *eof = true;
+        return NULL;
+      }
+      return "main: invalid index file (truncated checkpoint)";
+    }
+    n_read += n;
+  }
+  return NULL;
+}
+
+const char*  //
+write_fully(int fd, const uint8_t* ptr, size_t len) {
+  while (len > 0) {
+    ssize_t n = write(fd, ptr, len);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    ptr += n;
+    len -= n;
+  }
+  return NULL;
+}
+
+// read_src reads from stdin into src, compacting it first. It marks src as
+// closed when stdin is exhausted.
+const char*  //
+read_src(wuffs_base__io_buffer* src) {
+  wuffs_base__io_buffer__compact(src);
+  if (src->meta.wi == src->data.len) {
+    return "main: internal error: no I/O progress possible";
+  }
+  while (true) {
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, src->data.ptr + src->meta.wi,
+                     src->data.len - src->meta.wi);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    src->meta.wi += n;
+    if (n == 0) {
+      src->meta.closed = true;
+    }
+    return NULL;
+  }
+}
+
+// write_checkpoint writes a checkpoint for dec's current state or, if
+// member_start, for the start of the gzip member at src_pos.
+const char*  //
+write_checkpoint(wuffs_gzip__decoder* dec,
+                 uint64_t src_pos,
+                 uint64_t dst_pos,
+                 bool member_start) {
+  uint64_t w = 0;
+  uint8_t header[CHECKPOINT_HEADER_SIZE];
+  wuffs_base__store_u64le__no_bounds_check(header + 0, src_pos);
+  wuffs_base__store_u64le__no_bounds_check(header + 8, dst_pos);
+  if (member_start) {
+    header[16] = MEMBER_START;
+    header[17] = 0;
+  } else {
+    w = wuffs_gzip__decoder__copy_history(
+        dec, wuffs_base__make_slice_u8(window_array, WINDOW_ARRAY_SIZE));
+    header[16] = (uint8_t)(wuffs_gzip__decoder__n_held_bits(dec));
+    header[17] = (uint8_t)(wuffs_gzip__decoder__held_bits(dec));
+  }
+  wuffs_base__store_u16le__no_bounds_check(header + 18, (uint16_t)w);
+
+  const int stdout_fd = 1;
+  const char* z = write_fully(stdout_fd, header, CHECKPOINT_HEADER_SIZE);
+  if (z) {
+    return z;
+  }
+  return write_fully(stdout_fd, window_array, w);
+}
+
+const char*  //
+build(wuffs_base__io_buffer* dst, wuffs_base__io_buffer* src) {
+  wuffs_gzip__decoder dec;
+  wuffs_base__status status =
+      wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_gzip__decoder__set_multi_member(&dec, true);
+  wuffs_gzip__decoder__set_report_block_boundaries(&dec, true);
+  wuffs_gzip__decoder__set_report_member_boundaries(&dec, true);
+
+  uint64_t prev_dst_pos = 0;
+  while (true) {
+    status = wuffs_gzip__decoder__transform_io(
+        &dec, dst, src,
+        wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+
+    bool member_start = status.repr == wuffs_gzip__suspension__member_boundary;
+    if (member_start ||
+        (status.repr == wuffs_deflate__suspension__block_boundary)) {
+      uint64_t src_pos = wuffs_base__io_buffer__reader_io_position(src);
+      uint64_t dst_pos = wuffs_base__io_buffer__writer_io_position(dst);
+      if (member_start || ((dst_pos - prev_dst_pos) >= flags.spacing)) {
+        const char* z = write_checkpoint(&dec, src_pos, dst_pos, member_start);
+        if (z) {
+          return z;
+        }
+        prev_dst_pos = dst_pos;
+      }
+    }
+
+    // This program only indexes the decompressed data. Discard it.
+    dst->meta.ri = dst->meta.wi;
+    wuffs_base__io_buffer__compact(dst);
+
+    if (status.repr == wuffs_base__suspension__short_read) {
+      const char* z = read_src(src);
+      if (z) {
+        return z;
+      }
+    } else if (!wuffs_base__status__is_suspension(&status)) {
+      return wuffs_base__status__message(&status);
+    }
+  }
+}
+
+// find_checkpoint reads the index file, setting the src and dst positions to
+// those of the last checkpoint whose dst position is at or before
+// flags.offset, loading that checkpoint's window into dec. If there is no
+// such checkpoint, it sets *found to false. If it is a member start
+// checkpoint, it sets *member_start and leaves dec alone.
+const char*  //
+find_checkpoint(const char* index_filename,
+                wuffs_deflate__decoder* dec,
+                uint64_t* src_pos,
+                uint64_t* dst_pos,
+                bool* found,
+                bool* member_start) {
+  int fd = open(index_filename, O_RDONLY);
+  if (fd < 0) {
+    return strerror(errno);
+  }
+
+  const char* z = NULL;
+  uint8_t header[CHECKPOINT_HEADER_SIZE];
+  uint8_t held_bits = 0;
+  uint8_t n_held_bits = 0;
+  uint16_t w = 0;
+  while (true) {
+    bool eof = false;
+    z = read_fully(fd, header, CHECKPOINT_HEADER_SIZE, &eof);
+    if (z || eof) {
+      break;
+    }
+    uint64_t cp_dst_pos = wuffs_base__load_u64le__no_bounds_check(header + 8);
+    uint16_t cp_w = wuffs_base__load_u16le__no_bounds_check(header + 18);
+    if ((cp_w > WINDOW_ARRAY_SIZE) ||
+        ((header[16] >= 8) &&
+         ((header[16] != MEMBER_START) || (header[17] != 0) || (cp_w != 0)))) {
+      z = "main: invalid index file (bad checkpoint)";
+      break;
+    }
+
+    if (cp_dst_pos > flags.offset) {
+      // Checkpoints are in increasing order. We are done.
+      break;
+    }
+    *src_pos = wuffs_base__load_u64le__no_bounds_check(header + 0);
+    *dst_pos = cp_dst_pos;
+    n_held_bits = header[16];
+    held_bits = header[17];
+    w = cp_w;
+    *found = true;
+    *member_start = n_held_bits == MEMBER_START;
+    z = read_fully(fd, window_array, w, NULL);
+    if (z) {
+      break;
+    }
+  }
+  close(fd);
+
+  if (!z && *found && !*member_start) {
+    wuffs_deflate__decoder__resume_at_checkpoint(
+        dec, held_bits, n_held_bits,
+        wuffs_base__make_slice_u8(window_array, w));
+  }
+  return z;
+}
+
+// initialize_gzip_decoder prepares dec to decode from a gzip member's header
+// onwards, through every member after it.
+const char*  //
+initialize_gzip_decoder(wuffs_gzip__decoder* dec) {
+  wuffs_base__status status =
+      wuffs_gzip__decoder__initialize(dec, sizeof *dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_gzip__decoder__set_multi_member(dec, true);
+  return NULL;
+}
+
+// skip_gzip_trailer skips the 8 byte gzip trailer at src's read index, which
+// is where a raw deflate decoder stops at the end of a gzip member. It sets
+// *more to whether another member follows.
+const char*  //
+skip_gzip_trailer(wuffs_base__io_buffer* src, bool* more) {
+  while ((src->meta.wi - src->meta.ri) < 8) {
+    if (src->meta.closed) {
+      return "main: invalid gzip'ed data (truncated trailer)";
+    }
+    const char* z = read_src(src);
+    if (z) {
+      return z;
+    }
+  }
+  src->meta.ri += 8;
+  while ((src->meta.ri == src->meta.wi) && !src->meta.closed) {
+    const char* z = read_src(src);
+    if (z) {
+      return z;
+    }
+  }
+  *more = src->meta.ri < src->meta.wi;
+  return NULL;
+}
+
+const char*  //
+extract(wuffs_base__io_buffer* dst,
+        wuffs_base__io_buffer* src,
+        const char* index_filename) {
+  wuffs_deflate__decoder deflate_dec;
+  wuffs_gzip__decoder gzip_dec;
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      &deflate_dec, sizeof deflate_dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  uint64_t src_pos = 0;
+  uint64_t dst_pos = 0;
+  bool found = false;
+  bool member_start = false;
+  const char* z = find_checkpoint(index_filename, &deflate_dec, &src_pos,
+                                  &dst_pos, &found, &member_start);
+  if (z) {
+    return z;
+  }
+
+  // Resuming at a checkpoint within a member uses a raw deflate decoder, until
+  // the end of that member. Otherwise, decode from a gzip header: the start of
+  // a member or of the gzip'ed data.
+  wuffs_base__io_transformer* dec = NULL;
+  bool raw = found && !member_start;
+  if (raw) {
+    dec = wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
+        &deflate_dec);
+  } else {
+    z = initialize_gzip_decoder(&gzip_dec);
+    if (z) {
+      return z;
+    }
+    dec = wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(&gzip_dec);
+  }
+
+  const int stdin_fd = 0;
+  if (lseek(stdin_fd, (off_t)src_pos, SEEK_SET) < 0) {
+    return strerror(errno);
+  }
+  src->meta.pos = src_pos;
+  dst->meta.pos = dst_pos;
+
+  uint64_t remaining = flags.length;
+  while (remaining > 0) {
+    status = wuffs_base__io_transformer__transform_io(
+        dec, dst, src,
+        wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+
+    // Write the decompressed data in [flags.offset, flags.offset + length).
+    uint64_t i =
+        (dst->meta.pos < flags.offset) ? (flags.offset - dst->meta.pos) : 0;
+    if (i < dst->meta.wi) {
+      uint64_t n = dst->meta.wi - i;
+      if (n > remaining) {
+        n = remaining;
+      }
+      const int stdout_fd = 1;
+      z = write_fully(stdout_fd, dst->data.ptr + i, n);
+      if (z) {
+        return z;
+      }
+      remaining -= n;
+    }
+    dst->meta.ri = dst->meta.wi;
+    wuffs_base__io_buffer__compact(dst);
+
+    if (status.repr == wuffs_base__suspension__short_read) {
+      z = read_src(src);
+      if (z) {
+        return z;
+      }
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      if (raw && (remaining > 0) && wuffs_base__status__is_ok(&status)) {
+        // Continue with the gzip member (if any) after the raw one.
+        bool more = false;
+        z = skip_gzip_trailer(src, &more);
+        if (z) {
+          return z;
+        } else if (more) {
+          z = initialize_gzip_decoder(&gzip_dec);
+          if (z) {
+            return z;
+          }
+          dec = wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
+              &gzip_dec);
+          raw = false;
+          continue;
+        }
+      }
+      if (remaining > 0) {
+        return wuffs_base__status__is_ok(&status)
+                   ? "main: -offset and -length exceed the data's length"
+                   : wuffs_base__status__message(&status);
+      }
+      break;
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+main1(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+  if (z) {
+    return z;
+  }
+
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(dst_buffer_array, DST_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_io_buffer_meta());
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(src_buffer_array, SRC_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_io_buffer_meta());
+
+  if (flags.build) {
+    if (flags.remaining_argc != 0) {
+      return "main: -build takes no index file argument";
+    }
+    return build(&dst, &src);
+  }
+  if (flags.remaining_argc != 1) {
+    return "main: missing index file argument";
+  }
+  return extract(&dst, &src, flags.remaining_argv[0]);
+}
+
+int  //
+compute_exit_code(const char* status_msg) {
+  if (!status_msg) {
+    return 0;
+  }
+  size_t n = strnlen(status_msg, 2047);
+  if (n >= 2047) {
+    status_msg = "main: internal error: error message is too long";
+    n = strnlen(status_msg, 2047);
+  }
+  const int stderr_fd = 2;
+  ignore_return_value(write(stderr_fd, status_msg, n));
+  ignore_return_value(write(stderr_fd, "\n", 1));
+  // Return an exit code of 1 for regular (forseen) errors, e.g. badly
+  // formatted or unsupported input.
+  //
+  // Return an exit code of 2 for internal (exceptional) errors, e.g. defensive
+  // run-time checks found that an internal invariant did not hold.
+  //
+  // Automated testing, including badly formatted inputs, can therefore
+  // discriminate between expected failure (exit code 1) and unexpected failure
+  // (other non-zero exit codes). Specifically, exit code 2 for internal
+  // invariant violation, exit code 139 (which is 128 + SIGSEGV on x86_64
+  // linux) for a segmentation fault (e.g. null pointer dereference).
+  return strstr(status_msg, "internal error:") ? 2 : 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  return compute_exit_code(main1(argc, argv));
+}
@@ -22,9 +22,44 @@ also self-imposes a SECCOMP_MODE_STRICT sandbox. To run:
 $CC zcat.c && ./a.out < ../../test/data/romeo.txt.gz; rm -f a.out
 
 for a C compiler $CC, such as clang or gcc.
+
+With the -threads=N flag (for N greater than 1), it decodes each gzip member
+in parallel, similar to the "pugz" technique, and gives up the sandbox.
+Each round reads N chunks of compressed data (PARALLEL_CHUNK_SIZE each). The
+first chunk is decoded as usual, on the main thread. Each other chunk is
+decoded on its own thread, starting at the first bit position that looks like
+the start of a (dynamic Huffman) deflate block, with an unknown window. Its
+output is resolved once the chunk before it is known to finish exactly where
+it starts. The output is the same as for the serial decoder, but the parallel
+decoder is a proof of concept, not optimized, and uses more memory:
+
+$CC -O3 zcat.c -pthread && ./a.out -threads=4 < foo.gz > foo
+
+Deflate output bytes are 8 bits wide but a symbolic window needs 32768
+distinct symbols. Instead, each speculative chunk is decoded twice, with two
+different synthetic windows, such that literal bytes are the same in both
+decodings and each back-reference into the unknown window maps to a distinct
+pair of different bytes. The total CPU work for those chunks is therefore
+doubled, and the speedup is roughly N/2 instead of N.
+
+If the input is BGZF (blocked gzip, as used by the BAM and tabix file formats),
+each gzip member is at most 64 KiB long and its header records that length, so
+no speculation is needed. With the -threads=N flag, each round splits whole
+BGZF blocks into N runs, inflates each run on its own thread and writes the
+runs' output in order.
+
+The -voffset=V flag (which implies BGZF input) starts decoding at the BGZF
+virtual offset V, which is (coffset << 16 | uoffset): the compressed offset of
+a BGZF block in the input and the offset of a byte within that block's output.
+If stdin is seekable, the first coffset bytes are not even read:
+
+$CC -O3 zcat.c -pthread && ./a.out -threads=4 -voffset=123456789 < foo.bgzf
 */
 
 #include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/types.h>
 #include <unistd.h>
 
 // Wuffs ships as a "single file C library" or "header file library" as per
@@ -72,6 +107,18 @@ for a C compiler $CC, such as clang or gcc.
 #define WORK_BUFFER_ARRAY_SIZE \
   WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
 
+// MAX_THREADS is an arbitrary upper bound on the -threads=N flag value.
+#ifndef MAX_THREADS
+#define MAX_THREADS 256
+#endif
+
+// PARALLEL_CHUNK_SIZE is the amount of compressed data per thread per round.
+#ifndef PARALLEL_CHUNK_SIZE
+#define PARALLEL_CHUNK_SIZE (1024 * 1024)
+#endif
+
+#define WINDOW_SIZE 32768
+
 uint8_t dst_buffer_array[DST_BUFFER_ARRAY_SIZE];
 uint8_t src_buffer_array[SRC_BUFFER_ARRAY_SIZE];
 #if WORK_BUFFER_ARRAY_SIZE > 0
@@ -90,10 +137,15 @@ struct {
   char** remaining_argv;
 
   bool fail_if_unsandboxed;
+  size_t threads;
+  bool has_voffset;
+  uint64_t voffset;
 } flags = {0};
 
 const char*  //
 parse_flags(int argc, char** argv) {
+  flags.threads = 1;
+
   int c = (argc > 0) ? 1 : 0;  // Skip argv[0], the program name.
   for (; c < argc; c++) {
     char* arg = argv[c];
@@ -118,6 +170,26 @@ parse_flags(int argc, char** argv) {
       flags.fail_if_unsandboxed = true;
       continue;
     }
+    if (!strncmp(arg, "threads=", 8)) {
+      char* end = NULL;
+      unsigned long n = strtoul(arg + 8, &end, 10);
+      if ((end == arg + 8) || (*end != '\x00') || (n < 1) ||
+          (n > MAX_THREADS)) {
+        return "main: bad -threads=N flag value";
+      }
+      flags.threads = n;
+      continue;
+    }
+    if (!strncmp(arg, "voffset=", 8)) {
+      char* end = NULL;
+      unsigned long long n = strtoull(arg + 8, &end, 10);
+      if ((end == arg + 8) || (*end != '\x00')) {
+        return "main: bad -voffset=V flag value";
+      }
+      flags.has_voffset = true;
+      flags.voffset = n;
+      continue;
+    }
 
     return "main: unrecognized flag argument";
   }
@@ -133,22 +205,792 @@ parse_flags(int argc, char** argv) {
 static void  //
 ignore_return_value(int ignored) {}
 
+// ---- Parallel decoding.
+
+// speculative_windows are the two synthetic windows for the two speculative
+// decodings of a chunk. For the k'th window byte (where the window's last
+// byte, k = 32767, is immediately before the chunk), the first window holds
+// lo = (k & 0xFF) and the second holds ((lo + 1 + (k >> 8)) & 0xFF). Those two
+// bytes always differ and, together, identify k. Literal bytes are the same in
+// both decodings.
+uint8_t speculative_windows[2][WINDOW_SIZE];
+
+// actual_window holds the most recent actual_window_len bytes of output, at
+// its end.
+uint8_t actual_window[WINDOW_SIZE];
+size_t actual_window_len = 0;
+
+wuffs_crc32__ieee_hasher output_hasher;
+uint32_t output_checksum = 0;
+uint32_t output_length = 0;
+
+// lead is the (non-speculative) deflate decoder for each round's first chunk.
+wuffs_deflate__decoder lead;
+
+typedef struct {
+  // These fields are set before the worker thread starts. Bit positions and
+  // byte offsets are relative to src_ptr.
+  const uint8_t* src_ptr;
+  size_t src_len;
+  bool src_closed;
+  size_t lo;
+  size_t hi;
+
+  // These fields are set by the worker thread. If valid, out[0] and out[1]
+  // hold the two speculative decodings (with equal lengths) of the deflate
+  // blocks from start_bitpos to end_bitpos. final is whether the last of
+  // those blocks is the final block.
+  bool valid;
+  bool final;
+  uint64_t start_bitpos;
+  uint64_t end_bitpos;
+  struct {
+    uint8_t* ptr;
+    size_t len;
+    size_t cap;
+  } out[2];
+
+  pthread_t thread;
+  wuffs_deflate__decoder dec;
+} worker;
+
+static void  //
+initialize_speculative_windows() {
+  uint32_t k;
+  for (k = 0; k < WINDOW_SIZE; k++) {
+    uint32_t lo = k & 0xFF;
+    speculative_windows[0][k] = (uint8_t)lo;
+    speculative_windows[1][k] = (uint8_t)((lo + 1 + (k >> 8)) & 0xFF);
+  }
+}
+
+static void  //
+write_stdout(const uint8_t* ptr, size_t len) {
+  // TODO: handle EINTR and other write errors; see "man 2 write".
+  const int stdout_fd = 1;
+  ignore_return_value(write(stdout_fd, ptr, len));
+}
+
+static void  //
+emit(const uint8_t* ptr, size_t len) {
+  write_stdout(ptr, len);
+
+  output_checksum = wuffs_crc32__ieee_hasher__update_u32(
+      &output_hasher, wuffs_base__make_slice_u8((uint8_t*)ptr, len));
+  output_length += (uint32_t)len;
+
+  if (len >= WINDOW_SIZE) {
+    memcpy(actual_window, ptr + len - WINDOW_SIZE, WINDOW_SIZE);
+    actual_window_len = WINDOW_SIZE;
+  } else if (len > 0) {
+    memmove(actual_window, actual_window + len, WINDOW_SIZE - len);
+    memcpy(actual_window + WINDOW_SIZE - len, ptr, len);
+    actual_window_len += len;
+    if (actual_window_len > WINDOW_SIZE) {
+      actual_window_len = WINDOW_SIZE;
+    }
+  }
+}
+
+// get_bits returns the n bits (n <= 16) at bit position p, in deflate's Least
+// Significant Bits order. The caller is responsible for bounds checking.
+static uint32_t  //
+get_bits(const uint8_t* ptr, uint64_t p, uint32_t n) {
+  const uint8_t* q = ptr + (p >> 3);
+  uint32_t x = ((uint32_t)(q[0])) | (((uint32_t)(q[1])) << 8) |
+               (((uint32_t)(q[2])) << 16);
+  return (x >> (p & 7)) & ((1u << n) - 1);
+}
+
+// is_block_candidate returns whether bit position p looks like the start of a
+// dynamic Huffman block: valid HLIT and HDIST counts and a complete Huffman
+// code for the code lengths. Real encoders emit complete codes, and zlib
+// rejects incomplete code length codes.
+static bool  //
+is_block_candidate(const uint8_t* ptr, size_t len, uint64_t p) {
+  // The header is at most 3 + 5 + 5 + 4 + (19 * 3) = 74 bits long.
+  if (((p >> 3) + 12) > len) {
+    return false;
+  } else if ((get_bits(ptr, p, 3) & 6) != 4) {
+    return false;
+  } else if ((get_bits(ptr, p + 3, 5) > 29) || (get_bits(ptr, p + 8, 5) > 29)) {
+    return false;
+  }
+  uint32_t n_clcodes = get_bits(ptr, p + 13, 4) + 4;
+  uint32_t kraft = 0;
+  uint32_t i;
+  for (i = 0; i < n_clcodes; i++) {
+    uint32_t n = get_bits(ptr, p + 17 + (3 * i), 3);
+    if (n > 0) {
+      kraft += 128 >> n;
+    }
+  }
+  return kraft == 128;
+}
+
+// decode_speculatively decodes w's src, as raw deflate starting at bit
+// position start, into w->out[pass]. It stops at the first block boundary at
+// or after bit position stop, or at the end of the deflate stream, or when it
+// runs out of src. It returns whether it reached any block boundary, in which
+// case it truncates the output to the last one reached.
+static bool  //
+decode_speculatively(worker* w, int pass, uint64_t start, uint64_t stop) {
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      &w->dec, sizeof w->dec, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return false;
+  }
+  wuffs_deflate__decoder__set_report_block_boundaries(&w->dec, true);
+  // The output is never compacted. Growing it with realloc keeps its bytes.
+  wuffs_deflate__decoder__set_dst_holds_window(&w->dec, true);
+
+  size_t ri = start >> 3;
+  uint32_t held_bits = 0;
+  uint32_t n_held_bits = 0;
+  if (start & 7) {
+    held_bits = w->src_ptr[ri] >> (start & 7);
+    n_held_bits = 8 - (start & 7);
+    ri++;
+  }
+  wuffs_deflate__decoder__resume_at_checkpoint(
+      &w->dec, held_bits, n_held_bits,
+      wuffs_base__make_slice_u8(speculative_windows[pass], WINDOW_SIZE));
+
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8((uint8_t*)(w->src_ptr), w->src_len),
+      wuffs_base__make_io_buffer_meta(w->src_len, ri, 0, w->src_closed));
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(w->out[pass].ptr, w->out[pass].cap),
+      wuffs_base__empty_io_buffer_meta());
+
+  bool reached = false;
+  while (true) {
+    status = wuffs_deflate__decoder__transform_io(
+        &w->dec, &dst, &src,
+        wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+
+    if (status.repr == wuffs_base__suspension__short_write) {
+      size_t cap = dst.data.len ? (2 * dst.data.len) : (1024 * 1024);
+      uint8_t* ptr = (uint8_t*)realloc(dst.data.ptr, cap);
+      if (!ptr) {
+        break;
+      }
+      w->out[pass].ptr = ptr;
+      w->out[pass].cap = cap;
+      dst.data = wuffs_base__make_slice_u8(ptr, cap);
+      continue;
+    }
+
+    bool boundary = status.repr == wuffs_deflate__suspension__block_boundary;
+    if (boundary || wuffs_base__status__is_ok(&status)) {
+      reached = true;
+      w->final = !boundary;
+      w->end_bitpos =
+          (8 * (uint64_t)(src.meta.ri)) -
+          (boundary ? wuffs_deflate__decoder__n_held_bits(&w->dec) : 0);
+      w->out[pass].len = dst.meta.wi;
+      if (boundary && (w->end_bitpos < stop)) {
+        continue;
+      }
+    }
+    break;
+  }
+  return reached;
+}
+
+static void*  //
+worker_main(void* arg) {
+  worker* w = (worker*)arg;
+  w->valid = false;
+
+  // Find the first candidate that decodes to at least one block boundary.
+  uint64_t stop = 8 * (uint64_t)(w->hi);
+  uint64_t p = 8 * (uint64_t)(w->lo);
+  for (; p < stop; p++) {
+    if (is_block_candidate(w->src_ptr, w->src_len, p) &&
+        decode_speculatively(w, 0, p, stop)) {
+      break;
+    }
+  }
+  if (p >= stop) {
+    return NULL;
+  }
+
+  // Decode the same blocks again, with the other window.
+  uint64_t end_bitpos = w->end_bitpos;
+  bool final = w->final;
+  if (!decode_speculatively(w, 1, p, end_bitpos) ||
+      (w->end_bitpos != end_bitpos) || (w->final != final) ||
+      (w->out[0].len != w->out[1].len)) {
+    return NULL;
+  }
+  w->start_bitpos = p;
+  w->valid = true;
+  return NULL;
+}
+
+// resolve converts w's two speculative decodings to the actual output, in
+// place in w->out[0], given the output immediately before w's chunk. It
+// returns false if a back-reference goes before the start of all output.
+static bool  //
+resolve(worker* w) {
+  uint8_t* a = w->out[0].ptr;
+  const uint8_t* b = w->out[1].ptr;
+  size_t n = w->out[0].len;
+  size_t i;
+  for (i = 0; i < n; i++) {
+    if (a[i] == b[i]) {
+      continue;
+    }
+    uint32_t lo = a[i];
+    uint32_t hi = (((uint32_t)(b[i])) - lo - 1) & 0xFF;
+    uint32_t k = (hi << 8) | lo;
+    if ((hi >= (WINDOW_SIZE >> 8)) || (k < (WINDOW_SIZE - actual_window_len))) {
+      return false;
+    }
+    a[i] = actual_window[k];
+  }
+  return true;
+}
+
+// parse_gzip_header returns the length of the gzip header at the start of
+// ptr[.. len], or 0 if it is invalid or longer than len.
+static size_t  //
+parse_gzip_header(uint8_t* ptr, size_t len) {
+  if ((len < 10) || (ptr[0] != 0x1F) || (ptr[1] != 0x8B) || (ptr[2] != 0x08) ||
+      ((ptr[3] & 0xE0) != 0)) {
+    return 0;
+  }
+  uint8_t flags = ptr[3];
+  size_t i = 10;
+  if (flags & 0x04) {  // FEXTRA.
+    if ((len - i) < 2) {
+      return 0;
+    }
+    i += 2 + wuffs_base__load_u16le__no_bounds_check(ptr + i);
+  }
+  int j;
+  for (j = 0; j < 2; j++) {  // FNAME and FCOMMENT.
+    if (flags & (0x08 << j)) {
+      while ((i < len) && (ptr[i] != 0)) {
+        i++;
+      }
+      i++;
+    }
+  }
+  if (flags & 0x02) {  // FHCRC.
+    i += 2;
+  }
+  return (i < len) ? i : 0;
+}
+
+// read_src compacts src and then fills it from stdin, until it is full or
+// stdin is exhausted.
+static const char*  //
+read_src(wuffs_base__io_buffer* src) {
+  wuffs_base__io_buffer__compact(src);
+  while (!src->meta.closed && (src->meta.wi < src->data.len)) {
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, src->data.ptr + src->meta.wi,
+                     src->data.len - src->meta.wi);
+    if (n < 0) {
+      if (errno != EINTR) {
+        return strerror(errno);
+      }
+      continue;
+    }
+    src->meta.wi += n;
+    if (n == 0) {
+      src->meta.closed = true;
+    }
+  }
+  return NULL;
+}
+
+// resume_lead re-initializes the lead decoder at bit position p of src.
+static const char*  //
+resume_lead(wuffs_base__io_buffer* src, uint64_t p) {
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      &lead, sizeof lead, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_deflate__decoder__set_report_block_boundaries(&lead, true);
+
+  src->meta.ri = p >> 3;
+  uint32_t held_bits = 0;
+  uint32_t n_held_bits = 0;
+  if (p & 7) {
+    held_bits = src->data.ptr[src->meta.ri] >> (p & 7);
+    n_held_bits = 8 - (p & 7);
+    src->meta.ri++;
+  }
+  wuffs_deflate__decoder__resume_at_checkpoint(
+      &lead, held_bits, n_held_bits,
+      wuffs_base__make_slice_u8(actual_window + WINDOW_SIZE - actual_window_len,
+                                actual_window_len));
+  return NULL;
+}
+
+// check_gzip_footer checks the 8 byte gzip footer at src's read index.
+static const char*  //
+check_gzip_footer(wuffs_base__io_buffer* src) {
+  const char* z = read_src(src);
+  if (z) {
+    return z;
+  } else if ((src->meta.wi - src->meta.ri) < 8) {
+    return "main: truncated input";
+  }
+  uint8_t* p = src->data.ptr + src->meta.ri;
+  if ((wuffs_base__load_u32le__no_bounds_check(p + 0) != output_checksum) ||
+      (wuffs_base__load_u32le__no_bounds_check(p + 4) != output_length)) {
+    wuffs_base__status status =
+        wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+    return wuffs_base__status__message(&status);
+  }
+  return NULL;
+}
+
+// next_gzip_member checks the gzip footer at src's read index and then, like
+// main_serial, looks for another gzip member after it. If there is one, it
+// resets the output checksum, length and window and resumes the lead decoder
+// just after that member's header. Otherwise, it sets *done.
+static const char*  //
+next_gzip_member(wuffs_base__io_buffer* src, bool* done) {
+  const char* z = check_gzip_footer(src);
+  if (z) {
+    return z;
+  }
+  src->meta.ri += 8;
+  z = read_src(src);
+  if (z) {
+    return z;
+  } else if (src->meta.ri == src->meta.wi) {
+    *done = true;
+    return NULL;
+  }
+
+  size_t header_len = parse_gzip_header(src->data.ptr + src->meta.ri,
+                                        src->meta.wi - src->meta.ri);
+  if (header_len == 0) {
+    wuffs_base__status status =
+        wuffs_base__make_status(wuffs_gzip__error__bad_header);
+    return wuffs_base__status__message(&status);
+  }
+  wuffs_base__status status = wuffs_crc32__ieee_hasher__initialize(
+      &output_hasher, sizeof output_hasher, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  output_checksum = 0;
+  output_length = 0;
+  actual_window_len = 0;
+  return resume_lead(src, 8 * (uint64_t)(src->meta.ri + header_len));
+}
+
+// ---- BGZF decoding.
+
+// BGZF_MAX_BLOCK_SIZE is the maximum length of a BGZF block, both compressed
+// and decoded.
+#define BGZF_MAX_BLOCK_SIZE 65536
+
+typedef struct {
+  // These fields are set before the worker thread starts: a run of whole BGZF
+  // blocks and the total of their ISIZE fields.
+  const uint8_t* src_ptr;
+  size_t src_len;
+  size_t want_len;
+
+  // These fields are set by the worker thread.
+  const char* z;
+  struct {
+    uint8_t* ptr;
+    size_t len;
+    size_t cap;
+  } out;
+
+  pthread_t thread;
+  wuffs_gzip__decoder dec;
+} bgzf_worker;
+
+// bgzf_block_length returns the length of the BGZF block (a gzip member) at
+// the start of ptr[.. len], as per the BSIZE field of its "BC" extra subfield.
+// It returns 0 if ptr[.. len] does not start with a whole BGZF header.
+static size_t  //
+bgzf_block_length(uint8_t* ptr, size_t len) {
+  if ((len < 12) || (ptr[0] != 0x1F) || (ptr[1] != 0x8B) || (ptr[2] != 0x08) ||
+      ((ptr[3] & 0x04) == 0)) {
+    return 0;
+  }
+  size_t xlen = wuffs_base__load_u16le__no_bounds_check(ptr + 10);
+  if ((len - 12) < xlen) {
+    return 0;
+  }
+  uint8_t* p = ptr + 12;
+  uint8_t* q = p + xlen;
+  while ((q - p) >= 4) {
+    bool bc = (p[0] == 'B') && (p[1] == 'C');
+    size_t slen = wuffs_base__load_u16le__no_bounds_check(p + 2);
+    p += 4;
+    if ((size_t)(q - p) < slen) {
+      break;
+    } else if (bc && (slen == 2)) {
+      // The block must at least hold its header and the 8 byte trailer.
+      size_t n = 1 + (size_t)(wuffs_base__load_u16le__no_bounds_check(p));
+      return (n >= (12 + xlen + 8)) ? n : 0;
+    }
+    p += slen;
+  }
+  return 0;
+}
+
+// bgzf_split splits the whole BGZF blocks at the start of ptr[.. len] into at
+// most num_workers runs of roughly equal compressed length, setting
+// *num_runs. It sets it to zero if more input is needed to see a whole block.
+static const char*  //
+bgzf_split(bgzf_worker* workers,
+           size_t num_workers,
+           uint8_t* ptr,
+           size_t len,
+           bool closed,
+           size_t* num_runs) {
+  size_t run_len = len / num_workers;
+  size_t n = 0;
+  size_t i = 0;
+  while (i < len) {
+    size_t block_len = bgzf_block_length(ptr + i, len - i);
+    if ((block_len == 0) || (block_len > (len - i))) {
+      if (closed || ((len - i) >= BGZF_MAX_BLOCK_SIZE)) {
+        return block_len ? "main: truncated input" : "main: bad BGZF header";
+      }
+      break;
+    }
+    uint32_t isize =
+        wuffs_base__load_u32le__no_bounds_check(ptr + i + block_len - 4);
+    if (isize > BGZF_MAX_BLOCK_SIZE) {
+      return "main: bad BGZF ISIZE";
+    }
+
+    if ((n == 0) ||
+        ((n < num_workers) && (workers[n - 1].src_len >= run_len))) {
+      workers[n].src_ptr = ptr + i;
+      workers[n].src_len = 0;
+      workers[n].want_len = 0;
+      n++;
+    }
+    workers[n - 1].src_len += block_len;
+    workers[n - 1].want_len += isize;
+    i += block_len;
+  }
+  *num_runs = n;
+  return NULL;
+}
+
+static void*  //
+bgzf_worker_main(void* arg) {
+  bgzf_worker* w = (bgzf_worker*)arg;
+  w->out.len = 0;
+  wuffs_base__status status = wuffs_gzip__decoder__initialize(
+      &w->dec, sizeof w->dec, WUFFS_VERSION,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+  if (!wuffs_base__status__is_ok(&status)) {
+    w->z = wuffs_base__status__message(&status);
+    return NULL;
+  }
+  wuffs_gzip__decoder__set_multi_member(&w->dec, true);
+
+  wuffs_base__io_buffer src = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8((uint8_t*)(w->src_ptr), w->src_len),
+      wuffs_base__make_io_buffer_meta(w->src_len, 0, 0, true));
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(w->out.ptr, w->want_len),
+      wuffs_base__empty_io_buffer_meta());
+  status = wuffs_gzip__decoder__transform_io(
+      &w->dec, &dst, &src,
+      wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+  if (status.repr == wuffs_base__suspension__short_write) {
+    status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+  }
+  w->z = wuffs_base__status__is_ok(&status)
+             ? NULL
+             : wuffs_base__status__message(&status);
+  w->out.len = dst.meta.wi;
+  return NULL;
+}
+
+// main_bgzf decodes the BGZF data that starts at src's read index, and
+// continues on stdin, discarding the first skip bytes of output.
 const char*  //
-main1(int argc, char** argv) {
-  const char* z = parse_flags(argc, argv);
+main_bgzf(wuffs_base__io_buffer* src, uint64_t skip) {
+  size_t num_workers = flags.threads;
+  bgzf_worker* workers = (bgzf_worker*)calloc(num_workers, sizeof(bgzf_worker));
+  if (!workers) {
+    return "main: out of memory";
+  }
+
+  while (true) {
+    const char* z = read_src(src);
+    if (z) {
+      return z;
+    } else if (src->meta.closed && (src->meta.ri == src->meta.wi)) {
+      return NULL;
+    }
+
+    size_t n = 0;
+    z = bgzf_split(workers, num_workers, src->data.ptr + src->meta.ri,
+                   src->meta.wi - src->meta.ri, src->meta.closed, &n);
+    if (z) {
+      return z;
+    }
+
+    // Start the workers, one per run. A run's output buffer is exactly as
+    // long as its blocks' ISIZE fields say it should be. The first run is
+    // decoded on this thread.
+    size_t i;
+    for (i = 0; i < n; i++) {
+      bgzf_worker* w = &workers[i];
+      if (w->out.cap < w->want_len) {
+        uint8_t* ptr = (uint8_t*)realloc(w->out.ptr, w->want_len);
+        if (!ptr) {
+          return "main: out of memory";
+        }
+        w->out.ptr = ptr;
+        w->out.cap = w->want_len;
+      }
+      w->z = NULL;
+      if ((i > 0) && pthread_create(&w->thread, NULL, bgzf_worker_main, w)) {
+        return "main: could not create thread";
+      }
+    }
+    if (n > 0) {
+      bgzf_worker_main(&workers[0]);
+    }
+
+    // Write each run's output in order.
+    for (i = 0; i < n; i++) {
+      bgzf_worker* w = &workers[i];
+      if (i > 0) {
+        pthread_join(w->thread, NULL);
+      }
+      if (w->z) {
+        z = w->z;
+      } else if (!z) {
+        size_t k = (skip < w->out.len) ? ((size_t)skip) : w->out.len;
+        skip -= k;
+        write_stdout(w->out.ptr + k, w->out.len - k);
+      }
+      src->meta.ri += w->src_len;
+    }
+    if (z) {
+      return z;
+    }
+  }
+}
+
+// main_voffset decodes BGZF data from the virtual offset given by the
+// -voffset=V flag.
+const char*  //
+main_voffset() {
+  size_t src_len = flags.threads * PARALLEL_CHUNK_SIZE;
+  uint8_t* src_ptr = (uint8_t*)malloc(src_len);
+  if (!src_ptr) {
+    return "main: out of memory";
+  }
+  wuffs_base__io_buffer src =
+      wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(src_ptr, src_len),
+                                 wuffs_base__empty_io_buffer_meta());
+
+  // Skip the first coffset bytes of stdin: by seeking if possible, otherwise
+  // by reading and discarding.
+  uint64_t coffset = flags.voffset >> 16;
+  uint64_t uoffset = flags.voffset & 0xFFFF;
+  const int stdin_fd = 0;
+  if ((coffset > 0) && (lseek(stdin_fd, (off_t)coffset, SEEK_CUR) < 0)) {
+    while (coffset > 0) {
+      size_t len = (coffset < src_len) ? ((size_t)coffset) : src_len;
+      ssize_t n = read(stdin_fd, src_ptr, len);
+      if (n < 0) {
+        if (errno != EINTR) {
+          return strerror(errno);
+        }
+        continue;
+      } else if (n == 0) {
+        break;
+      }
+      coffset -= n;
+    }
+  }
+
+  // The virtual offset must be within a BGZF block.
+  const char* z = read_src(&src);
   if (z) {
     return z;
   }
-  if (flags.fail_if_unsandboxed && !sandboxed) {
-    return "main: unsandboxed";
+  size_t block_len = bgzf_block_length(src.data.ptr, src.meta.wi);
+  if ((block_len == 0) || (block_len > src.meta.wi) ||
+      (uoffset >
+       wuffs_base__load_u32le__no_bounds_check(src.data.ptr + block_len - 4))) {
+    return "main: bad -voffset=V flag value";
+  }
+  return main_bgzf(&src, uoffset);
+}
+
+const char*  //
+main_parallel() {
+  initialize_speculative_windows();
+  wuffs_base__status status = wuffs_crc32__ieee_hasher__initialize(
+      &output_hasher, sizeof output_hasher, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
   }
 
+  size_t num_workers = flags.threads - 1;
+  worker* workers = (worker*)calloc(num_workers, sizeof(worker));
+  size_t src_len = flags.threads * PARALLEL_CHUNK_SIZE;
+  uint8_t* src_ptr = (uint8_t*)malloc(src_len);
+  if (!workers || !src_ptr) {
+    return "main: out of memory";
+  }
+
+  wuffs_base__io_buffer src =
+      wuffs_base__make_io_buffer(wuffs_base__make_slice_u8(src_ptr, src_len),
+                                 wuffs_base__empty_io_buffer_meta());
+  wuffs_base__io_buffer dst = wuffs_base__make_io_buffer(
+      wuffs_base__make_slice_u8(dst_buffer_array, DST_BUFFER_ARRAY_SIZE),
+      wuffs_base__empty_io_buffer_meta());
+
+  const char* z = read_src(&src);
+  if (z) {
+    return z;
+  } else if (bgzf_block_length(src.data.ptr, src.meta.wi) > 0) {
+    return main_bgzf(&src, 0);
+  }
+  size_t header_len = parse_gzip_header(src.data.ptr, src.meta.wi);
+  if (header_len == 0) {
+    status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+    return wuffs_base__status__message(&status);
+  }
+  z = resume_lead(&src, 8 * (uint64_t)header_len);
+  if (z) {
+    return z;
+  }
+
+  while (true) {
+    z = read_src(&src);
+    if (z) {
+      return z;
+    }
+
+    // Start the workers, one per chunk after the first. Their src is
+    // read-only until they are joined.
+    size_t n = 0;
+    for (; n < num_workers; n++) {
+      worker* w = &workers[n];
+      w->src_ptr = src.data.ptr;
+      w->src_len = src.meta.wi;
+      w->src_closed = src.meta.closed;
+      w->lo = src.meta.ri + ((n + 1) * PARALLEL_CHUNK_SIZE);
+      w->hi =
+          (n + 1 < num_workers) ? (w->lo + PARALLEL_CHUNK_SIZE) : src.meta.wi;
+      if ((w->lo >= src.meta.wi) || (w->lo >= w->hi) ||
+          pthread_create(&w->thread, NULL, worker_main, w)) {
+        break;
+      }
+    }
+
+    // Decode the first chunk on this thread, stopping at the first block
+    // boundary at or after where the first worker started looking.
+    uint64_t lead_stop = n ? (8 * (uint64_t)(workers[0].lo)) : UINT64_MAX;
+    bool lead_at_boundary = false;
+    bool lead_final = false;
+    uint64_t cur = 0;
+    while (true) {
+      status = wuffs_deflate__decoder__transform_io(
+          &lead, &dst, &src,
+          wuffs_base__make_slice_u8(work_buffer_array, WORK_BUFFER_ARRAY_SIZE));
+      emit(dst.data.ptr, dst.meta.wi);
+      dst.meta.wi = 0;
+
+      if (status.repr == wuffs_base__suspension__short_write) {
+        continue;
+      } else if (status.repr == wuffs_deflate__suspension__block_boundary) {
+        cur = (8 * (uint64_t)(src.meta.ri)) -
+              wuffs_deflate__decoder__n_held_bits(&lead);
+        if (cur < lead_stop) {
+          continue;
+        }
+        lead_at_boundary = true;
+      } else if (wuffs_base__status__is_ok(&status)) {
+        lead_final = true;
+      } else if (status.repr != wuffs_base__suspension__short_read) {
+        z = wuffs_base__status__message(&status);
+      } else if (src.meta.closed) {
+        z = "main: truncated input";
+      }
+      break;
+    }
+
+    size_t i;
+    for (i = 0; i < n; i++) {
+      pthread_join(workers[i].thread, NULL);
+    }
+    bool done = false;
+    if (z) {
+      return z;
+    } else if (lead_final) {
+      z = next_gzip_member(&src, &done);
+      if (z || done) {
+        return z;
+      }
+      continue;
+    } else if (!lead_at_boundary) {
+      continue;
+    }
+
+    // Accept, in order, each chunk that starts where the previous one ended.
+    bool accepted = false;
+    for (i = 0; i < n; i++) {
+      worker* w = &workers[i];
+      if (!w->valid || (w->start_bitpos != cur) || !resolve(w)) {
+        break;
+      }
+      emit(w->out[0].ptr, w->out[0].len);
+      accepted = true;
+      cur = w->end_bitpos;
+      if (w->final) {
+        src.meta.ri = cur >> 3;
+        z = next_gzip_member(&src, &done);
+        if (z || done) {
+          return z;
+        }
+        accepted = false;
+        break;
+      }
+    }
+    if (accepted) {
+      z = resume_lead(&src, cur);
+      if (z) {
+        return z;
+      }
+    }
+  }
+}
+
+// ---- Serial decoding.
+
+const char*  //
+main_serial() {
   wuffs_gzip__decoder dec;
   wuffs_base__status status =
       wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
   if (!wuffs_base__status__is_ok(&status)) {
     return wuffs_base__status__message(&status);
   }
+  // Like /bin/zcat, decode every member of a multi-member gzip file, such as
+  // a BGZF file.
+  wuffs_gzip__decoder__set_multi_member(&dec, true);
 
   wuffs_base__io_buffer dst;
   dst.data.ptr = dst_buffer_array;
@@ -210,6 +1052,16 @@ main1(int argc, char** argv) {
   }
 }
 
+const char*  //
+main1() {
+  if (flags.fail_if_unsandboxed && !sandboxed) {
+    return "main: unsandboxed";
+  } else if (flags.has_voffset) {
+    return main_voffset();
+  }
+  return (flags.threads > 1) ? main_parallel() : main_serial();
+}
+
 int  //
 compute_exit_code(const char* status_msg) {
   if (!status_msg) {
@@ -239,18 +1091,26 @@ compute_exit_code(const char* status_msg) {
 
 int  //
 main(int argc, char** argv) {
+  const char* z = parse_flags(argc, argv);
+
 #if defined(WUFFS_EXAMPLE_USE_SECCOMP)
-  prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT);
-  sandboxed = true;
+  // The parallel decoder creates threads and allocates memory, and the
+  // -voffset flag can seek, which SECCOMP_MODE_STRICT does not allow.
+  if (!z && (flags.threads <= 1) && !flags.has_voffset) {
+    prctl(PR_SET_SECCOMP, SECCOMP_MODE_STRICT);
+    sandboxed = true;
+  }
 #endif
 
-  int exit_code = compute_exit_code(main1(argc, argv));
+  int exit_code = compute_exit_code(z ? z : main1());
 
 #if defined(WUFFS_EXAMPLE_USE_SECCOMP)
   // Call SYS_exit explicitly, instead of calling SYS_exit_group implicitly by
   // either calling _exit or returning from main. SECCOMP_MODE_STRICT allows
   // only SYS_exit.
-  syscall(SYS_exit, exit_code);
+  if (sandboxed) {
+    syscall(SYS_exit, exit_code);
+  }
 #endif
   return exit_code;
 }
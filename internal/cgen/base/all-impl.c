@@ -57,6 +57,17 @@ extern "C" {
 // WUFFS C HEADER ENDS HERE.
 #ifdef WUFFS_IMPLEMENTATION
 
+// WUFFS_BASE__CPU_ARCH__X86_64 means that the hand-written SIMD code paths,
+// which use compiler intrinsics and per-function target attributes, are
+// compiled in. Whether they are used is decided at runtime, by CPUID. Define
+// WUFFS_CONFIG__AVOID_CPU_ARCH to compile only the portable code paths.
+#if !defined(WUFFS_CONFIG__AVOID_CPU_ARCH) && defined(__GNUC__) && \
+    defined(__x86_64__)
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 // GCC does not warn for unused *static inline* functions, but clang does.
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -176,3 +176,107 @@ wuffs_base__table_u8__row(wuffs_base__table_u8 t, uint32_t y) {
   // ---------------- Slices and Tables (Utility)
 
 #define wuffs_base__utility__empty_slice_u8 wuffs_base__empty_slice_u8
+
+// ---------------- CPU Architecture
+
+// wuffs_base__cpu_arch__x86_features caches which x86 instruction set
+// extensions are available, as a bitmask of WUFFS_BASE__CPU_ARCH__X86__ETC
+// bits. It is zero until CPUID is first consulted, after which the CHECKED bit
+// is always set. Tests and benchmarks can set it to just the CHECKED bit to
+// force the portable (non-SIMD) code paths, but must do so before starting any
+// threads that use Wuffs.
+//
+// Many threads can call wuffs_base__cpu_arch__x86_features_check at once.
+// They might all consult CPUID, but they compute the same value, and reading
+// and writing the cache with relaxed atomics (GCC and Clang builtins, like
+// the rest of WUFFS_BASE__CPU_ARCH__X86_64) avoids a data race.
+#define WUFFS_BASE__CPU_ARCH__X86__CHECKED ((uint32_t)0x80000000)
+#define WUFFS_BASE__CPU_ARCH__X86__PCLMUL ((uint32_t)0x00000001)
+#define WUFFS_BASE__CPU_ARCH__X86__SSE42 ((uint32_t)0x00000002)
+#define WUFFS_BASE__CPU_ARCH__X86__SSSE3 ((uint32_t)0x00000004)
+#define WUFFS_BASE__CPU_ARCH__X86__AVX2 ((uint32_t)0x00000008)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static uint32_t wuffs_base__cpu_arch__x86_features = 0;
+#endif
+
+static inline uint32_t  //
+wuffs_base__cpu_arch__x86_features_check() {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  uint32_t f =
+      __atomic_load_n(&wuffs_base__cpu_arch__x86_features, __ATOMIC_RELAXED);
+  if (f == 0) {
+    f = WUFFS_BASE__CPU_ARCH__X86__CHECKED;
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      // ECX bit 1 is PCLMULQDQ.
+      if (ecx & 0x00000002) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__PCLMUL;
+      }
+      // ECX bit 9 is SSSE3.
+      if (ecx & 0x00000200) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__SSSE3;
+      }
+      // ECX bit 20 is SSE4.2.
+      if (ecx & 0x00100000) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__SSE42;
+      }
+      // AVX2 also needs the OS to save and restore the YMM registers: ECX bit
+      // 27 is OSXSAVE, ECX bit 28 is AVX and XCR0 bits 1 and 2 are the XMM and
+      // YMM state. Leaf 7's EBX bit 5 is AVX2.
+      if (((ecx & 0x18000000) == 0x18000000) &&
+          (__get_cpuid_max(0, NULL) >= 7)) {
+        unsigned int xcr0_lo = 0;
+        unsigned int xcr0_hi = 0;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if (((xcr0_lo & 6) == 6) && (ebx & 0x00000020)) {
+          f |= WUFFS_BASE__CPU_ARCH__X86__AVX2;
+        }
+      }
+    }
+    __atomic_store_n(&wuffs_base__cpu_arch__x86_features, f, __ATOMIC_RELAXED);
+  }
+  return f;
+#else
+  return 0;
+#endif
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_avx2() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__AVX2) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_pclmul() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__PCLMUL) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__SSE42) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_ssse3() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__SSSE3) != 0;
+}
+
+// ---------------- CPU Architecture (Utility)
+
+#define wuffs_base__utility__cpu_arch_have_x86_avx2 \
+  wuffs_base__cpu_arch__have_x86_avx2
+#define wuffs_base__utility__cpu_arch_have_x86_pclmul \
+  wuffs_base__cpu_arch__have_x86_pclmul
+#define wuffs_base__utility__cpu_arch_have_x86_sse42 \
+  wuffs_base__cpu_arch__have_x86_sse42
+#define wuffs_base__utility__cpu_arch_have_x86_ssse3 \
+  wuffs_base__cpu_arch__have_x86_ssse3
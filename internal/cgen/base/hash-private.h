@@ -0,0 +1,416 @@
+// After editing this file, run "go generate" in the parent directory.
+
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ---------------- Hashes
+
+// WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO is the number of 32-byte blocks that
+// the SIMD implementations can process before the s1 and s2 accumulators have
+// to be reduced modulo 65521. 173 is (5552 / 32), rounded down. See the "SIMD
+// Implementations" section of std/adler32/README.md.
+#define WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO 173
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+__attribute__((target("ssse3"))) static uint32_t  //
+wuffs_base__adler32__update_x86_ssse3__impl(uint32_t s,
+                                            const uint8_t* p,
+                                            size_t n) {
+  // The taps weight each byte of a 32-byte block by how many times it is
+  // added to s2 within that block.
+  const __m128i tap0 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //
+                                     24, 23, 22, 21, 20, 19, 18, 17);
+  const __m128i tap1 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,  //
+                                     8, 7, 6, 5, 4, 3, 2, 1);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi16(1);
+
+  uint32_t s1 = s & 0xFFFF;
+  uint32_t s2 = s >> 16;
+  while (n > 0) {
+    size_t num_blocks = n / 32;
+    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {
+      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;
+    }
+    n -= num_blocks * 32;
+
+    // v_ps accumulates the s1 value at the start of each block. Each of those
+    // is added 32 times to s2, which is applied (as a shift left by 5) after
+    // the inner loop.
+    __m128i v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * num_blocks));
+    __m128i v_s1 = zero;
+    __m128i v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+    do {
+      __m128i x0 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+      __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+      p += 32;
+      v_ps = _mm_add_epi32(v_ps, v_s1);
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x0, zero));
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x1, zero));
+      v_s2 = _mm_add_epi32(v_s2,
+                           _mm_madd_epi16(_mm_maddubs_epi16(x0, tap0), ones));
+      v_s2 = _mm_add_epi32(v_s2,
+                           _mm_madd_epi16(_mm_maddubs_epi16(x1, tap1), ones));
+    } while (--num_blocks);
+    v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+    // Sum the 32-bit lanes horizontally.
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0x4E));
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0xB1));
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0x4E));
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0xB1));
+    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(v_s1)) % 65521;
+    s2 = ((uint32_t)_mm_cvtsi128_si32(v_s2)) % 65521;
+  }
+  return (s2 << 16) | s1;
+}
+
+__attribute__((target("avx2"))) static uint32_t  //
+wuffs_base__adler32__update_x86_avx2__impl(uint32_t s,
+                                           const uint8_t* p,
+                                           size_t n) {
+  // This is the same algorithm as the SSSE3 implementation, except that each
+  // 32-byte block fits in a single 256-bit register.
+  const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //
+                                       24, 23, 22, 21, 20, 19, 18, 17,  //
+                                       16, 15, 14, 13, 12, 11, 10, 9,   //
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi16(1);
+
+  uint32_t s1 = s & 0xFFFF;
+  uint32_t s2 = s >> 16;
+  while (n > 0) {
+    size_t num_blocks = n / 32;
+    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {
+      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;
+    }
+    n -= num_blocks * 32;
+
+    __m256i v_ps =
+        _mm256_setr_epi32((int)(s1 * num_blocks), 0, 0, 0, 0, 0, 0, 0);
+    __m256i v_s1 = zero;
+    __m256i v_s2 = _mm256_setr_epi32((int)s2, 0, 0, 0, 0, 0, 0, 0);
+    do {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(const void*)p);
+      p += 32;
+      v_ps = _mm256_add_epi32(v_ps, v_s1);
+      v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(x, zero));
+      v_s2 = _mm256_add_epi32(
+          v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(x, tap), ones));
+    } while (--num_blocks);
+    v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+    // Sum the 32-bit lanes horizontally.
+    __m128i w_s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1),
+                                 _mm256_extracti128_si256(v_s1, 1));
+    __m128i w_s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2),
+                                 _mm256_extracti128_si256(v_s2, 1));
+    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0x4E));
+    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0xB1));
+    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0x4E));
+    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0xB1));
+    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(w_s1)) % 65521;
+    s2 = ((uint32_t)_mm_cvtsi128_si32(w_s2)) % 65521;
+  }
+  return (s2 << 16) | s1;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__adler32__update_x86_avx2 and
+// wuffs_base__adler32__update_x86_ssse3 update the Adler-32 state s (with s1 in
+// the low 16 bits and s2 in the high 16 bits, both less than 65521) with the
+// bytes of x, using PSADBW to accumulate s1 and PMADDUBSW to accumulate s2, 32
+// bytes at a time.
+//
+// Only the first (x.len - (x.len % 32)) bytes are hashed. The caller is
+// responsible for hashing the final (x.len % 32) bytes. If the CPU does not
+// support AVX2 (or SSSE3), no bytes are hashed and s is returned unchanged.
+// Callers should check wuffs_base__cpu_arch__have_x86_avx2 (or
+// wuffs_base__cpu_arch__have_x86_ssse3) before calling these functions.
+static inline uint32_t  //
+wuffs_base__adler32__update_x86_avx2(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    return wuffs_base__adler32__update_x86_avx2__impl(s, x.ptr,
+                                                      x.len & ~(size_t)31);
+  }
+#endif
+  return s;
+}
+
+static inline uint32_t  //
+wuffs_base__adler32__update_x86_ssse3(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_ssse3()) {
+    return wuffs_base__adler32__update_x86_ssse3__impl(s, x.ptr,
+                                                       x.len & ~(size_t)31);
+  }
+#endif
+  return s;
+}
+
+// --------
+
+// wuffs_base__crc32__ieee_fold_x86_pclmul updates the CRC-32 IEEE state s
+// (which is bit-inverted, as per std/crc32's ieee_hasher) with the bytes of x,
+// using the "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction" folding technique. See the "SIMD Implementations" section of
+// std/crc32/README.md.
+//
+// Only the first (x.len - (x.len % 16)) bytes are hashed. The caller is
+// responsible for hashing the final (x.len % 16) bytes. If x.len is less than
+// 64, or the CPU does not support PCLMULQDQ, no bytes are hashed and s is
+// returned unchanged. Callers should check
+// wuffs_base__cpu_arch__have_x86_pclmul before calling this function.
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+__attribute__((target("pclmul"))) static uint32_t  //
+wuffs_base__crc32__ieee_fold_x86_pclmul__impl(uint32_t s,
+                                              const uint8_t* p,
+                                              size_t n) {
+  // The k1 ..= k5 constants are x**(4*128+32) mod P, x**(4*128-32) mod P,
+  // x**(128+32) mod P, x**(128-32) mod P and x**64 mod P, bit-reflected. mu
+  // and P' are the Barrett reduction constants. All are from the Intel paper.
+  const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+  const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+  const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+
+  __m128i x0;
+  __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+  __m128i x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+  __m128i x3 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));
+  __m128i x4 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));
+  __m128i x5;
+  __m128i x6;
+  __m128i x7;
+  __m128i x8;
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)s));
+  p += 64;
+  n -= 64;
+
+  // Fold 4 x 128 bits at a time.
+  while (n >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+    x1 = _mm_xor_si128(x1, x5);
+    x2 = _mm_xor_si128(x2, x6);
+    x3 = _mm_xor_si128(x3, x7);
+    x4 = _mm_xor_si128(x4, x8);
+    x5 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+    x6 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+    x7 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));
+    x8 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));
+    x1 = _mm_xor_si128(x1, x5);
+    x2 = _mm_xor_si128(x2, x6);
+    x3 = _mm_xor_si128(x3, x7);
+    x4 = _mm_xor_si128(x4, x8);
+    p += 64;
+    n -= 64;
+  }
+
+  // Fold 4 x 128 bits down to 1 x 128 bits.
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // Fold 1 x 128 bits at a time.
+  while (n >= 16) {
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    p += 16;
+    n -= 16;
+  }
+
+  // Fold 128 bits down to 64 bits.
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduce 64 bits down to 32 bits.
+  x2 = _mm_and_si128(x1, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  x0 = _mm_srli_si128(x1, 4);
+  return (uint32_t)(_mm_cvtsi128_si32(x0));
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static inline uint32_t  //
+wuffs_base__crc32__ieee_fold_x86_pclmul(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if ((x.len >= 64) && wuffs_base__cpu_arch__have_x86_pclmul()) {
+    return wuffs_base__crc32__ieee_fold_x86_pclmul__impl(s, x.ptr,
+                                                         x.len & ~(size_t)15);
+  }
+#endif
+  return s;
+}
+
+// --------
+
+// WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG and __SHORT are the block
+// lengths for hashing three interleaved blocks in parallel. The CRC32
+// instruction has a latency of 3 cycles but a throughput of 1 per cycle, so
+// three independent dependency chains keep the CPU busy.
+#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG 8192
+#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT 256
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+// wuffs_base__crc32__castagnoli_shift_x86_sse42 returns the CRC-32C state s
+// after (notionally) hashing n zero bytes, without the pre- and post-inverting,
+// where k is x**(8*n - 33) modulo the Castagnoli polynomial, bit-reflected.
+// See script/print-crc32-magic-numbers.go.
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t  //
+wuffs_base__crc32__castagnoli_shift_x86_sse42(uint32_t s, uint32_t k) {
+  __m128i x = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)s),
+                                   _mm_cvtsi32_si128((int)k), 0x00);
+  return (uint32_t)(_mm_crc32_u64(0, (uint64_t)(_mm_cvtsi128_si64(x))));
+}
+
+__attribute__((target("sse4.2,pclmul"))) static uint32_t  //
+wuffs_base__crc32__castagnoli_update_x86_sse42__impl(uint32_t s,
+                                                     const uint8_t* p,
+                                                     size_t n,
+                                                     bool interleave) {
+  const size_t long_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG;
+  const size_t short_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT;
+  uint64_t s0 = s;
+  uint64_t s1 = 0;
+  uint64_t s2 = 0;
+  uint64_t v0 = 0;
+  uint64_t v1 = 0;
+  uint64_t v2 = 0;
+  const uint8_t* end = NULL;
+
+  // Align p to an 8 byte boundary.
+  while ((n > 0) && (((uintptr_t)p) & 7)) {
+    s0 = _mm_crc32_u8((uint32_t)s0, *p++);
+    n--;
+  }
+
+  // Hash three interleaved blocks in parallel, and then combine their partial
+  // checksums, first with long blocks and then with short blocks. Combining
+  // uses the PCLMULQDQ instruction, hence the interleave argument.
+  if (interleave) {
+    while (n >= (3 * long_len)) {
+      s1 = 0;
+      s2 = 0;
+      end = p + long_len;
+      do {
+        memcpy(&v0, p, 8);
+        memcpy(&v1, p + long_len, 8);
+        memcpy(&v2, p + (2 * long_len), 8);
+        s0 = _mm_crc32_u64(s0, v0);
+        s1 = _mm_crc32_u64(s1, v1);
+        s2 = _mm_crc32_u64(s2, v2);
+        p += 8;
+      } while (p < end);
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0x54A86326) ^
+           s1;
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0x54A86326) ^
+           s2;
+      p += 2 * long_len;
+      n -= 3 * long_len;
+    }
+
+    while (n >= (3 * short_len)) {
+      s1 = 0;
+      s2 = 0;
+      end = p + short_len;
+      do {
+        memcpy(&v0, p, 8);
+        memcpy(&v1, p + short_len, 8);
+        memcpy(&v2, p + (2 * short_len), 8);
+        s0 = _mm_crc32_u64(s0, v0);
+        s1 = _mm_crc32_u64(s1, v1);
+        s2 = _mm_crc32_u64(s2, v2);
+        p += 8;
+      } while (p < end);
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0xB9E02B86) ^
+           s1;
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0xB9E02B86) ^
+           s2;
+      p += 2 * short_len;
+      n -= 3 * short_len;
+    }
+  }
+
+  // Hash the remaining bytes, 8 (and then 1) at a time.
+  for (; n >= 8; n -= 8) {
+    memcpy(&v0, p, 8);
+    s0 = _mm_crc32_u64(s0, v0);
+    p += 8;
+  }
+  for (; n > 0; n--) {
+    s0 = _mm_crc32_u8((uint32_t)s0, *p++);
+  }
+  return (uint32_t)s0;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__crc32__castagnoli_update_x86_sse42 updates the CRC-32C state s
+// (which is bit-inverted, as per std/crc32's castagnoli_hasher) with all of
+// the bytes of x, using the SSE4.2 CRC32 instruction. Long inputs are hashed
+// as three interleaved streams, if the CPU also supports PCLMULQDQ.
+//
+// If the CPU does not support SSE4.2, no bytes are hashed and s is returned
+// unchanged. Callers should check wuffs_base__cpu_arch__have_x86_sse42 before
+// calling this function.
+static inline uint32_t  //
+wuffs_base__crc32__castagnoli_update_x86_sse42(uint32_t s,
+                                               wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_sse42()) {
+    return wuffs_base__crc32__castagnoli_update_x86_sse42__impl(
+        s, x.ptr, x.len, wuffs_base__cpu_arch__have_x86_pclmul());
+  }
+#endif
+  return s;
+}
+
+// ---------------- Hashes (Utility)
+
+#define wuffs_base__utility__adler32_update_x86_avx2 \
+  wuffs_base__adler32__update_x86_avx2
+#define wuffs_base__utility__adler32_update_x86_ssse3 \
+  wuffs_base__adler32__update_x86_ssse3
+#define wuffs_base__utility__crc32_castagnoli_update_x86_sse42 \
+  wuffs_base__crc32__castagnoli_update_x86_sse42
+#define wuffs_base__utility__crc32_ieee_fold_x86_pclmul \
+  wuffs_base__crc32__ieee_fold_x86_pclmul
@@ -959,3 +959,350 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
   }
   return 0;
 }
+
+// --------
+
+typedef struct {
+  // begin and end are the range of the quantizer's bin list that this box
+  // holds. count is the number of pixels in those bins.
+  uint32_t begin;
+  uint32_t end;
+  uint64_t count;
+  // min_incl and max_incl are the bounds of those bins' 5-bit red, green and
+  // blue coordinates.
+  uint32_t min_incl[3];
+  uint32_t max_incl[3];
+} wuffs_base__pixel_palette__quantize__box;
+
+// wuffs_base__pixel_palette__quantize__bin returns the 15-bit histogram bin
+// (5 bits each of red, green and blue) of a BGRA pixel loaded as a uint32_t.
+static inline uint32_t  //
+wuffs_base__pixel_palette__quantize__bin(uint32_t c) {
+  return ((c >> 9) & 0x7C00) | ((c >> 6) & 0x03E0) | ((c >> 3) & 0x001F);
+}
+
+static const uint32_t wuffs_base__pixel_palette__quantize__shifts[3] = {
+    10,
+    5,
+    0,
+};
+
+// wuffs_base__pixel_palette__quantize__shrink sets b's count and bounds from
+// its bins.
+static void  //
+wuffs_base__pixel_palette__quantize__shrink(
+    wuffs_base__pixel_palette__quantize__box* b,
+    uint8_t* counts,
+    uint8_t* list) {
+  b->count = 0;
+  int axis;
+  for (axis = 0; axis < 3; axis++) {
+    b->min_incl[axis] = 31;
+    b->max_incl[axis] = 0;
+  }
+  uint32_t k;
+  for (k = b->begin; k < b->end; k++) {
+    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));
+    b->count += wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));
+    for (axis = 0; axis < 3; axis++) {
+      uint32_t v =
+          (bin >> wuffs_base__pixel_palette__quantize__shifts[axis]) & 31;
+      if (b->min_incl[axis] > v) {
+        b->min_incl[axis] = v;
+      }
+      if (b->max_incl[axis] < v) {
+        b->max_incl[axis] = v;
+      }
+    }
+  }
+}
+
+// wuffs_base__pixel_palette__quantize__split splits b along the given axis,
+// at the population's median, moving the upper part to c.
+static void  //
+wuffs_base__pixel_palette__quantize__split(
+    wuffs_base__pixel_palette__quantize__box* b,
+    wuffs_base__pixel_palette__quantize__box* c,
+    int axis,
+    uint8_t* counts,
+    uint8_t* list) {
+  uint32_t shift = wuffs_base__pixel_palette__quantize__shifts[axis];
+  uint64_t hist[32] = {0};
+  uint32_t k;
+  for (k = b->begin; k < b->end; k++) {
+    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));
+    hist[(bin >> shift) & 31] +=
+        wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));
+  }
+
+  // Both halves are non-empty, as b has more than one coordinate value on
+  // this axis and m is in [min_incl, max_incl).
+  uint32_t m = b->min_incl[axis];
+  uint64_t n = 0;
+  for (; m < b->max_incl[axis]; m++) {
+    n += hist[m];
+    if ((2 * n) >= b->count) {
+      break;
+    }
+  }
+  if (m >= b->max_incl[axis]) {
+    m = b->max_incl[axis] - 1;
+  }
+
+  uint32_t lo = b->begin;
+  uint32_t hi = b->end;
+  while (lo < hi) {
+    uint16_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * lo));
+    if (((((uint32_t)bin) >> shift) & 31) <= m) {
+      lo++;
+      continue;
+    }
+    hi--;
+    wuffs_base__store_u16le__no_bounds_check(
+        list + (2 * lo),
+        wuffs_base__load_u16le__no_bounds_check(list + (2 * hi)));
+    wuffs_base__store_u16le__no_bounds_check(list + (2 * hi), bin);
+  }
+
+  c->begin = lo;
+  c->end = b->end;
+  b->end = lo;
+  wuffs_base__pixel_palette__quantize__shrink(b, counts, list);
+  wuffs_base__pixel_palette__quantize__shrink(c, counts, list);
+}
+
+wuffs_base__result_u64  //
+wuffs_base__pixel_palette__quantize(wuffs_base__slice_u8 dst_indexes,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src,
+                                    uint32_t max_colors,
+                                    wuffs_base__slice_u8 workbuf) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  size_t n = src.len / 4;
+  if ((max_colors < 2) || (max_colors > 256) || ((src.len % 4) != 0)) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  } else if ((dst_indexes.len < n) ||
+             (dst_palette.len < (4 * ((size_t)max_colors)))) {
+    ret.status.repr = wuffs_base__error__bad_argument_length_too_short;
+    return ret;
+  } else if (workbuf.len < WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN) {
+    ret.status.repr = wuffs_base__error__bad_workbuf_length;
+    return ret;
+  }
+
+  // The workbuf holds a uint32_t count (and later, a box index) per bin and
+  // then a uint16_t list of the occupied bins.
+  uint8_t* counts = workbuf.ptr;
+  uint8_t* list = workbuf.ptr + (4 * 32768);
+  memset(counts, 0, 4 * 32768);
+
+  bool has_transparent = false;
+  uint8_t* s = src.ptr;
+  size_t i;
+  for (i = 0; i < n; i++, s += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);
+    if (c < 0x80000000) {
+      has_transparent = true;
+      continue;
+    }
+    uint8_t* p = counts + (4 * wuffs_base__pixel_palette__quantize__bin(c));
+    wuffs_base__store_u32le__no_bounds_check(
+        p, wuffs_base__load_u32le__no_bounds_check(p) + 1);
+  }
+
+  // Start with a single box holding every occupied bin. Repeatedly split the
+  // box with the largest product of population and longest side.
+  wuffs_base__pixel_palette__quantize__box boxes[256];
+  uint32_t n_bins = 0;
+  uint32_t bin;
+  for (bin = 0; bin < 32768; bin++) {
+    if (wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin))) {
+      wuffs_base__store_u16le__no_bounds_check(list + (2 * n_bins),
+                                               (uint16_t)bin);
+      n_bins++;
+    }
+  }
+  uint32_t n_boxes = 0;
+  if (n_bins > 0) {
+    boxes[0].begin = 0;
+    boxes[0].end = n_bins;
+    wuffs_base__pixel_palette__quantize__shrink(&boxes[0], counts, list);
+    n_boxes = 1;
+  }
+
+  uint32_t max_boxes = max_colors - (has_transparent ? 1 : 0);
+  while (n_boxes < max_boxes) {
+    uint64_t best_score = 0;
+    uint32_t best_j = 0;
+    int best_axis = 0;
+    uint32_t j;
+    for (j = 0; j < n_boxes; j++) {
+      int axis;
+      for (axis = 0; axis < 3; axis++) {
+        uint64_t score =
+            boxes[j].count * (boxes[j].max_incl[axis] - boxes[j].min_incl[axis]);
+        if (best_score < score) {
+          best_score = score;
+          best_j = j;
+          best_axis = axis;
+        }
+      }
+    }
+    if (best_score == 0) {
+      break;
+    }
+    wuffs_base__pixel_palette__quantize__split(
+        &boxes[best_j], &boxes[n_boxes], best_axis, counts, list);
+    n_boxes++;
+  }
+
+  // Re-purpose each bin's count to hold its box index.
+  uint32_t j;
+  for (j = 0; j < n_boxes; j++) {
+    uint32_t k;
+    for (k = boxes[j].begin; k < boxes[j].end; k++) {
+      wuffs_base__store_u32le__no_bounds_check(
+          counts + (4 * wuffs_base__load_u16le__no_bounds_check(list + (2 * k))),
+          j);
+    }
+  }
+
+  // Map each pixel to its box, accumulating each box's mean color.
+  uint64_t sums[256][4] = {{0}};
+  uint8_t transparent_index = (uint8_t)n_boxes;
+  uint8_t* d = dst_indexes.ptr;
+  for (i = 0, s = src.ptr; i < n; i++, s += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);
+    if (c < 0x80000000) {
+      d[i] = transparent_index;
+      continue;
+    }
+    uint32_t k = wuffs_base__load_u32le__no_bounds_check(
+        counts + (4 * wuffs_base__pixel_palette__quantize__bin(c)));
+    sums[k][0] += 0xFF & (c >> 0);
+    sums[k][1] += 0xFF & (c >> 8);
+    sums[k][2] += 0xFF & (c >> 16);
+    sums[k][3]++;
+    d[i] = (uint8_t)k;
+  }
+
+  uint8_t* p = dst_palette.ptr;
+  for (j = 0; j < n_boxes; j++, p += 4) {
+    uint64_t count = sums[j][3];
+    uint64_t half = count / 2;
+    p[0] = (uint8_t)((sums[j][0] + half) / count);
+    p[1] = (uint8_t)((sums[j][1] + half) / count);
+    p[2] = (uint8_t)((sums[j][2] + half) / count);
+    p[3] = 0xFF;
+  }
+  if (has_transparent) {
+    wuffs_base__store_u32le__no_bounds_check(p, 0);
+    n_boxes++;
+  }
+
+  ret.value = n_boxes;
+  return ret;
+}
+
+// --------
+
+wuffs_base__result_u64  //
+wuffs_base__frame_index__build(wuffs_base__image_decoder* dec,
+                               wuffs_base__frame_index_entry* dst_ptr,
+                               size_t dst_len,
+                               wuffs_base__io_buffer* src,
+                               wuffs_base__rect_ie_u32 image_bounds) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  if (!dec || (!dst_ptr && (dst_len > 0)) || !src) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  }
+
+  while (true) {
+    wuffs_base__frame_config fc = wuffs_base__null_frame_config();
+    wuffs_base__status status =
+        wuffs_base__image_decoder__decode_frame_config(dec, &fc, src);
+    ret.value = wuffs_base__image_decoder__num_decoded_frame_configs(dec);
+    if (status.repr == wuffs_base__note__end_of_data) {
+      break;
+    } else if (status.repr) {
+      ret.status = status;
+      break;
+    }
+
+    uint64_t i = wuffs_base__frame_config__index(&fc);
+    if (i >= dst_len) {
+      ret.status.repr = wuffs_base__error__bad_argument_length_too_short;
+      break;
+    }
+    wuffs_base__frame_index_entry* e = &dst_ptr[i];
+    e->io_position = wuffs_base__frame_config__io_position(&fc);
+    e->bounds = wuffs_base__frame_config__bounds(&fc);
+    e->duration = wuffs_base__frame_config__duration(&fc);
+    e->disposal = wuffs_base__frame_config__disposal(&fc);
+    if (i == 0) {
+      e->keyframe = true;
+    } else if (wuffs_base__rect_ie_u32__equals(&e->bounds, image_bounds) &&
+               wuffs_base__frame_config__opaque_within_bounds(&fc)) {
+      e->keyframe = true;
+    } else {
+      wuffs_base__frame_index_entry* prev = &dst_ptr[i - 1];
+      e->keyframe =
+          wuffs_base__rect_ie_u32__equals(&prev->bounds, image_bounds) &&
+          (prev->disposal ==
+           WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND);
+    }
+  }
+  return ret;
+}
+
+wuffs_base__result_u64  //
+wuffs_base__frame_index__seek(wuffs_base__image_decoder* dec,
+                              const wuffs_base__frame_index_entry* index_ptr,
+                              size_t index_len,
+                              uint64_t target,
+                              wuffs_base__io_buffer* src) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  if (!dec || !index_ptr) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  } else if (target >= index_len) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  }
+
+  uint64_t k = target;
+  while ((k > 0) && (!index_ptr[k].keyframe ||
+                     ((k < target) &&
+                      (index_ptr[k].disposal ==
+                       WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS)))) {
+    k--;
+  }
+  uint64_t pos = index_ptr[k].io_position;
+
+  if (src) {
+    if ((pos < src->meta.pos) || ((pos - src->meta.pos) > src->meta.wi)) {
+      ret.status.repr = wuffs_base__error__bad_i_o_position;
+      return ret;
+    }
+  }
+  ret.status = wuffs_base__image_decoder__restart_frame(dec, k, pos);
+  if (ret.status.repr) {
+    return ret;
+  }
+  if (src) {
+    src->meta.ri = (size_t)(pos - src->meta.pos);
+  }
+  ret.value = k;
+  return ret;
+}
@@ -1204,3 +1204,91 @@ wuffs_base__pixel_swizzler::swizzle_interleaved(
 }
 
 #endif  // __cplusplus
+
+// --------
+
+// WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN is the length of the
+// workbuf that wuffs_base__pixel_palette__quantize needs: a 4-byte count and
+// a 2-byte list entry for each of the 32768 histogram bins.
+#define WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN 196608
+
+// wuffs_base__pixel_palette__quantize converts src's BGRA (non-premultiplied
+// alpha) pixels to palette indexes, one byte per pixel, written to
+// dst_indexes. The palette, of at most max_colors (in the range [2 ..= 256])
+// BGRA entries, is written to dst_palette. It returns the number of entries.
+//
+// It uses median cut over a histogram of 5 bits per color channel. Each
+// palette entry is the mean color of the pixels that map to it. Pixels whose
+// alpha is below 0x80 all map to one fully transparent (all zero) entry.
+// Other pixels map to fully opaque entries.
+//
+// The workbuf must be at least WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN
+// bytes long.
+wuffs_base__result_u64  //
+wuffs_base__pixel_palette__quantize(wuffs_base__slice_u8 dst_indexes,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src,
+                                    uint32_t max_colors,
+                                    wuffs_base__slice_u8 workbuf);
+
+// --------
+
+struct wuffs_base__image_decoder__struct;
+
+// wuffs_base__frame_index_entry summarizes one frame of an animated image, as
+// recorded by wuffs_base__frame_index__build.
+//
+// A keyframe is a frame that does not depend on the frames before it: from a
+// canvas cleared to the background, decoding (and compositing) the keyframe
+// and later frames gives the same pixels as decoding every frame from the
+// first. The first frame is a keyframe, as is a frame that covers the whole
+// image and is opaque within its bounds, or one that follows a frame that
+// covers the whole image and whose disposal is to restore the background.
+typedef struct {
+  uint64_t io_position;
+  wuffs_base__rect_ie_u32 bounds;
+  wuffs_base__flicks duration;
+  wuffs_base__animation_disposal disposal;
+  bool keyframe;
+} wuffs_base__frame_index_entry;
+
+// wuffs_base__frame_index__build decodes the frame configs of an image
+// decoder (whose image config has already been decoded), recording the Nth
+// frame's entry in dst_ptr[N]. A lighter weight decoder, such as a
+// wuffs_gif__config_decoder, suffices. image_bounds should be the image
+// config's pixel config's bounds.
+//
+// It returns the number of entries recorded, which is also the number of
+// frame configs decoded so far. On a suspension, such as
+// wuffs_base__suspension__short_read, the caller can refill src and call it
+// again with the same arguments to continue building the index. On success
+// (the decoder reached the end of its frame configs), the status is OK. If
+// there are more than dst_len frames, it returns
+// wuffs_base__error__bad_argument_length_too_short.
+wuffs_base__result_u64  //
+wuffs_base__frame_index__build(struct wuffs_base__image_decoder__struct* dec,
+                               wuffs_base__frame_index_entry* dst_ptr,
+                               size_t dst_len,
+                               wuffs_base__io_buffer* src,
+                               wuffs_base__rect_ie_u32 image_bounds);
+
+// wuffs_base__frame_index__seek prepares an image decoder (whose image config
+// has already been decoded) to decode frames starting from the nearest usable
+// keyframe at or before the target frame, returning that keyframe's index K.
+// The caller then decodes frames K ..= target, compositing them onto a canvas
+// cleared to the background, as if it had decoded every frame from the first.
+//
+// A keyframe before the target is not usable if its disposal is to restore
+// the previous canvas, as that canvas depends on the frames before it.
+//
+// It calls the decoder's restart_frame method. If src is not NULL, it also
+// moves src's read index to the keyframe's I/O position, returning
+// wuffs_base__error__bad_i_o_position if src's buffered data does not include
+// that position. A caller that reads src from a seekable file can pass NULL
+// and seek the file itself.
+wuffs_base__result_u64  //
+wuffs_base__frame_index__seek(struct wuffs_base__image_decoder__struct* dec,
+                              const wuffs_base__frame_index_entry* index_ptr,
+                              size_t index_len,
+                              uint64_t target,
+                              wuffs_base__io_buffer* src);
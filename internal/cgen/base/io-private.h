@@ -59,10 +59,8 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, which
+  // copies 8 bytes at a time when there is room to write past length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -81,6 +79,12 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
 //  - distance >  0
 //  - distance <= (*ptr_iop_w - io1_w)
 //  - length   <= (io2_w      - *ptr_iop_w)
+//
+// When there are at least (length + 8) bytes available, it copies 8 bytes at
+// a time and so may write up to 7 bytes past the length bytes. Those extra
+// bytes are before io2_w but after the updated *ptr_iop_w, so they are not
+// (yet) part of the output. A distance of 1 is a memset and other distances
+// below 8 repeat an 8 byte pattern.
 static inline uint32_t  //
 wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
                                                   uint8_t* io1_w,
@@ -90,6 +94,42 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   uint8_t* p = *ptr_iop_w;
   uint8_t* q = p - distance;
   uint32_t n = length;
+  if ((size_t)(io2_w - p) >= ((size_t)(length) + 8)) {
+    uint8_t* end = p + length;
+    if (distance >= 8) {
+      // Each chunk's source ends at or before that chunk's destination
+      // starts, so it only reads bytes that have already been written.
+      do {
+        wuffs_base__store_u64le__no_bounds_check(
+            p, wuffs_base__load_u64le__no_bounds_check(q));
+        p += 8;
+        q += 8;
+      } while (p < end);
+    } else if (distance == 1) {
+      memset(p, *q, length);
+    } else {
+      // Expand the distance-byte pattern to 8 bytes, one byte at a time, and
+      // then write those 8 bytes every step bytes, where step is the largest
+      // multiple of distance that is no more than 8.
+      p[0] = q[0];
+      p[1] = q[1];
+      p[2] = q[2];
+      p[3] = q[3];
+      p[4] = q[4];
+      p[5] = q[5];
+      p[6] = q[6];
+      p[7] = q[7];
+      uint64_t x = wuffs_base__load_u64le__no_bounds_check(p);
+      uint32_t step = 8 - (8 % distance);
+      p += step;
+      while (p < end) {
+        wuffs_base__store_u64le__no_bounds_check(p, x);
+        p += step;
+      }
+    }
+    *ptr_iop_w = end;
+    return length;
+  }
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -199,6 +239,28 @@ wuffs_base__io_reader__match7(uint8_t* iop_r,
   return 0;
 }
 
+// wuffs_base__io_reader__limit sets *b to a copy of *r, synchronized to the
+// iop_r read position, that holds at most limit readable bytes, moving
+// *ptr_io2_r accordingly. If limited, the copy is not closed.
+static inline wuffs_base__io_buffer*  //
+wuffs_base__io_reader__limit(wuffs_base__io_buffer* b,
+                             wuffs_base__io_buffer* r,
+                             uint8_t* iop_r,
+                             uint8_t** ptr_io2_r,
+                             uint64_t limit) {
+  if (!r) {
+    return r;
+  }
+  *b = *r;
+  b->meta.ri = ((size_t)(iop_r - b->data.ptr));
+  if (limit < ((uint64_t)(*ptr_io2_r - iop_r))) {
+    *ptr_io2_r = iop_r + limit;
+    b->meta.wi = ((size_t)(*ptr_io2_r - b->data.ptr));
+    b->meta.closed = false;
+  }
+  return b;
+}
+
 static inline wuffs_base__io_buffer*  //
 wuffs_base__io_reader__set(wuffs_base__io_buffer* b,
                            uint8_t** ptr_iop_r,
@@ -251,6 +313,27 @@ wuffs_base__io_writer__set(wuffs_base__io_buffer* b,
   return b;
 }
 
+// wuffs_base__io_writer__limit sets *b to a copy of *w, synchronized to the
+// iop_w write position, that has room for at most limit more bytes, moving
+// *ptr_io2_w accordingly.
+static inline wuffs_base__io_buffer*  //
+wuffs_base__io_writer__limit(wuffs_base__io_buffer* b,
+                             wuffs_base__io_buffer* w,
+                             uint8_t* iop_w,
+                             uint8_t** ptr_io2_w,
+                             uint64_t limit) {
+  if (!w) {
+    return w;
+  }
+  *b = *w;
+  b->meta.wi = ((size_t)(iop_w - b->data.ptr));
+  if (limit < ((uint64_t)(*ptr_io2_w - iop_w))) {
+    *ptr_io2_w = iop_w + limit;
+    b->data.len = ((size_t)(*ptr_io2_w - b->data.ptr));
+  }
+  return b;
+}
+
   // ---------------- I/O (Utility)
 
 #define wuffs_base__utility__empty_io_reader wuffs_base__empty_io_reader
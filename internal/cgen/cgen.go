@@ -265,6 +265,8 @@ func insertBaseAllPrivateH(buf *buffer) error {
 	buf.writeb('\n')
 	buf.writes(baseStrConvPrivateH)
 	buf.writeb('\n')
+	buf.writes(baseHashPrivateH)
+	buf.writeb('\n')
 	return nil
 }
 
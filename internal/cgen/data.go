@@ -19,7 +19,7 @@ package cgen
 const baseAllImplC = "" +
 	"#ifndef WUFFS_INCLUDE_GUARD__BASE\n#define WUFFS_INCLUDE_GUARD__BASE\n\n#if defined(WUFFS_IMPLEMENTATION) && !defined(WUFFS_CONFIG__MODULES)\n#define WUFFS_CONFIG__MODULES\n#define WUFFS_CONFIG__MODULE__BASE\n#endif\n\n// !! WUFFS MONOLITHIC RELEASE DISCARDS EVERYTHING ABOVE.\n\n// !! INSERT base/copyright\n\n#include <stdbool.h>\n#include <stdint.h>\n#include <string.h>\n\n// GCC does not warn for unused *static inline* functions, but clang does.\n#ifdef __clang__\n#pragma clang diagnostic push\n#pragma clang diagnostic ignored \"-Wunused-function\"\n#endif\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// !! INSERT base/all-public.h.\n\n// !! INSERT InterfaceDeclarations.\n\n" +
 	"" +
-	"// ----------------\n\n#ifdef __cplusplus\n}  // extern \"C\"\n#endif\n\n#ifdef __clang__\n#pragma clang diagnostic pop\n#endif\n\n// WUFFS C HEADER ENDS HERE.\n#ifdef WUFFS_IMPLEMENTATION\n\n// GCC does not warn for unused *static inline* functions, but clang does.\n#ifdef __clang__\n#pragma clang diagnostic push\n#pragma clang diagnostic ignored \"-Wunused-function\"\n#endif\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// !! INSERT base/all-private.h.\n\n" +
+	"// ----------------\n\n#ifdef __cplusplus\n}  // extern \"C\"\n#endif\n\n#ifdef __clang__\n#pragma clang diagnostic pop\n#endif\n\n// WUFFS C HEADER ENDS HERE.\n#ifdef WUFFS_IMPLEMENTATION\n\n// WUFFS_BASE__CPU_ARCH__X86_64 means that the hand-written SIMD code paths,\n// which use compiler intrinsics and per-function target attributes, are\n// compiled in. Whether they are used is decided at runtime, by CPUID. Define\n// WUFFS_CONFIG__AVOID_CPU_ARCH to compile only the portable code paths.\n#if !defined(WUFFS_CONFIG__AVOID_CPU_ARCH) && defined(__GNUC__) && \\\n    defined(__x86_64__)\n#define WUFFS_BASE__CPU_ARCH__X86_64\n#include <cpuid.h>\n#include <immintrin.h>\n#endif\n\n// GCC does not warn for unused *static inline* functions, but clang does.\n#ifdef __clang__\n#pragma clang diagnostic push\n#pragma clang diagnostic ignored \"-Wunused-function\"\n#endif\n\n#ifdef __cplusplus\nextern \"C\" {\n#endif\n\n// !! INSERT base/all-private.h.\n\n" +
 	"" +
 	"// ----------------\n\n#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BASE)\n\nconst uint8_t wuffs_base__low_bits_mask__u8[9] = {\n    0x00, 0x01, 0x03, 0x07, 0x0F, 0x1F, 0x3F, 0x7F, 0xFF,\n};\n\nconst uint16_t wuffs_base__low_bits_mask__u16[17] = {\n    0x0000, 0x0001, 0x0003, 0x0007, 0x000F, 0x001F, 0x003F, 0x007F, 0x00FF,\n    0x01FF, 0x03FF, 0x07FF, 0x0FFF, 0x1FFF, 0x3FFF, 0x7FFF, 0xFFFF,\n};\n\nconst uint32_t wuffs_base__low_bits_mask__u32[33] = {\n    0x00000000, 0x00000001, 0x00000003, 0x00000007, 0x0000000F, 0x0000001F,\n    0x0000003F, 0x0000007F, 0x000000FF, 0x000001FF, 0x000003FF, 0x000007FF,\n    0x00000FFF, 0x00001FFF, 0x00003FFF, 0x00007FFF, 0x0000FFFF, 0x0001FFFF,\n    0x0003FFFF, 0x0007FFFF, 0x000FFFFF, 0x001FFFFF, 0x003FFFFF, 0x007FFFFF,\n    0x00FFFFFF, 0x01FFFFFF, 0x03FFFFFF, 0x07FFFFFF, 0x0FFFFFFF, 0x1FFFFFFF,\n    0x3FFFFFFF, 0x7FFFFFFF, 0xFFFFFFFF,\n};\n\nconst uint64_t wuffs_base__low_bits_mask__u64[65] = {\n    0x0000000000000000, 0x0000000000000001, 0x0000000000000003,\n    0x0000000000" +
 	"000007, 0x000000000000000F, 0x000000000000001F,\n    0x000000000000003F, 0x000000000000007F, 0x00000000000000FF,\n    0x00000000000001FF, 0x00000000000003FF, 0x00000000000007FF,\n    0x0000000000000FFF, 0x0000000000001FFF, 0x0000000000003FFF,\n    0x0000000000007FFF, 0x000000000000FFFF, 0x000000000001FFFF,\n    0x000000000003FFFF, 0x000000000007FFFF, 0x00000000000FFFFF,\n    0x00000000001FFFFF, 0x00000000003FFFFF, 0x00000000007FFFFF,\n    0x0000000000FFFFFF, 0x0000000001FFFFFF, 0x0000000003FFFFFF,\n    0x0000000007FFFFFF, 0x000000000FFFFFFF, 0x000000001FFFFFFF,\n    0x000000003FFFFFFF, 0x000000007FFFFFFF, 0x00000000FFFFFFFF,\n    0x00000001FFFFFFFF, 0x00000003FFFFFFFF, 0x00000007FFFFFFFF,\n    0x0000000FFFFFFFFF, 0x0000001FFFFFFFFF, 0x0000003FFFFFFFFF,\n    0x0000007FFFFFFFFF, 0x000000FFFFFFFFFF, 0x000001FFFFFFFFFF,\n    0x000003FFFFFFFFFF, 0x000007FFFFFFFFFF, 0x00000FFFFFFFFFFF,\n    0x00001FFFFFFFFFFF, 0x00003FFFFFFFFFFF, 0x00007FFFFFFFFFFF,\n    0x0000FFFFFFFFFFFF, 0x0001FFFFFFFFFFFF, 0x0003FFFFFFFFFFFF,\n    0x0007FFFFFF" +
@@ -62,7 +62,21 @@ const baseImageImplC = "" +
 	"__pixel_swizzler__copy_4_4;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:\n      switch (blend) {\n        case WUFFS_BASE__PIXEL_BLEND__SRC:\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;\n        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:\n          return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;\n      }\n      return NULL;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:\n      // TODO.\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__RGBX:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:\n    case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:\n      // TODO.\n      break;\n  }\n  return NULL;\n}\n\n" +
 	"" +
 	"// --------\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend) {\n  if (!p) {\n    return wuffs_base__make_status(wuffs_base__error__bad_receiver);\n  }\n\n  // TODO: support many more formats.\n\n  wuffs_base__pixel_swizzler__func func = NULL;\n\n  switch (src_format.repr) {\n    case WUFFS_BASE__PIXEL_FORMAT__Y:\n      func = wuffs_base__pixel_swizzler__prepare__y(p, dst_format, dst_palette,\n                                                    src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:\n      func = wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(\n          p, dst_format, dst_" +
-	"palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      func = wuffs_base__pixel_swizzler__prepare__bgr(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n  }\n\n  p->private_impl.func = func;\n  return wuffs_base__make_status(\n      func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (p && p->private_impl.func) {\n    return (*p->private_impl.func)(dst, dst_palette, src);\n  }\n  return 0;\n}\n" +
+	"palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGR:\n      func = wuffs_base__pixel_swizzler__prepare__bgr(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n\n    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:\n      func = wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(\n          p, dst_format, dst_palette, src_palette, blend);\n      break;\n  }\n\n  p->private_impl.func = func;\n  return wuffs_base__make_status(\n      func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) {\n  if (p && p->private_impl.func) {\n    return (*p->private_impl.func)(dst, dst_palette, src);\n  }\n  return 0;\n}\n\n" +
+	"" +
+	"// --------\n\ntypedef struct {\n  // begin and end are the range of the quantizer's bin list that this box\n  // holds. count is the number of pixels in those bins.\n  uint32_t begin;\n  uint32_t end;\n  uint64_t count;\n  // min_incl and max_incl are the bounds of those bins' 5-bit red, green and\n  // blue coordinates.\n  uint32_t min_incl[3];\n  uint32_t max_incl[3];\n} wuffs_base__pixel_palette__quantize__box;\n\n// wuffs_base__pixel_palette__quantize__bin returns the 15-bit histogram bin\n// (5 bits each of red, green and blue) of a BGRA pixel loaded as a uint32_t.\nstatic inline uint32_t  //\nwuffs_base__pixel_palette__quantize__bin(uint32_t c) {\n  return ((c >> 9) & 0x7C00) | ((c >> 6) & 0x03E0) | ((c >> 3) & 0x001F);\n}\n\nstatic const uint32_t wuffs_base__pixel_palette__quantize__shifts[3] = {\n    10,\n    5,\n    0,\n};\n\n// wuffs_base__pixel_palette__quantize__shrink sets b's count and bounds from\n// its bins.\nstatic void  //\nwuffs_base__pixel_palette__quantize__shrink(\n    wuffs_base__pixel_palette__quantize__box* b,\n  " +
+	"  uint8_t* counts,\n    uint8_t* list) {\n  b->count = 0;\n  int axis;\n  for (axis = 0; axis < 3; axis++) {\n    b->min_incl[axis] = 31;\n    b->max_incl[axis] = 0;\n  }\n  uint32_t k;\n  for (k = b->begin; k < b->end; k++) {\n    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));\n    b->count += wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));\n    for (axis = 0; axis < 3; axis++) {\n      uint32_t v =\n          (bin >> wuffs_base__pixel_palette__quantize__shifts[axis]) & 31;\n      if (b->min_incl[axis] > v) {\n        b->min_incl[axis] = v;\n      }\n      if (b->max_incl[axis] < v) {\n        b->max_incl[axis] = v;\n      }\n    }\n  }\n}\n\n// wuffs_base__pixel_palette__quantize__split splits b along the given axis,\n// at the population's median, moving the upper part to c.\nstatic void  //\nwuffs_base__pixel_palette__quantize__split(\n    wuffs_base__pixel_palette__quantize__box* b,\n    wuffs_base__pixel_palette__quantize__box* c,\n    int axis,\n    uint8_t* counts,\n    uint8_t* list) {\n  uint32_" +
+	"t shift = wuffs_base__pixel_palette__quantize__shifts[axis];\n  uint64_t hist[32] = {0};\n  uint32_t k;\n  for (k = b->begin; k < b->end; k++) {\n    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));\n    hist[(bin >> shift) & 31] +=\n        wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));\n  }\n\n  // Both halves are non-empty, as b has more than one coordinate value on\n  // this axis and m is in [min_incl, max_incl).\n  uint32_t m = b->min_incl[axis];\n  uint64_t n = 0;\n  for (; m < b->max_incl[axis]; m++) {\n    n += hist[m];\n    if ((2 * n) >= b->count) {\n      break;\n    }\n  }\n  if (m >= b->max_incl[axis]) {\n    m = b->max_incl[axis] - 1;\n  }\n\n  uint32_t lo = b->begin;\n  uint32_t hi = b->end;\n  while (lo < hi) {\n    uint16_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * lo));\n    if (((((uint32_t)bin) >> shift) & 31) <= m) {\n      lo++;\n      continue;\n    }\n    hi--;\n    wuffs_base__store_u16le__no_bounds_check(\n        list + (2 * lo),\n        wuffs_base__load_u16le__" +
+	"no_bounds_check(list + (2 * hi)));\n    wuffs_base__store_u16le__no_bounds_check(list + (2 * hi), bin);\n  }\n\n  c->begin = lo;\n  c->end = b->end;\n  b->end = lo;\n  wuffs_base__pixel_palette__quantize__shrink(b, counts, list);\n  wuffs_base__pixel_palette__quantize__shrink(c, counts, list);\n}\n\nwuffs_base__result_u64  //\nwuffs_base__pixel_palette__quantize(wuffs_base__slice_u8 dst_indexes,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__slice_u8 src,\n                                    uint32_t max_colors,\n                                    wuffs_base__slice_u8 workbuf) {\n  wuffs_base__result_u64 ret;\n  ret.status.repr = NULL;\n  ret.value = 0;\n\n  size_t n = src.len / 4;\n  if ((max_colors < 2) || (max_colors > 256) || ((src.len % 4) != 0)) {\n    ret.status.repr = wuffs_base__error__bad_argument;\n    return ret;\n  } else if ((dst_indexes.len < n) ||\n             (dst_palette.len < (4 * ((size_t)max_colors)))) {\n    ret.status.repr = wuffs_base__er" +
+	"ror__bad_argument_length_too_short;\n    return ret;\n  } else if (workbuf.len < WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN) {\n    ret.status.repr = wuffs_base__error__bad_workbuf_length;\n    return ret;\n  }\n\n  // The workbuf holds a uint32_t count (and later, a box index) per bin and\n  // then a uint16_t list of the occupied bins.\n  uint8_t* counts = workbuf.ptr;\n  uint8_t* list = workbuf.ptr + (4 * 32768);\n  memset(counts, 0, 4 * 32768);\n\n  bool has_transparent = false;\n  uint8_t* s = src.ptr;\n  size_t i;\n  for (i = 0; i < n; i++, s += 4) {\n    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);\n    if (c < 0x80000000) {\n      has_transparent = true;\n      continue;\n    }\n    uint8_t* p = counts + (4 * wuffs_base__pixel_palette__quantize__bin(c));\n    wuffs_base__store_u32le__no_bounds_check(\n        p, wuffs_base__load_u32le__no_bounds_check(p) + 1);\n  }\n\n  // Start with a single box holding every occupied bin. Repeatedly split the\n  // box with the largest product of population and longest side.\n" +
+	"  wuffs_base__pixel_palette__quantize__box boxes[256];\n  uint32_t n_bins = 0;\n  uint32_t bin;\n  for (bin = 0; bin < 32768; bin++) {\n    if (wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin))) {\n      wuffs_base__store_u16le__no_bounds_check(list + (2 * n_bins),\n                                               (uint16_t)bin);\n      n_bins++;\n    }\n  }\n  uint32_t n_boxes = 0;\n  if (n_bins > 0) {\n    boxes[0].begin = 0;\n    boxes[0].end = n_bins;\n    wuffs_base__pixel_palette__quantize__shrink(&boxes[0], counts, list);\n    n_boxes = 1;\n  }\n\n  uint32_t max_boxes = max_colors - (has_transparent ? 1 : 0);\n  while (n_boxes < max_boxes) {\n    uint64_t best_score = 0;\n    uint32_t best_j = 0;\n    int best_axis = 0;\n    uint32_t j;\n    for (j = 0; j < n_boxes; j++) {\n      int axis;\n      for (axis = 0; axis < 3; axis++) {\n        uint64_t score =\n            boxes[j].count * (boxes[j].max_incl[axis] - boxes[j].min_incl[axis]);\n        if (best_score < score) {\n          best_score = score;\n          best_j = j;" +
+	"\n          best_axis = axis;\n        }\n      }\n    }\n    if (best_score == 0) {\n      break;\n    }\n    wuffs_base__pixel_palette__quantize__split(\n        &boxes[best_j], &boxes[n_boxes], best_axis, counts, list);\n    n_boxes++;\n  }\n\n  // Re-purpose each bin's count to hold its box index.\n  uint32_t j;\n  for (j = 0; j < n_boxes; j++) {\n    uint32_t k;\n    for (k = boxes[j].begin; k < boxes[j].end; k++) {\n      wuffs_base__store_u32le__no_bounds_check(\n          counts + (4 * wuffs_base__load_u16le__no_bounds_check(list + (2 * k))),\n          j);\n    }\n  }\n\n  // Map each pixel to its box, accumulating each box's mean color.\n  uint64_t sums[256][4] = {{0}};\n  uint8_t transparent_index = (uint8_t)n_boxes;\n  uint8_t* d = dst_indexes.ptr;\n  for (i = 0, s = src.ptr; i < n; i++, s += 4) {\n    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);\n    if (c < 0x80000000) {\n      d[i] = transparent_index;\n      continue;\n    }\n    uint32_t k = wuffs_base__load_u32le__no_bounds_check(\n        counts + (4 * wuffs_base" +
+	"__pixel_palette__quantize__bin(c)));\n    sums[k][0] += 0xFF & (c >> 0);\n    sums[k][1] += 0xFF & (c >> 8);\n    sums[k][2] += 0xFF & (c >> 16);\n    sums[k][3]++;\n    d[i] = (uint8_t)k;\n  }\n\n  uint8_t* p = dst_palette.ptr;\n  for (j = 0; j < n_boxes; j++, p += 4) {\n    uint64_t count = sums[j][3];\n    uint64_t half = count / 2;\n    p[0] = (uint8_t)((sums[j][0] + half) / count);\n    p[1] = (uint8_t)((sums[j][1] + half) / count);\n    p[2] = (uint8_t)((sums[j][2] + half) / count);\n    p[3] = 0xFF;\n  }\n  if (has_transparent) {\n    wuffs_base__store_u32le__no_bounds_check(p, 0);\n    n_boxes++;\n  }\n\n  ret.value = n_boxes;\n  return ret;\n}\n\n" +
+	"" +
+	"// --------\n\nwuffs_base__result_u64  //\nwuffs_base__frame_index__build(wuffs_base__image_decoder* dec,\n                               wuffs_base__frame_index_entry* dst_ptr,\n                               size_t dst_len,\n                               wuffs_base__io_buffer* src,\n                               wuffs_base__rect_ie_u32 image_bounds) {\n  wuffs_base__result_u64 ret;\n  ret.status.repr = NULL;\n  ret.value = 0;\n\n  if (!dec || (!dst_ptr && (dst_len > 0)) || !src) {\n    ret.status.repr = wuffs_base__error__bad_argument;\n    return ret;\n  }\n\n  while (true) {\n    wuffs_base__frame_config fc = wuffs_base__null_frame_config();\n    wuffs_base__status status =\n        wuffs_base__image_decoder__decode_frame_config(dec, &fc, src);\n    ret.value = wuffs_base__image_decoder__num_decoded_frame_configs(dec);\n    if (status.repr == wuffs_base__note__end_of_data) {\n      break;\n    } else if (status.repr) {\n      ret.status = status;\n      break;\n    }\n\n    uint64_t i = wuffs_base__frame_config__index(&fc);\n    if " +
+	"(i >= dst_len) {\n      ret.status.repr = wuffs_base__error__bad_argument_length_too_short;\n      break;\n    }\n    wuffs_base__frame_index_entry* e = &dst_ptr[i];\n    e->io_position = wuffs_base__frame_config__io_position(&fc);\n    e->bounds = wuffs_base__frame_config__bounds(&fc);\n    e->duration = wuffs_base__frame_config__duration(&fc);\n    e->disposal = wuffs_base__frame_config__disposal(&fc);\n    if (i == 0) {\n      e->keyframe = true;\n    } else if (wuffs_base__rect_ie_u32__equals(&e->bounds, image_bounds) &&\n               wuffs_base__frame_config__opaque_within_bounds(&fc)) {\n      e->keyframe = true;\n    } else {\n      wuffs_base__frame_index_entry* prev = &dst_ptr[i - 1];\n      e->keyframe =\n          wuffs_base__rect_ie_u32__equals(&prev->bounds, image_bounds) &&\n          (prev->disposal ==\n           WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND);\n    }\n  }\n  return ret;\n}\n\nwuffs_base__result_u64  //\nwuffs_base__frame_index__seek(wuffs_base__image_decoder* dec,\n                              c" +
+	"onst wuffs_base__frame_index_entry* index_ptr,\n                              size_t index_len,\n                              uint64_t target,\n                              wuffs_base__io_buffer* src) {\n  wuffs_base__result_u64 ret;\n  ret.status.repr = NULL;\n  ret.value = 0;\n\n  if (!dec || !index_ptr) {\n    ret.status.repr = wuffs_base__error__bad_argument;\n    return ret;\n  } else if (target >= index_len) {\n    ret.status.repr = wuffs_base__error__bad_argument;\n    return ret;\n  }\n\n  uint64_t k = target;\n  while ((k > 0) && (!index_ptr[k].keyframe ||\n                     ((k < target) &&\n                      (index_ptr[k].disposal ==\n                       WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS)))) {\n    k--;\n  }\n  uint64_t pos = index_ptr[k].io_position;\n\n  if (src) {\n    if ((pos < src->meta.pos) || ((pos - src->meta.pos) > src->meta.wi)) {\n      ret.status.repr = wuffs_base__error__bad_i_o_position;\n      return ret;\n    }\n  }\n  ret.status = wuffs_base__image_decoder__restart_frame(dec, k, pos);" +
+	"\n  if (ret.status.repr) {\n    return ret;\n  }\n  if (src) {\n    src->meta.ri = (size_t)(pos - src->meta.pos);\n  }\n  ret.value = k;\n  return ret;\n}\n" +
 	""
 
 const baseStrConvImplC = "" +
@@ -137,7 +151,14 @@ const baseCorePrivateH = "" +
 	"" +
 	"// --------\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__table_u8__row(wuffs_base__table_u8 t, uint32_t y) {\n  if (y < t.height) {\n    return wuffs_base__make_slice_u8(t.ptr + (t.stride * y), t.width);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\n  " +
 	"" +
-	"// ---------------- Slices and Tables (Utility)\n\n#define wuffs_base__utility__empty_slice_u8 wuffs_base__empty_slice_u8\n" +
+	"// ---------------- Slices and Tables (Utility)\n\n#define wuffs_base__utility__empty_slice_u8 wuffs_base__empty_slice_u8\n\n" +
+	"" +
+	"// ---------------- CPU Architecture\n\n// wuffs_base__cpu_arch__x86_features caches which x86 instruction set\n// extensions are available, as a bitmask of WUFFS_BASE__CPU_ARCH__X86__ETC\n// bits. It is zero until CPUID is first consulted, after which the CHECKED bit\n// is always set. Tests and benchmarks can set it to just the CHECKED bit to\n// force the portable (non-SIMD) code paths, but must do so before starting any\n// threads that use Wuffs.\n//\n// Many threads can call wuffs_base__cpu_arch__x86_features_check at once.\n// They might all consult CPUID, but they compute the same value, and reading\n// and writing the cache with relaxed atomics (GCC and Clang builtins, like\n// the rest of WUFFS_BASE__CPU_ARCH__X86_64) avoids a data race.\n#define WUFFS_BASE__CPU_ARCH__X86__CHECKED ((uint32_t)0x80000000)\n#define WUFFS_BASE__CPU_ARCH__X86__PCLMUL ((uint32_t)0x00000001)\n#define WUFFS_BASE__CPU_ARCH__X86__SSE42 ((uint32_t)0x00000002)\n#define WUFFS_BASE__CPU_ARCH__X86__SSSE3 ((uint32_t)0x00000004)\n#define WUFFS_BASE_" +
+	"_CPU_ARCH__X86__AVX2 ((uint32_t)0x00000008)\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\nstatic uint32_t wuffs_base__cpu_arch__x86_features = 0;\n#endif\n\nstatic inline uint32_t  //\nwuffs_base__cpu_arch__x86_features_check() {\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n  uint32_t f =\n      __atomic_load_n(&wuffs_base__cpu_arch__x86_features, __ATOMIC_RELAXED);\n  if (f == 0) {\n    f = WUFFS_BASE__CPU_ARCH__X86__CHECKED;\n    unsigned int eax = 0;\n    unsigned int ebx = 0;\n    unsigned int ecx = 0;\n    unsigned int edx = 0;\n    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {\n      // ECX bit 1 is PCLMULQDQ.\n      if (ecx & 0x00000002) {\n        f |= WUFFS_BASE__CPU_ARCH__X86__PCLMUL;\n      }\n      // ECX bit 9 is SSSE3.\n      if (ecx & 0x00000200) {\n        f |= WUFFS_BASE__CPU_ARCH__X86__SSSE3;\n      }\n      // ECX bit 20 is SSE4.2.\n      if (ecx & 0x00100000) {\n        f |= WUFFS_BASE__CPU_ARCH__X86__SSE42;\n      }\n      // AVX2 also needs the OS to save and restore the YMM registers: ECX bit\n      // 27 is OSXSAVE, " +
+	"ECX bit 28 is AVX and XCR0 bits 1 and 2 are the XMM and\n      // YMM state. Leaf 7's EBX bit 5 is AVX2.\n      if (((ecx & 0x18000000) == 0x18000000) &&\n          (__get_cpuid_max(0, NULL) >= 7)) {\n        unsigned int xcr0_lo = 0;\n        unsigned int xcr0_hi = 0;\n        __asm__ __volatile__(\"xgetbv\" : \"=a\"(xcr0_lo), \"=d\"(xcr0_hi) : \"c\"(0));\n        __cpuid_count(7, 0, eax, ebx, ecx, edx);\n        if (((xcr0_lo & 6) == 6) && (ebx & 0x00000020)) {\n          f |= WUFFS_BASE__CPU_ARCH__X86__AVX2;\n        }\n      }\n    }\n    __atomic_store_n(&wuffs_base__cpu_arch__x86_features, f, __ATOMIC_RELAXED);\n  }\n  return f;\n#else\n  return 0;\n#endif\n}\n\nstatic inline bool  //\nwuffs_base__cpu_arch__have_x86_avx2() {\n  return (wuffs_base__cpu_arch__x86_features_check() &\n          WUFFS_BASE__CPU_ARCH__X86__AVX2) != 0;\n}\n\nstatic inline bool  //\nwuffs_base__cpu_arch__have_x86_pclmul() {\n  return (wuffs_base__cpu_arch__x86_features_check() &\n          WUFFS_BASE__CPU_ARCH__X86__PCLMUL) != 0;\n}\n\nstatic inline bool  //\nwuffs_bas" +
+	"e__cpu_arch__have_x86_sse42() {\n  return (wuffs_base__cpu_arch__x86_features_check() &\n          WUFFS_BASE__CPU_ARCH__X86__SSE42) != 0;\n}\n\nstatic inline bool  //\nwuffs_base__cpu_arch__have_x86_ssse3() {\n  return (wuffs_base__cpu_arch__x86_features_check() &\n          WUFFS_BASE__CPU_ARCH__X86__SSSE3) != 0;\n}\n\n" +
+	"" +
+	"// ---------------- CPU Architecture (Utility)\n\n#define wuffs_base__utility__cpu_arch_have_x86_avx2 \\\n  wuffs_base__cpu_arch__have_x86_avx2\n#define wuffs_base__utility__cpu_arch_have_x86_pclmul \\\n  wuffs_base__cpu_arch__have_x86_pclmul\n#define wuffs_base__utility__cpu_arch_have_x86_sse42 \\\n  wuffs_base__cpu_arch__have_x86_sse42\n#define wuffs_base__utility__cpu_arch_have_x86_ssse3 \\\n  wuffs_base__cpu_arch__have_x86_ssse3\n" +
 	""
 
 const baseCorePublicH = "" +
@@ -182,6 +203,30 @@ const baseCorePublicH = "" +
 	"lice if i or j is out of bounds.\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__slice_u8__subslice_ij(wuffs_base__slice_u8 s,\n                                  uint64_t i,\n                                  uint64_t j) {\n  if ((i <= j) && (j <= SIZE_MAX) && (j <= s.len)) {\n    return wuffs_base__make_slice_u8(s.ptr + i, j - i);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n" +
 	""
 
+const baseHashPrivateH = "" +
+	"// ---------------- Hashes\n\n// WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO is the number of 32-byte blocks that\n// the SIMD implementations can process before the s1 and s2 accumulators have\n// to be reduced modulo 65521. 173 is (5552 / 32), rounded down. See the \"SIMD\n// Implementations\" section of std/adler32/README.md.\n#define WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO 173\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n__attribute__((target(\"ssse3\"))) static uint32_t  //\nwuffs_base__adler32__update_x86_ssse3__impl(uint32_t s,\n                                            const uint8_t* p,\n                                            size_t n) {\n  // The taps weight each byte of a 32-byte block by how many times it is\n  // added to s2 within that block.\n  const __m128i tap0 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //\n                                     24, 23, 22, 21, 20, 19, 18, 17);\n  const __m128i tap1 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,  //\n                                     8, 7, 6, 5, 4, 3, 2, 1" +
+	");\n  const __m128i zero = _mm_setzero_si128();\n  const __m128i ones = _mm_set1_epi16(1);\n\n  uint32_t s1 = s & 0xFFFF;\n  uint32_t s2 = s >> 16;\n  while (n > 0) {\n    size_t num_blocks = n / 32;\n    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {\n      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;\n    }\n    n -= num_blocks * 32;\n\n    // v_ps accumulates the s1 value at the start of each block. Each of those\n    // is added 32 times to s2, which is applied (as a shift left by 5) after\n    // the inner loop.\n    __m128i v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * num_blocks));\n    __m128i v_s1 = zero;\n    __m128i v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);\n    do {\n      __m128i x0 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));\n      __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));\n      p += 32;\n      v_ps = _mm_add_epi32(v_ps, v_s1);\n      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x0, zero));\n      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x1, zero));\n      v_s2 = _mm_a" +
+	"dd_epi32(v_s2,\n                           _mm_madd_epi16(_mm_maddubs_epi16(x0, tap0), ones));\n      v_s2 = _mm_add_epi32(v_s2,\n                           _mm_madd_epi16(_mm_maddubs_epi16(x1, tap1), ones));\n    } while (--num_blocks);\n    v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));\n\n    // Sum the 32-bit lanes horizontally.\n    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0x4E));\n    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0xB1));\n    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0x4E));\n    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0xB1));\n    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(v_s1)) % 65521;\n    s2 = ((uint32_t)_mm_cvtsi128_si32(v_s2)) % 65521;\n  }\n  return (s2 << 16) | s1;\n}\n\n__attribute__((target(\"avx2\"))) static uint32_t  //\nwuffs_base__adler32__update_x86_avx2__impl(uint32_t s,\n                                           const uint8_t* p,\n                                           size_t n) {\n  // This is the same algorithm as the SSSE3 implementation, except t" +
+	"hat each\n  // 32-byte block fits in a single 256-bit register.\n  const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //\n                                       24, 23, 22, 21, 20, 19, 18, 17,  //\n                                       16, 15, 14, 13, 12, 11, 10, 9,   //\n                                       8, 7, 6, 5, 4, 3, 2, 1);\n  const __m256i zero = _mm256_setzero_si256();\n  const __m256i ones = _mm256_set1_epi16(1);\n\n  uint32_t s1 = s & 0xFFFF;\n  uint32_t s2 = s >> 16;\n  while (n > 0) {\n    size_t num_blocks = n / 32;\n    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {\n      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;\n    }\n    n -= num_blocks * 32;\n\n    __m256i v_ps =\n        _mm256_setr_epi32((int)(s1 * num_blocks), 0, 0, 0, 0, 0, 0, 0);\n    __m256i v_s1 = zero;\n    __m256i v_s2 = _mm256_setr_epi32((int)s2, 0, 0, 0, 0, 0, 0, 0);\n    do {\n      __m256i x = _mm256_loadu_si256((const __m256i*)(const void*)p);\n      p += 32;\n      v_ps = _mm256_add_epi32(v_ps, v_s1);\n" +
+	"      v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(x, zero));\n      v_s2 = _mm256_add_epi32(\n          v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(x, tap), ones));\n    } while (--num_blocks);\n    v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));\n\n    // Sum the 32-bit lanes horizontally.\n    __m128i w_s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1),\n                                 _mm256_extracti128_si256(v_s1, 1));\n    __m128i w_s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2),\n                                 _mm256_extracti128_si256(v_s2, 1));\n    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0x4E));\n    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0xB1));\n    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0x4E));\n    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0xB1));\n    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(w_s1)) % 65521;\n    s2 = ((uint32_t)_mm_cvtsi128_si32(w_s2)) % 65521;\n  }\n  return (s2 << 16) | s1;\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\n// wuffs_base" +
+	"__adler32__update_x86_avx2 and\n// wuffs_base__adler32__update_x86_ssse3 update the Adler-32 state s (with s1 in\n// the low 16 bits and s2 in the high 16 bits, both less than 65521) with the\n// bytes of x, using PSADBW to accumulate s1 and PMADDUBSW to accumulate s2, 32\n// bytes at a time.\n//\n// Only the first (x.len - (x.len % 32)) bytes are hashed. The caller is\n// responsible for hashing the final (x.len % 32) bytes. If the CPU does not\n// support AVX2 (or SSSE3), no bytes are hashed and s is returned unchanged.\n// Callers should check wuffs_base__cpu_arch__have_x86_avx2 (or\n// wuffs_base__cpu_arch__have_x86_ssse3) before calling these functions.\nstatic inline uint32_t  //\nwuffs_base__adler32__update_x86_avx2(uint32_t s, wuffs_base__slice_u8 x) {\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n  if (wuffs_base__cpu_arch__have_x86_avx2()) {\n    return wuffs_base__adler32__update_x86_avx2__impl(s, x.ptr,\n                                                      x.len & ~(size_t)31);\n  }\n#endif\n  return s;\n}\n\nstatic inl" +
+	"ine uint32_t  //\nwuffs_base__adler32__update_x86_ssse3(uint32_t s, wuffs_base__slice_u8 x) {\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n  if (wuffs_base__cpu_arch__have_x86_ssse3()) {\n    return wuffs_base__adler32__update_x86_ssse3__impl(s, x.ptr,\n                                                       x.len & ~(size_t)31);\n  }\n#endif\n  return s;\n}\n\n" +
+	"" +
+	"// --------\n\n// wuffs_base__crc32__ieee_fold_x86_pclmul updates the CRC-32 IEEE state s\n// (which is bit-inverted, as per std/crc32's ieee_hasher) with the bytes of x,\n// using the \"Fast CRC Computation for Generic Polynomials Using PCLMULQDQ\n// Instruction\" folding technique. See the \"SIMD Implementations\" section of\n// std/crc32/README.md.\n//\n// Only the first (x.len - (x.len % 16)) bytes are hashed. The caller is\n// responsible for hashing the final (x.len % 16) bytes. If x.len is less than\n// 64, or the CPU does not support PCLMULQDQ, no bytes are hashed and s is\n// returned unchanged. Callers should check\n// wuffs_base__cpu_arch__have_x86_pclmul before calling this function.\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n__attribute__((target(\"pclmul\"))) static uint32_t  //\nwuffs_base__crc32__ieee_fold_x86_pclmul__impl(uint32_t s,\n                                              const uint8_t* p,\n                                              size_t n) {\n  // The k1 ..= k5 constants are x**(4*128+32) mod P, x**(4" +
+	"*128-32) mod P,\n  // x**(128+32) mod P, x**(128-32) mod P and x**64 mod P, bit-reflected. mu\n  // and P' are the Barrett reduction constants. All are from the Intel paper.\n  const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);\n  const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);\n  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);\n  const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);\n  const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);\n\n  __m128i x0;\n  __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));\n  __m128i x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));\n  __m128i x3 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));\n  __m128i x4 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));\n  __m128i x5;\n  __m128i x6;\n  __m128i x7;\n  __m128i x8;\n  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)s));\n  p += 64;\n  n -= 64;\n\n  // Fold 4 x 128 bits at a time.\n  while (n >= 64) {\n    x5 = _mm_clmulepi64_si128(x1, k1k2" +
+	", 0x00);\n    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);\n    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);\n    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);\n    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);\n    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);\n    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);\n    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);\n    x1 = _mm_xor_si128(x1, x5);\n    x2 = _mm_xor_si128(x2, x6);\n    x3 = _mm_xor_si128(x3, x7);\n    x4 = _mm_xor_si128(x4, x8);\n    x5 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));\n    x6 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));\n    x7 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));\n    x8 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));\n    x1 = _mm_xor_si128(x1, x5);\n    x2 = _mm_xor_si128(x2, x6);\n    x3 = _mm_xor_si128(x3, x7);\n    x4 = _mm_xor_si128(x4, x8);\n    p += 64;\n    n -= 64;\n  }\n\n  // Fold 4 x 128 bits down to 1 x 128 bits.\n  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);\n  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x1" +
+	"1);\n  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);\n  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);\n  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);\n  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);\n  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);\n  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);\n  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);\n\n  // Fold 1 x 128 bits at a time.\n  while (n >= 16) {\n    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);\n    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);\n    x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));\n    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);\n    p += 16;\n    n -= 16;\n  }\n\n  // Fold 128 bits down to 64 bits.\n  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);\n  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);\n  x2 = _mm_srli_si128(x1, 4);\n  x1 = _mm_and_si128(x1, mask);\n  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);\n  x1 = _mm_xor_si128(x1, x2);\n\n  // Barrett reduce 64 bits down to 32 bits.\n  x2 = _mm_and_si128(x1, mask);\n  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);\n  x2 " +
+	"= _mm_and_si128(x2, mask);\n  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);\n  x1 = _mm_xor_si128(x1, x2);\n  x0 = _mm_srli_si128(x1, 4);\n  return (uint32_t)(_mm_cvtsi128_si32(x0));\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\nstatic inline uint32_t  //\nwuffs_base__crc32__ieee_fold_x86_pclmul(uint32_t s, wuffs_base__slice_u8 x) {\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n  if ((x.len >= 64) && wuffs_base__cpu_arch__have_x86_pclmul()) {\n    return wuffs_base__crc32__ieee_fold_x86_pclmul__impl(s, x.ptr,\n                                                         x.len & ~(size_t)15);\n  }\n#endif\n  return s;\n}\n\n" +
+	"" +
+	"// --------\n\n// WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG and __SHORT are the block\n// lengths for hashing three interleaved blocks in parallel. The CRC32\n// instruction has a latency of 3 cycles but a throughput of 1 per cycle, so\n// three independent dependency chains keep the CPU busy.\n#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG 8192\n#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT 256\n\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n// wuffs_base__crc32__castagnoli_shift_x86_sse42 returns the CRC-32C state s\n// after (notionally) hashing n zero bytes, without the pre- and post-inverting,\n// where k is x**(8*n - 33) modulo the Castagnoli polynomial, bit-reflected.\n// See script/print-crc32-magic-numbers.go.\n__attribute__((target(\"sse4.2,pclmul\"))) static inline uint32_t  //\nwuffs_base__crc32__castagnoli_shift_x86_sse42(uint32_t s, uint32_t k) {\n  __m128i x = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)s),\n                                   _mm_cvtsi32_si128((int)k), 0x00);\n  return (uint32_t)" +
+	"(_mm_crc32_u64(0, (uint64_t)(_mm_cvtsi128_si64(x))));\n}\n\n__attribute__((target(\"sse4.2,pclmul\"))) static uint32_t  //\nwuffs_base__crc32__castagnoli_update_x86_sse42__impl(uint32_t s,\n                                                     const uint8_t* p,\n                                                     size_t n,\n                                                     bool interleave) {\n  const size_t long_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG;\n  const size_t short_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT;\n  uint64_t s0 = s;\n  uint64_t s1 = 0;\n  uint64_t s2 = 0;\n  uint64_t v0 = 0;\n  uint64_t v1 = 0;\n  uint64_t v2 = 0;\n  const uint8_t* end = NULL;\n\n  // Align p to an 8 byte boundary.\n  while ((n > 0) && (((uintptr_t)p) & 7)) {\n    s0 = _mm_crc32_u8((uint32_t)s0, *p++);\n    n--;\n  }\n\n  // Hash three interleaved blocks in parallel, and then combine their partial\n  // checksums, first with long blocks and then with short blocks. Combining\n  // uses the PCLMULQDQ instruction, hence the int" +
+	"erleave argument.\n  if (interleave) {\n    while (n >= (3 * long_len)) {\n      s1 = 0;\n      s2 = 0;\n      end = p + long_len;\n      do {\n        memcpy(&v0, p, 8);\n        memcpy(&v1, p + long_len, 8);\n        memcpy(&v2, p + (2 * long_len), 8);\n        s0 = _mm_crc32_u64(s0, v0);\n        s1 = _mm_crc32_u64(s1, v1);\n        s2 = _mm_crc32_u64(s2, v2);\n        p += 8;\n      } while (p < end);\n      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,\n                                                         0x54A86326) ^\n           s1;\n      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,\n                                                         0x54A86326) ^\n           s2;\n      p += 2 * long_len;\n      n -= 3 * long_len;\n    }\n\n    while (n >= (3 * short_len)) {\n      s1 = 0;\n      s2 = 0;\n      end = p + short_len;\n      do {\n        memcpy(&v0, p, 8);\n        memcpy(&v1, p + short_len, 8);\n        memcpy(&v2, p + (2 * short_len), 8);\n        s0 = _mm_crc32_u64(s0, v0);\n        s1" +
+	" = _mm_crc32_u64(s1, v1);\n        s2 = _mm_crc32_u64(s2, v2);\n        p += 8;\n      } while (p < end);\n      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,\n                                                         0xB9E02B86) ^\n           s1;\n      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,\n                                                         0xB9E02B86) ^\n           s2;\n      p += 2 * short_len;\n      n -= 3 * short_len;\n    }\n  }\n\n  // Hash the remaining bytes, 8 (and then 1) at a time.\n  for (; n >= 8; n -= 8) {\n    memcpy(&v0, p, 8);\n    s0 = _mm_crc32_u64(s0, v0);\n    p += 8;\n  }\n  for (; n > 0; n--) {\n    s0 = _mm_crc32_u8((uint32_t)s0, *p++);\n  }\n  return (uint32_t)s0;\n}\n#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)\n\n// wuffs_base__crc32__castagnoli_update_x86_sse42 updates the CRC-32C state s\n// (which is bit-inverted, as per std/crc32's castagnoli_hasher) with all of\n// the bytes of x, using the SSE4.2 CRC32 instruction. Long inputs are hashed\n// as three" +
+	" interleaved streams, if the CPU also supports PCLMULQDQ.\n//\n// If the CPU does not support SSE4.2, no bytes are hashed and s is returned\n// unchanged. Callers should check wuffs_base__cpu_arch__have_x86_sse42 before\n// calling this function.\nstatic inline uint32_t  //\nwuffs_base__crc32__castagnoli_update_x86_sse42(uint32_t s,\n                                               wuffs_base__slice_u8 x) {\n#if defined(WUFFS_BASE__CPU_ARCH__X86_64)\n  if (wuffs_base__cpu_arch__have_x86_sse42()) {\n    return wuffs_base__crc32__castagnoli_update_x86_sse42__impl(\n        s, x.ptr, x.len, wuffs_base__cpu_arch__have_x86_pclmul());\n  }\n#endif\n  return s;\n}\n\n" +
+	"" +
+	"// ---------------- Hashes (Utility)\n\n#define wuffs_base__utility__adler32_update_x86_avx2 \\\n  wuffs_base__adler32__update_x86_avx2\n#define wuffs_base__utility__adler32_update_x86_ssse3 \\\n  wuffs_base__adler32__update_x86_ssse3\n#define wuffs_base__utility__crc32_castagnoli_update_x86_sse42 \\\n  wuffs_base__crc32__castagnoli_update_x86_sse42\n#define wuffs_base__utility__crc32_ieee_fold_x86_pclmul \\\n  wuffs_base__crc32__ieee_fold_x86_pclmul\n" +
+	""
+
 const baseMemoryPrivateH = "" +
 	"// ---------------- Memory Allocation\n" +
 	""
@@ -252,17 +297,28 @@ const baseImagePublicH = "" +
 	"" +
 	"// --------\n\n// TODO: should the func type take restrict pointers?\ntypedef uint64_t (*wuffs_base__pixel_swizzler__func)(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\ntypedef struct {\n  // Do not access the private_impl's fields directly. There is no API/ABI\n  // compatibility or safety guarantee if you do so.\n  struct {\n    wuffs_base__pixel_swizzler__func func;\n  } private_impl;\n\n#ifdef __cplusplus\n  inline wuffs_base__status prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend);\n  inline uint64_t swizzle_interleaved(wuffs_base__slice_u8 dst,\n                                      wuffs_base__slice_u8 dst_palette,\n                                      wuffs_base__slice_u8 src) const;\n#endi" +
 	"f  // __cplusplus\n\n} wuffs_base__pixel_swizzler;\n\nwuffs_base__status  //\nwuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,\n                                    wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src_palette,\n                                    wuffs_base__pixel_blend blend);\n\nuint64_t  //\nwuffs_base__pixel_swizzler__swizzle_interleaved(\n    const wuffs_base__pixel_swizzler* p,\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src);\n\n#ifdef __cplusplus\n\ninline wuffs_base__status  //\nwuffs_base__pixel_swizzler::prepare(wuffs_base__pixel_format dst_format,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__pixel_format src_format,\n                                    wuffs_base__slice_u8 src" +
-	"_palette,\n                                    wuffs_base__pixel_blend blend) {\n  return wuffs_base__pixel_swizzler__prepare(this, dst_format, dst_palette,\n                                             src_format, src_palette, blend);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler::swizzle_interleaved(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) const {\n  return wuffs_base__pixel_swizzler__swizzle_interleaved(this, dst, dst_palette,\n                                                         src);\n}\n\n#endif  // __cplusplus\n" +
+	"_palette,\n                                    wuffs_base__pixel_blend blend) {\n  return wuffs_base__pixel_swizzler__prepare(this, dst_format, dst_palette,\n                                             src_format, src_palette, blend);\n}\n\nuint64_t  //\nwuffs_base__pixel_swizzler::swizzle_interleaved(\n    wuffs_base__slice_u8 dst,\n    wuffs_base__slice_u8 dst_palette,\n    wuffs_base__slice_u8 src) const {\n  return wuffs_base__pixel_swizzler__swizzle_interleaved(this, dst, dst_palette,\n                                                         src);\n}\n\n#endif  // __cplusplus\n\n" +
+	"" +
+	"// --------\n\n// WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN is the length of the\n// workbuf that wuffs_base__pixel_palette__quantize needs: a 4-byte count and\n// a 2-byte list entry for each of the 32768 histogram bins.\n#define WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN 196608\n\n// wuffs_base__pixel_palette__quantize converts src's BGRA (non-premultiplied\n// alpha) pixels to palette indexes, one byte per pixel, written to\n// dst_indexes. The palette, of at most max_colors (in the range [2 ..= 256])\n// BGRA entries, is written to dst_palette. It returns the number of entries.\n//\n// It uses median cut over a histogram of 5 bits per color channel. Each\n// palette entry is the mean color of the pixels that map to it. Pixels whose\n// alpha is below 0x80 all map to one fully transparent (all zero) entry.\n// Other pixels map to fully opaque entries.\n//\n// The workbuf must be at least WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN\n// bytes long.\nwuffs_base__result_u64  //\nwuffs_base__pixel_palette__quanti" +
+	"ze(wuffs_base__slice_u8 dst_indexes,\n                                    wuffs_base__slice_u8 dst_palette,\n                                    wuffs_base__slice_u8 src,\n                                    uint32_t max_colors,\n                                    wuffs_base__slice_u8 workbuf);\n\n" +
+	"" +
+	"// --------\n\nstruct wuffs_base__image_decoder__struct;\n\n// wuffs_base__frame_index_entry summarizes one frame of an animated image, as\n// recorded by wuffs_base__frame_index__build.\n//\n// A keyframe is a frame that does not depend on the frames before it: from a\n// canvas cleared to the background, decoding (and compositing) the keyframe\n// and later frames gives the same pixels as decoding every frame from the\n// first. The first frame is a keyframe, as is a frame that covers the whole\n// image and is opaque within its bounds, or one that follows a frame that\n// covers the whole image and whose disposal is to restore the background.\ntypedef struct {\n  uint64_t io_position;\n  wuffs_base__rect_ie_u32 bounds;\n  wuffs_base__flicks duration;\n  wuffs_base__animation_disposal disposal;\n  bool keyframe;\n} wuffs_base__frame_index_entry;\n\n// wuffs_base__frame_index__build decodes the frame configs of an image\n// decoder (whose image config has already been decoded), recording the Nth\n// frame's entry in dst_ptr[N]. A " +
+	"lighter weight decoder, such as a\n// wuffs_gif__config_decoder, suffices. image_bounds should be the image\n// config's pixel config's bounds.\n//\n// It returns the number of entries recorded, which is also the number of\n// frame configs decoded so far. On a suspension, such as\n// wuffs_base__suspension__short_read, the caller can refill src and call it\n// again with the same arguments to continue building the index. On success\n// (the decoder reached the end of its frame configs), the status is OK. If\n// there are more than dst_len frames, it returns\n// wuffs_base__error__bad_argument_length_too_short.\nwuffs_base__result_u64  //\nwuffs_base__frame_index__build(struct wuffs_base__image_decoder__struct* dec,\n                               wuffs_base__frame_index_entry* dst_ptr,\n                               size_t dst_len,\n                               wuffs_base__io_buffer* src,\n                               wuffs_base__rect_ie_u32 image_bounds);\n\n// wuffs_base__frame_index__seek prepares an image decoder (wh" +
+	"ose image config\n// has already been decoded) to decode frames starting from the nearest usable\n// keyframe at or before the target frame, returning that keyframe's index K.\n// The caller then decodes frames K ..= target, compositing them onto a canvas\n// cleared to the background, as if it had decoded every frame from the first.\n//\n// A keyframe before the target is not usable if its disposal is to restore\n// the previous canvas, as that canvas depends on the frames before it.\n//\n// It calls the decoder's restart_frame method. If src is not NULL, it also\n// moves src's read index to the keyframe's I/O position, returning\n// wuffs_base__error__bad_i_o_position if src's buffered data does not include\n// that position. A caller that reads src from a seekable file can pass NULL\n// and seek the file itself.\nwuffs_base__result_u64  //\nwuffs_base__frame_index__seek(struct wuffs_base__image_decoder__struct* dec,\n                              const wuffs_base__frame_index_entry* index_ptr,\n                           " +
+	"   size_t index_len,\n                              uint64_t target,\n                              wuffs_base__io_buffer* src);\n" +
 	""
 
 const baseIOPrivateH = "" +
 	"// ---------------- I/O\n\nstatic inline uint64_t  //\nwuffs_base__io__count_since(uint64_t mark, uint64_t index) {\n  if (index >= mark) {\n    return index - mark;\n  }\n  return 0;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io__since(uint64_t mark, uint64_t index, uint8_t* ptr) {\n  if (index >= mark) {\n    return wuffs_base__make_slice_u8(ptr + mark, index - mark);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,\n                                             uint8_t* io1_w,\n                                             uint8_t* io2_w,\n                                             uint32_t length,\n                                             uint32_t distance) {\n  if (!distance) {\n    return 0;\n  }\n  uint8_t* p = *ptr_iop_w;\n  if ((size_t)(p - io1_w) < (size_t)(distance)) {\n    return 0;\n  }\n  uint8_t* q = p - distance;\n  size_t n = (size_t)(io2_w - p);\n  if ((size_t)(length) > n) {\n    length = (uint32_t)(n);\n " +
-	" } else {\n    n = (size_t)(length);\n  }\n  // TODO: unrolling by 3 seems best for the std/deflate benchmarks, but that\n  // is mostly because 3 is the minimum length for the deflate format. This\n  // function implementation shouldn't overfit to that one format. Perhaps the\n  // copy_n32_from_history Wuffs method should also take an unroll hint\n  // argument, and the cgen can look if that argument is the constant\n  // expression '3'.\n  //\n  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.\n  //\n  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method\n  // that copies 8 bytes at a time, possibly writing more than length bytes?\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\n// wuffs_base__io_writer__copy_n32_from_history_fast is like the\n// wuffs_base__io_writer__copy_n32_from_history function above, but has\n// stronger pre-conditions. The caller needs to prove" +
-	" that:\n//  - distance >  0\n//  - distance <= (*ptr_iop_w - io1_w)\n//  - length   <= (io2_w      - *ptr_iop_w)\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,\n                                                  uint8_t* io1_w,\n                                                  uint8_t* io2_w,\n                                                  uint32_t length,\n                                                  uint32_t distance) {\n  uint8_t* p = *ptr_iop_w;\n  uint8_t* q = p - distance;\n  uint32_t n = length;\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,\n                                            uint8_t* io2_w,\n                                            uint32_t length,\n                                            uint8_t** ptr_iop_r,\n                             " +
-	"               uint8_t* io2_r) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = length;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  uint8_t* iop_r = *ptr_iop_r;\n  if (n > ((size_t)(io2_r - iop_r))) {\n    n = (size_t)(io2_r - iop_r);\n  }\n  if (n > 0) {\n    memmove(iop_w, iop_r, n);\n    *ptr_iop_w += n;\n    *ptr_iop_r += n;\n  }\n  return (uint32_t)(n);\n}\n\nstatic inline uint64_t  //\nwuffs_base__io_writer__copy_from_slice(uint8_t** ptr_iop_w,\n                                       uint8_t* io2_w,\n                                       wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint64_t)(n);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_slice(uint8_t** ptr_iop_w,\n                                           uint8_t* io2_w,\n                                           uint32_t" +
-	" length,\n                                           wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > length) {\n    n = length;\n  }\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint32_t)(n);\n}\n\n// wuffs_base__io_reader__match7 returns whether the io_reader's upcoming bytes\n// start with the given prefix (up to 7 bytes long). It is peek-like, not\n// read-like, in that there are no side-effects.\n//\n// The low 3 bits of a hold the prefix length, n.\n//\n// The high 56 bits of a hold the prefix itself, in little-endian order. The\n// first prefix byte is in bits 8..=15, the second prefix byte is in bits\n// 16..=23, etc. The high (8 * (7 - n)) bits are ignored.\n//\n// There are three possible return values:\n//  - 0 means success.\n//  - 1 means inconclusive, equivalent to \"$short read\".\n//  - 2 means failure.\nstatic inline uint32_t  //\nwuffs_base__io_reader__match7(ui" +
-	"nt8_t* iop_r,\n                              uint8_t* io2_r,\n                              wuffs_base__io_buffer* r,\n                              uint64_t a) {\n  uint32_t n = a & 7;\n  a >>= 8;\n  if ((io2_r - iop_r) >= 8) {\n    uint64_t x = wuffs_base__load_u64le__no_bounds_check(iop_r);\n    uint32_t shift = 8 * (8 - n);\n    return ((a << shift) == (x << shift)) ? 0 : 2;\n  }\n  for (; n > 0; n--) {\n    if (iop_r >= io2_r) {\n      return (r && r->meta.closed) ? 2 : 1;\n    } else if (*iop_r != ((uint8_t)(a))) {\n      return 2;\n    }\n    iop_r++;\n    a >>= 8;\n  }\n  return 0;\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_reader__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_r,\n                           uint8_t** ptr_io0_r,\n                           uint8_t** ptr_io1_r,\n                           uint8_t** ptr_io2_r,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = data.len;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = fal" +
-	"se;\n\n  *ptr_iop_r = data.ptr;\n  *ptr_io0_r = data.ptr;\n  *ptr_io1_r = data.ptr;\n  *ptr_io2_r = data.ptr + data.len;\n\n  return b;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io_reader__take(uint8_t** ptr_iop_r, uint8_t* io2_r, uint64_t n) {\n  if (n <= ((size_t)(io2_r - *ptr_iop_r))) {\n    uint8_t* p = *ptr_iop_r;\n    *ptr_iop_r += n;\n    return wuffs_base__make_slice_u8(p, n);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_writer__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_w,\n                           uint8_t** ptr_io0_w,\n                           uint8_t** ptr_io1_w,\n                           uint8_t** ptr_io2_w,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = 0;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = false;\n\n  *ptr_iop_w = data.ptr;\n  *ptr_io0_w = data.ptr;\n  *ptr_io1_w = data.ptr;\n  *ptr_io2_w = data.ptr + data.len;\n\n  return b;\n}\n\n  " +
+	" } else {\n    n = (size_t)(length);\n  }\n  // TODO: unrolling by 3 seems best for the std/deflate benchmarks, but that\n  // is mostly because 3 is the minimum length for the deflate format. This\n  // function implementation shouldn't overfit to that one format. Perhaps the\n  // copy_n32_from_history Wuffs method should also take an unroll hint\n  // argument, and the cgen can look if that argument is the constant\n  // expression '3'.\n  //\n  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, which\n  // copies 8 bytes at a time when there is room to write past length bytes.\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\n// wuffs_base__io_writer__copy_n32_from_history_fast is like the\n// wuffs_base__io_writer__copy_n32_from_history function above, but has\n// stronger pre-conditions. The caller needs to prove that:\n//  - distance >  0\n//  - distance <= (*ptr_iop_w - io1_w)\n//  - length " +
+	"  <= (io2_w      - *ptr_iop_w)\n//\n// When there are at least (length + 8) bytes available, it copies 8 bytes at\n// a time and so may write up to 7 bytes past the length bytes. Those extra\n// bytes are before io2_w but after the updated *ptr_iop_w, so they are not\n// (yet) part of the output. A distance of 1 is a memset and other distances\n// below 8 repeat an 8 byte pattern.\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,\n                                                  uint8_t* io1_w,\n                                                  uint8_t* io2_w,\n                                                  uint32_t length,\n                                                  uint32_t distance) {\n  uint8_t* p = *ptr_iop_w;\n  uint8_t* q = p - distance;\n  uint32_t n = length;\n  if ((size_t)(io2_w - p) >= ((size_t)(length) + 8)) {\n    uint8_t* end = p + length;\n    if (distance >= 8) {\n      // Each chunk's source ends at or before that chunk's destination\n      // starts," +
+	" so it only reads bytes that have already been written.\n      do {\n        wuffs_base__store_u64le__no_bounds_check(\n            p, wuffs_base__load_u64le__no_bounds_check(q));\n        p += 8;\n        q += 8;\n      } while (p < end);\n    } else if (distance == 1) {\n      memset(p, *q, length);\n    } else {\n      // Expand the distance-byte pattern to 8 bytes, one byte at a time, and\n      // then write those 8 bytes every step bytes, where step is the largest\n      // multiple of distance that is no more than 8.\n      p[0] = q[0];\n      p[1] = q[1];\n      p[2] = q[2];\n      p[3] = q[3];\n      p[4] = q[4];\n      p[5] = q[5];\n      p[6] = q[6];\n      p[7] = q[7];\n      uint64_t x = wuffs_base__load_u64le__no_bounds_check(p);\n      uint32_t step = 8 - (8 % distance);\n      p += step;\n      while (p < end) {\n        wuffs_base__store_u64le__no_bounds_check(p, x);\n        p += step;\n      }\n    }\n    *ptr_iop_w = end;\n    return length;\n  }\n  for (; n >= 3; n -= 3) {\n    *p++ = *q++;\n    *p++ = *q++;\n    *p++ = *q" +
+	"++;\n  }\n  for (; n; n--) {\n    *p++ = *q++;\n  }\n  *ptr_iop_w = p;\n  return length;\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_reader(uint8_t** ptr_iop_w,\n                                            uint8_t* io2_w,\n                                            uint32_t length,\n                                            uint8_t** ptr_iop_r,\n                                            uint8_t* io2_r) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = length;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  uint8_t* iop_r = *ptr_iop_r;\n  if (n > ((size_t)(io2_r - iop_r))) {\n    n = (size_t)(io2_r - iop_r);\n  }\n  if (n > 0) {\n    memmove(iop_w, iop_r, n);\n    *ptr_iop_w += n;\n    *ptr_iop_r += n;\n  }\n  return (uint32_t)(n);\n}\n\nstatic inline uint64_t  //\nwuffs_base__io_writer__copy_from_slice(uint8_t** ptr_iop_w,\n                                       uint8_t* io2_w,\n                                       wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  siz" +
+	"e_t n = src.len;\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint64_t)(n);\n}\n\nstatic inline uint32_t  //\nwuffs_base__io_writer__copy_n32_from_slice(uint8_t** ptr_iop_w,\n                                           uint8_t* io2_w,\n                                           uint32_t length,\n                                           wuffs_base__slice_u8 src) {\n  uint8_t* iop_w = *ptr_iop_w;\n  size_t n = src.len;\n  if (n > length) {\n    n = length;\n  }\n  if (n > ((size_t)(io2_w - iop_w))) {\n    n = (size_t)(io2_w - iop_w);\n  }\n  if (n > 0) {\n    memmove(iop_w, src.ptr, n);\n    *ptr_iop_w += n;\n  }\n  return (uint32_t)(n);\n}\n\n// wuffs_base__io_reader__match7 returns whether the io_reader's upcoming bytes\n// start with the given prefix (up to 7 bytes long). It is peek-like, not\n// read-like, in that there are no side-effects.\n//\n// The low 3 bits of a hold the prefix length, n.\n//\n// The high 56 bits of a" +
+	" hold the prefix itself, in little-endian order. The\n// first prefix byte is in bits 8..=15, the second prefix byte is in bits\n// 16..=23, etc. The high (8 * (7 - n)) bits are ignored.\n//\n// There are three possible return values:\n//  - 0 means success.\n//  - 1 means inconclusive, equivalent to \"$short read\".\n//  - 2 means failure.\nstatic inline uint32_t  //\nwuffs_base__io_reader__match7(uint8_t* iop_r,\n                              uint8_t* io2_r,\n                              wuffs_base__io_buffer* r,\n                              uint64_t a) {\n  uint32_t n = a & 7;\n  a >>= 8;\n  if ((io2_r - iop_r) >= 8) {\n    uint64_t x = wuffs_base__load_u64le__no_bounds_check(iop_r);\n    uint32_t shift = 8 * (8 - n);\n    return ((a << shift) == (x << shift)) ? 0 : 2;\n  }\n  for (; n > 0; n--) {\n    if (iop_r >= io2_r) {\n      return (r && r->meta.closed) ? 2 : 1;\n    } else if (*iop_r != ((uint8_t)(a))) {\n      return 2;\n    }\n    iop_r++;\n    a >>= 8;\n  }\n  return 0;\n}\n\n// wuffs_base__io_reader__limit sets *b to a copy o" +
+	"f *r, synchronized to the\n// iop_r read position, that holds at most limit readable bytes, moving\n// *ptr_io2_r accordingly. If limited, the copy is not closed.\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_reader__limit(wuffs_base__io_buffer* b,\n                             wuffs_base__io_buffer* r,\n                             uint8_t* iop_r,\n                             uint8_t** ptr_io2_r,\n                             uint64_t limit) {\n  if (!r) {\n    return r;\n  }\n  *b = *r;\n  b->meta.ri = ((size_t)(iop_r - b->data.ptr));\n  if (limit < ((uint64_t)(*ptr_io2_r - iop_r))) {\n    *ptr_io2_r = iop_r + limit;\n    b->meta.wi = ((size_t)(*ptr_io2_r - b->data.ptr));\n    b->meta.closed = false;\n  }\n  return b;\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_reader__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_r,\n                           uint8_t** ptr_io0_r,\n                           uint8_t** ptr_io1_r,\n                           uint8_t** ptr_io2_r,\n           " +
+	"                wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = data.len;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = false;\n\n  *ptr_iop_r = data.ptr;\n  *ptr_io0_r = data.ptr;\n  *ptr_io1_r = data.ptr;\n  *ptr_io2_r = data.ptr + data.len;\n\n  return b;\n}\n\nstatic inline wuffs_base__slice_u8  //\nwuffs_base__io_reader__take(uint8_t** ptr_iop_r, uint8_t* io2_r, uint64_t n) {\n  if (n <= ((size_t)(io2_r - *ptr_iop_r))) {\n    uint8_t* p = *ptr_iop_r;\n    *ptr_iop_r += n;\n    return wuffs_base__make_slice_u8(p, n);\n  }\n  return wuffs_base__make_slice_u8(NULL, 0);\n}\n\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_writer__set(wuffs_base__io_buffer* b,\n                           uint8_t** ptr_iop_w,\n                           uint8_t** ptr_io0_w,\n                           uint8_t** ptr_io1_w,\n                           uint8_t** ptr_io2_w,\n                           wuffs_base__slice_u8 data) {\n  b->data = data;\n  b->meta.wi = 0;\n  b->meta.ri = 0;\n  b->meta.pos = 0;\n  b->meta.closed = fa" +
+	"lse;\n\n  *ptr_iop_w = data.ptr;\n  *ptr_io0_w = data.ptr;\n  *ptr_io1_w = data.ptr;\n  *ptr_io2_w = data.ptr + data.len;\n\n  return b;\n}\n\n// wuffs_base__io_writer__limit sets *b to a copy of *w, synchronized to the\n// iop_w write position, that has room for at most limit more bytes, moving\n// *ptr_io2_w accordingly.\nstatic inline wuffs_base__io_buffer*  //\nwuffs_base__io_writer__limit(wuffs_base__io_buffer* b,\n                             wuffs_base__io_buffer* w,\n                             uint8_t* iop_w,\n                             uint8_t** ptr_io2_w,\n                             uint64_t limit) {\n  if (!w) {\n    return w;\n  }\n  *b = *w;\n  b->meta.wi = ((size_t)(iop_w - b->data.ptr));\n  if (limit < ((uint64_t)(*ptr_io2_w - iop_w))) {\n    *ptr_io2_w = iop_w + limit;\n    b->data.len = ((size_t)(*ptr_io2_w - b->data.ptr));\n  }\n  return b;\n}\n\n  " +
 	"" +
 	"// ---------------- I/O (Utility)\n\n#define wuffs_base__utility__empty_io_reader wuffs_base__empty_io_reader\n#define wuffs_base__utility__empty_io_writer wuffs_base__empty_io_writer\n" +
 	""
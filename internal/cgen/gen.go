@@ -79,6 +79,7 @@ func genBase(out *bytes.Buffer) error {
 
 		{"base/core-private.h", "baseCorePrivateH"},
 		{"base/core-public.h", "baseCorePublicH"},
+		{"base/hash-private.h", "baseHashPrivateH"},
 		{"base/memory-private.h", "baseMemoryPrivateH"},
 		{"base/memory-public.h", "baseMemoryPublicH"},
 		{"base/image-private.h", "baseImagePrivateH"},
@@ -273,7 +273,7 @@ func (g *gen) writeStatementIOBind(b *buffer, n *a.IOBind, depth uint32) error {
 		// TODO: save / restore all iop vars, not just for local IO vars? How
 		// does this work if the io_bind body advances these pointers, either
 		// directly or by calling other funcs?
-		if e.Operator() == 0 {
+		if (e.Operator() == 0) && (n.Keyword() == t.IDIOBind) {
 			b.printf("uint8_t *%s%d_%s%s%s = %s%s%s;\n",
 				oPrefix, ioBindNum, iopPrefix, prefix, name, iopPrefix, prefix, name)
 			b.printf("uint8_t *%s%d_%s%s%s = %s%s%s;\n",
@@ -294,7 +294,19 @@ func (g *gen) writeStatementIOBind(b *buffer, n *a.IOBind, depth uint32) error {
 			b.writes(");\n")
 
 		} else {
-			return fmt.Errorf("TODO: implement io_limit (or remove it from the parser)")
+			// The limited io_buffer is a copy of the original one (sharing
+			// the same data), with its upper bound pulled in.
+			b.printf("wuffs_base__io_buffer %s%d_%s%s%s;\n",
+				oPrefix, ioBindNum, uPrefix, prefix, name)
+			b.printf("uint8_t *%s%d_%s%s%s = %s%s%s;\n",
+				oPrefix, ioBindNum, io2Prefix, prefix, name, io2Prefix, prefix, name)
+			b.printf("%s%s = wuffs_base__io_%s__limit(&%s%d_%s%s%s, %s%s, %s%s%s, &%s%s%s,",
+				prefix, name, cTyp, oPrefix, ioBindNum, uPrefix, prefix, name, prefix, name,
+				iopPrefix, prefix, name, io2Prefix, prefix, name)
+			if err := g.writeExpr(b, n.Arg1(), 0); err != nil {
+				return err
+			}
+			b.writes(");\n")
 		}
 	}
 
@@ -313,7 +325,10 @@ func (g *gen) writeStatementIOBind(b *buffer, n *a.IOBind, depth uint32) error {
 		name := e.Ident().Str(g.tm)
 		b.printf("%s%s = %s%d_%s%s;\n",
 			prefix, name, oPrefix, ioBindNum, prefix, name)
-		if e.Operator() == 0 {
+		if n.Keyword() == t.IDIOLimit {
+			b.printf("%s%s%s = %s%d_%s%s%s;\n",
+				io2Prefix, prefix, name, oPrefix, ioBindNum, io2Prefix, prefix, name)
+		} else if e.Operator() == 0 {
 			b.printf("%s%s%s = %s%d_%s%s%s;\n",
 				iopPrefix, prefix, name, oPrefix, ioBindNum, iopPrefix, prefix, name)
 			b.printf("%s%s%s = %s%d_%s%s%s;\n",
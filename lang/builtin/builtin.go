@@ -125,6 +125,14 @@ var Funcs = []string{
 
 	// ---- utility
 
+	"utility.adler32_update_x86_avx2(s: u32, x: slice u8) u32",
+	"utility.adler32_update_x86_ssse3(s: u32, x: slice u8) u32",
+	"utility.cpu_arch_have_x86_avx2() bool",
+	"utility.cpu_arch_have_x86_pclmul() bool",
+	"utility.cpu_arch_have_x86_sse42() bool",
+	"utility.cpu_arch_have_x86_ssse3() bool",
+	"utility.crc32_castagnoli_update_x86_sse42(s: u32, x: slice u8) u32",
+	"utility.crc32_ieee_fold_x86_pclmul(s: u32, x: slice u8) u32",
 	"utility.empty_io_reader() io_reader",
 	"utility.empty_io_writer() io_writer",
 	"utility.empty_range_ii_u32() range_ii_u32",
@@ -250,9 +250,30 @@ func (q *checker) bcheckStatement(n *a.Node) error {
 		if _, err := q.bcheckExpr(n.Arg1(), 0); err != nil {
 			return err
 		}
+		// For io_limit, drop any facts involving the limited io, such as how
+		// many bytes it has available, both on entry and on exit. Inside the
+		// body, the limit pulls in its upper bound. After the body, the
+		// original io's reader or writer position has moved.
+		dropIOFacts := func() error {
+			if n.Keyword() != t.IDIOLimit {
+				return nil
+			}
+			return q.facts.update(func(x *a.Expr) (*a.Expr, error) {
+				if x.Mentions(n.IO()) {
+					return nil, nil
+				}
+				return x, nil
+			})
+		}
+		if err := dropIOFacts(); err != nil {
+			return err
+		}
 		if err := q.bcheckBlock(n.Body()); err != nil {
 			return err
 		}
+		if err := dropIOFacts(); err != nil {
+			return err
+		}
 		// TODO: invalidate any facts regarding the io_bind expressions.
 
 	case a.KIf:
@@ -787,7 +808,13 @@ func (q *checker) bcheckExpr(n *a.Expr, depth uint32) (bounds, error) {
 
 func bcheckExprConstValue(n *a.Expr) bounds {
 	if o := n.LHS(); o != nil {
-		bcheckExprConstValue(o.AsExpr())
+		if n.Operator() == t.IDDot {
+			// An imported const, "foo.bar". The package name, foo, has no
+			// value of its own.
+			o.SetMBounds(bounds{zero, zero})
+		} else {
+			bcheckExprConstValue(o.AsExpr())
+		}
 	}
 	if o := n.MHS(); o != nil {
 		bcheckExprConstValue(o.AsExpr())
@@ -827,7 +854,7 @@ func (q *checker) bcheckExprOther(n *a.Expr, depth uint32) (bounds, error) {
 		//
 		// TODO: look up "foo[i]" const expressions.
 		//
-		// TODO: allow imported consts, "foo.bar", not just "bar"?
+		// Imported consts, "foo.bar", have a ConstValue set by tcheckDot.
 		qid := t.QID{0, n.Ident()}
 		if c, ok := q.c.consts[qid]; ok {
 			if cv := c.Value().ConstValue(); cv != nil {
@@ -323,3 +323,86 @@ func TestBuiltInTypeMap(tt *testing.T) {
 		}
 	}
 }
+
+func TestIOLimitBody(tt *testing.T) {
+	const filename = "test.wuffs"
+	testCases := []struct {
+		body    string
+		wantErr string
+	}{{
+		// Without an io_limit, the available() fact carries into the write.
+		body: `
+			if args.dst.available() >= 8 {
+				args.dst.write_fast_u64le!(a: 0)
+			}
+		`,
+		wantErr: "",
+	}, {
+		// Inside an io_limit body, facts must be re-established.
+		body: `
+			io_limit (io: args.dst, limit: (1 as base.u64)) {
+				if args.dst.available() >= 8 {
+					args.dst.write_fast_u64le!(a: 0)
+				}
+			}
+		`,
+		wantErr: "",
+	}, {
+		// The limit pulls in args.dst's upper bound, so the outer fact
+		// does not hold inside the body.
+		body: `
+			if args.dst.available() >= 8 {
+				io_limit (io: args.dst, limit: (1 as base.u64)) {
+					args.dst.write_fast_u64le!(a: 0)
+				}
+			}
+		`,
+		wantErr: "could not prove write_fast_u64le pre-condition",
+	}, {
+		// The body may have written to args.dst, so the outer fact does not
+		// hold after the body either.
+		body: `
+			if args.dst.available() >= 8 {
+				io_limit (io: args.dst, limit: (1 as base.u64)) {
+				}
+				args.dst.write_fast_u64le!(a: 0)
+			}
+		`,
+		wantErr: "could not prove write_fast_u64le pre-condition",
+	}, {
+		body: `
+			io_limit (io: args.dst, limit: (1 as base.u64)) {
+				return 0
+			}
+		`,
+		wantErr: "io_limit body cannot return or yield",
+	}}
+
+	tm := &t.Map{}
+	for _, tc := range testCases {
+		src := "pri func foo!(dst : base.io_writer) base.u32 {\n" + tc.body + "\n}\n"
+
+		tokens, _, err := t.Tokenize(tm, filename, []byte(src))
+		if err != nil {
+			tt.Errorf("%q: Tokenize: %v", tc.body, err)
+			continue
+		}
+
+		file, err := parse.Parse(tm, filename, tokens, nil)
+		if err != nil {
+			tt.Errorf("%q: Parse: %v", tc.body, err)
+			continue
+		}
+
+		_, err = Check(tm, []*a.File{file}, nil)
+		if tc.wantErr == "" {
+			if err != nil {
+				tt.Errorf("%q: Check: %v", tc.body, err)
+			}
+		} else if err == nil {
+			tt.Errorf("%q: Check: got nil error, want %q", tc.body, tc.wantErr)
+		} else if !strings.Contains(err.Error(), tc.wantErr) {
+			tt.Errorf("%q: Check: got %v, want %q", tc.body, err, tc.wantErr)
+		}
+	}
+}
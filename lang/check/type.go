@@ -115,6 +115,11 @@ func (q *checker) tcheckStatement(n *a.Node) error {
 				return err
 			}
 		}
+		if n.Keyword() == t.IDIOLimit {
+			if err := q.tcheckIOLimitBody(n); err != nil {
+				return err
+			}
+		}
 
 	case a.KIterate:
 		for n := n.AsIterate(); n != nil; n = n.ElseIterate() {
@@ -221,6 +226,43 @@ func (q *checker) tcheckStatement(n *a.Node) error {
 	return nil
 }
 
+// tcheckIOLimitBody rejects io_limit bodies that could leave the io_limit
+// block other than by falling off its end, as the generated C code restores
+// the original (unlimited) io_buffer only there. Returning, yielding,
+// jumping to a loop outside of the body or suspending on a coroutine call all
+// would skip that. Calling a coroutine via "=?" is OK: its status is only
+// assigned, not acted upon.
+func (q *checker) tcheckIOLimitBody(n *a.IOBind) error {
+	loops := map[*a.Node]bool{}
+	tryCalls := map[*a.Node]bool{}
+	for _, o := range n.Body() {
+		if err := o.Walk(func(o *a.Node) error {
+			switch o.Kind() {
+			case a.KIterate, a.KWhile:
+				loops[o] = true
+			case a.KAssign:
+				if o := o.AsAssign(); o.Operator() == t.IDEqQuestion {
+					tryCalls[o.RHS().AsNode()] = true
+				}
+			case a.KExpr:
+				if o.AsExpr().Effect().Coroutine() && !tryCalls[o] {
+					return fmt.Errorf("check: io_limit body cannot suspend")
+				}
+			case a.KJump:
+				if jt := o.AsJump().JumpTarget(); (jt == nil) || !loops[jt.AsNode()] {
+					return fmt.Errorf("check: io_limit body cannot jump outside of that body")
+				}
+			case a.KRet:
+				return fmt.Errorf("check: io_limit body cannot return or yield")
+			}
+			return nil
+		}); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
 func (q *checker) tcheckAssert(n *a.Assert) error {
 	cond := n.Condition()
 	if err := q.tcheckExpr(cond, 0); err != nil {
@@ -502,6 +544,33 @@ func (q *checker) tcheckExprOther(n *a.Expr, depth uint32) error {
 		n.Operator(), n.Str(q.tm))
 }
 
+// tcheckImportedConst looks for an imported const, "foo.bar", where foo is the
+// base name of a used package (and not a local variable). It returns whether
+// n was such an expression.
+func (q *checker) tcheckImportedConst(n *a.Expr, pkg t.ID) (done bool, err error) {
+	if _, ok := q.localVars[pkg]; ok {
+		return false, nil
+	} else if _, ok := q.c.useBaseNames[pkg]; !ok {
+		return false, nil
+	}
+	c, ok := q.c.consts[t.QID{pkg, n.Ident()}]
+	if !ok {
+		return true, fmt.Errorf("check: no const %q in package %q",
+			n.Ident().Str(q.tm), pkg.Str(q.tm))
+	}
+	cv := c.Value().ConstValue()
+	if cv == nil {
+		return true, fmt.Errorf("check: const %q is not a constant value", n.Str(q.tm))
+	}
+	n.SetConstValue(cv)
+	n.SetMType(c.XType())
+
+	// The package name has no value of its own, and n's ConstValue means that
+	// cgen does not look at it, but every checked expression needs a type.
+	n.LHS().AsExpr().SetMType(typeExprEmptyStruct)
+	return true, nil
+}
+
 func (q *checker) tcheckExprCall(n *a.Expr, depth uint32) error {
 	lhs := n.LHS().AsExpr()
 	if err := q.tcheckExpr(lhs, depth); err != nil {
@@ -577,6 +646,11 @@ func (q *checker) tcheckExprCall(n *a.Expr, depth uint32) error {
 
 func (q *checker) tcheckDot(n *a.Expr, depth uint32) error {
 	lhs := n.LHS().AsExpr()
+	if lhs.Operator() == 0 {
+		if done, err := q.tcheckImportedConst(n, lhs.Ident()); done {
+			return err
+		}
+	}
 	if err := q.tcheckExpr(lhs, depth); err != nil {
 		return err
 	}
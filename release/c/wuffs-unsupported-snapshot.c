@@ -3401,6 +3401,94 @@ wuffs_base__pixel_swizzler::swizzle_interleaved(
 
 #endif  // __cplusplus
 
+// --------
+
+// WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN is the length of the
+// workbuf that wuffs_base__pixel_palette__quantize needs: a 4-byte count and
+// a 2-byte list entry for each of the 32768 histogram bins.
+#define WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN 196608
+
+// wuffs_base__pixel_palette__quantize converts src's BGRA (non-premultiplied
+// alpha) pixels to palette indexes, one byte per pixel, written to
+// dst_indexes. The palette, of at most max_colors (in the range [2 ..= 256])
+// BGRA entries, is written to dst_palette. It returns the number of entries.
+//
+// It uses median cut over a histogram of 5 bits per color channel. Each
+// palette entry is the mean color of the pixels that map to it. Pixels whose
+// alpha is below 0x80 all map to one fully transparent (all zero) entry.
+// Other pixels map to fully opaque entries.
+//
+// The workbuf must be at least WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN
+// bytes long.
+wuffs_base__result_u64  //
+wuffs_base__pixel_palette__quantize(wuffs_base__slice_u8 dst_indexes,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src,
+                                    uint32_t max_colors,
+                                    wuffs_base__slice_u8 workbuf);
+
+// --------
+
+struct wuffs_base__image_decoder__struct;
+
+// wuffs_base__frame_index_entry summarizes one frame of an animated image, as
+// recorded by wuffs_base__frame_index__build.
+//
+// A keyframe is a frame that does not depend on the frames before it: from a
+// canvas cleared to the background, decoding (and compositing) the keyframe
+// and later frames gives the same pixels as decoding every frame from the
+// first. The first frame is a keyframe, as is a frame that covers the whole
+// image and is opaque within its bounds, or one that follows a frame that
+// covers the whole image and whose disposal is to restore the background.
+typedef struct {
+  uint64_t io_position;
+  wuffs_base__rect_ie_u32 bounds;
+  wuffs_base__flicks duration;
+  wuffs_base__animation_disposal disposal;
+  bool keyframe;
+} wuffs_base__frame_index_entry;
+
+// wuffs_base__frame_index__build decodes the frame configs of an image
+// decoder (whose image config has already been decoded), recording the Nth
+// frame's entry in dst_ptr[N]. A lighter weight decoder, such as a
+// wuffs_gif__config_decoder, suffices. image_bounds should be the image
+// config's pixel config's bounds.
+//
+// It returns the number of entries recorded, which is also the number of
+// frame configs decoded so far. On a suspension, such as
+// wuffs_base__suspension__short_read, the caller can refill src and call it
+// again with the same arguments to continue building the index. On success
+// (the decoder reached the end of its frame configs), the status is OK. If
+// there are more than dst_len frames, it returns
+// wuffs_base__error__bad_argument_length_too_short.
+wuffs_base__result_u64  //
+wuffs_base__frame_index__build(struct wuffs_base__image_decoder__struct* dec,
+                               wuffs_base__frame_index_entry* dst_ptr,
+                               size_t dst_len,
+                               wuffs_base__io_buffer* src,
+                               wuffs_base__rect_ie_u32 image_bounds);
+
+// wuffs_base__frame_index__seek prepares an image decoder (whose image config
+// has already been decoded) to decode frames starting from the nearest usable
+// keyframe at or before the target frame, returning that keyframe's index K.
+// The caller then decodes frames K ..= target, compositing them onto a canvas
+// cleared to the background, as if it had decoded every frame from the first.
+//
+// A keyframe before the target is not usable if its disposal is to restore
+// the previous canvas, as that canvas depends on the frames before it.
+//
+// It calls the decoder's restart_frame method. If src is not NULL, it also
+// moves src's read index to the keyframe's I/O position, returning
+// wuffs_base__error__bad_i_o_position if src's buffered data does not include
+// that position. A caller that reads src from a seekable file can pass NULL
+// and seek the file itself.
+wuffs_base__result_u64  //
+wuffs_base__frame_index__seek(struct wuffs_base__image_decoder__struct* dec,
+                              const wuffs_base__frame_index_entry* index_ptr,
+                              size_t index_len,
+                              uint64_t target,
+                              wuffs_base__io_buffer* src);
+
 // ---------------- String Conversions
 
 // wuffs_base__parse_number_i64 parses the ASCII integer in s. For example, if
@@ -4007,6 +4095,12 @@ WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
                                   wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_adler32__hasher__combine(const wuffs_adler32__hasher* self,
+                               uint32_t a_adler_a,
+                               uint32_t a_adler_b,
+                               uint64_t a_len_b);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4082,6 +4176,11 @@ struct wuffs_adler32__hasher__struct {
     return wuffs_adler32__hasher__update_u32(this, a_x);
   }
 
+  inline uint32_t  //
+  combine(uint32_t a_adler_a, uint32_t a_adler_b, uint64_t a_len_b) const {
+    return wuffs_adler32__hasher__combine(this, a_adler_a, a_adler_b, a_len_b);
+  }
+
 #endif  // __cplusplus
 
 };  // struct wuffs_adler32__hasher__struct
@@ -4391,6 +4490,9 @@ extern "C" {
 
 // ---------------- Struct Declarations
 
+typedef struct wuffs_crc32__castagnoli_hasher__struct
+    wuffs_crc32__castagnoli_hasher;
+
 typedef struct wuffs_crc32__ieee_hasher__struct wuffs_crc32__ieee_hasher;
 
 // ---------------- Public Initializer Prototypes
@@ -4401,6 +4503,15 @@ typedef struct wuffs_crc32__ieee_hasher__struct wuffs_crc32__ieee_hasher;
 // Pass sizeof(*self) and WUFFS_VERSION for sizeof_star_self and wuffs_version.
 // Pass 0 (or some combination of WUFFS_INITIALIZE__XXX) for initialize_flags.
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_crc32__castagnoli_hasher__initialize(wuffs_crc32__castagnoli_hasher* self,
+                                           size_t sizeof_star_self,
+                                           uint64_t wuffs_version,
+                                           uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_crc32__castagnoli_hasher();
+
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
 wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
                                      size_t sizeof_star_self,
@@ -4412,6 +4523,12 @@ sizeof__wuffs_crc32__ieee_hasher();
 
 // ---------------- Upcasts
 
+static inline wuffs_base__hasher_u32*  //
+wuffs_crc32__castagnoli_hasher__upcast_as__wuffs_base__hasher_u32(
+    wuffs_crc32__castagnoli_hasher* p) {
+  return (wuffs_base__hasher_u32*)p;
+}
+
 static inline wuffs_base__hasher_u32*  //
 wuffs_crc32__ieee_hasher__upcast_as__wuffs_base__hasher_u32(
     wuffs_crc32__ieee_hasher* p) {
@@ -4420,10 +4537,20 @@ wuffs_crc32__ieee_hasher__upcast_as__wuffs_base__hasher_u32(
 
 // ---------------- Public Function Prototypes
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__castagnoli_hasher__update_u32(wuffs_crc32__castagnoli_hasher* self,
+                                           wuffs_base__slice_u8 a_x);
+
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
 wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
                                      wuffs_base__slice_u8 a_x);
 
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__combine(const wuffs_crc32__ieee_hasher* self,
+                                  uint32_t a_crc_a,
+                                  uint32_t a_crc_b,
+                                  uint64_t a_len_b);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4433,6 +4560,76 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
 
 #if defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
+struct wuffs_crc32__castagnoli_hasher__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__hasher_u32;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_state;
+
+  } private_impl;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_crc32__castagnoli_hasher__struct() = delete;
+  wuffs_crc32__castagnoli_hasher__struct(
+      const wuffs_crc32__castagnoli_hasher__struct&) = delete;
+  wuffs_crc32__castagnoli_hasher__struct& operator=(
+      const wuffs_crc32__castagnoli_hasher__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_crc32__castagnoli_hasher__initialize(
+        this, sizeof_star_self, wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__hasher_u32*  //
+  upcast_as__wuffs_base__hasher_u32() {
+    return (wuffs_base__hasher_u32*)this;
+  }
+
+  inline uint32_t  //
+  update_u32(wuffs_base__slice_u8 a_x) {
+    return wuffs_crc32__castagnoli_hasher__update_u32(this, a_x);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_crc32__castagnoli_hasher__struct
+
 struct wuffs_crc32__ieee_hasher__struct {
   // Do not access the private_impl's or private_data's fields directly. There
   // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
@@ -4499,6 +4696,11 @@ struct wuffs_crc32__ieee_hasher__struct {
     return wuffs_crc32__ieee_hasher__update_u32(this, a_x);
   }
 
+  inline uint32_t  //
+  combine(uint32_t a_crc_a, uint32_t a_crc_b, uint64_t a_len_b) const {
+    return wuffs_crc32__ieee_hasher__combine(this, a_crc_a, a_crc_b, a_len_b);
+  }
+
 #endif  // __cplusplus
 
 };  // struct wuffs_crc32__ieee_hasher__struct
@@ -4527,16 +4729,53 @@ extern const char* wuffs_deflate__error__bad_distance_code_count;
 extern const char* wuffs_deflate__error__bad_literal_length_code_count;
 extern const char* wuffs_deflate__error__inconsistent_stored_block_length;
 extern const char* wuffs_deflate__error__missing_end_of_block_code;
+extern const char* wuffs_deflate__error__missing_history;
 extern const char* wuffs_deflate__error__no_huffman_codes;
+extern const char* wuffs_deflate__suspension__block_boundary;
 
 // ---------------- Public Consts
 
 #define WUFFS_DEFLATE__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 1
 
+#define WUFFS_DEFLATE__CAPPED_DST_STRIDE 16384
+
+#define WUFFS_DEFLATE__STATS_STORED_BLOCKS 0
+
+#define WUFFS_DEFLATE__STATS_FIXED_BLOCKS 1
+
+#define WUFFS_DEFLATE__STATS_DYNAMIC_BLOCKS 2
+
+#define WUFFS_DEFLATE__STATS_STORED_BYTES 3
+
+#define WUFFS_DEFLATE__STATS_FIXED_BYTES 4
+
+#define WUFFS_DEFLATE__STATS_DYNAMIC_BYTES 5
+
+#define WUFFS_DEFLATE__STATS_LITERALS 6
+
+#define WUFFS_DEFLATE__STATS_MATCHES 7
+
+#define WUFFS_DEFLATE__STATS_MATCH_BYTES 8
+
+#define WUFFS_DEFLATE__STATS_HUFFMAN_TABLE_BUILDS 9
+
+#define WUFFS_DEFLATE__STATS_REDIRECTS 10
+
+#define WUFFS_DEFLATE__STATS_FAST_ITERATIONS 11
+
+#define WUFFS_DEFLATE__STATS_SLOW_ITERATIONS 12
+
+#define WUFFS_DEFLATE__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
 // ---------------- Struct Declarations
 
 typedef struct wuffs_deflate__decoder__struct wuffs_deflate__decoder;
 
+typedef struct wuffs_deflate__stats_decoder__struct
+    wuffs_deflate__stats_decoder;
+
+typedef struct wuffs_deflate__encoder__struct wuffs_deflate__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -4554,6 +4793,24 @@ wuffs_deflate__decoder__initialize(wuffs_deflate__decoder* self,
 size_t  //
 sizeof__wuffs_deflate__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__stats_decoder__initialize(wuffs_deflate__stats_decoder* self,
+                                         size_t sizeof_star_self,
+                                         uint64_t wuffs_version,
+                                         uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__stats_decoder();
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_deflate__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -4562,12 +4819,58 @@ wuffs_deflate__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__stats_decoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__stats_decoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
+static inline wuffs_base__io_transformer*  //
+wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_deflate__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
                                     wuffs_base__slice_u8 a_hist);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_history(wuffs_deflate__decoder* self,
+                                              bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+    wuffs_deflate__decoder* self,
+    bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_window(wuffs_deflate__decoder* self,
+                                             bool a_dhw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_rbb);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__decoder__held_bits(const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__decoder__n_held_bits(const wuffs_deflate__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__copy_history(wuffs_deflate__decoder* self,
+                                     wuffs_base__slice_u8 a_dst);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__resume_at_checkpoint(wuffs_deflate__decoder* self,
+                                             uint32_t a_held_bits,
+                                             uint32_t a_n_held_bits,
+                                             wuffs_base__slice_u8 a_window);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
 wuffs_deflate__decoder__workbuf_len(const wuffs_deflate__decoder* self);
 
@@ -4577,6 +4880,86 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
                                      wuffs_base__io_buffer* a_src,
                                      wuffs_base__slice_u8 a_workbuf);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__add_history(wuffs_deflate__stats_decoder* self,
+                                          wuffs_base__slice_u8 a_hist);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_history(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_history_on_short_write(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_window(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_report_block_boundaries(
+    wuffs_deflate__stats_decoder* self,
+    bool a_rbb);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__stats_decoder__held_bits(
+    const wuffs_deflate__stats_decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__stats_decoder__n_held_bits(
+    const wuffs_deflate__stats_decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__copy_history(wuffs_deflate__stats_decoder* self,
+                                           wuffs_base__slice_u8 a_dst);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__resume_at_checkpoint(
+    wuffs_deflate__stats_decoder* self,
+    uint32_t a_held_bits,
+    uint32_t a_n_held_bits,
+    wuffs_base__slice_u8 a_window);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__stats_decoder__workbuf_len(
+    const wuffs_deflate__stats_decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__stats_decoder__transform_io(wuffs_deflate__stats_decoder* self,
+                                           wuffs_base__io_buffer* a_dst,
+                                           wuffs_base__io_buffer* a_src,
+                                           wuffs_base__slice_u8 a_workbuf);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__stat(const wuffs_deflate__stats_decoder* self,
+                                   uint32_t a_key);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__match_length_count(
+    const wuffs_deflate__stats_decoder* self,
+    uint32_t a_length);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__match_distance_count(
+    const wuffs_deflate__stats_decoder* self,
+    uint32_t a_extra_bits);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4603,6 +4986,11 @@ struct wuffs_deflate__decoder__struct {
     uint32_t f_bits;
     uint32_t f_n_bits;
     uint32_t f_history_index;
+    bool f_dst_holds_history;
+    bool f_dst_holds_history_on_short_write;
+    bool f_dst_holds_window;
+    uint64_t f_n_history_pending;
+    bool f_report_block_boundaries;
     uint32_t f_n_huffs_bits[2];
     bool f_end_of_block;
 
@@ -4703,6 +5091,50 @@ struct wuffs_deflate__decoder__struct {
     return wuffs_deflate__decoder__add_history(this, a_hist);
   }
 
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history(bool a_dhh) {
+    return wuffs_deflate__decoder__set_dst_holds_history(this, a_dhh);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history_on_short_write(bool a_dhh) {
+    return wuffs_deflate__decoder__set_dst_holds_history_on_short_write(this,
+                                                                        a_dhh);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_window(bool a_dhw) {
+    return wuffs_deflate__decoder__set_dst_holds_window(this, a_dhw);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_block_boundaries(bool a_rbb) {
+    return wuffs_deflate__decoder__set_report_block_boundaries(this, a_rbb);
+  }
+
+  inline uint32_t  //
+  held_bits() const {
+    return wuffs_deflate__decoder__held_bits(this);
+  }
+
+  inline uint32_t  //
+  n_held_bits() const {
+    return wuffs_deflate__decoder__n_held_bits(this);
+  }
+
+  inline uint64_t  //
+  copy_history(wuffs_base__slice_u8 a_dst) {
+    return wuffs_deflate__decoder__copy_history(this, a_dst);
+  }
+
+  inline wuffs_base__empty_struct  //
+  resume_at_checkpoint(uint32_t a_held_bits,
+                       uint32_t a_n_held_bits,
+                       wuffs_base__slice_u8 a_window) {
+    return wuffs_deflate__decoder__resume_at_checkpoint(
+        this, a_held_bits, a_n_held_bits, a_window);
+  }
+
   inline wuffs_base__range_ii_u64  //
   workbuf_len() const {
     return wuffs_deflate__decoder__workbuf_len(this);
@@ -4719,27 +5151,381 @@ struct wuffs_deflate__decoder__struct {
 
 };  // struct wuffs_deflate__decoder__struct
 
-#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
-
-#ifdef __cplusplus
-}  // extern "C"
-#endif
-
-#ifdef __cplusplus
-extern "C" {
-#endif
-
-// ---------------- Status Codes
+struct wuffs_deflate__stats_decoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
 
-extern const char* wuffs_lzw__error__bad_code;
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
 
-// ---------------- Public Consts
+    uint32_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_history_index;
+    bool f_dst_holds_history;
+    bool f_dst_holds_history_on_short_write;
+    bool f_dst_holds_window;
+    uint64_t f_n_history_pending;
+    bool f_report_block_boundaries;
+    uint32_t f_n_huffs_bits[2];
+    bool f_end_of_block;
+    uint64_t f_stats[16];
+    uint64_t f_stats_lengths[259];
+    uint64_t f_stats_distances[16];
+    uint64_t f_stats_block_start;
 
-#define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+    uint32_t p_transform_io[1];
+    uint32_t p_decode_blocks[1];
+    uint32_t p_decode_uncompressed[1];
+    uint32_t p_init_dynamic_huffman[1];
+    uint32_t p_decode_huffman_slow[1];
+  } private_impl;
 
-// ---------------- Struct Declarations
+  struct {
+    uint32_t f_huffs[2][1024];
+    uint8_t f_history[33025];
+    uint8_t f_code_lengths[320];
 
-typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
+    struct {
+      uint32_t v_final;
+      uint32_t v_type;
+    } s_decode_blocks[1];
+    struct {
+      uint32_t v_length;
+      uint64_t scratch;
+    } s_decode_uncompressed[1];
+    struct {
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_n_lit;
+      uint32_t v_n_dist;
+      uint32_t v_n_clen;
+      uint32_t v_i;
+      uint32_t v_mask;
+      uint32_t v_table_entry;
+      uint32_t v_n_extra_bits;
+      uint8_t v_rep_symbol;
+      uint32_t v_rep_count;
+    } s_init_dynamic_huffman[1];
+    struct {
+      uint32_t v_bits;
+      uint32_t v_n_bits;
+      uint32_t v_table_entry;
+      uint32_t v_table_entry_n_bits;
+      uint32_t v_lmask;
+      uint32_t v_dmask;
+      uint32_t v_redir_top;
+      uint32_t v_redir_mask;
+      uint32_t v_length;
+      uint32_t v_dist_minus_1;
+      uint32_t v_hlen;
+      uint32_t v_hdist;
+      uint64_t scratch;
+    } s_decode_huffman_slow[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__stats_decoder__struct() = delete;
+  wuffs_deflate__stats_decoder__struct(
+      const wuffs_deflate__stats_decoder__struct&) = delete;
+  wuffs_deflate__stats_decoder__struct& operator=(
+      const wuffs_deflate__stats_decoder__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__stats_decoder__initialize(
+        this, sizeof_star_self, wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  add_history(wuffs_base__slice_u8 a_hist) {
+    return wuffs_deflate__stats_decoder__add_history(this, a_hist);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history(bool a_dhh) {
+    return wuffs_deflate__stats_decoder__set_dst_holds_history(this, a_dhh);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history_on_short_write(bool a_dhh) {
+    return wuffs_deflate__stats_decoder__set_dst_holds_history_on_short_write(
+        this, a_dhh);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_window(bool a_dhw) {
+    return wuffs_deflate__stats_decoder__set_dst_holds_window(this, a_dhw);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_block_boundaries(bool a_rbb) {
+    return wuffs_deflate__stats_decoder__set_report_block_boundaries(this,
+                                                                     a_rbb);
+  }
+
+  inline uint32_t  //
+  held_bits() const {
+    return wuffs_deflate__stats_decoder__held_bits(this);
+  }
+
+  inline uint32_t  //
+  n_held_bits() const {
+    return wuffs_deflate__stats_decoder__n_held_bits(this);
+  }
+
+  inline uint64_t  //
+  copy_history(wuffs_base__slice_u8 a_dst) {
+    return wuffs_deflate__stats_decoder__copy_history(this, a_dst);
+  }
+
+  inline wuffs_base__empty_struct  //
+  resume_at_checkpoint(uint32_t a_held_bits,
+                       uint32_t a_n_held_bits,
+                       wuffs_base__slice_u8 a_window) {
+    return wuffs_deflate__stats_decoder__resume_at_checkpoint(
+        this, a_held_bits, a_n_held_bits, a_window);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__stats_decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__stats_decoder__transform_io(this, a_dst, a_src,
+                                                      a_workbuf);
+  }
+
+  inline uint64_t  //
+  stat(uint32_t a_key) const {
+    return wuffs_deflate__stats_decoder__stat(this, a_key);
+  }
+
+  inline uint64_t  //
+  match_length_count(uint32_t a_length) const {
+    return wuffs_deflate__stats_decoder__match_length_count(this, a_length);
+  }
+
+  inline uint64_t  //
+  match_distance_count(uint32_t a_extra_bits) const {
+    return wuffs_deflate__stats_decoder__match_distance_count(this,
+                                                              a_extra_bits);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__stats_decoder__struct
+
+struct wuffs_deflate__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_set_level_arg;
+    uint32_t f_level;
+    uint32_t f_good_length;
+    uint32_t f_max_lazy;
+    uint32_t f_nice_length;
+    uint32_t f_max_chain;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+    uint32_t f_window_end;
+    uint32_t f_pos;
+    uint32_t f_token_pos;
+    uint32_t f_block_start;
+    bool f_match_available;
+    uint32_t f_match_length;
+    uint32_t f_match_distance_minus_1;
+    uint32_t f_n_tokens;
+    uint32_t f_hlit;
+    uint32_t f_hdist;
+    uint32_t f_hclen;
+    uint32_t f_n_clsyms;
+    uint8_t f_lens[3][288];
+
+    uint32_t p_transform_io[1];
+    uint32_t p_write_bits[1];
+    uint32_t p_write_block[1];
+    uint32_t p_write_stored[1];
+    uint32_t p_write_tokens[1];
+    uint32_t p_write_dynamic_header[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_window[65536];
+    uint16_t f_head[32768];
+    uint16_t f_prev[32768];
+    uint32_t f_tokens[16384];
+    uint32_t f_freqs[3][288];
+    uint16_t f_codes[3][288];
+    uint16_t f_clsyms[320];
+
+    struct {
+      uint64_t scratch;
+    } s_write_bits[1];
+    struct {
+      uint32_t v_header;
+      uint64_t v_stored_cost;
+    } s_write_block[1];
+    struct {
+      uint32_t v_p;
+      uint32_t v_end;
+      uint32_t v_c;
+      uint32_t v_header;
+    } s_write_stored[1];
+    struct {
+      uint32_t v_i;
+      uint32_t v_t;
+      uint32_t v_len3;
+      uint32_t v_k;
+      uint32_t v_d;
+      uint32_t v_magic;
+    } s_write_tokens[1];
+    struct {
+      uint32_t v_i;
+      uint32_t v_s;
+    } s_write_dynamic_header[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_deflate__encoder__struct() = delete;
+  wuffs_deflate__encoder__struct(const wuffs_deflate__encoder__struct&) =
+      delete;
+  wuffs_deflate__encoder__struct& operator=(
+      const wuffs_deflate__encoder__struct&) = delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_deflate__encoder__initialize(this, sizeof_star_self,
+                                              wuffs_version, initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_level(uint32_t a_level) {
+    return wuffs_deflate__encoder__set_level(this, a_level);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_deflate__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_deflate__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_deflate__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ---------------- Status Codes
+
+extern const char* wuffs_lzw__error__bad_code;
+extern const char* wuffs_lzw__error__bad_literal;
+
+// ---------------- Public Consts
+
+#define WUFFS_LZW__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+#define WUFFS_LZW__ENCODER_WORKBUF_LEN_MAX_INCL_WORST_CASE 0
+
+// ---------------- Struct Declarations
+
+typedef struct wuffs_lzw__decoder__struct wuffs_lzw__decoder;
+
+typedef struct wuffs_lzw__encoder__struct wuffs_lzw__encoder;
 
 // ---------------- Public Initializer Prototypes
 
@@ -4758,6 +5544,15 @@ wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
 size_t  //
 sizeof__wuffs_lzw__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_lzw__encoder__initialize(wuffs_lzw__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_lzw__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__io_transformer*  //
@@ -4766,6 +5561,12 @@ wuffs_lzw__decoder__upcast_as__wuffs_base__io_transformer(
   return (wuffs_base__io_transformer*)p;
 }
 
+static inline wuffs_base__io_transformer*  //
+wuffs_lzw__encoder__upcast_as__wuffs_base__io_transformer(
+    wuffs_lzw__encoder* p) {
+  return (wuffs_base__io_transformer*)p;
+}
+
 // ---------------- Public Function Prototypes
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
@@ -4783,6 +5584,18 @@ wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
 WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
 wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__set_literal_width(wuffs_lzw__encoder* self, uint32_t a_lw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__encoder__workbuf_len(const wuffs_lzw__encoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_lzw__encoder__transform_io(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -4813,7 +5626,7 @@ struct wuffs_lzw__decoder__struct {
     uint32_t f_save_code;
     uint32_t f_prev_code;
     uint32_t f_width;
-    uint32_t f_bits;
+    uint64_t f_bits;
     uint32_t f_n_bits;
     uint32_t f_output_ri;
     uint32_t f_output_wi;
@@ -4899,10 +5712,113 @@ struct wuffs_lzw__decoder__struct {
 
 };  // struct wuffs_lzw__decoder__struct
 
-#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
-
-#ifdef __cplusplus
-}  // extern "C"
+struct wuffs_lzw__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
+    wuffs_base__vtable null_vtable;
+
+    uint32_t f_set_literal_width_arg;
+    uint32_t f_literal_width;
+    uint32_t f_clear_code;
+    uint32_t f_end_code;
+    uint32_t f_save_code;
+    uint32_t f_width;
+    uint32_t f_prefix;
+    bool f_has_prefix;
+    uint64_t f_bits;
+    uint32_t f_n_bits;
+
+    uint32_t p_transform_io[1];
+    uint32_t p_flush_bits[1];
+  } private_impl;
+
+  struct {
+    uint32_t f_entries[16384];
+
+    struct {
+      uint64_t scratch;
+    } s_transform_io[1];
+    struct {
+      uint64_t scratch;
+    } s_flush_bits[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_lzw__encoder__struct() = delete;
+  wuffs_lzw__encoder__struct(const wuffs_lzw__encoder__struct&) = delete;
+  wuffs_lzw__encoder__struct& operator=(const wuffs_lzw__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_lzw__encoder__initialize(this, sizeof_star_self, wuffs_version,
+                                          initialize_flags);
+  }
+
+  inline wuffs_base__io_transformer*  //
+  upcast_as__wuffs_base__io_transformer() {
+    return (wuffs_base__io_transformer*)this;
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_literal_width(uint32_t a_lw) {
+    return wuffs_lzw__encoder__set_literal_width(this, a_lw);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_lzw__encoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_lzw__encoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_lzw__encoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
 #endif
 
 #ifdef __cplusplus
@@ -4944,6 +5860,8 @@ typedef struct wuffs_gif__config_decoder__struct wuffs_gif__config_decoder;
 
 typedef struct wuffs_gif__decoder__struct wuffs_gif__decoder;
 
+typedef struct wuffs_gif__encoder__struct wuffs_gif__encoder;
+
 // ---------------- Public Initializer Prototypes
 
 // For any given "wuffs_foo__bar* self", "wuffs_foo__bar__initialize(self,
@@ -4970,6 +5888,15 @@ wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
 size_t  //
 sizeof__wuffs_gif__decoder();
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__encoder__initialize(wuffs_gif__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags);
+
+size_t  //
+sizeof__wuffs_gif__encoder();
+
 // ---------------- Upcasts
 
 static inline wuffs_base__image_decoder*  //
@@ -5109,6 +6036,38 @@ wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
                                  wuffs_base__slice_u8 a_workbuf,
                                  wuffs_base__decode_frame_options* a_opts);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_palette(wuffs_gif__encoder* self,
+                                wuffs_base__slice_u8 a_palette);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_num_animation_loops(wuffs_gif__encoder* self,
+                                            uint32_t a_n);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_frame(wuffs_gif__encoder* self,
+                              uint32_t a_min_incl_x,
+                              uint32_t a_min_incl_y,
+                              uint32_t a_max_excl_x,
+                              uint32_t a_max_excl_y,
+                              uint64_t a_duration,
+                              uint8_t a_disposal);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_header(wuffs_gif__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  uint32_t a_width,
+                                  uint32_t a_height);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_frame(wuffs_gif__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_trailer(wuffs_gif__encoder* self,
+                                   wuffs_base__io_buffer* a_dst);
+
 // ---------------- Struct Definitions
 
 // These structs' fields, and the sizeof them, are private implementation
@@ -5602,6 +6561,157 @@ struct wuffs_gif__decoder__struct {
 
 };  // struct wuffs_gif__decoder__struct
 
+struct wuffs_gif__encoder__struct {
+  // Do not access the private_impl's or private_data's fields directly. There
+  // is no API/ABI compatibility or safety guarantee if you do so. Instead, use
+  // the wuffs_foo__bar__baz functions.
+  //
+  // It is a struct, not a struct*, so that the outermost wuffs_foo__bar struct
+  // can be stack allocated when WUFFS_IMPLEMENTATION is defined.
+
+  struct {
+    uint32_t magic;
+    uint32_t active_coroutine;
+    wuffs_base__vtable null_vtable;
+
+    uint8_t f_call_sequence;
+    uint32_t f_width;
+    uint32_t f_height;
+    uint32_t f_num_loops;
+    uint32_t f_palette_count;
+    uint32_t f_palette_bits;
+    uint32_t f_transparent_index;
+    uint32_t f_frame_rect_x0;
+    uint32_t f_frame_rect_y0;
+    uint32_t f_frame_rect_x1;
+    uint32_t f_frame_rect_y1;
+    uint64_t f_frame_duration;
+    uint8_t f_frame_disposal;
+    uint64_t f_n_pixels_want;
+    uint64_t f_n_pixels_have;
+    uint32_t f_block_n;
+    uint32_t f_block_ri;
+
+    uint32_t p_encode_header[1];
+    uint32_t p_encode_frame[1];
+    uint32_t p_encode_trailer[1];
+    uint32_t p_write_le[1];
+    uint32_t p_write_block[1];
+  } private_impl;
+
+  struct {
+    uint8_t f_palette[1024];
+    uint8_t f_block[255];
+    wuffs_lzw__encoder f_lzw;
+
+    struct {
+      uint32_t v_bits_minus_1;
+      uint32_t v_i;
+      uint32_t v_c;
+      uint32_t v_n_loops;
+      uint64_t scratch;
+    } s_encode_header[1];
+    struct {
+      uint32_t v_frame_width;
+      uint32_t v_frame_height;
+      uint32_t v_flags;
+      uint64_t v_delay;
+      uint32_t v_lw;
+      wuffs_base__status v_lzw_status;
+      uint64_t scratch;
+    } s_encode_frame[1];
+    struct {
+      uint64_t scratch;
+    } s_encode_trailer[1];
+    struct {
+      uint32_t v_i;
+      uint64_t scratch;
+    } s_write_le[1];
+    struct {
+      uint64_t scratch;
+    } s_write_block[1];
+  } private_data;
+
+#ifdef __cplusplus
+#if (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+  // Disallow constructing or copying an object via standard C++ mechanisms,
+  // e.g. the "new" operator, as this struct is intentionally opaque. Its total
+  // size and field layout is not part of the public, stable, memory-safe API.
+  // Use malloc or memcpy and the sizeof__wuffs_foo__bar function instead, and
+  // call wuffs_foo__bar__baz methods (which all take a "this"-like pointer as
+  // their first argument) rather than tweaking bar.private_impl.qux fields.
+  //
+  // In C, we can just leave wuffs_foo__bar as an incomplete type (unless
+  // WUFFS_IMPLEMENTATION is #define'd). In C++, we define a complete type in
+  // order to provide convenience methods. These forward on "this", so that you
+  // can write "bar->baz(etc)" instead of "wuffs_foo__bar__baz(bar, etc)".
+  wuffs_gif__encoder__struct() = delete;
+  wuffs_gif__encoder__struct(const wuffs_gif__encoder__struct&) = delete;
+  wuffs_gif__encoder__struct& operator=(const wuffs_gif__encoder__struct&) =
+      delete;
+
+  // As above, the size of the struct is not part of the public API, and unless
+  // WUFFS_IMPLEMENTATION is #define'd, this struct type T should be heap
+  // allocated, not stack allocated. Its size is not intended to be known at
+  // compile time, but it is unfortunately divulged as a side effect of
+  // defining C++ convenience methods. Use "sizeof__T()", calling the function,
+  // instead of "sizeof T", invoking the operator. To make the two values
+  // different, so that passing the latter will be rejected by the initialize
+  // function, we add an arbitrary amount of dead weight.
+  uint8_t dead_weight[123000000];  // 123 MB.
+#endif  // (__cplusplus >= 201103L) && !defined(WUFFS_IMPLEMENTATION)
+
+  inline wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+  initialize(size_t sizeof_star_self,
+             uint64_t wuffs_version,
+             uint32_t initialize_flags) {
+    return wuffs_gif__encoder__initialize(this, sizeof_star_self, wuffs_version,
+                                          initialize_flags);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_palette(wuffs_base__slice_u8 a_palette) {
+    return wuffs_gif__encoder__set_palette(this, a_palette);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_num_animation_loops(uint32_t a_n) {
+    return wuffs_gif__encoder__set_num_animation_loops(this, a_n);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_frame(uint32_t a_min_incl_x,
+            uint32_t a_min_incl_y,
+            uint32_t a_max_excl_x,
+            uint32_t a_max_excl_y,
+            uint64_t a_duration,
+            uint8_t a_disposal) {
+    return wuffs_gif__encoder__set_frame(this, a_min_incl_x, a_min_incl_y,
+                                         a_max_excl_x, a_max_excl_y, a_duration,
+                                         a_disposal);
+  }
+
+  inline wuffs_base__status  //
+  encode_header(wuffs_base__io_buffer* a_dst,
+                uint32_t a_width,
+                uint32_t a_height) {
+    return wuffs_gif__encoder__encode_header(this, a_dst, a_width, a_height);
+  }
+
+  inline wuffs_base__status  //
+  encode_frame(wuffs_base__io_buffer* a_dst, wuffs_base__io_buffer* a_src) {
+    return wuffs_gif__encoder__encode_frame(this, a_dst, a_src);
+  }
+
+  inline wuffs_base__status  //
+  encode_trailer(wuffs_base__io_buffer* a_dst) {
+    return wuffs_gif__encoder__encode_trailer(this, a_dst);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gif__encoder__struct
+
 #endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
 
 #ifdef __cplusplus
@@ -5618,6 +6728,7 @@ extern const char* wuffs_gzip__error__bad_checksum;
 extern const char* wuffs_gzip__error__bad_compression_method;
 extern const char* wuffs_gzip__error__bad_encoding_flags;
 extern const char* wuffs_gzip__error__bad_header;
+extern const char* wuffs_gzip__suspension__member_boundary;
 
 // ---------------- Public Consts
 
@@ -5654,6 +6765,41 @@ wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(
 
 // ---------------- Public Function Prototypes
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_multi_member(wuffs_gzip__decoder* self, bool a_mm);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_report_member_boundaries(wuffs_gzip__decoder* self,
+                                                  bool a_rmb);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__bgzf_block_length(const wuffs_gzip__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_dst_holds_history(wuffs_gzip__decoder* self,
+                                           bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_dst_holds_window(wuffs_gzip__decoder* self,
+                                          bool a_dhw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_report_block_boundaries(wuffs_gzip__decoder* self,
+                                                 bool a_rbb);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__held_bits(const wuffs_gzip__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__n_held_bits(const wuffs_gzip__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gzip__decoder__copy_history(wuffs_gzip__decoder* self,
+                                  wuffs_base__slice_u8 a_dst);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_fused_checksum(wuffs_gzip__decoder* self, bool a_fc);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_gzip__decoder__set_ignore_checksum(wuffs_gzip__decoder* self, bool a_ic);
 
@@ -5689,6 +6835,10 @@ struct wuffs_gzip__decoder__struct {
     wuffs_base__vtable vtable_for__wuffs_base__io_transformer;
     wuffs_base__vtable null_vtable;
 
+    bool f_multi_member;
+    bool f_report_member_boundaries;
+    uint32_t f_bgzf_length;
+    bool f_fused_checksum;
     bool f_ignore_checksum;
 
     uint32_t p_transform_io[1];
@@ -5700,6 +6850,8 @@ struct wuffs_gzip__decoder__struct {
 
     struct {
       uint8_t v_flags;
+      uint32_t v_xlen;
+      uint16_t v_si;
       uint32_t v_checksum_got;
       uint32_t v_decoded_length_got;
       uint32_t v_checksum_want;
@@ -5750,35 +6902,85 @@ struct wuffs_gzip__decoder__struct {
   }
 
   inline wuffs_base__empty_struct  //
-  set_ignore_checksum(bool a_ic) {
-    return wuffs_gzip__decoder__set_ignore_checksum(this, a_ic);
+  set_multi_member(bool a_mm) {
+    return wuffs_gzip__decoder__set_multi_member(this, a_mm);
   }
 
-  inline wuffs_base__range_ii_u64  //
-  workbuf_len() const {
-    return wuffs_gzip__decoder__workbuf_len(this);
+  inline wuffs_base__empty_struct  //
+  set_report_member_boundaries(bool a_rmb) {
+    return wuffs_gzip__decoder__set_report_member_boundaries(this, a_rmb);
   }
 
-  inline wuffs_base__status  //
-  transform_io(wuffs_base__io_buffer* a_dst,
-               wuffs_base__io_buffer* a_src,
-               wuffs_base__slice_u8 a_workbuf) {
-    return wuffs_gzip__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  inline uint32_t  //
+  bgzf_block_length() const {
+    return wuffs_gzip__decoder__bgzf_block_length(this);
   }
 
-#endif  // __cplusplus
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history(bool a_dhh) {
+    return wuffs_gzip__decoder__set_dst_holds_history(this, a_dhh);
+  }
 
-};  // struct wuffs_gzip__decoder__struct
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_window(bool a_dhw) {
+    return wuffs_gzip__decoder__set_dst_holds_window(this, a_dhw);
+  }
 
-#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+  inline wuffs_base__empty_struct  //
+  set_report_block_boundaries(bool a_rbb) {
+    return wuffs_gzip__decoder__set_report_block_boundaries(this, a_rbb);
+  }
 
-#ifdef __cplusplus
-}  // extern "C"
-#endif
+  inline uint32_t  //
+  held_bits() const {
+    return wuffs_gzip__decoder__held_bits(this);
+  }
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+  inline uint32_t  //
+  n_held_bits() const {
+    return wuffs_gzip__decoder__n_held_bits(this);
+  }
+
+  inline uint64_t  //
+  copy_history(wuffs_base__slice_u8 a_dst) {
+    return wuffs_gzip__decoder__copy_history(this, a_dst);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_fused_checksum(bool a_fc) {
+    return wuffs_gzip__decoder__set_fused_checksum(this, a_fc);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_ignore_checksum(bool a_ic) {
+    return wuffs_gzip__decoder__set_ignore_checksum(this, a_ic);
+  }
+
+  inline wuffs_base__range_ii_u64  //
+  workbuf_len() const {
+    return wuffs_gzip__decoder__workbuf_len(this);
+  }
+
+  inline wuffs_base__status  //
+  transform_io(wuffs_base__io_buffer* a_dst,
+               wuffs_base__io_buffer* a_src,
+               wuffs_base__slice_u8 a_workbuf) {
+    return wuffs_gzip__decoder__transform_io(this, a_dst, a_src, a_workbuf);
+  }
+
+#endif  // __cplusplus
+
+};  // struct wuffs_gzip__decoder__struct
+
+#endif  // defined(__cplusplus) || defined(WUFFS_IMPLEMENTATION)
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 // ---------------- Status Codes
 
@@ -6235,6 +7437,7 @@ extern "C" {
 
 // ---------------- Status Codes
 
+extern const char* wuffs_zlib__suspension__member_boundary;
 extern const char* wuffs_zlib__note__dictionary_required;
 extern const char* wuffs_zlib__error__bad_checksum;
 extern const char* wuffs_zlib__error__bad_compression_method;
@@ -6284,6 +7487,43 @@ WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
                                     wuffs_base__slice_u8 a_dict);
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__add_dictionary_with_id(wuffs_zlib__decoder* self,
+                                            wuffs_base__slice_u8 a_dict,
+                                            uint32_t a_dict_id);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_multi_member(wuffs_zlib__decoder* self, bool a_mm);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_report_member_boundaries(wuffs_zlib__decoder* self,
+                                                  bool a_rmb);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_dst_holds_history(wuffs_zlib__decoder* self,
+                                           bool a_dhh);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_dst_holds_window(wuffs_zlib__decoder* self,
+                                          bool a_dhw);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_report_block_boundaries(wuffs_zlib__decoder* self,
+                                                 bool a_rbb);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_zlib__decoder__held_bits(const wuffs_zlib__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_zlib__decoder__n_held_bits(const wuffs_zlib__decoder* self);
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_zlib__decoder__copy_history(wuffs_zlib__decoder* self,
+                                  wuffs_base__slice_u8 a_dst);
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_fused_checksum(wuffs_zlib__decoder* self, bool a_fc);
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
 wuffs_zlib__decoder__set_ignore_checksum(wuffs_zlib__decoder* self, bool a_ic);
 
@@ -6321,8 +7561,11 @@ struct wuffs_zlib__decoder__struct {
 
     bool f_bad_call_sequence;
     bool f_header_complete;
+    bool f_multi_member;
+    bool f_report_member_boundaries;
     bool f_got_dictionary;
     bool f_want_dictionary;
+    bool f_fused_checksum;
     bool f_ignore_checksum;
     uint32_t f_dict_id_got;
     uint32_t f_dict_id_want;
@@ -6393,6 +7636,56 @@ struct wuffs_zlib__decoder__struct {
     return wuffs_zlib__decoder__add_dictionary(this, a_dict);
   }
 
+  inline wuffs_base__empty_struct  //
+  add_dictionary_with_id(wuffs_base__slice_u8 a_dict, uint32_t a_dict_id) {
+    return wuffs_zlib__decoder__add_dictionary_with_id(this, a_dict, a_dict_id);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_multi_member(bool a_mm) {
+    return wuffs_zlib__decoder__set_multi_member(this, a_mm);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_member_boundaries(bool a_rmb) {
+    return wuffs_zlib__decoder__set_report_member_boundaries(this, a_rmb);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_history(bool a_dhh) {
+    return wuffs_zlib__decoder__set_dst_holds_history(this, a_dhh);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_dst_holds_window(bool a_dhw) {
+    return wuffs_zlib__decoder__set_dst_holds_window(this, a_dhw);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_report_block_boundaries(bool a_rbb) {
+    return wuffs_zlib__decoder__set_report_block_boundaries(this, a_rbb);
+  }
+
+  inline uint32_t  //
+  held_bits() const {
+    return wuffs_zlib__decoder__held_bits(this);
+  }
+
+  inline uint32_t  //
+  n_held_bits() const {
+    return wuffs_zlib__decoder__n_held_bits(this);
+  }
+
+  inline uint64_t  //
+  copy_history(wuffs_base__slice_u8 a_dst) {
+    return wuffs_zlib__decoder__copy_history(this, a_dst);
+  }
+
+  inline wuffs_base__empty_struct  //
+  set_fused_checksum(bool a_fc) {
+    return wuffs_zlib__decoder__set_fused_checksum(this, a_fc);
+  }
+
   inline wuffs_base__empty_struct  //
   set_ignore_checksum(bool a_ic) {
     return wuffs_zlib__decoder__set_ignore_checksum(this, a_ic);
@@ -6423,6 +7716,17 @@ struct wuffs_zlib__decoder__struct {
 // WUFFS C HEADER ENDS HERE.
 #ifdef WUFFS_IMPLEMENTATION
 
+// WUFFS_BASE__CPU_ARCH__X86_64 means that the hand-written SIMD code paths,
+// which use compiler intrinsics and per-function target attributes, are
+// compiled in. Whether they are used is decided at runtime, by CPUID. Define
+// WUFFS_CONFIG__AVOID_CPU_ARCH to compile only the portable code paths.
+#if !defined(WUFFS_CONFIG__AVOID_CPU_ARCH) && defined(__GNUC__) && \
+    defined(__x86_64__)
+#define WUFFS_BASE__CPU_ARCH__X86_64
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
 // GCC does not warn for unused *static inline* functions, but clang does.
 #ifdef __clang__
 #pragma clang diagnostic push
@@ -6596,6 +7900,110 @@ wuffs_base__table_u8__row(wuffs_base__table_u8 t, uint32_t y) {
 
 #define wuffs_base__utility__empty_slice_u8 wuffs_base__empty_slice_u8
 
+// ---------------- CPU Architecture
+
+// wuffs_base__cpu_arch__x86_features caches which x86 instruction set
+// extensions are available, as a bitmask of WUFFS_BASE__CPU_ARCH__X86__ETC
+// bits. It is zero until CPUID is first consulted, after which the CHECKED bit
+// is always set. Tests and benchmarks can set it to just the CHECKED bit to
+// force the portable (non-SIMD) code paths, but must do so before starting any
+// threads that use Wuffs.
+//
+// Many threads can call wuffs_base__cpu_arch__x86_features_check at once.
+// They might all consult CPUID, but they compute the same value, and reading
+// and writing the cache with relaxed atomics (GCC and Clang builtins, like
+// the rest of WUFFS_BASE__CPU_ARCH__X86_64) avoids a data race.
+#define WUFFS_BASE__CPU_ARCH__X86__CHECKED ((uint32_t)0x80000000)
+#define WUFFS_BASE__CPU_ARCH__X86__PCLMUL ((uint32_t)0x00000001)
+#define WUFFS_BASE__CPU_ARCH__X86__SSE42 ((uint32_t)0x00000002)
+#define WUFFS_BASE__CPU_ARCH__X86__SSSE3 ((uint32_t)0x00000004)
+#define WUFFS_BASE__CPU_ARCH__X86__AVX2 ((uint32_t)0x00000008)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+static uint32_t wuffs_base__cpu_arch__x86_features = 0;
+#endif
+
+static inline uint32_t  //
+wuffs_base__cpu_arch__x86_features_check() {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  uint32_t f =
+      __atomic_load_n(&wuffs_base__cpu_arch__x86_features, __ATOMIC_RELAXED);
+  if (f == 0) {
+    f = WUFFS_BASE__CPU_ARCH__X86__CHECKED;
+    unsigned int eax = 0;
+    unsigned int ebx = 0;
+    unsigned int ecx = 0;
+    unsigned int edx = 0;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+      // ECX bit 1 is PCLMULQDQ.
+      if (ecx & 0x00000002) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__PCLMUL;
+      }
+      // ECX bit 9 is SSSE3.
+      if (ecx & 0x00000200) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__SSSE3;
+      }
+      // ECX bit 20 is SSE4.2.
+      if (ecx & 0x00100000) {
+        f |= WUFFS_BASE__CPU_ARCH__X86__SSE42;
+      }
+      // AVX2 also needs the OS to save and restore the YMM registers: ECX bit
+      // 27 is OSXSAVE, ECX bit 28 is AVX and XCR0 bits 1 and 2 are the XMM and
+      // YMM state. Leaf 7's EBX bit 5 is AVX2.
+      if (((ecx & 0x18000000) == 0x18000000) &&
+          (__get_cpuid_max(0, NULL) >= 7)) {
+        unsigned int xcr0_lo = 0;
+        unsigned int xcr0_hi = 0;
+        __asm__ __volatile__("xgetbv" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+        __cpuid_count(7, 0, eax, ebx, ecx, edx);
+        if (((xcr0_lo & 6) == 6) && (ebx & 0x00000020)) {
+          f |= WUFFS_BASE__CPU_ARCH__X86__AVX2;
+        }
+      }
+    }
+    __atomic_store_n(&wuffs_base__cpu_arch__x86_features, f, __ATOMIC_RELAXED);
+  }
+  return f;
+#else
+  return 0;
+#endif
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_avx2() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__AVX2) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_pclmul() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__PCLMUL) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_sse42() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__SSE42) != 0;
+}
+
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_ssse3() {
+  return (wuffs_base__cpu_arch__x86_features_check() &
+          WUFFS_BASE__CPU_ARCH__X86__SSSE3) != 0;
+}
+
+// ---------------- CPU Architecture (Utility)
+
+#define wuffs_base__utility__cpu_arch_have_x86_avx2 \
+  wuffs_base__cpu_arch__have_x86_avx2
+#define wuffs_base__utility__cpu_arch_have_x86_pclmul \
+  wuffs_base__cpu_arch__have_x86_pclmul
+#define wuffs_base__utility__cpu_arch_have_x86_sse42 \
+  wuffs_base__cpu_arch__have_x86_sse42
+#define wuffs_base__utility__cpu_arch_have_x86_ssse3 \
+  wuffs_base__cpu_arch__have_x86_ssse3
+
 // ---------------- Ranges and Rects
 
 static inline uint32_t  //
@@ -6698,10 +8106,8 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
   // argument, and the cgen can look if that argument is the constant
   // expression '3'.
   //
-  // See also wuffs_base__io_writer__copy_n32_from_history_fast below.
-  //
-  // Alternatively, or additionally, have a sloppy_copy_n32_from_history method
-  // that copies 8 bytes at a time, possibly writing more than length bytes?
+  // See also wuffs_base__io_writer__copy_n32_from_history_fast below, which
+  // copies 8 bytes at a time when there is room to write past length bytes.
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -6720,6 +8126,12 @@ wuffs_base__io_writer__copy_n32_from_history(uint8_t** ptr_iop_w,
 //  - distance >  0
 //  - distance <= (*ptr_iop_w - io1_w)
 //  - length   <= (io2_w      - *ptr_iop_w)
+//
+// When there are at least (length + 8) bytes available, it copies 8 bytes at
+// a time and so may write up to 7 bytes past the length bytes. Those extra
+// bytes are before io2_w but after the updated *ptr_iop_w, so they are not
+// (yet) part of the output. A distance of 1 is a memset and other distances
+// below 8 repeat an 8 byte pattern.
 static inline uint32_t  //
 wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
                                                   uint8_t* io1_w,
@@ -6729,6 +8141,42 @@ wuffs_base__io_writer__copy_n32_from_history_fast(uint8_t** ptr_iop_w,
   uint8_t* p = *ptr_iop_w;
   uint8_t* q = p - distance;
   uint32_t n = length;
+  if ((size_t)(io2_w - p) >= ((size_t)(length) + 8)) {
+    uint8_t* end = p + length;
+    if (distance >= 8) {
+      // Each chunk's source ends at or before that chunk's destination
+      // starts, so it only reads bytes that have already been written.
+      do {
+        wuffs_base__store_u64le__no_bounds_check(
+            p, wuffs_base__load_u64le__no_bounds_check(q));
+        p += 8;
+        q += 8;
+      } while (p < end);
+    } else if (distance == 1) {
+      memset(p, *q, length);
+    } else {
+      // Expand the distance-byte pattern to 8 bytes, one byte at a time, and
+      // then write those 8 bytes every step bytes, where step is the largest
+      // multiple of distance that is no more than 8.
+      p[0] = q[0];
+      p[1] = q[1];
+      p[2] = q[2];
+      p[3] = q[3];
+      p[4] = q[4];
+      p[5] = q[5];
+      p[6] = q[6];
+      p[7] = q[7];
+      uint64_t x = wuffs_base__load_u64le__no_bounds_check(p);
+      uint32_t step = 8 - (8 % distance);
+      p += step;
+      while (p < end) {
+        wuffs_base__store_u64le__no_bounds_check(p, x);
+        p += step;
+      }
+    }
+    *ptr_iop_w = end;
+    return length;
+  }
   for (; n >= 3; n -= 3) {
     *p++ = *q++;
     *p++ = *q++;
@@ -6838,6 +8286,28 @@ wuffs_base__io_reader__match7(uint8_t* iop_r,
   return 0;
 }
 
+// wuffs_base__io_reader__limit sets *b to a copy of *r, synchronized to the
+// iop_r read position, that holds at most limit readable bytes, moving
+// *ptr_io2_r accordingly. If limited, the copy is not closed.
+static inline wuffs_base__io_buffer*  //
+wuffs_base__io_reader__limit(wuffs_base__io_buffer* b,
+                             wuffs_base__io_buffer* r,
+                             uint8_t* iop_r,
+                             uint8_t** ptr_io2_r,
+                             uint64_t limit) {
+  if (!r) {
+    return r;
+  }
+  *b = *r;
+  b->meta.ri = ((size_t)(iop_r - b->data.ptr));
+  if (limit < ((uint64_t)(*ptr_io2_r - iop_r))) {
+    *ptr_io2_r = iop_r + limit;
+    b->meta.wi = ((size_t)(*ptr_io2_r - b->data.ptr));
+    b->meta.closed = false;
+  }
+  return b;
+}
+
 static inline wuffs_base__io_buffer*  //
 wuffs_base__io_reader__set(wuffs_base__io_buffer* b,
                            uint8_t** ptr_iop_r,
@@ -6890,6 +8360,27 @@ wuffs_base__io_writer__set(wuffs_base__io_buffer* b,
   return b;
 }
 
+// wuffs_base__io_writer__limit sets *b to a copy of *w, synchronized to the
+// iop_w write position, that has room for at most limit more bytes, moving
+// *ptr_io2_w accordingly.
+static inline wuffs_base__io_buffer*  //
+wuffs_base__io_writer__limit(wuffs_base__io_buffer* b,
+                             wuffs_base__io_buffer* w,
+                             uint8_t* iop_w,
+                             uint8_t** ptr_io2_w,
+                             uint64_t limit) {
+  if (!w) {
+    return w;
+  }
+  *b = *w;
+  b->meta.wi = ((size_t)(iop_w - b->data.ptr));
+  if (limit < ((uint64_t)(*ptr_io2_w - iop_w))) {
+    *ptr_io2_w = iop_w + limit;
+    b->data.len = ((size_t)(*ptr_io2_w - b->data.ptr));
+  }
+  return b;
+}
+
   // ---------------- I/O (Utility)
 
 #define wuffs_base__utility__empty_io_reader wuffs_base__empty_io_reader
@@ -6911,6 +8402,407 @@ wuffs_base__io_writer__set(wuffs_base__io_buffer* b,
 
   // ---------------- Unicode and UTF-8
 
+// ---------------- Hashes
+
+// WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO is the number of 32-byte blocks that
+// the SIMD implementations can process before the s1 and s2 accumulators have
+// to be reduced modulo 65521. 173 is (5552 / 32), rounded down. See the "SIMD
+// Implementations" section of std/adler32/README.md.
+#define WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO 173
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+__attribute__((target("ssse3"))) static uint32_t  //
+wuffs_base__adler32__update_x86_ssse3__impl(uint32_t s,
+                                            const uint8_t* p,
+                                            size_t n) {
+  // The taps weight each byte of a 32-byte block by how many times it is
+  // added to s2 within that block.
+  const __m128i tap0 = _mm_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //
+                                     24, 23, 22, 21, 20, 19, 18, 17);
+  const __m128i tap1 = _mm_setr_epi8(16, 15, 14, 13, 12, 11, 10, 9,  //
+                                     8, 7, 6, 5, 4, 3, 2, 1);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i ones = _mm_set1_epi16(1);
+
+  uint32_t s1 = s & 0xFFFF;
+  uint32_t s2 = s >> 16;
+  while (n > 0) {
+    size_t num_blocks = n / 32;
+    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {
+      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;
+    }
+    n -= num_blocks * 32;
+
+    // v_ps accumulates the s1 value at the start of each block. Each of those
+    // is added 32 times to s2, which is applied (as a shift left by 5) after
+    // the inner loop.
+    __m128i v_ps = _mm_set_epi32(0, 0, 0, (int)(s1 * num_blocks));
+    __m128i v_s1 = zero;
+    __m128i v_s2 = _mm_set_epi32(0, 0, 0, (int)s2);
+    do {
+      __m128i x0 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+      __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+      p += 32;
+      v_ps = _mm_add_epi32(v_ps, v_s1);
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x0, zero));
+      v_s1 = _mm_add_epi32(v_s1, _mm_sad_epu8(x1, zero));
+      v_s2 = _mm_add_epi32(v_s2,
+                           _mm_madd_epi16(_mm_maddubs_epi16(x0, tap0), ones));
+      v_s2 = _mm_add_epi32(v_s2,
+                           _mm_madd_epi16(_mm_maddubs_epi16(x1, tap1), ones));
+    } while (--num_blocks);
+    v_s2 = _mm_add_epi32(v_s2, _mm_slli_epi32(v_ps, 5));
+
+    // Sum the 32-bit lanes horizontally.
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0x4E));
+    v_s1 = _mm_add_epi32(v_s1, _mm_shuffle_epi32(v_s1, 0xB1));
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0x4E));
+    v_s2 = _mm_add_epi32(v_s2, _mm_shuffle_epi32(v_s2, 0xB1));
+    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(v_s1)) % 65521;
+    s2 = ((uint32_t)_mm_cvtsi128_si32(v_s2)) % 65521;
+  }
+  return (s2 << 16) | s1;
+}
+
+__attribute__((target("avx2"))) static uint32_t  //
+wuffs_base__adler32__update_x86_avx2__impl(uint32_t s,
+                                           const uint8_t* p,
+                                           size_t n) {
+  // This is the same algorithm as the SSSE3 implementation, except that each
+  // 32-byte block fits in a single 256-bit register.
+  const __m256i tap = _mm256_setr_epi8(32, 31, 30, 29, 28, 27, 26, 25,  //
+                                       24, 23, 22, 21, 20, 19, 18, 17,  //
+                                       16, 15, 14, 13, 12, 11, 10, 9,   //
+                                       8, 7, 6, 5, 4, 3, 2, 1);
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i ones = _mm256_set1_epi16(1);
+
+  uint32_t s1 = s & 0xFFFF;
+  uint32_t s2 = s >> 16;
+  while (n > 0) {
+    size_t num_blocks = n / 32;
+    if (num_blocks > WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO) {
+      num_blocks = WUFFS_BASE__ADLER32__BLOCKS_PER_MODULO;
+    }
+    n -= num_blocks * 32;
+
+    __m256i v_ps =
+        _mm256_setr_epi32((int)(s1 * num_blocks), 0, 0, 0, 0, 0, 0, 0);
+    __m256i v_s1 = zero;
+    __m256i v_s2 = _mm256_setr_epi32((int)s2, 0, 0, 0, 0, 0, 0, 0);
+    do {
+      __m256i x = _mm256_loadu_si256((const __m256i*)(const void*)p);
+      p += 32;
+      v_ps = _mm256_add_epi32(v_ps, v_s1);
+      v_s1 = _mm256_add_epi32(v_s1, _mm256_sad_epu8(x, zero));
+      v_s2 = _mm256_add_epi32(
+          v_s2, _mm256_madd_epi16(_mm256_maddubs_epi16(x, tap), ones));
+    } while (--num_blocks);
+    v_s2 = _mm256_add_epi32(v_s2, _mm256_slli_epi32(v_ps, 5));
+
+    // Sum the 32-bit lanes horizontally.
+    __m128i w_s1 = _mm_add_epi32(_mm256_castsi256_si128(v_s1),
+                                 _mm256_extracti128_si256(v_s1, 1));
+    __m128i w_s2 = _mm_add_epi32(_mm256_castsi256_si128(v_s2),
+                                 _mm256_extracti128_si256(v_s2, 1));
+    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0x4E));
+    w_s1 = _mm_add_epi32(w_s1, _mm_shuffle_epi32(w_s1, 0xB1));
+    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0x4E));
+    w_s2 = _mm_add_epi32(w_s2, _mm_shuffle_epi32(w_s2, 0xB1));
+    s1 = (s1 + (uint32_t)_mm_cvtsi128_si32(w_s1)) % 65521;
+    s2 = ((uint32_t)_mm_cvtsi128_si32(w_s2)) % 65521;
+  }
+  return (s2 << 16) | s1;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__adler32__update_x86_avx2 and
+// wuffs_base__adler32__update_x86_ssse3 update the Adler-32 state s (with s1 in
+// the low 16 bits and s2 in the high 16 bits, both less than 65521) with the
+// bytes of x, using PSADBW to accumulate s1 and PMADDUBSW to accumulate s2, 32
+// bytes at a time.
+//
+// Only the first (x.len - (x.len % 32)) bytes are hashed. The caller is
+// responsible for hashing the final (x.len % 32) bytes. If the CPU does not
+// support AVX2 (or SSSE3), no bytes are hashed and s is returned unchanged.
+// Callers should check wuffs_base__cpu_arch__have_x86_avx2 (or
+// wuffs_base__cpu_arch__have_x86_ssse3) before calling these functions.
+static inline uint32_t  //
+wuffs_base__adler32__update_x86_avx2(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    return wuffs_base__adler32__update_x86_avx2__impl(s, x.ptr,
+                                                      x.len & ~(size_t)31);
+  }
+#endif
+  return s;
+}
+
+static inline uint32_t  //
+wuffs_base__adler32__update_x86_ssse3(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_ssse3()) {
+    return wuffs_base__adler32__update_x86_ssse3__impl(s, x.ptr,
+                                                       x.len & ~(size_t)31);
+  }
+#endif
+  return s;
+}
+
+// --------
+
+// wuffs_base__crc32__ieee_fold_x86_pclmul updates the CRC-32 IEEE state s
+// (which is bit-inverted, as per std/crc32's ieee_hasher) with the bytes of x,
+// using the "Fast CRC Computation for Generic Polynomials Using PCLMULQDQ
+// Instruction" folding technique. See the "SIMD Implementations" section of
+// std/crc32/README.md.
+//
+// Only the first (x.len - (x.len % 16)) bytes are hashed. The caller is
+// responsible for hashing the final (x.len % 16) bytes. If x.len is less than
+// 64, or the CPU does not support PCLMULQDQ, no bytes are hashed and s is
+// returned unchanged. Callers should check
+// wuffs_base__cpu_arch__have_x86_pclmul before calling this function.
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+__attribute__((target("pclmul"))) static uint32_t  //
+wuffs_base__crc32__ieee_fold_x86_pclmul__impl(uint32_t s,
+                                              const uint8_t* p,
+                                              size_t n) {
+  // The k1 ..= k5 constants are x**(4*128+32) mod P, x**(4*128-32) mod P,
+  // x**(128+32) mod P, x**(128-32) mod P and x**64 mod P, bit-reflected. mu
+  // and P' are the Barrett reduction constants. All are from the Intel paper.
+  const __m128i k1k2 = _mm_set_epi64x(0x01C6E41596, 0x0154442BD4);
+  const __m128i k3k4 = _mm_set_epi64x(0x00CCAA009E, 0x01751997D0);
+  const __m128i k5k0 = _mm_set_epi64x(0x0000000000, 0x0163CD6124);
+  const __m128i poly = _mm_set_epi64x(0x01F7011641, 0x01DB710641);
+  const __m128i mask = _mm_setr_epi32(-1, 0, -1, 0);
+
+  __m128i x0;
+  __m128i x1 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+  __m128i x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+  __m128i x3 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));
+  __m128i x4 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));
+  __m128i x5;
+  __m128i x6;
+  __m128i x7;
+  __m128i x8;
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)s));
+  p += 64;
+  n -= 64;
+
+  // Fold 4 x 128 bits at a time.
+  while (n >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+    x1 = _mm_xor_si128(x1, x5);
+    x2 = _mm_xor_si128(x2, x6);
+    x3 = _mm_xor_si128(x3, x7);
+    x4 = _mm_xor_si128(x4, x8);
+    x5 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+    x6 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x10));
+    x7 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x20));
+    x8 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x30));
+    x1 = _mm_xor_si128(x1, x5);
+    x2 = _mm_xor_si128(x2, x6);
+    x3 = _mm_xor_si128(x3, x7);
+    x4 = _mm_xor_si128(x4, x8);
+    p += 64;
+    n -= 64;
+  }
+
+  // Fold 4 x 128 bits down to 1 x 128 bits.
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+  // Fold 1 x 128 bits at a time.
+  while (n >= 16) {
+    x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+    x2 = _mm_loadu_si128((const __m128i*)(const void*)(p + 0x00));
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+    p += 16;
+    n -= 16;
+  }
+
+  // Fold 128 bits down to 64 bits.
+  x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, mask);
+  x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  // Barrett reduce 64 bits down to 32 bits.
+  x2 = _mm_and_si128(x1, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+  x2 = _mm_and_si128(x2, mask);
+  x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  x0 = _mm_srli_si128(x1, 4);
+  return (uint32_t)(_mm_cvtsi128_si32(x0));
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+static inline uint32_t  //
+wuffs_base__crc32__ieee_fold_x86_pclmul(uint32_t s, wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if ((x.len >= 64) && wuffs_base__cpu_arch__have_x86_pclmul()) {
+    return wuffs_base__crc32__ieee_fold_x86_pclmul__impl(s, x.ptr,
+                                                         x.len & ~(size_t)15);
+  }
+#endif
+  return s;
+}
+
+// --------
+
+// WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG and __SHORT are the block
+// lengths for hashing three interleaved blocks in parallel. The CRC32
+// instruction has a latency of 3 cycles but a throughput of 1 per cycle, so
+// three independent dependency chains keep the CPU busy.
+#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG 8192
+#define WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT 256
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+// wuffs_base__crc32__castagnoli_shift_x86_sse42 returns the CRC-32C state s
+// after (notionally) hashing n zero bytes, without the pre- and post-inverting,
+// where k is x**(8*n - 33) modulo the Castagnoli polynomial, bit-reflected.
+// See script/print-crc32-magic-numbers.go.
+__attribute__((target("sse4.2,pclmul"))) static inline uint32_t  //
+wuffs_base__crc32__castagnoli_shift_x86_sse42(uint32_t s, uint32_t k) {
+  __m128i x = _mm_clmulepi64_si128(_mm_cvtsi32_si128((int)s),
+                                   _mm_cvtsi32_si128((int)k), 0x00);
+  return (uint32_t)(_mm_crc32_u64(0, (uint64_t)(_mm_cvtsi128_si64(x))));
+}
+
+__attribute__((target("sse4.2,pclmul"))) static uint32_t  //
+wuffs_base__crc32__castagnoli_update_x86_sse42__impl(uint32_t s,
+                                                     const uint8_t* p,
+                                                     size_t n,
+                                                     bool interleave) {
+  const size_t long_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__LONG;
+  const size_t short_len = WUFFS_BASE__CRC32__CASTAGNOLI_X86_SSE42__SHORT;
+  uint64_t s0 = s;
+  uint64_t s1 = 0;
+  uint64_t s2 = 0;
+  uint64_t v0 = 0;
+  uint64_t v1 = 0;
+  uint64_t v2 = 0;
+  const uint8_t* end = NULL;
+
+  // Align p to an 8 byte boundary.
+  while ((n > 0) && (((uintptr_t)p) & 7)) {
+    s0 = _mm_crc32_u8((uint32_t)s0, *p++);
+    n--;
+  }
+
+  // Hash three interleaved blocks in parallel, and then combine their partial
+  // checksums, first with long blocks and then with short blocks. Combining
+  // uses the PCLMULQDQ instruction, hence the interleave argument.
+  if (interleave) {
+    while (n >= (3 * long_len)) {
+      s1 = 0;
+      s2 = 0;
+      end = p + long_len;
+      do {
+        memcpy(&v0, p, 8);
+        memcpy(&v1, p + long_len, 8);
+        memcpy(&v2, p + (2 * long_len), 8);
+        s0 = _mm_crc32_u64(s0, v0);
+        s1 = _mm_crc32_u64(s1, v1);
+        s2 = _mm_crc32_u64(s2, v2);
+        p += 8;
+      } while (p < end);
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0x54A86326) ^
+           s1;
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0x54A86326) ^
+           s2;
+      p += 2 * long_len;
+      n -= 3 * long_len;
+    }
+
+    while (n >= (3 * short_len)) {
+      s1 = 0;
+      s2 = 0;
+      end = p + short_len;
+      do {
+        memcpy(&v0, p, 8);
+        memcpy(&v1, p + short_len, 8);
+        memcpy(&v2, p + (2 * short_len), 8);
+        s0 = _mm_crc32_u64(s0, v0);
+        s1 = _mm_crc32_u64(s1, v1);
+        s2 = _mm_crc32_u64(s2, v2);
+        p += 8;
+      } while (p < end);
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0xB9E02B86) ^
+           s1;
+      s0 = wuffs_base__crc32__castagnoli_shift_x86_sse42((uint32_t)s0,
+                                                         0xB9E02B86) ^
+           s2;
+      p += 2 * short_len;
+      n -= 3 * short_len;
+    }
+  }
+
+  // Hash the remaining bytes, 8 (and then 1) at a time.
+  for (; n >= 8; n -= 8) {
+    memcpy(&v0, p, 8);
+    s0 = _mm_crc32_u64(s0, v0);
+    p += 8;
+  }
+  for (; n > 0; n--) {
+    s0 = _mm_crc32_u8((uint32_t)s0, *p++);
+  }
+  return (uint32_t)s0;
+}
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// wuffs_base__crc32__castagnoli_update_x86_sse42 updates the CRC-32C state s
+// (which is bit-inverted, as per std/crc32's castagnoli_hasher) with all of
+// the bytes of x, using the SSE4.2 CRC32 instruction. Long inputs are hashed
+// as three interleaved streams, if the CPU also supports PCLMULQDQ.
+//
+// If the CPU does not support SSE4.2, no bytes are hashed and s is returned
+// unchanged. Callers should check wuffs_base__cpu_arch__have_x86_sse42 before
+// calling this function.
+static inline uint32_t  //
+wuffs_base__crc32__castagnoli_update_x86_sse42(uint32_t s,
+                                               wuffs_base__slice_u8 x) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_sse42()) {
+    return wuffs_base__crc32__castagnoli_update_x86_sse42__impl(
+        s, x.ptr, x.len, wuffs_base__cpu_arch__have_x86_pclmul());
+  }
+#endif
+  return s;
+}
+
+// ---------------- Hashes (Utility)
+
+#define wuffs_base__utility__adler32_update_x86_avx2 \
+  wuffs_base__adler32__update_x86_avx2
+#define wuffs_base__utility__adler32_update_x86_ssse3 \
+  wuffs_base__adler32__update_x86_ssse3
+#define wuffs_base__utility__crc32_castagnoli_update_x86_sse42 \
+  wuffs_base__crc32__castagnoli_update_x86_sse42
+#define wuffs_base__utility__crc32_ieee_fold_x86_pclmul \
+  wuffs_base__crc32__ieee_fold_x86_pclmul
+
   // ----------------
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__BASE)
@@ -8441,67 +10333,415 @@ wuffs_base__pixel_swizzler__swizzle_interleaved(
   return 0;
 }
 
-// ---------------- String Conversions
+// --------
 
-// wuffs_base__parse_number__foo_digits entries are 0x00 for invalid digits,
-// and (0x80 | v) for valid digits, where v is the 4 bit value.
+typedef struct {
+  // begin and end are the range of the quantizer's bin list that this box
+  // holds. count is the number of pixels in those bins.
+  uint32_t begin;
+  uint32_t end;
+  uint64_t count;
+  // min_incl and max_incl are the bounds of those bins' 5-bit red, green and
+  // blue coordinates.
+  uint32_t min_incl[3];
+  uint32_t max_incl[3];
+} wuffs_base__pixel_palette__quantize__box;
+
+// wuffs_base__pixel_palette__quantize__bin returns the 15-bit histogram bin
+// (5 bits each of red, green and blue) of a BGRA pixel loaded as a uint32_t.
+static inline uint32_t  //
+wuffs_base__pixel_palette__quantize__bin(uint32_t c) {
+  return ((c >> 9) & 0x7C00) | ((c >> 6) & 0x03E0) | ((c >> 3) & 0x001F);
+}
 
-static const uint8_t wuffs_base__parse_number__decimal_digits[256] = {
-    // 0     1     2     3     4     5     6     7
-    // 8     9     A     B     C     D     E     F
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x00 ..= 0x07.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x08 ..= 0x0F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x10 ..= 0x17.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x18 ..= 0x1F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x20 ..= 0x27.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x28 ..= 0x2F.
-    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,  // 0x30 ..= 0x37. '0'-'7'.
-    0x88, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x38 ..= 0x3F. '8'-'9'.
+static const uint32_t wuffs_base__pixel_palette__quantize__shifts[3] = {
+    10,
+    5,
+    0,
+};
 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x40 ..= 0x47.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x48 ..= 0x4F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x50 ..= 0x57.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x58 ..= 0x5F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x60 ..= 0x67.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x68 ..= 0x6F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x70 ..= 0x77.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x78 ..= 0x7F.
+// wuffs_base__pixel_palette__quantize__shrink sets b's count and bounds from
+// its bins.
+static void  //
+wuffs_base__pixel_palette__quantize__shrink(
+    wuffs_base__pixel_palette__quantize__box* b,
+    uint8_t* counts,
+    uint8_t* list) {
+  b->count = 0;
+  int axis;
+  for (axis = 0; axis < 3; axis++) {
+    b->min_incl[axis] = 31;
+    b->max_incl[axis] = 0;
+  }
+  uint32_t k;
+  for (k = b->begin; k < b->end; k++) {
+    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));
+    b->count += wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));
+    for (axis = 0; axis < 3; axis++) {
+      uint32_t v =
+          (bin >> wuffs_base__pixel_palette__quantize__shifts[axis]) & 31;
+      if (b->min_incl[axis] > v) {
+        b->min_incl[axis] = v;
+      }
+      if (b->max_incl[axis] < v) {
+        b->max_incl[axis] = v;
+      }
+    }
+  }
+}
 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x80 ..= 0x87.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x88 ..= 0x8F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x90 ..= 0x97.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x98 ..= 0x9F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xA0 ..= 0xA7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xA8 ..= 0xAF.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xB0 ..= 0xB7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xB8 ..= 0xBF.
+// wuffs_base__pixel_palette__quantize__split splits b along the given axis,
+// at the population's median, moving the upper part to c.
+static void  //
+wuffs_base__pixel_palette__quantize__split(
+    wuffs_base__pixel_palette__quantize__box* b,
+    wuffs_base__pixel_palette__quantize__box* c,
+    int axis,
+    uint8_t* counts,
+    uint8_t* list) {
+  uint32_t shift = wuffs_base__pixel_palette__quantize__shifts[axis];
+  uint64_t hist[32] = {0};
+  uint32_t k;
+  for (k = b->begin; k < b->end; k++) {
+    uint32_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * k));
+    hist[(bin >> shift) & 31] +=
+        wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin));
+  }
+
+  // Both halves are non-empty, as b has more than one coordinate value on
+  // this axis and m is in [min_incl, max_incl).
+  uint32_t m = b->min_incl[axis];
+  uint64_t n = 0;
+  for (; m < b->max_incl[axis]; m++) {
+    n += hist[m];
+    if ((2 * n) >= b->count) {
+      break;
+    }
+  }
+  if (m >= b->max_incl[axis]) {
+    m = b->max_incl[axis] - 1;
+  }
 
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xC0 ..= 0xC7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xC8 ..= 0xCF.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xD0 ..= 0xD7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xD8 ..= 0xDF.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xE0 ..= 0xE7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xE8 ..= 0xEF.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xF0 ..= 0xF7.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xF8 ..= 0xFF.
-    // 0     1     2     3     4     5     6     7
-    // 8     9     A     B     C     D     E     F
-};
+  uint32_t lo = b->begin;
+  uint32_t hi = b->end;
+  while (lo < hi) {
+    uint16_t bin = wuffs_base__load_u16le__no_bounds_check(list + (2 * lo));
+    if (((((uint32_t)bin) >> shift) & 31) <= m) {
+      lo++;
+      continue;
+    }
+    hi--;
+    wuffs_base__store_u16le__no_bounds_check(
+        list + (2 * lo),
+        wuffs_base__load_u16le__no_bounds_check(list + (2 * hi)));
+    wuffs_base__store_u16le__no_bounds_check(list + (2 * hi), bin);
+  }
 
-static const uint8_t wuffs_base__parse_number__hexadecimal_digits[256] = {
-    // 0     1     2     3     4     5     6     7
-    // 8     9     A     B     C     D     E     F
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x00 ..= 0x07.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x08 ..= 0x0F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x10 ..= 0x17.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x18 ..= 0x1F.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x20 ..= 0x27.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x28 ..= 0x2F.
-    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,  // 0x30 ..= 0x37. '0'-'7'.
-    0x88, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x38 ..= 0x3F. '8'-'9'.
+  c->begin = lo;
+  c->end = b->end;
+  b->end = lo;
+  wuffs_base__pixel_palette__quantize__shrink(b, counts, list);
+  wuffs_base__pixel_palette__quantize__shrink(c, counts, list);
+}
 
-    0x00, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x00,  // 0x40 ..= 0x47. 'A'-'F'.
-    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x48 ..= 0x4F.
+wuffs_base__result_u64  //
+wuffs_base__pixel_palette__quantize(wuffs_base__slice_u8 dst_indexes,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__slice_u8 src,
+                                    uint32_t max_colors,
+                                    wuffs_base__slice_u8 workbuf) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  size_t n = src.len / 4;
+  if ((max_colors < 2) || (max_colors > 256) || ((src.len % 4) != 0)) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  } else if ((dst_indexes.len < n) ||
+             (dst_palette.len < (4 * ((size_t)max_colors)))) {
+    ret.status.repr = wuffs_base__error__bad_argument_length_too_short;
+    return ret;
+  } else if (workbuf.len < WUFFS_BASE__PIXEL_PALETTE__QUANTIZE__WORKBUF_LEN) {
+    ret.status.repr = wuffs_base__error__bad_workbuf_length;
+    return ret;
+  }
+
+  // The workbuf holds a uint32_t count (and later, a box index) per bin and
+  // then a uint16_t list of the occupied bins.
+  uint8_t* counts = workbuf.ptr;
+  uint8_t* list = workbuf.ptr + (4 * 32768);
+  memset(counts, 0, 4 * 32768);
+
+  bool has_transparent = false;
+  uint8_t* s = src.ptr;
+  size_t i;
+  for (i = 0; i < n; i++, s += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);
+    if (c < 0x80000000) {
+      has_transparent = true;
+      continue;
+    }
+    uint8_t* p = counts + (4 * wuffs_base__pixel_palette__quantize__bin(c));
+    wuffs_base__store_u32le__no_bounds_check(
+        p, wuffs_base__load_u32le__no_bounds_check(p) + 1);
+  }
+
+  // Start with a single box holding every occupied bin. Repeatedly split the
+  // box with the largest product of population and longest side.
+  wuffs_base__pixel_palette__quantize__box boxes[256];
+  uint32_t n_bins = 0;
+  uint32_t bin;
+  for (bin = 0; bin < 32768; bin++) {
+    if (wuffs_base__load_u32le__no_bounds_check(counts + (4 * bin))) {
+      wuffs_base__store_u16le__no_bounds_check(list + (2 * n_bins),
+                                               (uint16_t)bin);
+      n_bins++;
+    }
+  }
+  uint32_t n_boxes = 0;
+  if (n_bins > 0) {
+    boxes[0].begin = 0;
+    boxes[0].end = n_bins;
+    wuffs_base__pixel_palette__quantize__shrink(&boxes[0], counts, list);
+    n_boxes = 1;
+  }
+
+  uint32_t max_boxes = max_colors - (has_transparent ? 1 : 0);
+  while (n_boxes < max_boxes) {
+    uint64_t best_score = 0;
+    uint32_t best_j = 0;
+    int best_axis = 0;
+    uint32_t j;
+    for (j = 0; j < n_boxes; j++) {
+      int axis;
+      for (axis = 0; axis < 3; axis++) {
+        uint64_t score = boxes[j].count *
+                         (boxes[j].max_incl[axis] - boxes[j].min_incl[axis]);
+        if (best_score < score) {
+          best_score = score;
+          best_j = j;
+          best_axis = axis;
+        }
+      }
+    }
+    if (best_score == 0) {
+      break;
+    }
+    wuffs_base__pixel_palette__quantize__split(&boxes[best_j], &boxes[n_boxes],
+                                               best_axis, counts, list);
+    n_boxes++;
+  }
+
+  // Re-purpose each bin's count to hold its box index.
+  uint32_t j;
+  for (j = 0; j < n_boxes; j++) {
+    uint32_t k;
+    for (k = boxes[j].begin; k < boxes[j].end; k++) {
+      wuffs_base__store_u32le__no_bounds_check(
+          counts +
+              (4 * wuffs_base__load_u16le__no_bounds_check(list + (2 * k))),
+          j);
+    }
+  }
+
+  // Map each pixel to its box, accumulating each box's mean color.
+  uint64_t sums[256][4] = {{0}};
+  uint8_t transparent_index = (uint8_t)n_boxes;
+  uint8_t* d = dst_indexes.ptr;
+  for (i = 0, s = src.ptr; i < n; i++, s += 4) {
+    uint32_t c = wuffs_base__load_u32le__no_bounds_check(s);
+    if (c < 0x80000000) {
+      d[i] = transparent_index;
+      continue;
+    }
+    uint32_t k = wuffs_base__load_u32le__no_bounds_check(
+        counts + (4 * wuffs_base__pixel_palette__quantize__bin(c)));
+    sums[k][0] += 0xFF & (c >> 0);
+    sums[k][1] += 0xFF & (c >> 8);
+    sums[k][2] += 0xFF & (c >> 16);
+    sums[k][3]++;
+    d[i] = (uint8_t)k;
+  }
+
+  uint8_t* p = dst_palette.ptr;
+  for (j = 0; j < n_boxes; j++, p += 4) {
+    uint64_t count = sums[j][3];
+    uint64_t half = count / 2;
+    p[0] = (uint8_t)((sums[j][0] + half) / count);
+    p[1] = (uint8_t)((sums[j][1] + half) / count);
+    p[2] = (uint8_t)((sums[j][2] + half) / count);
+    p[3] = 0xFF;
+  }
+  if (has_transparent) {
+    wuffs_base__store_u32le__no_bounds_check(p, 0);
+    n_boxes++;
+  }
+
+  ret.value = n_boxes;
+  return ret;
+}
+
+// --------
+
+wuffs_base__result_u64  //
+wuffs_base__frame_index__build(wuffs_base__image_decoder* dec,
+                               wuffs_base__frame_index_entry* dst_ptr,
+                               size_t dst_len,
+                               wuffs_base__io_buffer* src,
+                               wuffs_base__rect_ie_u32 image_bounds) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  if (!dec || (!dst_ptr && (dst_len > 0)) || !src) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  }
+
+  while (true) {
+    wuffs_base__frame_config fc = wuffs_base__null_frame_config();
+    wuffs_base__status status =
+        wuffs_base__image_decoder__decode_frame_config(dec, &fc, src);
+    ret.value = wuffs_base__image_decoder__num_decoded_frame_configs(dec);
+    if (status.repr == wuffs_base__note__end_of_data) {
+      break;
+    } else if (status.repr) {
+      ret.status = status;
+      break;
+    }
+
+    uint64_t i = wuffs_base__frame_config__index(&fc);
+    if (i >= dst_len) {
+      ret.status.repr = wuffs_base__error__bad_argument_length_too_short;
+      break;
+    }
+    wuffs_base__frame_index_entry* e = &dst_ptr[i];
+    e->io_position = wuffs_base__frame_config__io_position(&fc);
+    e->bounds = wuffs_base__frame_config__bounds(&fc);
+    e->duration = wuffs_base__frame_config__duration(&fc);
+    e->disposal = wuffs_base__frame_config__disposal(&fc);
+    if (i == 0) {
+      e->keyframe = true;
+    } else if (wuffs_base__rect_ie_u32__equals(&e->bounds, image_bounds) &&
+               wuffs_base__frame_config__opaque_within_bounds(&fc)) {
+      e->keyframe = true;
+    } else {
+      wuffs_base__frame_index_entry* prev = &dst_ptr[i - 1];
+      e->keyframe =
+          wuffs_base__rect_ie_u32__equals(&prev->bounds, image_bounds) &&
+          (prev->disposal ==
+           WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND);
+    }
+  }
+  return ret;
+}
+
+wuffs_base__result_u64  //
+wuffs_base__frame_index__seek(wuffs_base__image_decoder* dec,
+                              const wuffs_base__frame_index_entry* index_ptr,
+                              size_t index_len,
+                              uint64_t target,
+                              wuffs_base__io_buffer* src) {
+  wuffs_base__result_u64 ret;
+  ret.status.repr = NULL;
+  ret.value = 0;
+
+  if (!dec || !index_ptr) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  } else if (target >= index_len) {
+    ret.status.repr = wuffs_base__error__bad_argument;
+    return ret;
+  }
+
+  uint64_t k = target;
+  while ((k > 0) && (!index_ptr[k].keyframe ||
+                     ((k < target) &&
+                      (index_ptr[k].disposal ==
+                       WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS)))) {
+    k--;
+  }
+  uint64_t pos = index_ptr[k].io_position;
+
+  if (src) {
+    if ((pos < src->meta.pos) || ((pos - src->meta.pos) > src->meta.wi)) {
+      ret.status.repr = wuffs_base__error__bad_i_o_position;
+      return ret;
+    }
+  }
+  ret.status = wuffs_base__image_decoder__restart_frame(dec, k, pos);
+  if (ret.status.repr) {
+    return ret;
+  }
+  if (src) {
+    src->meta.ri = (size_t)(pos - src->meta.pos);
+  }
+  ret.value = k;
+  return ret;
+}
+
+// ---------------- String Conversions
+
+// wuffs_base__parse_number__foo_digits entries are 0x00 for invalid digits,
+// and (0x80 | v) for valid digits, where v is the 4 bit value.
+
+static const uint8_t wuffs_base__parse_number__decimal_digits[256] = {
+    // 0     1     2     3     4     5     6     7
+    // 8     9     A     B     C     D     E     F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x00 ..= 0x07.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x08 ..= 0x0F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x10 ..= 0x17.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x18 ..= 0x1F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x20 ..= 0x27.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x28 ..= 0x2F.
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,  // 0x30 ..= 0x37. '0'-'7'.
+    0x88, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x38 ..= 0x3F. '8'-'9'.
+
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x40 ..= 0x47.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x48 ..= 0x4F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x50 ..= 0x57.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x58 ..= 0x5F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x60 ..= 0x67.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x68 ..= 0x6F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x70 ..= 0x77.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x78 ..= 0x7F.
+
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x80 ..= 0x87.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x88 ..= 0x8F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x90 ..= 0x97.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x98 ..= 0x9F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xA0 ..= 0xA7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xA8 ..= 0xAF.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xB0 ..= 0xB7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xB8 ..= 0xBF.
+
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xC0 ..= 0xC7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xC8 ..= 0xCF.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xD0 ..= 0xD7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xD8 ..= 0xDF.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xE0 ..= 0xE7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xE8 ..= 0xEF.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xF0 ..= 0xF7.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0xF8 ..= 0xFF.
+    // 0     1     2     3     4     5     6     7
+    // 8     9     A     B     C     D     E     F
+};
+
+static const uint8_t wuffs_base__parse_number__hexadecimal_digits[256] = {
+    // 0     1     2     3     4     5     6     7
+    // 8     9     A     B     C     D     E     F
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x00 ..= 0x07.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x08 ..= 0x0F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x10 ..= 0x17.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x18 ..= 0x1F.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x20 ..= 0x27.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x28 ..= 0x2F.
+    0x80, 0x81, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,  // 0x30 ..= 0x37. '0'-'7'.
+    0x88, 0x89, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x38 ..= 0x3F. '8'-'9'.
+
+    0x00, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x00,  // 0x40 ..= 0x47. 'A'-'F'.
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x48 ..= 0x4F.
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x50 ..= 0x57.
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // 0x58 ..= 0x5F.
     0x00, 0x8A, 0x8B, 0x8C, 0x8D, 0x8E, 0x8F, 0x00,  // 0x60 ..= 0x67. 'a'-'f'.
@@ -9820,6 +12060,15 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
     self->private_impl.f_started = true;
     self->private_impl.f_state = 1;
   }
+  if (wuffs_base__utility__cpu_arch_have_x86_avx2()) {
+    self->private_impl.f_state = wuffs_base__utility__adler32_update_x86_avx2(
+        self->private_impl.f_state, a_x);
+    a_x = wuffs_base__slice_u8__suffix(a_x, (((uint64_t)(a_x.len)) & 31));
+  } else if (wuffs_base__utility__cpu_arch_have_x86_ssse3()) {
+    self->private_impl.f_state = wuffs_base__utility__adler32_update_x86_ssse3(
+        self->private_impl.f_state, a_x);
+    a_x = wuffs_base__slice_u8__suffix(a_x, (((uint64_t)(a_x.len)) & 31));
+  }
   v_s1 = ((self->private_impl.f_state) & 0xFFFF);
   v_s2 = ((self->private_impl.f_state) >> (32 - (16)));
   while (((uint64_t)(a_x.len)) > 0) {
@@ -9875,6 +12124,39 @@ wuffs_adler32__hasher__update_u32(wuffs_adler32__hasher* self,
   return self->private_impl.f_state;
 }
 
+// -------- func adler32.hasher.combine
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_adler32__hasher__combine(const wuffs_adler32__hasher* self,
+                               uint32_t a_adler_a,
+                               uint32_t a_adler_b,
+                               uint64_t a_len_b) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  uint32_t v_a1 = 0;
+  uint32_t v_a2 = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_r = 0;
+  uint32_t v_s1 = 0;
+  uint32_t v_s2 = 0;
+
+  v_a1 = (((a_adler_a)&0xFFFF) % 65521);
+  v_a2 = (((a_adler_a) >> (32 - (16))) % 65521);
+  v_b1 = (((a_adler_b)&0xFFFF) % 65521);
+  v_b2 = (((a_adler_b) >> (32 - (16))) % 65521);
+  v_r = ((uint32_t)((a_len_b % 65521)));
+  v_s1 = ((v_a1 + v_b1 + 65520) % 65521);
+  v_s2 = (((((v_r * v_a1) % 65521) + v_a2 + v_b2 + 65521) - v_r) % 65521);
+  return ((v_s2 << 16) | v_s1);
+}
+
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
         // defined(WUFFS_CONFIG__MODULE__ADLER32)
 
@@ -11263,6 +13545,875 @@ wuffs_bmp__decoder__workbuf_len(const wuffs_bmp__decoder* self) {
 
 // ---------------- Private Consts
 
+static const uint32_t                       //
+    wuffs_crc32__castagnoli_table[16][256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        {
+            0,          4067132163, 3778769143, 324072436,  3348797215,
+            904991772,  648144872,  3570033899, 2329499855, 2024987596,
+            1809983544, 2575936315, 1296289744, 3207089363, 2893594407,
+            1578318884, 274646895,  3795141740, 4049975192, 51262619,
+            3619967088, 632279923,  922689671,  3298075524, 2592579488,
+            1760304291, 2075979607, 2312596564, 1562183871, 2943781820,
+            3156637768, 1313733451, 549293790,  3537243613, 3246849577,
+            871202090,  3878099393, 357341890,  102525238,  4101499445,
+            2858735121, 1477399826, 1264559846, 3107202533, 1845379342,
+            2677391885, 2361733625, 2125378298, 820201905,  3263744690,
+            3520608582, 598981189,  4151959214, 85089709,   373468761,
+            3827903834, 3124367742, 1213305469, 1526817161, 2842354314,
+            2107672161, 2412447074, 2627466902, 1861252501, 1098587580,
+            3004210879, 2688576843, 1378610760, 2262928035, 1955203488,
+            1742404180, 2511436119, 3416409459, 969524848,  714683780,
+            3639785095, 205050476,  4266873199, 3976438427, 526918040,
+            1361435347, 2739821008, 2954799652, 1114974503, 2529119692,
+            1691668175, 2005155131, 2247081528, 3690758684, 697762079,
+            986182379,  3366744552, 476452099,  3993867776, 4250756596,
+            255256311,  1640403810, 2477592673, 2164122517, 1922457750,
+            2791048317, 1412925310, 1197962378, 3037525897, 3944729517,
+            427051182,  170179418,  4165941337, 746937522,  3740196785,
+            3451792453, 1070968646, 1905808397, 2213795598, 2426610938,
+            1657317369, 3053634322, 1147748369, 1463399397, 2773627110,
+            4215344322, 153784257,  444234805,  3893493558, 1021025245,
+            3467647198, 3722505002, 797665321,  2197175160, 1889384571,
+            1674398607, 2443626636, 1164749927, 3070701412, 2757221520,
+            1446797203, 137323447,  4198817972, 3910406976, 461344835,
+            3484808360, 1037989803, 781091935,  3705997148, 2460548119,
+            1623424788, 1939049696, 2180517859, 1429367560, 2807687179,
+            3020495871, 1180866812, 410100952,  3927582683, 4182430767,
+            186734380,  3756733383, 763408580,  1053836080, 3434856499,
+            2722870694, 1344288421, 1131464017, 2971354706, 1708204729,
+            2545590714, 2229949006, 1988219213, 680717673,  3673779818,
+            3383336350, 1002577565, 4010310262, 493091189,  238226049,
+            4233660802, 2987750089, 1082061258, 1395524158, 2705686845,
+            1972364758, 2279892693, 2494862625, 1725896226, 952904198,
+            3399985413, 3656866545, 731699698,  4283874585, 222117402,
+            510512622,  3959836397, 3280807620, 837199303,  582374963,
+            3504198960, 68661723,   4135334616, 3844915500, 390545967,
+            1230274059, 3141532936, 2825850620, 1510247935, 2395924756,
+            2091215383, 1878366691, 2644384480, 3553878443, 565732008,
+            854102364,  3229815391, 340358836,  3861050807, 4117890627,
+            119113024,  1493875044, 2875275879, 3090270611, 1247431312,
+            2660249211, 1828433272, 2141937292, 2378227087, 3811616794,
+            291187481,  34330861,   4032846830, 615137029,  3603020806,
+            3314634738, 939183345,  1776939221, 2609017814, 2295496738,
+            2058945313, 2926798794, 1545135305, 1330124605, 3173225534,
+            4084100981, 17165430,   307568514,  3762199681, 888469610,
+            3332340585, 3587147933, 665062302,  2042050490, 2346497209,
+            2559330125, 1793573966, 3190661285, 1279665062, 1595330642,
+            2910671697,
+        },
+        {
+            0,          329422967,  658845934,  887597209,  1317691868,
+            1562966443, 1775194418, 2054015301, 2635383736, 2394315727,
+            3125932886, 2851302177, 3550388836, 3225172499, 4108030602,
+            3883469565, 1069937025, 744974838,  411091311,  186800408,
+            1901039709, 1659701290, 1443537075, 1168652484, 2731618873,
+            2977147470, 2241069783, 2520160928, 3965408229, 4294560658,
+            3407766283, 3636263804, 2139874050, 1814657909, 1489949676,
+            1265388443, 822182622,  581114537,  373600816,  98970183,
+            3802079418, 4047354061, 3319402580, 3598223395, 2887074150,
+            3216496913, 2337304968, 2566056447, 1078858371, 1408010996,
+            1728782957, 1957280282, 247755615,  493284136,  696337329,
+            975428550,  3713716539, 3472378188, 4196393429, 3921508770,
+            2479927527, 2154965136, 3029696521, 2805405822, 4279748100,
+            3971309171, 3629315818, 3421531805, 2979899352, 2722054063,
+            2530776886, 2239369025, 1644365244, 1906417099, 1162229074,
+            1457827109, 747201632,  1059847191, 197940366,  409914617,
+            3235002245, 3547377650, 3885434731, 4097154844, 2388153945,
+            2650459694, 2837276343, 3133144768, 1573319741, 1315204170,
+            2055455955, 1763794084, 323786209,  15601046,   873047311,
+            665533816,  2157716742, 2470362481, 2816021992, 3027996063,
+            3457565914, 3719617709, 3914560564, 4210158659, 495511230,
+            237665993,  986568272,  695160359,  1392674658, 1084235541,
+            1950857100, 1743073275, 3210335367, 2902150384, 2552030313,
+            2344516638, 4057183579, 3799067948, 3600188853, 3308527042,
+            575477567,  837783368,  84420561,   380288934,  1825011427,
+            2137386644, 1266828813, 1478549114, 4223924985, 3898696334,
+            3699821079, 3475264096, 3041499941, 2800419666, 2450303947,
+            2175677372, 1725380929, 1970643254, 1100089775, 1378914776,
+            677206173,  1006616810, 253257843,  482013188,  3288730488,
+            3617886991, 3812834198, 4041319393, 2324458148, 2569990867,
+            2915654218, 3194733117, 1494403264, 1253068983, 2119694382,
+            1844797529, 395880732,  70922603,   819829234,  595526021,
+            2219317755, 2548728204, 2735548693, 2964304226, 3401742375,
+            3647004752, 3985066185, 4263891134, 425515587,  184435252,
+            1041885869, 767259354,  1473690527, 1148462056, 1888717681,
+            1664160518, 3146639482, 2821681165, 2630408340, 2406105315,
+            4110911910, 3869577681, 3527588168, 3252691263, 647572418,
+            893105077,  31202092,   310281051,  1746094622, 2075251305,
+            1331067632, 1559552647, 81018109,   393651338,  596708371,
+            808686692,  1247698209, 1509737814, 1830514127, 2126116280,
+            2579562309, 2321704754, 3196440491, 2905036764, 3611991705,
+            3303540462, 4027559543, 3819779584, 991022460,  682841355,
+            475331986,  267806181,  1973136544, 1715025111, 1390320718,
+            1098646585, 2785349316, 3047659187, 2168471082, 2464327261,
+            3901714200, 4214093679, 3486146550, 3697854337, 2069880831,
+            1761429384, 1545269009, 1337489254, 903200291,  645342804,
+            311463629,  20059834,   3863682119, 4125721648, 3238931625,
+            3534533854, 2831252891, 3143886316, 2407812469, 2619790594,
+            1150955134, 1463334409, 1675566736, 1887274727, 168841122,
+            431151061,  760577868,  1056433979, 3650022854, 3391911345,
+            4274773288, 3983099231, 2533657626, 2225476717, 2957098228,
+            2749572227,
+        },
+        {
+            0,          2772537982, 1332695565, 3928932467, 2665391130,
+            1000289892, 3518101015, 1961911401, 944848581,  2635115707,
+            2000579784, 3531603638, 2794429151, 63834273,   3923822802,
+            1285642924, 1889697162, 3588485108, 1070411655, 2592914937,
+            4001159568, 1262308334, 2702412701, 72489443,   1223902031,
+            3987919153, 127668546,  2732426044, 3593332565, 1936487723,
+            2571285848, 1006839590, 3779394324, 1141205354, 2922096921,
+            191511399,  2140823310, 3671838064, 821366019,  2511642493,
+            3642082769, 2085902255, 2524616668, 859506082,  1204511179,
+            3800757173, 144978886,  2917507512, 2447804062, 883365088,
+            3733574803, 2076722925, 255337092,  2860101882, 1079472265,
+            3843482359, 2847389787, 217459237,  3872975446, 1134131240,
+            929635393,  2452131391, 2013679180, 3712474162, 3345318105,
+            1646531239, 2282410708, 759906474,  1505436867, 4244289213,
+            383022798,  3012945072, 4281646620, 1517628514, 2958814225,
+            354057839,  1642732038, 3299575928, 780486667,  2344934005,
+            3083337043, 310800173,  4171804510, 1575566624, 689527113,
+            2354629431, 1719012164, 3275200826, 2409022358, 718754280,
+            3237581211, 1706558437, 289957772,  3020551666, 1579627905,
+            4217808895, 639728589,  2204166579, 1766730176, 3423583166,
+            3103776727, 499010985,  4153445850, 1389436836, 510674184,
+            3140605814, 1360992005, 4099835259, 2158944530, 636449644,
+            3485578015, 1786782049, 1451427399, 4089615417, 434918474,
+            3165505076, 3361579613, 1830563875, 2268262480, 577987118,
+            1859270786, 3415452412, 566061711,  2231171313, 4027358360,
+            1431113446, 3210989205, 438459627,  2334619459, 778495293,
+            3293062478, 1628026672, 368694105,  2964865319, 1519812948,
+            4292285226, 3010873734, 372759544,  4229503883, 1498974709,
+            766045596,  2297004002, 1657257873, 3347459567, 4219800265,
+            1589942455, 3035257028, 296471226,  1700507347, 3222944941,
+            708115678,  2406837920, 3285464076, 1721083506, 2361091585,
+            704312447,  1560973334, 4165665384, 308658715,  3072610405,
+            1784908887, 3475119657, 621600346,  2152549412, 4106037325,
+            1375517235, 3151133248, 513009726,  1379054226, 4151517420,
+            492691615,  3088872161, 3438024328, 1772979446, 2206418053,
+            650303227,  448917981,  3212862371, 1437508560, 4042207662,
+            2216646087, 559859641,  3413116874, 1848743348, 579915544,
+            2278645094, 1845468437, 3367898987, 3159255810, 420477308,
+            4079040783, 1449175921, 1279457178, 3909314020, 53323159,
+            2792110057, 3533460352, 2011021822, 2649948557, 951227379,
+            1947453791, 3511835425, 998021970,  2654800172, 3939331397,
+            1334640443, 2778873672, 14921014,   1021348368, 2577471598,
+            1938806813, 3603843683, 2721984010, 125811828,  3981540359,
+            1209069177, 78755029,   2716870315, 1272899288, 4003427494,
+            2590970063, 1060012721, 3573564098, 1883361468, 2902854798,
+            138911472,  3798556291, 1193856253, 869836948,  2526624490,
+            2092432025, 3656804583, 2505519691, 806789173,  3661127750,
+            2138698296, 193566289,  2932343855, 1155974236, 3785840162,
+            3718541572, 2028331898, 2462786313, 931836279,  1132123422,
+            3862644576, 202737427,  2840860013, 3858059201, 1085595071,
+            2862226892, 266047410,  2066475995, 3731519909, 876919254,
+            2433035176,
+        },
+        {
+            0,          3712330424, 3211207553, 1646430521, 2065838579,
+            2791807819, 3292861042, 419477706,  4131677158, 721537374,
+            1227047015, 2489772767, 2372293141, 1344534701, 838955412,
+            4014267180, 3915690301, 874584965,  1443074748, 2336634884,
+            2454094030, 1325607542, 757179215,  4033087991, 522244827,
+            3261429859, 2689069402, 2097306594, 1677910824, 3108456848,
+            3680878761, 102787601,  3609531531, 174112307,  1749169930,
+            3037175218, 2886149496, 1900187584, 325060345,  3458575425,
+            560035693,  4230274517, 2651215084, 1128529492, 1514358430,
+            2265377830, 3844367647, 945934247,  1044489654, 3808694030,
+            2166785591, 1550003343, 1164153925, 2552643325, 4194613188,
+            658578812,  3355821648, 356543720,  2002970065, 2854702953,
+            3005740963, 1851940123, 205575202,  3506798234, 2879807463,
+            1994650975, 348224614,  3380926174, 3498339860, 230802604,
+            1877167509, 2997282605, 1575107585, 2158466745, 3800375168,
+            1069593912, 650120690,  4219840330, 2577870451, 1155695819,
+            1120071386, 2676442210, 4255501659, 551577571,  971038505,
+            3836048785, 2257058984, 1539462672, 3028716860, 1774397316,
+            199339709,  3601073157, 3483679951, 316741239,  1891868494,
+            2911254006, 2088979308, 2714165716, 3286526189, 513917525,
+            128023199,  3672428583, 3100006686, 1703146406, 2328307850,
+            1468170802, 899681035,  3907363251, 4058323321, 748729281,
+            1317157624, 2479329344, 2515008081, 1218597097, 713087440,
+            4156912488, 4005940130, 864051482,  1369630755, 2363966107,
+            1671666103, 3202757391, 3703880246, 25235598,   411150404,
+            3317957372, 2816904133, 2057511293, 1386268991, 2414175111,
+            3989301950, 813842438,  696449228,  4106703476, 2531646285,
+            1268806133, 2766449369, 2040594529, 461605208,  3334874080,
+            3754335018, 42152338,   1621211307, 3185840659, 3150215170,
+            1719784122, 77814659,   3655790907, 3236317681, 497279817,
+            2139187824, 2730803400, 1300241380, 2428875100, 4075239525,
+            799183581,  916597271,  3957817519, 2311391638, 1417716526,
+            2240142772, 1489008396, 987954741,  3886503053, 4272417863,
+            602031871,  1103155142, 2625987966, 1942077010, 2927891690,
+            3433471443, 300103531,  149131169,  3584435481, 3078925344,
+            1791035032, 1826712713, 2980365873, 3548794632, 247719344,
+            398679418,  3397842882, 2829352699, 1977734211, 2594508655,
+            1205904855, 633482478,  4169631318, 3783736988, 1019384868,
+            1591745821, 2208675749, 4177958616, 608386144,  1180808537,
+            2602835937, 2183440171, 1600195987, 1027835050, 3758501394,
+            256046398,  3523698566, 2955269823, 1835039751, 1952498893,
+            2837802613, 3406292812, 373444084,  274868197,  3441921373,
+            2936341604, 1916841692, 1799362070, 3053829294, 3559339415,
+            157458223,  3861267459, 996404923,  1497458562, 2214907194,
+            2634315248, 1078058824, 576935537,  4280745161, 774079059,
+            4083558635, 2437194194, 1275136874, 1426174880, 2286164248,
+            3932590113, 925055641,  3630686645, 86133517,   1728102964,
+            3125110924, 2739261510, 2113960702, 472052679,  3244775807,
+            3343332206, 436378070,  2015367407, 2774907479, 3160736413,
+            1629530149, 50471196,   3729230756, 822300808,  3964074544,
+            2388947721, 1394727345, 1243701627, 2539965379, 4115022586,
+            671344706,
+        },
+        {
+            0,          940666796,  1881333592, 1211347188, 3762667184,
+            3629437212, 2422694376, 2826309188, 3311864721, 4252394557,
+            3041252553, 2371140453, 623031585,  489937549,  1426090617,
+            1829832149, 2401395155, 3073576575, 4278238859, 3339833639,
+            1869078371, 1467396303, 524615739,  659845015,  1246063170,
+            1918109166, 979875098,  41343670,   2852181234, 2450635614,
+            3659664298, 3795018758, 464041303,  599382779,  1804233231,
+            1402668451, 4226616295, 3288097867, 2345653439, 3017718547,
+            3738156742, 3873362282, 2934792606, 2533101106, 1049231478,
+            110850010,  1319690030, 1991880834, 2492126340, 2895887144,
+            3836218332, 3703137392, 1959750196, 1289618840, 82687340,
+            1023204032, 1374543637, 1778167993, 567214157,  434008033,
+            2980602277, 2310606345, 3247095549, 4187738449, 928082606,
+            255853826,  1198765558, 2137184858, 3608466462, 4010130354,
+            2805336902, 2670159082, 4063650111, 3391557267, 2182397543,
+            3120943563, 309583759,  711110691,  1649475799, 1514172283,
+            3094547325, 2153931985, 3360805925, 4030774153, 1479980493,
+            1613224545, 672426645,  268764473,  2098462956, 1157984064,
+            221700020,  891793432,  2639380060, 2772488688, 3983761668,
+            3579973288, 754573305,  350793813,  1557856417, 1690988301,
+            3434897737, 4104982245, 3164519953, 2224017853, 3919500392,
+            3515857860, 2579237680, 2712495260, 165374680,  835323252,
+            2046408064, 1105779244, 2749087274, 2613760390, 3556335986,
+            3957853918, 1134428314, 2072997686, 868016066,  195932270,
+            1723643323, 1588451863, 379480803,  781124943,  2264468235,
+            3202901159, 4141601875, 3469392895, 1856165212, 1454619376,
+            511707652,  647062952,  2397531116, 3069576256, 4274369716,
+            3335838488, 2881871565, 2480189793, 3689349525, 3824578105,
+            1266704509, 1938886609, 1000521509, 62115977,   3783308431,
+            3650214691, 2443340759, 2847081595, 29690431,   970220947,
+            1911018855, 1240906443, 619167518,  485937330,  1422221382,
+            1825837034, 3298951598, 4239617538, 3028344566, 2358358362,
+            1963614219, 1293619111, 86556499,   1027199231, 2505039547,
+            2908664087, 3849126371, 3715919439, 2959960986, 2289828918,
+            3226449090, 4166966126, 1344853290, 1748613766, 537528946,
+            404448734,  4196925912, 3258543732, 2315968128, 2988159276,
+            443400040,  578605252,  1783586864, 1381896092, 1062144585,
+            123626981,  1332598033, 2004662973, 3742020857, 3877362517,
+            2938661793, 2537096205, 1509146610, 1642254430, 701587626,
+            297799430,  3115712834, 2175233774, 3381976602, 4052070838,
+            2626991203, 2760235983, 3971377979, 3567715479, 2094074579,
+            1153459583, 217306507,  887274023,  3604078113, 4005605773,
+            2800943481, 2665639637, 915693713,  243601213,  1186381769,
+            2124927077, 330749360,  732412444,  1670646504, 1535468868,
+            4092816128, 3420587180, 2211558488, 3149978612, 1113262757,
+            2051695881, 846845437,  174635601,  2719921173, 2584730553,
+            3527174989, 3928818913, 2268856628, 3207425688, 4145995372,
+            3473912256, 1736032132, 1600704552, 391864540,  793382768,
+            3447286646, 4117234906, 3176903726, 2236275586, 758961606,
+            355318378,  1562249886, 1695507762, 136208615,  806293323,
+            2017247167, 1076744211, 3898334807, 3494556155, 2558066959,
+            2691198627,
+        },
+        {
+            0,          4012927769, 3683426499, 884788186,  3002414967,
+            1573215342, 1769576372, 2252995757, 1611012127, 2402710278,
+            3146430684, 1421530053, 3539152744, 1036207217, 159354795,
+            3863995570, 3222024254, 792484647,  461410557,  4105239524,
+            1928922953, 2647223376, 2843060106, 1178979475, 2685020193,
+            1329218360, 2072414434, 2495013883, 318709590,  4258231375,
+            3379806101, 641979532,  2247366285, 1791262100, 1584969294,
+            2974342487, 922821114,  3627109091, 3968696633, 62777888,
+            3857845906, 180512139,  1048489553, 3511600456, 1460091365,
+            3090633468, 2357958950, 1673261631, 1173890739, 2865253802,
+            2658436720, 1900342633, 4144828868, 406682333,  746696967,
+            3283212830, 637419180,  3402519989, 4268924527, 289600886,
+            2534083035, 2017157826, 1283959064, 2746728961, 235166699,
+            3778294002, 3582524200, 985174065,  3169938588, 1405159301,
+            1736297567, 2286790470, 1845642228, 2167548141, 3046040375,
+            1522436142, 3707204739, 868687770,  125555776,  3897278297,
+            3456658389, 557318348,  361024278,  4206141455, 2096979106,
+            2479699899, 2809265249, 1212258168, 2920182730, 1094588627,
+            1971507977, 2595403792, 486229181,  4090179492, 3346523262,
+            675778407,  2347781478, 1690314367, 1350364581, 3209463484,
+            956660241,  3593801992, 3800685266, 230273483,  3958789497,
+            80100960,   813364666,  3746209443, 1493393934, 3056797975,
+            2190459597, 1841277396, 1274838360, 2764838465, 2423315867,
+            2134947458, 4178135599, 372842806,  579201772,  3451224565,
+            737830215,  3301576286, 4034315652, 524725917,  2567918128,
+            1983854889, 1115943667, 2914228714, 470333398,  4080590031,
+            3347322645, 682916876,  2935849121, 1104014264, 1970348130,
+            2587970427, 2081337289, 2470364368, 2810318602, 1219650579,
+            3472595134, 567014311,  360134781,  4198978404, 3691284456,
+            859106545,  126363435,  3904392242, 1861333151, 2176965510,
+            3044872284, 1515027269, 3154288631, 1395848430, 1737375540,
+            2294174765, 251111552,  3787965337, 3581610051, 978019162,
+            2583470427, 1993132610, 1114636696, 2906679937, 722048556,
+            3292134709, 4035262191, 531979766,  4193958212, 382390877,
+            578165127,  3443946142, 1259310643, 2755650858, 2424516336,
+            2142455273, 1508938085, 3066100348, 2189177254, 1833720511,
+            3943015954, 70634763,   814286545,  3753471432, 972458362,
+            3603358307, 3799656889, 222970528,  2332278285, 1681118484,
+            1351556814, 3216995799, 302836797,  4248602404, 3380628734,
+            649078759,  2700729162, 1338617939, 2071296905, 2487554192,
+            1913320482, 2637864763, 2844153057, 1186349048, 3237987157,
+            802138188,  460546966,  4098033807, 3523271683, 1026602778,
+            160201920,  3871086553, 1626729332, 2412085357, 3145288631,
+            1414078638, 2986787868, 1563864837, 1770677471, 2260340678,
+            15987563,   4022573170, 3682554792, 877607089,  2549676720,
+            2026410409, 1282693747, 2739155306, 621661639,  3393038046,
+            4269894916, 296814109,  4160676527, 416188854,  745685612,
+            3275893109, 1158403544, 2856042177, 2659677467, 1907826178,
+            1475660430, 3099894167, 2356701773, 1665663316, 3842113017,
+            171022048,  1049451834, 3518838307, 938660497,  3636640136,
+            3967709778, 55449931,   2231887334, 1782025983, 1586185509,
+            2981834300,
+        },
+        {
+            0,          1745038536, 3490077072, 3087365464, 2782971345,
+            3454265625, 1978047553, 501592201,  1311636819, 640602523,
+            2653660355, 4129851403, 3956095106, 2211320906, 1003184402,
+            1405636058, 2623273638, 4099462766, 1281205046, 610177022,
+            968572791,  1371018175, 3921503975, 2176731695, 3530950645,
+            3128240957, 40918629,   1785950893, 2006368804, 529919724,
+            2811272116, 3482564476, 1029407677, 1431875445, 3982350893,
+            2237593317, 2562410092, 4038617764, 1220354044, 549335860,
+            1937145582, 460673574,  2742036350, 3413314486, 3600202559,
+            3197474807, 110158511,  1855180391, 2701162779, 3372438995,
+            1896226955, 419761219,  81837258,   1826852866, 3571901786,
+            3169175954, 4012737608, 2267981952, 1059839448, 1462300944,
+            1254965657, 583953745,  2597001225, 4073206977, 2058815354,
+            313797554,  2863750890, 3266474530, 3747070635, 3075796579,
+            257006395,  1733474291, 882571817,  1553585889, 3835470777,
+            2359267185, 2440708088, 4185461552, 1098671720, 696208032,
+            3874291164, 2398081300, 921347148,  1592363140, 1124874253,
+            722408645,  2466931101, 4211690837, 2831220879, 3233950791,
+            2026330399, 281310679,  220317022,  1696786838, 3710360782,
+            3039080454, 1206682823, 804235279,  2548751703, 4293521823,
+            3792453910, 2316266974, 839522438,  1510552654, 163674516,
+            1640125788, 3653705732, 2982415564, 2887892037, 3290599565,
+            2082989525, 337955101,  3686235745, 3014939305, 196159473,
+            1672612665, 2119678896, 374642552,  2924601888, 3327315688,
+            2509931314, 4254707706, 1167907490, 765458026,  813319907,
+            1484352043, 3766230899, 2290037691, 4117630708, 2641175100,
+            627595108,  1298889644, 1351535397, 948824045,  2156434101,
+            3901472381, 3141792679, 3544244079, 1799727671, 54953727,
+            514012790,  1990204094, 3466948582, 2795914030, 1765143634,
+            20371610,   3107171778, 3509616906, 3436523907, 2765495627,
+            483616787,  1959806171, 655886593,  1327179209, 4145959057,
+            2669509721, 2197343440, 3942375448, 1392416064, 989706632,
+            3358952777, 2687934849, 406050009,  1882257425, 1842694296,
+            97936464,   3184726280, 3587194304, 2249748506, 3994770642,
+            1444817290, 1042089282, 603502027,  1274779907, 4093570139,
+            2617098387, 1416525807, 1013799719, 2221420159, 3966436023,
+            4052660798, 2576195318, 562621358,  1233897318, 440634044,
+            1916839540, 3393573676, 2722562020, 3215150957, 3617612709,
+            1873090301, 128334389,  2413365646, 3889833286, 1608470558,
+            937196758,  708430943,  1111154839, 4198471119, 2453453063,
+            3254056157, 2851592213, 301116749,  2045870469, 1679044876,
+            202841540,  3021105308, 3692119124, 327349032,  2072109024,
+            3280251576, 2877785712, 3059889913, 3730905649, 1717858153,
+            241648545,  1571753595, 900473523,  2376685547, 3853155107,
+            4165979050, 2420959074, 675910202,  1078640370, 2994899507,
+            3665929979, 1652872099, 176684907,  392318946,  2137088810,
+            3345225330, 2942778042, 4239357792, 2494323624, 749285104,
+            1151992376, 1498395313, 827104889,  2303322913, 3779774441,
+            786002069,  1188715613, 4276037893, 2531001805, 2335814980,
+            3812268428, 1530916052, 859619356,  1626639814, 150446350,
+            2968704086, 3639736478, 3306440727, 2903991519, 353505671,
+            2098281807,
+        },
+        {
+            0,          1228700967, 2457401934, 3678701417, 555582061,
+            1747058506, 3009771555, 4200137988, 1111164122, 185039357,
+            3494117012, 2575270835, 1663469239, 706411408,  4049501433,
+            3093430750, 2222328244, 3444208787, 370078714,  1597148893,
+            2775288793, 3965187838, 924021143,  2117012656, 3326938478,
+            2406576201, 1412822816, 487164423,  3880816387, 2926375460,
+            1965585741, 1007945834, 218129817,  1144789182, 2675482583,
+            3594838768, 740157428,  1696701139, 3194297786, 4149829789,
+            1329291587, 101129316,  3712195341, 2491409962, 1848042286,
+            656055817,  4234025312, 3043124295, 2306239533, 3226079498,
+            453940835,  1379068740, 2825645632, 3780612967, 974328846,
+            1932486953, 3410847991, 2188449232, 1496683193, 269086622,
+            3931171482, 2741802941, 2015891668, 823422451,  436259634,
+            1396487701, 2289578364, 3242478683, 991775071,  1914778744,
+            2842014481, 3763981878, 1480314856, 285717199,  3393402278,
+            2206156929, 2032553349, 807022754,  3948853195, 2724383468,
+            2658583174, 3612000161, 202258632,  1160922607, 3211477227,
+            4132912588, 756267685,  1680852866, 3696084572, 2507258747,
+            1312111634, 118047029,  4249895985, 3026991382, 1864941183,
+            638894936,  385920683,  1581044620, 2239255781, 3427019202,
+            907881670,  2132890081, 2758137480, 3982076847, 1429973617,
+            470275926,  3343077439, 2390699288, 1948657692, 1025135931,
+            3864973906, 2942480245, 2474026783, 3662338616, 17718609,
+            1211244662, 2993366386, 4216805461, 538173244,  1764729371,
+            3511526341, 2557599458, 1127569803, 168371372,  4031783336,
+            3110886543, 1646844902, 722773697,  872519268,  2101209923,
+            2792975402, 4014280973, 354161673,  1545627950, 2271538759,
+            3461911392, 1983550142, 1057419161, 3829557488, 2910721495,
+            1462178003, 505114100,  3311397533, 2355337146, 2960629712,
+            4182500087, 571434398,  1798510777, 2439650749, 3629539482,
+            51570675,   1244568276, 4065106698, 3144738349, 1614045508,
+            688397411,  3545307495, 2590860352, 1093264169, 135634446,
+            956429309,  1883082458, 2876836275, 3796202644, 404517264,
+            1361054903, 2321845214, 3277387513, 2067461927, 839289344,
+            3913420137, 2692640846, 1512535370, 320538733,  3361705732,
+            2170810915, 3178756681, 4098590574, 789512199,  1714650400,
+            2624223268, 3579184387, 236094058,  1194262349, 4283235987,
+            3060827060, 1832125661, 604535290,  3729882366, 2540503513,
+            1277789872, 85326743,   771841366,  1732059249, 3162089240,
+            4114995775, 253550395,  1176543772, 2640586101, 3562559570,
+            1815763340, 621159595,  4265780162, 3078545125, 1294457825,
+            68921030,   3747553711, 2523094152, 2859947234, 3813353925,
+            940551852,  1899221899, 2339034767, 3260459944, 420621505,
+            1345212902, 3897315384, 2708483359, 2050271862, 856217425,
+            3377582677, 2154671986, 1529423899, 303387964,  587282639,
+            1782400488, 2977546881, 4165320614, 35437218,   1260439429,
+            2422489324, 3646438859, 1631206421, 671498546,  4081239643,
+            3128867708, 1076346488, 152814431,  3529458742, 2606971153,
+            2809606523, 3997912156, 890227509,  2083763730, 2255139606,
+            3478572593, 336742744,  1563309183, 3846976929, 2893039750,
+            1999949807, 1040757448, 3293689804, 2372782827, 1445547394,
+            521482405,
+        },
+        {
+            0,          4097758792, 3985758817, 430902313,  3738157619,
+            720442491,  861804626,  3345010202, 3094606487, 1280124127,
+            1440884982, 2715614910, 1723609252, 2458052332, 2335042245,
+            2131967117, 1963693023, 2167752087, 2560248254, 1822728182,
+            2881769964, 1610254244, 1180011405, 2993380805, 3447218504,
+            960935680,  552188713,  3570888033, 330802043,  3884545331,
+            4263934234, 169389906,  3927386046, 506065398,  126287327,
+            4088933271, 886629773,  3236312005, 3645456364, 762833316,
+            1382339881, 2790916961, 3220508488, 1271650560, 2360022810,
+            2023080274, 1631243643, 2500074291, 2669458529, 1797415465,
+            1921871360, 2259925064, 1104377426, 3052249114, 2890050611,
+            1484552827, 661604086,  3545338046, 3405683863, 1052789471,
+            4188046533, 228479629,  338779812,  3759114476, 3519166861,
+            637333445,  1012130796, 3362600356, 252574654,  4214435318,
+            3801883103, 379778967,  1773259546, 2643402066, 2216694139,
+            1881065267, 3078490409, 1128324961, 1525666632, 2932933888,
+            2764679762, 1358396442, 1230532659, 3177621115, 2047240289,
+            2386083369, 2543301120, 1672045640, 481974469,  3901001357,
+            4046160548, 85284076,   3262487286, 910904510,  803487895,
+            3688535775, 1003822643, 3488335995, 3594830930, 578425370,
+            3843742720, 287574600,  143328865,  4239773737, 2208754852,
+            2006465260, 1849112261, 2584338573, 1567174295, 2841114847,
+            2969105654, 1153835710, 1323208172, 3135265700, 2739885965,
+            1467056581, 2417053663, 1680841111, 2105578942, 2310947830,
+            4138565499, 43231539,   456959258,  4009915218, 677559624,
+            3697044224, 3321063209, 835563873,  2791835115, 1381421987,
+            1274666890, 3217492418, 2024261592, 2358841744, 2503351737,
+            1627966449, 505149308,  3928301876, 4085919005, 129301333,
+            3235132751, 887808775,  759557934,  3648731494, 3546519092,
+            660422780,  1056066645, 3402406429, 229397511,  4187128399,
+            3762130534, 335763502,  1796236451, 2670637803, 2256649922,
+            1925146762, 3051333264, 1105293528, 1481538801, 2893064889,
+            1283400277, 3091330077, 2716792884, 1439706748, 2461065318,
+            1720596014, 2132883975, 2334125135, 4094480578, 3278474,
+            429722275,  3986939115, 717427441,  3741172921, 3344091280,
+            862723800,  963948938,  3444205506, 3571805163, 551271843,
+            3887821753, 327525873,  170568152,  4262756240, 2164736797,
+            1966708053, 1821809020, 2561167156, 1606975790, 2885048166,
+            2992200527, 1181191431, 2007645286, 2207574574, 2587616775,
+            1845833807, 2842033749, 1566255133, 1156850740, 2966090364,
+            3487158001, 1005000889, 575149200,  3598107352, 286657730,
+            3844659850, 4236760739, 146342123,  44150713,   4137646577,
+            4012930520, 453944208,  3698224522, 676379586,  838842347,
+            3317784995, 3134348590, 1324125030, 1464043343, 2742898951,
+            1679662877, 2418231637, 2307671420, 2108855092, 2646416344,
+            1770245520, 1881981369, 2215778289, 1131600363, 3075215267,
+            2934113162, 1524487618, 634317135,  3522182919, 3361682222,
+            1013048678, 4211157884, 255851828,  378597661,  3803064149,
+            3904276487, 478699087,  86463078,   4044981294, 913918516,
+            3259473020, 3689451605, 802571805,  1355119248, 2767957208,
+            3176440049, 1231713977, 2383067299, 2050256619, 1671127746,
+            2544219274,
+        },
+        {
+            0,          3411442597, 2470478267, 1477900830, 594376071,
+            3896184354, 2955801660, 2071695257, 1188752142, 2374799531,
+            3583666869, 516690192,  1706532489, 2934039852, 4143390514,
+            1033987223, 2377504284, 1189326265, 519395239,  3584240642,
+            2933433243, 1703860286, 1033380384, 4140718469, 3413064978,
+            3753655,    1479523497, 2474231564, 3892463765, 592720688,
+            2067974446, 2954146443, 512219849,  3587285356, 2378652530,
+            1183916247, 1038790478, 4139570411, 2930388725, 1711035728,
+            1482502599, 2466990690, 3407720572, 4967385,    2066760768,
+            2959491045, 3899704827, 589741662,  2469530837, 1482979184,
+            7507310,    3408197323, 2959046994, 2064188151, 589297897,
+            3897131852, 3588810715, 515808382,  1185441376, 2382241221,
+            4135948892, 1037298169, 1707414503, 2928896066, 1024439698,
+            4133080631, 2924426281, 1696157580, 509788181,  3577002928,
+            2367832494, 1182022155, 2077580956, 2961384761, 3902136103,
+            600024194,  1488464667, 2481868990, 3422071456, 11456773,
+            2965005198, 2079070251, 603644469,  3903625616, 2480346633,
+            1484877228, 9934770,    3418483735, 4133521536, 1027011365,
+            1696598331, 2926998174, 3574463751, 509314722,  1179483324,
+            2367358745, 596143963,  3906868478, 2965958368, 2073990469,
+            15014620,   3417530745, 2477103975, 1492377794, 1699906645,
+            2919563248, 4128376302, 1027898955, 1178595794, 2372504183,
+            3581898857, 506006476,  2923280711, 1701561058, 1031616764,
+            4130030425, 2370882752, 1174845285, 504384891,  3578148574,
+            3907473993, 598813164,  2074596338, 2968627287, 3414829006,
+            14441579,   1489675893, 2476531152, 2048879396, 2974355585,
+            3915377311, 571052346,  1500651171, 2451858694, 3392315160,
+            23389373,   1019576362, 4153670543, 2944729489, 1691580980,
+            531166637,  3573452296, 2364044310, 1203638195, 4155161912,
+            1023198877, 1693072515, 2948351782, 3569862847, 529642266,
+            1200048388, 2362520225, 2976929334, 2049322387, 573626253,
+            3915820072, 2451383217, 1498109972, 22913546,   3389774255,
+            1687728621, 2949565000, 4158140502, 1015958515, 1207288938,
+            2359541711, 3568649681, 534986356,  574773987,  3910410566,
+            2969754456, 2052366589, 19869540,   3396949185, 2456792799,
+            1496962426, 3912067057, 578493524,  2054022730, 2973474287,
+            3393196662, 18246099,   1493210061, 2455169128, 2952236287,
+            1688336218, 1018629444, 4158748385, 2358966648, 1204585181,
+            534411459,  3565945702, 1192287926, 2353440019, 3562037005,
+            520496296,  1685957425, 2938884244, 4147980938, 1013666095,
+            30029240,   3399241245, 2458563587, 1507643302, 581386303,
+            3924900762, 2984755588, 2058467873, 3399813290, 32731919,
+            1508215057, 2461266612, 3922230573, 580781704,  2055797910,
+            2984150835, 2357191588, 1193908225, 524247583,  3563657658,
+            2937230883, 1682238854, 1012012952, 4144262205, 1503069311,
+            2462154714, 3403122116, 25296481,   2063233528, 2980842077,
+            3921342531, 585927654,  525201265,  3558577364, 2349690570,
+            1197151599, 1008769782, 4151763283, 2942311245, 1681285352,
+            3559051875, 527739334,  1197626328, 2352228477, 4149192676,
+            1008327745, 1678714463, 2941869562, 2465741165, 1504592584,
+            28883158,   3404645235, 2979351786, 2059614031, 584437073,
+            3917723380,
+        },
+        {
+            0,          2540828609, 722442611,  3162402482, 1444885222,
+            3245262119, 2098244501, 3932249172, 2889770444, 995070477,
+            2268200127, 272632702,  4196489002, 1834000619, 3509505625,
+            1180645784, 1569766761, 3403762344, 1990140954, 3790525403,
+            193957775,  2633922638, 545265404,  3086082365, 4054767781,
+            1725902692, 3668001238, 1305523735, 2813454915, 817896834,
+            2361291568, 466584817,  3139533522, 743476499,  2418992033,
+            123671648,  3980281908, 2052046837, 3325153607, 1363158662,
+            387915550,  2154752223, 1007715949, 2875290028, 1090530808,
+            3597785657, 1779414155, 4252910410, 3870410683, 1908420730,
+            3451805384, 1523558665, 2964256093, 668926620,  2611047470,
+            214997999,  1250927223, 3724432822, 1635793668, 4143041733,
+            479236241,  2346805072, 933169634,  2700017187, 1940816725,
+            3839849620, 1486952998, 3486576103, 632402355,  2998945394,
+            247343296,  2580537089, 3750815385, 1222709592, 4104093674,
+            1676576811, 2307904639, 519971774,  2726317324, 905034445,
+            775831100,  3109014013, 87140175,   2453688462, 2015431898,
+            4015061787, 1395561897, 3294585448, 2181061616, 359771185,
+            2836382339, 1048458562, 3558828310, 1131323095, 4279300197,
+            1751189412, 3364878727, 1610485318, 3816841460, 1961989941,
+            2660289377, 165756064,  3047117330, 586065363,  1689361483,
+            4089473930, 1337853240, 3637506809, 850308781,  2782878060,
+            429995998,  2396045343, 2501854446, 40809263,   3188776349,
+            694233692,  3271587336, 1416724937, 3893358459, 2138970298,
+            958472482,  2924533475, 305051729,  2237616016, 1866339268,
+            4165985285, 1144097463, 3544218998, 3881633450, 1881993579,
+            3427966937, 1529047064, 2973905996, 640926605,  2588781887,
+            222059262,  1264804710, 3692205223, 1617754645, 4145876436,
+            494686592,  2316150337, 913557747,  2701279026, 3134045123,
+            767314946,  2445419184, 112448881,  3973220645, 2074312420,
+            3353153622, 1353508759, 385080847,  2172791246, 1039943548,
+            2861412541, 1089268969, 3617397544, 1810068890, 4237460059,
+            1551662200, 3406662585, 2004083979, 3758232266, 174280350,
+            2635250015, 560781293,  3055362092, 4030863796, 1731456629,
+            3679289543, 1279031046, 2791123794, 825023635,  2371007009,
+            438519264,  32293137,   2526885584, 719542370,  3180507043,
+            1475605495, 3229746230, 2096917124, 3951926597, 2916263133,
+            983782172,  2262646190, 296536687,  4224554555, 1824285178,
+            3502378824, 1202976905, 2498987519, 58880574,   3220970636,
+            680389453,  3270293273, 1436369112, 3923979882, 2123553195,
+            953016371,  2948339698, 331512128,  2226359937, 1859310293,
+            4188218644, 1172130726, 3534535783, 3378722966, 1578291031,
+            3798770149, 1964856868, 2675706480, 135134641,  3027473155,
+            587359426,  1700617562, 4063013531, 1314047017, 3642962920,
+            859991996,  2754844797, 407762639,  2403074318, 802357037,
+            3097692396, 81618526,   2477560223, 2043530699, 4005313034,
+            1388467384, 3316884345, 2213321441, 345861408,  2833449874,
+            1066595411, 3589515271, 1115840454, 4277940596, 1770899125,
+            1916944964, 3845371269, 1498274615, 3460050166, 610103458,
+            3006039907, 257092049,  2552438288, 3732678536, 1225642057,
+            4118003451, 1644316986, 2288194926, 521331375,  2741799965,
+            874347484,
+        },
+        {
+            0,          829543472,  1659086944, 1402109008, 3318173888,
+            4105602288, 2804218016, 2522164368, 2388842353, 3205694273,
+            3967909649, 3723537185, 1269139377, 2060735361, 692465617,
+            406322145,  422172691,  676858915,  2076864627, 1253811267,
+            3706620115, 3986644195, 3188531379, 2407330947, 2538278754,
+            2788875090, 4121470722, 3302585138, 1384931234, 1677560722,
+            812644290,  18752498,   844345382,  52585494,   1353717830,
+            1640090742, 4153729254, 3336910038, 2507622534, 2751896758,
+            3157354327, 2369827687, 3738357559, 4020443911, 2046179223,
+            1216865191, 454402039,  711216071,  729442357,  436976645,
+            1234813013, 2028475493, 4005378293, 3754749125, 2355007637,
+            3173991589, 2769862468, 2489936756, 3355121444, 4136289044,
+            1625288580, 1370373044, 37504996,   860722132,  1688690764,
+            1440134268, 105170988,  926227484,  2707435660, 2417091772,
+            3280181484, 4075965660, 3938826045, 3686032141, 2284199773,
+            3109538669, 788719613,  510866381,  1306611613, 2089851821,
+            2106505311, 1291807855, 527241279,  773637135,  3091851423,
+            2302164143, 3668590847, 3957036239, 4092358446, 3265116958,
+            2433730382, 2692617086, 908804078,  123399134,  1422432142,
+            1706640318, 1458884714, 1736770650, 873953290,  90614842,
+            2469626026, 2722256026, 4056950986, 3231841530, 3633710875,
+            3924284203, 3128274811, 2332326731, 491870171,  740328427,
+            2142437307, 1321413515, 1339885689, 2125257801, 759078937,
+            474969129,  2316982457, 3144387721, 3908694233, 3649578217,
+            3250577160, 4040035128, 2740746088, 2452464472, 75009992,
+            889805816,  1721444264, 1475015576, 3377381528, 4164883624,
+            2880268536, 2598157512, 210341976,  1039680616, 1852454968,
+            1595665416, 1194072041, 1985856473, 634371977,  348023737,
+            2196457257, 3013251865, 3758681929, 3514383225, 3496417419,
+            3776367803, 2995040491, 2213897435, 362825803,  617716859,
+            2000937003, 1177695259, 1577439226, 1869880266, 1021732762,
+            228045738,  2613223226, 2863876874, 4179703642, 3360744298,
+            4213010622, 3396117646, 2583615710, 2827947246, 1054482558,
+            262927438,  1547274270, 1833458734, 1971300303, 1141797887,
+            396103599,  653122463,  2964911887, 2177442623, 3529203567,
+            3811216223, 3795101869, 3544546461, 2161574093, 2980500733,
+            670300269,  377629789,  1158696973, 1952547901, 1817608156,
+            1562881004, 246798268,  1069810572, 2844864284, 2564881196,
+            3413280636, 4194521932, 2917769428, 2627237092, 3473541300,
+            4269530244, 1747906580, 1499407396, 181229684,  1002212420,
+            596342693,  318415765,  1097392069, 1880689653, 3863750501,
+            3611161429, 2226097925, 3051248437, 3032512711, 2243013879,
+            3592671399, 3880912023, 1896294407, 1081539639, 333742183,
+            580211799,  983740342,  198409094,  1480656854, 1764807654,
+            4284874614, 3457428294, 2642827030, 2901902118, 2679771378,
+            2932589762, 4250515602, 3425201314, 1518157874, 1795986434,
+            949938258,  166673506,  299419523,  547951539,  1933275107,
+            1112194003, 3558840131, 3849208691, 3069984547, 2274224915,
+            2257832161, 3085049041, 3832569985, 3573658801, 1129617441,
+            1915046929, 565653569,  281470065,  150019984,  964742048,
+            1779611632, 1533240256, 3442888528, 4232551264, 2950031152,
+            2661561088,
+        },
+        {
+            0,          819083365,  1638166730, 1366706351, 3276333460,
+            4087011825, 2733412702, 2453580091, 2206053849, 3014626748,
+            3805922579, 3524001142, 1077236813, 1894214696, 563160199,
+            289610978,  51846467,   868558118,  1655926153, 1382110700,
+            3227516119, 4035822770, 2717617181, 2435429496, 2154473626,
+            2964885759, 3788429392, 3508330549, 1126320398, 1945137515,
+            579221956,  307495329,  103692934,  922485475,  1737116236,
+            1465414185, 3311852306, 4122272631, 2764221400, 2484114365,
+            2236845919, 3045177146, 3841458069, 3559245808, 1176202955,
+            1992906414, 666836481,  393029220,  87631813,   904601504,
+            1688033039, 1414492010, 3329345105, 4137942580, 2815800987,
+            2533854974, 2252640796, 3063327353, 3890275030, 3610434227,
+            1158443912, 1977502701, 614990658,  343554855,  207385868,
+            1015958889, 1844970950, 1563049379, 3474232472, 4291210493,
+            2930828370, 2657279031, 2401353941, 3220437168, 4001738783,
+            3730278522, 1281958209, 2092636452, 768430475,  488597998,
+            256600143,  1067012138, 1861163141, 1581064416, 3422783963,
+            4241600958, 2913466641, 2641740148, 2352405910, 3169117683,
+            3985812828, 3711997241, 1333672962, 2141979751, 786058440,
+            503870637,  175263626,  983594991,  1809203008, 1526990629,
+            3376066078, 4192769659, 2828984020, 2555176625, 2299525715,
+            3118318134, 3903556249, 3631854332, 1246174151, 2056594338,
+            736324365,  456217448,  157635273,  968321708,  1757487619,
+            1477646950, 3391992669, 4211051320, 2877932439, 2606496754,
+            2316887824, 3133857653, 3955005402, 3681464255, 1229981316,
+            2038578913, 687109710,  405163563,  414771736,  678089341,
+            2031917778, 1238278839, 3689941900, 3944887273, 3126098758,
+            2324054819, 2613403585, 2870437796, 4200673035, 3400734574,
+            1485684309, 1751090736, 959041183,  167507706,  464516955,
+            729665342,  2047575953, 1255784436, 3639023311, 3895799466,
+            3108201989, 2308005472, 2563916418, 2818603751, 4185272904,
+            3382970925, 1536860950, 1799920499, 977195996,  183299001,
+            513200286,  776268027,  2134024276, 1340119089, 3722326282,
+            3976989039, 3162128832, 2359851429, 2649449799, 2906217762,
+            4233041293, 3432852968, 1587774675, 1852947638, 1057485849,
+            265669756,  495046109,  760477112,  2082848023, 1291289970,
+            3737726025, 3994752044, 3211615363, 2411685094, 2667345924,
+            2922266721, 4283959502, 3481940139, 1572116880, 1835442677,
+            1007741274, 214094143,  350527252,  607561585,  1967189982,
+            1167251387, 3618406016, 3883812581, 3053981258, 2262447663,
+            2543397581, 2806715048, 4131215879, 3337577058, 1423035225,
+            1677980476, 896908179,  94864374,   401834583,  656521778,
+            1985475229, 1183173368, 3569050563, 3832109990, 3038712585,
+            2244815724, 2492348302, 2757496811, 4113188676, 3321397025,
+            1472648730, 1729425023, 912434896,  112238261,  315270546,
+            572038647,  1936643416, 1136454973, 3514975238, 3780148323,
+            2955293900, 2163477673, 2444693579, 2707761198, 4027801729,
+            3233896676, 1392505311, 1647167930, 861634837,  59357552,
+            299743441,  554664116,  1887029275, 1085010046, 3533003077,
+            3796328736, 3006343567, 2212696554, 2459962632, 2725393773,
+            4077157826, 3285599655, 1374219420, 1631245561, 810327126,
+            10396723,
+        },
+        {
+            0,          1409766726, 2819533452, 4228513738, 1441866729,
+            32929455,   4261382501, 2851658787, 2883733458, 4293202580,
+            65858910,   1475065880, 4262683707, 2853450109, 1444794039,
+            35298289,   1378416981, 103787539,  4196815833, 2921399967,
+            131717820,  1407094778, 2950131760, 4224722294, 4190813831,
+            2915953601, 1371804683, 96682317,   2889588078, 4164732968,
+            70596578,   1345479332, 2756833962, 4032210924, 207575078,
+            1482165600, 4053848387, 2779218949, 1504607183, 229191305,
+            263435640,  1538580542, 2814189556, 4089072306, 1514313361,
+            239453143,  4065082397, 2789960027, 4135128063, 2726190777,
+            1584898419, 175174709,  2743609366, 4153376080, 193364634,
+            1602344924, 1570458669, 161225067,  4120241825, 2710746087,
+            141193156,  1550662274, 2690958664, 4100165646, 1297060773,
+            424199907,  3846256937, 2974182511, 415150156,  1287251210,
+            2964331200, 3837218694, 3870151799, 2997518641, 1319337723,
+            446966717,  3009214366, 3881542360, 458382610,  1330972756,
+            526871280,  1264598966, 3077161084, 3815675194, 1251363097,
+            512826463,  3801670549, 3063920339, 3028626722, 3766646884,
+            478906286,  1217188584, 3782479563, 3044236173, 1232774215,
+            494792961,  3911082255, 3172545609, 1091619715, 353869509,
+            3169796838, 3907524512, 350349418,  1088863532, 1123821277,
+            385577883,  3941764177, 3203782935, 386729268,  1124749426,
+            3204689848, 3942972158, 3140917338, 4013018396, 322450134,
+            1195337616, 4006067123, 3133206261, 1187582271, 315507833,
+            282386312,  1154714318, 3101324548, 3973914690, 1160117345,
+            287484199,  3979040493, 3106669483, 2594121546, 3466097164,
+            848399814,  1721161856, 3480093859, 2607370725, 1734389295,
+            862452585,  830300312,  1702507998, 2574502420, 3446972242,
+            1686913905, 814421559,  3431131645, 2558901435, 3367493151,
+            2628815705, 1622766739, 884875733,  2638675446, 3376523440,
+            893933434,  1632567868, 1666554317, 928173195,  3411751745,
+            2673632775, 916765220,  1654910818, 2661945512, 3400353262,
+            1053742560, 1791590566, 2529197932, 3267832362, 1799353865,
+            1060676431, 3274792069, 2536901059, 2502726194, 3240871796,
+            1025652926, 1764060664, 3235754459, 2497373341, 1758665559,
+            1020546577, 1827024053, 954300915,  3303573049, 2431636351,
+            957812572,  1829788186, 2434377168, 3307139222, 3338955623,
+            2466463265, 1862975979, 990745773,  2465548430, 3337756104,
+            989585922,  1862055748, 3620779247, 2211963305, 2145263203,
+            735660837,  2183239430, 3592864320, 707739018,  2116577484,
+            2083713853, 674604667,  3560724913, 2151353591, 700698836,
+            2110031250, 2177727064, 3586797342, 2247642554, 3523156220,
+            771155766,  2045882992, 3490278995, 2215525141, 2013775071,
+            738234777,  773458536,  2048745262, 2249498852, 3524523426,
+            2079009153, 804027591,  3555033869, 2279790155, 1937851973,
+            663098115,  3683642569, 2408102287, 644900268,  1920413930,
+            2390675232, 3665402470, 3630367127, 2355385553, 1886235419,
+            610991709,  2375164542, 3650451256, 631015666,  1906040244,
+            564772624,  1974397526, 2309428636, 3718267098, 1951964409,
+            543148479,  3696637557, 2287035187, 2320234690, 3729567108,
+            574968398,  1984038664, 3753564971, 2344455789, 2008314279,
+            598942945,
+        },
+        {
+            0,          1737424129, 3474848258, 2828207875, 2614592245,
+            4233723892, 1422555383, 860128758,  843281179,  1439534618,
+            4250831129, 2597352472, 2845110766, 3457813743, 1720257516,
+            17299181,   1686562358, 50862903,   2879069236, 3423985973,
+            4283524291, 2564790722, 810327745,  1472357312, 1455789357,
+            827025452,  2581098287, 4267086382, 3440515032, 2862410457,
+            34598362,   1702957275, 3373124716, 2927833453, 101725806,
+            1637796719, 1390038681, 894743448,  2647110811, 4199106970,
+            4216242039, 2629845622, 877872501,  1407039604, 1620655490,
+            118997123,  2944714624, 3356113537, 2911578714, 3389380443,
+            1654050904, 85470553,   912042159,  1372738990, 4181807789,
+            2664411052, 2680707393, 4165379136, 1356178243, 928734786,
+            69196724,   1670457013, 3405914550, 2894912695, 2549607977,
+            4034466600, 1491735595, 1063577898, 203451612,  1806602717,
+            3275593438, 2763221983, 2780077362, 3258605619, 1789486896,
+            220699185,  1046683591, 1508762310, 4051625413, 2532317380,
+            4084271135, 2499802398, 1013772829, 1541541660, 1755745002,
+            254310379,  2814079208, 3224735209, 3241310980, 2797372933,
+            237994246,  1772190727, 1525021169, 1030423792, 2516059123,
+            4067884786, 1593451077, 963960644,  2447890503, 4134085958,
+            3308101808, 2728615345, 170941106,  1841211315, 1824084318,
+            188197983,  2745477980, 3291108957, 4151235499, 2430611114,
+            947071401,  1610470568, 981255283,  1576155506, 4116790897,
+            2465186672, 2712356486, 3324361607, 1857469572, 154681733,
+            138393448,  1873889897, 3340914026, 2695671915, 2481468829,
+            4100376732, 1559613343, 997929630,  704883363,  1301108642,
+            3843969185, 2190519712, 2983471190, 3596277079, 2127155796,
+            424095573,  406903224,  2144216249, 3613205434, 2966675131,
+            2207734605, 3826886220, 1284153679, 721706062,  1317358741,
+            688632212,  2174269079, 3860220822, 3578973792, 3000775521,
+            441398370,  2109852003, 2093367182, 457753231,  3017524620,
+            3562354829, 3876699515, 2157920378, 671893369,  1333967480,
+            3809371855, 2223021006, 739482829,  1268605388, 2027545658,
+            525801787,  3083083320, 3494568761, 3511490004, 3066292437,
+            508620758,  2044596951, 1251645217, 756312608,  2240245027,
+            3792277538, 2273870073, 3758521848, 1217755899, 790333434,
+            475988492,  2077359885, 3544381454, 3033269519, 3050042338,
+            3527741155, 2060847584, 492369121,  773615895,  1234340886,
+            3774974741, 2257548820, 3186902154, 3665475979, 1927921288,
+            359089033,  639878783,  1101871998, 3913170045, 2393948540,
+            2411149201, 3896101520, 1084935571, 656683154,  341882212,
+            1944995941, 3682422630, 3170087527, 3648168636, 3204210621,
+            376395966,  1910613439, 1118117961, 623631688,  2377701963,
+            3929417546, 3945910695, 2361339046, 606874533,  1134745252,
+            1894142802, 392736339,  3220941136, 3631567953, 1962510566,
+            326596071,  3152311012, 3697971173, 4012771859, 2292250386,
+            540274705,  1203571984, 1186659325, 557057788,  2309423615,
+            3995729150, 3714939144, 3135472649, 309363466,  1979612683,
+            276786896,  2012320721, 3747779794, 3102501331, 2343103525,
+            3961917732, 1152718375, 591129382,  574365131,  1169350858,
+            3978422217, 2326731464, 3119226686, 3731186239, 1995859260,
+            293115965,
+        },
+        {
+            0,          4060876286, 3790892301, 335044851,  3322195179,
+            872980757,  670089702,  3590114328, 2313498407, 2078876377,
+            1745961514, 2585612244, 1340179404, 3186462258, 2920672961,
+            1545200447, 371599551,  3827967297, 4157752754, 98453580,
+            3491923028, 573475242,  836168025,  3285902503, 2680358808,
+            1842285158, 2117560981, 2352703339, 1506257779, 2882250381,
+            3090400894, 1245694848, 743199102,  3728759936, 3451403379,
+            1068773773, 3930652053, 407171179,  196907160,  4189101414,
+            2779348569, 1470460839, 1146950484, 3058769578, 1672336050,
+            2443304780, 2186919871, 1884664385, 980056513,  3362157631,
+            3684570316, 697440562,  4235121962, 241359060,  496678951,
+            4019631577, 3012515558, 1099127576, 1383807979, 2692167189,
+            1972107789, 2273834995, 2491389696, 1718852350, 1486398204,
+            2861870850, 3110916081, 1264632335, 2661027351, 1821377513,
+            2137547546, 2372169444, 3514666459, 594640933,  814342358,
+            3263556904, 393814320,  3849661646, 4136455229, 75579843,
+            1321110083, 3165816765, 2940921678, 1564928688, 2293900968,
+            2058758998, 1766738853, 2604811867, 3344672100, 894937242,
+            649054313,  3567502743, 23005583,   4082304113, 3769328770,
+            312961404,  1960113026, 2262367868, 2501942927, 1730974577,
+            3000000361, 1088180887, 1394881124, 2703769498, 4247903397,
+            255709531,  482718120,  4006198358, 993357902,  3375988144,
+            3670089027, 684527805,  1660083005, 2432620227, 2198255152,
+            1896528846, 2767615958, 1459255848, 1157765851, 3071153957,
+            3944215578, 421263844,  182688023,  4176450793, 756242673,
+            3743372559, 3437704700, 1055602690, 2972796408, 1128089606,
+            1355098357, 2731091211, 2000021779, 2235163885, 2529264670,
+            1691191776, 953445087,  3403179809, 3642755026, 724306476,
+            4275095092, 215796682,  522496825,  3978864327, 2803330375,
+            1427857593, 1189281866, 3035565492, 1628684716, 2468334674,
+            2162666657, 1928044895, 787628640,  3707654046, 3473289069,
+            1024074387, 3908497035, 452649845,  151159686,  4212035192,
+            2642220166, 1869683064, 2089384331, 2391110773, 1534703725,
+            2843063699, 3129857376, 1216469150, 345521057,  3868472927,
+            4117517996, 123755346,  3533477706, 546347700,  862517831,
+            3244619705, 2338012217, 2035757511, 1789874484, 2560842954,
+            1298108626, 3209927980, 2896952799, 1588064289, 46011166,
+            4038205152, 3813309971, 289829869,  3300573173, 917942795,
+            625922808,  3611483910, 3920226052, 463858426,  140347913,
+            4199647223, 799886319,  3718333969, 3461949154, 1012214556,
+            1615644707, 2453718493, 2176361774, 1941219536, 2789762248,
+            1413769526, 1203505605, 3048211515, 4287614907, 226738757,
+            511419062,  3967266632, 965436240,  3414650542, 3632205405,
+            712180643,  1986715804, 2221337954, 2543750545, 1704099951,
+            2960018551, 1113735561, 1369055610, 2744528004, 3320166010,
+            938064772,  605150071,  3592279689, 65084049,   4058847087,
+            3793057692, 270105186,  1275107677, 3188495523, 2918511696,
+            1610152366, 2315531702, 2013804616, 1810913467, 2583450949,
+            3552812741, 567251771,  842527688,  3225157174, 365376046,
+            3888857040, 4097007395, 104813277,  1512485346, 2821372956,
+            3151158511, 1239339281, 2619481353, 1848512759, 2111205380,
+            2413460986,
+        },
+};
+
 static const uint32_t                 //
     wuffs_crc32__ieee_table[16][256]  //
     WUFFS_BASE__POTENTIALLY_UNUSED = {
@@ -12132,12 +15283,34 @@ static const uint32_t                 //
         },
 };
 
+static const uint32_t                //
+    wuffs_crc32__ieee_x2n_table[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741824, 536870912,  134217728,  8388608,    32768,      3988292384,
+        2984685714, 2691310871, 3982654894, 2295415911, 3619421802, 3963911953,
+        2390663536, 1680310286, 1296546528, 167662735,  2206543119, 808857370,
+        2069535939, 838779241,  2683044394, 1821240772, 366380877,  1608415822,
+        3134787127, 776888047,  1319870996, 2829349568, 1117427358, 344797226,
+        3289097936, 3303156796,
+};
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
 
+static uint32_t  //
+wuffs_crc32__ieee_hasher__multiply_mod_p(const wuffs_crc32__ieee_hasher* self,
+                                         uint32_t a_a,
+                                         uint32_t a_b);
+
 // ---------------- VTables
 
+const wuffs_base__hasher_u32__func_ptrs
+    wuffs_crc32__castagnoli_hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
+        (uint32_t(*)(void*, wuffs_base__slice_u8))(
+            &wuffs_crc32__castagnoli_hasher__update_u32),
+};
+
 const wuffs_base__hasher_u32__func_ptrs
     wuffs_crc32__ieee_hasher__func_ptrs_for__wuffs_base__hasher_u32 = {
         (uint32_t(*)(void*, wuffs_base__slice_u8))(
@@ -12146,6 +15319,59 @@ const wuffs_base__hasher_u32__func_ptrs
 
 // ---------------- Initializer Implementations
 
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_crc32__castagnoli_hasher__initialize(wuffs_crc32__castagnoli_hasher* self,
+                                           size_t sizeof_star_self,
+                                           uint64_t wuffs_version,
+                                           uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.vtable_name =
+      wuffs_base__hasher_u32__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__hasher_u32.function_pointers =
+      (const void*)(&wuffs_crc32__castagnoli_hasher__func_ptrs_for__wuffs_base__hasher_u32);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_crc32__castagnoli_hasher() {
+  return sizeof(wuffs_crc32__castagnoli_hasher);
+}
+
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
 wuffs_crc32__ieee_hasher__initialize(wuffs_crc32__ieee_hasher* self,
                                      size_t sizeof_star_self,
@@ -12201,11 +15427,11 @@ sizeof__wuffs_crc32__ieee_hasher() {
 
 // ---------------- Function Implementations
 
-// -------- func crc32.ieee_hasher.update_u32
+// -------- func crc32.castagnoli_hasher.update_u32
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
-                                     wuffs_base__slice_u8 a_x) {
+wuffs_crc32__castagnoli_hasher__update_u32(wuffs_crc32__castagnoli_hasher* self,
+                                           wuffs_base__slice_u8 a_x) {
   if (!self) {
     return 0;
   }
@@ -12217,6 +15443,11 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
   wuffs_base__slice_u8 v_p = {0};
 
   v_s = (4294967295 ^ self->private_impl.f_state);
+  if (wuffs_base__utility__cpu_arch_have_x86_sse42()) {
+    v_s = wuffs_base__utility__crc32_castagnoli_update_x86_sse42(v_s, a_x);
+    self->private_impl.f_state = (4294967295 ^ v_s);
+    return self->private_impl.f_state;
+  }
   {
     wuffs_base__slice_u8 i_slice_p = a_x;
     v_p = i_slice_p;
@@ -12226,15 +15457,122 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
       v_s ^=
           ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
            (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
-      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
-             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
-             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
-             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
-             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
-             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
-             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
-             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
-             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+    }
+    v_p.len = 16;
+    uint8_t* i_end1_p = i_slice_p.ptr + (i_slice_p.len / 16) * 16;
+    while (v_p.ptr < i_end1_p) {
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__castagnoli_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__castagnoli_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__castagnoli_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__castagnoli_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__castagnoli_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__castagnoli_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__castagnoli_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__castagnoli_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__castagnoli_table[8][v_p.ptr[7]] ^
+             wuffs_crc32__castagnoli_table[9][v_p.ptr[6]] ^
+             wuffs_crc32__castagnoli_table[10][v_p.ptr[5]] ^
+             wuffs_crc32__castagnoli_table[11][v_p.ptr[4]] ^
+             wuffs_crc32__castagnoli_table[12][(255 & (v_s >> 24))] ^
+             wuffs_crc32__castagnoli_table[13][(255 & (v_s >> 16))] ^
+             wuffs_crc32__castagnoli_table[14][(255 & (v_s >> 8))] ^
+             wuffs_crc32__castagnoli_table[15][(255 & (v_s >> 0))]);
+      v_p.ptr += 16;
+    }
+    v_p.len = 1;
+    uint8_t* i_end2_p = i_slice_p.ptr + (i_slice_p.len / 1) * 1;
+    while (v_p.ptr < i_end2_p) {
+      v_s = (wuffs_crc32__castagnoli_table[0][(((uint8_t)((v_s & 255))) ^
+                                               v_p.ptr[0])] ^
+             (v_s >> 8));
+      v_p.ptr += 1;
+    }
+  }
+  self->private_impl.f_state = (4294967295 ^ v_s);
+  return self->private_impl.f_state;
+}
+
+// -------- func crc32.ieee_hasher.update_u32
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
+                                     wuffs_base__slice_u8 a_x) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint32_t v_s = 0;
+  wuffs_base__slice_u8 v_p = {0};
+  wuffs_base__slice_u8 v_q = {0};
+
+  v_s = (4294967295 ^ self->private_impl.f_state);
+  v_q = a_x;
+  if ((((uint64_t)(v_q.len)) >= 64) &&
+      wuffs_base__utility__cpu_arch_have_x86_pclmul()) {
+    v_s = wuffs_base__utility__crc32_ieee_fold_x86_pclmul(v_s, v_q);
+    v_q = wuffs_base__slice_u8__suffix(v_q, (((uint64_t)(v_q.len)) & 15));
+  }
+  {
+    wuffs_base__slice_u8 i_slice_p = v_q;
+    v_p = i_slice_p;
+    v_p.len = 16;
+    uint8_t* i_end0_p = i_slice_p.ptr + (i_slice_p.len / 32) * 32;
+    while (v_p.ptr < i_end0_p) {
+      v_s ^=
+          ((((uint32_t)(v_p.ptr[0])) << 0) | (((uint32_t)(v_p.ptr[1])) << 8) |
+           (((uint32_t)(v_p.ptr[2])) << 16) | (((uint32_t)(v_p.ptr[3])) << 24));
+      v_s = (wuffs_crc32__ieee_table[0][v_p.ptr[15]] ^
+             wuffs_crc32__ieee_table[1][v_p.ptr[14]] ^
+             wuffs_crc32__ieee_table[2][v_p.ptr[13]] ^
+             wuffs_crc32__ieee_table[3][v_p.ptr[12]] ^
+             wuffs_crc32__ieee_table[4][v_p.ptr[11]] ^
+             wuffs_crc32__ieee_table[5][v_p.ptr[10]] ^
+             wuffs_crc32__ieee_table[6][v_p.ptr[9]] ^
+             wuffs_crc32__ieee_table[7][v_p.ptr[8]] ^
+             wuffs_crc32__ieee_table[8][v_p.ptr[7]] ^
              wuffs_crc32__ieee_table[9][v_p.ptr[6]] ^
              wuffs_crc32__ieee_table[10][v_p.ptr[5]] ^
              wuffs_crc32__ieee_table[11][v_p.ptr[4]] ^
@@ -12301,6 +15639,66 @@ wuffs_crc32__ieee_hasher__update_u32(wuffs_crc32__ieee_hasher* self,
   return self->private_impl.f_state;
 }
 
+// -------- func crc32.ieee_hasher.combine
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_crc32__ieee_hasher__combine(const wuffs_crc32__ieee_hasher* self,
+                                  uint32_t a_crc_a,
+                                  uint32_t a_crc_b,
+                                  uint64_t a_len_b) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  uint32_t v_p = 0;
+  uint64_t v_n = 0;
+  uint32_t v_k = 0;
+
+  v_p = 2147483648;
+  v_n = a_len_b;
+  v_k = 3;
+  while (v_n > 0) {
+    if ((v_n & 1) != 0) {
+      v_p = wuffs_crc32__ieee_hasher__multiply_mod_p(
+          self, v_p, wuffs_crc32__ieee_x2n_table[v_k]);
+    }
+    v_n >>= 1;
+    v_k = ((v_k + 1) & 31);
+  }
+  return (wuffs_crc32__ieee_hasher__multiply_mod_p(self, v_p, a_crc_a) ^
+          a_crc_b);
+}
+
+// -------- func crc32.ieee_hasher.multiply_mod_p
+
+static uint32_t  //
+wuffs_crc32__ieee_hasher__multiply_mod_p(const wuffs_crc32__ieee_hasher* self,
+                                         uint32_t a_a,
+                                         uint32_t a_b) {
+  uint32_t v_ret = 0;
+  uint32_t v_b = 0;
+  uint32_t v_m = 0;
+
+  v_b = a_b;
+  v_m = 2147483648;
+  while (v_m > 0) {
+    if ((a_a & v_m) != 0) {
+      v_ret ^= v_b;
+    }
+    if ((v_b & 1) != 0) {
+      v_b = ((v_b >> 1) ^ 3988292384);
+    } else {
+      v_b = (v_b >> 1);
+    }
+    v_m >>= 1;
+  }
+  return v_ret;
+}
+
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
         // defined(WUFFS_CONFIG__MODULE__CRC32)
 
@@ -12330,8 +15728,11 @@ const char* wuffs_deflate__error__inconsistent_stored_block_length =
     "#deflate: inconsistent stored block length";
 const char* wuffs_deflate__error__missing_end_of_block_code =
     "#deflate: missing end-of-block code";
+const char* wuffs_deflate__error__missing_history = "#deflate: missing history";
 const char* wuffs_deflate__error__no_huffman_codes =
     "#deflate: no Huffman codes";
+const char* wuffs_deflate__suspension__block_boundary =
+    "$deflate: block boundary";
 const char*
     wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state =
         "#deflate: internal error: inconsistent Huffman decoder state";
@@ -12341,6 +15742,11 @@ const char* wuffs_deflate__error__internal_error_inconsistent_distance =
     "#deflate: internal error: inconsistent distance";
 const char* wuffs_deflate__error__internal_error_inconsistent_n_bits =
     "#deflate: internal error: inconsistent n_bits";
+const char*
+    wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state =
+        "#deflate: internal error: inconsistent Huffman encoder state";
+const char* wuffs_deflate__error__internal_error_inconsistent_encoder_state =
+    "#deflate: internal error: inconsistent encoder state";
 
 // ---------------- Private Consts
 
@@ -12396,10 +15802,192 @@ static const uint32_t                       //
         134217728,  134217728,
 };
 
+static const uint32_t                      //
+    wuffs_deflate__fixed_huffs_lcode[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        536870919,  2147504136, 2147487752, 1073770568, 1073749031, 2147512328,
+        2147495944, 2147532809, 1073743623, 2147508232, 2147491848, 2147524617,
+        2147483656, 2147516424, 2147500040, 2147541001, 1073742599, 2147506184,
+        2147489800, 2147520521, 1073756215, 2147514376, 2147497992, 2147536905,
+        1073745431, 2147510280, 2147493896, 2147528713, 2147485704, 2147518472,
+        2147502088, 2147545097, 1073742087, 2147505160, 2147488776, 1073799256,
+        1073752119, 2147513352, 2147496968, 2147534857, 1073744407, 2147509256,
+        2147492872, 2147526665, 2147484680, 2147517448, 2147501064, 2147543049,
+        1073743111, 2147507208, 2147490824, 2147522569, 1073762375, 2147515400,
+        2147499016, 2147538953, 1073746983, 2147511304, 2147494920, 2147530761,
+        2147486728, 2147519496, 2147503112, 2147547145, 1073741831, 2147504648,
+        2147488264, 1073782872, 1073750071, 2147512840, 2147496456, 2147533833,
+        1073743895, 2147508744, 2147492360, 2147525641, 2147484168, 2147516936,
+        2147500552, 2147542025, 1073742855, 2147506696, 2147490312, 2147521545,
+        1073758279, 2147514888, 2147498504, 2147537929, 1073745959, 2147510792,
+        2147494408, 2147529737, 2147486216, 2147518984, 2147502600, 2147546121,
+        1073742343, 2147505672, 2147489288, 134217736,  1073754167, 2147513864,
+        2147497480, 2147535881, 1073744919, 2147509768, 2147493384, 2147527689,
+        2147485192, 2147517960, 2147501576, 2147544073, 1073743367, 2147507720,
+        2147491336, 2147523593, 1073766471, 2147515912, 2147499528, 2147539977,
+        1073748007, 2147511816, 2147495432, 2147531785, 2147487240, 2147520008,
+        2147503624, 2147548169, 536870919,  2147504392, 2147488008, 1073774680,
+        1073749031, 2147512584, 2147496200, 2147533321, 1073743623, 2147508488,
+        2147492104, 2147525129, 2147483912, 2147516680, 2147500296, 2147541513,
+        1073742599, 2147506440, 2147490056, 2147521033, 1073756215, 2147514632,
+        2147498248, 2147537417, 1073745431, 2147510536, 2147494152, 2147529225,
+        2147485960, 2147518728, 2147502344, 2147545609, 1073742087, 2147505416,
+        2147489032, 1073807112, 1073752119, 2147513608, 2147497224, 2147535369,
+        1073744407, 2147509512, 2147493128, 2147527177, 2147484936, 2147517704,
+        2147501320, 2147543561, 1073743111, 2147507464, 2147491080, 2147523081,
+        1073762375, 2147515656, 2147499272, 2147539465, 1073746983, 2147511560,
+        2147495176, 2147531273, 2147486984, 2147519752, 2147503368, 2147547657,
+        1073741831, 2147504904, 2147488520, 1073791064, 1073750071, 2147513096,
+        2147496712, 2147534345, 1073743895, 2147509000, 2147492616, 2147526153,
+        2147484424, 2147517192, 2147500808, 2147542537, 1073742855, 2147506952,
+        2147490568, 2147522057, 1073758279, 2147515144, 2147498760, 2147538441,
+        1073745959, 2147511048, 2147494664, 2147530249, 2147486472, 2147519240,
+        2147502856, 2147546633, 1073742343, 2147505928, 2147489544, 134217736,
+        1073754167, 2147514120, 2147497736, 2147536393, 1073744919, 2147510024,
+        2147493640, 2147528201, 2147485448, 2147518216, 2147501832, 2147544585,
+        1073743367, 2147507976, 2147491592, 2147524105, 1073766471, 2147516168,
+        2147499784, 2147540489, 1073748007, 2147512072, 2147495688, 2147532297,
+        2147487496, 2147520264, 2147503880, 2147548681, 536870919,  2147504136,
+        2147487752, 1073770568, 1073749031, 2147512328, 2147495944, 2147533065,
+        1073743623, 2147508232, 2147491848, 2147524873, 2147483656, 2147516424,
+        2147500040, 2147541257, 1073742599, 2147506184, 2147489800, 2147520777,
+        1073756215, 2147514376, 2147497992, 2147537161, 1073745431, 2147510280,
+        2147493896, 2147528969, 2147485704, 2147518472, 2147502088, 2147545353,
+        1073742087, 2147505160, 2147488776, 1073799256, 1073752119, 2147513352,
+        2147496968, 2147535113, 1073744407, 2147509256, 2147492872, 2147526921,
+        2147484680, 2147517448, 2147501064, 2147543305, 1073743111, 2147507208,
+        2147490824, 2147522825, 1073762375, 2147515400, 2147499016, 2147539209,
+        1073746983, 2147511304, 2147494920, 2147531017, 2147486728, 2147519496,
+        2147503112, 2147547401, 1073741831, 2147504648, 2147488264, 1073782872,
+        1073750071, 2147512840, 2147496456, 2147534089, 1073743895, 2147508744,
+        2147492360, 2147525897, 2147484168, 2147516936, 2147500552, 2147542281,
+        1073742855, 2147506696, 2147490312, 2147521801, 1073758279, 2147514888,
+        2147498504, 2147538185, 1073745959, 2147510792, 2147494408, 2147529993,
+        2147486216, 2147518984, 2147502600, 2147546377, 1073742343, 2147505672,
+        2147489288, 134217736,  1073754167, 2147513864, 2147497480, 2147536137,
+        1073744919, 2147509768, 2147493384, 2147527945, 2147485192, 2147517960,
+        2147501576, 2147544329, 1073743367, 2147507720, 2147491336, 2147523849,
+        1073766471, 2147515912, 2147499528, 2147540233, 1073748007, 2147511816,
+        2147495432, 2147532041, 2147487240, 2147520008, 2147503624, 2147548425,
+        536870919,  2147504392, 2147488008, 1073774680, 1073749031, 2147512584,
+        2147496200, 2147533577, 1073743623, 2147508488, 2147492104, 2147525385,
+        2147483912, 2147516680, 2147500296, 2147541769, 1073742599, 2147506440,
+        2147490056, 2147521289, 1073756215, 2147514632, 2147498248, 2147537673,
+        1073745431, 2147510536, 2147494152, 2147529481, 2147485960, 2147518728,
+        2147502344, 2147545865, 1073742087, 2147505416, 2147489032, 1073807112,
+        1073752119, 2147513608, 2147497224, 2147535625, 1073744407, 2147509512,
+        2147493128, 2147527433, 2147484936, 2147517704, 2147501320, 2147543817,
+        1073743111, 2147507464, 2147491080, 2147523337, 1073762375, 2147515656,
+        2147499272, 2147539721, 1073746983, 2147511560, 2147495176, 2147531529,
+        2147486984, 2147519752, 2147503368, 2147547913, 1073741831, 2147504904,
+        2147488520, 1073791064, 1073750071, 2147513096, 2147496712, 2147534601,
+        1073743895, 2147509000, 2147492616, 2147526409, 2147484424, 2147517192,
+        2147500808, 2147542793, 1073742855, 2147506952, 2147490568, 2147522313,
+        1073758279, 2147515144, 2147498760, 2147538697, 1073745959, 2147511048,
+        2147494664, 2147530505, 2147486472, 2147519240, 2147502856, 2147546889,
+        1073742343, 2147505928, 2147489544, 134217736,  1073754167, 2147514120,
+        2147497736, 2147536649, 1073744919, 2147510024, 2147493640, 2147528457,
+        2147485448, 2147518216, 2147501832, 2147544841, 1073743367, 2147507976,
+        2147491592, 2147524361, 1073766471, 2147516168, 2147499784, 2147540745,
+        1073748007, 2147512072, 2147495688, 2147532553, 2147487496, 2147520264,
+        2147503880, 2147548937,
+};
+
+static const uint32_t                     //
+    wuffs_deflate__fixed_huffs_dcode[32]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        1073741829, 1073807477, 1073745973, 1074790581, 1073742869, 1074004117,
+        1073758293, 1077936341, 1073742341, 1073873029, 1073750085, 1075839173,
+        1073743909, 1074266277, 1073774693, 134217733,  1073742085, 1073840245,
+        1073748021, 1075314869, 1073743381, 1074135189, 1073766485, 1080033493,
+        1073742597, 1073938565, 1073754181, 1076887749, 1073744933, 1074528421,
+        1073791077, 134217733,
+};
+
 #define WUFFS_DEFLATE__HUFFS_TABLE_SIZE 1024
 
 #define WUFFS_DEFLATE__HUFFS_TABLE_MASK 1023
 
+static const uint8_t                  //
+    wuffs_deflate__length_codes[256]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  5,  6,  7,  8,  8,  9,  9,  10, 10, 11, 11, 12, 12,
+        12, 12, 13, 13, 13, 13, 14, 14, 14, 14, 15, 15, 15, 15, 16, 16, 16, 16,
+        16, 16, 16, 16, 17, 17, 17, 17, 17, 17, 17, 17, 18, 18, 18, 18, 18, 18,
+        18, 18, 19, 19, 19, 19, 19, 19, 19, 19, 20, 20, 20, 20, 20, 20, 20, 20,
+        20, 20, 20, 20, 20, 20, 20, 20, 21, 21, 21, 21, 21, 21, 21, 21, 21, 21,
+        21, 21, 21, 21, 21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22, 22,
+        22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23, 23,
+        23, 23, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 28,
+};
+
+static const uint8_t                    //
+    wuffs_deflate__distance_codes[512]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0,  1,  2,  3,  4,  4,  5,  5,  6,  6,  6,  6,  7,  7,  7,  7,  8,  8,
+        8,  8,  8,  8,  8,  8,  9,  9,  9,  9,  9,  9,  9,  9,  10, 10, 10, 10,
+        10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 11, 11, 11, 11, 11, 11,
+        11, 11, 11, 11, 11, 11, 11, 11, 11, 11, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12, 12,
+        12, 12, 12, 12, 12, 12, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13, 13,
+        13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14,
+        14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15, 15,
+        15, 15, 15, 15, 0,  0,  16, 17, 18, 18, 19, 19, 20, 20, 20, 20, 21, 21,
+        21, 21, 22, 22, 22, 22, 22, 22, 22, 22, 23, 23, 23, 23, 23, 23, 23, 23,
+        24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 24, 25, 25,
+        25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 25, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27, 27,
+        27, 27, 27, 27, 27, 27, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29, 29,
+        29, 29, 29, 29, 29, 29, 29, 29,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__level_good_lengths[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 4, 4, 4, 8, 8, 8, 32, 32,
+};
+
+static const uint32_t                    //
+    wuffs_deflate__level_max_lazies[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 5, 6, 4, 16, 16, 32, 128, 258,
+};
+
+static const uint32_t                      //
+    wuffs_deflate__level_nice_lengths[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 8, 16, 32, 16, 32, 128, 128, 258, 258,
+};
+
+static const uint32_t                    //
+    wuffs_deflate__level_max_chains[10]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        0, 4, 8, 32, 16, 32, 128, 256, 1024, 4096,
+};
+
+#define WUFFS_DEFLATE__MIN_LOOKAHEAD 262
+
 // ---------------- Private Initializer Prototypes
 
 // ---------------- Private Function Prototypes
@@ -12428,16 +16016,125 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
                                   uint32_t a_n_codes1,
                                   uint32_t a_base_symbol);
 
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_blocks(wuffs_deflate__stats_decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_uncompressed(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__init_fixed_huffman(
+    wuffs_deflate__stats_decoder* self);
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__init_dynamic_huffman(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__init_huff(wuffs_deflate__stats_decoder* self,
+                                        uint32_t a_which,
+                                        uint32_t a_n_codes0,
+                                        uint32_t a_n_codes1,
+                                        uint32_t a_base_symbol);
+
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
                                             wuffs_base__io_buffer* a_src);
 
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_huffman_fast(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
 static wuffs_base__status  //
 wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
                                             wuffs_base__io_buffer* a_dst,
                                             wuffs_base__io_buffer* a_src);
 
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_huffman_slow(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__reset_freqs(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide_window(wuffs_deflate__encoder* self);
+
+static uint32_t  //
+wuffs_deflate__encoder__insert_hash(wuffs_deflate__encoder* self, uint32_t a_p);
+
+static uint32_t  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_cur,
+                                      uint32_t a_cand,
+                                      uint32_t a_prev_length);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__deflate_fast(wuffs_deflate__encoder* self, bool a_eof);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__deflate_slow(wuffs_deflate__encoder* self, bool a_eof);
+
+static uint32_t  //
+wuffs_deflate__encoder__distance_code(const wuffs_deflate__encoder* self,
+                                      uint32_t a_d);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_b,
+                                   uint32_t a_n);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_stored(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     bool a_final);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_tokens(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_dynamic_header(wuffs_deflate__encoder* self,
+                                             wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_fixed_codes(wuffs_deflate__encoder* self);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__build_clsyms(wuffs_deflate__encoder* self);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__append_clsym(wuffs_deflate__encoder* self,
+                                     uint32_t a_s);
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_which,
+                                      uint32_t a_n_codes,
+                                      uint32_t a_max_len);
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_which,
+                                     uint32_t a_n_codes);
+
 // ---------------- VTables
 
 const wuffs_base__io_transformer__func_ptrs
@@ -12451,6 +16148,28 @@ const wuffs_base__io_transformer__func_ptrs
             &wuffs_deflate__decoder__workbuf_len),
 };
 
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__stats_decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__stats_decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__stats_decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_deflate__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_deflate__encoder__workbuf_len),
+};
+
 // ---------------- Initializer Implementations
 
 wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
@@ -12506,66 +16225,332 @@ sizeof__wuffs_deflate__decoder() {
   return sizeof(wuffs_deflate__decoder);
 }
 
-// ---------------- Function Implementations
-
-// -------- func deflate.decoder.add_history
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
-                                    wuffs_base__slice_u8 a_hist) {
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__stats_decoder__initialize(wuffs_deflate__stats_decoder* self,
+                                         size_t sizeof_star_self,
+                                         uint64_t wuffs_version,
+                                         uint32_t initialize_flags) {
   if (!self) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
   }
 
-  wuffs_base__slice_u8 v_s = {0};
-  uint64_t v_n_copied = 0;
-  uint32_t v_already_full = 0;
-
-  v_s = a_hist;
-  if (((uint64_t)(v_s.len)) >= 32768) {
-    v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
-    wuffs_base__slice_u8__copy_from_slice(
-        wuffs_base__slice_u8__subslice_j(
-            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-            32768),
-        v_s);
-    self->private_impl.f_history_index = 32768;
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
   } else {
-    v_n_copied = wuffs_base__slice_u8__copy_from_slice(
-        wuffs_base__slice_u8__subslice_ij(
-            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-            (self->private_impl.f_history_index & 32767), 32768),
-        v_s);
-    if (v_n_copied < ((uint64_t)(v_s.len))) {
-      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
-      v_n_copied = wuffs_base__slice_u8__copy_from_slice(
-          wuffs_base__slice_u8__subslice_j(
-              wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-              32768),
-          v_s);
-      self->private_impl.f_history_index =
-          (((uint32_t)((v_n_copied & 32767))) + 32768);
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
     } else {
-      v_already_full = 0;
-      if (self->private_impl.f_history_index >= 32768) {
-        v_already_full = 32768;
-      }
-      self->private_impl.f_history_index =
-          ((self->private_impl.f_history_index & 32767) +
-           ((uint32_t)((v_n_copied & 32767))) + v_already_full);
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
     }
   }
-  wuffs_base__slice_u8__copy_from_slice(
-      wuffs_base__slice_u8__subslice_i(
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__stats_decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_deflate__stats_decoder() {
+  return sizeof(wuffs_deflate__stats_decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_deflate__encoder__initialize(wuffs_deflate__encoder* self,
+                                   size_t sizeof_star_self,
+                                   uint64_t wuffs_version,
+                                   uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_deflate__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_deflate__encoder() {
+  return sizeof(wuffs_deflate__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func deflate.decoder.add_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__add_history(wuffs_deflate__decoder* self,
+                                    wuffs_base__slice_u8 a_hist) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n_copied = 0;
+  uint32_t v_already_full = 0;
+
+  v_s = a_hist;
+  if (((uint64_t)(v_s.len)) >= 32768) {
+    v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
+    wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_j(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            32768),
+        v_s);
+    self->private_impl.f_history_index = 32768;
+  } else {
+    v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_ij(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            (self->private_impl.f_history_index & 32767), 32768),
+        v_s);
+    if (v_n_copied < ((uint64_t)(v_s.len))) {
+      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
+      v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__slice_u8__subslice_j(
+              wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+              32768),
+          v_s);
+      self->private_impl.f_history_index =
+          (((uint32_t)((v_n_copied & 32767))) + 32768);
+    } else {
+      v_already_full = 0;
+      if (self->private_impl.f_history_index >= 32768) {
+        v_already_full = 32768;
+      }
+      self->private_impl.f_history_index =
+          ((self->private_impl.f_history_index & 32767) +
+           ((uint32_t)((v_n_copied & 32767))) + v_already_full);
+    }
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_i(
           wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
           32768),
       wuffs_base__make_slice_u8(self->private_data.f_history, 33025));
   return wuffs_base__make_empty_struct();
 }
 
+// -------- func deflate.decoder.set_dst_holds_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_history(wuffs_deflate__decoder* self,
+                                              bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_history = a_dhh;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_dst_holds_history_on_short_write
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+    wuffs_deflate__decoder* self,
+    bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_history_on_short_write = a_dhh;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_dst_holds_window
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_dst_holds_window(wuffs_deflate__decoder* self,
+                                             bool a_dhw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_window = a_dhw;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__set_report_block_boundaries(
+    wuffs_deflate__decoder* self,
+    bool a_rbb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_block_boundaries = a_rbb;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.decoder.held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__decoder__held_bits(const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_bits;
+}
+
+// -------- func deflate.decoder.n_held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__decoder__n_held_bits(const wuffs_deflate__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_n_bits;
+}
+
+// -------- func deflate.decoder.copy_history
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__decoder__copy_history(wuffs_deflate__decoder* self,
+                                     wuffs_base__slice_u8 a_dst) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_i = 0;
+  uint64_t v_n = 0;
+
+  v_i = (self->private_impl.f_history_index & 32767);
+  v_s = wuffs_base__slice_u8__subslice_j(
+      wuffs_base__make_slice_u8(self->private_data.f_history, 33025), v_i);
+  if (((uint64_t)(a_dst.len)) <= ((uint64_t)(v_s.len))) {
+    v_n = wuffs_base__slice_u8__copy_from_slice(
+        a_dst, wuffs_base__slice_u8__suffix(v_s, ((uint64_t)(a_dst.len))));
+    return v_n;
+  }
+  if (self->private_impl.f_history_index >= 32768) {
+    v_n = wuffs_base__slice_u8__copy_from_slice(
+        a_dst,
+        wuffs_base__slice_u8__suffix(
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+                v_i, 32768),
+            (((uint64_t)(a_dst.len)) - ((uint64_t)(v_s.len)))));
+  }
+  if (v_n < ((uint64_t)(a_dst.len))) {
+    wuffs_base__u64__sat_add_indirect(
+        &v_n, wuffs_base__slice_u8__copy_from_slice(
+                  wuffs_base__slice_u8__subslice_i(a_dst, v_n), v_s));
+  }
+  return v_n;
+}
+
+// -------- func deflate.decoder.resume_at_checkpoint
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__decoder__resume_at_checkpoint(wuffs_deflate__decoder* self,
+                                             uint32_t a_held_bits,
+                                             uint32_t a_n_held_bits,
+                                             wuffs_base__slice_u8 a_window) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_n_bits = (a_n_held_bits & 7);
+  self->private_impl.f_bits =
+      (a_held_bits & ((((uint32_t)(1)) << self->private_impl.f_n_bits) - 1));
+  self->private_impl.f_history_index = 0;
+  self->private_impl.f_n_history_pending = 0;
+  wuffs_deflate__decoder__add_history(self, a_window);
+  return wuffs_base__make_empty_struct();
+}
+
 // -------- func deflate.decoder.workbuf_len
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
@@ -12612,6 +16597,7 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
 
   uint64_t v_mark = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_hist = {0};
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -12657,11 +16643,44 @@ wuffs_deflate__decoder__transform_io(wuffs_deflate__decoder* self,
         }
         goto ok;
       }
-      wuffs_deflate__decoder__add_history(
-          self, wuffs_base__io__since(
-                    v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      if (self->private_impl.f_dst_holds_window ||
+          (self->private_impl.f_dst_holds_history &&
+           (v_status.repr ==
+            wuffs_base__make_status(wuffs_base__suspension__short_read)
+                .repr)) ||
+          (self->private_impl.f_dst_holds_history_on_short_write &&
+           (v_status.repr ==
+            wuffs_base__make_status(wuffs_base__suspension__short_write)
+                .repr))) {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_n_history_pending,
+            wuffs_base__io__count_since(v_mark,
+                                        ((uint64_t)(iop_a_dst - io0_a_dst))));
+      } else if (self->private_impl.f_n_history_pending > 0) {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_n_history_pending,
+            wuffs_base__io__count_since(v_mark,
+                                        ((uint64_t)(iop_a_dst - io0_a_dst))));
+        v_hist = wuffs_base__io__since(0, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                       io0_a_dst);
+        if (((uint64_t)(v_hist.len)) > self->private_impl.f_n_history_pending) {
+          v_hist = wuffs_base__slice_u8__suffix(
+              v_hist, self->private_impl.f_n_history_pending);
+        }
+        wuffs_deflate__decoder__add_history(self, v_hist);
+        self->private_impl.f_n_history_pending = 0;
+      } else {
+        wuffs_deflate__decoder__add_history(
+            self, wuffs_base__io__since(
+                      v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      }
       status = v_status;
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      if (((uint64_t)(iop_a_dst - io0_a_dst)) <
+          wuffs_base__u64__min(self->private_impl.f_n_history_pending, 32768)) {
+        status = wuffs_base__make_status(wuffs_deflate__error__missing_history);
+        goto exit;
+      }
     }
 
     goto ok;
@@ -12753,6 +16772,11 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
         if (status.repr) {
           goto suspend;
         }
+        if (self->private_impl.f_report_block_boundaries && (v_final == 0)) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__suspension__block_boundary);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+        }
         goto label__outer__continue;
       } else if (v_type == 1) {
         v_status = wuffs_deflate__decoder__init_fixed_huffman(self);
@@ -12771,7 +16795,7 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
         status = wuffs_deflate__decoder__init_dynamic_huffman(self, a_src);
         if (a_src) {
           iop_a_src = a_src->data.ptr + a_src->meta.ri;
@@ -12798,12 +16822,12 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
           goto exit;
         }
         if (self->private_impl.f_end_of_block) {
-          goto label__outer__continue;
+          goto label__0__break;
         }
         if (a_src) {
           a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
         status =
             wuffs_deflate__decoder__decode_huffman_slow(self, a_dst, a_src);
         if (a_src) {
@@ -12813,9 +16837,15 @@ wuffs_deflate__decoder__decode_blocks(wuffs_deflate__decoder* self,
           goto suspend;
         }
         if (self->private_impl.f_end_of_block) {
-          goto label__outer__continue;
+          goto label__0__break;
         }
       }
+    label__0__break:;
+      if (self->private_impl.f_report_block_boundaries && (v_final == 0)) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__suspension__block_boundary);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+      }
     }
 
     goto ok;
@@ -12973,36 +17003,18 @@ exit:
 static wuffs_base__status  //
 wuffs_deflate__decoder__init_fixed_huffman(wuffs_deflate__decoder* self) {
   uint32_t v_i = 0;
-  wuffs_base__status v_status = wuffs_base__make_status(NULL);
 
-  while (v_i < 144) {
-    self->private_data.f_code_lengths[v_i] = 8;
-    v_i += 1;
-  }
-  while (v_i < 256) {
-    self->private_data.f_code_lengths[v_i] = 9;
-    v_i += 1;
-  }
-  while (v_i < 280) {
-    self->private_data.f_code_lengths[v_i] = 7;
-    v_i += 1;
-  }
-  while (v_i < 288) {
-    self->private_data.f_code_lengths[v_i] = 8;
+  while (v_i < 512) {
+    self->private_data.f_huffs[0][v_i] = wuffs_deflate__fixed_huffs_lcode[v_i];
     v_i += 1;
   }
-  while (v_i < 320) {
-    self->private_data.f_code_lengths[v_i] = 5;
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_huffs[1][v_i] = wuffs_deflate__fixed_huffs_dcode[v_i];
     v_i += 1;
   }
-  v_status = wuffs_deflate__decoder__init_huff(self, 0, 0, 288, 257);
-  if (wuffs_base__status__is_error(&v_status)) {
-    return v_status;
-  }
-  v_status = wuffs_deflate__decoder__init_huff(self, 1, 288, 320, 0);
-  if (wuffs_base__status__is_error(&v_status)) {
-    return v_status;
-  }
+  self->private_impl.f_n_huffs_bits[0] = 9;
+  self->private_impl.f_n_huffs_bits[1] = 5;
   return wuffs_base__make_status(NULL);
 }
 
@@ -13277,6 +17289,8 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
                                   uint32_t a_n_codes1,
                                   uint32_t a_base_symbol) {
   uint16_t v_counts[16] = {0};
+  uint16_t v_odd_counts[16] = {0};
+  uint32_t v_sum = 0;
   uint32_t v_i = 0;
   uint32_t v_remaining = 0;
   uint16_t v_offsets[16] = {0};
@@ -13300,6 +17314,8 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
   uint32_t v_symbol = 0;
   uint32_t v_high_bits = 0;
   uint32_t v_delta = 0;
+  uint32_t v_n_keys = 0;
+  uint32_t v_second = 0;
 
   v_i = a_n_codes0;
   while (v_i < a_n_codes1) {
@@ -13316,10 +17332,37 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
 #pragma GCC diagnostic pop
 #endif
     v_i += 1;
+    if (v_i >= a_n_codes1) {
+      goto label__0__break;
+    }
+    if (v_odd_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_odd_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_i += 1;
+  }
+label__0__break:;
+  v_i = 0;
+  while (v_i < 16) {
+    v_sum = (((uint32_t)(v_counts[v_i])) + ((uint32_t)(v_odd_counts[v_i])));
+    if (v_sum > 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_counts[v_i] = ((uint16_t)(v_sum));
+    v_i += 1;
+  }
+  if ((((uint32_t)(v_counts[0])) + a_n_codes0) == a_n_codes1) {
+    return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
   }
-  if ((((uint32_t)(v_counts[0])) + a_n_codes0) == a_n_codes1) {
-    return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
-  }
   v_remaining = 1;
   v_i = 1;
   while (v_i <= 15) {
@@ -13391,7 +17434,7 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
   v_min_cl = 1;
   while (true) {
     if (v_counts[v_min_cl] != 0) {
-      goto label__0__break;
+      goto label__1__break;
     }
     if (v_min_cl >= 9) {
       return wuffs_base__make_status(
@@ -13399,18 +17442,18 @@ wuffs_deflate__decoder__init_huff(wuffs_deflate__decoder* self,
     }
     v_min_cl += 1;
   }
-label__0__break:;
+label__1__break:;
   v_max_cl = 15;
   while (true) {
     if (v_counts[v_max_cl] != 0) {
-      goto label__1__break;
+      goto label__2__break;
     }
     if (v_max_cl <= 1) {
       return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
     }
     v_max_cl -= 1;
   }
-label__1__break:;
+label__2__break:;
   if (v_max_cl <= 9) {
     self->private_impl.f_n_huffs_bits[a_which] = v_max_cl;
   } else {
@@ -13466,7 +17509,7 @@ label__1__break:;
         v_j = v_prev_cl;
         while (v_j <= 15) {
           if (v_remaining <= ((uint32_t)(v_counts[v_j]))) {
-            goto label__2__break;
+            goto label__3__break;
           }
           v_remaining -= ((uint32_t)(v_counts[v_j]));
           if (v_remaining > 1073741824) {
@@ -13476,7 +17519,7 @@ label__1__break:;
           v_remaining <<= 1;
           v_j += 1;
         }
-      label__2__break:;
+      label__3__break:;
         if ((v_j <= 9) || (15 < v_j)) {
           return wuffs_base__make_status(
               wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
@@ -13541,7 +17584,7 @@ label__1__break:;
     }
     v_i += 1;
     if (v_i >= v_n_symbols) {
-      goto label__3__break;
+      goto label__4__break;
     }
     v_code += 1;
     if (v_code >= 32768) {
@@ -13549,30 +17592,300 @@ label__1__break:;
           wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
   }
-label__3__break:;
+label__4__break:;
+  if ((a_which == 0) && (a_base_symbol == 257) &&
+      ((v_min_cl + v_min_cl) <= self->private_impl.f_n_huffs_bits[0])) {
+    v_n_keys = (((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]);
+    v_i = 0;
+    while (v_i < v_n_keys) {
+      v_value = self->private_data.f_huffs[0][v_i];
+      if ((v_value >> 31) != 0) {
+        v_cl = (v_value & 15);
+        v_second = self->private_data.f_huffs[0][(v_i >> v_cl)];
+        if (((v_second >> 31) != 0) && ((v_cl + (v_second & 15)) <=
+                                        self->private_impl.f_n_huffs_bits[0])) {
+          self->private_data.f_huffs[0][v_i] =
+              ((v_value & 65295) | 2147483648 | ((v_second & 65280) << 8) |
+               ((v_second & 15) << 4));
+        }
+      }
+      v_i += 1;
+    }
+  }
   return wuffs_base__make_status(NULL);
 }
 
-// -------- func deflate.decoder.decode_huffman_fast
+// -------- func deflate.stats_decoder.add_history
 
-static wuffs_base__status  //
-wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
-                                            wuffs_base__io_buffer* a_dst,
-                                            wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__add_history(wuffs_deflate__stats_decoder* self,
+                                          wuffs_base__slice_u8 a_hist) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n_copied = 0;
+  uint32_t v_already_full = 0;
+
+  v_s = a_hist;
+  if (((uint64_t)(v_s.len)) >= 32768) {
+    v_s = wuffs_base__slice_u8__suffix(v_s, 32768);
+    wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_j(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            32768),
+        v_s);
+    self->private_impl.f_history_index = 32768;
+  } else {
+    v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+        wuffs_base__slice_u8__subslice_ij(
+            wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+            (self->private_impl.f_history_index & 32767), 32768),
+        v_s);
+    if (v_n_copied < ((uint64_t)(v_s.len))) {
+      v_s = wuffs_base__slice_u8__subslice_i(v_s, v_n_copied);
+      v_n_copied = wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__slice_u8__subslice_j(
+              wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+              32768),
+          v_s);
+      self->private_impl.f_history_index =
+          (((uint32_t)((v_n_copied & 32767))) + 32768);
+    } else {
+      v_already_full = 0;
+      if (self->private_impl.f_history_index >= 32768) {
+        v_already_full = 32768;
+      }
+      self->private_impl.f_history_index =
+          ((self->private_impl.f_history_index & 32767) +
+           ((uint32_t)((v_n_copied & 32767))) + v_already_full);
+    }
+  }
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_i(
+          wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+          32768),
+      wuffs_base__make_slice_u8(self->private_data.f_history, 33025));
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.set_dst_holds_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_history(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_history = a_dhh;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.set_dst_holds_history_on_short_write
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_history_on_short_write(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_history_on_short_write = a_dhh;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.set_dst_holds_window
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_dst_holds_window(
+    wuffs_deflate__stats_decoder* self,
+    bool a_dhw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_dst_holds_window = a_dhw;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__set_report_block_boundaries(
+    wuffs_deflate__stats_decoder* self,
+    bool a_rbb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_block_boundaries = a_rbb;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__stats_decoder__held_bits(
+    const wuffs_deflate__stats_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_bits;
+}
+
+// -------- func deflate.stats_decoder.n_held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_deflate__stats_decoder__n_held_bits(
+    const wuffs_deflate__stats_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_n_bits;
+}
+
+// -------- func deflate.stats_decoder.copy_history
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__copy_history(wuffs_deflate__stats_decoder* self,
+                                           wuffs_base__slice_u8 a_dst) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_i = 0;
+  uint64_t v_n = 0;
+
+  v_i = (self->private_impl.f_history_index & 32767);
+  v_s = wuffs_base__slice_u8__subslice_j(
+      wuffs_base__make_slice_u8(self->private_data.f_history, 33025), v_i);
+  if (((uint64_t)(a_dst.len)) <= ((uint64_t)(v_s.len))) {
+    v_n = wuffs_base__slice_u8__copy_from_slice(
+        a_dst, wuffs_base__slice_u8__suffix(v_s, ((uint64_t)(a_dst.len))));
+    return v_n;
+  }
+  if (self->private_impl.f_history_index >= 32768) {
+    v_n = wuffs_base__slice_u8__copy_from_slice(
+        a_dst,
+        wuffs_base__slice_u8__suffix(
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+                v_i, 32768),
+            (((uint64_t)(a_dst.len)) - ((uint64_t)(v_s.len)))));
+  }
+  if (v_n < ((uint64_t)(a_dst.len))) {
+    wuffs_base__u64__sat_add_indirect(
+        &v_n, wuffs_base__slice_u8__copy_from_slice(
+                  wuffs_base__slice_u8__subslice_i(a_dst, v_n), v_s));
+  }
+  return v_n;
+}
+
+// -------- func deflate.stats_decoder.resume_at_checkpoint
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__stats_decoder__resume_at_checkpoint(
+    wuffs_deflate__stats_decoder* self,
+    uint32_t a_held_bits,
+    uint32_t a_n_held_bits,
+    wuffs_base__slice_u8 a_window) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_n_bits = (a_n_held_bits & 7);
+  self->private_impl.f_bits =
+      (a_held_bits & ((((uint32_t)(1)) << self->private_impl.f_n_bits) - 1));
+  self->private_impl.f_history_index = 0;
+  self->private_impl.f_n_history_pending = 0;
+  wuffs_deflate__stats_decoder__add_history(self, a_window);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.stats_decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__stats_decoder__workbuf_len(
+    const wuffs_deflate__stats_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(1, 1);
+}
+
+// -------- func deflate.stats_decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__stats_decoder__transform_io(wuffs_deflate__stats_decoder* self,
+                                           wuffs_base__io_buffer* a_dst,
+                                           wuffs_base__io_buffer* a_src,
+                                           wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_bits = 0;
-  uint32_t v_n_bits = 0;
-  uint32_t v_table_entry = 0;
-  uint32_t v_table_entry_n_bits = 0;
-  uint32_t v_lmask = 0;
-  uint32_t v_dmask = 0;
-  uint32_t v_redir_top = 0;
-  uint32_t v_redir_mask = 0;
-  uint32_t v_length = 0;
-  uint32_t v_dist_minus_1 = 0;
-  uint32_t v_hlen = 0;
-  uint32_t v_hdist = 0;
+  uint64_t v_mark = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_hist = {0};
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -13587,295 +17900,295 @@ wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
       io2_a_dst = iop_a_dst;
     }
   }
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
 
-  if ((self->private_impl.f_n_bits >= 8) ||
-      ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
-    status = wuffs_base__make_status(
-        wuffs_deflate__error__internal_error_inconsistent_n_bits);
-    goto exit;
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
   }
-  v_bits = self->private_impl.f_bits;
-  v_n_bits = self->private_impl.f_n_bits;
-  v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
-  v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
-label__loop__continue:;
-  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 258) &&
-         (((uint64_t)(io2_a_src - iop_a_src)) >= 12)) {
-    if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    } else {
-    }
-    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
-    v_table_entry_n_bits = (v_table_entry & 15);
-    v_bits >>= v_table_entry_n_bits;
-    v_n_bits -= v_table_entry_n_bits;
-    if ((v_table_entry >> 31) != 0) {
-      (wuffs_base__store_u8be__no_bounds_check(
-           iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
-       iop_a_dst += 1, wuffs_base__make_empty_struct());
-      goto label__loop__continue;
-    } else if ((v_table_entry >> 30) != 0) {
-    } else if ((v_table_entry >> 29) != 0) {
-      self->private_impl.f_end_of_block = true;
-      goto label__loop__break;
-    } else if ((v_table_entry >> 28) != 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
-      v_redir_top = ((v_table_entry >> 8) & 65535);
-      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
-      v_table_entry_n_bits = (v_table_entry & 15);
-      v_bits >>= v_table_entry_n_bits;
-      v_n_bits -= v_table_entry_n_bits;
-      if ((v_table_entry >> 31) != 0) {
-        (wuffs_base__store_u8be__no_bounds_check(
-             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
-         iop_a_dst += 1, wuffs_base__make_empty_struct());
-        goto label__loop__continue;
-      } else if ((v_table_entry >> 30) != 0) {
-      } else if ((v_table_entry >> 29) != 0) {
-        self->private_impl.f_end_of_block = true;
-        goto label__loop__break;
-      } else if ((v_table_entry >> 28) != 0) {
-        status = wuffs_base__make_status(
-            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-        goto exit;
-      } else if ((v_table_entry >> 27) != 0) {
-        status =
-            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
-        goto exit;
-      } else {
-        status = wuffs_base__make_status(
-            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-        goto exit;
-      }
-    } else if ((v_table_entry >> 27) != 0) {
-      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
-      goto exit;
-    } else {
-      status = wuffs_base__make_status(
-          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-      goto exit;
-    }
-    v_length = (((v_table_entry >> 8) & 255) + 3);
-    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
-    if (v_table_entry_n_bits > 0) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
-      v_length =
-          (((v_length + 253 +
-             ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
-            255) +
-           3);
-      v_bits >>= v_table_entry_n_bits;
-      v_n_bits -= v_table_entry_n_bits;
-    } else {
-    }
-    if (v_n_bits < 15) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    } else {
-    }
-    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
-    v_table_entry_n_bits = (v_table_entry & 15);
-    v_bits >>= v_table_entry_n_bits;
-    v_n_bits -= v_table_entry_n_bits;
-    if ((v_table_entry >> 28) == 1) {
-      if (v_n_bits < 15) {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-      } else {
-      }
-      v_redir_top = ((v_table_entry >> 8) & 65535);
-      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-      v_table_entry =
-          self->private_data
-              .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
-      v_table_entry_n_bits = (v_table_entry & 15);
-      v_bits >>= v_table_entry_n_bits;
-      v_n_bits -= v_table_entry_n_bits;
-    } else {
-    }
-    if ((v_table_entry >> 24) != 64) {
-      if ((v_table_entry >> 24) == 8) {
-        status =
-            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
-        goto exit;
-      }
-      status = wuffs_base__make_status(
-          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-      goto exit;
-    }
-    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
-    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
-    if (v_n_bits < v_table_entry_n_bits) {
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-      v_bits |= (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-                 << v_n_bits);
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
-      v_n_bits += 8;
-    }
-    v_dist_minus_1 =
-        ((v_dist_minus_1 +
-          ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
-         32767);
-    v_bits >>= v_table_entry_n_bits;
-    v_n_bits -= v_table_entry_n_bits;
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
     while (true) {
-      if (((uint64_t)((v_dist_minus_1 + 1))) >
-          ((uint64_t)(iop_a_dst - io0_a_dst))) {
-        v_hlen = 0;
-        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
-                               ((uint64_t)(iop_a_dst - io0_a_dst)))));
-        if (v_length > v_hdist) {
-          v_length -= v_hdist;
-          v_hlen = v_hdist;
-        } else {
-          v_hlen = v_length;
-          v_length = 0;
-        }
-        if (self->private_impl.f_history_index < v_hdist) {
-          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
-          goto exit;
+      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+      {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
         }
-        v_hdist = (self->private_impl.f_history_index - v_hdist);
-        wuffs_base__io_writer__copy_n32_from_slice(
-            &iop_a_dst, io2_a_dst, v_hlen,
-            wuffs_base__slice_u8__subslice_i(
-                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
-                (v_hdist & 32767)));
-        if (v_length == 0) {
-          goto label__loop__continue;
+        wuffs_base__status t_0 =
+            wuffs_deflate__stats_decoder__decode_blocks(self, a_dst, a_src);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
         }
-        if (((uint64_t)((v_dist_minus_1 + 1))) >
-            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_status = t_0;
+      }
+      if (!wuffs_base__status__is_suspension(&v_status)) {
+        status = v_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
           status = wuffs_base__make_status(
-              wuffs_deflate__error__internal_error_inconsistent_distance);
+              wuffs_base__error__cannot_return_a_suspension);
           goto exit;
         }
+        goto ok;
+      }
+      if (self->private_impl.f_dst_holds_window ||
+          (self->private_impl.f_dst_holds_history &&
+           (v_status.repr ==
+            wuffs_base__make_status(wuffs_base__suspension__short_read)
+                .repr)) ||
+          (self->private_impl.f_dst_holds_history_on_short_write &&
+           (v_status.repr ==
+            wuffs_base__make_status(wuffs_base__suspension__short_write)
+                .repr))) {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_n_history_pending,
+            wuffs_base__io__count_since(v_mark,
+                                        ((uint64_t)(iop_a_dst - io0_a_dst))));
+      } else if (self->private_impl.f_n_history_pending > 0) {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_n_history_pending,
+            wuffs_base__io__count_since(v_mark,
+                                        ((uint64_t)(iop_a_dst - io0_a_dst))));
+        v_hist = wuffs_base__io__since(0, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                       io0_a_dst);
+        if (((uint64_t)(v_hist.len)) > self->private_impl.f_n_history_pending) {
+          v_hist = wuffs_base__slice_u8__suffix(
+              v_hist, self->private_impl.f_n_history_pending);
+        }
+        wuffs_deflate__stats_decoder__add_history(self, v_hist);
+        self->private_impl.f_n_history_pending = 0;
+      } else {
+        wuffs_deflate__stats_decoder__add_history(
+            self, wuffs_base__io__since(
+                      v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)), io0_a_dst));
+      }
+      status = v_status;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      if (((uint64_t)(iop_a_dst - io0_a_dst)) <
+          wuffs_base__u64__min(self->private_impl.f_n_history_pending, 32768)) {
+        status = wuffs_base__make_status(wuffs_deflate__error__missing_history);
+        goto exit;
       }
-      wuffs_base__io_writer__copy_n32_from_history_fast(
-          &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
-      goto label__0__break;
-    }
-  label__0__break:;
-  }
-label__loop__break:;
-  while (v_n_bits >= 8) {
-    v_n_bits -= 8;
-    if (iop_a_src > io1_a_src) {
-      (iop_a_src--, wuffs_base__make_empty_struct());
-    } else {
-      status = wuffs_base__make_status(
-          wuffs_deflate__error__internal_error_inconsistent_i_o);
-      goto exit;
     }
-  }
-  self->private_impl.f_bits = (v_bits & ((((uint32_t)(1)) << v_n_bits) - 1));
-  self->private_impl.f_n_bits = v_n_bits;
-  if ((self->private_impl.f_n_bits >= 8) ||
-      ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
-    status = wuffs_base__make_status(
-        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
     goto exit;
   }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
   goto exit;
 exit:
   if (a_dst) {
     a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func deflate.decoder.decode_huffman_slow
+// -------- func deflate.stats_decoder.decode_blocks
 
 static wuffs_base__status  //
-wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
+wuffs_deflate__stats_decoder__decode_blocks(wuffs_deflate__stats_decoder* self,
                                             wuffs_base__io_buffer* a_dst,
                                             wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_bits = 0;
-  uint32_t v_n_bits = 0;
-  uint32_t v_table_entry = 0;
-  uint32_t v_table_entry_n_bits = 0;
-  uint32_t v_lmask = 0;
-  uint32_t v_dmask = 0;
+  uint32_t v_final = 0;
   uint32_t v_b0 = 0;
-  uint32_t v_redir_top = 0;
-  uint32_t v_redir_mask = 0;
-  uint32_t v_b1 = 0;
-  uint32_t v_length = 0;
-  uint32_t v_b2 = 0;
-  uint32_t v_b3 = 0;
-  uint32_t v_b4 = 0;
-  uint32_t v_dist_minus_1 = 0;
-  uint32_t v_b5 = 0;
+  uint32_t v_type = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_blocks[0];
+  if (coro_susp_point) {
+    v_final = self->private_data.s_decode_blocks[0].v_final;
+    v_type = self->private_data.s_decode_blocks[0].v_type;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+  label__outer__continue:;
+    while (v_final == 0) {
+      while (self->private_impl.f_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        self->private_impl.f_bits |= (v_b0 << self->private_impl.f_n_bits);
+        self->private_impl.f_n_bits += 8;
+      }
+      v_final = (self->private_impl.f_bits & 1);
+      v_type = ((self->private_impl.f_bits >> 1) & 3);
+      self->private_impl.f_bits >>= 3;
+      self->private_impl.f_n_bits -= 3;
+      if (v_type == 0) {
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[0], 1);
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__stats_decoder__decode_uncompressed(self, a_dst,
+                                                                   a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (self->private_impl.f_report_block_boundaries && (v_final == 0)) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__suspension__block_boundary);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
+        }
+        goto label__outer__continue;
+      } else if (v_type == 1) {
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[1], 1);
+        v_status = wuffs_deflate__stats_decoder__init_fixed_huffman(self);
+        if (!wuffs_base__status__is_ok(&v_status)) {
+          status = v_status;
+          if (wuffs_base__status__is_error(&status)) {
+            goto exit;
+          } else if (wuffs_base__status__is_suspension(&status)) {
+            status = wuffs_base__make_status(
+                wuffs_base__error__cannot_return_a_suspension);
+            goto exit;
+          }
+          goto ok;
+        }
+      } else if (v_type == 2) {
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[2], 1);
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status =
+            wuffs_deflate__stats_decoder__init_dynamic_huffman(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else {
+        status = wuffs_base__make_status(wuffs_deflate__error__bad_block);
+        goto exit;
+      }
+      self->private_impl.f_stats_block_start = wuffs_base__u64__sat_add(
+          self->private_impl.f_stats[6], self->private_impl.f_stats[8]);
+      self->private_impl.f_end_of_block = false;
+      while (true) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        v_status = wuffs_deflate__stats_decoder__decode_huffman_fast(
+            self, a_dst, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (wuffs_base__status__is_error(&v_status)) {
+          status = v_status;
+          goto exit;
+        }
+        if (self->private_impl.f_end_of_block) {
+          goto label__0__break;
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        status = wuffs_deflate__stats_decoder__decode_huffman_slow(self, a_dst,
+                                                                   a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (self->private_impl.f_end_of_block) {
+          goto label__0__break;
+        }
+      }
+    label__0__break:;
+      if (v_type == 1) {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_stats[4],
+            (wuffs_base__u64__sat_add(self->private_impl.f_stats[6],
+                                      self->private_impl.f_stats[8]) -
+             self->private_impl.f_stats_block_start));
+      } else {
+        wuffs_base__u64__sat_add_indirect(
+            &self->private_impl.f_stats[5],
+            (wuffs_base__u64__sat_add(self->private_impl.f_stats[6],
+                                      self->private_impl.f_stats[8]) -
+             self->private_impl.f_stats_block_start));
+      }
+      if (self->private_impl.f_report_block_boundaries && (v_final == 0)) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__suspension__block_boundary);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+      }
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_blocks[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_blocks[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_blocks[0].v_final = v_final;
+  self->private_data.s_decode_blocks[0].v_type = v_type;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.stats_decoder.decode_uncompressed
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_uncompressed(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_length = 0;
   uint32_t v_n_copied = 0;
-  uint32_t v_hlen = 0;
-  uint32_t v_hdist = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -13901,21 +18214,9 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_slow[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_uncompressed[0];
   if (coro_susp_point) {
-    v_bits = self->private_data.s_decode_huffman_slow[0].v_bits;
-    v_n_bits = self->private_data.s_decode_huffman_slow[0].v_n_bits;
-    v_table_entry = self->private_data.s_decode_huffman_slow[0].v_table_entry;
-    v_table_entry_n_bits =
-        self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits;
-    v_lmask = self->private_data.s_decode_huffman_slow[0].v_lmask;
-    v_dmask = self->private_data.s_decode_huffman_slow[0].v_dmask;
-    v_redir_top = self->private_data.s_decode_huffman_slow[0].v_redir_top;
-    v_redir_mask = self->private_data.s_decode_huffman_slow[0].v_redir_mask;
-    v_length = self->private_data.s_decode_huffman_slow[0].v_length;
-    v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
-    v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
-    v_hdist = self->private_data.s_decode_huffman_slow[0].v_hdist;
+    v_length = self->private_data.s_decode_uncompressed[0].v_length;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
@@ -13927,340 +18228,366 @@ wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
           wuffs_deflate__error__internal_error_inconsistent_n_bits);
       goto exit;
     }
-    v_bits = self->private_impl.f_bits;
-    v_n_bits = self->private_impl.f_n_bits;
-    v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
-    v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
-  label__loop__continue:;
-    while (!(self->private_impl.p_decode_huffman_slow[0] != 0)) {
-      while (true) {
-        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
-        v_table_entry_n_bits = (v_table_entry & 15);
-        if (v_n_bits >= v_table_entry_n_bits) {
-          v_bits >>= v_table_entry_n_bits;
-          v_n_bits -= v_table_entry_n_bits;
-          goto label__0__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_bits = 0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+        t_0 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+        iop_a_src += 4;
+      } else {
+        self->private_data.s_decode_uncompressed[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint32_t t_0 = *iop_a_src++;
-          v_b0 = t_0;
-        }
-        v_bits |= (v_b0 << v_n_bits);
-        v_n_bits += 8;
-      }
-    label__0__break:;
-      if ((v_table_entry >> 31) != 0) {
-        self->private_data.s_decode_huffman_slow[0].scratch =
-            ((uint8_t)(((v_table_entry >> 8) & 255)));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (iop_a_dst == io2_a_dst) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
-          goto suspend;
-        }
-        *iop_a_dst++ =
-            ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
-        goto label__loop__continue;
-      } else if ((v_table_entry >> 30) != 0) {
-      } else if ((v_table_entry >> 29) != 0) {
-        self->private_impl.f_end_of_block = true;
-        goto label__loop__break;
-      } else if ((v_table_entry >> 28) != 0) {
-        v_redir_top = ((v_table_entry >> 8) & 65535);
-        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-        while (true) {
-          v_table_entry =
-              self->private_data
-                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
-          v_table_entry_n_bits = (v_table_entry & 15);
-          if (v_n_bits >= v_table_entry_n_bits) {
-            v_bits >>= v_table_entry_n_bits;
-            v_n_bits -= v_table_entry_n_bits;
-            goto label__1__break;
-          }
-          {
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint32_t t_1 = *iop_a_src++;
-            v_b1 = t_1;
+          uint64_t* scratch =
+              &self->private_data.s_decode_uncompressed[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 24) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
           }
-          v_bits |= (v_b1 << v_n_bits);
-          v_n_bits += 8;
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
         }
-      label__1__break:;
-        if ((v_table_entry >> 31) != 0) {
-          self->private_data.s_decode_huffman_slow[0].scratch =
-              ((uint8_t)(((v_table_entry >> 8) & 255)));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (iop_a_dst == io2_a_dst) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_write);
-            goto suspend;
-          }
-          *iop_a_dst++ =
-              ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
-          goto label__loop__continue;
-        } else if ((v_table_entry >> 30) != 0) {
-        } else if ((v_table_entry >> 29) != 0) {
-          self->private_impl.f_end_of_block = true;
-          goto label__loop__break;
-        } else if ((v_table_entry >> 28) != 0) {
-          status = wuffs_base__make_status(
-              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-          goto exit;
-        } else if ((v_table_entry >> 27) != 0) {
-          status =
-              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
-          goto exit;
-        } else {
-          status = wuffs_base__make_status(
-              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-          goto exit;
-        }
-      } else if ((v_table_entry >> 27) != 0) {
-        status =
-            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
-        goto exit;
+      }
+      v_length = t_0;
+    }
+    if ((((v_length)&0xFFFF) + ((v_length) >> (32 - (16)))) != 65535) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__inconsistent_stored_block_length);
+      goto exit;
+    }
+    v_length = ((v_length)&0xFFFF);
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[3],
+                                      ((uint64_t)(v_length)));
+    while (true) {
+      v_n_copied = wuffs_base__io_writer__copy_n32_from_reader(
+          &iop_a_dst, io2_a_dst, v_length, &iop_a_src, io2_a_src);
+      if (v_length <= v_n_copied) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      v_length -= v_n_copied;
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(3);
       } else {
-        status = wuffs_base__make_status(
-            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
-        goto exit;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
       }
-      v_length = (((v_table_entry >> 8) & 255) + 3);
-      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
-      if (v_table_entry_n_bits > 0) {
-        while (v_n_bits < v_table_entry_n_bits) {
-          {
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint32_t t_2 = *iop_a_src++;
-            v_b2 = t_2;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_uncompressed[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_uncompressed[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_uncompressed[0].v_length = v_length;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.stats_decoder.init_fixed_huffman
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__init_fixed_huffman(
+    wuffs_deflate__stats_decoder* self) {
+  uint32_t v_i = 0;
+
+  while (v_i < 512) {
+    self->private_data.f_huffs[0][v_i] = wuffs_deflate__fixed_huffs_lcode[v_i];
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 32) {
+    self->private_data.f_huffs[1][v_i] = wuffs_deflate__fixed_huffs_dcode[v_i];
+    v_i += 1;
+  }
+  self->private_impl.f_n_huffs_bits[0] = 9;
+  self->private_impl.f_n_huffs_bits[1] = 5;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.stats_decoder.init_dynamic_huffman
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__init_dynamic_huffman(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_n_lit = 0;
+  uint32_t v_n_dist = 0;
+  uint32_t v_n_clen = 0;
+  uint32_t v_i = 0;
+  uint32_t v_b1 = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint32_t v_mask = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_n_extra_bits = 0;
+  uint8_t v_rep_symbol = 0;
+  uint32_t v_rep_count = 0;
+  uint32_t v_b3 = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_init_dynamic_huffman[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_init_dynamic_huffman[0].v_bits;
+    v_n_bits = self->private_data.s_init_dynamic_huffman[0].v_n_bits;
+    v_n_lit = self->private_data.s_init_dynamic_huffman[0].v_n_lit;
+    v_n_dist = self->private_data.s_init_dynamic_huffman[0].v_n_dist;
+    v_n_clen = self->private_data.s_init_dynamic_huffman[0].v_n_clen;
+    v_i = self->private_data.s_init_dynamic_huffman[0].v_i;
+    v_mask = self->private_data.s_init_dynamic_huffman[0].v_mask;
+    v_table_entry = self->private_data.s_init_dynamic_huffman[0].v_table_entry;
+    v_n_extra_bits =
+        self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits;
+    v_rep_symbol = self->private_data.s_init_dynamic_huffman[0].v_rep_symbol;
+    v_rep_count = self->private_data.s_init_dynamic_huffman[0].v_rep_count;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    while (v_n_bits < 14) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint32_t t_0 = *iop_a_src++;
+        v_b0 = t_0;
+      }
+      v_bits |= (v_b0 << v_n_bits);
+      v_n_bits += 8;
+    }
+    v_n_lit = (((v_bits)&0x1F) + 257);
+    if (v_n_lit > 286) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__bad_literal_length_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_dist = (((v_bits)&0x1F) + 1);
+    if (v_n_dist > 30) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__bad_distance_code_count);
+      goto exit;
+    }
+    v_bits >>= 5;
+    v_n_clen = (((v_bits)&0xF) + 4);
+    v_bits >>= 4;
+    v_n_bits -= 14;
+    v_i = 0;
+    while (v_i < v_n_clen) {
+      while (v_n_bits < 3) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          v_bits |= (v_b2 << v_n_bits);
-          v_n_bits += 8;
+          uint32_t t_1 = *iop_a_src++;
+          v_b1 = t_1;
         }
-        v_length = (((v_length + 253 +
-                      ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(
-                          v_table_entry_n_bits))) &
-                     255) +
-                    3);
-        v_bits >>= v_table_entry_n_bits;
-        v_n_bits -= v_table_entry_n_bits;
+        v_bits |= (v_b1 << v_n_bits);
+        v_n_bits += 8;
       }
+      self->private_data.f_code_lengths[wuffs_deflate__code_order[v_i]] =
+          ((uint8_t)((v_bits & 7)));
+      v_bits >>= 3;
+      v_n_bits -= 3;
+      v_i += 1;
+    }
+    while (v_i < 19) {
+      self->private_data.f_code_lengths[wuffs_deflate__code_order[v_i]] = 0;
+      v_i += 1;
+    }
+    v_status = wuffs_deflate__stats_decoder__init_huff(self, 0, 0, 19, 4095);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_mask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_i = 0;
+  label__0__continue:;
+    while (v_i < (v_n_lit + v_n_dist)) {
       while (true) {
-        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_mask)];
         v_table_entry_n_bits = (v_table_entry & 15);
         if (v_n_bits >= v_table_entry_n_bits) {
           v_bits >>= v_table_entry_n_bits;
           v_n_bits -= v_table_entry_n_bits;
-          goto label__2__break;
+          goto label__1__break;
         }
         {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint32_t t_3 = *iop_a_src++;
-          v_b3 = t_3;
+          uint32_t t_2 = *iop_a_src++;
+          v_b2 = t_2;
         }
-        v_bits |= (v_b3 << v_n_bits);
+        v_bits |= (v_b2 << v_n_bits);
         v_n_bits += 8;
       }
-    label__2__break:;
-      if ((v_table_entry >> 28) == 1) {
-        v_redir_top = ((v_table_entry >> 8) & 65535);
-        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
-        while (true) {
-          v_table_entry =
-              self->private_data
-                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
-          v_table_entry_n_bits = (v_table_entry & 15);
-          if (v_n_bits >= v_table_entry_n_bits) {
-            v_bits >>= v_table_entry_n_bits;
-            v_n_bits -= v_table_entry_n_bits;
-            goto label__3__break;
-          }
-          {
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint32_t t_4 = *iop_a_src++;
-            v_b4 = t_4;
-          }
-          v_bits |= (v_b4 << v_n_bits);
-          v_n_bits += 8;
-        }
-      label__3__break:;
+    label__1__break:;
+      if ((v_table_entry >> 24) != 128) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
       }
-      if ((v_table_entry >> 24) != 64) {
-        if ((v_table_entry >> 24) == 8) {
-          status =
-              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      v_table_entry = ((v_table_entry >> 8) & 255);
+      if (v_table_entry < 16) {
+        self->private_data.f_code_lengths[v_i] = ((uint8_t)(v_table_entry));
+        v_i += 1;
+        goto label__0__continue;
+      }
+      v_n_extra_bits = 0;
+      v_rep_symbol = 0;
+      v_rep_count = 0;
+      if (v_table_entry == 16) {
+        v_n_extra_bits = 2;
+        if (v_i <= 0) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__bad_huffman_code_length_repetition);
           goto exit;
         }
+        v_rep_symbol = (self->private_data.f_code_lengths[(v_i - 1)] & 15);
+        v_rep_count = 3;
+      } else if (v_table_entry == 17) {
+        v_n_extra_bits = 3;
+        v_rep_symbol = 0;
+        v_rep_count = 3;
+      } else if (v_table_entry == 18) {
+        v_n_extra_bits = 7;
+        v_rep_symbol = 0;
+        v_rep_count = 11;
+      } else {
         status = wuffs_base__make_status(
             wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
         goto exit;
       }
-      v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
-      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
-      if (v_table_entry_n_bits > 0) {
-        while (v_n_bits < v_table_entry_n_bits) {
-          {
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint32_t t_5 = *iop_a_src++;
-            v_b5 = t_5;
-          }
-          v_bits |= (v_b5 << v_n_bits);
-          v_n_bits += 8;
-        }
-        v_dist_minus_1 =
-            ((v_dist_minus_1 +
-              ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
-             32767);
-        v_bits >>= v_table_entry_n_bits;
-        v_n_bits -= v_table_entry_n_bits;
-      }
-      while (true) {
-        if (((uint64_t)((v_dist_minus_1 + 1))) >
-            ((uint64_t)(iop_a_dst - io0_a_dst))) {
-          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
-                                 ((uint64_t)(iop_a_dst - io0_a_dst)))));
-          if (v_length > v_hdist) {
-            v_length -= v_hdist;
-            v_hlen = v_hdist;
-          } else {
-            v_hlen = v_length;
-            v_length = 0;
-          }
-          if (self->private_impl.f_history_index < v_hdist) {
-            status =
-                wuffs_base__make_status(wuffs_deflate__error__bad_distance);
-            goto exit;
-          }
-          v_hdist = (self->private_impl.f_history_index - v_hdist);
-          while (true) {
-            v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
-                &iop_a_dst, io2_a_dst, v_hlen,
-                wuffs_base__slice_u8__subslice_ij(
-                    wuffs_base__make_slice_u8(self->private_data.f_history,
-                                              33025),
-                    (v_hdist & 32767), 32768));
-            if (v_hlen <= v_n_copied) {
-              v_hlen = 0;
-              goto label__4__break;
-            }
-            if (v_n_copied > 0) {
-              v_hlen -= v_n_copied;
-              v_hdist = ((v_hdist + v_n_copied) & 32767);
-              if (v_hdist == 0) {
-                goto label__4__break;
-              }
-            }
+      while (v_n_bits < v_n_extra_bits) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
-                wuffs_base__make_status(wuffs_base__suspension__short_write);
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
-          }
-        label__4__break:;
-          if (v_hlen > 0) {
-            while (true) {
-              v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
-                  &iop_a_dst, io2_a_dst, v_hlen,
-                  wuffs_base__slice_u8__subslice_ij(
-                      wuffs_base__make_slice_u8(self->private_data.f_history,
-                                                33025),
-                      (v_hdist & 32767), 32768));
-              if (v_hlen <= v_n_copied) {
-                v_hlen = 0;
-                goto label__5__break;
-              }
-              v_hlen -= v_n_copied;
-              v_hdist += v_n_copied;
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_write);
-              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
-            }
-          label__5__break:;
-          }
-          if (v_length == 0) {
-            goto label__loop__continue;
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
         }
-        v_n_copied = wuffs_base__io_writer__copy_n32_from_history(
-            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
-        if (v_length <= v_n_copied) {
-          v_length = 0;
-          goto label__6__break;
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+      v_rep_count += ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_n_extra_bits));
+      v_bits >>= v_n_extra_bits;
+      v_n_bits -= v_n_extra_bits;
+      while (v_rep_count > 0) {
+        if (v_i >= (v_n_lit + v_n_dist)) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__bad_huffman_code_length_count);
+          goto exit;
         }
-        v_length -= v_n_copied;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        self->private_data.f_code_lengths[v_i] = v_rep_symbol;
+        v_i += 1;
+        v_rep_count -= 1;
       }
-    label__6__break:;
     }
-  label__loop__break:;
-    self->private_impl.f_bits = v_bits;
-    self->private_impl.f_n_bits = v_n_bits;
-    if ((self->private_impl.f_n_bits >= 8) ||
-        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
-         0)) {
+    if (v_i != (v_n_lit + v_n_dist)) {
       status = wuffs_base__make_status(
-          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+          wuffs_deflate__error__bad_huffman_code_length_count);
+      goto exit;
+    }
+    if (self->private_data.f_code_lengths[256] == 0) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__missing_end_of_block_code);
+      goto exit;
+    }
+    v_status =
+        wuffs_deflate__stats_decoder__init_huff(self, 0, 0, v_n_lit, 257);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
+      goto exit;
+    }
+    v_status = wuffs_deflate__stats_decoder__init_huff(self, 1, v_n_lit,
+                                                       (v_n_lit + v_n_dist), 0);
+    if (wuffs_base__status__is_error(&v_status)) {
+      status = v_status;
       goto exit;
     }
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_huffman_slow[0] = 0;
+    self->private_impl.p_init_dynamic_huffman[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_huffman_slow[0] =
+  self->private_impl.p_init_dynamic_huffman[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_huffman_slow[0].v_bits = v_bits;
-  self->private_data.s_decode_huffman_slow[0].v_n_bits = v_n_bits;
-  self->private_data.s_decode_huffman_slow[0].v_table_entry = v_table_entry;
-  self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits =
-      v_table_entry_n_bits;
-  self->private_data.s_decode_huffman_slow[0].v_lmask = v_lmask;
-  self->private_data.s_decode_huffman_slow[0].v_dmask = v_dmask;
-  self->private_data.s_decode_huffman_slow[0].v_redir_top = v_redir_top;
-  self->private_data.s_decode_huffman_slow[0].v_redir_mask = v_redir_mask;
-  self->private_data.s_decode_huffman_slow[0].v_length = v_length;
-  self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
-  self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
-  self->private_data.s_decode_huffman_slow[0].v_hdist = v_hdist;
+  self->private_data.s_init_dynamic_huffman[0].v_bits = v_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_bits = v_n_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_n_lit = v_n_lit;
+  self->private_data.s_init_dynamic_huffman[0].v_n_dist = v_n_dist;
+  self->private_data.s_init_dynamic_huffman[0].v_n_clen = v_n_clen;
+  self->private_data.s_init_dynamic_huffman[0].v_i = v_i;
+  self->private_data.s_init_dynamic_huffman[0].v_mask = v_mask;
+  self->private_data.s_init_dynamic_huffman[0].v_table_entry = v_table_entry;
+  self->private_data.s_init_dynamic_huffman[0].v_n_extra_bits = v_n_extra_bits;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_symbol = v_rep_symbol;
+  self->private_data.s_init_dynamic_huffman[0].v_rep_count = v_rep_count;
 
   goto exit;
 exit:
-  if (a_dst) {
-    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
-  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
@@ -14268,263 +18595,376 @@ exit:
   return status;
 }
 
-#endif  // !defined(WUFFS_CONFIG__MODULES) ||
-        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
-
-#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
-
-// ---------------- Status Codes Implementations
-
-const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
-const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
-    "#lzw: internal error: inconsistent I/O";
-
-// ---------------- Private Consts
-
-// ---------------- Private Initializer Prototypes
-
-// ---------------- Private Function Prototypes
-
-static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src);
+// -------- func deflate.stats_decoder.init_huff
 
 static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst);
-
-// ---------------- VTables
-
-const wuffs_base__io_transformer__func_ptrs
-    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__slice_u8))(
-            &wuffs_lzw__decoder__transform_io),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_lzw__decoder__workbuf_len),
-};
-
-// ---------------- Initializer Implementations
-
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
-  }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
-  }
+wuffs_deflate__stats_decoder__init_huff(wuffs_deflate__stats_decoder* self,
+                                        uint32_t a_which,
+                                        uint32_t a_n_codes0,
+                                        uint32_t a_n_codes1,
+                                        uint32_t a_base_symbol) {
+  uint16_t v_counts[16] = {0};
+  uint16_t v_odd_counts[16] = {0};
+  uint32_t v_sum = 0;
+  uint32_t v_i = 0;
+  uint32_t v_remaining = 0;
+  uint16_t v_offsets[16] = {0};
+  uint32_t v_n_symbols = 0;
+  uint32_t v_count = 0;
+  uint16_t v_symbols[320] = {0};
+  uint32_t v_min_cl = 0;
+  uint32_t v_max_cl = 0;
+  uint32_t v_initial_high_bits = 0;
+  uint32_t v_prev_cl = 0;
+  uint32_t v_prev_redirect_key = 0;
+  uint32_t v_top = 0;
+  uint32_t v_next_top = 0;
+  uint32_t v_code = 0;
+  uint32_t v_key = 0;
+  uint32_t v_value = 0;
+  uint32_t v_cl = 0;
+  uint32_t v_redirect_key = 0;
+  uint32_t v_j = 0;
+  uint32_t v_reversed_key = 0;
+  uint32_t v_symbol = 0;
+  uint32_t v_high_bits = 0;
+  uint32_t v_delta = 0;
+  uint32_t v_n_keys = 0;
+  uint32_t v_second = 0;
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
+  wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[9], 1);
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
 #pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#pragma GCC diagnostic ignored "-Wconversion"
 #endif
-    if (self->private_impl.magic != 0) {
+    v_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_i += 1;
+    if (v_i >= a_n_codes1) {
+      goto label__0__break;
+    }
+    if (v_odd_counts[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
       return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
-#if !defined(__clang__) && defined(__GNUC__)
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_odd_counts[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
 #pragma GCC diagnostic pop
 #endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    v_i += 1;
+  }
+label__0__break:;
+  v_i = 0;
+  while (v_i < 16) {
+    v_sum = (((uint32_t)(v_counts[v_i])) + ((uint32_t)(v_odd_counts[v_i])));
+    if (v_sum > 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
+    v_counts[v_i] = ((uint16_t)(v_sum));
+    v_i += 1;
   }
-
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
-
-size_t  //
-sizeof__wuffs_lzw__decoder() {
-  return sizeof(wuffs_lzw__decoder);
-}
-
-// ---------------- Function Implementations
-
-// -------- func lzw.decoder.set_literal_width
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
+  if ((((uint32_t)(v_counts[0])) + a_n_codes0) == a_n_codes1) {
+    return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+  v_remaining = 1;
+  v_i = 1;
+  while (v_i <= 15) {
+    if (v_remaining > 1073741824) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_remaining <<= 1;
+    if (v_remaining < ((uint32_t)(v_counts[v_i]))) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__bad_huffman_code_over_subscribed);
+    }
+    v_remaining -= ((uint32_t)(v_counts[v_i]));
+    v_i += 1;
   }
-  if (a_lw > 8) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_empty_struct();
+  if (v_remaining != 0) {
+    if ((a_which == 1) && (v_counts[1] == 1) &&
+        (self->private_data.f_code_lengths[a_n_codes0] == 1) &&
+        ((((uint32_t)(v_counts[0])) + a_n_codes0 + 1) == a_n_codes1)) {
+      self->private_impl.f_n_huffs_bits[1] = 1;
+      self->private_data.f_huffs[1][0] =
+          (wuffs_deflate__dcode_magic_numbers[0] | 1);
+      self->private_data.f_huffs[1][1] =
+          (wuffs_deflate__dcode_magic_numbers[31] | 1);
+      return wuffs_base__make_status(NULL);
+    }
+    return wuffs_base__make_status(
+        wuffs_deflate__error__bad_huffman_code_under_subscribed);
   }
-
-  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
-  return wuffs_base__make_empty_struct();
-}
-
-// -------- func lzw.decoder.workbuf_len
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
+  v_i = 1;
+  while (v_i <= 15) {
+    v_offsets[v_i] = ((uint16_t)(v_n_symbols));
+    v_count = ((uint32_t)(v_counts[v_i]));
+    if (v_n_symbols > (320 - v_count)) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_n_symbols = (v_n_symbols + v_count);
+    v_i += 1;
   }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
+  if (v_n_symbols > 288) {
+    return wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
   }
-
-  return wuffs_base__utility__make_range_ii_u64(0, 0);
-}
-
-// -------- func lzw.decoder.transform_io
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
-                                 wuffs_base__io_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__slice_u8 a_workbuf) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  v_i = a_n_codes0;
+  while (v_i < a_n_codes1) {
+    if (v_i < a_n_codes0) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    if (self->private_data.f_code_lengths[v_i] != 0) {
+      if (v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] >= 320) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      v_symbols[v_offsets[(self->private_data.f_code_lengths[v_i] & 15)]] =
+          ((uint16_t)((v_i - a_n_codes0)));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+      v_offsets[(self->private_data.f_code_lengths[v_i] & 15)] += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    }
+    v_i += 1;
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
+  v_min_cl = 1;
+  while (true) {
+    if (v_counts[v_min_cl] != 0) {
+      goto label__1__break;
+    }
+    if (v_min_cl >= 9) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__bad_huffman_minimum_code_length);
+    }
+    v_min_cl += 1;
   }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+label__1__break:;
+  v_max_cl = 15;
+  while (true) {
+    if (v_counts[v_max_cl] != 0) {
+      goto label__2__break;
+    }
+    if (v_max_cl <= 1) {
+      return wuffs_base__make_status(wuffs_deflate__error__no_huffman_codes);
+    }
+    v_max_cl -= 1;
   }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 1)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
+label__2__break:;
+  if (v_max_cl <= 9) {
+    self->private_impl.f_n_huffs_bits[a_which] = v_max_cl;
+  } else {
+    self->private_impl.f_n_huffs_bits[a_which] = 9;
+  }
+  v_i = 0;
+  if ((v_n_symbols != ((uint32_t)(v_offsets[v_max_cl]))) ||
+      (v_n_symbols != ((uint32_t)(v_offsets[15])))) {
     return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
   }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  uint32_t v_i = 0;
-
-  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
-  if (coro_susp_point) {
+  if ((a_n_codes0 + ((uint32_t)(v_symbols[0]))) >= 320) {
+    return wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    self->private_impl.f_literal_width = 8;
-    if (self->private_impl.f_set_literal_width_arg > 0) {
-      self->private_impl.f_literal_width =
-          (self->private_impl.f_set_literal_width_arg - 1);
+  v_initial_high_bits = 512;
+  if (v_max_cl < 9) {
+    v_initial_high_bits = (((uint32_t)(1)) << v_max_cl);
+  }
+  v_prev_cl = ((uint32_t)((self->private_data.f_code_lengths[(
+                               a_n_codes0 + ((uint32_t)(v_symbols[0])))] &
+                           15)));
+  v_prev_redirect_key = 4294967295;
+  v_top = 0;
+  v_next_top = 512;
+  v_code = 0;
+  v_key = 0;
+  v_value = 0;
+  while (true) {
+    if ((a_n_codes0 + ((uint32_t)(v_symbols[v_i]))) >= 320) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
-    self->private_impl.f_clear_code =
-        (((uint32_t)(1)) << self->private_impl.f_literal_width);
-    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
-    self->private_impl.f_save_code = self->private_impl.f_end_code;
-    self->private_impl.f_prev_code = self->private_impl.f_end_code;
-    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
-    self->private_impl.f_bits = 0;
-    self->private_impl.f_n_bits = 0;
-    self->private_impl.f_output_ri = 0;
-    self->private_impl.f_output_wi = 0;
-    v_i = 0;
-    while (v_i < self->private_impl.f_clear_code) {
-      self->private_data.f_lm1s[v_i] = 0;
-      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
-      v_i += 1;
+    v_cl = ((uint32_t)((self->private_data.f_code_lengths[(
+                            a_n_codes0 + ((uint32_t)(v_symbols[v_i])))] &
+                        15)));
+    if (v_cl > v_prev_cl) {
+      v_code <<= (v_cl - v_prev_cl);
+      if (v_code >= 32768) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
     }
-  label__0__continue:;
-    while (true) {
-      wuffs_lzw__decoder__read_from(self, a_src);
-      if (self->private_impl.f_output_wi > 0) {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_lzw__decoder__write_to(self, a_dst);
-        if (status.repr) {
-          goto suspend;
+    v_prev_cl = v_cl;
+    v_key = v_code;
+    if (v_cl > 9) {
+      v_cl -= 9;
+      v_redirect_key = ((v_key >> v_cl) & 511);
+      v_key = ((v_key)&WUFFS_BASE__LOW_BITS_MASK__U32(v_cl));
+      if (v_prev_redirect_key != v_redirect_key) {
+        v_prev_redirect_key = v_redirect_key;
+        v_remaining = (((uint32_t)(1)) << v_cl);
+        v_j = v_prev_cl;
+        while (v_j <= 15) {
+          if (v_remaining <= ((uint32_t)(v_counts[v_j]))) {
+            goto label__3__break;
+          }
+          v_remaining -= ((uint32_t)(v_counts[v_j]));
+          if (v_remaining > 1073741824) {
+            return wuffs_base__make_status(
+                wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          }
+          v_remaining <<= 1;
+          v_j += 1;
+        }
+      label__3__break:;
+        if ((v_j <= 9) || (15 < v_j)) {
+          return wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        }
+        v_j -= 9;
+        v_initial_high_bits = (((uint32_t)(1)) << v_j);
+        v_top = v_next_top;
+        if ((v_top + (((uint32_t)(1)) << v_j)) > 1024) {
+          return wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
         }
+        v_next_top = (v_top + (((uint32_t)(1)) << v_j));
+        v_redirect_key =
+            (((uint32_t)(wuffs_deflate__reverse8[(v_redirect_key >> 1)])) |
+             ((v_redirect_key & 1) << 8));
+        self->private_data.f_huffs[a_which][v_redirect_key] =
+            (268435465 | (v_top << 8) | (v_j << 4));
       }
-      if (self->private_impl.f_read_from_return_value == 0) {
-        goto label__0__break;
-      } else if (self->private_impl.f_read_from_return_value == 1) {
-        goto label__0__continue;
-      } else if (self->private_impl.f_read_from_return_value == 2) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
-      } else if (self->private_impl.f_read_from_return_value == 3) {
-        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
-        goto exit;
+    }
+    if ((v_key >= 512) || (v_counts[v_prev_cl] <= 0)) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+    v_counts[v_prev_cl] -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+    v_reversed_key = (((uint32_t)(wuffs_deflate__reverse8[(v_key >> 1)])) |
+                      ((v_key & 1) << 8));
+    v_reversed_key >>= (9 - v_cl);
+    v_symbol = ((uint32_t)(v_symbols[v_i]));
+    if (v_symbol == 256) {
+      v_value = (536870912 | v_cl);
+    } else if ((v_symbol < 256) && (a_which == 0)) {
+      v_value = (2147483648 | (v_symbol << 8) | v_cl);
+    } else if (v_symbol >= a_base_symbol) {
+      v_symbol -= a_base_symbol;
+      if (a_which == 0) {
+        v_value = (wuffs_deflate__lcode_magic_numbers[(v_symbol & 31)] | v_cl);
       } else {
-        status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
-        goto exit;
+        v_value = (wuffs_deflate__dcode_magic_numbers[(v_symbol & 31)] | v_cl);
       }
+    } else {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+    }
+    v_high_bits = v_initial_high_bits;
+    v_delta = (((uint32_t)(1)) << v_cl);
+    while (v_high_bits >= v_delta) {
+      v_high_bits -= v_delta;
+      if ((v_top + ((v_high_bits | v_reversed_key) & 511)) >= 1024) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      }
+      self->private_data
+          .f_huffs[a_which][(v_top + ((v_high_bits | v_reversed_key) & 511))] =
+          v_value;
+    }
+    v_i += 1;
+    if (v_i >= v_n_symbols) {
+      goto label__4__break;
+    }
+    v_code += 1;
+    if (v_code >= 32768) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
     }
-  label__0__break:;
-
-    goto ok;
-  ok:
-    self->private_impl.p_transform_io[0] = 0;
-    goto exit;
   }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_transform_io[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 1 : 0;
-
-  goto exit;
-exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
+label__4__break:;
+  if ((a_which == 0) && (a_base_symbol == 257) &&
+      ((v_min_cl + v_min_cl) <= self->private_impl.f_n_huffs_bits[0])) {
+    v_n_keys = (((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]);
+    v_i = 0;
+    while (v_i < v_n_keys) {
+      v_value = self->private_data.f_huffs[0][v_i];
+      if ((v_value >> 31) != 0) {
+        v_cl = (v_value & 15);
+        v_second = self->private_data.f_huffs[0][(v_i >> v_cl)];
+        if (((v_second >> 31) != 0) && ((v_cl + (v_second & 15)) <=
+                                        self->private_impl.f_n_huffs_bits[0])) {
+          self->private_data.f_huffs[0][v_i] =
+              ((v_value & 65295) | 2147483648 | ((v_second & 65280) << 8) |
+               ((v_second & 15) << 4));
+        }
+      }
+      v_i += 1;
+    }
   }
-  return status;
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func lzw.decoder.read_from
+// -------- func deflate.decoder.decode_huffman_fast
 
-static wuffs_base__empty_struct  //
-wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
-  uint32_t v_clear_code = 0;
-  uint32_t v_end_code = 0;
-  uint32_t v_save_code = 0;
-  uint32_t v_prev_code = 0;
-  uint32_t v_width = 0;
-  uint32_t v_bits = 0;
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_fast(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_bits = 0;
   uint32_t v_n_bits = 0;
-  uint32_t v_output_wi = 0;
-  uint32_t v_code = 0;
-  uint32_t v_c = 0;
-  uint32_t v_o = 0;
-  uint32_t v_steps = 0;
-  uint8_t v_first_byte = 0;
-  uint16_t v_lm1_b = 0;
-  uint16_t v_lm1_a = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -14536,178 +18976,222 @@ wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  v_clear_code = self->private_impl.f_clear_code;
-  v_end_code = self->private_impl.f_end_code;
-  v_save_code = self->private_impl.f_save_code;
-  v_prev_code = self->private_impl.f_prev_code;
-  v_width = self->private_impl.f_width;
-  v_bits = self->private_impl.f_bits;
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
   v_n_bits = self->private_impl.f_n_bits;
-  v_output_wi = self->private_impl.f_output_wi;
-  while (true) {
-    if (v_n_bits < v_width) {
-      if (((uint64_t)(io2_a_src - iop_a_src)) >= 4) {
-        v_bits |=
-            (wuffs_base__load_u32le__no_bounds_check(iop_a_src) << v_n_bits);
-        (iop_a_src += ((31 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
-        v_n_bits |= 24;
-      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        self->private_impl.f_read_from_return_value = 2;
-        goto label__0__break;
-      } else {
-        v_bits |=
-            (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-             << v_n_bits);
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        v_n_bits += 8;
-        if (v_n_bits >= v_width) {
-        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          self->private_impl.f_read_from_return_value = 2;
-          goto label__0__break;
-        } else {
-          v_bits |=
-              (((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
-               << v_n_bits);
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
-          v_n_bits += 8;
-          if (v_n_bits < v_width) {
-            self->private_impl.f_read_from_return_value = 4;
-            goto label__0__break;
-          }
-        }
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 258) &&
+         (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+    v_bits |= (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+    (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+    v_n_bits |= 56;
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+        goto label__loop__continue;
+      }
+      (wuffs_base__store_u8be__no_bounds_check(
+           iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+       iop_a_dst += 1, wuffs_base__make_empty_struct());
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
       }
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
     }
-    v_code = ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_width));
-    v_bits >>= v_width;
-    v_n_bits -= v_width;
-    if (v_code < v_clear_code) {
-      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
-      v_output_wi = ((v_output_wi + 1) & 8191);
-      if (v_save_code <= 4095) {
-        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
-        if ((v_lm1_a % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] =
-              ((uint8_t)(v_code));
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    v_bits |= (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+    (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+    v_n_bits |= 56;
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    } else {
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      }
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    v_dist_minus_1 =
+        ((v_dist_minus_1 + ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                               v_table_entry_n_bits))))) &
+         32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) >
+          ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                               ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
         } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
-        }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
+          v_hlen = v_length;
+          v_length = 0;
         }
-        v_prev_code = v_code;
-      }
-    } else if (v_code <= v_end_code) {
-      if (v_code == v_end_code) {
-        self->private_impl.f_read_from_return_value = 0;
-        goto label__0__break;
-      }
-      v_save_code = v_end_code;
-      v_prev_code = v_end_code;
-      v_width = (self->private_impl.f_literal_width + 1);
-    } else if (v_code <= v_save_code) {
-      v_c = v_code;
-      if (v_code == v_save_code) {
-        v_c = v_prev_code;
-      }
-      v_o = ((v_output_wi +
-              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) &
-             8191);
-      v_output_wi =
-          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
-           8191);
-      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
-      while (true) {
-        memcpy((self->private_data.f_output) + (v_o),
-               (self->private_data.f_suffixes[v_c]), 8);
-        if (v_steps <= 0) {
-          goto label__1__break;
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
         }
-        v_steps -= 1;
-        v_o = ((v_o - 8) & 8191);
-        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
-      }
-    label__1__break:;
-      v_first_byte = self->private_data.f_suffixes[v_c][0];
-      if (v_code == v_save_code) {
-        self->private_data.f_output[v_output_wi] = v_first_byte;
-        v_output_wi = ((v_output_wi + 1) & 8191);
-      }
-      if (v_save_code <= 4095) {
-        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
-        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
-        if ((v_lm1_b % 8) != 0) {
-          self->private_impl.f_prefixes[v_save_code] =
-              self->private_impl.f_prefixes[v_prev_code];
-          memcpy(self->private_data.f_suffixes[v_save_code],
-                 self->private_data.f_suffixes[v_prev_code],
-                 sizeof(self->private_data.f_suffixes[v_save_code]));
-          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] =
-              v_first_byte;
-        } else {
-          self->private_impl.f_prefixes[v_save_code] =
-              ((uint16_t)(v_prev_code));
-          self->private_data.f_suffixes[v_save_code][0] =
-              ((uint8_t)(v_first_byte));
+        v_hdist = (self->private_impl.f_history_index - v_hdist);
+        wuffs_base__io_writer__copy_n32_from_slice(
+            &iop_a_dst, io2_a_dst, v_hlen,
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+                (v_hdist & 32767)));
+        if (v_length == 0) {
+          goto label__loop__continue;
         }
-        v_save_code += 1;
-        if (v_width < 12) {
-          v_width += (1 & (v_save_code >> v_width));
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
         }
-        v_prev_code = v_code;
       }
-    } else {
-      self->private_impl.f_read_from_return_value = 3;
-      goto label__0__break;
-    }
-    if (v_output_wi > 4095) {
-      self->private_impl.f_read_from_return_value = 1;
+      wuffs_base__io_writer__copy_n32_from_history_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
       goto label__0__break;
     }
+  label__0__break:;
   }
-label__0__break:;
-  if (self->private_impl.f_read_from_return_value != 2) {
-    while (v_n_bits >= 8) {
-      v_n_bits -= 8;
-      if (iop_a_src > io1_a_src) {
-        (iop_a_src--, wuffs_base__make_empty_struct());
-      } else {
-        self->private_impl.f_read_from_return_value = 4;
-        goto label__2__break;
-      }
+label__loop__break:;
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      (iop_a_src--, wuffs_base__make_empty_struct());
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
     }
-  label__2__break:;
   }
-  self->private_impl.f_save_code = v_save_code;
-  self->private_impl.f_prev_code = v_prev_code;
-  self->private_impl.f_width = v_width;
-  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
   self->private_impl.f_n_bits = v_n_bits;
-  self->private_impl.f_output_wi = v_output_wi;
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func lzw.decoder.write_to
+// -------- func deflate.stats_decoder.decode_huffman_fast
 
 static wuffs_base__status  //
-wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
-                             wuffs_base__io_buffer* a_dst) {
+wuffs_deflate__stats_decoder__decode_huffman_fast(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  wuffs_base__slice_u8 v_s = {0};
-  uint64_t v_n = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint64_t v_lmask = 0;
+  uint64_t v_dmask = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_length = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -14722,79 +19206,3822 @@ wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
       io2_a_dst = iop_a_dst;
     }
   }
-
-  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
-  if (coro_susp_point) {
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (self->private_impl.f_output_wi > 0) {
-      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
+    goto exit;
+  }
+  v_bits = ((uint64_t)(self->private_impl.f_bits));
+  v_n_bits = self->private_impl.f_n_bits;
+  v_lmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+  v_dmask = ((((uint64_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+label__loop__continue:;
+  while ((((uint64_t)(io2_a_dst - iop_a_dst)) >= 258) &&
+         (((uint64_t)(io2_a_src - iop_a_src)) >= 16)) {
+    v_bits |= (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+    (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+    v_n_bits |= 56;
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[11], 1);
+    v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 31) != 0) {
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        (wuffs_base__store_u16le__no_bounds_check(
+             iop_a_dst, ((uint16_t)(((v_table_entry >> 8) & 65535)))),
+         iop_a_dst += 2, wuffs_base__make_empty_struct());
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[6], 2);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+        goto label__loop__continue;
+      }
+      (wuffs_base__store_u8be__no_bounds_check(
+           iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+       iop_a_dst += 1, wuffs_base__make_empty_struct());
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[6], 1);
+      goto label__loop__continue;
+    } else if ((v_table_entry >> 30) != 0) {
+    } else if ((v_table_entry >> 29) != 0) {
+      self->private_impl.f_end_of_block = true;
+      goto label__loop__break;
+    } else if ((v_table_entry >> 28) != 0) {
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[10], 1);
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[0][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+      if ((v_table_entry >> 31) != 0) {
+        (wuffs_base__store_u8be__no_bounds_check(
+             iop_a_dst, ((uint8_t)(((v_table_entry >> 8) & 255)))),
+         iop_a_dst += 1, wuffs_base__make_empty_struct());
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[6], 1);
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
         status = wuffs_base__make_status(
-            wuffs_lzw__error__internal_error_inconsistent_i_o);
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
         goto exit;
       }
-      v_s = wuffs_base__slice_u8__subslice_ij(
-          wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
-      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
-      if (v_n == ((uint64_t)(v_s.len))) {
-        self->private_impl.f_output_ri = 0;
-        self->private_impl.f_output_wi = 0;
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+    } else if ((v_table_entry >> 27) != 0) {
+      status = wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+      goto exit;
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
+    }
+    v_length = (((v_table_entry >> 8) & 255) + 3);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    if (v_table_entry_n_bits > 0) {
+      v_length = (((v_length + 253 +
+                    ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                        v_table_entry_n_bits))))) &
+                   255) +
+                  3);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    }
+    v_bits |= (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+    (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+    v_n_bits |= 56;
+    v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+    v_table_entry_n_bits = (v_table_entry & 15);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    if ((v_table_entry >> 28) == 1) {
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[10], 1);
+      v_redir_top = ((v_table_entry >> 8) & 65535);
+      v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+      v_table_entry = self->private_data.f_huffs[1][(
+          (v_redir_top + (((uint32_t)((v_bits & 32767))) & v_redir_mask)) &
+          1023)];
+      v_table_entry_n_bits = (v_table_entry & 15);
+      v_bits >>= v_table_entry_n_bits;
+      v_n_bits -= v_table_entry_n_bits;
+    } else {
+    }
+    if ((v_table_entry >> 24) != 64) {
+      if ((v_table_entry >> 24) == 8) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
       }
-      self->private_impl.f_output_ri =
-          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
-           8191);
-      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+      goto exit;
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_write_to[0] = 0;
+    v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+    v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+    v_dist_minus_1 =
+        ((v_dist_minus_1 + ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(
+                               v_table_entry_n_bits))))) &
+         32767);
+    v_bits >>= v_table_entry_n_bits;
+    v_n_bits -= v_table_entry_n_bits;
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[7], 1);
+    wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[8],
+                                      ((uint64_t)(v_length)));
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_stats_lengths[v_length], 1);
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_stats_distances[v_table_entry_n_bits], 1);
+    while (true) {
+      if (((uint64_t)((v_dist_minus_1 + 1))) >
+          ((uint64_t)(iop_a_dst - io0_a_dst))) {
+        v_hlen = 0;
+        v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                               ((uint64_t)(iop_a_dst - io0_a_dst)))));
+        if (v_length > v_hdist) {
+          v_length -= v_hdist;
+          v_hlen = v_hdist;
+        } else {
+          v_hlen = v_length;
+          v_length = 0;
+        }
+        if (self->private_impl.f_history_index < v_hdist) {
+          status = wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+          goto exit;
+        }
+        v_hdist = (self->private_impl.f_history_index - v_hdist);
+        wuffs_base__io_writer__copy_n32_from_slice(
+            &iop_a_dst, io2_a_dst, v_hlen,
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_history, 33025),
+                (v_hdist & 32767)));
+        if (v_length == 0) {
+          goto label__loop__continue;
+        }
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_distance);
+          goto exit;
+        }
+      }
+      wuffs_base__io_writer__copy_n32_from_history_fast(
+          &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+      goto label__0__break;
+    }
+  label__0__break:;
+  }
+label__loop__break:;
+  while (v_n_bits >= 8) {
+    v_n_bits -= 8;
+    if (iop_a_src > io1_a_src) {
+      (iop_a_src--, wuffs_base__make_empty_struct());
+    } else {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_i_o);
+      goto exit;
+    }
+  }
+  self->private_impl.f_bits =
+      ((uint32_t)((v_bits & ((((uint64_t)(1)) << v_n_bits) - 1))));
+  self->private_impl.f_n_bits = v_n_bits;
+  if ((self->private_impl.f_n_bits >= 8) ||
+      ((self->private_impl.f_bits >> self->private_impl.f_n_bits) != 0)) {
+    status = wuffs_base__make_status(
+        wuffs_deflate__error__internal_error_inconsistent_n_bits);
     goto exit;
   }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_write_to[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
   goto exit;
 exit:
   if (a_dst) {
     a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
 
   return status;
 }
 
-// -------- func lzw.decoder.flush
+// -------- func deflate.decoder.decode_huffman_slow
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
-wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
-  if (!self) {
-    return wuffs_base__make_slice_u8(NULL, 0);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_slice_u8(NULL, 0);
-  }
+static wuffs_base__status  //
+wuffs_deflate__decoder__decode_huffman_slow(wuffs_deflate__decoder* self,
+                                            wuffs_base__io_buffer* a_dst,
+                                            wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  wuffs_base__slice_u8 v_s = {0};
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_lmask = 0;
+  uint32_t v_dmask = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_length = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_b3 = 0;
+  uint32_t v_b4 = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_b5 = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
 
-  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
-    v_s = wuffs_base__slice_u8__subslice_ij(
-        wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
-        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
-  self->private_impl.f_output_ri = 0;
-  self->private_impl.f_output_wi = 0;
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_slow[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_decode_huffman_slow[0].v_bits;
+    v_n_bits = self->private_data.s_decode_huffman_slow[0].v_n_bits;
+    v_table_entry = self->private_data.s_decode_huffman_slow[0].v_table_entry;
+    v_table_entry_n_bits =
+        self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits;
+    v_lmask = self->private_data.s_decode_huffman_slow[0].v_lmask;
+    v_dmask = self->private_data.s_decode_huffman_slow[0].v_dmask;
+    v_redir_top = self->private_data.s_decode_huffman_slow[0].v_redir_top;
+    v_redir_mask = self->private_data.s_decode_huffman_slow[0].v_redir_mask;
+    v_length = self->private_data.s_decode_huffman_slow[0].v_length;
+    v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
+    v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
+    v_hdist = self->private_data.s_decode_huffman_slow[0].v_hdist;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  label__loop__continue:;
+    while (!(self->private_impl.p_decode_huffman_slow[0] != 0)) {
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        v_bits |= (v_b0 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__0__break:;
+      if ((v_table_entry >> 31) != 0) {
+        self->private_data.s_decode_huffman_slow[0].scratch =
+            ((uint8_t)(((v_table_entry >> 8) & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__1__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_1 = *iop_a_src++;
+            v_b1 = t_1;
+          }
+          v_bits |= (v_b1 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__1__break:;
+        if ((v_table_entry >> 31) != 0) {
+          self->private_data.s_decode_huffman_slow[0].scratch =
+              ((uint8_t)(((v_table_entry >> 8) & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (iop_a_dst == io2_a_dst) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+          goto label__loop__continue;
+        } else if ((v_table_entry >> 30) != 0) {
+        } else if ((v_table_entry >> 29) != 0) {
+          self->private_impl.f_end_of_block = true;
+          goto label__loop__break;
+        } else if ((v_table_entry >> 28) != 0) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        } else if ((v_table_entry >> 27) != 0) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        } else {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        }
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_length = (((v_table_entry >> 8) & 255) + 3);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_2 = *iop_a_src++;
+            v_b2 = t_2;
+          }
+          v_bits |= (v_b2 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_length = (((v_length + 253 +
+                      ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(
+                          v_table_entry_n_bits))) &
+                     255) +
+                    3);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__2__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__2__break:;
+      if ((v_table_entry >> 28) == 1) {
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__3__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_4 = *iop_a_src++;
+            v_b4 = t_4;
+          }
+          v_bits |= (v_b4 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__3__break:;
+      }
+      if ((v_table_entry >> 24) != 64) {
+        if ((v_table_entry >> 24) == 8) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        }
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_5 = *iop_a_src++;
+            v_b5 = t_5;
+          }
+          v_bits |= (v_b5 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_dist_minus_1 =
+            ((v_dist_minus_1 +
+              ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
+             32767);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                                 ((uint64_t)(iop_a_dst - io0_a_dst)))));
+          if (v_length > v_hdist) {
+            v_length -= v_hdist;
+            v_hlen = v_hdist;
+          } else {
+            v_hlen = v_length;
+            v_length = 0;
+          }
+          if (self->private_impl.f_history_index < v_hdist) {
+            status =
+                wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+            goto exit;
+          }
+          v_hdist = (self->private_impl.f_history_index - v_hdist);
+          while (true) {
+            v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                &iop_a_dst, io2_a_dst, v_hlen,
+                wuffs_base__slice_u8__subslice_ij(
+                    wuffs_base__make_slice_u8(self->private_data.f_history,
+                                              33025),
+                    (v_hdist & 32767), 32768));
+            if (v_hlen <= v_n_copied) {
+              v_hlen = 0;
+              goto label__4__break;
+            }
+            if (v_n_copied > 0) {
+              v_hlen -= v_n_copied;
+              v_hdist = ((v_hdist + v_n_copied) & 32767);
+              if (v_hdist == 0) {
+                goto label__4__break;
+              }
+            }
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+          }
+        label__4__break:;
+          if (v_hlen > 0) {
+            while (true) {
+              v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                  &iop_a_dst, io2_a_dst, v_hlen,
+                  wuffs_base__slice_u8__subslice_ij(
+                      wuffs_base__make_slice_u8(self->private_data.f_history,
+                                                33025),
+                      (v_hdist & 32767), 32768));
+              if (v_hlen <= v_n_copied) {
+                v_hlen = 0;
+                goto label__5__break;
+              }
+              v_hlen -= v_n_copied;
+              v_hdist += v_n_copied;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+            }
+          label__5__break:;
+          }
+          if (v_length == 0) {
+            goto label__loop__continue;
+          }
+        }
+        v_n_copied = wuffs_base__io_writer__copy_n32_from_history(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+        if (v_length <= v_n_copied) {
+          v_length = 0;
+          goto label__6__break;
+        }
+        v_length -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+      }
+    label__6__break:;
+    }
+  label__loop__break:;
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_huffman_slow[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_huffman_slow[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_slow[0].v_bits = v_bits;
+  self->private_data.s_decode_huffman_slow[0].v_n_bits = v_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry = v_table_entry;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits =
+      v_table_entry_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_lmask = v_lmask;
+  self->private_data.s_decode_huffman_slow[0].v_dmask = v_dmask;
+  self->private_data.s_decode_huffman_slow[0].v_redir_top = v_redir_top;
+  self->private_data.s_decode_huffman_slow[0].v_redir_mask = v_redir_mask;
+  self->private_data.s_decode_huffman_slow[0].v_length = v_length;
+  self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
+  self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
+  self->private_data.s_decode_huffman_slow[0].v_hdist = v_hdist;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.stats_decoder.decode_huffman_slow
+
+static wuffs_base__status  //
+wuffs_deflate__stats_decoder__decode_huffman_slow(
+    wuffs_deflate__stats_decoder* self,
+    wuffs_base__io_buffer* a_dst,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_table_entry = 0;
+  uint32_t v_table_entry_n_bits = 0;
+  uint32_t v_lmask = 0;
+  uint32_t v_dmask = 0;
+  uint32_t v_b0 = 0;
+  uint32_t v_redir_top = 0;
+  uint32_t v_redir_mask = 0;
+  uint32_t v_b1 = 0;
+  uint32_t v_length = 0;
+  uint32_t v_b2 = 0;
+  uint32_t v_b3 = 0;
+  uint32_t v_b4 = 0;
+  uint32_t v_dist_minus_1 = 0;
+  uint32_t v_b5 = 0;
+  uint32_t v_n_copied = 0;
+  uint32_t v_hlen = 0;
+  uint32_t v_hdist = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_huffman_slow[0];
+  if (coro_susp_point) {
+    v_bits = self->private_data.s_decode_huffman_slow[0].v_bits;
+    v_n_bits = self->private_data.s_decode_huffman_slow[0].v_n_bits;
+    v_table_entry = self->private_data.s_decode_huffman_slow[0].v_table_entry;
+    v_table_entry_n_bits =
+        self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits;
+    v_lmask = self->private_data.s_decode_huffman_slow[0].v_lmask;
+    v_dmask = self->private_data.s_decode_huffman_slow[0].v_dmask;
+    v_redir_top = self->private_data.s_decode_huffman_slow[0].v_redir_top;
+    v_redir_mask = self->private_data.s_decode_huffman_slow[0].v_redir_mask;
+    v_length = self->private_data.s_decode_huffman_slow[0].v_length;
+    v_dist_minus_1 = self->private_data.s_decode_huffman_slow[0].v_dist_minus_1;
+    v_hlen = self->private_data.s_decode_huffman_slow[0].v_hlen;
+    v_hdist = self->private_data.s_decode_huffman_slow[0].v_hdist;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    v_lmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[0]) - 1);
+    v_dmask = ((((uint32_t)(1)) << self->private_impl.f_n_huffs_bits[1]) - 1);
+  label__loop__continue:;
+    while (!(self->private_impl.p_decode_huffman_slow[0] != 0)) {
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[12], 1);
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[0][(v_bits & v_lmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_0 = *iop_a_src++;
+          v_b0 = t_0;
+        }
+        v_bits |= (v_b0 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__0__break:;
+      if ((v_table_entry >> 31) != 0) {
+        self->private_data.s_decode_huffman_slow[0].scratch =
+            ((uint8_t)(((v_table_entry >> 8) & 255)));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[6], 1);
+        goto label__loop__continue;
+      } else if ((v_table_entry >> 30) != 0) {
+      } else if ((v_table_entry >> 29) != 0) {
+        self->private_impl.f_end_of_block = true;
+        goto label__loop__break;
+      } else if ((v_table_entry >> 28) != 0) {
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[10], 1);
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[0][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__1__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_1 = *iop_a_src++;
+            v_b1 = t_1;
+          }
+          v_bits |= (v_b1 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__1__break:;
+        if ((v_table_entry >> 31) != 0) {
+          self->private_data.s_decode_huffman_slow[0].scratch =
+              ((uint8_t)(((v_table_entry >> 8) & 255)));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (iop_a_dst == io2_a_dst) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            goto suspend;
+          }
+          *iop_a_dst++ =
+              ((uint8_t)(self->private_data.s_decode_huffman_slow[0].scratch));
+          wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[6], 1);
+          goto label__loop__continue;
+        } else if ((v_table_entry >> 30) != 0) {
+        } else if ((v_table_entry >> 29) != 0) {
+          self->private_impl.f_end_of_block = true;
+          goto label__loop__break;
+        } else if ((v_table_entry >> 28) != 0) {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        } else if ((v_table_entry >> 27) != 0) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        } else {
+          status = wuffs_base__make_status(
+              wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+          goto exit;
+        }
+      } else if ((v_table_entry >> 27) != 0) {
+        status =
+            wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_length = (((v_table_entry >> 8) & 255) + 3);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_2 = *iop_a_src++;
+            v_b2 = t_2;
+          }
+          v_bits |= (v_b2 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_length = (((v_length + 253 +
+                      ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(
+                          v_table_entry_n_bits))) &
+                     255) +
+                    3);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      while (true) {
+        v_table_entry = self->private_data.f_huffs[1][(v_bits & v_dmask)];
+        v_table_entry_n_bits = (v_table_entry & 15);
+        if (v_n_bits >= v_table_entry_n_bits) {
+          v_bits >>= v_table_entry_n_bits;
+          v_n_bits -= v_table_entry_n_bits;
+          goto label__2__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint32_t t_3 = *iop_a_src++;
+          v_b3 = t_3;
+        }
+        v_bits |= (v_b3 << v_n_bits);
+        v_n_bits += 8;
+      }
+    label__2__break:;
+      if ((v_table_entry >> 28) == 1) {
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[10], 1);
+        v_redir_top = ((v_table_entry >> 8) & 65535);
+        v_redir_mask = ((((uint32_t)(1)) << ((v_table_entry >> 4) & 15)) - 1);
+        while (true) {
+          v_table_entry =
+              self->private_data
+                  .f_huffs[1][((v_redir_top + (v_bits & v_redir_mask)) & 1023)];
+          v_table_entry_n_bits = (v_table_entry & 15);
+          if (v_n_bits >= v_table_entry_n_bits) {
+            v_bits >>= v_table_entry_n_bits;
+            v_n_bits -= v_table_entry_n_bits;
+            goto label__3__break;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_4 = *iop_a_src++;
+            v_b4 = t_4;
+          }
+          v_bits |= (v_b4 << v_n_bits);
+          v_n_bits += 8;
+        }
+      label__3__break:;
+      }
+      if ((v_table_entry >> 24) != 64) {
+        if ((v_table_entry >> 24) == 8) {
+          status =
+              wuffs_base__make_status(wuffs_deflate__error__bad_huffman_code);
+          goto exit;
+        }
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_decoder_state);
+        goto exit;
+      }
+      v_dist_minus_1 = ((v_table_entry >> 8) & 32767);
+      v_table_entry_n_bits = ((v_table_entry >> 4) & 15);
+      if (v_table_entry_n_bits > 0) {
+        while (v_n_bits < v_table_entry_n_bits) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint32_t t_5 = *iop_a_src++;
+            v_b5 = t_5;
+          }
+          v_bits |= (v_b5 << v_n_bits);
+          v_n_bits += 8;
+        }
+        v_dist_minus_1 =
+            ((v_dist_minus_1 +
+              ((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U32(v_table_entry_n_bits))) &
+             32767);
+        v_bits >>= v_table_entry_n_bits;
+        v_n_bits -= v_table_entry_n_bits;
+      }
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[7], 1);
+      wuffs_base__u64__sat_add_indirect(&self->private_impl.f_stats[8],
+                                        ((uint64_t)(v_length)));
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_stats_lengths[v_length], 1);
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_stats_distances[v_table_entry_n_bits], 1);
+      while (true) {
+        if (((uint64_t)((v_dist_minus_1 + 1))) >
+            ((uint64_t)(iop_a_dst - io0_a_dst))) {
+          v_hdist = ((uint32_t)((((uint64_t)((v_dist_minus_1 + 1))) -
+                                 ((uint64_t)(iop_a_dst - io0_a_dst)))));
+          if (v_length > v_hdist) {
+            v_length -= v_hdist;
+            v_hlen = v_hdist;
+          } else {
+            v_hlen = v_length;
+            v_length = 0;
+          }
+          if (self->private_impl.f_history_index < v_hdist) {
+            status =
+                wuffs_base__make_status(wuffs_deflate__error__bad_distance);
+            goto exit;
+          }
+          v_hdist = (self->private_impl.f_history_index - v_hdist);
+          while (true) {
+            v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                &iop_a_dst, io2_a_dst, v_hlen,
+                wuffs_base__slice_u8__subslice_ij(
+                    wuffs_base__make_slice_u8(self->private_data.f_history,
+                                              33025),
+                    (v_hdist & 32767), 32768));
+            if (v_hlen <= v_n_copied) {
+              v_hlen = 0;
+              goto label__4__break;
+            }
+            if (v_n_copied > 0) {
+              v_hlen -= v_n_copied;
+              v_hdist = ((v_hdist + v_n_copied) & 32767);
+              if (v_hdist == 0) {
+                goto label__4__break;
+              }
+            }
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_write);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
+          }
+        label__4__break:;
+          if (v_hlen > 0) {
+            while (true) {
+              v_n_copied = wuffs_base__io_writer__copy_n32_from_slice(
+                  &iop_a_dst, io2_a_dst, v_hlen,
+                  wuffs_base__slice_u8__subslice_ij(
+                      wuffs_base__make_slice_u8(self->private_data.f_history,
+                                                33025),
+                      (v_hdist & 32767), 32768));
+              if (v_hlen <= v_n_copied) {
+                v_hlen = 0;
+                goto label__5__break;
+              }
+              v_hlen -= v_n_copied;
+              v_hdist += v_n_copied;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_write);
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+            }
+          label__5__break:;
+          }
+          if (v_length == 0) {
+            goto label__loop__continue;
+          }
+        }
+        v_n_copied = wuffs_base__io_writer__copy_n32_from_history(
+            &iop_a_dst, io0_a_dst, io2_a_dst, v_length, (v_dist_minus_1 + 1));
+        if (v_length <= v_n_copied) {
+          v_length = 0;
+          goto label__6__break;
+        }
+        v_length -= v_n_copied;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+      }
+    label__6__break:;
+    }
+  label__loop__break:;
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if ((self->private_impl.f_n_bits >= 8) ||
+        ((self->private_impl.f_bits >> (self->private_impl.f_n_bits & 7)) !=
+         0)) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_huffman_slow[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_huffman_slow[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_huffman_slow[0].v_bits = v_bits;
+  self->private_data.s_decode_huffman_slow[0].v_n_bits = v_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry = v_table_entry;
+  self->private_data.s_decode_huffman_slow[0].v_table_entry_n_bits =
+      v_table_entry_n_bits;
+  self->private_data.s_decode_huffman_slow[0].v_lmask = v_lmask;
+  self->private_data.s_decode_huffman_slow[0].v_dmask = v_dmask;
+  self->private_data.s_decode_huffman_slow[0].v_redir_top = v_redir_top;
+  self->private_data.s_decode_huffman_slow[0].v_redir_mask = v_redir_mask;
+  self->private_data.s_decode_huffman_slow[0].v_length = v_length;
+  self->private_data.s_decode_huffman_slow[0].v_dist_minus_1 = v_dist_minus_1;
+  self->private_data.s_decode_huffman_slow[0].v_hlen = v_hlen;
+  self->private_data.s_decode_huffman_slow[0].v_hdist = v_hdist;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.stats_decoder.stat
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__stat(const wuffs_deflate__stats_decoder* self,
+                                   uint32_t a_key) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (a_key < 16) {
+    return self->private_impl.f_stats[a_key];
+  }
+  return 0;
+}
+
+// -------- func deflate.stats_decoder.match_length_count
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__match_length_count(
+    const wuffs_deflate__stats_decoder* self,
+    uint32_t a_length) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (a_length <= 258) {
+    return self->private_impl.f_stats_lengths[a_length];
+  }
+  return 0;
+}
+
+// -------- func deflate.stats_decoder.match_distance_count
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_deflate__stats_decoder__match_distance_count(
+    const wuffs_deflate__stats_decoder* self,
+    uint32_t a_extra_bits) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (a_extra_bits < 16) {
+    return self->private_impl.f_stats_distances[a_extra_bits];
+  }
+  return 0;
+}
+
+// -------- func deflate.encoder.set_level
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_level(wuffs_deflate__encoder* self,
+                                  uint32_t a_level) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_level > 9) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_set_level_arg = (a_level + 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_deflate__encoder__workbuf_len(const wuffs_deflate__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func deflate.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_deflate__encoder__transform_io(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     wuffs_base__io_buffer* a_src,
+                                     wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_level = 0;
+  uint32_t v_i = 0;
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+  uint32_t v_m = 0;
+  bool v_eof = false;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_level = 6;
+    if (self->private_impl.f_set_level_arg > 0) {
+      v_level = (self->private_impl.f_set_level_arg - 1);
+    }
+    self->private_impl.f_level = v_level;
+    self->private_impl.f_good_length =
+        wuffs_deflate__level_good_lengths[v_level];
+    self->private_impl.f_max_lazy = wuffs_deflate__level_max_lazies[v_level];
+    self->private_impl.f_nice_length =
+        wuffs_deflate__level_nice_lengths[v_level];
+    self->private_impl.f_max_chain = wuffs_deflate__level_max_chains[v_level];
+    self->private_impl.f_bits = 0;
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_window_end = 0;
+    self->private_impl.f_pos = 0;
+    self->private_impl.f_token_pos = 0;
+    self->private_impl.f_block_start = 0;
+    self->private_impl.f_match_available = false;
+    self->private_impl.f_match_length = 2;
+    self->private_impl.f_match_distance_minus_1 = 0;
+    self->private_impl.f_n_tokens = 0;
+    wuffs_deflate__encoder__reset_freqs(self);
+    v_i = 0;
+    while (v_i < 32768) {
+      self->private_data.f_head[v_i] = 0;
+      v_i += 1;
+    }
+    while (true) {
+      if (self->private_impl.f_window_end < 65536) {
+        v_n = wuffs_base__u64__min(
+            ((uint64_t)(io2_a_src - iop_a_src)),
+            ((uint64_t)((65536 - self->private_impl.f_window_end))));
+        v_s = wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n);
+        v_n = wuffs_base__slice_u8__copy_from_slice(
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_window, 65536),
+                self->private_impl.f_window_end),
+            v_s);
+        v_m = (self->private_impl.f_window_end +
+               ((uint32_t)(wuffs_base__u64__min(v_n, 65536))));
+        self->private_impl.f_window_end = wuffs_base__u32__min(v_m, 65536);
+      }
+      v_eof = ((a_src && a_src->meta.closed) &&
+               (((uint64_t)(io2_a_src - iop_a_src)) == 0));
+      if (self->private_impl.f_level == 0) {
+        self->private_impl.f_pos = self->private_impl.f_window_end;
+        self->private_impl.f_token_pos = self->private_impl.f_window_end;
+      } else if (self->private_impl.f_level <= 3) {
+        wuffs_deflate__encoder__deflate_fast(self, v_eof);
+      } else {
+        wuffs_deflate__encoder__deflate_slow(self, v_eof);
+      }
+      if (self->private_impl.f_n_tokens >= 16384) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, false);
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_eof &&
+                 (self->private_impl.f_pos >=
+                  self->private_impl.f_window_end) &&
+                 !self->private_impl.f_match_available) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_block(self, a_dst, true);
+        if (status.repr) {
+          goto suspend;
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, 0, ((8 - self->private_impl.f_n_bits) & 7));
+        if (status.repr) {
+          goto suspend;
+        }
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      } else if (self->private_impl.f_window_end >= 65536) {
+        if (self->private_impl.f_block_start < 32768) {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          status = wuffs_deflate__encoder__write_block(self, a_dst, false);
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        wuffs_deflate__encoder__slide_window(self);
+      } else {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+      }
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func deflate.encoder.reset_freqs
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__reset_freqs(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 288) {
+    self->private_data.f_freqs[0][v_i] = 0;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    self->private_data.f_freqs[1][v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.slide_window
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__slide_window(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__slice_u8__subslice_j(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65536), 32768),
+      wuffs_base__slice_u8__subslice_i(
+          wuffs_base__make_slice_u8(self->private_data.f_window, 65536),
+          32768));
+  self->private_impl.f_window_end =
+      (wuffs_base__u32__max(self->private_impl.f_window_end, 32768) - 32768);
+  self->private_impl.f_pos =
+      (wuffs_base__u32__max(self->private_impl.f_pos, 32768) - 32768);
+  self->private_impl.f_token_pos =
+      (wuffs_base__u32__max(self->private_impl.f_token_pos, 32768) - 32768);
+  self->private_impl.f_block_start =
+      (wuffs_base__u32__max(self->private_impl.f_block_start, 32768) - 32768);
+  v_i = 0;
+  while (v_i < 32768) {
+    self->private_data.f_head[v_i] =
+        (wuffs_base__u16__max(self->private_data.f_head[v_i], 32768) - 32768);
+    self->private_data.f_prev[v_i] =
+        (wuffs_base__u16__max(self->private_data.f_prev[v_i], 32768) - 32768);
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.insert_hash
+
+static uint32_t  //
+wuffs_deflate__encoder__insert_hash(wuffs_deflate__encoder* self,
+                                    uint32_t a_p) {
+  uint32_t v_h = 0;
+  uint32_t v_c = 0;
+
+  v_h =
+      (((((uint32_t)(self->private_data.f_window[a_p])) |
+         (((uint32_t)(self->private_data.f_window[((a_p + 1) & 65535)])) << 8) |
+         (((uint32_t)(self->private_data.f_window[((a_p + 2) & 65535)]))
+          << 16)) *
+        506832829) >>
+       17);
+  v_c = ((uint32_t)(self->private_data.f_head[v_h]));
+  self->private_data.f_prev[(a_p & 32767)] = self->private_data.f_head[v_h];
+  self->private_data.f_head[v_h] = ((uint16_t)(a_p));
+  return v_c;
+}
+
+// -------- func deflate.encoder.longest_match
+
+static uint32_t  //
+wuffs_deflate__encoder__longest_match(wuffs_deflate__encoder* self,
+                                      uint32_t a_cur,
+                                      uint32_t a_cand,
+                                      uint32_t a_prev_length) {
+  uint32_t v_best_len = 0;
+  uint32_t v_max_len = 0;
+  uint32_t v_nice_len = 0;
+  uint32_t v_chain = 0;
+  uint32_t v_c = 0;
+  uint32_t v_dist_m1 = 0;
+  uint32_t v_len = 0;
+
+  if (self->private_impl.f_window_end <= a_cur) {
+    return a_prev_length;
+  }
+  v_max_len = (self->private_impl.f_window_end - a_cur);
+  v_max_len = wuffs_base__u32__min(v_max_len, 258);
+  v_best_len = a_prev_length;
+  if (v_best_len >= v_max_len) {
+    return v_best_len;
+  }
+  v_nice_len =
+      wuffs_base__u32__min(self->private_impl.f_nice_length, v_max_len);
+  v_chain = self->private_impl.f_max_chain;
+  if (v_best_len >= self->private_impl.f_good_length) {
+    v_chain >>= 2;
+  }
+  v_c = a_cand;
+  while (v_chain > 0) {
+    v_chain -= 1;
+    if (a_cur <= v_c) {
+      goto label__loop__break;
+    }
+    if ((v_c == 0) || ((a_cur - v_c) > 32767)) {
+      goto label__loop__break;
+    }
+    v_dist_m1 = ((a_cur - v_c) - 1);
+    if ((self->private_data.f_window[((v_c + v_best_len) & 65535)] ==
+         self->private_data.f_window[((a_cur + v_best_len) & 65535)]) &&
+        (self->private_data.f_window[v_c] ==
+         self->private_data.f_window[a_cur])) {
+      v_len = 1;
+      while ((v_len < v_max_len) && (v_len < 258)) {
+        if (self->private_data.f_window[((v_c + v_len) & 65535)] !=
+            self->private_data.f_window[((a_cur + v_len) & 65535)]) {
+          goto label__0__break;
+        }
+        v_len += 1;
+      }
+    label__0__break:;
+      if (v_best_len < v_len) {
+        v_best_len = v_len;
+        self->private_impl.f_match_distance_minus_1 = v_dist_m1;
+        if (v_best_len >= v_nice_len) {
+          goto label__loop__break;
+        }
+      }
+    }
+    v_c = ((uint32_t)(self->private_data.f_prev[(v_c & 32767)]));
+  }
+label__loop__break:;
+  return v_best_len;
+}
+
+// -------- func deflate.encoder.deflate_fast
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__deflate_fast(wuffs_deflate__encoder* self, bool a_eof) {
+  uint32_t v_limit = 0;
+  uint32_t v_hash_end = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_len = 0;
+  uint32_t v_match_end = 0;
+  uint32_t v_end = 0;
+  uint32_t v_p = 0;
+  uint32_t v_lit = 0;
+
+  v_limit = self->private_impl.f_window_end;
+  if (!a_eof) {
+    v_limit =
+        (wuffs_base__u32__max(self->private_impl.f_window_end, 262) - 262);
+  }
+  v_hash_end = (wuffs_base__u32__max(self->private_impl.f_window_end, 2) - 2);
+  while ((self->private_impl.f_pos < v_limit) &&
+         (self->private_impl.f_n_tokens < 16384)) {
+    v_pos = self->private_impl.f_pos;
+    v_len = 0;
+    if (v_pos < v_hash_end) {
+      v_cand = wuffs_deflate__encoder__insert_hash(self, v_pos);
+      if (v_cand > 0) {
+        v_len = wuffs_deflate__encoder__longest_match(self, v_pos, v_cand, 2);
+      }
+    }
+    if (v_len >= 3) {
+      self->private_data.f_tokens[self->private_impl.f_n_tokens] =
+          (2147483648 | ((v_len - 3) << 16) |
+           self->private_impl.f_match_distance_minus_1);
+      self->private_impl.f_n_tokens += 1;
+      self->private_data.f_freqs[0][(
+          257 + ((uint32_t)(wuffs_deflate__length_codes[(v_len - 3)])))] += 1;
+      self->private_data.f_freqs[1][wuffs_deflate__encoder__distance_code(
+          self, self->private_impl.f_match_distance_minus_1)] += 1;
+      v_match_end = (v_pos + v_len);
+      v_end =
+          wuffs_base__u32__min(v_match_end, self->private_impl.f_window_end);
+      if (v_len <= self->private_impl.f_max_lazy) {
+        v_p = (v_pos + 1);
+        while (v_p < v_end) {
+          if (v_p < v_hash_end) {
+            wuffs_deflate__encoder__insert_hash(self, v_p);
+          }
+          v_p += 1;
+        }
+      }
+      self->private_impl.f_pos = v_end;
+    } else {
+      v_lit = ((uint32_t)(self->private_data.f_window[v_pos]));
+      self->private_data.f_tokens[self->private_impl.f_n_tokens] = v_lit;
+      self->private_impl.f_n_tokens += 1;
+      self->private_data.f_freqs[0][v_lit] += 1;
+      self->private_impl.f_pos = (v_pos + 1);
+    }
+  }
+  self->private_impl.f_token_pos = self->private_impl.f_pos;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.deflate_slow
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__deflate_slow(wuffs_deflate__encoder* self, bool a_eof) {
+  uint32_t v_limit = 0;
+  uint32_t v_hash_end = 0;
+  uint32_t v_pos = 0;
+  uint32_t v_pos_m1 = 0;
+  uint32_t v_cand = 0;
+  uint32_t v_prev_len = 0;
+  uint32_t v_prev_dist = 0;
+  uint32_t v_len = 0;
+  uint32_t v_match_end = 0;
+  uint32_t v_end = 0;
+  uint32_t v_p = 0;
+  uint32_t v_lit = 0;
+
+  v_limit = self->private_impl.f_window_end;
+  if (!a_eof) {
+    v_limit =
+        (wuffs_base__u32__max(self->private_impl.f_window_end, 262) - 262);
+  }
+  v_hash_end = (wuffs_base__u32__max(self->private_impl.f_window_end, 2) - 2);
+  while ((self->private_impl.f_pos < v_limit) &&
+         (self->private_impl.f_n_tokens < 16384)) {
+    v_pos = self->private_impl.f_pos;
+    v_pos_m1 = (wuffs_base__u32__max(v_pos, 1) - 1);
+    v_prev_len = self->private_impl.f_match_length;
+    v_prev_dist = self->private_impl.f_match_distance_minus_1;
+    v_len = 2;
+    if (v_pos < v_hash_end) {
+      v_cand = wuffs_deflate__encoder__insert_hash(self, v_pos);
+      if ((v_cand > 0) && (v_prev_len < self->private_impl.f_max_lazy)) {
+        v_len = wuffs_deflate__encoder__longest_match(self, v_pos, v_cand,
+                                                      v_prev_len);
+        if ((v_len == 3) &&
+            (self->private_impl.f_match_distance_minus_1 >= 4096)) {
+          v_len = 2;
+        }
+      }
+    }
+    if ((v_prev_len >= 3) && (v_len <= v_prev_len)) {
+      self->private_data.f_tokens[self->private_impl.f_n_tokens] =
+          (2147483648 | ((v_prev_len - 3) << 16) | v_prev_dist);
+      self->private_impl.f_n_tokens += 1;
+      self->private_data.f_freqs[0][(
+          257 + ((uint32_t)(wuffs_deflate__length_codes[(v_prev_len - 3)])))] +=
+          1;
+      self->private_data.f_freqs[1][wuffs_deflate__encoder__distance_code(
+          self, v_prev_dist)] += 1;
+      v_match_end = (v_pos_m1 + v_prev_len);
+      v_end =
+          wuffs_base__u32__min(v_match_end, self->private_impl.f_window_end);
+      v_p = (v_pos + 1);
+      while (v_p < v_end) {
+        if (v_p < v_hash_end) {
+          wuffs_deflate__encoder__insert_hash(self, v_p);
+        }
+        v_p += 1;
+      }
+      self->private_impl.f_pos = v_end;
+      self->private_impl.f_match_available = false;
+      self->private_impl.f_match_length = 2;
+    } else {
+      if (self->private_impl.f_match_available) {
+        v_lit = ((uint32_t)(self->private_data.f_window[v_pos_m1]));
+        self->private_data.f_tokens[self->private_impl.f_n_tokens] = v_lit;
+        self->private_impl.f_n_tokens += 1;
+        self->private_data.f_freqs[0][v_lit] += 1;
+      }
+      self->private_impl.f_pos = (v_pos + 1);
+      self->private_impl.f_match_available = true;
+      self->private_impl.f_match_length = v_len;
+    }
+  }
+  if (a_eof && (self->private_impl.f_pos >= self->private_impl.f_window_end) &&
+      self->private_impl.f_match_available &&
+      (self->private_impl.f_n_tokens < 16384)) {
+    v_lit = ((uint32_t)(self->private_data.f_window[(
+        wuffs_base__u32__max(self->private_impl.f_pos, 1) - 1)]));
+    self->private_data.f_tokens[self->private_impl.f_n_tokens] = v_lit;
+    self->private_impl.f_n_tokens += 1;
+    self->private_data.f_freqs[0][v_lit] += 1;
+    self->private_impl.f_match_available = false;
+  }
+  self->private_impl.f_token_pos = self->private_impl.f_pos;
+  if (self->private_impl.f_match_available) {
+    self->private_impl.f_token_pos =
+        (wuffs_base__u32__max(self->private_impl.f_pos, 1) - 1);
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.distance_code
+
+static uint32_t  //
+wuffs_deflate__encoder__distance_code(const wuffs_deflate__encoder* self,
+                                      uint32_t a_d) {
+  if (a_d < 256) {
+    return ((uint32_t)(wuffs_deflate__distance_codes[a_d]));
+  }
+  return ((uint32_t)(wuffs_deflate__distance_codes[(256 + (a_d >> 7))]));
+}
+
+// -------- func deflate.encoder.write_bits
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_bits(wuffs_deflate__encoder* self,
+                                   wuffs_base__io_buffer* a_dst,
+                                   uint32_t a_b,
+                                   uint32_t a_n) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_bits[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_n_bits >= 32) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    self->private_impl.f_bits |=
+        (((uint64_t)((a_b & 65535))) << self->private_impl.f_n_bits);
+    self->private_impl.f_n_bits += a_n;
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_write_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_bits[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_bits[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.write_block
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_block(wuffs_deflate__encoder* self,
+                                    wuffs_base__io_buffer* a_dst,
+                                    bool a_final) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+  uint64_t v_f = 0;
+  uint32_t v_magic = 0;
+  uint32_t v_header = 0;
+  uint64_t v_extra_cost = 0;
+  uint64_t v_fixed_cost = 0;
+  uint64_t v_dynamic_cost = 0;
+  uint64_t v_stored_cost = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  uint32_t coro_susp_point = self->private_impl.p_write_block[0];
+  if (coro_susp_point) {
+    v_header = self->private_data.s_write_block[0].v_header;
+    v_stored_cost = self->private_data.s_write_block[0].v_stored_cost;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_token_pos < self->private_impl.f_block_start) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+      goto exit;
+    }
+    v_stored_cost =
+        (10 +
+         (8 * ((uint64_t)((self->private_impl.f_token_pos -
+                           self->private_impl.f_block_start)))) +
+         (32 * (1 + ((uint64_t)(((self->private_impl.f_token_pos -
+                                  self->private_impl.f_block_start) /
+                                 65535))))));
+    if (self->private_impl.f_level == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_deflate__encoder__write_stored(self, a_dst, a_final);
+      if (status.repr) {
+        goto suspend;
+      }
+      wuffs_deflate__encoder__reset_freqs(self);
+      self->private_impl.f_n_tokens = 0;
+      self->private_impl.f_block_start = self->private_impl.f_token_pos;
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    self->private_data.f_freqs[0][256] = 1;
+    v_status = wuffs_deflate__encoder__build_huffman(self, 0, 286, 15);
+    if (!wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_status = wuffs_deflate__encoder__build_huffman(self, 1, 30, 15);
+    if (!wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_status = wuffs_deflate__encoder__build_clsyms(self);
+    if (!wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    v_extra_cost = 0;
+    v_fixed_cost = 3;
+    v_dynamic_cost = (17 + (3 * ((uint64_t)(self->private_impl.f_hclen))));
+    v_i = 0;
+    while (v_i < 286) {
+      v_f = ((uint64_t)(self->private_data.f_freqs[0][v_i]));
+      v_dynamic_cost += (v_f * ((uint64_t)(self->private_impl.f_lens[0][v_i])));
+      if (v_i < 144) {
+        v_fixed_cost += (v_f * 8);
+      } else if (v_i < 256) {
+        v_fixed_cost += (v_f * 9);
+      } else if (v_i < 280) {
+        v_fixed_cost += (v_f * 7);
+      } else {
+        v_fixed_cost += (v_f * 8);
+      }
+      if (v_i >= 257) {
+        v_magic = wuffs_deflate__lcode_magic_numbers[((v_i - 257) & 31)];
+        v_extra_cost += (v_f * ((uint64_t)(((v_magic >> 4) & 15))));
+      }
+      v_i += 1;
+    }
+    v_i = 0;
+    while (v_i < 30) {
+      v_f = ((uint64_t)(self->private_data.f_freqs[1][v_i]));
+      v_dynamic_cost += (v_f * ((uint64_t)(self->private_impl.f_lens[1][v_i])));
+      v_fixed_cost += (v_f * 5);
+      v_magic = wuffs_deflate__dcode_magic_numbers[v_i];
+      v_extra_cost += (v_f * ((uint64_t)(((v_magic >> 4) & 15))));
+      v_i += 1;
+    }
+    v_i = 0;
+    while (v_i < 19) {
+      v_f = ((uint64_t)(self->private_data.f_freqs[2][v_i]));
+      v_dynamic_cost += (v_f * ((uint64_t)(self->private_impl.f_lens[2][v_i])));
+      v_i += 1;
+    }
+    v_dynamic_cost += (2 * ((uint64_t)(self->private_data.f_freqs[2][16])));
+    v_dynamic_cost += (3 * ((uint64_t)(self->private_data.f_freqs[2][17])));
+    v_dynamic_cost += (7 * ((uint64_t)(self->private_data.f_freqs[2][18])));
+    v_dynamic_cost += v_extra_cost;
+    v_fixed_cost += v_extra_cost;
+    v_header = 0;
+    if (a_final) {
+      v_header = 1;
+    }
+    if ((v_stored_cost <= v_fixed_cost) && (v_stored_cost <= v_dynamic_cost)) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_deflate__encoder__write_stored(self, a_dst, a_final);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (v_fixed_cost <= v_dynamic_cost) {
+      wuffs_deflate__encoder__set_fixed_codes(self);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status =
+          wuffs_deflate__encoder__write_bits(self, a_dst, (v_header + 2), 3);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_deflate__encoder__write_tokens(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else {
+      wuffs_deflate__encoder__assign_codes(self, 0, 286);
+      wuffs_deflate__encoder__assign_codes(self, 1, 30);
+      wuffs_deflate__encoder__assign_codes(self, 2, 19);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      status =
+          wuffs_deflate__encoder__write_bits(self, a_dst, (v_header + 4), 3);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      status = wuffs_deflate__encoder__write_dynamic_header(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      status = wuffs_deflate__encoder__write_tokens(self, a_dst);
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    wuffs_deflate__encoder__reset_freqs(self);
+    self->private_impl.f_n_tokens = 0;
+    self->private_impl.f_block_start = self->private_impl.f_token_pos;
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_block[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_block[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_block[0].v_header = v_header;
+  self->private_data.s_write_block[0].v_stored_cost = v_stored_cost;
+
+  goto exit;
+exit:
+  return status;
+}
+
+// -------- func deflate.encoder.write_stored
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_stored(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst,
+                                     bool a_final) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_p = 0;
+  uint32_t v_end = 0;
+  uint32_t v_m = 0;
+  uint32_t v_c = 0;
+  uint64_t v_n = 0;
+  uint32_t v_header = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_stored[0];
+  if (coro_susp_point) {
+    v_p = self->private_data.s_write_stored[0].v_p;
+    v_end = self->private_data.s_write_stored[0].v_end;
+    v_c = self->private_data.s_write_stored[0].v_c;
+    v_header = self->private_data.s_write_stored[0].v_header;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_p = self->private_impl.f_block_start;
+    while (true) {
+      if (self->private_impl.f_token_pos < v_p) {
+        status = wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_encoder_state);
+        goto exit;
+      }
+      v_end = (self->private_impl.f_token_pos - v_p);
+      v_c = wuffs_base__u32__min(v_end, 65535);
+      v_end = (v_p + v_c);
+      v_end = wuffs_base__u32__min(v_end, self->private_impl.f_token_pos);
+      v_header = 0;
+      if (a_final && (v_end >= self->private_impl.f_token_pos)) {
+        v_header = 1;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_deflate__encoder__write_bits(self, a_dst, v_header, 3);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, 0, ((8 - self->private_impl.f_n_bits) & 7));
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      status = wuffs_deflate__encoder__write_bits(self, a_dst, v_c, 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status =
+          wuffs_deflate__encoder__write_bits(self, a_dst, (65535 ^ v_c), 16);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      while (v_p < v_end) {
+        v_n = wuffs_base__io_writer__copy_from_slice(
+            &iop_a_dst, io2_a_dst,
+            wuffs_base__slice_u8__subslice_ij(
+                wuffs_base__make_slice_u8(self->private_data.f_window, 65536),
+                v_p, v_end));
+        v_m = (v_p + ((uint32_t)(wuffs_base__u64__min(v_n, 65535))));
+        v_p = wuffs_base__u32__min(v_m, v_end);
+        if (v_p < v_end) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+        }
+      }
+      if (v_end >= self->private_impl.f_token_pos) {
+        goto label__outer__break;
+      }
+    }
+  label__outer__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_stored[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_stored[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_stored[0].v_p = v_p;
+  self->private_data.s_write_stored[0].v_end = v_end;
+  self->private_data.s_write_stored[0].v_c = v_c;
+  self->private_data.s_write_stored[0].v_header = v_header;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.write_tokens
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_tokens(wuffs_deflate__encoder* self,
+                                     wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+  uint32_t v_t = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_len3 = 0;
+  uint32_t v_k = 0;
+  uint32_t v_d = 0;
+  uint32_t v_magic = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_tokens[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_write_tokens[0].v_i;
+    v_t = self->private_data.s_write_tokens[0].v_t;
+    v_len3 = self->private_data.s_write_tokens[0].v_len3;
+    v_k = self->private_data.s_write_tokens[0].v_k;
+    v_d = self->private_data.s_write_tokens[0].v_d;
+    v_magic = self->private_data.s_write_tokens[0].v_magic;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_n_bits >= 8) {
+      status = wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_n_bits);
+      goto exit;
+    }
+    v_bits = self->private_impl.f_bits;
+    v_n_bits = self->private_impl.f_n_bits;
+    v_i = 0;
+    while ((v_i < self->private_impl.f_n_tokens) &&
+           (((uint64_t)(io2_a_dst - iop_a_dst)) >= 8)) {
+      v_t = self->private_data.f_tokens[v_i];
+      if (v_t < 2147483648) {
+        v_bits |= (((uint64_t)(self->private_data.f_codes[0][(v_t & 255)]))
+                   << v_n_bits);
+        v_n_bits += ((uint32_t)(self->private_impl.f_lens[0][(v_t & 255)]));
+      } else {
+        v_len3 = ((v_t >> 16) & 255);
+        v_k = ((uint32_t)(wuffs_deflate__length_codes[v_len3]));
+        v_magic = wuffs_deflate__lcode_magic_numbers[v_k];
+        v_bits |= (((uint64_t)(self->private_data.f_codes[0][(257 + v_k)]))
+                   << v_n_bits);
+        v_n_bits += ((uint32_t)(self->private_impl.f_lens[0][(257 + v_k)]));
+        v_bits |= (((uint64_t)(((v_len3 - ((v_magic >> 8) & 255)) & 31)))
+                   << v_n_bits);
+        v_n_bits += ((v_magic >> 4) & 15);
+        if (v_n_bits >= 32) {
+          (wuffs_base__store_u32le__no_bounds_check(
+               iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+           iop_a_dst += 4, wuffs_base__make_empty_struct());
+          v_bits >>= 32;
+        } else {
+        }
+        v_n_bits &= 31;
+        v_d = (v_t & 32767);
+        v_k = wuffs_deflate__encoder__distance_code(self, v_d);
+        v_magic = wuffs_deflate__dcode_magic_numbers[v_k];
+        v_bits |=
+            (((uint64_t)(self->private_data.f_codes[1][v_k])) << v_n_bits);
+        v_n_bits += ((uint32_t)(self->private_impl.f_lens[1][v_k]));
+        v_bits |= (((uint64_t)(((v_d - ((v_magic >> 8) & 32767)) & 8191)))
+                   << v_n_bits);
+        v_n_bits += ((v_magic >> 4) & 15);
+      }
+      if (v_n_bits >= 32) {
+        (wuffs_base__store_u32le__no_bounds_check(
+             iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+         iop_a_dst += 4, wuffs_base__make_empty_struct());
+        v_bits >>= 32;
+      }
+      v_n_bits &= 31;
+      v_i += 1;
+    }
+    self->private_impl.f_bits = v_bits;
+    self->private_impl.f_n_bits = v_n_bits;
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_deflate__encoder__write_bits(self, a_dst, 0, 0);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    while (v_i < self->private_impl.f_n_tokens) {
+      v_t = self->private_data.f_tokens[v_i];
+      if (v_t < 2147483648) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst,
+            ((uint32_t)(self->private_data.f_codes[0][(v_t & 255)])),
+            ((uint32_t)(self->private_impl.f_lens[0][(v_t & 255)])));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else {
+        v_len3 = ((v_t >> 16) & 255);
+        v_k = ((uint32_t)(wuffs_deflate__length_codes[v_len3]));
+        v_magic = wuffs_deflate__lcode_magic_numbers[v_k];
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst,
+            ((uint32_t)(self->private_data.f_codes[0][(257 + v_k)])),
+            ((uint32_t)(self->private_impl.f_lens[0][(257 + v_k)])));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, ((v_len3 - ((v_magic >> 8) & 255)) & 31),
+            ((v_magic >> 4) & 15));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        v_d = (v_t & 32767);
+        v_k = wuffs_deflate__encoder__distance_code(self, v_d);
+        v_magic = wuffs_deflate__dcode_magic_numbers[v_k];
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, ((uint32_t)(self->private_data.f_codes[1][v_k])),
+            ((uint32_t)(self->private_impl.f_lens[1][v_k])));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        status = wuffs_deflate__encoder__write_bits(
+            self, a_dst, ((v_d - ((v_magic >> 8) & 32767)) & 8191),
+            ((v_magic >> 4) & 15));
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      v_i += 1;
+    }
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, ((uint32_t)(self->private_data.f_codes[0][256])),
+        ((uint32_t)(self->private_impl.f_lens[0][256])));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_tokens[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_tokens[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_tokens[0].v_i = v_i;
+  self->private_data.s_write_tokens[0].v_t = v_t;
+  self->private_data.s_write_tokens[0].v_len3 = v_len3;
+  self->private_data.s_write_tokens[0].v_k = v_k;
+  self->private_data.s_write_tokens[0].v_d = v_d;
+  self->private_data.s_write_tokens[0].v_magic = v_magic;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func deflate.encoder.write_dynamic_header
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__write_dynamic_header(wuffs_deflate__encoder* self,
+                                             wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+  uint32_t v_s = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_write_dynamic_header[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_write_dynamic_header[0].v_i;
+    v_s = self->private_data.s_write_dynamic_header[0].v_s;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, (self->private_impl.f_hlit - 257), 5);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, (self->private_impl.f_hdist - 1), 5);
+    if (status.repr) {
+      goto suspend;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_deflate__encoder__write_bits(
+        self, a_dst, (self->private_impl.f_hclen - 4), 4);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_i = 0;
+    while (v_i < self->private_impl.f_hclen) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst,
+          ((uint32_t)(self->private_impl
+                          .f_lens[2][wuffs_deflate__code_order[v_i]])),
+          3);
+      if (status.repr) {
+        goto suspend;
+      }
+      v_i += 1;
+    }
+    v_i = 0;
+    while (v_i < self->private_impl.f_n_clsyms) {
+      v_s = ((uint32_t)(self->private_data.f_clsyms[v_i]));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      status = wuffs_deflate__encoder__write_bits(
+          self, a_dst, ((uint32_t)(self->private_data.f_codes[2][(v_s & 31)])),
+          ((uint32_t)(self->private_impl.f_lens[2][(v_s & 31)])));
+      if (status.repr) {
+        goto suspend;
+      }
+      if ((v_s & 31) == 16) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        status = wuffs_deflate__encoder__write_bits(self, a_dst, (v_s >> 5), 2);
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if ((v_s & 31) == 17) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+        status = wuffs_deflate__encoder__write_bits(self, a_dst, (v_s >> 5), 3);
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if ((v_s & 31) == 18) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        status = wuffs_deflate__encoder__write_bits(self, a_dst, (v_s >> 5), 7);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      v_i += 1;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_dynamic_header[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_dynamic_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_dynamic_header[0].v_i = v_i;
+  self->private_data.s_write_dynamic_header[0].v_s = v_s;
+
+  goto exit;
+exit:
+  return status;
+}
+
+// -------- func deflate.encoder.set_fixed_codes
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__set_fixed_codes(wuffs_deflate__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 144) {
+    self->private_impl.f_lens[0][v_i] = 8;
+    v_i += 1;
+  }
+  while (v_i < 256) {
+    self->private_impl.f_lens[0][v_i] = 9;
+    v_i += 1;
+  }
+  while (v_i < 280) {
+    self->private_impl.f_lens[0][v_i] = 7;
+    v_i += 1;
+  }
+  while (v_i < 288) {
+    self->private_impl.f_lens[0][v_i] = 8;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < 30) {
+    self->private_impl.f_lens[1][v_i] = 5;
+    v_i += 1;
+  }
+  wuffs_deflate__encoder__assign_codes(self, 0, 288);
+  wuffs_deflate__encoder__assign_codes(self, 1, 30);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_clsyms
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__build_clsyms(wuffs_deflate__encoder* self) {
+  uint8_t v_all_lens[512] = {0};
+  uint32_t v_n = 0;
+  uint32_t v_total = 0;
+  uint32_t v_i = 0;
+  uint32_t v_l = 0;
+  uint32_t v_run = 0;
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+
+  self->private_impl.f_hlit = 286;
+  while (self->private_impl.f_hlit > 257) {
+    if (self->private_impl.f_lens[0][(self->private_impl.f_hlit - 1)] != 0) {
+      goto label__0__break;
+    }
+    self->private_impl.f_hlit -= 1;
+  }
+label__0__break:;
+  self->private_impl.f_hdist = 30;
+  while (self->private_impl.f_hdist > 1) {
+    if (self->private_impl.f_lens[1][(self->private_impl.f_hdist - 1)] != 0) {
+      goto label__1__break;
+    }
+    self->private_impl.f_hdist -= 1;
+  }
+label__1__break:;
+  v_n = self->private_impl.f_hlit;
+  v_i = 0;
+  while (v_i < v_n) {
+    v_all_lens[v_i] = self->private_impl.f_lens[0][v_i];
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < self->private_impl.f_hdist) {
+    v_all_lens[(v_n + v_i)] = self->private_impl.f_lens[1][v_i];
+    v_i += 1;
+  }
+  v_total = (v_n + self->private_impl.f_hdist);
+  v_i = 0;
+  while (v_i < 19) {
+    self->private_data.f_freqs[2][v_i] = 0;
+    v_i += 1;
+  }
+  self->private_impl.f_n_clsyms = 0;
+  v_i = 0;
+  while (v_i < v_total) {
+    v_l = ((uint32_t)(v_all_lens[(v_i & 511)]));
+    v_run = 1;
+    while (((v_i + v_run) < v_total) && (v_run < 138)) {
+      if (((uint32_t)(v_all_lens[((v_i + v_run) & 511)])) != v_l) {
+        goto label__2__break;
+      }
+      v_run += 1;
+    }
+  label__2__break:;
+    v_i += v_run;
+    if (v_l == 0) {
+      if (v_run >= 11) {
+        wuffs_deflate__encoder__append_clsym(self, (18 | ((v_run - 11) << 5)));
+        v_run = 0;
+      } else if (v_run >= 3) {
+        wuffs_deflate__encoder__append_clsym(self, (17 | ((v_run - 3) << 5)));
+        v_run = 0;
+      }
+    } else if (v_run >= 4) {
+      wuffs_deflate__encoder__append_clsym(self, v_l);
+      v_run -= 1;
+      while (v_run >= 3) {
+        if (v_run >= 6) {
+          wuffs_deflate__encoder__append_clsym(self, 112);
+          v_run -= 6;
+        } else {
+          wuffs_deflate__encoder__append_clsym(self, (16 | ((v_run - 3) << 5)));
+          v_run = 0;
+        }
+      }
+    }
+    while (v_run > 0) {
+      wuffs_deflate__encoder__append_clsym(self, v_l);
+      v_run -= 1;
+    }
+  }
+  v_status = wuffs_deflate__encoder__build_huffman(self, 2, 19, 7);
+  if (!wuffs_base__status__is_ok(&v_status)) {
+    return v_status;
+  }
+  self->private_impl.f_hclen = 19;
+  while (self->private_impl.f_hclen > 4) {
+    if (self->private_impl.f_lens[2][wuffs_deflate__code_order[(
+            self->private_impl.f_hclen - 1)]] != 0) {
+      goto label__3__break;
+    }
+    self->private_impl.f_hclen -= 1;
+  }
+label__3__break:;
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.encoder.append_clsym
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__append_clsym(wuffs_deflate__encoder* self,
+                                     uint32_t a_s) {
+  if (self->private_impl.f_n_clsyms < 320) {
+    self->private_data.f_clsyms[self->private_impl.f_n_clsyms] =
+        ((uint16_t)(a_s));
+    self->private_impl.f_n_clsyms += 1;
+  }
+  self->private_data.f_freqs[2][(a_s & 31)] += 1;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func deflate.encoder.build_huffman
+
+static wuffs_base__status  //
+wuffs_deflate__encoder__build_huffman(wuffs_deflate__encoder* self,
+                                      uint32_t a_which,
+                                      uint32_t a_n_codes,
+                                      uint32_t a_max_len) {
+  uint16_t v_syms[512] = {0};
+  uint32_t v_keys[512] = {0};
+  uint32_t v_num_codes[64] = {0};
+  uint32_t v_n = 0;
+  uint32_t v_i = 0;
+  uint32_t v_n_m1 = 0;
+  uint32_t v_n_m2 = 0;
+  uint32_t v_sym = 0;
+  uint32_t v_j = 0;
+  uint32_t v_f = 0;
+  uint32_t v_root = 0;
+  uint32_t v_leaf = 0;
+  uint32_t v_next = 0;
+  uint32_t v_avbl = 0;
+  uint32_t v_used = 0;
+  uint32_t v_depth = 0;
+  uint32_t v_k = 0;
+  uint32_t v_m = 0;
+  uint32_t v_total = 0;
+  uint32_t v_c = 0;
+
+  v_n = 0;
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    v_sym = v_i;
+    v_i += 1;
+    self->private_impl.f_lens[a_which][v_sym] = 0;
+    v_f = self->private_data.f_freqs[a_which][v_sym];
+    if (v_f > 0) {
+      if (v_n >= 288) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state);
+      }
+      v_j = v_n;
+      while (v_j > 0) {
+        if (v_keys[(v_j - 1)] <= v_f) {
+          goto label__0__break;
+        }
+        v_keys[v_j] = v_keys[(v_j - 1)];
+        v_syms[v_j] = v_syms[(v_j - 1)];
+        v_j -= 1;
+      }
+    label__0__break:;
+      v_keys[v_j] = v_f;
+      v_syms[v_j] = ((uint16_t)(v_sym));
+      if (v_n >= 288) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state);
+      }
+      v_n += 1;
+    }
+  }
+  if (v_n < 2) {
+    if (a_n_codes < 2) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state);
+    }
+    if (v_n == 0) {
+      self->private_impl.f_lens[a_which][0] = 1;
+      self->private_impl.f_lens[a_which][1] = 1;
+    } else if (v_syms[0] == 0) {
+      self->private_impl.f_lens[a_which][0] = 1;
+      self->private_impl.f_lens[a_which][1] = 1;
+    } else {
+      self->private_impl.f_lens[a_which][0] = 1;
+      self->private_impl.f_lens[a_which][v_syms[0]] = 1;
+    }
+    return wuffs_base__make_status(NULL);
+  }
+  v_n_m1 = (v_n - 1);
+  v_n_m2 = (v_n - 2);
+  v_keys[0] += v_keys[1];
+  v_root = 0;
+  v_leaf = 2;
+  v_next = 1;
+  while (v_next < v_n_m1) {
+    if ((v_leaf >= v_n) || (v_keys[v_root] < v_keys[v_leaf])) {
+      v_keys[v_next] = v_keys[v_root];
+      v_keys[v_root] = v_next;
+      v_root = ((v_root + 1) & 511);
+    } else {
+      v_keys[v_next] = v_keys[v_leaf];
+      v_leaf = ((v_leaf + 1) & 511);
+    }
+    if ((v_leaf >= v_n) ||
+        ((v_root < v_next) && (v_keys[v_root] < v_keys[v_leaf]))) {
+      v_keys[v_next] += v_keys[v_root];
+      v_keys[v_root] = v_next;
+      v_root = ((v_root + 1) & 511);
+    } else {
+      v_keys[v_next] += v_keys[v_leaf];
+      v_leaf = ((v_leaf + 1) & 511);
+    }
+    v_next = ((v_next + 1) & 511);
+  }
+  v_keys[v_n_m2] = 0;
+  v_next = v_n_m2;
+  while (v_next > 0) {
+    v_next -= 1;
+    v_keys[v_next] = (((v_keys[(v_keys[v_next] & 511)] & 511) + 1) & 511);
+  }
+  v_avbl = 1;
+  v_used = 0;
+  v_depth = 0;
+  v_root = v_n_m2;
+  v_next = v_n_m1;
+  while (v_avbl > 0) {
+    while (v_root < 511) {
+      if (v_keys[v_root] != v_depth) {
+        goto label__1__break;
+      }
+      v_used = ((v_used + 1) & 511);
+      if (v_root == 0) {
+        v_root = 511;
+        goto label__1__break;
+      }
+      v_root -= 1;
+    }
+  label__1__break:;
+    while ((v_avbl > v_used) && (v_avbl > 0)) {
+      v_keys[v_next] = v_depth;
+      v_next = ((v_next - 1) & 511);
+      v_avbl -= 1;
+    }
+    v_avbl = (2 * v_used);
+    v_depth = ((v_depth + 1) & 63);
+    v_used = 0;
+  }
+  v_k = 0;
+  while (v_k < 64) {
+    v_num_codes[v_k] = 0;
+    v_k += 1;
+  }
+  v_j = 0;
+  while (v_j < v_n) {
+    v_num_codes[wuffs_base__u32__min(v_keys[v_j], 32)] += 1;
+    v_j += 1;
+  }
+  v_k = (a_max_len + 1);
+  while (v_k <= 32) {
+    v_num_codes[a_max_len] += v_num_codes[v_k];
+    v_num_codes[v_k] = 0;
+    v_k += 1;
+  }
+  v_total = 0;
+  v_k = 1;
+  while (v_k <= 15) {
+    v_total += (v_num_codes[v_k] << (15 - v_k));
+    v_k += 1;
+  }
+  while (v_total != 32768) {
+    if (v_num_codes[a_max_len] <= 0) {
+      return wuffs_base__make_status(
+          wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state);
+    }
+    v_num_codes[a_max_len] -= 1;
+    v_m = (wuffs_base__u32__max(a_max_len, 1) - 1);
+    while (v_m > 0) {
+      if (v_num_codes[v_m] > 0) {
+        v_num_codes[v_m] -= 1;
+        v_num_codes[(v_m + 1)] += 2;
+        goto label__2__break;
+      }
+      v_m -= 1;
+    }
+  label__2__break:;
+    v_total -= (((uint32_t)(1)) << (15 - a_max_len));
+  }
+  v_j = v_n;
+  v_k = 1;
+  while (v_k <= 15) {
+    v_m = v_k;
+    v_c = v_num_codes[v_k];
+    v_k += 1;
+    while (v_c > 0) {
+      if (v_j <= 0) {
+        return wuffs_base__make_status(
+            wuffs_deflate__error__internal_error_inconsistent_huffman_encoder_state);
+      }
+      v_j -= 1;
+      self->private_impl.f_lens[a_which][v_syms[v_j]] = ((uint8_t)(v_m));
+      v_c -= 1;
+    }
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func deflate.encoder.assign_codes
+
+static wuffs_base__empty_struct  //
+wuffs_deflate__encoder__assign_codes(wuffs_deflate__encoder* self,
+                                     uint32_t a_which,
+                                     uint32_t a_n_codes) {
+  uint32_t v_counts[16] = {0};
+  uint32_t v_next_codes[16] = {0};
+  uint16_t v_out[288] = {0};
+  uint32_t v_i = 0;
+  uint32_t v_code = 0;
+  uint32_t v_len = 0;
+
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    v_counts[self->private_impl.f_lens[a_which][v_i]] += 1;
+    v_i += 1;
+  }
+  v_counts[0] = 0;
+  v_code = 0;
+  v_i = 0;
+  while (v_i < 15) {
+    v_code = ((v_code + v_counts[v_i]) << 1);
+    v_next_codes[(v_i + 1)] = v_code;
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    v_len = ((uint32_t)(self->private_impl.f_lens[a_which][v_i]));
+    v_code = v_next_codes[v_len];
+    v_next_codes[v_len] = (v_code + 1);
+    v_out[v_i] = ((uint16_t)((
+        ((((uint32_t)(wuffs_deflate__reverse8[(v_code & 255)])) << 8) |
+         ((uint32_t)(wuffs_deflate__reverse8[((v_code >> 8) & 255)]))) >>
+        (16 - v_len))));
+    v_i += 1;
+  }
+  v_i = 0;
+  while (v_i < a_n_codes) {
+    self->private_data.f_codes[a_which][v_i] = v_out[v_i];
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__DEFLATE)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
+
+// ---------------- Status Codes Implementations
+
+const char* wuffs_lzw__error__bad_code = "#lzw: bad code";
+const char* wuffs_lzw__error__internal_error_inconsistent_i_o =
+    "#lzw: internal error: inconsistent I/O";
+const char* wuffs_lzw__error__bad_literal = "#lzw: bad literal";
+
+// ---------------- Private Consts
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
+                              wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__reset_table(wuffs_lzw__encoder* self);
+
+static wuffs_base__status  //
+wuffs_lzw__encoder__flush_bits(wuffs_lzw__encoder* self,
+                               wuffs_base__io_buffer* a_dst);
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__write_codes(wuffs_lzw__encoder* self,
+                                wuffs_base__io_buffer* a_dst,
+                                wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__add_code(wuffs_lzw__encoder* self, uint32_t a_code);
+
+// ---------------- VTables
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_lzw__decoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_lzw__decoder__workbuf_len),
+};
+
+const wuffs_base__io_transformer__func_ptrs
+    wuffs_lzw__encoder__func_ptrs_for__wuffs_base__io_transformer = {
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__slice_u8))(
+            &wuffs_lzw__encoder__transform_io),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_lzw__encoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_lzw__decoder__initialize(wuffs_lzw__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_lzw__decoder() {
+  return sizeof(wuffs_lzw__decoder);
+}
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_lzw__encoder__initialize(wuffs_lzw__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_lzw__encoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_lzw__encoder() {
+  return sizeof(wuffs_lzw__encoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func lzw.decoder.set_literal_width
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__decoder__set_literal_width(wuffs_lzw__decoder* self, uint32_t a_lw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__decoder__workbuf_len(const wuffs_lzw__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func lzw.decoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_lzw__decoder__transform_io(wuffs_lzw__decoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_literal_width = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      self->private_impl.f_literal_width =
+          (self->private_impl.f_set_literal_width_arg - 1);
+    }
+    self->private_impl.f_clear_code =
+        (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_save_code = self->private_impl.f_end_code;
+    self->private_impl.f_prev_code = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    self->private_impl.f_bits = 0;
+    self->private_impl.f_n_bits = 0;
+    self->private_impl.f_output_ri = 0;
+    self->private_impl.f_output_wi = 0;
+    v_i = 0;
+    while (v_i < self->private_impl.f_clear_code) {
+      self->private_data.f_lm1s[v_i] = 0;
+      self->private_data.f_suffixes[v_i][0] = ((uint8_t)(v_i));
+      v_i += 1;
+    }
+  label__0__continue:;
+    while (true) {
+      wuffs_lzw__decoder__read_from(self, a_src);
+      if (self->private_impl.f_output_wi > 0) {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_lzw__decoder__write_to(self, a_dst);
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (self->private_impl.f_read_from_return_value == 0) {
+        goto label__0__break;
+      } else if (self->private_impl.f_read_from_return_value == 1) {
+        goto label__0__continue;
+      } else if (self->private_impl.f_read_from_return_value == 2) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      } else if (self->private_impl.f_read_from_return_value == 3) {
+        status = wuffs_base__make_status(wuffs_lzw__error__bad_code);
+        goto exit;
+      } else {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+    }
+  label__0__break:;
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func lzw.decoder.read_from
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__decoder__read_from(wuffs_lzw__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
+  uint32_t v_clear_code = 0;
+  uint32_t v_end_code = 0;
+  uint32_t v_save_code = 0;
+  uint32_t v_prev_code = 0;
+  uint32_t v_width = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_output_wi = 0;
+  uint32_t v_code = 0;
+  uint32_t v_c = 0;
+  uint32_t v_o = 0;
+  uint32_t v_steps = 0;
+  uint8_t v_first_byte = 0;
+  uint16_t v_lm1_b = 0;
+  uint16_t v_lm1_a = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_clear_code = self->private_impl.f_clear_code;
+  v_end_code = self->private_impl.f_end_code;
+  v_save_code = self->private_impl.f_save_code;
+  v_prev_code = self->private_impl.f_prev_code;
+  v_width = self->private_impl.f_width;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  v_output_wi = self->private_impl.f_output_wi;
+  while (true) {
+    if (v_n_bits < v_width) {
+      if (((uint64_t)(io2_a_src - iop_a_src)) >= 8) {
+        v_bits |=
+            (wuffs_base__load_u64le__no_bounds_check(iop_a_src) << v_n_bits);
+        (iop_a_src += ((63 - v_n_bits) >> 3), wuffs_base__make_empty_struct());
+        v_n_bits |= 56;
+      } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        self->private_impl.f_read_from_return_value = 2;
+        goto label__0__break;
+      } else {
+        v_bits |=
+            (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+             << v_n_bits);
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        v_n_bits += 8;
+        if (v_n_bits >= v_width) {
+        } else if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          self->private_impl.f_read_from_return_value = 2;
+          goto label__0__break;
+        } else {
+          v_bits |=
+              (((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)))
+               << v_n_bits);
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+          v_n_bits += 8;
+          if (v_n_bits < v_width) {
+            self->private_impl.f_read_from_return_value = 4;
+            goto label__0__break;
+          }
+        }
+      }
+    }
+    v_code = ((uint32_t)(((v_bits)&WUFFS_BASE__LOW_BITS_MASK__U64(v_width))));
+    v_bits >>= v_width;
+    v_n_bits -= v_width;
+    if (v_code < v_clear_code) {
+      self->private_data.f_output[v_output_wi] = ((uint8_t)(v_code));
+      v_output_wi = ((v_output_wi + 1) & 8191);
+      if (v_save_code <= 4095) {
+        v_lm1_a = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_a;
+        if ((v_lm1_a % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_a % 8)] =
+              ((uint8_t)(v_code));
+        } else {
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] = ((uint8_t)(v_code));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
+      }
+    } else if (v_code <= v_end_code) {
+      if (v_code == v_end_code) {
+        self->private_impl.f_read_from_return_value = 0;
+        goto label__0__break;
+      }
+      v_save_code = v_end_code;
+      v_prev_code = v_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+    } else if (v_code <= v_save_code) {
+      v_c = v_code;
+      if (v_code == v_save_code) {
+        v_c = v_prev_code;
+      }
+      v_o = ((v_output_wi +
+              (((uint32_t)(self->private_data.f_lm1s[v_c])) & 4294967288)) &
+             8191);
+      v_output_wi =
+          ((v_output_wi + 1 + ((uint32_t)(self->private_data.f_lm1s[v_c]))) &
+           8191);
+      v_steps = (((uint32_t)(self->private_data.f_lm1s[v_c])) >> 3);
+      while (true) {
+        memcpy((self->private_data.f_output) + (v_o),
+               (self->private_data.f_suffixes[v_c]), 8);
+        if (v_steps <= 0) {
+          goto label__1__break;
+        }
+        v_steps -= 1;
+        v_o = ((v_o - 8) & 8191);
+        v_c = ((uint32_t)(self->private_impl.f_prefixes[v_c]));
+      }
+    label__1__break:;
+      v_first_byte = self->private_data.f_suffixes[v_c][0];
+      if (v_code == v_save_code) {
+        self->private_data.f_output[v_output_wi] = v_first_byte;
+        v_output_wi = ((v_output_wi + 1) & 8191);
+      }
+      if (v_save_code <= 4095) {
+        v_lm1_b = ((self->private_data.f_lm1s[v_prev_code] + 1) & 4095);
+        self->private_data.f_lm1s[v_save_code] = v_lm1_b;
+        if ((v_lm1_b % 8) != 0) {
+          self->private_impl.f_prefixes[v_save_code] =
+              self->private_impl.f_prefixes[v_prev_code];
+          memcpy(self->private_data.f_suffixes[v_save_code],
+                 self->private_data.f_suffixes[v_prev_code],
+                 sizeof(self->private_data.f_suffixes[v_save_code]));
+          self->private_data.f_suffixes[v_save_code][(v_lm1_b % 8)] =
+              v_first_byte;
+        } else {
+          self->private_impl.f_prefixes[v_save_code] =
+              ((uint16_t)(v_prev_code));
+          self->private_data.f_suffixes[v_save_code][0] =
+              ((uint8_t)(v_first_byte));
+        }
+        v_save_code += 1;
+        if (v_width < 12) {
+          v_width += (1 & (v_save_code >> v_width));
+        }
+        v_prev_code = v_code;
+      }
+    } else {
+      self->private_impl.f_read_from_return_value = 3;
+      goto label__0__break;
+    }
+    if (v_output_wi > 4095) {
+      self->private_impl.f_read_from_return_value = 1;
+      goto label__0__break;
+    }
+  }
+label__0__break:;
+  if (self->private_impl.f_read_from_return_value != 2) {
+    while (v_n_bits >= 8) {
+      v_n_bits -= 8;
+      if (iop_a_src > io1_a_src) {
+        (iop_a_src--, wuffs_base__make_empty_struct());
+      } else {
+        self->private_impl.f_read_from_return_value = 4;
+        goto label__2__break;
+      }
+    }
+  label__2__break:;
+  }
+  self->private_impl.f_save_code = v_save_code;
+  self->private_impl.f_prev_code = v_prev_code;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  self->private_impl.f_output_wi = v_output_wi;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.decoder.write_to
+
+static wuffs_base__status  //
+wuffs_lzw__decoder__write_to(wuffs_lzw__decoder* self,
+                             wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  wuffs_base__slice_u8 v_s = {0};
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_to[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_output_wi > 0) {
+      if (self->private_impl.f_output_ri > self->private_impl.f_output_wi) {
+        status = wuffs_base__make_status(
+            wuffs_lzw__error__internal_error_inconsistent_i_o);
+        goto exit;
+      }
+      v_s = wuffs_base__slice_u8__subslice_ij(
+          wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
+          self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+      v_n = wuffs_base__io_writer__copy_from_slice(&iop_a_dst, io2_a_dst, v_s);
+      if (v_n == ((uint64_t)(v_s.len))) {
+        self->private_impl.f_output_ri = 0;
+        self->private_impl.f_output_wi = 0;
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_impl.f_output_ri =
+          ((self->private_impl.f_output_ri + ((uint32_t)((v_n & 4294967295)))) &
+           8191);
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_to[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_to[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func lzw.decoder.flush
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__slice_u8  //
+wuffs_lzw__decoder__flush(wuffs_lzw__decoder* self) {
+  if (!self) {
+    return wuffs_base__make_slice_u8(NULL, 0);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_slice_u8(NULL, 0);
+  }
+
+  wuffs_base__slice_u8 v_s = {0};
+
+  if (self->private_impl.f_output_ri <= self->private_impl.f_output_wi) {
+    v_s = wuffs_base__slice_u8__subslice_ij(
+        wuffs_base__make_slice_u8(self->private_data.f_output, 8199),
+        self->private_impl.f_output_ri, self->private_impl.f_output_wi);
+  }
+  self->private_impl.f_output_ri = 0;
+  self->private_impl.f_output_wi = 0;
   return v_s;
 }
 
+// -------- func lzw.encoder.set_literal_width
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_lzw__encoder__set_literal_width(wuffs_lzw__encoder* self, uint32_t a_lw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (a_lw > 8) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_set_literal_width_arg = (a_lw + 1);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.encoder.workbuf_len
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_lzw__encoder__workbuf_len(const wuffs_lzw__encoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func lzw.encoder.transform_io
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_lzw__encoder__transform_io(wuffs_lzw__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__slice_u8 a_workbuf) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_literal = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    self->private_impl.f_literal_width = 8;
+    if (self->private_impl.f_set_literal_width_arg > 0) {
+      self->private_impl.f_literal_width =
+          (self->private_impl.f_set_literal_width_arg - 1);
+    }
+    self->private_impl.f_clear_code =
+        (((uint32_t)(1)) << self->private_impl.f_literal_width);
+    self->private_impl.f_end_code = (self->private_impl.f_clear_code + 1);
+    self->private_impl.f_save_code = self->private_impl.f_end_code;
+    self->private_impl.f_width = (self->private_impl.f_literal_width + 1);
+    self->private_impl.f_prefix = 0;
+    self->private_impl.f_has_prefix = false;
+    self->private_impl.f_bits = ((uint64_t)(self->private_impl.f_clear_code));
+    self->private_impl.f_n_bits = self->private_impl.f_width;
+    wuffs_lzw__encoder__reset_table(self);
+  label__0__continue:;
+    while (true) {
+      if (self->private_impl.f_n_bits >= 8) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      }
+      if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        if (a_src && a_src->meta.closed) {
+          goto label__0__break;
+        }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+        goto label__0__continue;
+      }
+      v_literal =
+          ((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (v_literal >= self->private_impl.f_clear_code) {
+        status = wuffs_base__make_status(wuffs_lzw__error__bad_literal);
+        goto exit;
+      }
+      if (!self->private_impl.f_has_prefix) {
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_prefix = v_literal;
+        self->private_impl.f_has_prefix = true;
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
+      wuffs_lzw__encoder__write_codes(self, a_dst, a_src);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+    }
+  label__0__break:;
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_has_prefix) {
+      wuffs_lzw__encoder__add_code(self, self->private_impl.f_prefix);
+      if (self->private_impl.f_save_code <= 4095) {
+        self->private_impl.f_save_code += 1;
+        if (self->private_impl.f_width < 12) {
+          self->private_impl.f_width += (1 & (self->private_impl.f_save_code >>
+                                              self->private_impl.f_width));
+        }
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+    }
+    wuffs_lzw__encoder__add_code(self, self->private_impl.f_end_code);
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+    status = wuffs_lzw__encoder__flush_bits(self, a_dst);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_n_bits > 0) {
+      self->private_data.s_transform_io[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_transform_io[0].scratch));
+      self->private_impl.f_bits = 0;
+      self->private_impl.f_n_bits = 0;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_transform_io[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_transform_io[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func lzw.encoder.reset_table
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__reset_table(wuffs_lzw__encoder* self) {
+  uint32_t v_i = 0;
+
+  v_i = 0;
+  while (v_i < 16384) {
+    self->private_data.f_entries[v_i] = 0;
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.encoder.flush_bits
+
+static wuffs_base__status  //
+wuffs_lzw__encoder__flush_bits(wuffs_lzw__encoder* self,
+                               wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_flush_bits[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (self->private_impl.f_n_bits >= 8) {
+      self->private_data.s_flush_bits[0].scratch =
+          ((uint8_t)((self->private_impl.f_bits & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
+      }
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_flush_bits[0].scratch));
+      self->private_impl.f_bits >>= 8;
+      self->private_impl.f_n_bits -= 8;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_flush_bits[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_flush_bits[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func lzw.encoder.write_codes
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__write_codes(wuffs_lzw__encoder* self,
+                                wuffs_base__io_buffer* a_dst,
+                                wuffs_base__io_buffer* a_src) {
+  uint32_t v_clear_code = 0;
+  uint32_t v_save_code = 0;
+  uint32_t v_width = 0;
+  uint32_t v_prefix = 0;
+  uint64_t v_bits = 0;
+  uint32_t v_n_bits = 0;
+  uint32_t v_literal = 0;
+  uint32_t v_key = 0;
+  uint32_t v_h = 0;
+  uint32_t v_t = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  v_clear_code = self->private_impl.f_clear_code;
+  v_save_code = self->private_impl.f_save_code;
+  v_width = self->private_impl.f_width;
+  v_prefix = self->private_impl.f_prefix;
+  v_bits = self->private_impl.f_bits;
+  v_n_bits = self->private_impl.f_n_bits;
+  if (v_n_bits >= 32) {
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    return wuffs_base__make_empty_struct();
+  }
+label__loop__continue:;
+  while (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+    v_literal = ((uint32_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+    if (v_literal >= v_clear_code) {
+      goto label__loop__break;
+    }
+    (iop_a_src += 1, wuffs_base__make_empty_struct());
+    v_key = ((v_prefix << 8) | v_literal);
+    v_h = (((v_key >> 12) ^ v_key) & 16383);
+    while (true) {
+      v_t = self->private_data.f_entries[v_h];
+      if (v_t == 0) {
+        goto label__0__break;
+      } else if ((v_t >> 12) == v_key) {
+        v_prefix = (v_t & 4095);
+        goto label__loop__continue;
+      }
+      v_h = ((v_h + 1) & 16383);
+    }
+  label__0__break:;
+    v_bits |= (((uint64_t)(v_prefix)) << v_n_bits);
+    v_n_bits += v_width;
+    v_prefix = v_literal;
+    if (v_save_code <= 4095) {
+      v_save_code += 1;
+      if (v_width < 12) {
+        v_width += (1 & (v_save_code >> v_width));
+      }
+    }
+    if (v_save_code < 4095) {
+      self->private_data.f_entries[v_h] = ((v_key << 12) | v_save_code);
+    } else {
+      v_bits |= (((uint64_t)(v_clear_code)) << v_n_bits);
+      v_n_bits += v_width;
+      v_save_code = self->private_impl.f_end_code;
+      v_width = (self->private_impl.f_literal_width + 1);
+      wuffs_lzw__encoder__reset_table(self);
+    }
+    if (v_n_bits >= 32) {
+      if (((uint64_t)(io2_a_dst - iop_a_dst)) < 4) {
+        goto label__loop__break;
+      }
+      (wuffs_base__store_u32le__no_bounds_check(
+           iop_a_dst, ((uint32_t)((v_bits & 4294967295)))),
+       iop_a_dst += 4, wuffs_base__make_empty_struct());
+      v_bits >>= 32;
+    }
+    v_n_bits &= 31;
+  }
+label__loop__break:;
+  self->private_impl.f_save_code = v_save_code;
+  self->private_impl.f_width = v_width;
+  self->private_impl.f_prefix = v_prefix;
+  self->private_impl.f_bits = v_bits;
+  self->private_impl.f_n_bits = v_n_bits;
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func lzw.encoder.add_code
+
+static wuffs_base__empty_struct  //
+wuffs_lzw__encoder__add_code(wuffs_lzw__encoder* self, uint32_t a_code) {
+  if (self->private_impl.f_n_bits < 8) {
+    self->private_impl.f_bits |=
+        (((uint64_t)(a_code)) << self->private_impl.f_n_bits);
+    self->private_impl.f_n_bits += self->private_impl.f_width;
+  }
+  return wuffs_base__make_empty_struct();
+}
+
 #endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__LZW)
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
@@ -14843,351 +23070,787 @@ static const uint8_t              //
         78, 69, 84, 83, 67, 65, 80, 69, 50, 46, 48,
 };
 
-static const uint8_t            //
-    wuffs_gif__iccrgbg1012[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
-};
+static const uint8_t            //
+    wuffs_gif__iccrgbg1012[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        73, 67, 67, 82, 71, 66, 71, 49, 48, 49, 50,
+};
+
+static const uint8_t           //
+    wuffs_gif__xmpdataxmp[11]  //
+    WUFFS_BASE__POTENTIALLY_UNUSED = {
+        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
+};
+
+// ---------------- Private Initializer Prototypes
+
+// ---------------- Private Function Prototypes
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
+                                         wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
+
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
+                                     wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
+                                wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
+                                    wuffs_base__io_buffer* a_src);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__pixel_blend a_blend);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__slice_u8 a_workbuf);
+
+static wuffs_base__status  //
+wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
+                                         wuffs_base__pixel_buffer* a_pb,
+                                         wuffs_base__slice_u8 a_src);
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_le(wuffs_gif__encoder* self,
+                             wuffs_base__io_buffer* a_dst,
+                             uint32_t a_n,
+                             uint64_t a_x);
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_block(wuffs_gif__encoder* self,
+                                wuffs_base__io_buffer* a_dst);
+
+// ---------------- VTables
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__config_decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__config_decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__config_decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__config_decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__config_decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__config_decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__config_decoder__workbuf_len),
+};
+
+const wuffs_base__image_decoder__func_ptrs
+    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
+        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__ack_metadata_chunk),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__pixel_buffer*,
+                               wuffs_base__io_buffer*,
+                               wuffs_base__pixel_blend,
+                               wuffs_base__slice_u8,
+                               wuffs_base__decode_frame_options*))(
+            &wuffs_gif__decoder__decode_frame),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__frame_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_frame_config),
+        (wuffs_base__status(*)(void*,
+                               wuffs_base__image_config*,
+                               wuffs_base__io_buffer*))(
+            &wuffs_gif__decoder__decode_image_config),
+        (wuffs_base__rect_ie_u32(*)(const void*))(
+            &wuffs_gif__decoder__frame_dirty_rect),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
+        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
+        (uint64_t(*)(const void*))(
+            &wuffs_gif__decoder__num_decoded_frame_configs),
+        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
+        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
+            &wuffs_gif__decoder__restart_frame),
+        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
+            &wuffs_gif__decoder__set_report_metadata),
+        (wuffs_base__range_ii_u64(*)(const void*))(
+            &wuffs_gif__decoder__workbuf_len),
+};
+
+// ---------------- Initializer Implementations
+
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
+                                      size_t sizeof_star_self,
+                                      uint64_t wuffs_version,
+                                      uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
+
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
+
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
 
-static const uint8_t           //
-    wuffs_gif__xmpdataxmp[11]  //
-    WUFFS_BASE__POTENTIALLY_UNUSED = {
-        88, 77, 80, 32, 68, 97, 116, 97, 88, 77, 80,
-};
+size_t  //
+sizeof__wuffs_gif__config_decoder() {
+  return sizeof(wuffs_gif__config_decoder);
+}
 
-// ---------------- Private Initializer Prototypes
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
 
-// ---------------- Private Function Prototypes
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+  {
+    wuffs_base__status z = wuffs_lzw__decoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
+      wuffs_base__image_decoder__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
+      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
+  return wuffs_base__make_status(NULL);
+}
 
-static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self);
+size_t  //
+sizeof__wuffs_gif__decoder() {
+  return sizeof(wuffs_gif__decoder);
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src);
+wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
+wuffs_gif__encoder__initialize(wuffs_gif__encoder* self,
+                               size_t sizeof_star_self,
+                               uint64_t wuffs_version,
+                               uint32_t initialize_flags) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (sizeof(*self) != sizeof_star_self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  }
+  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
+      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+  }
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src);
+  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
+// The whole point of this if-check is to detect an uninitialized *self.
+// We disable the warning on GCC. Clang-5.0 does not have this warning.
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    if (self->private_impl.magic != 0) {
+      return wuffs_base__make_status(
+          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
+    }
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+  } else {
+    if ((initialize_flags &
+         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
+      memset(self, 0, sizeof(*self));
+      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
+    } else {
+      memset(&(self->private_impl), 0, sizeof(self->private_impl));
+    }
+  }
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src);
+  {
+    wuffs_base__status z = wuffs_lzw__encoder__initialize(
+        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  return wuffs_base__make_status(NULL);
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src);
+size_t  //
+sizeof__wuffs_gif__encoder() {
+  return sizeof(wuffs_gif__encoder);
+}
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src);
+// ---------------- Function Implementations
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+// -------- func gif.config_decoder.set_quirk_enabled
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
+                                             uint32_t a_quirk,
+                                             bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src);
+  if (self->private_impl.f_call_sequence == 0) {
+    if (a_quirk == 1041635328) {
+      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
+    } else if (a_quirk == 1041635329) {
+      self->private_impl
+          .f_quirk_enabled_first_frame_local_palette_means_black_background =
+          a_enabled;
+    } else if (a_quirk == 1041635330) {
+      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
+    } else if (a_quirk == 1041635331) {
+      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
+    } else if (a_quirk == 1041635332) {
+      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
+    } else if (a_quirk == 1041635333) {
+      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
+    } else if (a_quirk == 1041635334) {
+      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
+// -------- func gif.config_decoder.decode_image_config
 
-static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__image_config* a_dst,
+                                               wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src);
+  bool v_ffio = false;
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src);
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src);
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__config_decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
+      if (status.repr) {
+        goto suspend;
+      }
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
+    }
+    self->private_impl.f_call_sequence = 3;
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
-                                     wuffs_base__io_buffer* a_src);
+    goto ok;
+  ok:
+    self->private_impl.p_decode_image_config[0] = 0;
+    goto exit;
+  }
 
-static wuffs_base__status  //
-wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
-                                wuffs_base__io_buffer* a_src);
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_image_config[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src);
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src);
+// -------- func gif.config_decoder.set_report_metadata
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
-                                    wuffs_base__io_buffer* a_src);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
+                                               uint32_t a_fourcc,
+                                               bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__pixel_blend a_blend);
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__slice_u8 a_workbuf);
+// -------- func gif.config_decoder.ack_metadata_chunk
 
-static wuffs_base__status  //
-wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
-                                         wuffs_base__pixel_buffer* a_pb,
-                                         wuffs_base__slice_u8 a_src);
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
+                                              wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// ---------------- VTables
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
 
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__ack_metadata_chunk),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__config_decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__config_decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__config_decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__config_decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__config_decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__config_decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__config_decoder__set_report_metadata),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__config_decoder__workbuf_len),
-};
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-const wuffs_base__image_decoder__func_ptrs
-    wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder = {
-        (wuffs_base__status(*)(void*, wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__ack_metadata_chunk),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__pixel_buffer*,
-                               wuffs_base__io_buffer*,
-                               wuffs_base__pixel_blend,
-                               wuffs_base__slice_u8,
-                               wuffs_base__decode_frame_options*))(
-            &wuffs_gif__decoder__decode_frame),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__frame_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_frame_config),
-        (wuffs_base__status(*)(void*,
-                               wuffs_base__image_config*,
-                               wuffs_base__io_buffer*))(
-            &wuffs_gif__decoder__decode_image_config),
-        (wuffs_base__rect_ie_u32(*)(const void*))(
-            &wuffs_gif__decoder__frame_dirty_rect),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__metadata_chunk_length),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__metadata_fourcc),
-        (uint32_t(*)(const void*))(&wuffs_gif__decoder__num_animation_loops),
-        (uint64_t(*)(const void*))(
-            &wuffs_gif__decoder__num_decoded_frame_configs),
-        (uint64_t(*)(const void*))(&wuffs_gif__decoder__num_decoded_frames),
-        (wuffs_base__status(*)(void*, uint64_t, uint64_t))(
-            &wuffs_gif__decoder__restart_frame),
-        (wuffs_base__empty_struct(*)(void*, uint32_t, bool))(
-            &wuffs_gif__decoder__set_report_metadata),
-        (wuffs_base__range_ii_u64(*)(const void*))(
-            &wuffs_gif__decoder__workbuf_len),
-};
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+      }
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      }
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
+    }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+    goto ok;
+  ok:
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    goto exit;
+  }
 
-// ---------------- Initializer Implementations
+  goto suspend;
+suspend:
+  self->private_impl.p_ack_metadata_chunk[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__config_decoder__initialize(wuffs_gif__config_decoder* self,
-                                      size_t sizeof_star_self,
-                                      uint64_t wuffs_version,
-                                      uint32_t initialize_flags) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
+  return status;
+}
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
+// -------- func gif.config_decoder.metadata_fourcc
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__metadata_fourcc(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__config_decoder__func_ptrs_for__wuffs_base__image_decoder);
-  return wuffs_base__make_status(NULL);
+  return self->private_impl.f_metadata_fourcc_value;
 }
 
-size_t  //
-sizeof__wuffs_gif__config_decoder() {
-  return sizeof(wuffs_gif__config_decoder);
+// -------- func gif.config_decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__metadata_chunk_length(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_chunk_length_value;
 }
 
-wuffs_base__status WUFFS_BASE__WARN_UNUSED_RESULT  //
-wuffs_gif__decoder__initialize(wuffs_gif__decoder* self,
-                               size_t sizeof_star_self,
-                               uint64_t wuffs_version,
-                               uint32_t initialize_flags) {
+// -------- func gif.config_decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__config_decoder__num_animation_loops(
+    const wuffs_gif__config_decoder* self) {
   if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+    return 0;
   }
-  if (sizeof(*self) != sizeof_star_self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_sizeof_receiver);
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
-  if (((wuffs_version >> 32) != WUFFS_VERSION_MAJOR) ||
-      (((wuffs_version >> 16) & 0xFFFF) > WUFFS_VERSION_MINOR)) {
-    return wuffs_base__make_status(wuffs_base__error__bad_wuffs_version);
+
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
   }
+  return 1;
+}
 
-  if ((initialize_flags & WUFFS_INITIALIZE__ALREADY_ZEROED) != 0) {
-// The whole point of this if-check is to detect an uninitialized *self.
-// We disable the warning on GCC. Clang-5.0 does not have this warning.
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
-#endif
-    if (self->private_impl.magic != 0) {
-      return wuffs_base__make_status(
-          wuffs_base__error__initialize_falsely_claimed_already_zeroed);
-    }
-#if !defined(__clang__) && defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-  } else {
-    if ((initialize_flags &
-         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED) == 0) {
-      memset(self, 0, sizeof(*self));
-      initialize_flags |= WUFFS_INITIALIZE__ALREADY_ZEROED;
-    } else {
-      memset(&(self->private_impl), 0, sizeof(self->private_impl));
-    }
+// -------- func gif.config_decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frame_configs(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  {
-    wuffs_base__status z = wuffs_lzw__decoder__initialize(
-        &self->private_data.f_lzw, sizeof(self->private_data.f_lzw),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.config_decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__config_decoder__num_decoded_frames(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return 0;
   }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.vtable_name =
-      wuffs_base__image_decoder__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__image_decoder.function_pointers =
-      (const void*)(&wuffs_gif__decoder__func_ptrs_for__wuffs_base__image_decoder);
-  return wuffs_base__make_status(NULL);
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_num_decoded_frames_value;
 }
 
-size_t  //
-sizeof__wuffs_gif__decoder() {
-  return sizeof(wuffs_gif__decoder);
+// -------- func gif.config_decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__config_decoder__frame_dirty_rect(
+    const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+
+  return wuffs_base__utility__empty_rect_ie_u32();
 }
 
-// ---------------- Function Implementations
+// -------- func gif.config_decoder.workbuf_len
 
-// -------- func gif.config_decoder.set_quirk_enabled
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_quirk_enabled(wuffs_gif__config_decoder* self,
-                                             uint32_t a_quirk,
-                                             bool a_enabled) {
+  return wuffs_base__utility__empty_range_ii_u64();
+}
+
+// -------- func gif.config_decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
+                                         uint64_t a_index,
+                                         uint64_t a_io_position) {
   if (!self) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
   if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
   }
 
   if (self->private_impl.f_call_sequence == 0) {
-    if (a_quirk == 1041635328) {
-      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
-    } else if (a_quirk == 1041635329) {
-      self->private_impl
-          .f_quirk_enabled_first_frame_local_palette_means_black_background =
-          a_enabled;
-    } else if (a_quirk == 1041635330) {
-      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
-    } else if (a_quirk == 1041635331) {
-      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
-    } else if (a_quirk == 1041635332) {
-      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
-    } else if (a_quirk == 1041635333) {
-      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
-    } else if (a_quirk == 1041635334) {
-      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
-    }
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
   }
-  return wuffs_base__make_empty_struct();
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__config_decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func gif.config_decoder.decode_image_config
+// -------- func gif.config_decoder.decode_frame_config
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__image_config* a_dst,
+wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
+                                               wuffs_base__frame_config* a_dst,
                                                wuffs_base__io_buffer* a_src) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
@@ -15203,7 +23866,7 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 1)) {
+      (self->private_impl.active_coroutine != 3)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(
         wuffs_base__error__interleaved_coroutine_calls);
@@ -15211,103 +23874,253 @@ wuffs_gif__config_decoder__decode_image_config(wuffs_gif__config_decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  bool v_ffio = false;
+  uint32_t v_background_color = 0;
+  uint8_t v_flags = 0;
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
   if (coro_susp_point) {
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence == 0) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__config_decoder__decode_header(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_lsd(self, a_src);
-      if (status.repr) {
-        goto suspend;
+    self->private_impl.f_ignore_metadata = true;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status =
+            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+          }
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          }
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
       }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-    if (status.repr) {
-      goto suspend;
     }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
     }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl
+              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        }
+      }
     }
     if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
     }
-    self->private_impl.f_call_sequence = 3;
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_decode_frame_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_decode_frame_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
 
   goto exit;
 exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
   if (wuffs_base__status__is_error(&status)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
   return status;
 }
 
-// -------- func gif.config_decoder.set_report_metadata
+// -------- func gif.config_decoder.skip_frame
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__set_report_metadata(wuffs_gif__config_decoder* self,
-                                               uint32_t a_fourcc,
-                                               bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
+static wuffs_base__status  //
+wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  if (coro_susp_point) {
   }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
+    }
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
+    }
+    wuffs_gif__config_decoder__reset_gc(self);
+
+    goto ok;
+  ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  return wuffs_base__make_empty_struct();
+
+  return status;
 }
 
-// -------- func gif.config_decoder.ack_metadata_chunk
+// -------- func gif.config_decoder.decode_frame
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
-                                              wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_frame(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__pixel_buffer* a_dst,
+    wuffs_base__io_buffer* a_src,
+    wuffs_base__pixel_blend a_blend,
+    wuffs_base__slice_u8 a_workbuf,
+    wuffs_base__decode_frame_options* a_opts) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -15317,12 +24130,12 @@ wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_src) {
+  if (!a_dst || !a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
+      (self->private_impl.active_coroutine != 4)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(
         wuffs_base__error__interleaved_coroutine_calls);
@@ -15330,6 +24143,40 @@ wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
+  goto exit;
+  goto ok;
+ok:
+  goto exit;
+exit:
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.config_decoder.reset_gc
+
+static wuffs_base__empty_struct  //
+wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gif.config_decoder.decode_up_to_id_part1
+
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_up_to_id_part1(
+    wuffs_gif__config_decoder* self,
+    wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t v_block_type = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15341,247 +24188,183 @@ wuffs_gif__config_decoder__ack_metadata_chunk(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
+      }
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
       goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
     }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
       }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
     }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
+  label__0__break:;
+
     goto ok;
   ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
-
-// -------- func gif.config_decoder.metadata_fourcc
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__metadata_fourcc(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_fourcc_value;
-}
-
-// -------- func gif.config_decoder.metadata_chunk_length
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__metadata_chunk_length(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_chunk_length_value;
-}
-
-// -------- func gif.config_decoder.num_animation_loops
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__config_decoder__num_animation_loops(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
-}
-
-// -------- func gif.config_decoder.num_decoded_frame_configs
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frame_configs(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frame_configs_value;
-}
-
-// -------- func gif.config_decoder.num_decoded_frames
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__config_decoder__num_decoded_frames(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_num_decoded_frames_value;
-}
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    goto exit;
+  }
 
-// -------- func gif.config_decoder.frame_dirty_rect
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_up_to_id_part1[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__config_decoder__frame_dirty_rect(
-    const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  return wuffs_base__utility__empty_rect_ie_u32();
+  return status;
 }
 
-// -------- func gif.config_decoder.workbuf_len
+// -------- func gif.config_decoder.decode_header
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__config_decoder__workbuf_len(const wuffs_gif__config_decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
+                                         wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  return wuffs_base__utility__empty_range_ii_u64();
-}
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
 
-// -------- func gif.config_decoder.restart_frame
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__restart_frame(wuffs_gif__config_decoder* self,
-                                         uint64_t a_index,
-                                         uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
   }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
+      }
+      v_i += 1;
+    }
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
+    }
+
+    goto ok;
+  ok:
+    self->private_impl.p_decode_header[0] = 0;
+    goto exit;
   }
 
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__config_decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
+
+  return status;
 }
 
-// -------- func gif.config_decoder.decode_frame_config
+// -------- func gif.config_decoder.decode_lsd
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
-                                               wuffs_base__frame_config* a_dst,
-                                               wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
+                                      wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_background_color = 0;
   uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15594,114 +24377,191 @@ wuffs_gif__config_decoder__decode_frame_config(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
   if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status =
-            wuffs_gif__config_decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__config_decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
           }
-          if (status.repr) {
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_width = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
         }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
       }
+      self->private_impl.f_height = t_1;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
     }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
     }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl
-              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
         }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirk_enabled_honor_background_color) {
+        if ((v_background_color_index != 0) &&
+            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul =
+              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
+                << 0) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
+                << 8) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
+                << 16) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
+                << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
         }
       }
     }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
+    self->private_impl.p_decode_lsd[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame_config[0] =
+  self->private_impl.p_decode_lsd[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index =
+      v_background_color_index;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -15709,21 +24569,17 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.config_decoder.skip_frame
+// -------- func gif.config_decoder.decode_extension
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
+                                            wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+  uint8_t v_label = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15736,7 +24592,7 @@ wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
@@ -15749,34 +24605,36 @@ wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
         goto suspend;
       }
       uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
+      v_label = t_0;
     }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
-    }
-    {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
         goto suspend;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
+      status = wuffs_base__make_status(NULL);
+      goto ok;
     }
     if (a_src) {
       a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
@@ -15789,99 +24647,35 @@ wuffs_gif__config_decoder__skip_frame(wuffs_gif__config_decoder* self,
     if (status.repr) {
       goto suspend;
     }
-    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
-    }
-    wuffs_gif__config_decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_skip_frame[0] = 0;
+    self->private_impl.p_decode_extension[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_frame[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  return status;
-}
-
-// -------- func gif.config_decoder.decode_frame
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__config_decoder__decode_frame(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__pixel_buffer* a_dst,
-    wuffs_base__io_buffer* a_src,
-    wuffs_base__pixel_blend a_blend,
-    wuffs_base__slice_u8 a_workbuf,
-    wuffs_base__decode_frame_options* a_opts) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  status = wuffs_base__make_status(wuffs_base__error__unsupported_method);
-  goto exit;
-  goto ok;
-ok:
-  goto exit;
-exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
-  return status;
-}
+  self->private_impl.p_decode_extension[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
-// -------- func gif.config_decoder.reset_gc
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
 
-static wuffs_base__empty_struct  //
-wuffs_gif__config_decoder__reset_gc(wuffs_gif__config_decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func gif.config_decoder.decode_up_to_id_part1
+// -------- func gif.config_decoder.skip_blocks
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_up_to_id_part1(
-    wuffs_gif__config_decoder* self,
-    wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_type = 0;
+  uint8_t v_block_size = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -15894,26 +24688,12 @@ wuffs_gif__config_decoder__decode_up_to_id_part1(
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
-      }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
-    }
     while (true) {
       {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
@@ -15922,62 +24702,34 @@ wuffs_gif__config_decoder__decode_up_to_id_part1(
           goto suspend;
         }
         uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
+        v_block_size = t_0;
       }
-      if (v_block_type == 33) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__config_decoder__decode_extension(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__config_decoder__decode_id_part0(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
-        }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_blocks[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
     }
-  label__0__break:;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    self->private_impl.p_skip_blocks[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
+  self->private_impl.p_skip_blocks[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -15989,15 +24741,19 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_header
+// -------- func gif.config_decoder.decode_ae
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
-                                         wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16010,44 +24766,233 @@ wuffs_gif__config_decoder__decode_header(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
   if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (v_i < 6) {
+    while (true) {
       {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
         if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
           status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__0__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts =
+            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
+        v_is_netscape =
+            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
+        v_is_iccp =
+            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch =
+              ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
+        }
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__0__break;
+        }
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_loops = t_4;
+        }
+        self->private_impl.f_seen_num_loops = true;
+        if ((0 < self->private_impl.f_num_loops) &&
+            (self->private_impl.f_num_loops <= 65535)) {
+          self->private_impl.f_num_loops += 1;
+        }
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
         }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_metadata_fourcc_value = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        }
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        }
+        self->private_impl.f_metadata_fourcc_value = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
       }
-      v_i += 1;
+      goto label__0__break;
     }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
-      goto exit;
+  label__0__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_header[0] = 0;
+    self->private_impl.p_decode_ae[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_header[0] =
+  self->private_impl.p_decode_ae[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
 
   goto exit;
 exit:
@@ -16058,19 +25003,16 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_lsd
+// -------- func gif.config_decoder.decode_gc
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
-                                      wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_c = 0;
   uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16083,191 +25025,108 @@ wuffs_gif__config_decoder__decode_lsd(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
-      }
-      self->private_impl.f_width = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
-      }
-      self->private_impl.f_height = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
       if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_2 = *iop_a_src++;
-      v_flags = t_2;
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
     }
     {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
       if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_3 = *iop_a_src++;
-      v_background_color_index = t_3;
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-      goto suspend;
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
     }
-    iop_a_src++;
-    v_i = 0;
-    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
-    if (self->private_impl.f_has_global_palette) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_lsd[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
-              if (num_bits_4 == 16) {
-                t_4 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4));
-            }
-          }
-          v_argb = t_4;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      if (self->private_impl.f_quirk_enabled_honor_background_color) {
-        if ((v_background_color_index != 0) &&
-            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
-          v_j = (4 * ((uint32_t)(v_background_color_index)));
-          self->private_impl.f_background_color_u32_argb_premul =
-              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
-                << 0) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
-                << 8) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
-                << 16) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
-                << 24));
-        } else {
-          self->private_impl.f_background_color_u32_argb_premul = 77;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
         }
       }
+      v_gc_duration_centiseconds = t_2;
     }
-    while (v_i < 256) {
-      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
-      v_i += 1;
+    self->private_impl.f_gc_duration =
+        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_lsd[0] = 0;
+    self->private_impl.p_decode_gc[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_lsd[0] =
+  self->private_impl.p_decode_gc[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_lsd[0].v_flags = v_flags;
-  self->private_data.s_decode_lsd[0].v_background_color_index =
-      v_background_color_index;
-  self->private_data.s_decode_lsd[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_lsd[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -16278,15 +25137,13 @@ exit:
   return status;
 }
 
-// -------- func gif.config_decoder.decode_extension
+// -------- func gif.config_decoder.decode_id_part0
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
-                                            wuffs_base__io_buffer* a_src) {
+wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
+                                           wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_label = 0;
-
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16298,7 +25155,7 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
@@ -16306,63 +25163,143 @@ wuffs_gif__config_decoder__decode_extension(wuffs_gif__config_decoder* self,
 
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_label = t_0;
+      self->private_impl.f_frame_rect_x0 = t_0;
     }
-    if (v_label == 249) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__config_decoder__decode_gc(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    } else if (v_label == 255) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
+    {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      status = wuffs_gif__config_decoder__decode_ae(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
+        }
       }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
+      self->private_impl.f_frame_rect_y0 = t_1;
     }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_x1 = t_2;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
+      }
+      self->private_impl.f_frame_rect_y1 = t_3;
     }
-    if (status.repr) {
-      goto suspend;
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&
+        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
+      self->private_impl.f_width = wuffs_base__u32__max(
+          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(
+          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_extension[0] = 0;
+    self->private_impl.p_decode_id_part0[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_extension[0] =
+  self->private_impl.p_decode_id_part0[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -16370,355 +25307,446 @@ exit:
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-
-  return status;
+
+  return status;
+}
+
+// -------- func gif.decoder.set_quirk_enabled
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
+                                      uint32_t a_quirk,
+                                      bool a_enabled) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    if (a_quirk == 1041635328) {
+      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
+    } else if (a_quirk == 1041635329) {
+      self->private_impl
+          .f_quirk_enabled_first_frame_local_palette_means_black_background =
+          a_enabled;
+    } else if (a_quirk == 1041635330) {
+      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
+    } else if (a_quirk == 1041635331) {
+      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
+    } else if (a_quirk == 1041635332) {
+      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
+    } else if (a_quirk == 1041635333) {
+      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
+    } else if (a_quirk == 1041635334) {
+      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+    }
+  }
+  return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.config_decoder.skip_blocks
+// -------- func gif.decoder.decode_image_config
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__skip_blocks(wuffs_gif__config_decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
+                                        wuffs_base__image_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_size = 0;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+  bool v_ffio = false;
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+    if (self->private_impl.f_call_sequence == 0) {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      status = wuffs_gif__decoder__decode_header(self, a_src);
+      if (status.repr) {
+        goto suspend;
       }
-      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_blocks[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_blocks[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__decoder__decode_lsd(self, a_src);
+      if (status.repr) {
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+    } else if (self->private_impl.f_call_sequence != 2) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+    if (status.repr) {
+      goto suspend;
+    }
+    v_ffio = !self->private_impl.f_gc_has_transparent_index;
+    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
+      v_ffio =
+          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
+           (self->private_impl.f_frame_rect_y0 == 0) &&
+           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
+           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
+    } else if (v_ffio) {
+      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
+    }
+    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
+      self->private_impl.f_background_color_u32_argb_premul =
+          self->private_impl.f_black_color_u32_argb_premul;
+    }
+    if (a_dst != NULL) {
+      wuffs_base__image_config__set(
+          a_dst, 1191444488, 0, self->private_impl.f_width,
+          self->private_impl.f_height,
+          self->private_impl.f_frame_config_io_position, v_ffio);
     }
+    self->private_impl.f_call_sequence = 3;
 
     goto ok;
   ok:
-    self->private_impl.p_skip_blocks[0] = 0;
+    self->private_impl.p_decode_image_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_blocks[0] =
+  self->private_impl.p_decode_image_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
   }
-
   return status;
 }
 
-// -------- func gif.config_decoder.decode_ae
-
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_ae(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  uint8_t v_c = 0;
-  uint8_t v_block_size = 0;
-  bool v_is_animexts = false;
-  bool v_is_netscape = false;
-  bool v_is_iccp = false;
-  bool v_is_xmp = false;
+// -------- func gif.decoder.set_report_metadata
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
+                                        uint32_t a_fourcc,
+                                        bool a_report) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
-  if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
-    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
-    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
-    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
-    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
+  if (a_fourcc == 1229144912) {
+    self->private_impl.f_report_metadata_iccp = a_report;
+  } else if (a_fourcc == 1481461792) {
+    self->private_impl.f_report_metadata_xmp = a_report;
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+  return wuffs_base__make_empty_struct();
+}
 
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      if (v_block_size != 11) {
-        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (self->private_data.s_decode_ae[0].scratch >
-            ((uint64_t)(io2_a_src - iop_a_src))) {
-          self->private_data.s_decode_ae[0].scratch -=
-              ((uint64_t)(io2_a_src - iop_a_src));
-          iop_a_src = io2_a_src;
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        iop_a_src += self->private_data.s_decode_ae[0].scratch;
-        goto label__0__break;
-      }
-      v_is_animexts = true;
-      v_is_netscape = true;
-      v_is_iccp = true;
-      v_is_xmp = true;
-      v_block_size = 0;
-      while (v_block_size < 11) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_1 = *iop_a_src++;
-          v_c = t_1;
-        }
-        v_is_animexts =
-            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
-        v_is_netscape =
-            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
-        v_is_iccp =
-            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
-        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        v_block_size += 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
+// -------- func gif.decoder.ack_metadata_chunk
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
+                                       wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    }
+    if (wuffs_base__u64__sat_add(a_src->meta.pos,
+                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
+        self->private_impl.f_metadata_io_position) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+      goto exit;
+    }
+    if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
       }
-      if (v_is_animexts || v_is_netscape) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_2 = *iop_a_src++;
-          v_block_size = t_2;
-        }
-        if (v_block_size != 3) {
-          self->private_data.s_decode_ae[0].scratch =
-              ((uint32_t)(v_block_size));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__0__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_3 = *iop_a_src++;
-          v_c = t_3;
-        }
-        if (v_c != 1) {
-          self->private_data.s_decode_ae[0].scratch = 2;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
-          goto label__0__break;
-        }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-            iop_a_src += 2;
-          } else {
-            self->private_data.s_decode_ae[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-              *scratch <<= 8;
-              *scratch >>= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-              if (num_bits_4 == 8) {
-                t_4 = ((uint32_t)(*scratch));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4)) << 56;
-            }
-          }
-          self->private_impl.f_num_loops = t_4;
-        }
-        self->private_impl.f_seen_num_loops = true;
-        if ((0 < self->private_impl.f_num_loops) &&
-            (self->private_impl.f_num_loops <= 65535)) {
-          self->private_impl.f_num_loops += 1;
-        }
-      } else if (self->private_impl.f_ignore_metadata) {
-      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        self->private_impl.f_metadata_fourcc_value = 1229144912;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
-        }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+      self->private_impl.f_metadata_chunk_length_value =
+          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+      if (self->private_impl.f_metadata_chunk_length_value > 0) {
+        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
           self->private_impl.f_metadata_chunk_length_value += 1;
         } else {
           (iop_a_src += 1, wuffs_base__make_empty_struct());
         }
-        self->private_impl.f_metadata_fourcc_value = 1481461792;
         self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
             wuffs_base__u64__sat_add(a_src->meta.pos,
                                      ((uint64_t)(iop_a_src - io0_a_src))),
             self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
         status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
         goto ok;
       }
-      goto label__0__break;
-    }
-  label__0__break:;
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
-    status = wuffs_gif__config_decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
-    }
-    if (status.repr) {
-      goto suspend;
+      (iop_a_src += 1, wuffs_base__make_empty_struct());
     }
+    self->private_impl.f_call_sequence = 2;
+    self->private_impl.f_metadata_fourcc_value = 0;
+    self->private_impl.f_metadata_io_position = 0;
+    status = wuffs_base__make_status(NULL);
+    goto ok;
+    goto ok;
+  ok:
+    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_ack_metadata_chunk[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.decoder.metadata_fourcc
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_fourcc_value;
+}
+
+// -------- func gif.decoder.metadata_chunk_length
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_metadata_chunk_length_value;
+}
+
+// -------- func gif.decoder.num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  if (self->private_impl.f_seen_num_loops) {
+    return self->private_impl.f_num_loops;
+  }
+  return 1;
+}
+
+// -------- func gif.decoder.num_decoded_frame_configs
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_ae[0] = 0;
-    goto exit;
+  return self->private_impl.f_num_decoded_frame_configs_value;
+}
+
+// -------- func gif.decoder.num_decoded_frames
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_ae[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
-  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
-  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
-  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
-  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+  return self->private_impl.f_num_decoded_frames_value;
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+// -------- func gif.decoder.frame_dirty_rect
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
+wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_rect_ie_u32();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_rect_ie_u32();
   }
 
-  return status;
+  return wuffs_base__utility__make_rect_ie_u32(
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                           self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                           self->private_impl.f_height),
+      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                           self->private_impl.f_width),
+      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
+                           self->private_impl.f_height));
 }
 
-// -------- func gif.config_decoder.decode_gc
+// -------- func gif.decoder.workbuf_len
 
-static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
+wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
+  if (!self) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return wuffs_base__utility__empty_range_ii_u64();
+  }
+
+  return wuffs_base__utility__make_range_ii_u64(0, 0);
+}
+
+// -------- func gif.decoder.restart_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
+                                  uint64_t a_index,
+                                  uint64_t a_io_position) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+
+  if (self->private_impl.f_call_sequence == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+  self->private_impl.f_delayed_num_decoded_frames = false;
+  self->private_impl.f_end_of_data = false;
+  self->private_impl.f_restarted = true;
+  self->private_impl.f_frame_config_io_position = a_io_position;
+  self->private_impl.f_num_decoded_frame_configs_value = a_index;
+  self->private_impl.f_num_decoded_frames_value = a_index;
+  wuffs_gif__decoder__reset_gc(self);
+  return wuffs_base__make_status(NULL);
+}
+
+// -------- func gif.decoder.decode_frame_config
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
+                                        wuffs_base__frame_config* a_dst,
+                                        wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
+  uint32_t v_background_color = 0;
   uint8_t v_flags = 0;
-  uint16_t v_gc_duration_centiseconds = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16731,108 +25759,114 @@ wuffs_gif__config_decoder__decode_gc(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
   if (coro_susp_point) {
+    v_background_color =
+        self->private_data.s_decode_frame_config[0].v_background_color;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 4) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_1 = *iop_a_src++;
-      v_flags = t_1;
-    }
-    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
-    v_flags = ((v_flags >> 2) & 7);
-    if (v_flags == 2) {
-      self->private_impl.f_gc_disposal = 1;
-    } else if ((v_flags == 3) || (v_flags == 4)) {
-      self->private_impl.f_gc_disposal = 2;
-    } else {
-      self->private_impl.f_gc_disposal = 0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint16_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_gc[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
+    self->private_impl.f_ignore_metadata = true;
+    self->private_impl.f_dirty_max_excl_y = 0;
+    if (!self->private_impl.f_end_of_data) {
+      if (self->private_impl.f_call_sequence == 0) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (self->private_impl.f_call_sequence != 3) {
+        if (self->private_impl.f_call_sequence == 4) {
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
           }
-          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint16_t)(*scratch));
-            break;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          status = wuffs_gif__decoder__skip_frame(self, a_src);
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
           }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+          if (status.repr) {
+            goto suspend;
+          }
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
         }
       }
-      v_gc_duration_centiseconds = t_2;
     }
-    self->private_impl.f_gc_duration =
-        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      self->private_impl.f_gc_transparent_index = t_3;
+    if (self->private_impl.f_end_of_data) {
+      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
+      goto ok;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+    if (!self->private_impl.f_gc_has_transparent_index) {
+      v_background_color =
+          self->private_impl.f_background_color_u32_argb_premul;
+      if (self->private_impl
+              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
+          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+        }
+        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
+        if ((v_flags & 128) != 0) {
+          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        }
       }
-      uint8_t t_4 = *iop_a_src++;
-      v_c = t_4;
     }
-    if (v_c != 0) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
+    if (a_dst != NULL) {
+      wuffs_base__frame_config__update(
+          a_dst,
+          wuffs_base__utility__make_rect_ie_u32(
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
+                                   self->private_impl.f_height),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
+                                   self->private_impl.f_width),
+              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
+                                   self->private_impl.f_height)),
+          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
+          self->private_impl.f_num_decoded_frame_configs_value,
+          self->private_impl.f_frame_config_io_position,
+          self->private_impl.f_gc_disposal,
+          !self->private_impl.f_gc_has_transparent_index, false,
+          v_background_color);
     }
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frame_configs_value, 1);
+    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_gc[0] = 0;
+    self->private_impl.p_decode_frame_config[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_gc[0] =
+  self->private_impl.p_decode_frame_config[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+  self->private_data.s_decode_frame_config[0].v_background_color =
+      v_background_color;
 
   goto exit;
 exit:
@@ -16840,16 +25874,22 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.config_decoder.decode_id_part0
+// -------- func gif.decoder.skip_frame
 
 static wuffs_base__status  //
-wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
-                                           wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_flags = 0;
+  uint8_t v_lw = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -16861,7 +25901,7 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
+  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
@@ -16869,195 +25909,88 @@ wuffs_gif__config_decoder__decode_id_part0(wuffs_gif__config_decoder* self,
 
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      self->private_impl.f_frame_rect_x0 = t_0;
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
+    if ((v_flags & 128) != 0) {
+      self->private_data.s_skip_frame[0].scratch =
+          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_frame[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_frame[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      self->private_impl.f_frame_rect_y0 = t_1;
+      iop_a_src += self->private_data.s_skip_frame[0].scratch;
     }
     {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      uint32_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
-        }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
       }
-      self->private_impl.f_frame_rect_x1 = t_2;
+      uint8_t t_1 = *iop_a_src++;
+      v_lw = t_1;
     }
-    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
-          if (num_bits_3 == 8) {
-            t_3 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y1 = t_3;
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
     }
-    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
-    if ((self->private_impl.f_call_sequence == 0) &&
-        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
-      self->private_impl.f_width = wuffs_base__u32__max(
-          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
-      self->private_impl.f_height = wuffs_base__u32__max(
-          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part0[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part0[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  return status;
-}
-
-// -------- func gif.decoder.set_quirk_enabled
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_quirk_enabled(wuffs_gif__decoder* self,
-                                      uint32_t a_quirk,
-                                      bool a_enabled) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
-
-  if (self->private_impl.f_call_sequence == 0) {
-    if (a_quirk == 1041635328) {
-      self->private_impl.f_quirk_enabled_delay_num_decoded_frames = a_enabled;
-    } else if (a_quirk == 1041635329) {
-      self->private_impl
-          .f_quirk_enabled_first_frame_local_palette_means_black_background =
-          a_enabled;
-    } else if (a_quirk == 1041635330) {
-      self->private_impl.f_quirk_enabled_honor_background_color = a_enabled;
-    } else if (a_quirk == 1041635331) {
-      self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data = a_enabled;
-    } else if (a_quirk == 1041635332) {
-      self->private_impl.f_quirk_enabled_image_bounds_are_strict = a_enabled;
-    } else if (a_quirk == 1041635333) {
-      self->private_impl.f_quirk_enabled_reject_empty_frame = a_enabled;
-    } else if (a_quirk == 1041635334) {
-      self->private_impl.f_quirk_enabled_reject_empty_palette = a_enabled;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
+      self->private_impl.f_delayed_num_decoded_frames = true;
+    } else {
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_num_decoded_frames_value, 1);
     }
+    wuffs_gif__decoder__reset_gc(self);
+
+    goto ok;
+  ok:
+    self->private_impl.p_skip_frame[0] = 0;
+    goto exit;
   }
-  return wuffs_base__make_empty_struct();
+
+  goto suspend;
+suspend:
+  self->private_impl.p_skip_frame[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  }
+
+  return status;
 }
 
-// -------- func gif.decoder.decode_image_config
+// -------- func gif.decoder.decode_frame
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
-                                        wuffs_base__image_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
+                                 wuffs_base__pixel_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src,
+                                 wuffs_base__pixel_blend a_blend,
+                                 wuffs_base__slice_u8 a_workbuf,
+                                 wuffs_base__decode_frame_options* a_opts) {
   if (!self) {
     return wuffs_base__make_status(wuffs_base__error__bad_receiver);
   }
@@ -17067,12 +26000,12 @@ wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
             ? wuffs_base__error__disabled_by_previous_error
             : wuffs_base__error__initialize_not_called);
   }
-  if (!a_src) {
+  if (!a_dst || !a_src) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 1)) {
+      (self->private_impl.active_coroutine != 4)) {
     self->private_impl.magic = WUFFS_BASE__DISABLED;
     return wuffs_base__make_status(
         wuffs_base__error__interleaved_coroutine_calls);
@@ -17080,68 +26013,54 @@ wuffs_gif__decoder__decode_image_config(wuffs_gif__decoder* self,
   self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  bool v_ffio = false;
-
-  uint32_t coro_susp_point = self->private_impl.p_decode_image_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence == 0) {
+    self->private_impl.f_ignore_metadata = true;
+    if (self->private_impl.f_call_sequence != 4) {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_header(self, a_src);
-      if (status.repr) {
-        goto suspend;
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__decoder__decode_lsd(self, a_src);
+      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
       if (status.repr) {
         goto suspend;
       }
-    } else if (self->private_impl.f_call_sequence != 2) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+    }
+    if (self->private_impl.f_quirk_enabled_reject_empty_frame &&
+        ((self->private_impl.f_frame_rect_x0 ==
+          self->private_impl.f_frame_rect_x1) ||
+         (self->private_impl.f_frame_rect_y0 ==
+          self->private_impl.f_frame_rect_y1))) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
       goto exit;
     }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
     if (status.repr) {
       goto suspend;
     }
-    v_ffio = !self->private_impl.f_gc_has_transparent_index;
-    if (!self->private_impl.f_quirk_enabled_honor_background_color) {
-      v_ffio =
-          (v_ffio && (self->private_impl.f_frame_rect_x0 == 0) &&
-           (self->private_impl.f_frame_rect_y0 == 0) &&
-           (self->private_impl.f_frame_rect_x1 == self->private_impl.f_width) &&
-           (self->private_impl.f_frame_rect_y1 == self->private_impl.f_height));
-    } else if (v_ffio) {
-      self->private_impl.f_black_color_u32_argb_premul = 4278190080;
-    }
-    if (self->private_impl.f_background_color_u32_argb_premul == 77) {
-      self->private_impl.f_background_color_u32_argb_premul =
-          self->private_impl.f_black_color_u32_argb_premul;
-    }
-    if (a_dst != NULL) {
-      wuffs_base__image_config__set(
-          a_dst, 1191444488, 0, self->private_impl.f_width,
-          self->private_impl.f_height,
-          self->private_impl.f_frame_config_io_position, v_ffio);
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
+    if (status.repr) {
+      goto suspend;
     }
-    self->private_impl.f_call_sequence = 3;
+    wuffs_base__u64__sat_add_indirect(
+        &self->private_impl.f_num_decoded_frames_value, 1);
+    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_image_config[0] = 0;
+    self->private_impl.p_decode_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_image_config[0] =
+  self->private_impl.p_decode_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
   self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+      wuffs_base__status__is_suspension(&status) ? 4 : 0;
 
   goto exit;
 exit:
@@ -17151,54 +26070,27 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.set_report_metadata
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_gif__decoder__set_report_metadata(wuffs_gif__decoder* self,
-                                        uint32_t a_fourcc,
-                                        bool a_report) {
-  if (!self) {
-    return wuffs_base__make_empty_struct();
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_empty_struct();
-  }
+// -------- func gif.decoder.reset_gc
 
-  if (a_fourcc == 1229144912) {
-    self->private_impl.f_report_metadata_iccp = a_report;
-  } else if (a_fourcc == 1481461792) {
-    self->private_impl.f_report_metadata_xmp = a_report;
-  }
+static wuffs_base__empty_struct  //
+wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
+  self->private_impl.f_call_sequence = 5;
+  self->private_impl.f_gc_has_transparent_index = false;
+  self->private_impl.f_gc_transparent_index = 0;
+  self->private_impl.f_gc_disposal = 0;
+  self->private_impl.f_gc_duration = 0;
   return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.decoder.ack_metadata_chunk
+// -------- func gif.decoder.decode_up_to_id_part1
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
-                                       wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 2)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
+                                          wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
+  uint8_t v_block_type = 0;
+
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17210,61 +26102,91 @@ wuffs_gif__decoder__ack_metadata_chunk(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_ack_metadata_chunk[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (self->private_impl.f_call_sequence != 1) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-      goto exit;
-    }
-    if (wuffs_base__u64__sat_add(a_src->meta.pos,
-                                 ((uint64_t)(iop_a_src - io0_a_src))) !=
-        self->private_impl.f_metadata_io_position) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_i_o_position);
+    if (!self->private_impl.f_restarted) {
+      if (self->private_impl.f_call_sequence != 2) {
+        self->private_impl.f_frame_config_io_position =
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src)));
+      }
+    } else if (self->private_impl.f_frame_config_io_position !=
+               wuffs_base__u64__sat_add(a_src->meta.pos,
+                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
       goto exit;
+    } else {
+      self->private_impl.f_restarted = false;
     }
-    if (self->private_impl.f_metadata_chunk_length_value > 0) {
-      while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(1);
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_type = t_0;
       }
-      self->private_impl.f_metadata_chunk_length_value =
-          ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-      if (self->private_impl.f_metadata_chunk_length_value > 0) {
-        if (self->private_impl.f_metadata_fourcc_value == 1481461792) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+      if (v_block_type == 33) {
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
         }
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        status = wuffs_gif__decoder__decode_extension(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+      } else if (v_block_type == 44) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        if (a_src) {
+          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        }
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
+        if (a_src) {
+          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        }
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__break;
+      } else if (v_block_type == 59) {
+        if (self->private_impl.f_delayed_num_decoded_frames) {
+          self->private_impl.f_delayed_num_decoded_frames = false;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_num_decoded_frames_value, 1);
+        }
+        self->private_impl.f_end_of_data = true;
+        goto label__0__break;
+      } else {
+        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
+        goto exit;
       }
-      (iop_a_src += 1, wuffs_base__make_empty_struct());
     }
-    self->private_impl.f_call_sequence = 2;
-    self->private_impl.f_metadata_fourcc_value = 0;
-    self->private_impl.f_metadata_io_position = 0;
-    status = wuffs_base__make_status(NULL);
-    goto ok;
+  label__0__break:;
+
     goto ok;
   ok:
-    self->private_impl.p_ack_metadata_chunk[0] = 0;
+    self->private_impl.p_decode_up_to_id_part1[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_ack_metadata_chunk[0] =
+  self->private_impl.p_decode_up_to_id_part1[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 2 : 0;
 
   goto exit;
 exit:
@@ -17272,187 +26194,91 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.metadata_fourcc
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__metadata_fourcc(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_fourcc_value;
-}
-
-// -------- func gif.decoder.metadata_chunk_length
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__metadata_chunk_length(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  return self->private_impl.f_metadata_chunk_length_value;
-}
-
-// -------- func gif.decoder.num_animation_loops
-
-WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_gif__decoder__num_animation_loops(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
-
-  if (self->private_impl.f_seen_num_loops) {
-    return self->private_impl.f_num_loops;
-  }
-  return 1;
-}
-
-// -------- func gif.decoder.num_decoded_frame_configs
-
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frame_configs(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
-  }
+// -------- func gif.decoder.decode_header
 
-  return self->private_impl.f_num_decoded_frame_configs_value;
-}
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
+                                  wuffs_base__io_buffer* a_src) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-// -------- func gif.decoder.num_decoded_frames
+  uint8_t v_c[6] = {0};
+  uint32_t v_i = 0;
 
-WUFFS_BASE__MAYBE_STATIC uint64_t  //
-wuffs_gif__decoder__num_decoded_frames(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return 0;
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return 0;
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  return self->private_impl.f_num_decoded_frames_value;
-}
-
-// -------- func gif.decoder.frame_dirty_rect
-
-WUFFS_BASE__MAYBE_STATIC wuffs_base__rect_ie_u32  //
-wuffs_gif__decoder__frame_dirty_rect(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_rect_ie_u32();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_rect_ie_u32();
+  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  if (coro_susp_point) {
+    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
+    v_i = self->private_data.s_decode_header[0].v_i;
   }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-  return wuffs_base__utility__make_rect_ie_u32(
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                           self->private_impl.f_height),
-      wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                           self->private_impl.f_width),
-      wuffs_base__u32__min(self->private_impl.f_dirty_max_excl_y,
-                           self->private_impl.f_height));
-}
-
-// -------- func gif.decoder.workbuf_len
+    while (v_i < 6) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c[v_i] = t_0;
+      }
+      v_i += 1;
+    }
+    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
+        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+      goto exit;
+    }
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__range_ii_u64  //
-wuffs_gif__decoder__workbuf_len(const wuffs_gif__decoder* self) {
-  if (!self) {
-    return wuffs_base__utility__empty_range_ii_u64();
-  }
-  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
-      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
-    return wuffs_base__utility__empty_range_ii_u64();
+    goto ok;
+  ok:
+    self->private_impl.p_decode_header[0] = 0;
+    goto exit;
   }
 
-  return wuffs_base__utility__make_range_ii_u64(0, 0);
-}
-
-// -------- func gif.decoder.restart_frame
+  goto suspend;
+suspend:
+  self->private_impl.p_decode_header[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
+  self->private_data.s_decode_header[0].v_i = v_i;
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__restart_frame(wuffs_gif__decoder* self,
-                                  uint64_t a_index,
-                                  uint64_t a_io_position) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
+  goto exit;
+exit:
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (self->private_impl.f_call_sequence == 0) {
-    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
-  }
-  self->private_impl.f_delayed_num_decoded_frames = false;
-  self->private_impl.f_end_of_data = false;
-  self->private_impl.f_restarted = true;
-  self->private_impl.f_frame_config_io_position = a_io_position;
-  self->private_impl.f_num_decoded_frame_configs_value = a_index;
-  self->private_impl.f_num_decoded_frames_value = a_index;
-  wuffs_gif__decoder__reset_gc(self);
-  return wuffs_base__make_status(NULL);
+  return status;
 }
 
-// -------- func gif.decoder.decode_frame_config
+// -------- func gif.decoder.decode_lsd
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
-                                        wuffs_base__frame_config* a_dst,
-                                        wuffs_base__io_buffer* a_src) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 3)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
+                               wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t v_background_color = 0;
   uint8_t v_flags = 0;
+  uint8_t v_background_color_index = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_j = 0;
+  uint32_t v_argb = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17465,114 +26291,191 @@ wuffs_gif__decoder__decode_frame_config(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame_config[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
   if (coro_susp_point) {
-    v_background_color =
-        self->private_data.s_decode_frame_config[0].v_background_color;
-  }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    self->private_impl.f_ignore_metadata = true;
-    self->private_impl.f_dirty_max_excl_y = 0;
-    if (!self->private_impl.f_end_of_data) {
-      if (self->private_impl.f_call_sequence == 0) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        status = wuffs_gif__decoder__decode_image_config(self, NULL, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
-        }
-      } else if (self->private_impl.f_call_sequence != 3) {
-        if (self->private_impl.f_call_sequence == 4) {
-          if (a_src) {
-            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    v_flags = self->private_data.s_decode_lsd[0].v_flags;
+    v_background_color_index =
+        self->private_data.s_decode_lsd[0].v_background_color_index;
+    v_num_palette_entries =
+        self->private_data.s_decode_lsd[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_lsd[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      uint32_t t_0;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          status = wuffs_gif__decoder__skip_frame(self, a_src);
-          if (a_src) {
-            iop_a_src = a_src->data.ptr + a_src->meta.ri;
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
+          if (num_bits_0 == 8) {
+            t_0 = ((uint32_t)(*scratch));
+            break;
           }
-          if (status.repr) {
+          num_bits_0 += 8;
+          *scratch |= ((uint64_t)(num_bits_0)) << 56;
+        }
+      }
+      self->private_impl.f_width = t_0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint32_t t_1;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_lsd[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_up_to_id_part1(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
-        }
-        if (status.repr) {
-          goto suspend;
+          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
+          if (num_bits_1 == 8) {
+            t_1 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_1 += 8;
+          *scratch |= ((uint64_t)(num_bits_1)) << 56;
         }
       }
+      self->private_impl.f_height = t_1;
     }
-    if (self->private_impl.f_end_of_data) {
-      status = wuffs_base__make_status(wuffs_base__note__end_of_data);
-      goto ok;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_2 = *iop_a_src++;
+      v_flags = t_2;
     }
-    v_background_color = self->private_impl.f_black_color_u32_argb_premul;
-    if (!self->private_impl.f_gc_has_transparent_index) {
-      v_background_color =
-          self->private_impl.f_background_color_u32_argb_premul;
-      if (self->private_impl
-              .f_quirk_enabled_first_frame_local_palette_means_black_background &&
-          (self->private_impl.f_num_decoded_frame_configs_value == 0)) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(4);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      v_background_color_index = t_3;
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      goto suspend;
+    }
+    iop_a_src++;
+    v_i = 0;
+    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
+    if (self->private_impl.f_has_global_palette) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_lsd[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+              if (num_bits_4 == 16) {
+                t_4 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4));
+            }
+          }
+          v_argb = t_4;
         }
-        v_flags = wuffs_base__load_u8be__no_bounds_check(iop_a_src);
-        if ((v_flags & 128) != 0) {
-          v_background_color = self->private_impl.f_black_color_u32_argb_premul;
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
+      }
+      if (self->private_impl.f_quirk_enabled_honor_background_color) {
+        if ((v_background_color_index != 0) &&
+            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
+          v_j = (4 * ((uint32_t)(v_background_color_index)));
+          self->private_impl.f_background_color_u32_argb_premul =
+              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
+                << 0) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
+                << 8) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
+                << 16) |
+               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
+                << 24));
+        } else {
+          self->private_impl.f_background_color_u32_argb_premul = 77;
         }
       }
     }
-    if (a_dst != NULL) {
-      wuffs_base__frame_config__update(
-          a_dst,
-          wuffs_base__utility__make_rect_ie_u32(
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x0,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y0,
-                                   self->private_impl.f_height),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_x1,
-                                   self->private_impl.f_width),
-              wuffs_base__u32__min(self->private_impl.f_frame_rect_y1,
-                                   self->private_impl.f_height)),
-          ((wuffs_base__flicks)(self->private_impl.f_gc_duration)),
-          self->private_impl.f_num_decoded_frame_configs_value,
-          self->private_impl.f_frame_config_io_position,
-          self->private_impl.f_gc_disposal,
-          !self->private_impl.f_gc_has_transparent_index, false,
-          v_background_color);
+    while (v_i < 256) {
+      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
+      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
+      v_i += 1;
     }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frame_configs_value, 1);
-    self->private_impl.f_call_sequence = 4;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame_config[0] = 0;
+    self->private_impl.p_decode_lsd[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame_config[0] =
+  self->private_impl.p_decode_lsd[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 3 : 0;
-  self->private_data.s_decode_frame_config[0].v_background_color =
-      v_background_color;
+  self->private_data.s_decode_lsd[0].v_flags = v_flags;
+  self->private_data.s_decode_lsd[0].v_background_color_index =
+      v_background_color_index;
+  self->private_data.s_decode_lsd[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_lsd[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -17580,21 +26483,17 @@ exit:
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-  }
   return status;
 }
 
-// -------- func gif.decoder.skip_frame
+// -------- func gif.decoder.decode_extension
 
 static wuffs_base__status  //
-wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
+                                     wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_lw = 0;
+  uint8_t v_label = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17607,7 +26506,7 @@ wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_frame[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
@@ -17620,34 +26519,36 @@ wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
         goto suspend;
       }
       uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
+      v_label = t_0;
     }
-    if ((v_flags & 128) != 0) {
-      self->private_data.s_skip_frame[0].scratch =
-          (((uint32_t)(3)) << (1 + (v_flags & 7)));
+    if (v_label == 249) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_frame[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_frame[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__decoder__decode_gc(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_frame[0].scratch;
-    }
-    {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    } else if (v_label == 255) {
+      if (a_src) {
+        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__decoder__decode_ae(self, a_src);
+      if (a_src) {
+        iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      }
+      if (status.repr) {
         goto suspend;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_lw = t_1;
-    }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
+      status = wuffs_base__make_status(NULL);
+      goto ok;
     }
     if (a_src) {
       a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
@@ -17660,23 +26561,16 @@ wuffs_gif__decoder__skip_frame(wuffs_gif__decoder* self,
     if (status.repr) {
       goto suspend;
     }
-    if (self->private_impl.f_quirk_enabled_delay_num_decoded_frames) {
-      self->private_impl.f_delayed_num_decoded_frames = true;
-    } else {
-      wuffs_base__u64__sat_add_indirect(
-          &self->private_impl.f_num_decoded_frames_value, 1);
-    }
-    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_skip_frame[0] = 0;
+    self->private_impl.p_decode_extension[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_frame[0] =
+  self->private_impl.p_decode_extension[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -17688,114 +26582,92 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_frame
+// -------- func gif.decoder.skip_blocks
 
-WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
-wuffs_gif__decoder__decode_frame(wuffs_gif__decoder* self,
-                                 wuffs_base__pixel_buffer* a_dst,
-                                 wuffs_base__io_buffer* a_src,
-                                 wuffs_base__pixel_blend a_blend,
-                                 wuffs_base__slice_u8 a_workbuf,
-                                 wuffs_base__decode_frame_options* a_opts) {
-  if (!self) {
-    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
-  }
-  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
-    return wuffs_base__make_status(
-        (self->private_impl.magic == WUFFS_BASE__DISABLED)
-            ? wuffs_base__error__disabled_by_previous_error
-            : wuffs_base__error__initialize_not_called);
-  }
-  if (!a_dst || !a_src) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(wuffs_base__error__bad_argument);
-  }
-  if ((self->private_impl.active_coroutine != 0) &&
-      (self->private_impl.active_coroutine != 4)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
-    return wuffs_base__make_status(
-        wuffs_base__error__interleaved_coroutine_calls);
-  }
-  self->private_impl.active_coroutine = 0;
+static wuffs_base__status  //
+wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
+                                wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_frame[0];
+  uint8_t v_block_size = 0;
+
+  uint8_t* iop_a_src = NULL;
+  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_src) {
+    io0_a_src = a_src->data.ptr;
+    io1_a_src = io0_a_src + a_src->meta.ri;
+    iop_a_src = io1_a_src;
+    io2_a_src = io0_a_src + a_src->meta.wi;
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
   if (coro_susp_point) {
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    self->private_impl.f_ignore_metadata = true;
-    if (self->private_impl.f_call_sequence != 4) {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      status = wuffs_gif__decoder__decode_frame_config(self, NULL, a_src);
-      if (status.repr) {
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_block_size = t_0;
+      }
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (self->private_data.s_skip_blocks[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_skip_blocks[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
+      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
     }
-    if (self->private_impl.f_quirk_enabled_reject_empty_frame &&
-        ((self->private_impl.f_frame_rect_x0 ==
-          self->private_impl.f_frame_rect_x1) ||
-         (self->private_impl.f_frame_rect_y0 ==
-          self->private_impl.f_frame_rect_y1))) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
-      goto exit;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-    status = wuffs_gif__decoder__decode_id_part1(self, a_dst, a_src, a_blend);
-    if (status.repr) {
-      goto suspend;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-    status = wuffs_gif__decoder__decode_id_part2(self, a_dst, a_src, a_workbuf);
-    if (status.repr) {
-      goto suspend;
-    }
-    wuffs_base__u64__sat_add_indirect(
-        &self->private_impl.f_num_decoded_frames_value, 1);
-    wuffs_gif__decoder__reset_gc(self);
 
     goto ok;
   ok:
-    self->private_impl.p_decode_frame[0] = 0;
+    self->private_impl.p_skip_blocks[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_frame[0] =
+  self->private_impl.p_skip_blocks[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_impl.active_coroutine =
-      wuffs_base__status__is_suspension(&status) ? 4 : 0;
 
   goto exit;
 exit:
-  if (wuffs_base__status__is_error(&status)) {
-    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  if (a_src) {
+    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
-  return status;
-}
-
-// -------- func gif.decoder.reset_gc
 
-static wuffs_base__empty_struct  //
-wuffs_gif__decoder__reset_gc(wuffs_gif__decoder* self) {
-  self->private_impl.f_call_sequence = 5;
-  self->private_impl.f_gc_has_transparent_index = false;
-  self->private_impl.f_gc_transparent_index = 0;
-  self->private_impl.f_gc_disposal = 0;
-  self->private_impl.f_gc_duration = 0;
-  return wuffs_base__make_empty_struct();
+  return status;
 }
 
-// -------- func gif.decoder.decode_up_to_id_part1
+// -------- func gif.decoder.decode_ae
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
-                                          wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_type = 0;
+  uint8_t v_c = 0;
+  uint8_t v_block_size = 0;
+  bool v_is_animexts = false;
+  bool v_is_netscape = false;
+  bool v_is_iccp = false;
+  bool v_is_xmp = false;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17808,26 +26680,17 @@ wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_up_to_id_part1[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
   if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
+    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
+    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
+    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
+    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    if (!self->private_impl.f_restarted) {
-      if (self->private_impl.f_call_sequence != 2) {
-        self->private_impl.f_frame_config_io_position =
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src)));
-      }
-    } else if (self->private_impl.f_frame_config_io_position !=
-               wuffs_base__u64__sat_add(a_src->meta.pos,
-                                        ((uint64_t)(iop_a_src - io0_a_src)))) {
-      status = wuffs_base__make_status(wuffs_base__error__bad_restart);
-      goto exit;
-    } else {
-      self->private_impl.f_restarted = false;
-    }
     while (true) {
       {
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
@@ -17836,63 +26699,214 @@ wuffs_gif__decoder__decode_up_to_id_part1(wuffs_gif__decoder* self,
           goto suspend;
         }
         uint8_t t_0 = *iop_a_src++;
-        v_block_type = t_0;
+        v_block_size = t_0;
       }
-      if (v_block_type == 33) {
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+      if (v_block_size == 0) {
+        status = wuffs_base__make_status(NULL);
+        goto ok;
+      }
+      if (v_block_size != 11) {
+        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (self->private_data.s_decode_ae[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_decode_ae[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        goto label__0__break;
+      }
+      v_is_animexts = true;
+      v_is_netscape = true;
+      v_is_iccp = true;
+      v_is_xmp = true;
+      v_block_size = 0;
+      while (v_block_size < 11) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_1 = *iop_a_src++;
+          v_c = t_1;
+        }
+        v_is_animexts =
+            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
+        v_is_netscape =
+            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
+        v_is_iccp =
+            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
+        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        v_block_size += 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+      }
+      if (v_is_animexts || v_is_netscape) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_2 = *iop_a_src++;
+          v_block_size = t_2;
+        }
+        if (v_block_size != 3) {
+          self->private_data.s_decode_ae[0].scratch =
+              ((uint32_t)(v_block_size));
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__0__break;
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        status = wuffs_gif__decoder__decode_extension(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint8_t t_3 = *iop_a_src++;
+          v_c = t_3;
         }
-        if (status.repr) {
-          goto suspend;
+        if (v_c != 1) {
+          self->private_data.s_decode_ae[0].scratch = 2;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          if (self->private_data.s_decode_ae[0].scratch >
+              ((uint64_t)(io2_a_src - iop_a_src))) {
+            self->private_data.s_decode_ae[0].scratch -=
+                ((uint64_t)(io2_a_src - iop_a_src));
+            iop_a_src = io2_a_src;
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+          goto label__0__break;
         }
-      } else if (v_block_type == 44) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((uint32_t)(
+                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_decode_ae[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          self->private_impl.f_num_loops = t_4;
         }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        self->private_impl.f_seen_num_loops = true;
+        if ((0 < self->private_impl.f_num_loops) &&
+            (self->private_impl.f_num_loops <= 65535)) {
+          self->private_impl.f_num_loops += 1;
         }
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-        status = wuffs_gif__decoder__decode_id_part0(self, a_src);
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      } else if (self->private_impl.f_ignore_metadata) {
+      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
         }
-        if (status.repr) {
-          goto suspend;
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+        self->private_impl.f_metadata_fourcc_value = 1229144912;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
+      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
+        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
         }
-        goto label__0__break;
-      } else if (v_block_type == 59) {
-        if (self->private_impl.f_delayed_num_decoded_frames) {
-          self->private_impl.f_delayed_num_decoded_frames = false;
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_num_decoded_frames_value, 1);
+        self->private_impl.f_metadata_chunk_length_value =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        if (self->private_impl.f_metadata_chunk_length_value > 0) {
+          self->private_impl.f_metadata_chunk_length_value += 1;
+        } else {
+          (iop_a_src += 1, wuffs_base__make_empty_struct());
         }
-        self->private_impl.f_end_of_data = true;
-        goto label__0__break;
-      } else {
-        status = wuffs_base__make_status(wuffs_gif__error__bad_block);
-        goto exit;
+        self->private_impl.f_metadata_fourcc_value = 1481461792;
+        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
+            wuffs_base__u64__sat_add(a_src->meta.pos,
+                                     ((uint64_t)(iop_a_src - io0_a_src))),
+            self->private_impl.f_metadata_chunk_length_value);
+        self->private_impl.f_call_sequence = 1;
+        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
+        goto ok;
       }
+      goto label__0__break;
     }
   label__0__break:;
+    if (a_src) {
+      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+    status = wuffs_gif__decoder__skip_blocks(self, a_src);
+    if (a_src) {
+      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_up_to_id_part1[0] = 0;
+    self->private_impl.p_decode_ae[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_up_to_id_part1[0] =
+  self->private_impl.p_decode_ae[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
+  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
+  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
+  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
+  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
 
   goto exit;
 exit:
@@ -17903,15 +26917,16 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_header
+// -------- func gif.decoder.decode_gc
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
-                                  wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
+                              wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c[6] = {0};
-  uint32_t v_i = 0;
+  uint8_t v_c = 0;
+  uint8_t v_flags = 0;
+  uint16_t v_gc_duration_centiseconds = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17924,44 +26939,108 @@ wuffs_gif__decoder__decode_header(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_header[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
   if (coro_susp_point) {
-    memcpy(v_c, self->private_data.s_decode_header[0].v_c, sizeof(v_c));
-    v_i = self->private_data.s_decode_header[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (v_i < 6) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_c = t_0;
+    }
+    if (v_c != 4) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
+      goto exit;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_1 = *iop_a_src++;
+      v_flags = t_1;
+    }
+    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
+    v_flags = ((v_flags >> 2) & 7);
+    if (v_flags == 2) {
+      self->private_impl.f_gc_disposal = 1;
+    } else if ((v_flags == 3) || (v_flags == 4)) {
+      self->private_impl.f_gc_disposal = 2;
+    } else {
+      self->private_impl.f_gc_disposal = 0;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+      uint16_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_gc[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint16_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
         }
-        uint8_t t_0 = *iop_a_src++;
-        v_c[v_i] = t_0;
       }
-      v_i += 1;
+      v_gc_duration_centiseconds = t_2;
     }
-    if ((v_c[0] != 71) || (v_c[1] != 73) || (v_c[2] != 70) || (v_c[3] != 56) ||
-        ((v_c[4] != 55) && (v_c[4] != 57)) || (v_c[5] != 97)) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_header);
+    self->private_impl.f_gc_duration =
+        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_3 = *iop_a_src++;
+      self->private_impl.f_gc_transparent_index = t_3;
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_4 = *iop_a_src++;
+      v_c = t_4;
+    }
+    if (v_c != 0) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
       goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_header[0] = 0;
+    self->private_impl.p_decode_gc[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_header[0] =
+  self->private_impl.p_decode_gc[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  memcpy(self->private_data.s_decode_header[0].v_c, v_c, sizeof(v_c));
-  self->private_data.s_decode_header[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -17972,20 +27051,13 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_lsd
+// -------- func gif.decoder.decode_id_part0
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
-                               wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
+                                    wuffs_base__io_buffer* a_src) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_background_color_index = 0;
-  uint32_t v_num_palette_entries = 0;
-  uint32_t v_i = 0;
-  uint32_t v_j = 0;
-  uint32_t v_argb = 0;
-
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -17997,14 +27069,8 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_lsd[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
   if (coro_susp_point) {
-    v_flags = self->private_data.s_decode_lsd[0].v_flags;
-    v_background_color_index =
-        self->private_data.s_decode_lsd[0].v_background_color_index;
-    v_num_palette_entries =
-        self->private_data.s_decode_lsd[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_lsd[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
@@ -18016,7 +27082,7 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
         t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
         iop_a_src += 2;
       } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
+        self->private_data.s_decode_id_part0[0].scratch = 0;
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
         while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
@@ -18024,7 +27090,7 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
           uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
           *scratch <<= 8;
           *scratch >>= 8;
@@ -18037,7 +27103,7 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
           *scratch |= ((uint64_t)(num_bits_0)) << 56;
         }
       }
-      self->private_impl.f_width = t_0;
+      self->private_impl.f_frame_rect_x0 = t_0;
     }
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
@@ -18046,7 +27112,7 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
         t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
         iop_a_src += 2;
       } else {
-        self->private_data.s_decode_lsd[0].scratch = 0;
+        self->private_data.s_decode_id_part0[0].scratch = 0;
         WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
         while (true) {
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
@@ -18054,7 +27120,7 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
           uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
           *scratch <<= 8;
           *scratch >>= 8;
@@ -18067,216 +27133,89 @@ wuffs_gif__decoder__decode_lsd(wuffs_gif__decoder* self,
           *scratch |= ((uint64_t)(num_bits_1)) << 56;
         }
       }
-      self->private_impl.f_height = t_1;
+      self->private_impl.f_frame_rect_y0 = t_1;
     }
     {
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_2 = *iop_a_src++;
-      v_flags = t_2;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      v_background_color_index = t_3;
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-    if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-      goto suspend;
-    }
-    iop_a_src++;
-    v_i = 0;
-    self->private_impl.f_has_global_palette = ((v_flags & 128) != 0);
-    if (self->private_impl.f_has_global_palette) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_lsd[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_lsd[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
-              if (num_bits_4 == 16) {
-                t_4 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4));
-            }
+      uint32_t t_2;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
           }
-          v_argb = t_4;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[0][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[0][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      if (self->private_impl.f_quirk_enabled_honor_background_color) {
-        if ((v_background_color_index != 0) &&
-            (((uint32_t)(v_background_color_index)) < v_num_palette_entries)) {
-          v_j = (4 * ((uint32_t)(v_background_color_index)));
-          self->private_impl.f_background_color_u32_argb_premul =
-              ((((uint32_t)(self->private_data.f_palettes[0][(v_j + 0)]))
-                << 0) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 1)]))
-                << 8) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 2)]))
-                << 16) |
-               (((uint32_t)(self->private_data.f_palettes[0][(v_j + 3)]))
-                << 24));
-        } else {
-          self->private_impl.f_background_color_u32_argb_premul = 77;
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
+          if (num_bits_2 == 8) {
+            t_2 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_2 += 8;
+          *scratch |= ((uint64_t)(num_bits_2)) << 56;
         }
       }
+      self->private_impl.f_frame_rect_x1 = t_2;
     }
-    while (v_i < 256) {
-      self->private_data.f_palettes[0][((4 * v_i) + 0)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 1)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 2)] = 0;
-      self->private_data.f_palettes[0][((4 * v_i) + 3)] = 255;
-      v_i += 1;
-    }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_lsd[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_lsd[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_lsd[0].v_flags = v_flags;
-  self->private_data.s_decode_lsd[0].v_background_color_index =
-      v_background_color_index;
-  self->private_data.s_decode_lsd[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_lsd[0].v_i = v_i;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-  }
-
-  return status;
-}
-
-// -------- func gif.decoder.decode_extension
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_extension(wuffs_gif__decoder* self,
-                                     wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  uint8_t v_label = 0;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
-
-  uint32_t coro_susp_point = self->private_impl.p_decode_extension[0];
-  if (coro_susp_point) {
-  }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
+    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
     {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_label = t_0;
-    }
-    if (v_label == 249) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      status = wuffs_gif__decoder__decode_gc(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
-      }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    } else if (v_label == 255) {
-      if (a_src) {
-        a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-      }
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      status = wuffs_gif__decoder__decode_ae(self, a_src);
-      if (a_src) {
-        iop_a_src = a_src->data.ptr + a_src->meta.ri;
-      }
-      if (status.repr) {
-        goto suspend;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      uint32_t t_3;
+      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+        iop_a_src += 2;
+      } else {
+        self->private_data.s_decode_id_part0[0].scratch = 0;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+        while (true) {
+          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+            status =
+                wuffs_base__make_status(wuffs_base__suspension__short_read);
+            goto suspend;
+          }
+          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
+          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
+          *scratch <<= 8;
+          *scratch >>= 8;
+          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
+          if (num_bits_3 == 8) {
+            t_3 = ((uint32_t)(*scratch));
+            break;
+          }
+          num_bits_3 += 8;
+          *scratch |= ((uint64_t)(num_bits_3)) << 56;
+        }
       }
-      status = wuffs_base__make_status(NULL);
-      goto ok;
-    }
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
+      self->private_impl.f_frame_rect_y1 = t_3;
     }
-    if (status.repr) {
-      goto suspend;
+    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
+    self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+    self->private_impl.f_dst_y = self->private_impl.f_frame_rect_y0;
+    if ((self->private_impl.f_call_sequence == 0) &&
+        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
+      self->private_impl.f_width = wuffs_base__u32__max(
+          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
+      self->private_impl.f_height = wuffs_base__u32__max(
+          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_extension[0] = 0;
+    self->private_impl.p_decode_id_part0[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_extension[0] =
+  self->private_impl.p_decode_id_part0[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
 
   goto exit;
@@ -18288,14 +27227,23 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.skip_blocks
+// -------- func gif.decoder.decode_id_part1
 
 static wuffs_base__status  //
-wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
-                                wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__pixel_blend a_blend) {
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_block_size = 0;
+  uint8_t v_flags = 0;
+  uint8_t v_which_palette = 0;
+  uint32_t v_num_palette_entries = 0;
+  uint32_t v_i = 0;
+  uint32_t v_argb = 0;
+  wuffs_base__slice_u8 v_dst_palette = {0};
+  wuffs_base__status v_status = wuffs_base__make_status(NULL);
+  uint8_t v_lw = 0;
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18308,49 +27256,169 @@ wuffs_gif__decoder__skip_blocks(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_skip_blocks[0];
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part1[0];
   if (coro_susp_point) {
+    v_which_palette = self->private_data.s_decode_id_part1[0].v_which_palette;
+    v_num_palette_entries =
+        self->private_data.s_decode_id_part1[0].v_num_palette_entries;
+    v_i = self->private_data.s_decode_id_part1[0].v_i;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        goto suspend;
+      }
+      uint8_t t_0 = *iop_a_src++;
+      v_flags = t_0;
+    }
+    if ((v_flags & 64) != 0) {
+      self->private_impl.f_interlace = 4;
+    } else {
+      self->private_impl.f_interlace = 0;
+    }
+    v_which_palette = 1;
+    if ((v_flags & 128) != 0) {
+      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
+      v_i = 0;
+      while (v_i < v_num_palette_entries) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+          uint32_t t_1;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
+            t_1 = ((uint32_t)(
+                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
+            iop_a_src += 3;
+          } else {
+            self->private_data.s_decode_id_part1[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch =
+                  &self->private_data.s_decode_id_part1[0].scratch;
+              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              *scratch >>= 8;
+              *scratch <<= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+              if (num_bits_1 == 16) {
+                t_1 = ((uint32_t)(*scratch >> 40));
+                break;
+              }
+              num_bits_1 += 8;
+              *scratch |= ((uint64_t)(num_bits_1));
+            }
+          }
+          v_argb = t_1;
         }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
+        v_argb |= 4278190080;
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] =
+            ((uint8_t)(((v_argb >> 0) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] =
+            ((uint8_t)(((v_argb >> 8) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] =
+            ((uint8_t)(((v_argb >> 16) & 255)));
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] =
+            ((uint8_t)(((v_argb >> 24) & 255)));
+        v_i += 1;
       }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
+      while (v_i < 256) {
+        self->private_data.f_palettes[1][((4 * v_i) + 0)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 1)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 2)] = 0;
+        self->private_data.f_palettes[1][((4 * v_i) + 3)] = 255;
+        v_i += 1;
       }
-      self->private_data.s_skip_blocks[0].scratch = ((uint32_t)(v_block_size));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (self->private_data.s_skip_blocks[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_skip_blocks[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
+    } else if (self->private_impl.f_quirk_enabled_reject_empty_palette &&
+               !self->private_impl.f_has_global_palette) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_palette);
+      goto exit;
+    } else if (self->private_impl.f_gc_has_transparent_index) {
+      wuffs_base__slice_u8__copy_from_slice(
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024),
+          wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024));
+    } else {
+      v_which_palette = 0;
+    }
+    if (self->private_impl.f_gc_has_transparent_index) {
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 0)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 1)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 2)] =
+          0;
+      self->private_data.f_palettes[1][(
+          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 3)] =
+          0;
+    }
+    v_dst_palette = wuffs_base__pixel_buffer__palette(a_dst);
+    if (((uint64_t)(v_dst_palette.len)) == 0) {
+      v_dst_palette =
+          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024);
+    }
+    v_status = wuffs_base__pixel_swizzler__prepare(
+        &self->private_impl.f_swizzler,
+        wuffs_base__pixel_buffer__pixel_format(a_dst), v_dst_palette,
+        wuffs_base__utility__make_pixel_format(1191444488),
+        wuffs_base__make_slice_u8(
+            self->private_data.f_palettes[v_which_palette], 1024),
+        a_blend);
+    if (!wuffs_base__status__is_ok(&v_status)) {
+      status = v_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
+      }
+      goto ok;
+    }
+    if (self->private_impl.f_previous_lzw_decode_ended_abruptly) {
+      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(
+          &self->private_data.f_lzw, sizeof(wuffs_lzw__decoder), WUFFS_VERSION,
+          0));
+    }
+    {
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      iop_a_src += self->private_data.s_skip_blocks[0].scratch;
+      uint8_t t_2 = *iop_a_src++;
+      v_lw = t_2;
+    }
+    if (v_lw > 8) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
+      goto exit;
     }
+    wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw,
+                                          ((uint32_t)(v_lw)));
+    self->private_impl.f_previous_lzw_decode_ended_abruptly = true;
 
     goto ok;
   ok:
-    self->private_impl.p_skip_blocks[0] = 0;
+    self->private_impl.p_decode_id_part1[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_skip_blocks[0] =
+  self->private_impl.p_decode_id_part1[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_decode_id_part1[0].v_which_palette = v_which_palette;
+  self->private_data.s_decode_id_part1[0].v_num_palette_entries =
+      v_num_palette_entries;
+  self->private_data.s_decode_id_part1[0].v_i = v_i;
 
   goto exit;
 exit:
@@ -18361,19 +27429,31 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_ae
+// -------- func gif.decoder.decode_id_part2
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
+wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
+                                    wuffs_base__pixel_buffer* a_dst,
+                                    wuffs_base__io_buffer* a_src,
+                                    wuffs_base__slice_u8 a_workbuf) {
+  wuffs_base__io_buffer empty_io_buffer = wuffs_base__empty_io_buffer();
+
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_c = 0;
-  uint8_t v_block_size = 0;
-  bool v_is_animexts = false;
-  bool v_is_netscape = false;
-  bool v_is_iccp = false;
-  bool v_is_xmp = false;
+  uint64_t v_block_size = 0;
+  bool v_need_block_size = false;
+  uint64_t v_n_compressed = 0;
+  wuffs_base__slice_u8 v_compressed = {0};
+  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_r = &u_r;
+  uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_mark = 0;
+  wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
+  wuffs_base__status v_copy_status = wuffs_base__make_status(NULL);
+  wuffs_base__slice_u8 v_uncompressed = {0};
 
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -18385,234 +27465,198 @@ wuffs_gif__decoder__decode_ae(wuffs_gif__decoder* self,
     iop_a_src = io1_a_src;
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
-
-  uint32_t coro_susp_point = self->private_impl.p_decode_ae[0];
-  if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_ae[0].v_block_size;
-    v_is_animexts = self->private_data.s_decode_ae[0].v_is_animexts;
-    v_is_netscape = self->private_data.s_decode_ae[0].v_is_netscape;
-    v_is_iccp = self->private_data.s_decode_ae[0].v_is_iccp;
-    v_is_xmp = self->private_data.s_decode_ae[0].v_is_xmp;
-  }
+
+  uint32_t coro_susp_point = self->private_impl.p_decode_id_part2[0];
+  if (coro_susp_point) {
+    v_block_size = self->private_data.s_decode_id_part2[0].v_block_size;
+    v_need_block_size =
+        self->private_data.s_decode_id_part2[0].v_need_block_size;
+    v_lzw_status = self->private_data.s_decode_id_part2[0].v_lzw_status;
+  }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
+    v_need_block_size = true;
+  label__outer__continue:;
     while (true) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        uint8_t t_0 = *iop_a_src++;
-        v_block_size = t_0;
-      }
-      if (v_block_size == 0) {
-        status = wuffs_base__make_status(NULL);
-        goto ok;
-      }
-      if (v_block_size != 11) {
-        self->private_data.s_decode_ae[0].scratch = ((uint32_t)(v_block_size));
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        if (self->private_data.s_decode_ae[0].scratch >
-            ((uint64_t)(io2_a_src - iop_a_src))) {
-          self->private_data.s_decode_ae[0].scratch -=
-              ((uint64_t)(io2_a_src - iop_a_src));
-          iop_a_src = io2_a_src;
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          goto suspend;
-        }
-        iop_a_src += self->private_data.s_decode_ae[0].scratch;
-        goto label__0__break;
-      }
-      v_is_animexts = true;
-      v_is_netscape = true;
-      v_is_iccp = true;
-      v_is_xmp = true;
-      v_block_size = 0;
-      while (v_block_size < 11) {
+      if (v_need_block_size) {
+        v_need_block_size = false;
         {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
           if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
             status =
                 wuffs_base__make_status(wuffs_base__suspension__short_read);
             goto suspend;
           }
-          uint8_t t_1 = *iop_a_src++;
-          v_c = t_1;
+          uint64_t t_0 = *iop_a_src++;
+          v_block_size = t_0;
         }
-        v_is_animexts =
-            (v_is_animexts && (v_c == wuffs_gif__animexts1dot0[v_block_size]));
-        v_is_netscape =
-            (v_is_netscape && (v_c == wuffs_gif__netscape2dot0[v_block_size]));
-        v_is_iccp =
-            (v_is_iccp && (v_c == wuffs_gif__iccrgbg1012[v_block_size]));
-        v_is_xmp = (v_is_xmp && (v_c == wuffs_gif__xmpdataxmp[v_block_size]));
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        v_block_size += 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
       }
-      if (v_is_animexts || v_is_netscape) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_2 = *iop_a_src++;
-          v_block_size = t_2;
-        }
-        if (v_block_size != 3) {
-          self->private_data.s_decode_ae[0].scratch =
-              ((uint32_t)(v_block_size));
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+      if (v_block_size == 0) {
+        goto label__outer__break;
+      }
+      while (((uint64_t)(io2_a_src - iop_a_src)) == 0) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
+      }
+      if (self->private_impl.f_compressed_ri ==
+          self->private_impl.f_compressed_wi) {
+        self->private_impl.f_compressed_ri = 0;
+        self->private_impl.f_compressed_wi = 0;
+      }
+      while (self->private_impl.f_compressed_wi <= 3841) {
+        v_n_compressed = wuffs_base__u64__min(
+            v_block_size, ((uint64_t)(io2_a_src - iop_a_src)));
+        if (v_n_compressed <= 0) {
           goto label__0__break;
         }
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_3 = *iop_a_src++;
-          v_c = t_3;
+        v_compressed =
+            wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n_compressed);
+        wuffs_base__slice_u8__copy_from_slice(
+            wuffs_base__slice_u8__subslice_i(
+                wuffs_base__make_slice_u8(self->private_data.f_compressed,
+                                          4096),
+                self->private_impl.f_compressed_wi),
+            v_compressed);
+        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_wi,
+                                          v_n_compressed);
+        wuffs_base__u64__sat_sub_indirect(&v_block_size, v_n_compressed);
+        if (v_block_size > 0) {
+          goto label__0__break;
         }
-        if (v_c != 1) {
-          self->private_data.s_decode_ae[0].scratch = 2;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-          if (self->private_data.s_decode_ae[0].scratch >
-              ((uint64_t)(io2_a_src - iop_a_src))) {
-            self->private_data.s_decode_ae[0].scratch -=
-                ((uint64_t)(io2_a_src - iop_a_src));
-            iop_a_src = io2_a_src;
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          iop_a_src += self->private_data.s_decode_ae[0].scratch;
+        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
+          v_need_block_size = true;
           goto label__0__break;
         }
+        v_block_size =
+            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
+        (iop_a_src += 1, wuffs_base__make_empty_struct());
+      }
+    label__0__break:;
+    label__inner__continue:;
+      while (true) {
+        if ((self->private_impl.f_compressed_ri >
+             self->private_impl.f_compressed_wi) ||
+            (self->private_impl.f_compressed_wi > 4096)) {
+          status = wuffs_base__make_status(
+              wuffs_gif__error__internal_error_inconsistent_ri_wi);
+          goto exit;
+        }
         {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-          uint32_t t_4;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-            t_4 = ((uint32_t)(
-                wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-            iop_a_src += 2;
-          } else {
-            self->private_data.s_decode_ae[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch = &self->private_data.s_decode_ae[0].scratch;
-              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
-              *scratch <<= 8;
-              *scratch >>= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-              if (num_bits_4 == 8) {
-                t_4 = ((uint32_t)(*scratch));
-                break;
-              }
-              num_bits_4 += 8;
-              *scratch |= ((uint64_t)(num_bits_4)) << 56;
-            }
+          wuffs_base__io_buffer* o_0_v_r = v_r;
+          uint8_t* o_0_iop_v_r = iop_v_r;
+          uint8_t* o_0_io0_v_r = io0_v_r;
+          uint8_t* o_0_io1_v_r = io1_v_r;
+          uint8_t* o_0_io2_v_r = io2_v_r;
+          v_r = wuffs_base__io_reader__set(
+              &u_r, &iop_v_r, &io0_v_r, &io1_v_r, &io2_v_r,
+              wuffs_base__slice_u8__subslice_ij(
+                  wuffs_base__make_slice_u8(self->private_data.f_compressed,
+                                            4096),
+                  self->private_impl.f_compressed_ri,
+                  self->private_impl.f_compressed_wi));
+          v_mark = ((uint64_t)(iop_v_r - io0_v_r));
+          {
+            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
+            wuffs_base__status t_1 = wuffs_lzw__decoder__transform_io(
+                &self->private_data.f_lzw, &empty_io_buffer, v_r,
+                wuffs_base__utility__empty_slice_u8());
+            iop_v_r = u_r.data.ptr + u_r.meta.ri;
+            v_lzw_status = t_1;
           }
-          self->private_impl.f_num_loops = t_4;
-        }
-        self->private_impl.f_seen_num_loops = true;
-        if ((0 < self->private_impl.f_num_loops) &&
-            (self->private_impl.f_num_loops <= 65535)) {
-          self->private_impl.f_num_loops += 1;
+          wuffs_base__u64__sat_add_indirect(
+              &self->private_impl.f_compressed_ri,
+              wuffs_base__io__count_since(v_mark,
+                                          ((uint64_t)(iop_v_r - io0_v_r))));
+          v_r = o_0_v_r;
+          iop_v_r = o_0_iop_v_r;
+          io0_v_r = o_0_io0_v_r;
+          io1_v_r = o_0_io1_v_r;
+          io2_v_r = o_0_io2_v_r;
         }
-      } else if (self->private_impl.f_ignore_metadata) {
-      } else if (v_is_iccp && self->private_impl.f_report_metadata_iccp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(10);
+        v_uncompressed = wuffs_lzw__decoder__flush(&self->private_data.f_lzw);
+        if (((uint64_t)(v_uncompressed.len)) > 0) {
+          v_copy_status = wuffs_gif__decoder__copy_to_image_buffer(
+              self, a_dst, v_uncompressed);
+          if (wuffs_base__status__is_error(&v_copy_status)) {
+            status = v_copy_status;
+            goto exit;
+          }
         }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-        self->private_impl.f_metadata_fourcc_value = 1229144912;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
-        goto ok;
-      } else if (v_is_xmp && self->private_impl.f_report_metadata_xmp) {
-        while (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(11);
+        if (wuffs_base__status__is_ok(&v_lzw_status)) {
+          self->private_impl.f_previous_lzw_decode_ended_abruptly = false;
+          if (v_need_block_size || (v_block_size > 0)) {
+            self->private_data.s_decode_id_part2[0].scratch =
+                ((uint32_t)(v_block_size));
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            if (self->private_data.s_decode_id_part2[0].scratch >
+                ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_decode_id_part2[0].scratch -=
+                  ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            status = wuffs_gif__decoder__skip_blocks(self, a_src);
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            if (status.repr) {
+              goto suspend;
+            }
+          }
+          goto label__outer__break;
+        } else if (v_lzw_status.repr ==
+                   wuffs_base__make_status(wuffs_base__suspension__short_read)
+                       .repr) {
+          goto label__outer__continue;
+        } else if (v_lzw_status.repr ==
+                   wuffs_base__make_status(wuffs_base__suspension__short_write)
+                       .repr) {
+          goto label__inner__continue;
         }
-        self->private_impl.f_metadata_chunk_length_value =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        if (self->private_impl.f_metadata_chunk_length_value > 0) {
-          self->private_impl.f_metadata_chunk_length_value += 1;
-        } else {
-          (iop_a_src += 1, wuffs_base__make_empty_struct());
+        status = v_lzw_status;
+        if (wuffs_base__status__is_error(&status)) {
+          goto exit;
+        } else if (wuffs_base__status__is_suspension(&status)) {
+          status = wuffs_base__make_status(
+              wuffs_base__error__cannot_return_a_suspension);
+          goto exit;
         }
-        self->private_impl.f_metadata_fourcc_value = 1481461792;
-        self->private_impl.f_metadata_io_position = wuffs_base__u64__sat_add(
-            wuffs_base__u64__sat_add(a_src->meta.pos,
-                                     ((uint64_t)(iop_a_src - io0_a_src))),
-            self->private_impl.f_metadata_chunk_length_value);
-        self->private_impl.f_call_sequence = 1;
-        status = wuffs_base__make_status(wuffs_base__note__metadata_reported);
         goto ok;
       }
-      goto label__0__break;
-    }
-  label__0__break:;
-    if (a_src) {
-      a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-    }
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
-    status = wuffs_gif__decoder__skip_blocks(self, a_src);
-    if (a_src) {
-      iop_a_src = a_src->data.ptr + a_src->meta.ri;
     }
-    if (status.repr) {
-      goto suspend;
+  label__outer__break:;
+    self->private_impl.f_compressed_ri = 0;
+    self->private_impl.f_compressed_wi = 0;
+    if ((self->private_impl.f_dst_y < self->private_impl.f_frame_rect_y1) &&
+        (self->private_impl.f_frame_rect_x0 !=
+         self->private_impl.f_frame_rect_x1) &&
+        (self->private_impl.f_frame_rect_y0 !=
+         self->private_impl.f_frame_rect_y1)) {
+      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+      goto exit;
     }
 
     goto ok;
   ok:
-    self->private_impl.p_decode_ae[0] = 0;
+    self->private_impl.p_decode_id_part2[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_ae[0] =
+  self->private_impl.p_decode_id_part2[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_ae[0].v_block_size = v_block_size;
-  self->private_data.s_decode_ae[0].v_is_animexts = v_is_animexts;
-  self->private_data.s_decode_ae[0].v_is_netscape = v_is_netscape;
-  self->private_data.s_decode_ae[0].v_is_iccp = v_is_iccp;
-  self->private_data.s_decode_ae[0].v_is_xmp = v_is_xmp;
+  self->private_data.s_decode_id_part2[0].v_block_size = v_block_size;
+  self->private_data.s_decode_id_part2[0].v_need_block_size = v_need_block_size;
+  self->private_data.s_decode_id_part2[0].v_lzw_status = v_lzw_status;
 
   goto exit;
 exit:
@@ -18623,544 +27667,510 @@ exit:
   return status;
 }
 
-// -------- func gif.decoder.decode_gc
+// -------- func gif.decoder.copy_to_image_buffer
 
 static wuffs_base__status  //
-wuffs_gif__decoder__decode_gc(wuffs_gif__decoder* self,
-                              wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
-
-  uint8_t v_c = 0;
-  uint8_t v_flags = 0;
-  uint16_t v_gc_duration_centiseconds = 0;
-
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
-  }
+wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
+                                         wuffs_base__pixel_buffer* a_pb,
+                                         wuffs_base__slice_u8 a_src) {
+  wuffs_base__slice_u8 v_dst = {0};
+  wuffs_base__slice_u8 v_src = {0};
+  uint64_t v_width_in_bytes = 0;
+  uint64_t v_n = 0;
+  uint64_t v_src_ri = 0;
+  wuffs_base__pixel_format v_pixfmt = {0};
+  uint32_t v_bytes_per_pixel = 0;
+  uint32_t v_bits_per_pixel = 0;
+  wuffs_base__table_u8 v_tab = {0};
+  uint64_t v_i = 0;
+  uint64_t v_j = 0;
+  uint32_t v_replicate_y0 = 0;
+  uint32_t v_replicate_y1 = 0;
+  wuffs_base__slice_u8 v_replicate_dst = {0};
+  wuffs_base__slice_u8 v_replicate_src = {0};
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_gc[0];
-  if (coro_susp_point) {
+  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
+  v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
+  if ((v_bits_per_pixel & 7) != 0) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
-
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+  v_bytes_per_pixel = (v_bits_per_pixel >> 3);
+  v_width_in_bytes = (((uint64_t)(self->private_impl.f_width)) *
+                      ((uint64_t)(v_bytes_per_pixel)));
+  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
+label__0__continue:;
+  while (v_src_ri < ((uint64_t)(a_src.len))) {
+    v_src = wuffs_base__slice_u8__subslice_i(a_src, v_src_ri);
+    if (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) {
+      if (self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data) {
+        return wuffs_base__make_status(NULL);
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
+      return wuffs_base__make_status(wuffs_base__error__too_much_data);
     }
-    if (v_c != 4) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
+    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
+    if (self->private_impl.f_dst_y >= self->private_impl.f_height) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
+    } else if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
+      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    v_i = (((uint64_t)(self->private_impl.f_dst_x)) *
+           ((uint64_t)(v_bytes_per_pixel)));
+    if (v_i < ((uint64_t)(v_dst.len))) {
+      v_j = (((uint64_t)(self->private_impl.f_frame_rect_x1)) *
+             ((uint64_t)(v_bytes_per_pixel)));
+      if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
+        v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
+      } else {
+        v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_flags = t_1;
-    }
-    self->private_impl.f_gc_has_transparent_index = ((v_flags & 1) != 0);
-    v_flags = ((v_flags >> 2) & 7);
-    if (v_flags == 2) {
-      self->private_impl.f_gc_disposal = 1;
-    } else if ((v_flags == 3) || (v_flags == 4)) {
-      self->private_impl.f_gc_disposal = 2;
-    } else {
-      self->private_impl.f_gc_disposal = 0;
+      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
+          &self->private_impl.f_swizzler, v_dst,
+          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
+          v_src);
+      wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                        ((uint32_t)((v_n & 4294967295))));
+      self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
+          self->private_impl.f_dirty_max_excl_y,
+          wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1));
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint16_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_gc[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_gc[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint16_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      if (self->private_impl.f_interlace == 0) {
+        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, 1);
+        goto label__0__continue;
+      }
+      if ((self->private_impl.f_num_decoded_frames_value == 0) &&
+          !self->private_impl.f_gc_has_transparent_index &&
+          (self->private_impl.f_interlace > 1)) {
+        v_replicate_src =
+            wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
+        v_replicate_y0 =
+            wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
+        v_replicate_y1 = wuffs_base__u32__sat_add(
+            self->private_impl.f_dst_y,
+            ((uint32_t)(
+                wuffs_gif__interlace_count[self->private_impl.f_interlace])));
+        v_replicate_y1 = wuffs_base__u32__min(
+            v_replicate_y1, self->private_impl.f_frame_rect_y1);
+        while (v_replicate_y0 < v_replicate_y1) {
+          v_replicate_dst = wuffs_base__table_u8__row(v_tab, v_replicate_y0);
+          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst,
+                                                v_replicate_src);
+          v_replicate_y0 += 1;
         }
+        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
+            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
+      }
+      wuffs_base__u32__sat_add_indirect(
+          &self->private_impl.f_dst_y,
+          ((uint32_t)(
+              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
+      while (
+          (self->private_impl.f_interlace > 0) &&
+          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
+            self->private_impl.f_frame_rect_y0,
+            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
       }
-      v_gc_duration_centiseconds = t_2;
+      goto label__0__continue;
     }
-    self->private_impl.f_gc_duration =
-        (((uint64_t)(v_gc_duration_centiseconds)) * 7056000);
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_3 = *iop_a_src++;
-      self->private_impl.f_gc_transparent_index = t_3;
+    if (((uint64_t)(a_src.len)) == v_src_ri) {
+      goto label__0__break;
+    } else if (((uint64_t)(a_src.len)) < v_src_ri) {
+      return wuffs_base__make_status(
+          wuffs_gif__error__internal_error_inconsistent_ri_wi);
     }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    v_n = ((uint64_t)(
+        (self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
+    v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
+    wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
+    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
+                                      ((uint32_t)((v_n & 4294967295))));
+    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
+      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
+      wuffs_base__u32__sat_add_indirect(
+          &self->private_impl.f_dst_y,
+          ((uint32_t)(
+              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
+      while (
+          (self->private_impl.f_interlace > 0) &&
+          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
+#if defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wconversion"
+#endif
+        self->private_impl.f_interlace -= 1;
+#if defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
+            self->private_impl.f_frame_rect_y0,
+            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
       }
-      uint8_t t_4 = *iop_a_src++;
-      v_c = t_4;
+      goto label__0__continue;
     }
-    if (v_c != 0) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_graphic_control);
-      goto exit;
+    if (v_src_ri != ((uint64_t)(a_src.len))) {
+      return wuffs_base__make_status(
+          wuffs_gif__error__internal_error_inconsistent_ri_wi);
     }
-
-    goto ok;
-  ok:
-    self->private_impl.p_decode_gc[0] = 0;
-    goto exit;
-  }
-
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_gc[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+    goto label__0__break;
   }
-
-  return status;
+label__0__break:;
+  return wuffs_base__make_status(NULL);
 }
 
-// -------- func gif.decoder.decode_id_part0
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part0(wuffs_gif__decoder* self,
-                                    wuffs_base__io_buffer* a_src) {
-  wuffs_base__status status = wuffs_base__make_status(NULL);
+// -------- func gif.encoder.set_palette
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_palette(wuffs_gif__encoder* self,
+                                wuffs_base__slice_u8 a_palette) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
   }
-
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part0[0];
-  if (coro_susp_point) {
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  switch (coro_susp_point) {
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      uint32_t t_0;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_0 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_0 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_0;
-          if (num_bits_0 == 8) {
-            t_0 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_0 += 8;
-          *scratch |= ((uint64_t)(num_bits_0)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_x0 = t_0;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      uint32_t t_1;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_1 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_1 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_1;
-          if (num_bits_1 == 8) {
-            t_1 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_1 += 8;
-          *scratch |= ((uint64_t)(num_bits_1)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y0 = t_1;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-      uint32_t t_2;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_2 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_2 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_2;
-          if (num_bits_2 == 8) {
-            t_2 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_2 += 8;
-          *scratch |= ((uint64_t)(num_bits_2)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_x1 = t_2;
-    }
-    self->private_impl.f_frame_rect_x1 += self->private_impl.f_frame_rect_x0;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-        t_3 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
-        iop_a_src += 2;
-      } else {
-        self->private_data.s_decode_id_part0[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_decode_id_part0[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_3;
-          if (num_bits_3 == 8) {
-            t_3 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3)) << 56;
-        }
-      }
-      self->private_impl.f_frame_rect_y1 = t_3;
-    }
-    self->private_impl.f_frame_rect_y1 += self->private_impl.f_frame_rect_y0;
-    self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-    self->private_impl.f_dst_y = self->private_impl.f_frame_rect_y0;
-    if ((self->private_impl.f_call_sequence == 0) &&
-        !self->private_impl.f_quirk_enabled_image_bounds_are_strict) {
-      self->private_impl.f_width = wuffs_base__u32__max(
-          self->private_impl.f_width, self->private_impl.f_frame_rect_x1);
-      self->private_impl.f_height = wuffs_base__u32__max(
-          self->private_impl.f_height, self->private_impl.f_frame_rect_y1);
+  uint64_t v_n = 0;
+  uint32_t v_i = 0;
+
+  v_n = (((uint64_t)(a_palette.len)) / 4);
+  v_n = wuffs_base__u64__min(v_n, 256);
+  wuffs_base__slice_u8__copy_from_slice(
+      wuffs_base__make_slice_u8(self->private_data.f_palette, 1024), a_palette);
+  self->private_impl.f_palette_count = ((uint32_t)(v_n));
+  self->private_impl.f_transparent_index = 256;
+  v_i = 0;
+  while (v_i < 256) {
+    if (v_i >= self->private_impl.f_palette_count) {
+      self->private_data.f_palette[((4 * v_i) + 0)] = 0;
+      self->private_data.f_palette[((4 * v_i) + 1)] = 0;
+      self->private_data.f_palette[((4 * v_i) + 2)] = 0;
+      self->private_data.f_palette[((4 * v_i) + 3)] = 0;
+    } else if ((self->private_data.f_palette[((4 * v_i) + 3)] < 128) &&
+               (self->private_impl.f_transparent_index >= 256)) {
+      self->private_impl.f_transparent_index = v_i;
     }
+    v_i += 1;
+  }
+  return wuffs_base__make_empty_struct();
+}
 
-    goto ok;
-  ok:
-    self->private_impl.p_decode_id_part0[0] = 0;
-    goto exit;
+// -------- func gif.encoder.set_num_animation_loops
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_num_animation_loops(wuffs_gif__encoder* self,
+                                            uint32_t a_n) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  goto suspend;
-suspend:
-  self->private_impl.p_decode_id_part0[0] =
-      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.f_num_loops = a_n;
+  return wuffs_base__make_empty_struct();
+}
 
-  goto exit;
-exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+// -------- func gif.encoder.set_frame
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gif__encoder__set_frame(wuffs_gif__encoder* self,
+                              uint32_t a_min_incl_x,
+                              uint32_t a_min_incl_y,
+                              uint32_t a_max_excl_x,
+                              uint32_t a_max_excl_y,
+                              uint64_t a_duration,
+                              uint8_t a_disposal) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
 
-  return status;
+  self->private_impl.f_frame_rect_x0 = a_min_incl_x;
+  self->private_impl.f_frame_rect_y0 = a_min_incl_y;
+  self->private_impl.f_frame_rect_x1 = a_max_excl_x;
+  self->private_impl.f_frame_rect_y1 = a_max_excl_y;
+  self->private_impl.f_frame_duration = a_duration;
+  self->private_impl.f_frame_disposal = a_disposal;
+  return wuffs_base__make_empty_struct();
 }
 
-// -------- func gif.decoder.decode_id_part1
+// -------- func gif.encoder.encode_header
 
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part1(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__pixel_blend a_blend) {
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_header(wuffs_gif__encoder* self,
+                                  wuffs_base__io_buffer* a_dst,
+                                  uint32_t a_width,
+                                  uint32_t a_height) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 1)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint8_t v_flags = 0;
-  uint8_t v_which_palette = 0;
-  uint32_t v_num_palette_entries = 0;
+  uint32_t v_bits_minus_1 = 0;
   uint32_t v_i = 0;
-  uint32_t v_argb = 0;
-  wuffs_base__slice_u8 v_dst_palette = {0};
-  wuffs_base__status v_status = wuffs_base__make_status(NULL);
-  uint8_t v_lw = 0;
+  uint32_t v_c = 0;
+  uint32_t v_n_loops = 0;
 
-  uint8_t* iop_a_src = NULL;
-  uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  if (a_src) {
-    io0_a_src = a_src->data.ptr;
-    io1_a_src = io0_a_src + a_src->meta.ri;
-    iop_a_src = io1_a_src;
-    io2_a_src = io0_a_src + a_src->meta.wi;
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part1[0];
+  uint32_t coro_susp_point = self->private_impl.p_encode_header[0];
   if (coro_susp_point) {
-    v_which_palette = self->private_data.s_decode_id_part1[0].v_which_palette;
-    v_num_palette_entries =
-        self->private_data.s_decode_id_part1[0].v_num_palette_entries;
-    v_i = self->private_data.s_decode_id_part1[0].v_i;
+    v_bits_minus_1 = self->private_data.s_encode_header[0].v_bits_minus_1;
+    v_i = self->private_data.s_encode_header[0].v_i;
+    v_c = self->private_data.s_encode_header[0].v_c;
+    v_n_loops = self->private_data.s_encode_header[0].v_n_loops;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      uint8_t t_0 = *iop_a_src++;
-      v_flags = t_0;
-    }
-    if ((v_flags & 64) != 0) {
-      self->private_impl.f_interlace = 4;
-    } else {
-      self->private_impl.f_interlace = 0;
-    }
-    v_which_palette = 1;
-    if ((v_flags & 128) != 0) {
-      v_num_palette_entries = (((uint32_t)(1)) << (1 + (v_flags & 7)));
-      v_i = 0;
-      while (v_i < v_num_palette_entries) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          uint32_t t_1;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 3)) {
-            t_1 = ((uint32_t)(
-                wuffs_base__load_u24be__no_bounds_check(iop_a_src)));
-            iop_a_src += 3;
-          } else {
-            self->private_data.s_decode_id_part1[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-            while (true) {
-              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-                status =
-                    wuffs_base__make_status(wuffs_base__suspension__short_read);
-                goto suspend;
-              }
-              uint64_t* scratch =
-                  &self->private_data.s_decode_id_part1[0].scratch;
-              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
-              *scratch >>= 8;
-              *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
-              if (num_bits_1 == 16) {
-                t_1 = ((uint32_t)(*scratch >> 40));
-                break;
-              }
-              num_bits_1 += 8;
-              *scratch |= ((uint64_t)(num_bits_1));
-            }
-          }
-          v_argb = t_1;
-        }
-        v_argb |= 4278190080;
-        self->private_data.f_palettes[1][((4 * v_i) + 0)] =
-            ((uint8_t)(((v_argb >> 0) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 1)] =
-            ((uint8_t)(((v_argb >> 8) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 2)] =
-            ((uint8_t)(((v_argb >> 16) & 255)));
-        self->private_data.f_palettes[1][((4 * v_i) + 3)] =
-            ((uint8_t)(((v_argb >> 24) & 255)));
-        v_i += 1;
-      }
-      while (v_i < 256) {
-        self->private_data.f_palettes[1][((4 * v_i) + 0)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 1)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 2)] = 0;
-        self->private_data.f_palettes[1][((4 * v_i) + 3)] = 255;
-        v_i += 1;
-      }
-    } else if (self->private_impl.f_quirk_enabled_reject_empty_palette &&
-               !self->private_impl.f_has_global_palette) {
+    if (self->private_impl.f_call_sequence != 0) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    } else if ((a_width > 65535) || (a_height > 65535)) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_argument);
+      goto exit;
+    } else if (self->private_impl.f_palette_count <= 0) {
       status = wuffs_base__make_status(wuffs_gif__error__bad_palette);
       goto exit;
-    } else if (self->private_impl.f_gc_has_transparent_index) {
-      wuffs_base__slice_u8__copy_from_slice(
-          wuffs_base__make_slice_u8(self->private_data.f_palettes[1], 1024),
-          wuffs_base__make_slice_u8(self->private_data.f_palettes[0], 1024));
-    } else {
-      v_which_palette = 0;
     }
-    if (self->private_impl.f_gc_has_transparent_index) {
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 0)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 1)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 2)] =
-          0;
-      self->private_data.f_palettes[1][(
-          (4 * ((uint32_t)(self->private_impl.f_gc_transparent_index))) + 3)] =
-          0;
+    self->private_impl.f_width = a_width;
+    self->private_impl.f_height = a_height;
+    v_bits_minus_1 = 0;
+    while ((v_bits_minus_1 < 7) && ((((uint32_t)(2)) << v_bits_minus_1) <
+                                    self->private_impl.f_palette_count)) {
+      v_bits_minus_1 += 1;
     }
-    v_dst_palette = wuffs_base__pixel_buffer__palette(a_dst);
-    if (((uint64_t)(v_dst_palette.len)) == 0) {
-      v_dst_palette =
-          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024);
+    self->private_impl.f_palette_bits = (v_bits_minus_1 + 1);
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
     }
-    v_status = wuffs_base__pixel_swizzler__prepare(
-        &self->private_impl.f_swizzler,
-        wuffs_base__pixel_buffer__pixel_format(a_dst), v_dst_palette,
-        wuffs_base__utility__make_pixel_format(1191444488),
-        wuffs_base__make_slice_u8(
-            self->private_data.f_palettes[v_which_palette], 1024),
-        a_blend);
-    if (!wuffs_base__status__is_ok(&v_status)) {
-      status = v_status;
-      if (wuffs_base__status__is_error(&status)) {
-        goto exit;
-      } else if (wuffs_base__status__is_suspension(&status)) {
-        status = wuffs_base__make_status(
-            wuffs_base__error__cannot_return_a_suspension);
-        goto exit;
-      }
-      goto ok;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_gif__encoder__write_le(self, a_dst, 6, 106898385160519);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
     }
-    if (self->private_impl.f_previous_lzw_decode_ended_abruptly) {
-      wuffs_base__ignore_status(wuffs_lzw__decoder__initialize(
-          &self->private_data.f_lzw, sizeof(wuffs_lzw__decoder), WUFFS_VERSION,
-          0));
+    if (status.repr) {
+      goto suspend;
     }
-    {
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    status = wuffs_gif__encoder__write_le(
+        self, a_dst, 4,
+        ((uint64_t)((self->private_impl.f_width |
+                     (self->private_impl.f_height << 16)))));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__encoder__write_le(
+        self, a_dst, 3, ((uint64_t)((128 | (v_bits_minus_1 * 17)))));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    v_i = 0;
+    while (v_i < (((uint32_t)(1)) << self->private_impl.f_palette_bits)) {
+      v_c =
+          ((((uint32_t)(self->private_data.f_palette[((4 * v_i) + 2)])) << 0) |
+           (((uint32_t)(self->private_data.f_palette[((4 * v_i) + 1)])) << 8) |
+           (((uint32_t)(self->private_data.f_palette[((4 * v_i) + 0)])) << 16));
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
       WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+      status = wuffs_gif__encoder__write_le(self, a_dst, 3, ((uint64_t)(v_c)));
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
         goto suspend;
       }
-      uint8_t t_2 = *iop_a_src++;
-      v_lw = t_2;
+      v_i += 1;
     }
-    if (v_lw > 8) {
-      status = wuffs_base__make_status(wuffs_gif__error__bad_literal_width);
-      goto exit;
+    if (self->private_impl.f_num_loops != 1) {
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      status = wuffs_gif__encoder__write_le(self, a_dst, 3, 786209);
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
+      v_i = 0;
+      while (v_i < 11) {
+        self->private_data.s_encode_header[0].scratch =
+            wuffs_gif__netscape2dot0[v_i];
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        if (iop_a_dst == io2_a_dst) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+          goto suspend;
+        }
+        *iop_a_dst++ =
+            ((uint8_t)(self->private_data.s_encode_header[0].scratch));
+        v_i += 1;
+      }
+      v_n_loops = 65535;
+      if (self->private_impl.f_num_loops == 0) {
+        v_n_loops = 0;
+      } else if (self->private_impl.f_num_loops <= 65536) {
+        v_n_loops = (self->private_impl.f_num_loops - 1);
+      }
+      if (a_dst) {
+        a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      }
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+      status = wuffs_gif__encoder__write_le(
+          self, a_dst, 5, (259 | (((uint64_t)(v_n_loops)) << 16)));
+      if (a_dst) {
+        iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+      }
+      if (status.repr) {
+        goto suspend;
+      }
     }
-    wuffs_lzw__decoder__set_literal_width(&self->private_data.f_lzw,
-                                          ((uint32_t)(v_lw)));
-    self->private_impl.f_previous_lzw_decode_ended_abruptly = true;
+    self->private_impl.f_call_sequence = 1;
 
     goto ok;
   ok:
-    self->private_impl.p_decode_id_part1[0] = 0;
+    self->private_impl.p_encode_header[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_id_part1[0] =
+  self->private_impl.p_encode_header[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_id_part1[0].v_which_palette = v_which_palette;
-  self->private_data.s_decode_id_part1[0].v_num_palette_entries =
-      v_num_palette_entries;
-  self->private_data.s_decode_id_part1[0].v_i = v_i;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 1 : 0;
+  self->private_data.s_encode_header[0].v_bits_minus_1 = v_bits_minus_1;
+  self->private_data.s_encode_header[0].v_i = v_i;
+  self->private_data.s_encode_header[0].v_c = v_c;
+  self->private_data.s_encode_header[0].v_n_loops = v_n_loops;
 
   goto exit;
 exit:
-  if (a_src) {
-    a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.decoder.decode_id_part2
-
-static wuffs_base__status  //
-wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
-                                    wuffs_base__pixel_buffer* a_dst,
-                                    wuffs_base__io_buffer* a_src,
-                                    wuffs_base__slice_u8 a_workbuf) {
-  wuffs_base__io_buffer empty_io_buffer = wuffs_base__empty_io_buffer();
+// -------- func gif.encoder.encode_frame
 
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_frame(wuffs_gif__encoder* self,
+                                 wuffs_base__io_buffer* a_dst,
+                                 wuffs_base__io_buffer* a_src) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst || !a_src) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 2)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
   wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  uint64_t v_block_size = 0;
-  bool v_need_block_size = false;
-  uint64_t v_n_compressed = 0;
-  wuffs_base__slice_u8 v_compressed = {0};
-  wuffs_base__io_buffer u_r = wuffs_base__empty_io_buffer();
-  wuffs_base__io_buffer* v_r = &u_r;
-  uint8_t* iop_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io0_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io1_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint8_t* io2_v_r WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
-  uint64_t v_mark = 0;
+  uint32_t v_frame_width = 0;
+  uint32_t v_frame_height = 0;
+  uint32_t v_flags = 0;
+  uint64_t v_delay = 0;
+  uint32_t v_lw = 0;
+  wuffs_base__io_buffer u_w = wuffs_base__empty_io_buffer();
+  wuffs_base__io_buffer* v_w = &u_w;
+  uint8_t* iop_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io0_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_v_w WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint64_t v_w_mark = 0;
+  uint64_t v_r_mark = 0;
+  uint64_t v_n = 0;
   wuffs_base__status v_lzw_status = wuffs_base__make_status(NULL);
-  wuffs_base__status v_copy_status = wuffs_base__make_status(NULL);
-  wuffs_base__slice_u8 v_uncompressed = {0};
 
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
+  }
   uint8_t* iop_a_src = NULL;
   uint8_t* io0_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
   uint8_t* io1_a_src WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -19172,366 +28182,481 @@ wuffs_gif__decoder__decode_id_part2(wuffs_gif__decoder* self,
     io2_a_src = io0_a_src + a_src->meta.wi;
   }
 
-  uint32_t coro_susp_point = self->private_impl.p_decode_id_part2[0];
+  uint32_t coro_susp_point = self->private_impl.p_encode_frame[0];
   if (coro_susp_point) {
-    v_block_size = self->private_data.s_decode_id_part2[0].v_block_size;
-    v_need_block_size =
-        self->private_data.s_decode_id_part2[0].v_need_block_size;
-    v_lzw_status = self->private_data.s_decode_id_part2[0].v_lzw_status;
+    v_frame_width = self->private_data.s_encode_frame[0].v_frame_width;
+    v_frame_height = self->private_data.s_encode_frame[0].v_frame_height;
+    v_flags = self->private_data.s_encode_frame[0].v_flags;
+    v_delay = self->private_data.s_encode_frame[0].v_delay;
+    v_lw = self->private_data.s_encode_frame[0].v_lw;
+    v_lzw_status = self->private_data.s_encode_frame[0].v_lzw_status;
   }
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    v_need_block_size = true;
-  label__outer__continue:;
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
+    } else if ((self->private_impl.f_frame_rect_x0 >
+                self->private_impl.f_frame_rect_x1) ||
+               (self->private_impl.f_frame_rect_x1 >
+                self->private_impl.f_width) ||
+               (self->private_impl.f_frame_rect_y0 >
+                self->private_impl.f_frame_rect_y1) ||
+               (self->private_impl.f_frame_rect_y1 >
+                self->private_impl.f_height)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
+    }
+    v_frame_width = (self->private_impl.f_frame_rect_x1 -
+                     self->private_impl.f_frame_rect_x0);
+    v_frame_height = (self->private_impl.f_frame_rect_y1 -
+                      self->private_impl.f_frame_rect_y0);
+    self->private_impl.f_n_pixels_want =
+        (((uint64_t)(v_frame_width)) * ((uint64_t)(v_frame_height)));
+    self->private_impl.f_n_pixels_have = 0;
+    if ((a_src && a_src->meta.closed) && (((uint64_t)(io2_a_src - iop_a_src)) !=
+                                          self->private_impl.f_n_pixels_want)) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
+      goto exit;
+    }
+    v_flags = 4;
+    if (self->private_impl.f_frame_disposal == 1) {
+      v_flags = 8;
+    } else if (self->private_impl.f_frame_disposal == 2) {
+      v_flags = 12;
+    }
+    if (self->private_impl.f_transparent_index < 256) {
+      v_flags |= 1;
+    }
+    v_delay = (self->private_impl.f_frame_duration / 7056000);
+    v_delay = wuffs_base__u64__min(v_delay, 65535);
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    status = wuffs_gif__encoder__write_le(
+        self, a_dst, 8,
+        (325921 | (((uint64_t)(v_flags)) << 24) | (v_delay << 32) |
+         (((uint64_t)((self->private_impl.f_transparent_index & 255))) << 48)));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    self->private_data.s_encode_frame[0].scratch = 44;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+    status = wuffs_gif__encoder__write_le(
+        self, a_dst, 8,
+        (((uint64_t)((self->private_impl.f_frame_rect_x0 & 65535))) |
+         (((uint64_t)((self->private_impl.f_frame_rect_y0 & 65535))) << 16) |
+         (((uint64_t)((v_frame_width & 65535))) << 32) |
+         (((uint64_t)((v_frame_height & 65535))) << 48)));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    v_lw = wuffs_base__u32__max(self->private_impl.f_palette_bits, 2);
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+    status =
+        wuffs_gif__encoder__write_le(self, a_dst, 2, ((uint64_t)((v_lw << 8))));
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    wuffs_lzw__encoder__set_literal_width(&self->private_data.f_lzw, v_lw);
+    self->private_impl.f_block_n = 0;
+    self->private_impl.f_block_ri = 0;
+  label__0__continue:;
     while (true) {
-      if (v_need_block_size) {
-        v_need_block_size = false;
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t t_0 = *iop_a_src++;
-          v_block_size = t_0;
-        }
-      }
-      if (v_block_size == 0) {
-        goto label__outer__break;
-      }
-      while (((uint64_t)(io2_a_src - iop_a_src)) == 0) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
-      }
-      if (self->private_impl.f_compressed_ri ==
-          self->private_impl.f_compressed_wi) {
-        self->private_impl.f_compressed_ri = 0;
-        self->private_impl.f_compressed_wi = 0;
-      }
-      while (self->private_impl.f_compressed_wi <= 3841) {
-        v_n_compressed = wuffs_base__u64__min(
-            v_block_size, ((uint64_t)(io2_a_src - iop_a_src)));
-        if (v_n_compressed <= 0) {
-          goto label__0__break;
-        }
-        v_compressed =
-            wuffs_base__io_reader__take(&iop_a_src, io2_a_src, v_n_compressed);
-        wuffs_base__slice_u8__copy_from_slice(
+      v_r_mark = ((uint64_t)(iop_a_src - io0_a_src));
+      {
+        wuffs_base__io_buffer* o_0_v_w = v_w;
+        uint8_t* o_0_iop_v_w = iop_v_w;
+        uint8_t* o_0_io0_v_w = io0_v_w;
+        uint8_t* o_0_io1_v_w = io1_v_w;
+        uint8_t* o_0_io2_v_w = io2_v_w;
+        v_w = wuffs_base__io_writer__set(
+            &u_w, &iop_v_w, &io0_v_w, &io1_v_w, &io2_v_w,
             wuffs_base__slice_u8__subslice_i(
-                wuffs_base__make_slice_u8(self->private_data.f_compressed,
-                                          4096),
-                self->private_impl.f_compressed_wi),
-            v_compressed);
-        wuffs_base__u64__sat_add_indirect(&self->private_impl.f_compressed_wi,
-                                          v_n_compressed);
-        wuffs_base__u64__sat_sub_indirect(&v_block_size, v_n_compressed);
-        if (v_block_size > 0) {
-          goto label__0__break;
-        }
-        if (((uint64_t)(io2_a_src - iop_a_src)) <= 0) {
-          v_need_block_size = true;
-          goto label__0__break;
-        }
-        v_block_size =
-            ((uint64_t)(wuffs_base__load_u8be__no_bounds_check(iop_a_src)));
-        (iop_a_src += 1, wuffs_base__make_empty_struct());
-      }
-    label__0__break:;
-    label__inner__continue:;
-      while (true) {
-        if ((self->private_impl.f_compressed_ri >
-             self->private_impl.f_compressed_wi) ||
-            (self->private_impl.f_compressed_wi > 4096)) {
-          status = wuffs_base__make_status(
-              wuffs_gif__error__internal_error_inconsistent_ri_wi);
-          goto exit;
-        }
+                wuffs_base__make_slice_u8(self->private_data.f_block, 255),
+                self->private_impl.f_block_n));
+        v_w_mark = ((uint64_t)(iop_v_w - io0_v_w));
         {
-          wuffs_base__io_buffer* o_0_v_r = v_r;
-          uint8_t* o_0_iop_v_r = iop_v_r;
-          uint8_t* o_0_io0_v_r = io0_v_r;
-          uint8_t* o_0_io1_v_r = io1_v_r;
-          uint8_t* o_0_io2_v_r = io2_v_r;
-          v_r = wuffs_base__io_reader__set(
-              &u_r, &iop_v_r, &io0_v_r, &io1_v_r, &io2_v_r,
-              wuffs_base__slice_u8__subslice_ij(
-                  wuffs_base__make_slice_u8(self->private_data.f_compressed,
-                                            4096),
-                  self->private_impl.f_compressed_ri,
-                  self->private_impl.f_compressed_wi));
-          v_mark = ((uint64_t)(iop_v_r - io0_v_r));
-          {
-            u_r.meta.ri = ((size_t)(iop_v_r - u_r.data.ptr));
-            wuffs_base__status t_1 = wuffs_lzw__decoder__transform_io(
-                &self->private_data.f_lzw, &empty_io_buffer, v_r,
-                wuffs_base__utility__empty_slice_u8());
-            iop_v_r = u_r.data.ptr + u_r.meta.ri;
-            v_lzw_status = t_1;
+          u_w.meta.wi = ((size_t)(iop_v_w - u_w.data.ptr));
+          if (a_src) {
+            a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
           }
-          wuffs_base__u64__sat_add_indirect(
-              &self->private_impl.f_compressed_ri,
-              wuffs_base__io__count_since(v_mark,
-                                          ((uint64_t)(iop_v_r - io0_v_r))));
-          v_r = o_0_v_r;
-          iop_v_r = o_0_iop_v_r;
-          io0_v_r = o_0_io0_v_r;
-          io1_v_r = o_0_io1_v_r;
-          io2_v_r = o_0_io2_v_r;
-        }
-        v_uncompressed = wuffs_lzw__decoder__flush(&self->private_data.f_lzw);
-        if (((uint64_t)(v_uncompressed.len)) > 0) {
-          v_copy_status = wuffs_gif__decoder__copy_to_image_buffer(
-              self, a_dst, v_uncompressed);
-          if (wuffs_base__status__is_error(&v_copy_status)) {
-            status = v_copy_status;
-            goto exit;
+          wuffs_base__status t_0 = wuffs_lzw__encoder__transform_io(
+              &self->private_data.f_lzw, v_w, a_src,
+              wuffs_base__utility__empty_slice_u8());
+          iop_v_w = u_w.data.ptr + u_w.meta.wi;
+          if (a_src) {
+            iop_a_src = a_src->data.ptr + a_src->meta.ri;
           }
+          v_lzw_status = t_0;
         }
-        if (wuffs_base__status__is_ok(&v_lzw_status)) {
-          self->private_impl.f_previous_lzw_decode_ended_abruptly = false;
-          if (v_need_block_size || (v_block_size > 0)) {
-            self->private_data.s_decode_id_part2[0].scratch =
-                ((uint32_t)(v_block_size));
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-            if (self->private_data.s_decode_id_part2[0].scratch >
-                ((uint64_t)(io2_a_src - iop_a_src))) {
-              self->private_data.s_decode_id_part2[0].scratch -=
-                  ((uint64_t)(io2_a_src - iop_a_src));
-              iop_a_src = io2_a_src;
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            iop_a_src += self->private_data.s_decode_id_part2[0].scratch;
-            if (a_src) {
-              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-            }
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-            status = wuffs_gif__decoder__skip_blocks(self, a_src);
-            if (a_src) {
-              iop_a_src = a_src->data.ptr + a_src->meta.ri;
-            }
-            if (status.repr) {
-              goto suspend;
-            }
-          }
-          goto label__outer__break;
-        } else if (v_lzw_status.repr ==
-                   wuffs_base__make_status(wuffs_base__suspension__short_read)
-                       .repr) {
-          goto label__outer__continue;
-        } else if (v_lzw_status.repr ==
-                   wuffs_base__make_status(wuffs_base__suspension__short_write)
-                       .repr) {
-          goto label__inner__continue;
+        v_n = wuffs_base__io__count_since(v_w_mark,
+                                          ((uint64_t)(iop_v_w - io0_v_w)));
+        v_w = o_0_v_w;
+        iop_v_w = o_0_iop_v_w;
+        io0_v_w = o_0_io0_v_w;
+        io1_v_w = o_0_io1_v_w;
+        io2_v_w = o_0_io2_v_w;
+      }
+      wuffs_base__u64__sat_add_indirect(
+          &self->private_impl.f_n_pixels_have,
+          wuffs_base__io__count_since(v_r_mark,
+                                      ((uint64_t)(iop_a_src - io0_a_src))));
+      v_n = (((uint64_t)(self->private_impl.f_block_n)) +
+             wuffs_base__u64__min(v_n, 255));
+      self->private_impl.f_block_n =
+          ((uint32_t)(wuffs_base__u64__min(v_n, 255)));
+      if (wuffs_base__status__is_ok(&v_lzw_status)) {
+        goto label__0__break;
+      } else if (v_lzw_status.repr ==
+                 wuffs_base__make_status(wuffs_base__suspension__short_write)
+                     .repr) {
+        if (a_dst) {
+          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
         }
-        status = v_lzw_status;
-        if (wuffs_base__status__is_error(&status)) {
-          goto exit;
-        } else if (wuffs_base__status__is_suspension(&status)) {
-          status = wuffs_base__make_status(
-              wuffs_base__error__cannot_return_a_suspension);
-          goto exit;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+        status = wuffs_gif__encoder__write_block(self, a_dst);
+        if (a_dst) {
+          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
         }
-        goto ok;
+        if (status.repr) {
+          goto suspend;
+        }
+        goto label__0__continue;
+      } else if (wuffs_base__status__is_suspension(&v_lzw_status)) {
+        status = v_lzw_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(6);
+        goto label__0__continue;
+      }
+      status = v_lzw_status;
+      if (wuffs_base__status__is_error(&status)) {
+        goto exit;
+      } else if (wuffs_base__status__is_suspension(&status)) {
+        status = wuffs_base__make_status(
+            wuffs_base__error__cannot_return_a_suspension);
+        goto exit;
       }
+      goto ok;
     }
-  label__outer__break:;
-    self->private_impl.f_compressed_ri = 0;
-    self->private_impl.f_compressed_wi = 0;
-    if ((self->private_impl.f_dst_y < self->private_impl.f_frame_rect_y1) &&
-        (self->private_impl.f_frame_rect_x0 !=
-         self->private_impl.f_frame_rect_x1) &&
-        (self->private_impl.f_frame_rect_y0 !=
-         self->private_impl.f_frame_rect_y1)) {
-      status = wuffs_base__make_status(wuffs_base__error__not_enough_data);
+  label__0__break:;
+    if (a_dst) {
+      a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+    }
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+    status = wuffs_gif__encoder__write_block(self, a_dst);
+    if (a_dst) {
+      iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+    }
+    if (status.repr) {
+      goto suspend;
+    }
+    if (self->private_impl.f_n_pixels_have !=
+        self->private_impl.f_n_pixels_want) {
+      status = wuffs_base__make_status(wuffs_gif__error__bad_frame_size);
       goto exit;
     }
+    self->private_data.s_encode_frame[0].scratch = 0;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
+    }
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_frame[0].scratch));
 
     goto ok;
   ok:
-    self->private_impl.p_decode_id_part2[0] = 0;
+    self->private_impl.p_encode_frame[0] = 0;
     goto exit;
   }
 
   goto suspend;
 suspend:
-  self->private_impl.p_decode_id_part2[0] =
+  self->private_impl.p_encode_frame[0] =
       wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
-  self->private_data.s_decode_id_part2[0].v_block_size = v_block_size;
-  self->private_data.s_decode_id_part2[0].v_need_block_size = v_need_block_size;
-  self->private_data.s_decode_id_part2[0].v_lzw_status = v_lzw_status;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 2 : 0;
+  self->private_data.s_encode_frame[0].v_frame_width = v_frame_width;
+  self->private_data.s_encode_frame[0].v_frame_height = v_frame_height;
+  self->private_data.s_encode_frame[0].v_flags = v_flags;
+  self->private_data.s_encode_frame[0].v_delay = v_delay;
+  self->private_data.s_encode_frame[0].v_lw = v_lw;
+  self->private_data.s_encode_frame[0].v_lzw_status = v_lzw_status;
 
   goto exit;
 exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
   if (a_src) {
     a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
   }
 
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
   return status;
 }
 
-// -------- func gif.decoder.copy_to_image_buffer
+// -------- func gif.encoder.encode_trailer
 
-static wuffs_base__status  //
-wuffs_gif__decoder__copy_to_image_buffer(wuffs_gif__decoder* self,
-                                         wuffs_base__pixel_buffer* a_pb,
-                                         wuffs_base__slice_u8 a_src) {
-  wuffs_base__slice_u8 v_dst = {0};
-  wuffs_base__slice_u8 v_src = {0};
-  uint64_t v_width_in_bytes = 0;
-  uint64_t v_n = 0;
-  uint64_t v_src_ri = 0;
-  wuffs_base__pixel_format v_pixfmt = {0};
-  uint32_t v_bytes_per_pixel = 0;
-  uint32_t v_bits_per_pixel = 0;
-  wuffs_base__table_u8 v_tab = {0};
-  uint64_t v_i = 0;
-  uint64_t v_j = 0;
-  uint32_t v_replicate_y0 = 0;
-  uint32_t v_replicate_y1 = 0;
-  wuffs_base__slice_u8 v_replicate_dst = {0};
-  wuffs_base__slice_u8 v_replicate_src = {0};
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_gif__encoder__encode_trailer(wuffs_gif__encoder* self,
+                                   wuffs_base__io_buffer* a_dst) {
+  if (!self) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_status(
+        (self->private_impl.magic == WUFFS_BASE__DISABLED)
+            ? wuffs_base__error__disabled_by_previous_error
+            : wuffs_base__error__initialize_not_called);
+  }
+  if (!a_dst) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  if ((self->private_impl.active_coroutine != 0) &&
+      (self->private_impl.active_coroutine != 3)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+    return wuffs_base__make_status(
+        wuffs_base__error__interleaved_coroutine_calls);
+  }
+  self->private_impl.active_coroutine = 0;
+  wuffs_base__status status = wuffs_base__make_status(NULL);
 
-  v_pixfmt = wuffs_base__pixel_buffer__pixel_format(a_pb);
-  v_bits_per_pixel = wuffs_base__pixel_format__bits_per_pixel(&v_pixfmt);
-  if ((v_bits_per_pixel & 7) != 0) {
-    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
+    }
   }
-  v_bytes_per_pixel = (v_bits_per_pixel >> 3);
-  v_width_in_bytes = (((uint64_t)(self->private_impl.f_width)) *
-                      ((uint64_t)(v_bytes_per_pixel)));
-  v_tab = wuffs_base__pixel_buffer__plane(a_pb, 0);
-label__0__continue:;
-  while (v_src_ri < ((uint64_t)(a_src.len))) {
-    v_src = wuffs_base__slice_u8__subslice_i(a_src, v_src_ri);
-    if (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1) {
-      if (self->private_impl.f_quirk_enabled_ignore_too_much_pixel_data) {
-        return wuffs_base__make_status(NULL);
-      }
-      return wuffs_base__make_status(wuffs_base__error__too_much_data);
+
+  uint32_t coro_susp_point = self->private_impl.p_encode_trailer[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_call_sequence != 1) {
+      status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+      goto exit;
     }
-    v_dst = wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-    if (self->private_impl.f_dst_y >= self->private_impl.f_height) {
-      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, 0);
-    } else if (v_width_in_bytes < ((uint64_t)(v_dst.len))) {
-      v_dst = wuffs_base__slice_u8__subslice_j(v_dst, v_width_in_bytes);
+    self->private_data.s_encode_trailer[0].scratch = 59;
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+    if (iop_a_dst == io2_a_dst) {
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      goto suspend;
     }
-    v_i = (((uint64_t)(self->private_impl.f_dst_x)) *
-           ((uint64_t)(v_bytes_per_pixel)));
-    if (v_i < ((uint64_t)(v_dst.len))) {
-      v_j = (((uint64_t)(self->private_impl.f_frame_rect_x1)) *
-             ((uint64_t)(v_bytes_per_pixel)));
-      if ((v_i <= v_j) && (v_j <= ((uint64_t)(v_dst.len)))) {
-        v_dst = wuffs_base__slice_u8__subslice_ij(v_dst, v_i, v_j);
-      } else {
-        v_dst = wuffs_base__slice_u8__subslice_i(v_dst, v_i);
-      }
-      v_n = wuffs_base__pixel_swizzler__swizzle_interleaved(
-          &self->private_impl.f_swizzler, v_dst,
-          wuffs_base__make_slice_u8(self->private_data.f_dst_palette, 1024),
-          v_src);
-      wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
-      wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
-                                        ((uint32_t)((v_n & 4294967295))));
-      self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
-          self->private_impl.f_dirty_max_excl_y,
-          wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1));
+    *iop_a_dst++ = ((uint8_t)(self->private_data.s_encode_trailer[0].scratch));
+    self->private_impl.f_call_sequence = 2;
+
+    goto ok;
+  ok:
+    self->private_impl.p_encode_trailer[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_encode_trailer[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_impl.active_coroutine =
+      wuffs_base__status__is_suspension(&status) ? 3 : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  if (wuffs_base__status__is_error(&status)) {
+    self->private_impl.magic = WUFFS_BASE__DISABLED;
+  }
+  return status;
+}
+
+// -------- func gif.encoder.write_le
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_le(wuffs_gif__encoder* self,
+                             wuffs_base__io_buffer* a_dst,
+                             uint32_t a_n,
+                             uint64_t a_x) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint32_t v_i = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
     }
-    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
-      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-      if (self->private_impl.f_interlace == 0) {
-        wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_y, 1);
-        goto label__0__continue;
-      }
-      if ((self->private_impl.f_num_decoded_frames_value == 0) &&
-          !self->private_impl.f_gc_has_transparent_index &&
-          (self->private_impl.f_interlace > 1)) {
-        v_replicate_src =
-            wuffs_base__table_u8__row(v_tab, self->private_impl.f_dst_y);
-        v_replicate_y0 =
-            wuffs_base__u32__sat_add(self->private_impl.f_dst_y, 1);
-        v_replicate_y1 = wuffs_base__u32__sat_add(
-            self->private_impl.f_dst_y,
-            ((uint32_t)(
-                wuffs_gif__interlace_count[self->private_impl.f_interlace])));
-        v_replicate_y1 = wuffs_base__u32__min(
-            v_replicate_y1, self->private_impl.f_frame_rect_y1);
-        while (v_replicate_y0 < v_replicate_y1) {
-          v_replicate_dst = wuffs_base__table_u8__row(v_tab, v_replicate_y0);
-          wuffs_base__slice_u8__copy_from_slice(v_replicate_dst,
-                                                v_replicate_src);
-          v_replicate_y0 += 1;
-        }
-        self->private_impl.f_dirty_max_excl_y = wuffs_base__u32__max(
-            self->private_impl.f_dirty_max_excl_y, v_replicate_y1);
-      }
-      wuffs_base__u32__sat_add_indirect(
-          &self->private_impl.f_dst_y,
-          ((uint32_t)(
-              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
-      while (
-          (self->private_impl.f_interlace > 0) &&
-          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        self->private_impl.f_interlace -= 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
-            self->private_impl.f_frame_rect_y0,
-            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_le[0];
+  if (coro_susp_point) {
+    v_i = self->private_data.s_write_le[0].v_i;
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    v_i = 0;
+    while (v_i < a_n) {
+      self->private_data.s_write_le[0].scratch =
+          ((uint8_t)(((a_x >> (8 * v_i)) & 255)));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
-      goto label__0__continue;
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_le[0].scratch));
+      v_i += 1;
     }
-    if (((uint64_t)(a_src.len)) == v_src_ri) {
-      goto label__0__break;
-    } else if (((uint64_t)(a_src.len)) < v_src_ri) {
-      return wuffs_base__make_status(
-          wuffs_gif__error__internal_error_inconsistent_ri_wi);
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_le[0] = 0;
+    goto exit;
+  }
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_le[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+  self->private_data.s_write_le[0].v_i = v_i;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
+}
+
+// -------- func gif.encoder.write_block
+
+static wuffs_base__status  //
+wuffs_gif__encoder__write_block(wuffs_gif__encoder* self,
+                                wuffs_base__io_buffer* a_dst) {
+  wuffs_base__status status = wuffs_base__make_status(NULL);
+
+  uint64_t v_n = 0;
+
+  uint8_t* iop_a_dst = NULL;
+  uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io1_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  uint8_t* io2_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
+  if (a_dst) {
+    io0_a_dst = a_dst->data.ptr;
+    io1_a_dst = io0_a_dst + a_dst->meta.wi;
+    iop_a_dst = io1_a_dst;
+    io2_a_dst = io0_a_dst + a_dst->data.len;
+    if (a_dst->meta.closed) {
+      io2_a_dst = iop_a_dst;
     }
-    v_n = ((uint64_t)(
-        (self->private_impl.f_frame_rect_x1 - self->private_impl.f_dst_x)));
-    v_n = wuffs_base__u64__min(v_n, (((uint64_t)(a_src.len)) - v_src_ri));
-    wuffs_base__u64__sat_add_indirect(&v_src_ri, v_n);
-    wuffs_base__u32__sat_add_indirect(&self->private_impl.f_dst_x,
-                                      ((uint32_t)((v_n & 4294967295))));
-    if (self->private_impl.f_frame_rect_x1 <= self->private_impl.f_dst_x) {
-      self->private_impl.f_dst_x = self->private_impl.f_frame_rect_x0;
-      wuffs_base__u32__sat_add_indirect(
-          &self->private_impl.f_dst_y,
-          ((uint32_t)(
-              wuffs_gif__interlace_delta[self->private_impl.f_interlace])));
-      while (
-          (self->private_impl.f_interlace > 0) &&
-          (self->private_impl.f_dst_y >= self->private_impl.f_frame_rect_y1)) {
-#if defined(__GNUC__)
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wconversion"
-#endif
-        self->private_impl.f_interlace -= 1;
-#if defined(__GNUC__)
-#pragma GCC diagnostic pop
-#endif
-        self->private_impl.f_dst_y = wuffs_base__u32__sat_add(
-            self->private_impl.f_frame_rect_y0,
-            wuffs_gif__interlace_start[self->private_impl.f_interlace]);
+  }
+
+  uint32_t coro_susp_point = self->private_impl.p_write_block[0];
+  if (coro_susp_point) {
+  }
+  switch (coro_susp_point) {
+    WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
+
+    if (self->private_impl.f_block_n <= 0) {
+      status = wuffs_base__make_status(NULL);
+      goto ok;
+    }
+    if (self->private_impl.f_block_ri <= 0) {
+      self->private_data.s_write_block[0].scratch =
+          ((uint8_t)(self->private_impl.f_block_n));
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+      if (iop_a_dst == io2_a_dst) {
+        status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+        goto suspend;
       }
-      goto label__0__continue;
+      *iop_a_dst++ = ((uint8_t)(self->private_data.s_write_block[0].scratch));
     }
-    if (v_src_ri != ((uint64_t)(a_src.len))) {
-      return wuffs_base__make_status(
-          wuffs_gif__error__internal_error_inconsistent_ri_wi);
+    while (true) {
+      if (self->private_impl.f_block_ri > self->private_impl.f_block_n) {
+        status = wuffs_base__make_status(
+            wuffs_gif__error__internal_error_inconsistent_ri_wi);
+        goto exit;
+      }
+      v_n = wuffs_base__io_writer__copy_from_slice(
+          &iop_a_dst, io2_a_dst,
+          wuffs_base__slice_u8__subslice_ij(
+              wuffs_base__make_slice_u8(self->private_data.f_block, 255),
+              self->private_impl.f_block_ri, self->private_impl.f_block_n));
+      v_n = (((uint64_t)(self->private_impl.f_block_ri)) +
+             wuffs_base__u64__min(v_n, 255));
+      self->private_impl.f_block_ri =
+          ((uint32_t)(wuffs_base__u64__min(v_n, 255)));
+      if (self->private_impl.f_block_ri >= self->private_impl.f_block_n) {
+        goto label__0__break;
+      }
+      status = wuffs_base__make_status(wuffs_base__suspension__short_write);
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(2);
     }
-    goto label__0__break;
+  label__0__break:;
+    self->private_impl.f_block_n = 0;
+    self->private_impl.f_block_ri = 0;
+
+    goto ok;
+  ok:
+    self->private_impl.p_write_block[0] = 0;
+    goto exit;
   }
-label__0__break:;
-  return wuffs_base__make_status(NULL);
+
+  goto suspend;
+suspend:
+  self->private_impl.p_write_block[0] =
+      wuffs_base__status__is_suspension(&status) ? coro_susp_point : 0;
+
+  goto exit;
+exit:
+  if (a_dst) {
+    a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+  }
+
+  return status;
 }
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
@@ -19545,6 +28670,7 @@ const char* wuffs_gzip__error__bad_compression_method =
     "#gzip: bad compression method";
 const char* wuffs_gzip__error__bad_encoding_flags = "#gzip: bad encoding flags";
 const char* wuffs_gzip__error__bad_header = "#gzip: bad header";
+const char* wuffs_gzip__suspension__member_boundary = "$gzip: member boundary";
 
 // ---------------- Private Consts
 
@@ -19607,37 +28733,198 @@ wuffs_gzip__decoder__initialize(wuffs_gzip__decoder* self,
     }
   }
 
-  {
-    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
-        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  {
+    wuffs_base__status z = wuffs_crc32__ieee_hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_gzip__decoder() {
+  return sizeof(wuffs_gzip__decoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func gzip.decoder.set_multi_member
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_multi_member(wuffs_gzip__decoder* self, bool a_mm) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_multi_member = a_mm;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.set_report_member_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_report_member_boundaries(wuffs_gzip__decoder* self,
+                                                  bool a_rmb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_member_boundaries = a_rmb;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.bgzf_block_length
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__bgzf_block_length(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_bgzf_length;
+}
+
+// -------- func gzip.decoder.set_dst_holds_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_dst_holds_history(wuffs_gzip__decoder* self,
+                                           bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_dst_holds_history(&self->private_data.f_flate,
+                                                a_dhh);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.set_dst_holds_window
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_dst_holds_window(wuffs_gzip__decoder* self,
+                                          bool a_dhw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_dst_holds_window(&self->private_data.f_flate,
+                                               a_dhw);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_report_block_boundaries(wuffs_gzip__decoder* self,
+                                                 bool a_rbb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_report_block_boundaries(
+      &self->private_data.f_flate, a_rbb);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func gzip.decoder.held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__held_bits(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return wuffs_deflate__decoder__held_bits(&self->private_data.f_flate);
+}
+
+// -------- func gzip.decoder.n_held_bits
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_gzip__decoder__n_held_bits(const wuffs_gzip__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return wuffs_deflate__decoder__n_held_bits(&self->private_data.f_flate);
+}
+
+// -------- func gzip.decoder.copy_history
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_gzip__decoder__copy_history(wuffs_gzip__decoder* self,
+                                  wuffs_base__slice_u8 a_dst) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint64_t v_n = 0;
+
+  v_n =
+      wuffs_deflate__decoder__copy_history(&self->private_data.f_flate, a_dst);
+  return v_n;
+}
+
+// -------- func gzip.decoder.set_fused_checksum
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_gzip__decoder__set_fused_checksum(wuffs_gzip__decoder* self, bool a_fc) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
   }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
-        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_gzip__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
-}
 
-size_t  //
-sizeof__wuffs_gzip__decoder() {
-  return sizeof(wuffs_gzip__decoder);
+  self->private_impl.f_fused_checksum = a_fc;
+  return wuffs_base__make_empty_struct();
 }
 
-// ---------------- Function Implementations
-
 // -------- func gzip.decoder.set_ignore_checksum
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
@@ -19699,8 +28986,12 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
 
   uint8_t v_c = 0;
   uint8_t v_flags = 0;
-  uint16_t v_xlen = 0;
+  uint32_t v_xlen = 0;
+  uint16_t v_si = 0;
+  uint32_t v_slen = 0;
+  uint16_t v_bsize = 0;
   uint64_t v_mark = 0;
+  bool v_stride = false;
   uint32_t v_checksum_got = 0;
   uint32_t v_decoded_length_got = 0;
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
@@ -19734,6 +29025,8 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
   uint32_t coro_susp_point = self->private_impl.p_transform_io[0];
   if (coro_susp_point) {
     v_flags = self->private_data.s_transform_io[0].v_flags;
+    v_xlen = self->private_data.s_transform_io[0].v_xlen;
+    v_si = self->private_data.s_transform_io[0].v_si;
     v_checksum_got = self->private_data.s_transform_io[0].v_checksum_got;
     v_decoded_length_got =
         self->private_data.s_transform_io[0].v_decoded_length_got;
@@ -19742,76 +29035,370 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
   switch (coro_susp_point) {
     WUFFS_BASE__COROUTINE_SUSPENSION_POINT_0;
 
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+    while (true) {
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_0 = *iop_a_src++;
+        v_c = t_0;
       }
-      uint8_t t_0 = *iop_a_src++;
-      v_c = t_0;
-    }
-    if (v_c != 31) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      if (v_c != 31) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
       }
-      uint8_t t_1 = *iop_a_src++;
-      v_c = t_1;
-    }
-    if (v_c != 139) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_1 = *iop_a_src++;
+        v_c = t_1;
       }
-      uint8_t t_2 = *iop_a_src++;
-      v_c = t_2;
-    }
-    if (v_c != 8) {
-      status =
-          wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
-      goto exit;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
-      if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+      if (v_c != 139) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_header);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_2 = *iop_a_src++;
+        v_c = t_2;
+      }
+      if (v_c != 8) {
+        status =
+            wuffs_base__make_status(wuffs_gzip__error__bad_compression_method);
+        goto exit;
+      }
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+        if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        uint8_t t_3 = *iop_a_src++;
+        v_flags = t_3;
+      }
+      self->private_data.s_transform_io[0].scratch = 6;
+      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
+      if (self->private_data.s_transform_io[0].scratch >
+          ((uint64_t)(io2_a_src - iop_a_src))) {
+        self->private_data.s_transform_io[0].scratch -=
+            ((uint64_t)(io2_a_src - iop_a_src));
+        iop_a_src = io2_a_src;
         status = wuffs_base__make_status(wuffs_base__suspension__short_read);
         goto suspend;
       }
-      uint8_t t_3 = *iop_a_src++;
-      v_flags = t_3;
-    }
-    self->private_data.s_transform_io[0].scratch = 6;
-    WUFFS_BASE__COROUTINE_SUSPENSION_POINT(5);
-    if (self->private_data.s_transform_io[0].scratch >
-        ((uint64_t)(io2_a_src - iop_a_src))) {
-      self->private_data.s_transform_io[0].scratch -=
-          ((uint64_t)(io2_a_src - iop_a_src));
-      iop_a_src = io2_a_src;
-      status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-      goto suspend;
-    }
-    iop_a_src += self->private_data.s_transform_io[0].scratch;
-    if ((v_flags & 4) != 0) {
+      iop_a_src += self->private_data.s_transform_io[0].scratch;
+      self->private_impl.f_bgzf_length = 0;
+      if ((v_flags & 4) != 0) {
+        {
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+          uint32_t t_4;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_4 = ((
+                uint32_t)(wuffs_base__load_u16le__no_bounds_check(iop_a_src)));
+            iop_a_src += 2;
+          } else {
+            self->private_data.s_transform_io[0].scratch = 0;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+            while (true) {
+              if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                status =
+                    wuffs_base__make_status(wuffs_base__suspension__short_read);
+                goto suspend;
+              }
+              uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+              uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+              *scratch <<= 8;
+              *scratch >>= 8;
+              *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
+              if (num_bits_4 == 8) {
+                t_4 = ((uint32_t)(*scratch));
+                break;
+              }
+              num_bits_4 += 8;
+              *scratch |= ((uint64_t)(num_bits_4)) << 56;
+            }
+          }
+          v_xlen = t_4;
+        }
+        while (v_xlen >= 4) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
+            uint16_t t_5;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_5 = wuffs_base__load_u16be__no_bounds_check(iop_a_src);
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_5 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_5);
+                if (num_bits_5 == 8) {
+                  t_5 = ((uint16_t)(*scratch >> 48));
+                  break;
+                }
+                num_bits_5 += 8;
+                *scratch |= ((uint64_t)(num_bits_5));
+              }
+            }
+            v_si = t_5;
+          }
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
+            uint32_t t_6;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+              t_6 = ((uint32_t)(wuffs_base__load_u16le__no_bounds_check(
+                  iop_a_src)));
+              iop_a_src += 2;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_6 = ((uint32_t)(*scratch >> 56));
+                *scratch <<= 8;
+                *scratch >>= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_6;
+                if (num_bits_6 == 8) {
+                  t_6 = ((uint32_t)(*scratch));
+                  break;
+                }
+                num_bits_6 += 8;
+                *scratch |= ((uint64_t)(num_bits_6)) << 56;
+              }
+            }
+            v_slen = t_6;
+          }
+          v_xlen -= 4;
+          if (v_xlen < v_slen) {
+            goto label__0__break;
+          }
+          v_xlen -= v_slen;
+          if ((v_si == 16963) && (v_slen == 2)) {
+            {
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(12);
+              uint16_t t_7;
+              if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+                t_7 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
+                iop_a_src += 2;
+              } else {
+                self->private_data.s_transform_io[0].scratch = 0;
+                WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
+                while (true) {
+                  if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                    status = wuffs_base__make_status(
+                        wuffs_base__suspension__short_read);
+                    goto suspend;
+                  }
+                  uint64_t* scratch =
+                      &self->private_data.s_transform_io[0].scratch;
+                  uint32_t num_bits_7 = ((uint32_t)(*scratch >> 56));
+                  *scratch <<= 8;
+                  *scratch >>= 8;
+                  *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_7;
+                  if (num_bits_7 == 8) {
+                    t_7 = ((uint16_t)(*scratch));
+                    break;
+                  }
+                  num_bits_7 += 8;
+                  *scratch |= ((uint64_t)(num_bits_7)) << 56;
+                }
+              }
+              v_bsize = t_7;
+            }
+            self->private_impl.f_bgzf_length = (((uint32_t)(v_bsize)) + 1);
+          } else {
+            self->private_data.s_transform_io[0].scratch = v_slen;
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
+            if (self->private_data.s_transform_io[0].scratch >
+                ((uint64_t)(io2_a_src - iop_a_src))) {
+              self->private_data.s_transform_io[0].scratch -=
+                  ((uint64_t)(io2_a_src - iop_a_src));
+              iop_a_src = io2_a_src;
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            iop_a_src += self->private_data.s_transform_io[0].scratch;
+          }
+        }
+      label__0__break:;
+        self->private_data.s_transform_io[0].scratch = v_xlen;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 8) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_8 = *iop_a_src++;
+            v_c = t_8;
+          }
+          if (v_c == 0) {
+            goto label__1__break;
+          }
+        }
+      label__1__break:;
+      }
+      if ((v_flags & 16) != 0) {
+        while (true) {
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(17);
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint8_t t_9 = *iop_a_src++;
+            v_c = t_9;
+          }
+          if (v_c == 0) {
+            goto label__2__break;
+          }
+        }
+      label__2__break:;
+      }
+      if ((v_flags & 2) != 0) {
+        self->private_data.s_transform_io[0].scratch = 2;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(18);
+        if (self->private_data.s_transform_io[0].scratch >
+            ((uint64_t)(io2_a_src - iop_a_src))) {
+          self->private_data.s_transform_io[0].scratch -=
+              ((uint64_t)(io2_a_src - iop_a_src));
+          iop_a_src = io2_a_src;
+          status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+          goto suspend;
+        }
+        iop_a_src += self->private_data.s_transform_io[0].scratch;
+      }
+      if ((v_flags & 224) != 0) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
+        goto exit;
+      }
+    label__3__continue:;
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        v_stride = (self->private_impl.f_fused_checksum &&
+                    !self->private_impl.f_ignore_checksum &&
+                    (((uint64_t)(io2_a_dst - iop_a_dst)) > 16384));
+        if (v_stride) {
+          wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+              &self->private_data.f_flate, true);
+          {
+            wuffs_base__io_buffer* o_0_a_dst = a_dst;
+            wuffs_base__io_buffer o_0_u_a_dst;
+            uint8_t* o_0_io2_a_dst = io2_a_dst;
+            a_dst = wuffs_base__io_writer__limit(&o_0_u_a_dst, a_dst, iop_a_dst,
+                                                 &io2_a_dst, 16384);
+            {
+              if (a_dst) {
+                a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+              }
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              wuffs_base__status t_10 = wuffs_deflate__decoder__transform_io(
+                  &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+              if (a_dst) {
+                iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+              }
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+              v_status = t_10;
+            }
+            a_dst = o_0_a_dst;
+            io2_a_dst = o_0_io2_a_dst;
+          }
+          wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+              &self->private_data.f_flate, false);
+        } else {
+          {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_11 = wuffs_deflate__decoder__transform_io(
+                &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            v_status = t_11;
+          }
+        }
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
+          v_decoded_length_got +=
+              ((uint32_t)((wuffs_base__io__count_since(
+                               v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
+                           4294967295)));
+        }
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__3__break;
+        } else if (v_stride &&
+                   (v_status.repr ==
+                    wuffs_base__make_status(wuffs_base__suspension__short_write)
+                        .repr)) {
+          goto label__3__continue;
+        }
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(19);
+      }
+    label__3__break:;
       {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-        uint16_t t_4;
-        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-          t_4 = wuffs_base__load_u16le__no_bounds_check(iop_a_src);
-          iop_a_src += 2;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(20);
+        uint32_t t_12;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_12 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
         } else {
           self->private_data.s_transform_io[0].scratch = 0;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(21);
           while (true) {
             if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
               status =
@@ -19819,187 +29406,84 @@ wuffs_gzip__decoder__transform_io(wuffs_gzip__decoder* self,
               goto suspend;
             }
             uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-            uint32_t num_bits_4 = ((uint32_t)(*scratch >> 56));
+            uint32_t num_bits_12 = ((uint32_t)(*scratch >> 56));
             *scratch <<= 8;
             *scratch >>= 8;
-            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_4;
-            if (num_bits_4 == 8) {
-              t_4 = ((uint16_t)(*scratch));
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_12;
+            if (num_bits_12 == 24) {
+              t_12 = ((uint32_t)(*scratch));
               break;
             }
-            num_bits_4 += 8;
-            *scratch |= ((uint64_t)(num_bits_4)) << 56;
-          }
-        }
-        v_xlen = t_4;
-      }
-      self->private_data.s_transform_io[0].scratch = ((uint32_t)(v_xlen));
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(8);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
-      }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
-    }
-    if ((v_flags & 8) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(9);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint8_t t_5 = *iop_a_src++;
-          v_c = t_5;
-        }
-        if (v_c == 0) {
-          goto label__0__break;
-        }
-      }
-    label__0__break:;
-    }
-    if ((v_flags & 16) != 0) {
-      while (true) {
-        {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(10);
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
+            num_bits_12 += 8;
+            *scratch |= ((uint64_t)(num_bits_12)) << 56;
           }
-          uint8_t t_6 = *iop_a_src++;
-          v_c = t_6;
         }
-        if (v_c == 0) {
-          goto label__1__break;
-        }
-      }
-    label__1__break:;
-    }
-    if ((v_flags & 2) != 0) {
-      self->private_data.s_transform_io[0].scratch = 2;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(11);
-      if (self->private_data.s_transform_io[0].scratch >
-          ((uint64_t)(io2_a_src - iop_a_src))) {
-        self->private_data.s_transform_io[0].scratch -=
-            ((uint64_t)(io2_a_src - iop_a_src));
-        iop_a_src = io2_a_src;
-        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
-        goto suspend;
+        v_checksum_want = t_12;
       }
-      iop_a_src += self->private_data.s_transform_io[0].scratch;
-    }
-    if ((v_flags & 224) != 0) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_encoding_flags);
-      goto exit;
-    }
-    while (true) {
-      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
       {
-        if (a_dst) {
-          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
-        }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
-        }
-        wuffs_base__status t_7 = wuffs_deflate__decoder__transform_io(
-            &self->private_data.f_flate, a_dst, a_src, a_workbuf);
-        if (a_dst) {
-          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
-        }
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(22);
+        uint32_t t_13;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_13 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(23);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_13 = ((uint32_t)(*scratch >> 56));
+            *scratch <<= 8;
+            *scratch >>= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_13;
+            if (num_bits_13 == 24) {
+              t_13 = ((uint32_t)(*scratch));
+              break;
+            }
+            num_bits_13 += 8;
+            *scratch |= ((uint64_t)(num_bits_13)) << 56;
+          }
         }
-        v_status = t_7;
-      }
-      if (!self->private_impl.f_ignore_checksum) {
-        v_checksum_got = wuffs_crc32__ieee_hasher__update_u32(
-            &self->private_data.f_checksum,
-            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
-                                  io0_a_dst));
-        v_decoded_length_got +=
-            ((uint32_t)((wuffs_base__io__count_since(
-                             v_mark, ((uint64_t)(iop_a_dst - io0_a_dst))) &
-                         4294967295)));
+        v_decoded_length_want = t_13;
       }
-      if (wuffs_base__status__is_ok(&v_status)) {
-        goto label__2__break;
+      if (!self->private_impl.f_ignore_checksum &&
+          ((v_checksum_got != v_checksum_want) ||
+           (v_decoded_length_got != v_decoded_length_want))) {
+        status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
+        goto exit;
       }
-      status = v_status;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(12);
-    }
-  label__2__break:;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(13);
-      uint32_t t_8;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_8 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(14);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_8 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_8;
-          if (num_bits_8 == 24) {
-            t_8 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_8 += 8;
-          *scratch |= ((uint64_t)(num_bits_8)) << 56;
-        }
+      if (!self->private_impl.f_multi_member) {
+        goto label__member__break;
       }
-      v_checksum_want = t_8;
-    }
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(15);
-      uint32_t t_9;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_9 = wuffs_base__load_u32le__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(16);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_9 = ((uint32_t)(*scratch >> 56));
-          *scratch <<= 8;
-          *scratch >>= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << num_bits_9;
-          if (num_bits_9 == 24) {
-            t_9 = ((uint32_t)(*scratch));
-            break;
-          }
-          num_bits_9 += 8;
-          *scratch |= ((uint64_t)(num_bits_9)) << 56;
+      while (true) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+          goto label__4__break;
+        } else if (a_src && a_src->meta.closed) {
+          goto label__member__break;
         }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(24);
+      }
+    label__4__break:;
+      wuffs_base__ignore_status(wuffs_crc32__ieee_hasher__initialize(
+          &self->private_data.f_checksum, sizeof(wuffs_crc32__ieee_hasher),
+          WUFFS_VERSION, 0));
+      v_checksum_got = 0;
+      v_decoded_length_got = 0;
+      wuffs_deflate__decoder__resume_at_checkpoint(
+          &self->private_data.f_flate, 0, 0,
+          wuffs_base__utility__empty_slice_u8());
+      if (self->private_impl.f_report_member_boundaries) {
+        status =
+            wuffs_base__make_status(wuffs_gzip__suspension__member_boundary);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(25);
       }
-      v_decoded_length_want = t_9;
-    }
-    if (!self->private_impl.f_ignore_checksum &&
-        ((v_checksum_got != v_checksum_want) ||
-         (v_decoded_length_got != v_decoded_length_want))) {
-      status = wuffs_base__make_status(wuffs_gzip__error__bad_checksum);
-      goto exit;
     }
+  label__member__break:;
 
     goto ok;
   ok:
@@ -20014,6 +29498,8 @@ suspend:
   self->private_impl.active_coroutine =
       wuffs_base__status__is_suspension(&status) ? 1 : 0;
   self->private_data.s_transform_io[0].v_flags = v_flags;
+  self->private_data.s_transform_io[0].v_xlen = v_xlen;
+  self->private_data.s_transform_io[0].v_si = v_si;
   self->private_data.s_transform_io[0].v_checksum_got = v_checksum_got;
   self->private_data.s_transform_io[0].v_decoded_length_got =
       v_decoded_length_got;
@@ -22096,6 +31582,7 @@ wuffs_wbmp__decoder__workbuf_len(const wuffs_wbmp__decoder* self) {
 
 // ---------------- Status Codes Implementations
 
+const char* wuffs_zlib__suspension__member_boundary = "$zlib: member boundary";
 const char* wuffs_zlib__note__dictionary_required =
     "@zlib: dictionary required";
 const char* wuffs_zlib__error__bad_checksum = "#zlib: bad checksum";
@@ -22167,51 +31654,209 @@ wuffs_zlib__decoder__initialize(wuffs_zlib__decoder* self,
       memset(&(self->private_impl), 0, sizeof(self->private_impl));
     }
   }
-
-  {
-    wuffs_base__status z = wuffs_adler32__hasher__initialize(
-        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_checksum, sizeof(self->private_data.f_checksum),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_adler32__hasher__initialize(
+        &self->private_data.f_dict_id_hasher,
+        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
+        initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  {
+    wuffs_base__status z = wuffs_deflate__decoder__initialize(
+        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
+        WUFFS_VERSION, initialize_flags);
+    if (z.repr) {
+      return z;
+    }
+  }
+  self->private_impl.magic = WUFFS_BASE__MAGIC;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
+      wuffs_base__io_transformer__vtable_name;
+  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
+      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
+  return wuffs_base__make_status(NULL);
+}
+
+size_t  //
+sizeof__wuffs_zlib__decoder() {
+  return sizeof(wuffs_zlib__decoder);
+}
+
+// ---------------- Function Implementations
+
+// -------- func zlib.decoder.dictionary_id
+
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return self->private_impl.f_dict_id_want;
+}
+
+// -------- func zlib.decoder.add_dictionary
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
+                                    wuffs_base__slice_u8 a_dict) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_header_complete) {
+    self->private_impl.f_bad_call_sequence = true;
+  } else {
+    self->private_impl.f_dict_id_got = wuffs_adler32__hasher__update_u32(
+        &self->private_data.f_dict_id_hasher, a_dict);
+    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
+  }
+  self->private_impl.f_got_dictionary = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.add_dictionary_with_id
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__add_dictionary_with_id(wuffs_zlib__decoder* self,
+                                            wuffs_base__slice_u8 a_dict,
+                                            uint32_t a_dict_id) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  if (self->private_impl.f_header_complete) {
+    self->private_impl.f_bad_call_sequence = true;
+  } else {
+    self->private_impl.f_dict_id_got = a_dict_id;
+    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
+  }
+  self->private_impl.f_got_dictionary = true;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_multi_member
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_multi_member(wuffs_zlib__decoder* self, bool a_mm) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_multi_member = a_mm;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_report_member_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_report_member_boundaries(wuffs_zlib__decoder* self,
+                                                  bool a_rmb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  self->private_impl.f_report_member_boundaries = a_rmb;
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_dst_holds_history
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_dst_holds_history(wuffs_zlib__decoder* self,
+                                           bool a_dhh) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  {
-    wuffs_base__status z = wuffs_adler32__hasher__initialize(
-        &self->private_data.f_dict_id_hasher,
-        sizeof(self->private_data.f_dict_id_hasher), WUFFS_VERSION,
-        initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+
+  wuffs_deflate__decoder__set_dst_holds_history(&self->private_data.f_flate,
+                                                a_dhh);
+  return wuffs_base__make_empty_struct();
+}
+
+// -------- func zlib.decoder.set_dst_holds_window
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_dst_holds_window(wuffs_zlib__decoder* self,
+                                          bool a_dhw) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
   }
-  {
-    wuffs_base__status z = wuffs_deflate__decoder__initialize(
-        &self->private_data.f_flate, sizeof(self->private_data.f_flate),
-        WUFFS_VERSION, initialize_flags);
-    if (z.repr) {
-      return z;
-    }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
   }
-  self->private_impl.magic = WUFFS_BASE__MAGIC;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.vtable_name =
-      wuffs_base__io_transformer__vtable_name;
-  self->private_impl.vtable_for__wuffs_base__io_transformer.function_pointers =
-      (const void*)(&wuffs_zlib__decoder__func_ptrs_for__wuffs_base__io_transformer);
-  return wuffs_base__make_status(NULL);
+
+  wuffs_deflate__decoder__set_dst_holds_window(&self->private_data.f_flate,
+                                               a_dhw);
+  return wuffs_base__make_empty_struct();
 }
 
-size_t  //
-sizeof__wuffs_zlib__decoder() {
-  return sizeof(wuffs_zlib__decoder);
+// -------- func zlib.decoder.set_report_block_boundaries
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
+wuffs_zlib__decoder__set_report_block_boundaries(wuffs_zlib__decoder* self,
+                                                 bool a_rbb) {
+  if (!self) {
+    return wuffs_base__make_empty_struct();
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return wuffs_base__make_empty_struct();
+  }
+
+  wuffs_deflate__decoder__set_report_block_boundaries(
+      &self->private_data.f_flate, a_rbb);
+  return wuffs_base__make_empty_struct();
 }
 
-// ---------------- Function Implementations
+// -------- func zlib.decoder.held_bits
 
-// -------- func zlib.decoder.dictionary_id
+WUFFS_BASE__MAYBE_STATIC uint32_t  //
+wuffs_zlib__decoder__held_bits(const wuffs_zlib__decoder* self) {
+  if (!self) {
+    return 0;
+  }
+  if ((self->private_impl.magic != WUFFS_BASE__MAGIC) &&
+      (self->private_impl.magic != WUFFS_BASE__DISABLED)) {
+    return 0;
+  }
+
+  return wuffs_deflate__decoder__held_bits(&self->private_data.f_flate);
+}
+
+// -------- func zlib.decoder.n_held_bits
 
 WUFFS_BASE__MAYBE_STATIC uint32_t  //
-wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
+wuffs_zlib__decoder__n_held_bits(const wuffs_zlib__decoder* self) {
   if (!self) {
     return 0;
   }
@@ -22220,14 +31865,32 @@ wuffs_zlib__decoder__dictionary_id(const wuffs_zlib__decoder* self) {
     return 0;
   }
 
-  return self->private_impl.f_dict_id_want;
+  return wuffs_deflate__decoder__n_held_bits(&self->private_data.f_flate);
 }
 
-// -------- func zlib.decoder.add_dictionary
+// -------- func zlib.decoder.copy_history
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_zlib__decoder__copy_history(wuffs_zlib__decoder* self,
+                                  wuffs_base__slice_u8 a_dst) {
+  if (!self) {
+    return 0;
+  }
+  if (self->private_impl.magic != WUFFS_BASE__MAGIC) {
+    return 0;
+  }
+
+  uint64_t v_n = 0;
+
+  v_n =
+      wuffs_deflate__decoder__copy_history(&self->private_data.f_flate, a_dst);
+  return v_n;
+}
+
+// -------- func zlib.decoder.set_fused_checksum
 
 WUFFS_BASE__MAYBE_STATIC wuffs_base__empty_struct  //
-wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
-                                    wuffs_base__slice_u8 a_dict) {
+wuffs_zlib__decoder__set_fused_checksum(wuffs_zlib__decoder* self, bool a_fc) {
   if (!self) {
     return wuffs_base__make_empty_struct();
   }
@@ -22235,14 +31898,7 @@ wuffs_zlib__decoder__add_dictionary(wuffs_zlib__decoder* self,
     return wuffs_base__make_empty_struct();
   }
 
-  if (self->private_impl.f_header_complete) {
-    self->private_impl.f_bad_call_sequence = true;
-  } else {
-    self->private_impl.f_dict_id_got = wuffs_adler32__hasher__update_u32(
-        &self->private_data.f_dict_id_hasher, a_dict);
-    wuffs_deflate__decoder__add_history(&self->private_data.f_flate, a_dict);
-  }
-  self->private_impl.f_got_dictionary = true;
+  self->private_impl.f_fused_checksum = a_fc;
   return wuffs_base__make_empty_struct();
 }
 
@@ -22310,6 +31966,7 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
   wuffs_base__status v_status = wuffs_base__make_status(NULL);
   uint32_t v_checksum_want = 0;
   uint64_t v_mark = 0;
+  bool v_stride = false;
 
   uint8_t* iop_a_dst = NULL;
   uint8_t* io0_a_dst WUFFS_BASE__POTENTIALLY_UNUSED = NULL;
@@ -22345,63 +32002,18 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
     if (self->private_impl.f_bad_call_sequence) {
       status = wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
       goto exit;
-    } else if (!self->private_impl.f_want_dictionary) {
-      {
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
-        uint16_t t_0;
-        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
-          t_0 = wuffs_base__load_u16be__no_bounds_check(iop_a_src);
-          iop_a_src += 2;
-        } else {
-          self->private_data.s_transform_io[0].scratch = 0;
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
-          while (true) {
-            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-              status =
-                  wuffs_base__make_status(wuffs_base__suspension__short_read);
-              goto suspend;
-            }
-            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-            uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
-            *scratch >>= 8;
-            *scratch <<= 8;
-            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
-            if (num_bits_0 == 8) {
-              t_0 = ((uint16_t)(*scratch >> 48));
-              break;
-            }
-            num_bits_0 += 8;
-            *scratch |= ((uint64_t)(num_bits_0));
-          }
-        }
-        v_x = t_0;
-      }
-      if (((v_x >> 8) & 15) != 8) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__bad_compression_method);
-        goto exit;
-      }
-      if ((v_x >> 12) > 7) {
-        status = wuffs_base__make_status(
-            wuffs_zlib__error__bad_compression_window_size);
-        goto exit;
-      }
-      if ((v_x % 31) != 0) {
-        status = wuffs_base__make_status(wuffs_zlib__error__bad_parity_check);
-        goto exit;
-      }
-      self->private_impl.f_want_dictionary = ((v_x & 32) != 0);
-      if (self->private_impl.f_want_dictionary) {
-        self->private_impl.f_dict_id_got = 1;
+    }
+    while (true) {
+      if (!self->private_impl.f_want_dictionary) {
         {
-          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
-          uint32_t t_1;
-          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-            t_1 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
-            iop_a_src += 4;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(1);
+          uint16_t t_0;
+          if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 2)) {
+            t_0 = wuffs_base__load_u16be__no_bounds_check(iop_a_src);
+            iop_a_src += 2;
           } else {
             self->private_data.s_transform_io[0].scratch = 0;
-            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(2);
             while (true) {
               if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
                 status =
@@ -22409,105 +32021,229 @@ wuffs_zlib__decoder__transform_io(wuffs_zlib__decoder* self,
                 goto suspend;
               }
               uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-              uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+              uint32_t num_bits_0 = ((uint32_t)(*scratch & 0xFF));
               *scratch >>= 8;
               *scratch <<= 8;
-              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
-              if (num_bits_1 == 24) {
-                t_1 = ((uint32_t)(*scratch >> 32));
+              *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_0);
+              if (num_bits_0 == 8) {
+                t_0 = ((uint16_t)(*scratch >> 48));
                 break;
               }
-              num_bits_1 += 8;
-              *scratch |= ((uint64_t)(num_bits_1));
+              num_bits_0 += 8;
+              *scratch |= ((uint64_t)(num_bits_0));
+            }
+          }
+          v_x = t_0;
+        }
+        if (((v_x >> 8) & 15) != 8) {
+          status = wuffs_base__make_status(
+              wuffs_zlib__error__bad_compression_method);
+          goto exit;
+        }
+        if ((v_x >> 12) > 7) {
+          status = wuffs_base__make_status(
+              wuffs_zlib__error__bad_compression_window_size);
+          goto exit;
+        }
+        if ((v_x % 31) != 0) {
+          status = wuffs_base__make_status(wuffs_zlib__error__bad_parity_check);
+          goto exit;
+        }
+        self->private_impl.f_want_dictionary = ((v_x & 32) != 0);
+        if (self->private_impl.f_want_dictionary) {
+          self->private_impl.f_dict_id_got = 1;
+          {
+            WUFFS_BASE__COROUTINE_SUSPENSION_POINT(3);
+            uint32_t t_1;
+            if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+              t_1 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
+              iop_a_src += 4;
+            } else {
+              self->private_data.s_transform_io[0].scratch = 0;
+              WUFFS_BASE__COROUTINE_SUSPENSION_POINT(4);
+              while (true) {
+                if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+                  status = wuffs_base__make_status(
+                      wuffs_base__suspension__short_read);
+                  goto suspend;
+                }
+                uint64_t* scratch =
+                    &self->private_data.s_transform_io[0].scratch;
+                uint32_t num_bits_1 = ((uint32_t)(*scratch & 0xFF));
+                *scratch >>= 8;
+                *scratch <<= 8;
+                *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_1);
+                if (num_bits_1 == 24) {
+                  t_1 = ((uint32_t)(*scratch >> 32));
+                  break;
+                }
+                num_bits_1 += 8;
+                *scratch |= ((uint64_t)(num_bits_1));
+              }
             }
+            self->private_impl.f_dict_id_want = t_1;
           }
-          self->private_impl.f_dict_id_want = t_1;
+          status =
+              wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
+          goto ok;
+        } else if (self->private_impl.f_got_dictionary) {
+          status =
+              wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
+          goto exit;
+        }
+      } else if (self->private_impl.f_dict_id_got !=
+                 self->private_impl.f_dict_id_want) {
+        if (self->private_impl.f_got_dictionary) {
+          status =
+              wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
+          goto exit;
         }
         status = wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
         goto ok;
-      } else if (self->private_impl.f_got_dictionary) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
-        goto exit;
-      }
-    } else if (self->private_impl.f_dict_id_got !=
-               self->private_impl.f_dict_id_want) {
-      if (self->private_impl.f_got_dictionary) {
-        status =
-            wuffs_base__make_status(wuffs_zlib__error__incorrect_dictionary);
-        goto exit;
       }
-      status = wuffs_base__make_status(wuffs_zlib__note__dictionary_required);
-      goto ok;
-    }
-    self->private_impl.f_header_complete = true;
-    while (true) {
-      v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
-      {
-        if (a_dst) {
-          a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+      self->private_impl.f_header_complete = true;
+    label__0__continue:;
+      while (true) {
+        v_mark = ((uint64_t)(iop_a_dst - io0_a_dst));
+        v_stride = (self->private_impl.f_fused_checksum &&
+                    !self->private_impl.f_ignore_checksum &&
+                    (((uint64_t)(io2_a_dst - iop_a_dst)) > 16384));
+        if (v_stride) {
+          wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+              &self->private_data.f_flate, true);
+          {
+            wuffs_base__io_buffer* o_0_a_dst = a_dst;
+            wuffs_base__io_buffer o_0_u_a_dst;
+            uint8_t* o_0_io2_a_dst = io2_a_dst;
+            a_dst = wuffs_base__io_writer__limit(&o_0_u_a_dst, a_dst, iop_a_dst,
+                                                 &io2_a_dst, 16384);
+            {
+              if (a_dst) {
+                a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+              }
+              if (a_src) {
+                a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+              }
+              wuffs_base__status t_2 = wuffs_deflate__decoder__transform_io(
+                  &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+              if (a_dst) {
+                iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+              }
+              if (a_src) {
+                iop_a_src = a_src->data.ptr + a_src->meta.ri;
+              }
+              v_status = t_2;
+            }
+            a_dst = o_0_a_dst;
+            io2_a_dst = o_0_io2_a_dst;
+          }
+          wuffs_deflate__decoder__set_dst_holds_history_on_short_write(
+              &self->private_data.f_flate, false);
+        } else {
+          {
+            if (a_dst) {
+              a_dst->meta.wi = ((size_t)(iop_a_dst - a_dst->data.ptr));
+            }
+            if (a_src) {
+              a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+            }
+            wuffs_base__status t_3 = wuffs_deflate__decoder__transform_io(
+                &self->private_data.f_flate, a_dst, a_src, a_workbuf);
+            if (a_dst) {
+              iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+            }
+            if (a_src) {
+              iop_a_src = a_src->data.ptr + a_src->meta.ri;
+            }
+            v_status = t_3;
+          }
         }
-        if (a_src) {
-          a_src->meta.ri = ((size_t)(iop_a_src - a_src->data.ptr));
+        if (!self->private_impl.f_ignore_checksum) {
+          v_checksum_got = wuffs_adler32__hasher__update_u32(
+              &self->private_data.f_checksum,
+              wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
+                                    io0_a_dst));
         }
-        wuffs_base__status t_2 = wuffs_deflate__decoder__transform_io(
-            &self->private_data.f_flate, a_dst, a_src, a_workbuf);
-        if (a_dst) {
-          iop_a_dst = a_dst->data.ptr + a_dst->meta.wi;
+        if (wuffs_base__status__is_ok(&v_status)) {
+          goto label__0__break;
+        } else if (v_stride &&
+                   (v_status.repr ==
+                    wuffs_base__make_status(wuffs_base__suspension__short_write)
+                        .repr)) {
+          goto label__0__continue;
         }
-        if (a_src) {
-          iop_a_src = a_src->data.ptr + a_src->meta.ri;
+        status = v_status;
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
+      }
+    label__0__break:;
+      {
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
+        uint32_t t_4;
+        if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
+          t_4 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
+          iop_a_src += 4;
+        } else {
+          self->private_data.s_transform_io[0].scratch = 0;
+          WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
+          while (true) {
+            if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
+              status =
+                  wuffs_base__make_status(wuffs_base__suspension__short_read);
+              goto suspend;
+            }
+            uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
+            uint32_t num_bits_4 = ((uint32_t)(*scratch & 0xFF));
+            *scratch >>= 8;
+            *scratch <<= 8;
+            *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_4);
+            if (num_bits_4 == 24) {
+              t_4 = ((uint32_t)(*scratch >> 32));
+              break;
+            }
+            num_bits_4 += 8;
+            *scratch |= ((uint64_t)(num_bits_4));
+          }
         }
-        v_status = t_2;
+        v_checksum_want = t_4;
       }
-      if (!self->private_impl.f_ignore_checksum) {
-        v_checksum_got = wuffs_adler32__hasher__update_u32(
-            &self->private_data.f_checksum,
-            wuffs_base__io__since(v_mark, ((uint64_t)(iop_a_dst - io0_a_dst)),
-                                  io0_a_dst));
+      if (!self->private_impl.f_ignore_checksum &&
+          (v_checksum_got != v_checksum_want)) {
+        status = wuffs_base__make_status(wuffs_zlib__error__bad_checksum);
+        goto exit;
       }
-      if (wuffs_base__status__is_ok(&v_status)) {
-        goto label__0__break;
+      if (!self->private_impl.f_multi_member) {
+        goto label__member__break;
       }
-      status = v_status;
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(5);
-    }
-  label__0__break:;
-    {
-      WUFFS_BASE__COROUTINE_SUSPENSION_POINT(6);
-      uint32_t t_3;
-      if (WUFFS_BASE__LIKELY(io2_a_src - iop_a_src >= 4)) {
-        t_3 = wuffs_base__load_u32be__no_bounds_check(iop_a_src);
-        iop_a_src += 4;
-      } else {
-        self->private_data.s_transform_io[0].scratch = 0;
-        WUFFS_BASE__COROUTINE_SUSPENSION_POINT(7);
-        while (true) {
-          if (WUFFS_BASE__UNLIKELY(iop_a_src == io2_a_src)) {
-            status =
-                wuffs_base__make_status(wuffs_base__suspension__short_read);
-            goto suspend;
-          }
-          uint64_t* scratch = &self->private_data.s_transform_io[0].scratch;
-          uint32_t num_bits_3 = ((uint32_t)(*scratch & 0xFF));
-          *scratch >>= 8;
-          *scratch <<= 8;
-          *scratch |= ((uint64_t)(*iop_a_src++)) << (56 - num_bits_3);
-          if (num_bits_3 == 24) {
-            t_3 = ((uint32_t)(*scratch >> 32));
-            break;
-          }
-          num_bits_3 += 8;
-          *scratch |= ((uint64_t)(num_bits_3));
+      while (true) {
+        if (((uint64_t)(io2_a_src - iop_a_src)) > 0) {
+          goto label__1__break;
+        } else if (a_src && a_src->meta.closed) {
+          goto label__member__break;
         }
+        status = wuffs_base__make_status(wuffs_base__suspension__short_read);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(8);
+      }
+    label__1__break:;
+      self->private_impl.f_header_complete = false;
+      self->private_impl.f_got_dictionary = false;
+      self->private_impl.f_want_dictionary = false;
+      wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(
+          &self->private_data.f_checksum, sizeof(wuffs_adler32__hasher),
+          WUFFS_VERSION, 0));
+      wuffs_base__ignore_status(wuffs_adler32__hasher__initialize(
+          &self->private_data.f_dict_id_hasher, sizeof(wuffs_adler32__hasher),
+          WUFFS_VERSION, 0));
+      v_checksum_got = 0;
+      wuffs_deflate__decoder__resume_at_checkpoint(
+          &self->private_data.f_flate, 0, 0,
+          wuffs_base__utility__empty_slice_u8());
+      if (self->private_impl.f_report_member_boundaries) {
+        status =
+            wuffs_base__make_status(wuffs_zlib__suspension__member_boundary);
+        WUFFS_BASE__COROUTINE_SUSPENSION_POINT_MAYBE_SUSPEND(9);
       }
-      v_checksum_want = t_3;
-    }
-    if (!self->private_impl.f_ignore_checksum &&
-        (v_checksum_got != v_checksum_want)) {
-      status = wuffs_base__make_status(wuffs_zlib__error__bad_checksum);
-      goto exit;
     }
+  label__member__break:;
 
     goto ok;
   ok:
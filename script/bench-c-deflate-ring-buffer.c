@@ -0,0 +1,328 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// This file contains a hand-written C benchmark of different strategies for
+// streaming gzip decoding into a fixed size dst buffer. It is Linux-only.
+//
+// Its stdin should be gzip-compressed, e.g. test/data/pi.txt.gz.
+//
+// Both strategies hand the decoder a fixed amount of room, RING_ROOM bytes,
+// per call. When that is full (a short write), the caller consumes the output
+// and makes more room.
+//
+// "ArrayHistory" simply compacts dst. On each short write, the decoder copies
+// the most recent 32 KiB of output into its internal history array, as
+// back-references can reach up to 32 KiB into the past.
+//
+// "RingHistory" uses a ring buffer of RING_SIZE bytes whose physical memory
+// is mmap'ed three times in a row, as per script/mmap-ring-buffer.c. Each dst
+// window starts 32 KiB (or less, at the start of the stream) before the next
+// byte to write. Because of the aliasing, those 32 KiB are always the most
+// recent output and making room is just moving the window: no bytes are
+// copied and the window never needs to split at the ring's boundary. The
+// decoder is told so via set_dst_holds_window, and never writes to its own
+// history array.
+//
+// With a smaller RING_ROOM, there are more short writes and the difference
+// between the two strategies is larger.
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* cc = "clang";
+const char* cc_version = __clang_version__;
+#elif defined(__GNUC__)
+const char* cc = "gcc";
+const char* cc_version = __VERSION__;
+#else
+const char* cc = "cc";
+const char* cc_version = "???";
+#endif
+
+#define HISTORY_SIZE (32 * 1024)
+#ifndef RING_SIZE
+#define RING_SIZE (256 * 1024)
+#endif
+#define RING_ROOM (RING_SIZE - HISTORY_SIZE)
+#define SRC_BUFFER_ARRAY_SIZE (64 * 1024 * 1024)
+
+uint8_t array_buffer[RING_ROOM] = {0};
+uint8_t* ring_base = NULL;
+uint8_t src_buffer_array[SRC_BUFFER_ARRAY_SIZE] = {0};
+size_t src_len = 0;
+
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t work_buffer_array[1];
+#endif
+
+// See script/mmap-ring-buffer.c for why we don't use <sys/memfd.h>.
+static int  //
+my_memfd_create(const char* name, unsigned int flags) {
+  return syscall(__NR_memfd_create, name, flags);
+}
+
+const char*  //
+make_ring_buffer() {
+  int page_size = getpagesize();
+  if ((page_size <= 0) || ((RING_SIZE % page_size) != 0)) {
+    return "RING_SIZE is not a multiple of the page size";
+  }
+
+  int memfd = my_memfd_create("ring", 0);
+  if (memfd == -1) {
+    return strerror(errno);
+  }
+  if (ftruncate(memfd, RING_SIZE) == -1) {
+    return strerror(errno);
+  }
+
+  // Have the kernel find a contiguous range of unused address space.
+  void* base =
+      mmap(NULL, 3 * RING_SIZE, PROT_NONE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+  if (base == MAP_FAILED) {
+    return strerror(errno);
+  }
+
+  // Map that "ring" file 3 times, filling that range exactly.
+  int i;
+  for (i = 0; i < 3; i++) {
+    void* p = mmap((uint8_t*)(base) + (i * RING_SIZE), RING_SIZE,
+                   PROT_READ | PROT_WRITE, MAP_FIXED | MAP_SHARED, memfd, 0);
+    if (p == MAP_FAILED) {
+      return strerror(errno);
+    }
+  }
+
+  close(memfd);
+  ring_base = (uint8_t*)(base);
+  return NULL;
+}
+
+const char*  //
+read_stdin() {
+  while (src_len < SRC_BUFFER_ARRAY_SIZE) {
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, src_buffer_array + src_len,
+                     SRC_BUFFER_ARRAY_SIZE - src_len);
+    if (n > 0) {
+      src_len += n;
+    } else if (n == 0) {
+      return NULL;
+    } else if (errno == EINTR) {
+      // No-op.
+    } else {
+      return strerror(errno);
+    }
+  }
+  return "input is too large";
+}
+
+// decode_once decodes stdin's gzip data, returning the number of bytes
+// decoded in *n_out.
+const char*  //
+decode_once(bool ring, uint64_t* n_out) {
+  wuffs_gzip__decoder dec;
+  wuffs_base__status status =
+      wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  if (ring) {
+    wuffs_gzip__decoder__set_dst_holds_window(&dec, true);
+  }
+
+  wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
+      .data = ((wuffs_base__slice_u8){
+          .ptr = array_buffer,
+          .len = RING_ROOM,
+      }),
+  });
+  if (ring) {
+    dst.data.ptr = ring_base + RING_SIZE;
+  }
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = ((wuffs_base__slice_u8){
+          .ptr = src_buffer_array,
+          .len = src_len,
+      }),
+      .meta = ((wuffs_base__io_buffer_meta){
+          .wi = src_len,
+          .ri = 0,
+          .pos = 0,
+          .closed = true,
+      }),
+  });
+
+  // n is the total number of bytes decoded before dst.meta.wi.
+  uint64_t n = 0;
+  while (true) {
+    status =
+        wuffs_gzip__decoder__transform_io(&dec, &dst, &src,
+                                          ((wuffs_base__slice_u8){
+                                              .ptr = work_buffer_array,
+                                              .len = WORK_BUFFER_ARRAY_SIZE,
+                                          }));
+    if (status.repr != wuffs_base__suspension__short_write) {
+      break;
+    }
+
+    // Consume the output (this program just counts it) and make more room.
+    if (!ring) {
+      n += dst.meta.wi;
+      dst.meta.wi = 0;
+      continue;
+    }
+    n += dst.meta.wi - (dst.data.len - RING_ROOM);
+    size_t history = (n < HISTORY_SIZE) ? n : HISTORY_SIZE;
+    dst.data.ptr = ring_base + RING_SIZE + (n % RING_SIZE) - history;
+    dst.data.len = history + RING_ROOM;
+    dst.meta.wi = history;
+  }
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  n += dst.meta.wi - (ring ? (dst.data.len - RING_ROOM) : 0);
+  *n_out = n;
+  return NULL;
+}
+
+const char*  //
+decode(bool ring, uint64_t* n_out) {
+  int reps;
+  if (src_len < 100000) {
+    reps = 1000;
+  } else if (src_len < 1000000) {
+    reps = 100;
+  } else if (src_len < 10000000) {
+    reps = 10;
+  } else {
+    reps = 1;
+  }
+
+  struct timeval bench_start_tv;
+  gettimeofday(&bench_start_tv, NULL);
+
+  int i;
+  for (i = 0; i < reps; i++) {
+    const char* msg = decode_once(ring, n_out);
+    if (msg) {
+      return msg;
+    }
+  }
+
+  struct timeval bench_finish_tv;
+  gettimeofday(&bench_finish_tv, NULL);
+  int64_t micros =
+      (int64_t)(bench_finish_tv.tv_sec - bench_start_tv.tv_sec) * 1000000 +
+      (int64_t)(bench_finish_tv.tv_usec - bench_start_tv.tv_usec);
+  uint64_t nanos = 1;
+  if (micros > 0) {
+    nanos = (uint64_t)(micros)*1000;
+  }
+
+  printf("Benchmark%sHistory/%s\t%8d\t%8" PRIu64 " ns/op\n",
+         ring ? "Ring" : "Array", cc, reps, nanos / reps);
+
+  return NULL;
+}
+
+int  //
+fail(const char* msg) {
+  const int stderr_fd = 2;
+  write(stderr_fd, msg, strnlen(msg, 4095));
+  write(stderr_fd, "\n", 1);
+  return 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  const char* msg = read_stdin();
+  if (msg) {
+    return fail(msg);
+  }
+  msg = make_ring_buffer();
+  if (msg) {
+    return fail(msg);
+  }
+
+  printf("# %s version %s\n#\n", cc, cc_version);
+  printf(
+      "# The output format, including the \"Benchmark\" prefixes, is "
+      "compatible with the\n"
+      "# https://godoc.org/golang.org/x/perf/cmd/benchstat tool. To install "
+      "it, first\n"
+      "# install Go, then run \"go get golang.org/x/perf/cmd/benchstat\".\n");
+
+  int i;
+  for (i = 0; i < 5; i++) {
+    uint64_t n_array = 0;
+    uint64_t n_ring = 0;
+    msg = decode(false, &n_array);
+    if (msg) {
+      return fail(msg);
+    }
+    msg = decode(true, &n_ring);
+    if (msg) {
+      return fail(msg);
+    }
+    if (n_array != n_ring) {
+      return fail("inconsistent number of bytes decoded");
+    }
+  }
+
+  return 0;
+}
+
+#else  // defined(__linux__)
+
+#include <stdio.h>
+
+int  //
+main(int argc, char** argv) {
+  fprintf(stderr, "this program requires Linux\n");
+  return 1;
+}
+
+#endif  // defined(__linux__)
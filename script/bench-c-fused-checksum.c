@@ -0,0 +1,307 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// This file contains a hand-written C benchmark of gzip or zlib decoding with
+// and without the decoder's set_fused_checksum option, into a single dst
+// buffer that is large enough to hold all of the output.
+//
+// Its stdin should be gzip- or zlib-compressed. The interesting inputs are
+// those whose decoded size is far larger than the CPU's caches (e.g. 100 MB),
+// such as:
+//
+//   for i in $(seq 1000); do cat test/data/pi.txt; done | gzip > /tmp/pi.gz
+//   gcc -O3 script/bench-c-fused-checksum.c && ./a.out < /tmp/pi.gz
+//
+// or a zlib stream of a large PNG image's filtered rows (the concatenated
+// IDAT chunks' payload), which is what a PNG decoder would decode.
+//
+// "Unfused" lets one DEFLATE decoder call fill dst before checksumming it, so
+// that the CRC-32 or Adler-32 computation re-reads that output from main
+// memory. "Fused" checksums the output in strides small enough to still be in
+// cache.
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../release/c/wuffs-unsupported-snapshot.c"
+
+// The order matters here. Clang also defines "__GNUC__".
+#if defined(__clang__)
+const char* cc = "clang";
+const char* cc_version = __clang_version__;
+#elif defined(__GNUC__)
+const char* cc = "gcc";
+const char* cc_version = __VERSION__;
+#else
+const char* cc = "cc";
+const char* cc_version = "???";
+#endif
+
+#define SRC_BUFFER_ARRAY_SIZE (256 * 1024 * 1024)
+
+bool is_gzip = false;
+uint8_t* src_buffer_array = NULL;
+size_t src_len = 0;
+uint8_t* dst_buffer_array = NULL;
+size_t dst_len = 0;
+
+// Neither the gzip nor the zlib decoder needs a work buffer, but in case
+// that changes, use the larger of their worst case lengths.
+#if WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE > \
+    WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_GZIP__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+#else
+#define WORK_BUFFER_ARRAY_SIZE \
+  WUFFS_ZLIB__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE
+#endif
+#if WORK_BUFFER_ARRAY_SIZE > 0
+uint8_t work_buffer_array[WORK_BUFFER_ARRAY_SIZE];
+#else
+// Not all C/C++ compilers support 0-length arrays.
+uint8_t work_buffer_array[1];
+#endif
+
+const char*  //
+read_stdin() {
+  src_buffer_array = (uint8_t*)(malloc(SRC_BUFFER_ARRAY_SIZE));
+  if (!src_buffer_array) {
+    return "could not allocate src buffer";
+  }
+  while (src_len < SRC_BUFFER_ARRAY_SIZE) {
+    const int stdin_fd = 0;
+    ssize_t n = read(stdin_fd, src_buffer_array + src_len,
+                     SRC_BUFFER_ARRAY_SIZE - src_len);
+    if (n > 0) {
+      src_len += n;
+    } else if (n == 0) {
+      return NULL;
+    } else if (errno == EINTR) {
+      // No-op.
+    } else {
+      return strerror(errno);
+    }
+  }
+  return "input is too large";
+}
+
+const char* decode_once(bool fused, uint64_t* n_out);
+
+// make_dst_buffer allocates a dst buffer as large as the decoded size. For
+// gzip, that is what the trailer's ISIZE (modulo 4 GiB) says. For zlib, the
+// data is first decoded (and discarded) 1 MiB at a time, to count it.
+const char*  //
+make_dst_buffer() {
+  if (src_len < 2) {
+    return "input is too short";
+  }
+  is_gzip = (src_buffer_array[0] == 0x1F) && (src_buffer_array[1] == 0x8B);
+  if (is_gzip) {
+    if (src_len < 18) {
+      return "input is too short";
+    }
+    dst_len =
+        wuffs_base__load_u32le__no_bounds_check(src_buffer_array + src_len - 4);
+  } else {
+    dst_len = 1024 * 1024;
+    dst_buffer_array = (uint8_t*)(malloc(dst_len));
+    if (!dst_buffer_array) {
+      return "could not allocate dst buffer";
+    }
+    uint64_t n = 0;
+    const char* msg = decode_once(false, &n);
+    free(dst_buffer_array);
+    if (msg) {
+      return msg;
+    }
+    dst_len = n;
+  }
+  dst_buffer_array = (uint8_t*)(malloc(dst_len ? dst_len : 1));
+  if (!dst_buffer_array) {
+    return "could not allocate dst buffer";
+  }
+  return NULL;
+}
+
+// decode_once decodes stdin's gzip or zlib data, returning the number of
+// bytes decoded in *n_out. If dst is too small, its contents are discarded
+// (but counted) whenever it is full.
+const char*  //
+decode_once(bool fused, uint64_t* n_out) {
+  wuffs_gzip__decoder gzip_dec;
+  wuffs_zlib__decoder zlib_dec;
+  wuffs_base__io_transformer* dec = NULL;
+  wuffs_base__status status;
+  if (is_gzip) {
+    status = wuffs_gzip__decoder__initialize(
+        &gzip_dec, sizeof gzip_dec, WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    wuffs_gzip__decoder__set_fused_checksum(&gzip_dec, fused);
+    dec = wuffs_gzip__decoder__upcast_as__wuffs_base__io_transformer(&gzip_dec);
+  } else {
+    status = wuffs_zlib__decoder__initialize(
+        &zlib_dec, sizeof zlib_dec, WUFFS_VERSION,
+        WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED);
+    wuffs_zlib__decoder__set_fused_checksum(&zlib_dec, fused);
+    dec = wuffs_zlib__decoder__upcast_as__wuffs_base__io_transformer(&zlib_dec);
+  }
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+
+  wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
+      .data = ((wuffs_base__slice_u8){
+          .ptr = dst_buffer_array,
+          .len = dst_len,
+      }),
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = ((wuffs_base__slice_u8){
+          .ptr = src_buffer_array,
+          .len = src_len,
+      }),
+      .meta = ((wuffs_base__io_buffer_meta){
+          .wi = src_len,
+          .ri = 0,
+          .pos = 0,
+          .closed = true,
+      }),
+  });
+
+  uint64_t n = 0;
+  while (true) {
+    status = wuffs_base__io_transformer__transform_io(
+        dec, &dst, &src,
+        ((wuffs_base__slice_u8){
+            .ptr = work_buffer_array,
+            .len = WORK_BUFFER_ARRAY_SIZE,
+        }));
+    n += dst.meta.wi;
+    dst.meta.wi = 0;
+    if (status.repr != wuffs_base__suspension__short_write) {
+      break;
+    }
+  }
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__status__message(&status);
+  }
+  *n_out = n;
+  return NULL;
+}
+
+const char*  //
+decode(bool fused, uint64_t* n_out) {
+  int reps;
+  if (dst_len < 100000) {
+    reps = 1000;
+  } else if (dst_len < 1000000) {
+    reps = 100;
+  } else if (dst_len < 10000000) {
+    reps = 10;
+  } else {
+    reps = 1;
+  }
+
+  struct timeval bench_start_tv;
+  gettimeofday(&bench_start_tv, NULL);
+
+  int i;
+  for (i = 0; i < reps; i++) {
+    const char* msg = decode_once(fused, n_out);
+    if (msg) {
+      return msg;
+    }
+  }
+
+  struct timeval bench_finish_tv;
+  gettimeofday(&bench_finish_tv, NULL);
+  int64_t micros =
+      (int64_t)(bench_finish_tv.tv_sec - bench_start_tv.tv_sec) * 1000000 +
+      (int64_t)(bench_finish_tv.tv_usec - bench_start_tv.tv_usec);
+  uint64_t nanos = 1;
+  if (micros > 0) {
+    nanos = (uint64_t)(micros)*1000;
+  }
+
+  printf("Benchmark%sChecksum/%s\t%8d\t%8" PRIu64 " ns/op\t%8.3f MB/s\n",
+         fused ? "Fused" : "Unfused", cc, reps, nanos / reps,
+         ((double)(*n_out) * reps * 1e3) / ((double)(nanos)));
+
+  return NULL;
+}
+
+int  //
+fail(const char* msg) {
+  const int stderr_fd = 2;
+  write(stderr_fd, msg, strnlen(msg, 4095));
+  write(stderr_fd, "\n", 1);
+  return 1;
+}
+
+int  //
+main(int argc, char** argv) {
+  const char* msg = read_stdin();
+  if (msg) {
+    return fail(msg);
+  }
+  msg = make_dst_buffer();
+  if (msg) {
+    return fail(msg);
+  }
+
+  printf("# %s version %s\n#\n", cc, cc_version);
+  printf(
+      "# The output format, including the \"Benchmark\" prefixes, is "
+      "compatible with the\n"
+      "# https://godoc.org/golang.org/x/perf/cmd/benchstat tool. To install "
+      "it, first\n"
+      "# install Go, then run \"go get golang.org/x/perf/cmd/benchstat\".\n");
+
+  int i;
+  for (i = 0; i < 5; i++) {
+    uint64_t n_unfused = 0;
+    uint64_t n_fused = 0;
+    msg = decode(false, &n_unfused);
+    if (msg) {
+      return fail(msg);
+    }
+    msg = decode(true, &n_fused);
+    if (msg) {
+      return fail(msg);
+    }
+    if (n_unfused != n_fused) {
+      return fail("inconsistent number of bytes decoded");
+    }
+  }
+
+  return 0;
+}
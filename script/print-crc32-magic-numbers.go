@@ -34,8 +34,46 @@ func main() {
 }
 
 func main1() error {
+	printTables("ieee", crc32.IEEE)
+	fmt.Println()
+	printTables("castagnoli", crc32.Castagnoli)
+
+	// See "Combining Checksums" in std/crc32/README.md. x2nTable[i] is
+	// x**(2**i) modulo the IEEE polynomial, in bit-reflected form. x**0 is
+	// 0x80000000 and x**1 is 0x40000000.
+	x2nTable := [32]uint32{}
+	x2nTable[0] = 0x40000000
+	for i := 1; i < 32; i++ {
+		x2nTable[i] = multiplyModP(x2nTable[i-1], x2nTable[i-1], crc32.IEEE)
+	}
+
+	fmt.Println()
+	fmt.Println("// ieee_x2n_table")
+	for j, x := range x2nTable {
+		fmt.Printf("0x%08X,", x)
+		if j&7 == 7 {
+			fmt.Println()
+		}
+	}
+
+	// The base library's x86 SSE4.2 CRC-32C implementation hashes three
+	// interleaved blocks (of length n) in parallel, then shifts the partial
+	// checksums past the blocks that follow. Shifting by n bytes multiplies
+	// by x**(8*n), which is calculated as a 64-bit carry-less multiplication
+	// by x**(8*n - 33) followed by a CRC32 instruction (which multiplies by
+	// x**32 and reduces modulo P). The extra x**-1 factor accounts for the
+	// bit-reflected carry-less product being 63, not 64, bits wide.
+	fmt.Println()
+	for _, n := range []int{256, 8192} {
+		fmt.Printf("// castagnoli x**(8*%d - 33)\n0x%08X\n",
+			n, xPowModP(8*n-33, crc32.Castagnoli))
+	}
+	return nil
+}
+
+func printTables(name string, poly uint32) {
 	tables := [16]crc32.Table{}
-	tables[0] = *crc32.MakeTable(crc32.IEEE)
+	tables[0] = *crc32.MakeTable(poly)
 
 	// See "Multi-Byte Lookup Tables" in std/crc32/README.md for more detail on
 	// the slicing-by-M algorithm. We use an M of 16.
@@ -47,6 +85,7 @@ func main1() error {
 		}
 	}
 
+	fmt.Printf("// %s_table\n", name)
 	for i, t := range tables {
 		if i != 0 {
 			fmt.Println("],[")
@@ -58,5 +97,29 @@ func main1() error {
 			}
 		}
 	}
-	return nil
+}
+
+// xPowModP returns x**n modulo poly, in bit-reflected form.
+func xPowModP(n int, poly uint32) (ret uint32) {
+	ret = 0x80000000
+	for ; n > 0; n-- {
+		ret = multiplyModP(ret, 0x40000000, poly)
+	}
+	return ret
+}
+
+// multiplyModP returns (a * b) modulo poly, where all three polynomials are in
+// bit-reflected form.
+func multiplyModP(a uint32, b uint32, poly uint32) (ret uint32) {
+	for m := uint32(0x80000000); m != 0; m >>= 1 {
+		if a&m != 0 {
+			ret ^= b
+		}
+		if b&1 != 0 {
+			b = (b >> 1) ^ poly
+		} else {
+			b = (b >> 1)
+		}
+	}
+	return ret
 }
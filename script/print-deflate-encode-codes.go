@@ -0,0 +1,106 @@
+// Copyright 2017 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// +build ignore
+
+package main
+
+// print-deflate-encode-codes.go prints the std/deflate length_codes and
+// distance_codes values, the inverses of the RFC 1951 section 3.2.5 tables.
+//
+// length_codes is indexed by (length - 3), in the range [0, 255], and maps to
+// an lcode (minus 257), in the range [0, 28].
+//
+// distance_codes is indexed by (distance - 1), in the range [0, 32767], but
+// only has 512 entries. Let d be (distance - 1). If d < 256 then the dcode is
+// distance_codes[d], otherwise it is distance_codes[256 + (d >> 7)].
+//
+// Usage: go run print-deflate-encode-codes.go
+
+import (
+	"fmt"
+)
+
+func main() {
+	lengthCodes := [256]uint32{}
+	for code, base := range lengthBaseNumbers {
+		n := uint32(1) << lengthExtraBits[code]
+		for j := uint32(0); j < n; j++ {
+			if x := base - 3 + j; x < 256 {
+				lengthCodes[x] = uint32(code)
+			}
+		}
+	}
+	// The length 258 has its own code, 28, even though code 27 with 5 extra
+	// bits could also represent it.
+	lengthCodes[255] = 28
+
+	distanceCodes := [512]uint32{}
+	for code, base := range distanceBaseNumbers {
+		n := uint32(1) << distanceExtraBits[code]
+		for j := uint32(0); j < n; j++ {
+			d := base - 1 + j
+			if d < 256 {
+				distanceCodes[d] = uint32(code)
+			} else {
+				distanceCodes[256+(d>>7)] = uint32(code)
+			}
+		}
+	}
+
+	print(lengthCodes[:])
+	fmt.Println()
+	print(distanceCodes[:])
+}
+
+func print(s []uint32) {
+	for i, x := range s {
+		fmt.Printf("%2d,", x)
+		if i&15 == 15 {
+			fmt.Println()
+		} else {
+			fmt.Print(" ")
+		}
+	}
+}
+
+var (
+	lengthBaseNumbers = [29]uint32{
+		3, 4, 5, 6, 7, 8, 9, 10,
+		11, 13, 15, 17, 19, 23, 27, 31,
+		35, 43, 51, 59, 67, 83, 99, 115,
+		131, 163, 195, 227, 258,
+	}
+
+	lengthExtraBits = [29]uint32{
+		0, 0, 0, 0, 0, 0, 0, 0,
+		1, 1, 1, 1, 2, 2, 2, 2,
+		3, 3, 3, 3, 4, 4, 4, 4,
+		5, 5, 5, 5, 0,
+	}
+
+	distanceBaseNumbers = [30]uint32{
+		1, 2, 3, 4, 5, 7, 9, 13,
+		17, 25, 33, 49, 65, 97, 129, 193,
+		257, 385, 513, 769, 1025, 1537, 2049, 3073,
+		4097, 6145, 8193, 12289, 16385, 24577,
+	}
+
+	distanceExtraBits = [30]uint32{
+		0, 0, 0, 0, 1, 1, 2, 2,
+		3, 3, 4, 4, 5, 5, 6, 6,
+		7, 7, 8, 8, 9, 9, 10, 10,
+		11, 11, 12, 12, 13, 13,
+	}
+)
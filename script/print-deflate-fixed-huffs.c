@@ -0,0 +1,92 @@
+// Copyright 2020 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ----------------
+
+// print-deflate-fixed-huffs.c prints the std/deflate fixed_huffs_lcode and
+// fixed_huffs_dcode values: the decoder.huffs lookup tables for the fixed
+// Huffman codes defined in RFC 1951 section 3.2.6.
+//
+// It builds those tables by calling the decoder's init_huff method, which is
+// private, so it #include's the Wuffs implementation directly. If init_huff's
+// table format changes, re-run this program and paste its output into
+// std/deflate/decode_deflate.wuffs.
+//
+// Usage: gcc print-deflate-fixed-huffs.c && ./a.out
+
+#include <inttypes.h>
+#include <stdio.h>
+
+#define WUFFS_IMPLEMENTATION
+#include "../release/c/wuffs-unsupported-snapshot.c"
+
+void  //
+print_table(const char* name, const uint32_t* table, uint32_t n) {
+  printf("pri const %s array[%" PRIu32 "] base.u32 = [\n", name, n);
+  uint32_t i;
+  for (i = 0; i < n; i++) {
+    printf("%s0x%04" PRIX32 "_%04" PRIX32 ",%s", ((i & 7) == 0) ? "\t" : " ",
+           table[i] >> 16, table[i] & 0xFFFF, ((i & 7) == 7) ? "\n" : "");
+  }
+  printf("]\n");
+}
+
+int  //
+main(int argc, char** argv) {
+  wuffs_deflate__decoder dec;
+  wuffs_base__status status = wuffs_deflate__decoder__initialize(
+      &dec, sizeof dec, WUFFS_VERSION, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    fprintf(stderr, "%s\n", wuffs_base__status__message(&status));
+    return 1;
+  }
+
+  uint32_t i = 0;
+  for (; i < 144; i++) {
+    dec.private_data.f_code_lengths[i] = 8;
+  }
+  for (; i < 256; i++) {
+    dec.private_data.f_code_lengths[i] = 9;
+  }
+  for (; i < 280; i++) {
+    dec.private_data.f_code_lengths[i] = 7;
+  }
+  for (; i < 288; i++) {
+    dec.private_data.f_code_lengths[i] = 8;
+  }
+  for (; i < 320; i++) {
+    dec.private_data.f_code_lengths[i] = 5;
+  }
+
+  status = wuffs_deflate__decoder__init_huff(&dec, 0, 0, 288, 257);
+  if (!wuffs_base__status__is_ok(&status)) {
+    fprintf(stderr, "%s\n", wuffs_base__status__message(&status));
+    return 1;
+  }
+  status = wuffs_deflate__decoder__init_huff(&dec, 1, 288, 320, 0);
+  if (!wuffs_base__status__is_ok(&status)) {
+    fprintf(stderr, "%s\n", wuffs_base__status__message(&status));
+    return 1;
+  }
+
+  printf("// n_huffs_bits: %" PRIu32 ", %" PRIu32 "\n\n",
+         dec.private_impl.f_n_huffs_bits[0],
+         dec.private_impl.f_n_huffs_bits[1]);
+  print_table("fixed_huffs_lcode", dec.private_data.f_huffs[0],
+              1 << dec.private_impl.f_n_huffs_bits[0]);
+  printf("\n");
+  print_table("fixed_huffs_dcode", dec.private_data.f_huffs[1],
+              1 << dec.private_impl.f_n_huffs_bits[1]);
+  return 0;
+}
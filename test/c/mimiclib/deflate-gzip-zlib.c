@@ -75,6 +75,15 @@ mimic_deflate_decode(wuffs_base__io_buffer* dst,
                                    rlimit, true);
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     int level) {
+  return "miniz_tinfl.c does not implement deflate encoding";
+}
+
 const char*  //
 mimic_gzip_decode(wuffs_base__io_buffer* dst,
                   wuffs_base__io_buffer* src,
@@ -271,6 +280,81 @@ mimic_deflate_decode(wuffs_base__io_buffer* dst,
                                         zlib_flavor_raw);
 }
 
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     int level) {
+  const char* ret = NULL;
+  if (dst->data.len > UINT_MAX) {
+    ret = "dst length is too large";
+    goto cleanup0;
+  }
+  if (src->data.len > UINT_MAX) {
+    ret = "src length is too large";
+    goto cleanup0;
+  }
+
+  // A negative window_bits means raw deflate, with no zlib or gzip wrapper.
+  z_stream z = {0};
+  int di2_err = deflateInit2(&z, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+  if (di2_err != Z_OK) {
+    ret = "deflateInit2 failed";
+    goto cleanup0;
+  }
+
+  while (true) {
+    z.next_in = src->data.ptr + src->meta.ri;
+    z.avail_in = src->meta.wi - src->meta.ri;
+    if (z.avail_in > rlimit) {
+      z.avail_in = rlimit;
+    }
+    uInt initial_avail_in = z.avail_in;
+
+    z.next_out = dst->data.ptr + dst->meta.wi;
+    z.avail_out = dst->data.len - dst->meta.wi;
+    if (z.avail_out > wlimit) {
+      z.avail_out = wlimit;
+    }
+    uInt initial_avail_out = z.avail_out;
+
+    bool finish = (src->meta.ri + initial_avail_in) == src->meta.wi;
+    int d_err = deflate(&z, finish ? Z_FINISH : Z_NO_FLUSH);
+
+    if (initial_avail_in < z.avail_in) {
+      ret = "inconsistent avail_in";
+      goto cleanup1;
+    }
+    src->meta.ri += initial_avail_in - z.avail_in;
+
+    if (initial_avail_out < z.avail_out) {
+      ret = "inconsistent avail_out";
+      goto cleanup1;
+    }
+    dst->meta.wi += initial_avail_out - z.avail_out;
+
+    if (d_err == Z_STREAM_END) {
+      break;
+    } else if ((d_err != Z_OK) && (d_err != Z_BUF_ERROR)) {
+      ret = "deflate failed";
+      goto cleanup1;
+    } else if (dst->meta.wi == dst->data.len) {
+      ret = "deflate failed (dst is full)";
+      goto cleanup1;
+    }
+  }
+
+cleanup1:;
+  int de_err = deflateEnd(&z);
+  if ((de_err != Z_OK) && !ret) {
+    ret = "deflateEnd failed";
+  }
+
+cleanup0:;
+  return ret;
+}
+
 const char*  //
 mimic_gzip_decode(wuffs_base__io_buffer* dst,
                   wuffs_base__io_buffer* src,
@@ -69,10 +69,22 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 
 // ---------------- Golden Tests
 
+golden_test adler32_harvesters_1m_gt = {
+    .src_filename = "test/data/harvesters.bmp",  //
+    .src_offset0 = 0,                            //
+    .src_offset1 = 1000000,                      //
+};
+
 golden_test adler32_midsummer_gt = {
     .src_filename = "test/data/midsummer.txt",  //
 };
 
+golden_test adler32_midsummer_1k_gt = {
+    .src_filename = "test/data/midsummer.txt",  //
+    .src_offset0 = 0,                           //
+    .src_offset1 = 1000,                        //
+};
+
 golden_test adler32_pi_gt = {
     .src_filename = "test/data/pi.txt",  //
 };
@@ -92,6 +104,53 @@ test_wuffs_adler32_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0xF1BB258D);
 }
 
+const char*  //
+test_wuffs_adler32_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+
+  wuffs_adler32__hasher h;
+  CHECK_STATUS("initialize",
+               wuffs_adler32__hasher__initialize(
+                   &h, sizeof h, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  size_t n_total = src.meta.wi;
+  uint32_t want = wuffs_adler32__hasher__update_u32(
+      &h, wuffs_base__make_slice_u8(src.data.ptr, n_total));
+
+  // 65521 and 65522 exercise B's length wrapping around the modulus.
+  size_t splits[] = {0, 1, 31, 32, 5552, 65521, 65522, n_total - 1, n_total};
+  int i;
+  for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(splits); i++) {
+    size_t n = splits[i];
+    wuffs_adler32__hasher ha;
+    CHECK_STATUS("initialize a",
+                 wuffs_adler32__hasher__initialize(
+                     &ha, sizeof ha, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_adler32__hasher hb;
+    CHECK_STATUS("initialize b",
+                 wuffs_adler32__hasher__initialize(
+                     &hb, sizeof hb, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t adler_a = wuffs_adler32__hasher__update_u32(
+        &ha, wuffs_base__make_slice_u8(src.data.ptr, n_total - n));
+    uint32_t adler_b = wuffs_adler32__hasher__update_u32(
+        &hb, wuffs_base__make_slice_u8(src.data.ptr + n_total - n, n));
+    uint32_t have =
+        wuffs_adler32__hasher__combine(&h, adler_a, adler_b, (uint64_t)n);
+    if (have != want) {
+      RETURN_FAIL("i=%d: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i, have,
+                  want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_adler32_golden() {
   CHECK_FOCUS(__func__);
@@ -139,7 +198,11 @@ test_wuffs_adler32_golden() {
     CHECK_STRING(read_file(&src, test_cases[tc].filename));
 
     int j;
-    for (j = 0; j < 2; j++) {
+    for (j = 0; j < 8; j++) {
+      set_cpu_arch_portable(j & 2);
+      if (j & 4) {
+        set_cpu_arch_x86_avoid(WUFFS_BASE__CPU_ARCH__X86__AVX2);
+      }
       wuffs_adler32__hasher checksum;
       CHECK_STATUS("initialize",
                    wuffs_adler32__hasher__initialize(
@@ -155,13 +218,14 @@ test_wuffs_adler32_golden() {
             .len = src.meta.wi - num_bytes,
         });
         size_t limit = 101 + 103 * num_fragments;
-        if ((j > 0) && (data.len > limit)) {
+        if ((j & 1) && (data.len > limit)) {
           data.len = limit;
         }
         have = wuffs_adler32__hasher__update_u32(&checksum, data);
         num_fragments++;
         num_bytes += data.len;
       } while (num_bytes < src.meta.wi);
+      set_cpu_arch_portable(false);
 
       if (have != test_cases[tc].want) {
         RETURN_FAIL("tc=%d, j=%d, filename=\"%s\": have 0x%08" PRIX32
@@ -255,6 +319,15 @@ wuffs_bench_adler32(wuffs_base__io_buffer* dst,
   return NULL;
 }
 
+const char*  //
+bench_wuffs_adler32_1k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_midsummer_1k_gt, UINT64_MAX, UINT64_MAX, 15000);
+}
+
 const char*  //
 bench_wuffs_adler32_10k() {
   CHECK_FOCUS(__func__);
@@ -273,10 +346,78 @@ bench_wuffs_adler32_100k() {
       &adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_wuffs_adler32_1m() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_harvesters_1m_gt, UINT64_MAX, UINT64_MAX, 15);
+}
+
+// The "portable" benches force the non-SIMD code paths, for comparison with
+// the benches above (on CPUs that support the SIMD code paths).
+
+const char*  //
+bench_wuffs_adler32_portable_1k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_midsummer_1k_gt, UINT64_MAX, UINT64_MAX, 15000);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_adler32_portable_10k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_adler32_portable_100k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_adler32_portable_1m() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_adler32,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &adler32_harvesters_1m_gt, UINT64_MAX, UINT64_MAX, 15);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
 
+const char*  //
+bench_mimic_adler32_1k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_bench_adler32, 0, tcounter_src,
+                             &adler32_midsummer_1k_gt, UINT64_MAX, UINT64_MAX,
+                             15000);
+}
+
 const char*  //
 bench_mimic_adler32_10k() {
   CHECK_FOCUS(__func__);
@@ -292,6 +433,14 @@ bench_mimic_adler32_100k() {
                              &adler32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+const char*  //
+bench_mimic_adler32_1m() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_bench_adler32, 0, tcounter_src,
+                             &adler32_harvesters_1m_gt, UINT64_MAX, UINT64_MAX,
+                             15);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -302,6 +451,7 @@ bench_mimic_adler32_100k() {
 // The empty comments forces clang-format to place one element per line.
 proc tests[] = {
 
+    test_wuffs_adler32_combine,    //
     test_wuffs_adler32_golden,     //
     test_wuffs_adler32_interface,  //
     test_wuffs_adler32_pi,         //
@@ -312,13 +462,21 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_adler32_10k,   //
-    bench_wuffs_adler32_100k,  //
+    bench_wuffs_adler32_1k,             //
+    bench_wuffs_adler32_10k,            //
+    bench_wuffs_adler32_100k,           //
+    bench_wuffs_adler32_1m,             //
+    bench_wuffs_adler32_portable_1k,    //
+    bench_wuffs_adler32_portable_10k,   //
+    bench_wuffs_adler32_portable_100k,  //
+    bench_wuffs_adler32_portable_1m,    //
 
 #ifdef WUFFS_MIMIC
 
+    bench_mimic_adler32_1k,    //
     bench_mimic_adler32_10k,   //
     bench_mimic_adler32_100k,  //
+    bench_mimic_adler32_1m,    //
 
 #endif  // WUFFS_MIMIC
 
@@ -92,6 +92,205 @@ test_wuffs_crc32_ieee_interface() {
       "test/data/hat.lossy.webp", 0, SIZE_MAX, 0x89F53B4E);
 }
 
+const char*  //
+test_wuffs_crc32_castagnoli_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_crc32__castagnoli_hasher h;
+  CHECK_STATUS("initialize",
+               wuffs_crc32__castagnoli_hasher__initialize(
+                   &h, sizeof h, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__hasher_u32(
+      wuffs_crc32__castagnoli_hasher__upcast_as__wuffs_base__hasher_u32(&h),
+      "test/data/hat.lossy.webp", 0, SIZE_MAX, 0x56A84923);
+}
+
+const char*  //
+test_wuffs_crc32_castagnoli_golden() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* filename;
+    // The want values are determined by script/checksum.go.
+    uint32_t want;
+  } test_cases[] = {
+      {
+          .filename = "test/data/hat.bmp",
+          .want = 0xABF7B0E6,
+      },
+      {
+          .filename = "test/data/hat.gif",
+          .want = 0x9570A28D,
+      },
+      {
+          .filename = "test/data/hat.jpeg",
+          .want = 0x5BFEBB65,
+      },
+      {
+          .filename = "test/data/hat.lossless.webp",
+          .want = 0x8EE1FA9D,
+      },
+      {
+          .filename = "test/data/hat.lossy.webp",
+          .want = 0x56A84923,
+      },
+      {
+          .filename = "test/data/hat.png",
+          .want = 0xCFB87FD9,
+      },
+      {
+          .filename = "test/data/hat.tiff",
+          .want = 0xD34CECD3,
+      },
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+
+    int j;
+    for (j = 0; j < 4; j++) {
+      set_cpu_arch_portable(j & 2);
+      wuffs_crc32__castagnoli_hasher checksum;
+      CHECK_STATUS("initialize",
+                   wuffs_crc32__castagnoli_hasher__initialize(
+                       &checksum, sizeof checksum, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+      uint32_t have = 0;
+      size_t num_fragments = 0;
+      size_t num_bytes = 0;
+      do {
+        wuffs_base__slice_u8 data = ((wuffs_base__slice_u8){
+            .ptr = src.data.ptr + num_bytes,
+            .len = src.meta.wi - num_bytes,
+        });
+        size_t limit = 101 + 103 * num_fragments;
+        if ((j & 1) && (data.len > limit)) {
+          data.len = limit;
+        }
+        have = wuffs_crc32__castagnoli_hasher__update_u32(&checksum, data);
+        num_fragments++;
+        num_bytes += data.len;
+      } while (num_bytes < src.meta.wi);
+
+      set_cpu_arch_portable(false);
+      if (have != test_cases[tc].want) {
+        RETURN_FAIL("tc=%d, j=%d, filename=\"%s\": have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    tc, j, test_cases[tc].filename, have, test_cases[tc].want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_crc32_castagnoli_pi() {
+  CHECK_FOCUS(__func__);
+
+  const char* digits =
+      "3."
+      "141592653589793238462643383279502884197169399375105820974944592307816406"
+      "2862089986280348253421170";
+  if (strlen(digits) != 99) {
+    RETURN_FAIL("strlen(digits): have %d, want 99", (int)(strlen(digits)));
+  }
+
+  // The want values are determined by script/checksum.go.
+  //
+  // wants[i] is the checksum of the first i bytes of the digits string.
+  uint32_t wants[100] = {
+      0x00000000, 0x71CEE914, 0x090DFC31, 0x52745EAD, 0xB83500D4, 0x8404DA57,
+      0xD204B41E, 0xA6D8BDD0, 0x50D05301, 0xB604AE58, 0x8C25884E, 0x9C416E07,
+      0x83392B79, 0xE1EEF4C5, 0xECB11D00, 0xB6B8CF16, 0x2C655964, 0xD7BE8830,
+      0xB3919D2E, 0xFDB84970, 0x9922AE6B, 0x5DD29708, 0xCEBB7750, 0xD24E0BB3,
+      0xE5A8323E, 0x397AD35B, 0xB95BE22F, 0x0FD9000C, 0xA50B54FF, 0xDC16B111,
+      0x614C38CA, 0x1E5A3CCF, 0x87AC81F0, 0xA486CD08, 0xE8E3C4E2, 0x8146513E,
+      0x745DF2E8, 0x81DAEF08, 0x2F5C0FDF, 0x1D1A1863, 0x68A7BBA2, 0xF54C1CE1,
+      0x815BFEE6, 0x812FE904, 0xDD3779DA, 0xC92217FE, 0x45F33369, 0x031D7AB1,
+      0x31B305A4, 0xD3B4EFB7, 0x3163AC31, 0x524C30FD, 0x2E8A7576, 0x0078376C,
+      0xC4C266AA, 0x4AC835EF, 0xDFF746EB, 0x604A354B, 0x6EC682B9, 0x6FCDE278,
+      0xE102000C, 0xE8A6402F, 0xDB429945, 0x233E45C5, 0xEC73CDB1, 0xC337E810,
+      0x61531993, 0xE307461A, 0xCD0B961A, 0x9336A6EE, 0xDF2EB878, 0xBFA1DF72,
+      0x351808DA, 0xDA9ACB7B, 0xACF498F5, 0x4596E5E6, 0x2D939B38, 0xFE287FED,
+      0xDF43A6A1, 0x32616FE3, 0x181578AE, 0x1407DED5, 0xFC1A3345, 0x9C3151BC,
+      0xBBF57140, 0xC26582DA, 0x50B4EE3E, 0xFE555898, 0x69411894, 0xF05FA7EF,
+      0x559489B6, 0x17446BBF, 0xBB7E047A, 0x6B0FEB25, 0xB02318D6, 0x76674F4C,
+      0x9CBB2CC0, 0x53E4040B, 0x2F8E3134, 0x95C84A7F,
+  };
+
+  int i;
+  for (i = 0; i < 200; i++) {
+    set_cpu_arch_portable(i >= 100);
+    wuffs_crc32__castagnoli_hasher checksum;
+    CHECK_STATUS("initialize",
+                 wuffs_crc32__castagnoli_hasher__initialize(
+                     &checksum, sizeof checksum, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t have = wuffs_crc32__castagnoli_hasher__update_u32(
+        &checksum, ((wuffs_base__slice_u8){
+                       .ptr = (uint8_t*)(digits),
+                       .len = i % 100,
+                   }));
+    set_cpu_arch_portable(false);
+    if (have != wants[i % 100]) {
+      RETURN_FAIL("i=%d: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i, have,
+                  wants[i % 100]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_crc32_ieee_combine() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, "test/data/midsummer.txt"));
+
+  wuffs_crc32__ieee_hasher h;
+  CHECK_STATUS("initialize",
+               wuffs_crc32__ieee_hasher__initialize(
+                   &h, sizeof h, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  size_t n_total = src.meta.wi;
+  uint32_t want = wuffs_crc32__ieee_hasher__update_u32(
+      &h, wuffs_base__make_slice_u8(src.data.ptr, n_total));
+
+  size_t splits[] = {0, 1, 15, 16, 17, 64, 1000, n_total - 1, n_total};
+  int i;
+  for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(splits); i++) {
+    size_t n = splits[i];
+    wuffs_crc32__ieee_hasher ha;
+    CHECK_STATUS("initialize a",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &ha, sizeof ha, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_crc32__ieee_hasher hb;
+    CHECK_STATUS("initialize b",
+                 wuffs_crc32__ieee_hasher__initialize(
+                     &hb, sizeof hb, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    uint32_t crc_a = wuffs_crc32__ieee_hasher__update_u32(
+        &ha, wuffs_base__make_slice_u8(src.data.ptr, n));
+    uint32_t crc_b = wuffs_crc32__ieee_hasher__update_u32(
+        &hb, wuffs_base__make_slice_u8(src.data.ptr + n, n_total - n));
+    uint32_t have =
+        wuffs_crc32__ieee_hasher__combine(&h, crc_a, crc_b, n_total - n);
+    if (have != want) {
+      RETURN_FAIL("i=%d: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i, have,
+                  want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_crc32_ieee_golden() {
   CHECK_FOCUS(__func__);
@@ -139,7 +338,8 @@ test_wuffs_crc32_ieee_golden() {
     CHECK_STRING(read_file(&src, test_cases[tc].filename));
 
     int j;
-    for (j = 0; j < 2; j++) {
+    for (j = 0; j < 4; j++) {
+      set_cpu_arch_portable(j & 2);
       wuffs_crc32__ieee_hasher checksum;
       CHECK_STATUS("initialize",
                    wuffs_crc32__ieee_hasher__initialize(
@@ -155,7 +355,7 @@ test_wuffs_crc32_ieee_golden() {
             .len = src.meta.wi - num_bytes,
         });
         size_t limit = 101 + 103 * num_fragments;
-        if ((j > 0) && (data.len > limit)) {
+        if ((j & 1) && (data.len > limit)) {
           data.len = limit;
         }
         have = wuffs_crc32__ieee_hasher__update_u32(&checksum, data);
@@ -163,6 +363,7 @@ test_wuffs_crc32_ieee_golden() {
         num_bytes += data.len;
       } while (num_bytes < src.meta.wi);
 
+      set_cpu_arch_portable(false);
       if (have != test_cases[tc].want) {
         RETURN_FAIL("tc=%d, j=%d, filename=\"%s\": have 0x%08" PRIX32
                     ", want 0x%08" PRIX32,
@@ -269,6 +470,29 @@ test_mimic_crc32_ieee_pi() {
 
 uint32_t global_wuffs_crc32_unused_u32;
 
+const char*  //
+wuffs_bench_crc32_castagnoli(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  uint64_t len = src->meta.wi - src->meta.ri;
+  if (rlimit) {
+    len = wuffs_base__u64__min(len, rlimit);
+  }
+  wuffs_crc32__castagnoli_hasher checksum;
+  CHECK_STATUS("initialize", wuffs_crc32__castagnoli_hasher__initialize(
+                                 &checksum, sizeof checksum, WUFFS_VERSION,
+                                 wuffs_initialize_flags));
+  global_wuffs_crc32_unused_u32 = wuffs_crc32__castagnoli_hasher__update_u32(
+      &checksum, ((wuffs_base__slice_u8){
+                     .ptr = src->data.ptr + src->meta.ri,
+                     .len = len,
+                 }));
+  src->meta.ri += len;
+  return NULL;
+}
+
 const char*  //
 wuffs_bench_crc32_ieee(wuffs_base__io_buffer* dst,
                        wuffs_base__io_buffer* src,
@@ -292,6 +516,24 @@ wuffs_bench_crc32_ieee(wuffs_base__io_buffer* dst,
   return NULL;
 }
 
+const char*  //
+bench_wuffs_crc32_castagnoli_10k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_crc32_castagnoli,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+}
+
+const char*  //
+bench_wuffs_crc32_castagnoli_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_bench_crc32_castagnoli,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+}
+
 const char*  //
 bench_wuffs_crc32_ieee_10k() {
   CHECK_FOCUS(__func__);
@@ -310,6 +552,57 @@ bench_wuffs_crc32_ieee_100k() {
       &crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
 }
 
+// The "portable" benches force the non-SIMD code paths, for comparison with
+// the benches above (on CPUs that support the SIMD code paths).
+
+const char*  //
+bench_wuffs_crc32_ieee_portable_10k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_crc32_ieee,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_crc32_ieee_portable_100k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_crc32_ieee,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_crc32_castagnoli_portable_10k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_crc32_castagnoli,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_midsummer_gt, UINT64_MAX, UINT64_MAX, 1500);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
+const char*  //
+bench_wuffs_crc32_castagnoli_portable_100k() {
+  CHECK_FOCUS(__func__);
+  set_cpu_arch_portable(true);
+  const char* status = do_bench_io_buffers(
+      wuffs_bench_crc32_castagnoli,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &crc32_pi_gt, UINT64_MAX, UINT64_MAX, 150);
+  set_cpu_arch_portable(false);
+  return status;
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -338,9 +631,13 @@ bench_mimic_crc32_ieee_100k() {
 // The empty comments forces clang-format to place one element per line.
 proc tests[] = {
 
-    test_wuffs_crc32_ieee_golden,     //
-    test_wuffs_crc32_ieee_interface,  //
-    test_wuffs_crc32_ieee_pi,         //
+    test_wuffs_crc32_castagnoli_golden,     //
+    test_wuffs_crc32_castagnoli_interface,  //
+    test_wuffs_crc32_castagnoli_pi,         //
+    test_wuffs_crc32_ieee_combine,          //
+    test_wuffs_crc32_ieee_golden,           //
+    test_wuffs_crc32_ieee_interface,        //
+    test_wuffs_crc32_ieee_pi,               //
 
 #ifdef WUFFS_MIMIC
 
@@ -354,8 +651,14 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_crc32_ieee_10k,   //
-    bench_wuffs_crc32_ieee_100k,  //
+    bench_wuffs_crc32_castagnoli_10k,            //
+    bench_wuffs_crc32_castagnoli_100k,           //
+    bench_wuffs_crc32_castagnoli_portable_10k,   //
+    bench_wuffs_crc32_castagnoli_portable_100k,  //
+    bench_wuffs_crc32_ieee_10k,                  //
+    bench_wuffs_crc32_ieee_100k,                 //
+    bench_wuffs_crc32_ieee_portable_10k,         //
+    bench_wuffs_crc32_ieee_portable_100k,        //
 
 #ifdef WUFFS_MIMIC
 
@@ -134,6 +134,13 @@ golden_test deflate_midsummer_gt = {
     .src_offset1 = 5166,                           //
 };
 
+golden_test deflate_nobel_prizes_gt = {
+    .want_filename = "test/data/nobel-prizes.json",    //
+    .src_filename = "test/data/nobel-prizes.json.gz",  //
+    .src_offset0 = 28,                                 //
+    .src_offset1 = 42367,                              //
+};
+
 golden_test deflate_pi_gt = {
     .want_filename = "test/data/pi.txt",    //
     .src_filename = "test/data/pi.txt.gz",  //
@@ -153,6 +160,18 @@ golden_test deflate_romeo_fixed_gt = {
     .src_filename = "test/data/romeo.txt.fixed-huff.deflate",  //
 };
 
+// The deflate_encode_etc_gt golden tests have no want_filename. They are only
+// used for benchmarks. The encoder tests instead check that encoding and then
+// decoding round-trips to the original src.
+
+golden_test deflate_encode_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",  //
+};
+
+golden_test deflate_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",  //
+};
+
 // ---------------- Deflate Tests
 
 const char*  //
@@ -199,6 +218,37 @@ wuffs_deflate_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+// wuffs_deflate_decode_dst_holds_history is like wuffs_deflate_decode but it
+// passes dst itself (not a limited writer starting at dst's write index) to
+// each transform_io call, so that dst keeps the history. wlimit is ignored.
+const char*  //
+wuffs_deflate_decode_dst_holds_history(wuffs_base__io_buffer* dst,
+                                       wuffs_base__io_buffer* src,
+                                       uint32_t wuffs_initialize_flags,
+                                       uint64_t wlimit,
+                                       uint64_t rlimit) {
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION, wuffs_initialize_flags));
+  wuffs_deflate__decoder__set_dst_holds_history(&dec, true);
+
+  while (true) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+        &dec, dst, &limited_src, global_work_slice);
+
+    src->meta.ri += limited_src.meta.ri;
+
+    if ((rlimit < UINT64_MAX) &&
+        (status.repr == wuffs_base__suspension__short_read)) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
 const char*  //
 test_wuffs_deflate_decode_256_bytes() {
   CHECK_FOCUS(__func__);
@@ -297,6 +347,13 @@ test_wuffs_deflate_decode_midsummer() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_deflate_decode_nobel_prizes() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_deflate_decode, &deflate_nobel_prizes_gt,
+                            UINT64_MAX, UINT64_MAX);
+}
+
 const char*  //
 test_wuffs_deflate_decode_pi_just_one_read() {
   CHECK_FOCUS(__func__);
@@ -311,6 +368,13 @@ test_wuffs_deflate_decode_pi_many_big_reads() {
                             4096);
 }
 
+const char*  //
+test_wuffs_deflate_decode_pi_dst_holds_history() {
+  CHECK_FOCUS(__func__);
+  return do_test_io_buffers(wuffs_deflate_decode_dst_holds_history,
+                            &deflate_pi_gt, UINT64_MAX, 4096);
+}
+
 const char*  //
 test_wuffs_deflate_decode_pi_many_medium_reads() {
   CHECK_FOCUS(__func__);
@@ -514,6 +578,125 @@ test_wuffs_deflate_history_full() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_deflate_history_in_dst() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  golden_test* gt = &deflate_pi_gt;
+  CHECK_STRING(read_file(&src, gt->src_filename));
+  CHECK_STRING(read_file(&want, gt->want_filename));
+
+  // i == 0 decodes into one large dst.
+  //
+  // i == 1 compacts dst (after marking it all as read) after every short
+  // read, breaking the set_dst_holds_history promise.
+  //
+  // i == 2 decodes into a smaller dst, compacting it after every short write
+  // (but not after short reads), which is allowed.
+  //
+  // i == 3 is like i == 2 but uses set_dst_holds_window, and so keeps the
+  // last 32 KiB of dst when making room after every short write.
+  int i;
+  for (i = 0; i < 4; i++) {
+    wuffs_deflate__decoder dec;
+    memset(&(dec.private_data.f_history), 0,
+           sizeof(dec.private_data.f_history));
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    if (i < 3) {
+      wuffs_deflate__decoder__set_dst_holds_history(&dec, true);
+    } else {
+      wuffs_deflate__decoder__set_dst_holds_window(&dec, true);
+    }
+
+    src.meta.ri = gt->src_offset0;
+    src.meta.wi = gt->src_offset1;
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    if (i >= 2) {
+      have.data.len = 40000;
+    }
+    // have's first n_kept bytes have already been checked against want's
+    // first n_checked bytes.
+    size_t n_kept = 0;
+    size_t n_checked = 0;
+
+    wuffs_base__status status;
+    while (true) {
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, 1000);
+      status = wuffs_deflate__decoder__transform_io(&dec, &have, &limited_src,
+                                                    global_work_slice);
+      src.meta.ri += limited_src.meta.ri;
+      if (status.repr == wuffs_base__suspension__short_read) {
+        if (i != 1) {
+          continue;
+        }
+      } else if (status.repr != wuffs_base__suspension__short_write) {
+        break;
+      }
+
+      size_t n = have.meta.wi - n_kept;
+      if ((n_checked + n) > want.meta.wi) {
+        RETURN_FAIL("i=%d: too much output", i);
+      } else if (memcmp(have.data.ptr + n_kept, want.data.ptr + n_checked, n) !=
+                 0) {
+        RETURN_FAIL("i=%d: output differs near offset %zu", i, n_checked);
+      }
+      n_checked += n;
+
+      if (i < 3) {
+        have.meta.ri = have.meta.wi;
+        wuffs_base__io_buffer__compact(&have);
+      } else if (have.meta.wi > 32768) {
+        memmove(have.data.ptr, have.data.ptr + have.meta.wi - 32768, 32768);
+        have.meta.wi = 32768;
+      }
+      n_kept = have.meta.wi;
+    }
+
+    if (i == 1) {
+      if (status.repr != wuffs_deflate__error__missing_history) {
+        RETURN_FAIL("i=%d: have \"%s\", want \"%s\"", i, status.repr,
+                    wuffs_deflate__error__missing_history);
+      }
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    size_t n = have.meta.wi - n_kept;
+    if (((n_checked + n) != want.meta.wi) ||
+        (memcmp(have.data.ptr + n_kept, want.data.ptr + n_checked, n) != 0)) {
+      RETURN_FAIL("i=%d: output differs near offset %zu", i, n_checked);
+    }
+
+    // Other than after i == 2's short writes, the history array should not
+    // have been touched.
+    if (i != 2) {
+      if (dec.private_impl.f_history_index != 0) {
+        RETURN_FAIL("i=%d: history_index: have 0x%04" PRIX32 ", want 0", i,
+                    dec.private_impl.f_history_index);
+      }
+      size_t j;
+      for (j = 0; j < sizeof(dec.private_data.f_history); j++) {
+        if (dec.private_data.f_history[j] != 0) {
+          RETURN_FAIL("i=%d: history[%zu]: have 0x%02" PRIX8 ", want 0", i, j,
+                      dec.private_data.f_history[j]);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_history_partial() {
   CHECK_FOCUS(__func__);
@@ -581,6 +764,378 @@ test_wuffs_deflate_history_partial() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_deflate_resume_at_checkpoint() {
+  CHECK_FOCUS(__func__);
+
+  golden_test* gts[] = {
+      &deflate_deflate_backref_crosses_blocks_gt,
+      &deflate_nobel_prizes_gt,
+  };
+
+  struct {
+    size_t src_ri;
+    size_t dst_wi;
+    uint32_t held_bits;
+    uint32_t n_held_bits;
+  } checkpoints[64];
+  uint8_t window[32768];
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(gts); tc++) {
+    golden_test* gt = gts[tc];
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+        .data = global_want_slice,
+    });
+    CHECK_STRING(read_file(&src, gt->src_filename));
+    CHECK_STRING(read_file(&want, gt->want_filename));
+    size_t src_offset1 = gt->src_offset1 ? gt->src_offset1 : src.meta.wi;
+
+    // Decode once, recording a checkpoint at every block boundary.
+    size_t n_checkpoints = 0;
+    {
+      wuffs_deflate__decoder dec;
+      CHECK_STATUS("initialize",
+                   wuffs_deflate__decoder__initialize(
+                       &dec, sizeof dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      wuffs_deflate__decoder__set_report_block_boundaries(&dec, true);
+
+      src.meta.ri = gt->src_offset0;
+      src.meta.wi = src_offset1;
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = global_have_slice,
+      });
+
+      while (true) {
+        wuffs_base__status status = wuffs_deflate__decoder__transform_io(
+            &dec, &have, &src, global_work_slice);
+        if (status.repr != wuffs_deflate__suspension__block_boundary) {
+          CHECK_STATUS("transform_io", status);
+          break;
+        }
+        if (n_checkpoints >= WUFFS_TESTLIB_ARRAY_SIZE(checkpoints)) {
+          RETURN_FAIL("tc=%d: too many checkpoints", tc);
+        }
+        uint32_t n_held_bits = wuffs_deflate__decoder__n_held_bits(&dec);
+        if (n_held_bits >= 8) {
+          RETURN_FAIL("tc=%d: n_held_bits: have %" PRIu32 ", want < 8", tc,
+                      n_held_bits);
+        }
+        checkpoints[n_checkpoints].src_ri = src.meta.ri;
+        checkpoints[n_checkpoints].dst_wi = have.meta.wi;
+        checkpoints[n_checkpoints].held_bits =
+            wuffs_deflate__decoder__held_bits(&dec);
+        checkpoints[n_checkpoints].n_held_bits = n_held_bits;
+        n_checkpoints++;
+
+        size_t w = (have.meta.wi < 32768) ? have.meta.wi : 32768;
+        uint64_t n = wuffs_deflate__decoder__copy_history(
+            &dec, wuffs_base__make_slice_u8(window, sizeof window));
+        if ((n != w) ||
+            (memcmp(window, want.data.ptr + have.meta.wi - w, w) != 0)) {
+          RETURN_FAIL("tc=%d: copy_history differs at dst offset %zu", tc,
+                      have.meta.wi);
+        }
+      }
+      CHECK_STRING(check_io_buffers_equal("", &have, &want));
+    }
+
+    if (n_checkpoints == 0) {
+      RETURN_FAIL("tc=%d: no checkpoints", tc);
+    }
+
+    // Resume decoding from each checkpoint, with a fresh decoder.
+    size_t i;
+    for (i = 0; i < n_checkpoints; i++) {
+      wuffs_deflate__decoder dec;
+      CHECK_STATUS("initialize",
+                   wuffs_deflate__decoder__initialize(
+                       &dec, sizeof dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      size_t dst_wi = checkpoints[i].dst_wi;
+      size_t w = (dst_wi < 32768) ? dst_wi : 32768;
+      wuffs_deflate__decoder__resume_at_checkpoint(
+          &dec, checkpoints[i].held_bits, checkpoints[i].n_held_bits,
+          wuffs_base__make_slice_u8(want.data.ptr + dst_wi - w, w));
+
+      src.meta.ri = checkpoints[i].src_ri;
+      src.meta.wi = src_offset1;
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = global_have_slice,
+      });
+      CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                       &dec, &have, &src, global_work_slice));
+      if ((have.meta.wi != (want.meta.wi - dst_wi)) ||
+          (memcmp(have.data.ptr, want.data.ptr + dst_wi, have.meta.wi) != 0)) {
+        RETURN_FAIL("tc=%d, i=%zu: output differs", tc, i);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_stats() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    golden_test* gt;
+    uint64_t want_stored_blocks;
+    uint64_t want_fixed_blocks;
+    uint64_t want_dynamic_blocks;
+  } tcs[] = {
+      {&deflate_deflate_backref_crosses_blocks_gt, 1, 1, 0},
+      {&deflate_romeo_fixed_gt, 1, 1, 0},
+      {&deflate_pi_gt, 0, 0, 1},
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    golden_test* gt = tcs[tc].gt;
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = global_src_slice,
+    });
+    wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+        .data = global_want_slice,
+    });
+    CHECK_STRING(read_file(&src, gt->src_filename));
+    CHECK_STRING(read_file(&want, gt->want_filename));
+    size_t src_offset1 = gt->src_offset1 ? gt->src_offset1 : src.meta.wi;
+
+    // Small writes exercise decode_huffman_slow and suspending mid-block.
+    int w;
+    for (w = 0; w < 2; w++) {
+      uint64_t wlimit = w ? 37 : UINT64_MAX;
+      wuffs_deflate__stats_decoder dec;
+      CHECK_STATUS("initialize",
+                   wuffs_deflate__stats_decoder__initialize(
+                       &dec, sizeof dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+      src.meta.ri = gt->src_offset0;
+      src.meta.wi = src_offset1;
+      wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+          .data = global_have_slice,
+      });
+      while (true) {
+        wuffs_base__io_buffer limited_dst = make_limited_writer(have, wlimit);
+        wuffs_base__status status = wuffs_deflate__stats_decoder__transform_io(
+            &dec, &limited_dst, &src, global_work_slice);
+        have.meta.wi += limited_dst.meta.wi;
+        if ((wlimit < UINT64_MAX) &&
+            (status.repr == wuffs_base__suspension__short_write)) {
+          continue;
+        }
+        CHECK_STATUS("transform_io", status);
+        break;
+      }
+      CHECK_STRING(check_io_buffers_equal("", &have, &want));
+
+      uint64_t stats[WUFFS_DEFLATE__STATS_SLOW_ITERATIONS + 1];
+      uint32_t k;
+      for (k = 0; k <= WUFFS_DEFLATE__STATS_SLOW_ITERATIONS; k++) {
+        stats[k] = wuffs_deflate__stats_decoder__stat(&dec, k);
+      }
+
+      if ((stats[WUFFS_DEFLATE__STATS_STORED_BLOCKS] !=
+           tcs[tc].want_stored_blocks) ||
+          (stats[WUFFS_DEFLATE__STATS_FIXED_BLOCKS] !=
+           tcs[tc].want_fixed_blocks) ||
+          (stats[WUFFS_DEFLATE__STATS_DYNAMIC_BLOCKS] !=
+           tcs[tc].want_dynamic_blocks)) {
+        RETURN_FAIL("tc=%d, w=%d: blocks: have (%" PRIu64 ", %" PRIu64
+                    ", %" PRIu64 ")",
+                    tc, w, stats[WUFFS_DEFLATE__STATS_STORED_BLOCKS],
+                    stats[WUFFS_DEFLATE__STATS_FIXED_BLOCKS],
+                    stats[WUFFS_DEFLATE__STATS_DYNAMIC_BLOCKS]);
+      }
+
+      uint64_t n_bytes = stats[WUFFS_DEFLATE__STATS_STORED_BYTES] +
+                         stats[WUFFS_DEFLATE__STATS_FIXED_BYTES] +
+                         stats[WUFFS_DEFLATE__STATS_DYNAMIC_BYTES];
+      uint64_t n_huffman_bytes = stats[WUFFS_DEFLATE__STATS_LITERALS] +
+                                 stats[WUFFS_DEFLATE__STATS_MATCH_BYTES];
+      if ((n_bytes != want.meta.wi) ||
+          (n_huffman_bytes !=
+           (n_bytes - stats[WUFFS_DEFLATE__STATS_STORED_BYTES]))) {
+        RETURN_FAIL("tc=%d, w=%d: bytes: have %" PRIu64 " and %" PRIu64
+                    ", want %zu",
+                    tc, w, n_bytes, n_huffman_bytes, want.meta.wi);
+      }
+
+      uint64_t n_lengths = 0;
+      uint64_t n_length_bytes = 0;
+      for (k = 0; k <= 258; k++) {
+        uint64_t c = wuffs_deflate__stats_decoder__match_length_count(&dec, k);
+        if ((k < 3) && (c != 0)) {
+          RETURN_FAIL("tc=%d, w=%d: match_length_count(%" PRIu32
+                      "): have %" PRIu64 ", want 0",
+                      tc, w, k, c);
+        }
+        n_lengths += c;
+        n_length_bytes += c * k;
+      }
+      uint64_t n_distances = 0;
+      for (k = 0; k <= 13; k++) {
+        n_distances +=
+            wuffs_deflate__stats_decoder__match_distance_count(&dec, k);
+      }
+      if ((n_lengths != stats[WUFFS_DEFLATE__STATS_MATCHES]) ||
+          (n_distances != stats[WUFFS_DEFLATE__STATS_MATCHES]) ||
+          (n_length_bytes != stats[WUFFS_DEFLATE__STATS_MATCH_BYTES])) {
+        RETURN_FAIL("tc=%d, w=%d: histograms are inconsistent", tc, w);
+      }
+
+      uint64_t want_builds = 3 * stats[WUFFS_DEFLATE__STATS_DYNAMIC_BLOCKS];
+      if (stats[WUFFS_DEFLATE__STATS_HUFFMAN_TABLE_BUILDS] != want_builds) {
+        RETURN_FAIL("tc=%d, w=%d: huffman_table_builds: have %" PRIu64
+                    ", want %" PRIu64,
+                    tc, w, stats[WUFFS_DEFLATE__STATS_HUFFMAN_TABLE_BUILDS],
+                    want_builds);
+      }
+
+      // Each iteration decodes one literal, a pair of literals, one match or
+      // one end-of-block code.
+      uint64_t n_iterations = stats[WUFFS_DEFLATE__STATS_FAST_ITERATIONS] +
+                              stats[WUFFS_DEFLATE__STATS_SLOW_ITERATIONS];
+      uint64_t n_codes = stats[WUFFS_DEFLATE__STATS_LITERALS] +
+                         stats[WUFFS_DEFLATE__STATS_MATCHES] +
+                         stats[WUFFS_DEFLATE__STATS_FIXED_BLOCKS] +
+                         stats[WUFFS_DEFLATE__STATS_DYNAMIC_BLOCKS];
+      if ((n_iterations > n_codes) || ((2 * n_iterations) < n_codes)) {
+        RETURN_FAIL("tc=%d, w=%d: iterations: have %" PRIu64
+                    ", codes: %" PRIu64,
+                    tc, w, n_iterations, n_codes);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_table_fixed() {
+  CHECK_FOCUS(__func__);
+
+  // init_fixed_huffman copies precomputed tables. Check that they match what
+  // init_huff builds from the RFC section 3.2.6 code lengths.
+
+  wuffs_deflate__decoder have;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &have, sizeof have, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("init_fixed_huffman",
+               wuffs_deflate__decoder__init_fixed_huffman(&have));
+
+  wuffs_deflate__decoder want;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &want, sizeof want, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  int i = 0;
+  for (; i < 144; i++) {
+    want.private_data.f_code_lengths[i] = 8;
+  }
+  for (; i < 256; i++) {
+    want.private_data.f_code_lengths[i] = 9;
+  }
+  for (; i < 280; i++) {
+    want.private_data.f_code_lengths[i] = 7;
+  }
+  for (; i < 288; i++) {
+    want.private_data.f_code_lengths[i] = 8;
+  }
+  for (; i < 320; i++) {
+    want.private_data.f_code_lengths[i] = 5;
+  }
+  CHECK_STATUS("init_huff",
+               wuffs_deflate__decoder__init_huff(&want, 0, 0, 288, 257));
+  CHECK_STATUS("init_huff",
+               wuffs_deflate__decoder__init_huff(&want, 1, 288, 320, 0));
+
+  int which;
+  for (which = 0; which < 2; which++) {
+    uint32_t n_huffs_bits = want.private_impl.f_n_huffs_bits[which];
+    if (have.private_impl.f_n_huffs_bits[which] != n_huffs_bits) {
+      RETURN_FAIL("n_huffs_bits[%d]: have %" PRIu32 ", want %" PRIu32, which,
+                  have.private_impl.f_n_huffs_bits[which], n_huffs_bits);
+    }
+    for (i = 0; i < (1 << n_huffs_bits); i++) {
+      uint32_t h = have.private_data.f_huffs[which][i];
+      uint32_t w = want.private_data.f_huffs[which][i];
+      if (h != w) {
+        RETURN_FAIL("huffs[%d][%d]: have 0x%08" PRIX32 ", want 0x%08" PRIX32,
+                    which, i, h, w);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_deflate_table_literal_pairs() {
+  CHECK_FOCUS(__func__);
+
+  // Call init_huff with a Huffman code that looks like:
+  //
+  //  code_bits  cl  symbol
+  //  0b_____0    1  0x61 'a'
+  //  0b____10    2  0x62 'b'
+  //  0b___110    3  0x100 end-of-block
+  //  0b___111    3  0x101 length code
+  //
+  // The 1st-level table uses 3 bits. Its keys hold the code bits in Least
+  // Significant Bits order, so that 'b' is the key 0b.01. Where two literal
+  // codes fit in 3 bits, the table entry should hold both literals.
+
+  wuffs_deflate__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  memset(&(dec.private_data.f_huffs), 0, sizeof(dec.private_data.f_huffs));
+  memset(&(dec.private_data.f_code_lengths), 0,
+         sizeof(dec.private_data.f_code_lengths));
+
+  dec.private_data.f_code_lengths[0x61] = 1;
+  dec.private_data.f_code_lengths[0x62] = 2;
+  dec.private_data.f_code_lengths[0x100] = 3;
+  dec.private_data.f_code_lengths[0x101] = 3;
+
+  CHECK_STATUS("init_huff",
+               wuffs_deflate__decoder__init_huff(&dec, 0, 0, 0x102, 257));
+
+  if (dec.private_impl.f_n_huffs_bits[0] != 3) {
+    RETURN_FAIL("n_huffs_bits[0]: have %" PRIu32 ", want 3",
+                dec.private_impl.f_n_huffs_bits[0]);
+  }
+
+  const uint32_t wants[8] = {
+      0x80616111,  // 0b000: 'a' (1 bit) then 'a' (1 bit).
+      0x80616212,  // 0b001: 'b' (2 bits) then 'a' (1 bit).
+      0x80626121,  // 0b010: 'a' (1 bit) then 'b' (2 bits).
+      0x20000003,  // 0b011: end-of-block.
+      0x80616111,  // 0b100: 'a' (1 bit) then 'a' (1 bit).
+      0x80006202,  // 0b101: 'b' (2 bits) only.
+      0x80006101,  // 0b110: 'a' (1 bit) only.
+      0x40000003,  // 0b111: length code.
+  };
+  int i;
+  for (i = 0; i < 8; i++) {
+    uint32_t have = dec.private_data.f_huffs[0][i];
+    uint32_t want = wants[i];
+    if (have != want) {
+      RETURN_FAIL("huffs[0][%d]: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i,
+                  have, want);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_deflate_table_redirect() {
   CHECK_FOCUS(__func__);
@@ -710,6 +1265,187 @@ test_wuffs_deflate_table_redirect() {
   return NULL;
 }
 
+// ---------------- Deflate Encoder Tests
+
+// global_deflate_encode_n_src and global_deflate_encode_n_dst hold the number
+// of bytes read and written by the most recent encode call, so that the
+// benchmarks can report a compression ratio.
+uint64_t global_deflate_encode_n_src;
+uint64_t global_deflate_encode_n_dst;
+
+const char*  //
+test_wuffs_deflate_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_deflate__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/romeo.txt", 0, SIZE_MAX, 530, 0x00);
+}
+
+const char*  //
+wuffs_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     uint32_t level) {
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  wuffs_deflate__encoder__set_level(&enc, level);
+
+  size_t dst_wi0 = dst->meta.wi;
+  size_t src_ri0 = src->meta.ri;
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    global_deflate_encode_n_src = src->meta.ri - src_ri0;
+    global_deflate_encode_n_dst = dst->meta.wi - dst_wi0;
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              1);
+}
+
+const char*  //
+wuffs_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              6);
+}
+
+const char*  //
+wuffs_deflate_encode_level_9(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return wuffs_deflate_encode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              9);
+}
+
+const char*  //
+do_test_wuffs_deflate_encode_round_trip(const char* src_filename,
+                                        uint32_t level,
+                                        uint64_t wlimit,
+                                        uint64_t rlimit) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  CHECK_STRING(read_file(&src, src_filename));
+  CHECK_STRING(wuffs_deflate_encode(
+      &have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS, wlimit, rlimit, level));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  if ((level > 0) && (have.meta.wi >= src.meta.wi)) {
+    RETURN_FAIL("dst wi: have %zu, want < %zu", have.meta.wi, src.meta.wi);
+  }
+
+  CHECK_STRING(wuffs_deflate_decode(
+      &want, &have, WUFFS_INITIALIZE__DEFAULT_OPTIONS, UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_level_0() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip("test/data/pi.txt", 0, 4096,
+                                                 UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip("test/data/midsummer.txt", 1,
+                                                 UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip("test/data/harvesters.bmp", 6,
+                                                 1000, 1000);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip("test/data/pi.txt", 9, 77,
+                                                 UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_short_distances() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  // Runs of period 1, 2, ..., 20 exercise the decoder's back-reference copies
+  // for every distance below 16: memset, pattern expansion and 8 byte chunks.
+  uint32_t period;
+  for (period = 1; period <= 20; period++) {
+    uint32_t i;
+    for (i = 0; i < 300 + period; i++) {
+      src.data.ptr[src.meta.wi++] =
+          (uint8_t)('a' + ((period + (i % period)) % 26));
+    }
+  }
+  src.meta.closed = true;
+
+  CHECK_STRING(wuffs_deflate_encode(&have, &src,
+                                    WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                    UINT64_MAX, UINT64_MAX, 6));
+  CHECK_STRING(wuffs_deflate_decode(
+      &want, &have, WUFFS_INITIALIZE__DEFAULT_OPTIONS, UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -802,6 +1538,28 @@ test_mimic_deflate_decode_romeo_fixed() {
                             UINT64_MAX, UINT64_MAX);
 }
 
+const char*  //
+test_mimic_deflate_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  CHECK_STRING(read_file(&src, "test/data/midsummer.txt"));
+  CHECK_STRING(wuffs_deflate_encode(&have, &src,
+                                    WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                    UINT64_MAX, UINT64_MAX, 6));
+  CHECK_STRING(mimic_deflate_decode(&want, &have, 0, UINT64_MAX, UINT64_MAX));
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Deflate Benches
@@ -823,6 +1581,83 @@ bench_wuffs_deflate_decode_1k_part_init() {
       &deflate_romeo_gt, UINT64_MAX, UINT64_MAX, 2000);
 }
 
+// bench_wuffs_deflate_decode_1k_10000_streams decodes independent streams,
+// each with a freshly initialized decoder. With the default -iterscale=100,
+// it decodes 10000 streams. Each stream decodes to (at most) 1 KiB, so setup,
+// such as building the Huffman tables, matters more than for the other
+// benchmarks.
+//
+// The streams are compressed at run time, by deflate.encoder, from
+// consecutive 1 KiB chunks of some text and JSON test data files. This gives
+// a mix of fixed and dynamic Huffman blocks.
+const char*  //
+bench_wuffs_deflate_decode_1k_10000_streams() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/midsummer.txt",
+      "test/data/pi.txt",
+      "test/data/file-sizes.json",
+      "test/data/nobel-prizes.json",
+  };
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  int f;
+  for (f = 0; f < WUFFS_TESTLIB_ARRAY_SIZE(filenames); f++) {
+    src.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[f]));
+  }
+
+  // Compress each 1 KiB chunk of src, back to back, into the streams buffer.
+  wuffs_base__io_buffer streams = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  size_t offsets[512];
+  size_t n_streams = 0;
+  offsets[0] = 0;
+  while ((src.meta.ri < src.meta.wi) &&
+         (n_streams < (WUFFS_TESTLIB_ARRAY_SIZE(offsets) - 1))) {
+    wuffs_base__io_buffer chunk = make_limited_reader(src, 1024);
+    chunk.meta.closed = true;
+    CHECK_STRING(wuffs_deflate_encode(&streams, &chunk,
+                                      WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                      UINT64_MAX, UINT64_MAX, 6));
+    src.meta.ri += chunk.meta.ri;
+    offsets[++n_streams] = streams.meta.wi;
+  }
+
+  uint64_t n_bytes = 0;
+  uint64_t iters = 100 * flags.iterscale;
+  bench_start();
+  uint64_t i;
+  for (i = 0; i < iters; i++) {
+    size_t j = (size_t)(i % n_streams);
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = global_have_slice,
+    });
+    wuffs_base__io_buffer stream = ((wuffs_base__io_buffer){
+        .data = global_want_slice,
+        .meta = ((wuffs_base__io_buffer_meta){
+            .wi = offsets[j + 1],
+            .ri = offsets[j],
+            .closed = true,
+        }),
+    });
+
+    wuffs_deflate__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_deflate__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("transform_io", wuffs_deflate__decoder__transform_io(
+                                     &dec, &have, &stream, global_work_slice));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
 const char*  //
 bench_wuffs_deflate_decode_10k_full_init() {
   CHECK_FOCUS(__func__);
@@ -858,6 +1693,89 @@ bench_wuffs_deflate_decode_100k_many_big_reads() {
       &deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_wuffs_deflate_decode_100k_dst_holds_history() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode_dst_holds_history,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_pi_gt, UINT64_MAX, 4096, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_decode_200k_json() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &deflate_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 15);
+}
+
+const char*  //
+do_bench_deflate_encode(const char* (*codec_func)(wuffs_base__io_buffer*,
+                                                  wuffs_base__io_buffer*,
+                                                  uint32_t,
+                                                  uint64_t,
+                                                  uint64_t),
+                        golden_test* gt,
+                        uint64_t iters_unscaled) {
+  global_deflate_encode_n_src = 0;
+  global_deflate_encode_n_dst = 0;
+  CHECK_STRING(do_bench_io_buffers(
+      codec_func, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, gt, UINT64_MAX, UINT64_MAX, iters_unscaled));
+  if (!bench_warm_up && (global_deflate_encode_n_dst > 0)) {
+    uint64_t permille =
+        (global_deflate_encode_n_src * 1000) / global_deflate_encode_n_dst;
+    printf("# %s compression ratio: %d.%03d (%" PRIu64 " / %" PRIu64 ")\n",
+           proc_func_name, (int)(permille / 1000), (int)(permille % 1000),
+           global_deflate_encode_n_src, global_deflate_encode_n_dst);
+  }
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_deflate_encode_10k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_1,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_10k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_6,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_10k_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_9,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_1,
+                                 &deflate_encode_pi_gt, 10);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_6,
+                                 &deflate_encode_pi_gt, 10);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(wuffs_deflate_encode_level_9,
+                                 &deflate_encode_pi_gt, 10);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -891,6 +1809,92 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
                              &deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_mimic_deflate_decode_200k_json() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_decode, 0, tcounter_dst,
+                             &deflate_nobel_prizes_gt, UINT64_MAX, UINT64_MAX,
+                             15);
+}
+
+const char*  //
+mimic_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  const char* ret = mimic_deflate_encode(dst, src, wlimit, rlimit, 1);
+  global_deflate_encode_n_src = src->meta.ri;
+  global_deflate_encode_n_dst = dst->meta.wi;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  const char* ret = mimic_deflate_encode(dst, src, wlimit, rlimit, 6);
+  global_deflate_encode_n_src = src->meta.ri;
+  global_deflate_encode_n_dst = dst->meta.wi;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode_level_9(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  const char* ret = mimic_deflate_encode(dst, src, wlimit, rlimit, 9);
+  global_deflate_encode_n_src = src->meta.ri;
+  global_deflate_encode_n_dst = dst->meta.wi;
+  return ret;
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_1,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_6,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_9,
+                                 &deflate_encode_midsummer_gt, 100);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_level_1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_1,
+                                 &deflate_encode_pi_gt, 10);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_level_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_6,
+                                 &deflate_encode_pi_gt, 10);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_level_9() {
+  CHECK_FOCUS(__func__);
+  return do_bench_deflate_encode(mimic_deflate_encode_level_9,
+                                 &deflate_encode_pi_gt, 10);
+}
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -906,15 +1910,28 @@ proc tests[] = {
     test_wuffs_deflate_decode_deflate_huffman_primlen_9,          //
     test_wuffs_deflate_decode_interface,                          //
     test_wuffs_deflate_decode_midsummer,                          //
+    test_wuffs_deflate_decode_nobel_prizes,                       //
     test_wuffs_deflate_decode_pi_just_one_read,                   //
     test_wuffs_deflate_decode_pi_many_big_reads,                  //
+    test_wuffs_deflate_decode_pi_dst_holds_history,               //
     test_wuffs_deflate_decode_pi_many_medium_reads,               //
     test_wuffs_deflate_decode_pi_many_small_writes_reads,         //
     test_wuffs_deflate_decode_romeo,                              //
     test_wuffs_deflate_decode_romeo_fixed,                        //
     test_wuffs_deflate_decode_split_src,                          //
+    test_wuffs_deflate_encode_interface,                          //
+    test_wuffs_deflate_encode_round_trip_level_0,                 //
+    test_wuffs_deflate_encode_round_trip_level_1,                 //
+    test_wuffs_deflate_encode_round_trip_level_6,                 //
+    test_wuffs_deflate_encode_round_trip_level_9,                 //
+    test_wuffs_deflate_encode_round_trip_short_distances,         //
     test_wuffs_deflate_history_full,                              //
+    test_wuffs_deflate_history_in_dst,                            //
     test_wuffs_deflate_history_partial,                           //
+    test_wuffs_deflate_resume_at_checkpoint,                      //
+    test_wuffs_deflate_stats,                                     //
+    test_wuffs_deflate_table_fixed,                               //
+    test_wuffs_deflate_table_literal_pairs,                       //
     test_wuffs_deflate_table_redirect,                            //
 
 #ifdef WUFFS_MIMIC
@@ -930,6 +1947,7 @@ proc tests[] = {
     test_mimic_deflate_decode_pi_many_big_reads,                  //
     test_mimic_deflate_decode_romeo,                              //
     test_mimic_deflate_decode_romeo_fixed,                        //
+    test_mimic_deflate_encode_round_trip,                         //
 
 #endif  // WUFFS_MIMIC
 
@@ -939,12 +1957,21 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_deflate_decode_1k_full_init,         //
-    bench_wuffs_deflate_decode_1k_part_init,         //
-    bench_wuffs_deflate_decode_10k_full_init,        //
-    bench_wuffs_deflate_decode_10k_part_init,        //
-    bench_wuffs_deflate_decode_100k_just_one_read,   //
-    bench_wuffs_deflate_decode_100k_many_big_reads,  //
+    bench_wuffs_deflate_decode_1k_full_init,            //
+    bench_wuffs_deflate_decode_1k_part_init,            //
+    bench_wuffs_deflate_decode_1k_10000_streams,        //
+    bench_wuffs_deflate_decode_10k_full_init,           //
+    bench_wuffs_deflate_decode_10k_part_init,           //
+    bench_wuffs_deflate_decode_100k_just_one_read,      //
+    bench_wuffs_deflate_decode_100k_many_big_reads,     //
+    bench_wuffs_deflate_decode_100k_dst_holds_history,  //
+    bench_wuffs_deflate_decode_200k_json,               //
+    bench_wuffs_deflate_encode_10k_level_1,             //
+    bench_wuffs_deflate_encode_10k_level_6,             //
+    bench_wuffs_deflate_encode_10k_level_9,             //
+    bench_wuffs_deflate_encode_100k_level_1,            //
+    bench_wuffs_deflate_encode_100k_level_6,            //
+    bench_wuffs_deflate_encode_100k_level_9,            //
 
 #ifdef WUFFS_MIMIC
 
@@ -952,6 +1979,13 @@ proc benches[] = {
     bench_mimic_deflate_decode_10k,                  //
     bench_mimic_deflate_decode_100k_just_one_read,   //
     bench_mimic_deflate_decode_100k_many_big_reads,  //
+    bench_mimic_deflate_decode_200k_json,            //
+    bench_mimic_deflate_encode_10k_level_1,          //
+    bench_mimic_deflate_encode_10k_level_6,          //
+    bench_mimic_deflate_encode_10k_level_9,          //
+    bench_mimic_deflate_encode_100k_level_1,         //
+    bench_mimic_deflate_encode_100k_level_6,         //
+    bench_mimic_deflate_encode_100k_level_9,         //
 
 #endif  // WUFFS_MIMIC
 
@@ -1995,6 +1995,729 @@ test_wuffs_gif_sizeof() {
   return NULL;
 }
 
+// ---------------- GIF Encoder Tests
+
+typedef struct {
+  wuffs_base__rect_ie_u32 bounds;
+  wuffs_base__flicks duration;
+  wuffs_base__animation_disposal disposal;
+  wuffs_base__slice_u8 indexes;
+} gif_encoder_frame;
+
+const char*  //
+wuffs_gif_encode(wuffs_base__io_buffer* dst,
+                 uint64_t wlimit,
+                 uint64_t rlimit,
+                 wuffs_base__slice_u8 palette,
+                 uint32_t width,
+                 uint32_t height,
+                 uint32_t num_animation_loops,
+                 gif_encoder_frame* frames,
+                 size_t num_frames) {
+  wuffs_gif__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gif__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gif__encoder__set_palette(&enc, palette);
+  wuffs_gif__encoder__set_num_animation_loops(&enc, num_animation_loops);
+
+  // Step 0 writes the header, steps 1 ..= num_frames write the frames and
+  // the final step writes the trailer.
+  size_t step;
+  for (step = 0; step <= (num_frames + 1); step++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){});
+    if ((0 < step) && (step <= num_frames)) {
+      gif_encoder_frame* f = &frames[step - 1];
+      wuffs_gif__encoder__set_frame(
+          &enc, f->bounds.min_incl_x, f->bounds.min_incl_y,
+          f->bounds.max_excl_x, f->bounds.max_excl_y, f->duration, f->disposal);
+      src.data = f->indexes;
+      src.meta.wi = f->indexes.len;
+      src.meta.closed = true;
+    }
+
+    while (true) {
+      wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+      wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+
+      wuffs_base__status status;
+      if (step == 0) {
+        status = wuffs_gif__encoder__encode_header(&enc, &limited_dst, width,
+                                                   height);
+      } else if (step <= num_frames) {
+        status =
+            wuffs_gif__encoder__encode_frame(&enc, &limited_dst, &limited_src);
+      } else {
+        status = wuffs_gif__encoder__encode_trailer(&enc, &limited_dst);
+      }
+
+      dst->meta.wi += limited_dst.meta.wi;
+      src.meta.ri += limited_src.meta.ri;
+
+      if (((wlimit < UINT64_MAX) &&
+           (status.repr == wuffs_base__suspension__short_write)) ||
+          ((rlimit < UINT64_MAX) &&
+           (status.repr == wuffs_base__suspension__short_read))) {
+        continue;
+      }
+      CHECK_STATUS("encode", status);
+      break;
+    }
+  }
+  return NULL;
+}
+
+// do_test_wuffs_gif_encode_round_trip encodes a GIF and then decodes it,
+// checking that the decoder sees the same palette, frame configs and pixel
+// indexes.
+const char*  //
+do_test_wuffs_gif_encode_round_trip(wuffs_base__slice_u8 palette,
+                                    uint32_t width,
+                                    uint32_t height,
+                                    uint32_t num_animation_loops,
+                                    gif_encoder_frame* frames,
+                                    size_t num_frames,
+                                    uint64_t wlimit,
+                                    uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  CHECK_STRING(wuffs_gif_encode(&have, wlimit, rlimit, palette, width, height,
+                                num_animation_loops, frames, num_frames));
+  have.meta.closed = true;
+
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, &ic, &have));
+  if ((wuffs_base__pixel_config__width(&ic.pixcfg) != width) ||
+      (wuffs_base__pixel_config__height(&ic.pixcfg) != height)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "x%" PRIu32 ", want %" PRIu32
+                "x%" PRIu32,
+                wuffs_base__pixel_config__width(&ic.pixcfg),
+                wuffs_base__pixel_config__height(&ic.pixcfg), width, height);
+  }
+  uint32_t have_num_loops = wuffs_gif__decoder__num_animation_loops(&dec);
+  if (have_num_loops != num_animation_loops) {
+    RETURN_FAIL("num_animation_loops: have %" PRIu32 ", want %" PRIu32,
+                have_num_loops, num_animation_loops);
+  }
+
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, global_pixel_slice));
+  wuffs_base__table_u8 plane = wuffs_base__pixel_buffer__plane(&pb, 0);
+
+  size_t i;
+  for (i = 0; i < num_frames; i++) {
+    gif_encoder_frame* f = &frames[i];
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_gif__decoder__decode_frame_config(&dec, &fc, &have));
+    wuffs_base__rect_ie_u32 bounds = wuffs_base__frame_config__bounds(&fc);
+    if (!wuffs_base__rect_ie_u32__equals(&bounds, f->bounds)) {
+      RETURN_FAIL("frame #%zu: bounds: have (%" PRIu32 ", %" PRIu32
+                  ")-(%" PRIu32 ", %" PRIu32 ")",
+                  i, bounds.min_incl_x, bounds.min_incl_y, bounds.max_excl_x,
+                  bounds.max_excl_y);
+    }
+    if (wuffs_base__frame_config__duration(&fc) != f->duration) {
+      RETURN_FAIL("frame #%zu: duration: have %" PRIu64 ", want %" PRIu64, i,
+                  wuffs_base__frame_config__duration(&fc), f->duration);
+    }
+    if (wuffs_base__frame_config__disposal(&fc) != f->disposal) {
+      RETURN_FAIL("frame #%zu: disposal: have %d, want %d", i,
+                  (int)(wuffs_base__frame_config__disposal(&fc)),
+                  (int)(f->disposal));
+    }
+
+    CHECK_STATUS("decode_frame",
+                 wuffs_gif__decoder__decode_frame(&dec, &pb, &have,
+                                                  WUFFS_BASE__PIXEL_BLEND__SRC,
+                                                  global_work_slice, NULL));
+
+    // The pixel buffer is indexed, so it holds the frame's pixel indexes.
+    const uint8_t* want = f->indexes.ptr;
+    uint32_t y;
+    for (y = bounds.min_incl_y; y < bounds.max_excl_y; y++) {
+      uint32_t x;
+      for (x = bounds.min_incl_x; x < bounds.max_excl_x; x++, want++) {
+        uint8_t got = plane.ptr[(y * plane.stride) + x];
+        if (got != *want) {
+          RETURN_FAIL("frame #%zu: index at (%" PRIu32 ", %" PRIu32
+                      "): have 0x%02X, want 0x%02X",
+                      i, x, y, got, *want);
+        }
+      }
+    }
+  }
+
+  wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+  wuffs_base__status status =
+      wuffs_gif__decoder__decode_frame_config(&dec, &fc, &have);
+  if (status.repr != wuffs_base__note__end_of_data) {
+    RETURN_FAIL("decode_frame_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__note__end_of_data);
+  }
+
+  // The decoder's palette should match, with any transparent entry zeroed.
+  wuffs_base__slice_u8 have_palette = wuffs_base__pixel_buffer__palette(&pb);
+  for (i = 0; i < (palette.len / 4); i++) {
+    uint32_t want =
+        wuffs_base__load_u32le__no_bounds_check(palette.ptr + 4 * i);
+    if (want < 0x80000000) {
+      want = 0;
+    }
+    uint32_t got =
+        wuffs_base__load_u32le__no_bounds_check(have_palette.ptr + 4 * i);
+    if (got != want) {
+      RETURN_FAIL("palette[%zu]: have 0x%08" PRIX32 ", want 0x%08" PRIX32, i,
+                  got, want);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_gif_encode_round_trip_bricks_dither(uint64_t wlimit,
+                                                  uint64_t rlimit) {
+  wuffs_base__io_buffer pal = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&pal, "test/data/bricks-dither.palette"));
+  wuffs_base__io_buffer ind = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&ind, "test/data/bricks-dither.indexes"));
+
+  gif_encoder_frame frames[1] = {{
+      .bounds = make_rect_ie_u32(0, 0, 160, 120),
+      .duration = 0,
+      .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      .indexes = wuffs_base__make_slice_u8(ind.data.ptr, ind.meta.wi),
+  }};
+  return do_test_wuffs_gif_encode_round_trip(
+      wuffs_base__make_slice_u8(pal.data.ptr, pal.meta.wi), 160, 120, 1, frames,
+      1, wlimit, rlimit);
+}
+
+const char*  //
+test_wuffs_gif_encode_round_trip_bricks_dither() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_encode_round_trip_bricks_dither(UINT64_MAX,
+                                                           UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_gif_encode_round_trip_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gif_encode_round_trip_bricks_dither(5, 7);
+}
+
+const char*  //
+test_wuffs_gif_encode_round_trip_animated() {
+  CHECK_FOCUS(__func__);
+
+  // Red, green, blue and (transparent) black.
+  uint8_t palette[16] = {
+      0x00, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+      0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0x00,
+  };
+  uint8_t* indexes = global_src_slice.ptr;
+  size_t n = 0;
+
+  // Like test/data/animated-red-blue.gif's frame bounds, with an assortment
+  // of durations and disposals.
+  gif_encoder_frame frames[4] = {
+      {
+          .bounds = make_rect_ie_u32(0, 0, 64, 48),
+          .duration = 10 * 7056000,
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+      {
+          .bounds = make_rect_ie_u32(15, 31, 52, 40),
+          .duration = 20 * 7056000,
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND,
+      },
+      {
+          .bounds = make_rect_ie_u32(15, 0, 64, 40),
+          .duration = 0,
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS,
+      },
+      {
+          .bounds = make_rect_ie_u32(0, 0, 0, 0),
+          .duration = 0xFFFF * (uint64_t)7056000,
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+  };
+  size_t i;
+  for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(frames); i++) {
+    uint64_t m =
+        ((uint64_t)(wuffs_base__rect_ie_u32__width(&frames[i].bounds))) *
+        ((uint64_t)(wuffs_base__rect_ie_u32__height(&frames[i].bounds)));
+    frames[i].indexes = wuffs_base__make_slice_u8(indexes + n, m);
+    uint64_t j;
+    for (j = 0; j < m; j++) {
+      indexes[n + j] = (uint8_t)((j * (i + 1) + (j / 7)) & 3);
+    }
+    n += m;
+  }
+
+  const char* status = do_test_wuffs_gif_encode_round_trip(
+      wuffs_base__make_slice_u8(palette, sizeof palette), 64, 48, 3, frames,
+      WUFFS_TESTLIB_ARRAY_SIZE(frames), UINT64_MAX, UINT64_MAX);
+  if (status) {
+    return status;
+  }
+  return do_test_wuffs_gif_encode_round_trip(
+      wuffs_base__make_slice_u8(palette, sizeof palette), 64, 48, 0, frames,
+      WUFFS_TESTLIB_ARRAY_SIZE(frames), 3, 1);
+}
+
+const char*  //
+test_wuffs_gif_encode_bad_frame_size() {
+  CHECK_FOCUS(__func__);
+  uint8_t palette[8] = {0};
+  uint8_t indexes[16] = {0};
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  int tc;
+  for (tc = 0; tc < 3; tc++) {
+    wuffs_gif__encoder enc;
+    CHECK_STATUS("initialize", wuffs_gif__encoder__initialize(
+                                   &enc, sizeof enc, WUFFS_VERSION,
+                                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+    wuffs_gif__encoder__set_palette(
+        &enc, wuffs_base__make_slice_u8(palette, sizeof palette));
+    have.meta.wi = 0;
+    CHECK_STATUS("encode_header",
+                 wuffs_gif__encoder__encode_header(&enc, &have, 4, 3));
+
+    // Test case 0 has too few pixels, 1 has too many and 2 is out of bounds.
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = wuffs_base__make_slice_u8(indexes, sizeof indexes),
+    });
+    src.meta.wi = (tc == 1) ? 13 : 11;
+    src.meta.closed = true;
+    wuffs_gif__encoder__set_frame(&enc, 0, 0, (tc == 2) ? 5 : 4,
+                                  (tc == 2) ? 2 : 3, 0, 0);
+    wuffs_base__status status =
+        wuffs_gif__encoder__encode_frame(&enc, &have, &src);
+    if (status.repr != wuffs_gif__error__bad_frame_size) {
+      RETURN_FAIL("tc=%d: have \"%s\", want \"%s\"", tc, status.repr,
+                  wuffs_gif__error__bad_frame_size);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_encode_call_sequence() {
+  CHECK_FOCUS(__func__);
+  uint8_t palette[8] = {0};
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+
+  // Errors are sticky, so each test case uses a fresh encoder. Test case 0
+  // has no palette, 1 encodes a trailer first and 2 encodes two headers.
+  int tc;
+  for (tc = 0; tc < 3; tc++) {
+    wuffs_gif__encoder enc;
+    CHECK_STATUS("initialize", wuffs_gif__encoder__initialize(
+                                   &enc, sizeof enc, WUFFS_VERSION,
+                                   WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+    if (tc != 0) {
+      wuffs_gif__encoder__set_palette(
+          &enc, wuffs_base__make_slice_u8(palette, sizeof palette));
+    }
+    have.meta.wi = 0;
+
+    const char* want = wuffs_base__error__bad_call_sequence;
+    wuffs_base__status status;
+    if (tc == 0) {
+      want = wuffs_gif__error__bad_palette;
+      status = wuffs_gif__encoder__encode_header(&enc, &have, 4, 3);
+    } else if (tc == 1) {
+      status = wuffs_gif__encoder__encode_trailer(&enc, &have);
+    } else {
+      CHECK_STATUS("encode_header",
+                   wuffs_gif__encoder__encode_header(&enc, &have, 4, 3));
+      status = wuffs_gif__encoder__encode_header(&enc, &have, 4, 3);
+    }
+    if (status.repr != want) {
+      RETURN_FAIL("tc=%d: have \"%s\", want \"%s\"", tc, status.repr, want);
+    }
+  }
+  return NULL;
+}
+
+// test_wuffs_gif_quantize_round_trip quantizes a true color (BGRA) image,
+// encodes that as a GIF and decodes that GIF, checking that the decoded
+// pixels are close to the originals.
+const char*  //
+test_wuffs_gif_quantize_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  // hibiscus.regular.gif has few enough colors that decoding it to BGRA gives
+  // a suitable test image.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hibiscus.regular.gif"));
+  wuffs_base__io_buffer bgra = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(wuffs_gif_decode(
+      &bgra, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      &src));
+  uint32_t width = wuffs_base__load_u16le__no_bounds_check(src.data.ptr + 6);
+  uint32_t height = wuffs_base__load_u16le__no_bounds_check(src.data.ptr + 8);
+  size_t n = ((size_t)width) * ((size_t)height);
+  if (bgra.meta.wi != (4 * n)) {
+    RETURN_FAIL("bgra.meta.wi: have %zu, want %zu", bgra.meta.wi, 4 * n);
+  }
+
+  // Make the top left corner transparent.
+  size_t i;
+  for (i = 0; i < 16; i++) {
+    bgra.data.ptr[(4 * i) + 3] = 0x00;
+  }
+
+  struct {
+    uint32_t max_colors;
+    uint32_t max_mean_error;
+  } test_cases[] = {
+      {.max_colors = 2, .max_mean_error = 200},
+      {.max_colors = 16, .max_mean_error = 36},
+      {.max_colors = 256, .max_mean_error = 1},
+  };
+
+  int tc;
+  for (tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    uint8_t palette[1024] = {0};
+    wuffs_base__slice_u8 indexes =
+        wuffs_base__make_slice_u8(global_src_slice.ptr, n);
+    wuffs_base__result_u64 r = wuffs_base__pixel_palette__quantize(
+        indexes, wuffs_base__make_slice_u8(palette, sizeof palette),
+        wuffs_base__make_slice_u8(bgra.data.ptr, bgra.meta.wi),
+        test_cases[tc].max_colors, global_work_slice);
+    CHECK_STATUS("quantize", r.status);
+    if ((r.value < 2) || (r.value > test_cases[tc].max_colors)) {
+      RETURN_FAIL("tc=%d: num_colors: have %" PRIu64 ", want in [2 ..= %" PRIu32
+                  "]",
+                  tc, r.value, test_cases[tc].max_colors);
+    }
+
+    uint64_t total_error = 0;
+    for (i = 0; i < n; i++) {
+      if (indexes.ptr[i] >= r.value) {
+        RETURN_FAIL("tc=%d: indexes[%zu]: have %d, want < %" PRIu64, tc, i,
+                    (int)(indexes.ptr[i]), r.value);
+      }
+      const uint8_t* p = &palette[4 * indexes.ptr[i]];
+      const uint8_t* q = &bgra.data.ptr[4 * i];
+      if ((p[3] >= 0x80) != (q[3] >= 0x80)) {
+        RETURN_FAIL("tc=%d: alpha[%zu]: have 0x%02X, want 0x%02X", tc, i, p[3],
+                    q[3]);
+      }
+      int c;
+      for (c = 0; c < 3; c++) {
+        total_error +=
+            (uint64_t)((p[c] > q[c]) ? (p[c] - q[c]) : (q[c] - p[c]));
+      }
+    }
+    if ((total_error / n) > test_cases[tc].max_mean_error) {
+      RETURN_FAIL("tc=%d: mean error: have %" PRIu64 ", want <= %" PRIu32, tc,
+                  total_error / n, test_cases[tc].max_mean_error);
+    }
+
+    gif_encoder_frame frames[1] = {{
+        .bounds = make_rect_ie_u32(0, 0, width, height),
+        .duration = 0,
+        .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+        .indexes = indexes,
+    }};
+    const char* status = do_test_wuffs_gif_encode_round_trip(
+        wuffs_base__make_slice_u8(palette, 4 * r.value), width, height, 1,
+        frames, 1, UINT64_MAX, UINT64_MAX);
+    if (status) {
+      RETURN_FAIL("tc=%d: %s", tc, status);
+    }
+  }
+  return NULL;
+}
+
+// ---------------- GIF Frame Index Tests
+
+const char*  //
+test_wuffs_gif_frame_index_build() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, "test/data/animated-red-blue.gif"));
+  size_t full_wi = src.meta.wi;
+
+  uint64_t pos_wants[4] = {781, 2126, 2187, 2542};
+  bool keyframe_wants[4] = {true, false, false, false};
+
+  // Build the index twice: with a long enough array and then with one entry
+  // too few. The first time, the source bytes arrive in 100 byte chunks, so
+  // that wuffs_base__frame_index__build is resumed after short reads.
+  int tc;
+  for (tc = 0; tc < 2; tc++) {
+    wuffs_gif__config_decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__config_decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    src.meta.ri = 0;
+    src.meta.wi = full_wi;
+    src.meta.closed = true;
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS(
+        "decode_image_config",
+        wuffs_gif__config_decoder__decode_image_config(&dec, &ic, &src));
+
+    wuffs_base__frame_index_entry entries[4] = {{0}};
+    size_t num_entries = (tc == 0) ? 4 : 3;
+    if (tc == 0) {
+      src.meta.wi = src.meta.ri;
+      src.meta.closed = false;
+    }
+    wuffs_base__result_u64 r;
+    while (true) {
+      if (!src.meta.closed) {
+        src.meta.wi = wuffs_base__u64__min(src.meta.wi + 100, full_wi);
+        src.meta.closed = src.meta.wi == full_wi;
+      }
+      r = wuffs_base__frame_index__build(
+          wuffs_gif__config_decoder__upcast_as__wuffs_base__image_decoder(&dec),
+          entries, num_entries, &src,
+          wuffs_base__pixel_config__bounds(&ic.pixcfg));
+      if (r.status.repr != wuffs_base__suspension__short_read) {
+        break;
+      }
+    }
+
+    if (tc == 1) {
+      if (r.status.repr != wuffs_base__error__bad_argument_length_too_short) {
+        RETURN_FAIL("tc=%d: status: have \"%s\", want \"%s\"", tc,
+                    r.status.repr,
+                    wuffs_base__error__bad_argument_length_too_short);
+      }
+      continue;
+    }
+    CHECK_STATUS("build", r.status);
+    if (r.value != 4) {
+      RETURN_FAIL("tc=%d: num_entries: have %" PRIu64 ", want 4", tc, r.value);
+    }
+
+    int i;
+    for (i = 0; i < 4; i++) {
+      if (entries[i].io_position != pos_wants[i]) {
+        RETURN_FAIL("tc=%d: io_position #%d: have %" PRIu64 ", want %" PRIu64,
+                    tc, i, entries[i].io_position, pos_wants[i]);
+      }
+      if (entries[i].keyframe != keyframe_wants[i]) {
+        RETURN_FAIL("tc=%d: keyframe #%d: have %d, want %d", tc, i,
+                    (int)(entries[i].keyframe), (int)(keyframe_wants[i]));
+      }
+    }
+    if (entries[1].duration != 20 * 7056000) {
+      RETURN_FAIL("tc=%d: duration #1: have %" PRIu64 ", want %" PRIu64, tc,
+                  entries[1].duration, (uint64_t)(20 * 7056000));
+    }
+    if (!wuffs_base__rect_ie_u32__equals(&entries[1].bounds,
+                                         make_rect_ie_u32(15, 31, 52, 40))) {
+      RETURN_FAIL("tc=%d: bounds #1: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                  ", %" PRIu32 ")",
+                  tc, entries[1].bounds.min_incl_x,
+                  entries[1].bounds.min_incl_y, entries[1].bounds.max_excl_x,
+                  entries[1].bounds.max_excl_y);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gif_frame_index_seek() {
+  CHECK_FOCUS(__func__);
+
+  // Red, green, blue and black, all opaque.
+  uint8_t palette[16] = {
+      0x00, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+      0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00, 0xFF,
+  };
+  uint8_t* indexes = global_want_slice.ptr;
+  size_t n = 0;
+
+  // Frames 0, 2 and 4 cover the whole image, and so are keyframes, but
+  // frame 2 restores the previous canvas and so is only usable when seeking
+  // to frame 2 itself. Frame 4 restores the background, so that frame 5 is
+  // also a keyframe.
+  gif_encoder_frame frames[7] = {
+      {
+          .bounds = make_rect_ie_u32(0, 0, 16, 12),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+      {
+          .bounds = make_rect_ie_u32(2, 3, 9, 8),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+      {
+          .bounds = make_rect_ie_u32(0, 0, 16, 12),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS,
+      },
+      {
+          .bounds = make_rect_ie_u32(4, 1, 16, 5),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+      {
+          .bounds = make_rect_ie_u32(0, 0, 16, 12),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND,
+      },
+      {
+          .bounds = make_rect_ie_u32(1, 1, 3, 3),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+      {
+          .bounds = make_rect_ie_u32(5, 6, 7, 12),
+          .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      },
+  };
+  bool keyframe_wants[7] = {true, false, true, false, true, true, false};
+  uint64_t seek_wants[7] = {0, 0, 2, 0, 4, 5, 5};
+
+  size_t i;
+  for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(frames); i++) {
+    uint64_t m =
+        ((uint64_t)(wuffs_base__rect_ie_u32__width(&frames[i].bounds))) *
+        ((uint64_t)(wuffs_base__rect_ie_u32__height(&frames[i].bounds)));
+    frames[i].duration = (i + 1) * 7056000;
+    frames[i].indexes = wuffs_base__make_slice_u8(indexes + n, m);
+    uint64_t j;
+    for (j = 0; j < m; j++) {
+      indexes[n + j] = (uint8_t)((j + i) & 3);
+    }
+    n += m;
+  }
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(
+      wuffs_gif_encode(&src, UINT64_MAX, UINT64_MAX,
+                       wuffs_base__make_slice_u8(palette, sizeof palette), 16,
+                       12, 0, frames, WUFFS_TESTLIB_ARRAY_SIZE(frames)));
+  src.meta.closed = true;
+
+  // Build the index with a config_decoder.
+  wuffs_base__frame_index_entry entries[7] = {{0}};
+  {
+    wuffs_gif__config_decoder cdec;
+    CHECK_STATUS("initialize",
+                 wuffs_gif__config_decoder__initialize(
+                     &cdec, sizeof cdec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS(
+        "decode_image_config",
+        wuffs_gif__config_decoder__decode_image_config(&cdec, &ic, &src));
+    wuffs_base__result_u64 r = wuffs_base__frame_index__build(
+        wuffs_gif__config_decoder__upcast_as__wuffs_base__image_decoder(&cdec),
+        entries, WUFFS_TESTLIB_ARRAY_SIZE(entries), &src,
+        wuffs_base__pixel_config__bounds(&ic.pixcfg));
+    CHECK_STATUS("build", r.status);
+    if (r.value != WUFFS_TESTLIB_ARRAY_SIZE(entries)) {
+      RETURN_FAIL("num_entries: have %" PRIu64 ", want %zu", r.value,
+                  WUFFS_TESTLIB_ARRAY_SIZE(entries));
+    }
+    for (i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(entries); i++) {
+      if (entries[i].keyframe != keyframe_wants[i]) {
+        RETURN_FAIL("keyframe #%zu: have %d, want %d", i,
+                    (int)(entries[i].keyframe), (int)(keyframe_wants[i]));
+      }
+    }
+  }
+
+  // Seek with a full decoder, starting from the end of the image, and decode
+  // the frames from the keyframe to the target.
+  wuffs_gif__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gif__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_decoder* idec =
+      wuffs_gif__decoder__upcast_as__wuffs_base__image_decoder(&dec);
+  src.meta.ri = 0;
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_gif__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, global_pixel_slice));
+  src.meta.ri = src.meta.wi;
+
+  int t;
+  for (t = 6; t >= 0; t--) {
+    wuffs_base__result_u64 r = wuffs_base__frame_index__seek(
+        idec, entries, WUFFS_TESTLIB_ARRAY_SIZE(entries), t, &src);
+    CHECK_STATUS("seek", r.status);
+    if (r.value != seek_wants[t]) {
+      RETURN_FAIL("seek #%d: have %" PRIu64 ", want %" PRIu64, t, r.value,
+                  seek_wants[t]);
+    }
+
+    uint64_t k;
+    for (k = r.value; k <= (uint64_t)t; k++) {
+      wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+      CHECK_STATUS("decode_frame_config",
+                   wuffs_gif__decoder__decode_frame_config(&dec, &fc, &src));
+      if (wuffs_base__frame_config__index(&fc) != k) {
+        RETURN_FAIL("seek #%d: index: have %" PRIu64 ", want %" PRIu64, t,
+                    wuffs_base__frame_config__index(&fc), k);
+      }
+      wuffs_base__rect_ie_u32 bounds = wuffs_base__frame_config__bounds(&fc);
+      if (!wuffs_base__rect_ie_u32__equals(&bounds, frames[k].bounds)) {
+        RETURN_FAIL("seek #%d: bounds #%" PRIu64 " mismatch", t, k);
+      }
+      CHECK_STATUS("decode_frame",
+                   wuffs_gif__decoder__decode_frame(
+                       &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       global_work_slice, NULL));
+    }
+  }
+
+  // Seeking past the final frame, or to a position that src does not hold,
+  // should fail.
+  wuffs_base__result_u64 r = wuffs_base__frame_index__seek(
+      idec, entries, WUFFS_TESTLIB_ARRAY_SIZE(entries), 7, &src);
+  if (r.status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("seek #7: have \"%s\", want \"%s\"", r.status.repr,
+                wuffs_base__error__bad_argument);
+  }
+  src.meta.pos = entries[6].io_position + 1;
+  r = wuffs_base__frame_index__seek(idec, entries,
+                                    WUFFS_TESTLIB_ARRAY_SIZE(entries), 6, &src);
+  if (r.status.repr != wuffs_base__error__bad_i_o_position) {
+    RETURN_FAIL("seek #6: have \"%s\", want \"%s\"", r.status.repr,
+                wuffs_base__error__bad_i_o_position);
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -2266,6 +2989,106 @@ bench_wuffs_gif_decode_anim_screencap() {
       1);
 }
 
+// do_bench_wuffs_gif_encode decodes filename, as palette indexes, and then
+// benchmarks re-encoding those indexes as a GIF.
+const char*  //
+do_bench_wuffs_gif_encode(const char* filename, uint64_t iters_unscaled) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer indexes = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  CHECK_STRING(
+      wuffs_gif_decode(&indexes, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                       wuffs_base__make_pixel_format(
+                           WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY),
+                       &src));
+  uint32_t width = wuffs_base__load_u16le__no_bounds_check(src.data.ptr + 6);
+  uint32_t height = wuffs_base__load_u16le__no_bounds_check(src.data.ptr + 8);
+
+  // The palette's colors do not affect the encoding speed.
+  uint8_t palette[1024] = {0};
+  gif_encoder_frame frames[1] = {{
+      .bounds = make_rect_ie_u32(0, 0, width, height),
+      .duration = 0,
+      .disposal = WUFFS_BASE__ANIMATION_DISPOSAL__NONE,
+      .indexes = wuffs_base__make_slice_u8(indexes.data.ptr, indexes.meta.wi),
+  }};
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    CHECK_STRING(
+        wuffs_gif_encode(&have, UINT64_MAX, UINT64_MAX,
+                         wuffs_base__make_slice_u8(palette, sizeof palette),
+                         width, height, 1, frames, 1));
+    n_bytes += indexes.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+// do_bench_wuffs_gif_quantize decodes filename, as BGRA pixels, and then
+// benchmarks quantizing those pixels to 256 colors.
+const char*  //
+do_bench_wuffs_gif_quantize(const char* filename, uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  wuffs_base__io_buffer bgra = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&src, filename));
+  CHECK_STRING(wuffs_gif_decode(
+      &bgra, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      &src));
+
+  uint8_t palette[1024];
+  wuffs_base__slice_u8 indexes = global_have_slice;
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    wuffs_base__result_u64 r = wuffs_base__pixel_palette__quantize(
+        indexes, wuffs_base__make_slice_u8(palette, sizeof palette),
+        wuffs_base__make_slice_u8(bgra.data.ptr, bgra.meta.wi), 256,
+        global_work_slice);
+    CHECK_STATUS("quantize", r.status);
+    n_bytes += bgra.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_gif_encode_20k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gif_encode("test/data/bricks-dither.gif", 50);
+}
+
+const char*  //
+bench_wuffs_gif_encode_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gif_encode("test/data/harvesters.gif", 1);
+}
+
+const char*  //
+bench_wuffs_gif_quantize_1000k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_gif_quantize("test/data/harvesters.gif", 1);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -2367,46 +3190,54 @@ proc tests[] = {
     test_basic_status_is_error,         //
     test_basic_sub_struct_initializer,  //
 
-    test_wuffs_gif_call_interleaved,                         //
-    test_wuffs_gif_call_sequence,                            //
-    test_wuffs_gif_decode_animated_big,                      //
-    test_wuffs_gif_decode_animated_medium,                   //
-    test_wuffs_gif_decode_animated_small,                    //
-    test_wuffs_gif_decode_background_color,                  //
-    test_wuffs_gif_decode_delay_num_frames_decoded,          //
-    test_wuffs_gif_decode_empty_palette,                     //
-    test_wuffs_gif_decode_first_frame_is_opaque,             //
-    test_wuffs_gif_decode_frame_out_of_bounds,               //
-    test_wuffs_gif_decode_input_is_a_gif_just_one_read,      //
-    test_wuffs_gif_decode_input_is_a_gif_many_big_reads,     //
-    test_wuffs_gif_decode_input_is_a_gif_many_medium_reads,  //
-    test_wuffs_gif_decode_input_is_a_gif_many_small_reads,   //
-    test_wuffs_gif_decode_input_is_a_png,                    //
-    test_wuffs_gif_decode_interface_image_config_decoder,    //
-    test_wuffs_gif_decode_interface_image_decoder,           //
-    test_wuffs_gif_decode_interlaced_truncated,              //
-    test_wuffs_gif_decode_metadata_empty,                    //
-    test_wuffs_gif_decode_metadata_full,                     //
-    test_wuffs_gif_decode_missing_two_src_bytes,             //
-    test_wuffs_gif_decode_multiple_graphic_controls,         //
-    test_wuffs_gif_decode_multiple_loop_counts,              //
-    test_wuffs_gif_decode_pixel_data_none,                   //
-    test_wuffs_gif_decode_pixel_data_not_enough,             //
-    test_wuffs_gif_decode_pixel_data_too_much_sans_quirk,    //
-    test_wuffs_gif_decode_pixel_data_too_much_with_quirk,    //
-    test_wuffs_gif_decode_pixfmt_bgr,                        //
-    test_wuffs_gif_decode_pixfmt_bgr_565,                    //
-    test_wuffs_gif_decode_pixfmt_bgra_nonpremul,             //
-    test_wuffs_gif_decode_pixfmt_rgb,                        //
-    test_wuffs_gif_decode_pixfmt_rgba_nonpremul,             //
-    test_wuffs_gif_decode_zero_width_frame,                  //
-    test_wuffs_gif_frame_dirty_rect,                         //
-    test_wuffs_gif_num_decoded_frame_configs,                //
-    test_wuffs_gif_num_decoded_frames,                       //
-    test_wuffs_gif_io_position_one_chunk,                    //
-    test_wuffs_gif_io_position_two_chunks,                   //
-    test_wuffs_gif_small_frame_interlaced,                   //
-    test_wuffs_gif_sizeof,                                   //
+    test_wuffs_gif_call_interleaved,                           //
+    test_wuffs_gif_call_sequence,                              //
+    test_wuffs_gif_decode_animated_big,                        //
+    test_wuffs_gif_decode_animated_medium,                     //
+    test_wuffs_gif_decode_animated_small,                      //
+    test_wuffs_gif_decode_background_color,                    //
+    test_wuffs_gif_decode_delay_num_frames_decoded,            //
+    test_wuffs_gif_decode_empty_palette,                       //
+    test_wuffs_gif_decode_first_frame_is_opaque,               //
+    test_wuffs_gif_decode_frame_out_of_bounds,                 //
+    test_wuffs_gif_decode_input_is_a_gif_just_one_read,        //
+    test_wuffs_gif_decode_input_is_a_gif_many_big_reads,       //
+    test_wuffs_gif_decode_input_is_a_gif_many_medium_reads,    //
+    test_wuffs_gif_decode_input_is_a_gif_many_small_reads,     //
+    test_wuffs_gif_decode_input_is_a_png,                      //
+    test_wuffs_gif_decode_interface_image_config_decoder,      //
+    test_wuffs_gif_decode_interface_image_decoder,             //
+    test_wuffs_gif_decode_interlaced_truncated,                //
+    test_wuffs_gif_decode_metadata_empty,                      //
+    test_wuffs_gif_decode_metadata_full,                       //
+    test_wuffs_gif_decode_missing_two_src_bytes,               //
+    test_wuffs_gif_decode_multiple_graphic_controls,           //
+    test_wuffs_gif_decode_multiple_loop_counts,                //
+    test_wuffs_gif_decode_pixel_data_none,                     //
+    test_wuffs_gif_decode_pixel_data_not_enough,               //
+    test_wuffs_gif_decode_pixel_data_too_much_sans_quirk,      //
+    test_wuffs_gif_decode_pixel_data_too_much_with_quirk,      //
+    test_wuffs_gif_decode_pixfmt_bgr,                          //
+    test_wuffs_gif_decode_pixfmt_bgr_565,                      //
+    test_wuffs_gif_decode_pixfmt_bgra_nonpremul,               //
+    test_wuffs_gif_decode_pixfmt_rgb,                          //
+    test_wuffs_gif_decode_pixfmt_rgba_nonpremul,               //
+    test_wuffs_gif_decode_zero_width_frame,                    //
+    test_wuffs_gif_encode_bad_frame_size,                      //
+    test_wuffs_gif_encode_call_sequence,                       //
+    test_wuffs_gif_encode_round_trip_animated,                 //
+    test_wuffs_gif_encode_round_trip_bricks_dither,            //
+    test_wuffs_gif_encode_round_trip_many_small_writes_reads,  //
+    test_wuffs_gif_frame_dirty_rect,                           //
+    test_wuffs_gif_frame_index_build,                          //
+    test_wuffs_gif_frame_index_seek,                           //
+    test_wuffs_gif_num_decoded_frame_configs,                  //
+    test_wuffs_gif_num_decoded_frames,                         //
+    test_wuffs_gif_io_position_one_chunk,                      //
+    test_wuffs_gif_io_position_two_chunks,                     //
+    test_wuffs_gif_quantize_round_trip,                        //
+    test_wuffs_gif_small_frame_interlaced,                     //
+    test_wuffs_gif_sizeof,                                     //
 
 #ifdef WUFFS_MIMIC
 
@@ -2443,6 +3274,9 @@ proc benches[] = {
     bench_wuffs_gif_decode_1000k_full_init,     //
     bench_wuffs_gif_decode_1000k_part_init,     //
     bench_wuffs_gif_decode_anim_screencap,      //
+    bench_wuffs_gif_encode_20k,                 //
+    bench_wuffs_gif_encode_1000k,               //
+    bench_wuffs_gif_quantize_1000k,             //
 
 #ifdef WUFFS_MIMIC
 
@@ -83,6 +83,111 @@ golden_test gzip_pi_gt = {
 
 // ---------------- Gzip Tests
 
+const char*  //
+test_wuffs_gzip_decode_bgzf() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Read romeo.txt.gz into the second half of src, skipping its 20 byte
+  // header (10 fixed bytes and a "romeo.txt" FNAME).
+  const size_t half = src.data.len / 2;
+  wuffs_base__io_buffer gz = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(src.data.ptr + half, half),
+  });
+  CHECK_STRING(read_file(&gz, "test/data/romeo.txt.gz"));
+  if ((gz.meta.wi < 20) || (gz.data.ptr[3] != 0x08)) {
+    RETURN_FAIL("unexpected romeo.txt.gz header");
+  }
+  const uint8_t* body_ptr = gz.data.ptr + 20;
+  const size_t body_len = gz.meta.wi - 20;
+
+  // Write two BGZF blocks (gzip members with a "BC" FEXTRA subfield) with
+  // that body. The first block also has an unrelated "AB" subfield.
+  size_t block_lengths[2] = {0};
+  int i;
+  for (i = 0; i < 2; i++) {
+    uint8_t header[25] = {
+        0x1F, 0x8B, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+        0x00, 0x00, 'A',  'B',  0x03, 0x00, 0x00, 0x00, 0x00,
+    };
+    size_t n = 12;
+    if (i == 0) {
+      n += 7;
+    }
+    block_lengths[i] = n + 6 + body_len;
+    header[n + 0] = 'B';
+    header[n + 1] = 'C';
+    header[n + 2] = 0x02;
+    header[n + 3] = 0x00;
+    header[n + 4] = (uint8_t)(block_lengths[i] - 1);
+    header[n + 5] = (uint8_t)((block_lengths[i] - 1) >> 8);
+    header[10] = (uint8_t)(n + 6 - 12);
+    memcpy(src.data.ptr + src.meta.wi, header, n + 6);
+    src.meta.wi += n + 6;
+    memcpy(src.data.ptr + src.meta.wi, body_ptr, body_len);
+    src.meta.wi += body_len;
+
+    want.meta.closed = false;
+    CHECK_STRING(read_file(&want, "test/data/romeo.txt"));
+  }
+  src.meta.closed = true;
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gzip__decoder__set_multi_member(&dec, true);
+  wuffs_gzip__decoder__set_report_member_boundaries(&dec, true);
+
+  wuffs_base__status status =
+      wuffs_gzip__decoder__transform_io(&dec, &have, &src, global_work_slice);
+  if (status.repr != wuffs_gzip__suspension__member_boundary) {
+    RETURN_FAIL("transform_io #0: have \"%s\", want \"%s\"", status.repr,
+                wuffs_gzip__suspension__member_boundary);
+  } else if (src.meta.ri != block_lengths[0]) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri,
+                block_lengths[0]);
+  }
+  uint32_t have_bgzf = wuffs_gzip__decoder__bgzf_block_length(&dec);
+  if (have_bgzf != block_lengths[0]) {
+    RETURN_FAIL("bgzf_block_length #0: have %" PRIu32 ", want %zu", have_bgzf,
+                block_lengths[0]);
+  }
+
+  CHECK_STATUS("transform_io #1", wuffs_gzip__decoder__transform_io(
+                                      &dec, &have, &src, global_work_slice));
+  have_bgzf = wuffs_gzip__decoder__bgzf_block_length(&dec);
+  if (have_bgzf != block_lengths[1]) {
+    RETURN_FAIL("bgzf_block_length #1: have %" PRIu32 ", want %zu", have_bgzf,
+                block_lengths[1]);
+  }
+  CHECK_STRING(check_io_buffers_equal("", &have, &want));
+
+  // A plain gzip file has no BGZF block length.
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  have.meta.wi = 0;
+  gz.meta.ri = 0;
+  CHECK_STATUS("transform_io #2", wuffs_gzip__decoder__transform_io(
+                                      &dec, &have, &gz, global_work_slice));
+  have_bgzf = wuffs_gzip__decoder__bgzf_block_length(&dec);
+  if (have_bgzf != 0) {
+    RETURN_FAIL("bgzf_block_length #2: have %" PRIu32 ", want 0", have_bgzf);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_gzip_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -97,15 +202,17 @@ test_wuffs_gzip_decode_interface() {
 }
 
 const char*  //
-wuffs_gzip_decode(wuffs_base__io_buffer* dst,
-                  wuffs_base__io_buffer* src,
-                  uint32_t wuffs_initialize_flags,
-                  uint64_t wlimit,
-                  uint64_t rlimit) {
+do_wuffs_gzip_decode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     bool fused_checksum) {
   wuffs_gzip__decoder dec;
   CHECK_STATUS("initialize",
                wuffs_gzip__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
                                                wuffs_initialize_flags));
+  wuffs_gzip__decoder__set_fused_checksum(&dec, fused_checksum);
 
   while (true) {
     wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
@@ -127,6 +234,26 @@ wuffs_gzip_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+const char*  //
+wuffs_gzip_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return do_wuffs_gzip_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              false);
+}
+
+const char*  //
+wuffs_gzip_decode_fused_checksum(wuffs_base__io_buffer* dst,
+                                 wuffs_base__io_buffer* src,
+                                 uint32_t wuffs_initialize_flags,
+                                 uint64_t wlimit,
+                                 uint64_t rlimit) {
+  return do_wuffs_gzip_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              true);
+}
+
 const char*  //
 do_test_wuffs_gzip_checksum(bool ignore_checksum, uint32_t bad_checksum) {
   wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
@@ -222,6 +349,106 @@ test_wuffs_gzip_decode_midsummer() {
                             UINT64_MAX);
 }
 
+const char*  //
+do_test_wuffs_gzip_multi_member(bool multi_member, uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Concatenate three gzip files (and their decodings), recording where each
+  // member starts.
+  const char* filenames[3][2] = {
+      {"test/data/romeo.txt.gz", "test/data/romeo.txt"},
+      {"test/data/midsummer.txt.gz", "test/data/midsummer.txt"},
+      {"test/data/romeo.txt.gz", "test/data/romeo.txt"},
+  };
+  uint64_t src_offsets[3] = {0};
+  uint64_t dst_offsets[3] = {0};
+  int i;
+  for (i = 0; i < 3; i++) {
+    src_offsets[i] = src.meta.wi;
+    dst_offsets[i] = want.meta.wi;
+    src.meta.closed = false;
+    want.meta.closed = false;
+    CHECK_STRING(read_file(&src, filenames[i][0]));
+    CHECK_STRING(read_file(&want, filenames[i][1]));
+  }
+  if (!multi_member) {
+    want.meta.wi = dst_offsets[1];
+  }
+
+  wuffs_gzip__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_gzip__decoder__set_multi_member(&dec, multi_member);
+  wuffs_gzip__decoder__set_report_member_boundaries(&dec, true);
+
+  int n_boundaries = 0;
+  while (true) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+    wuffs_base__status status = wuffs_gzip__decoder__transform_io(
+        &dec, &have, &limited_src, global_work_slice);
+    src.meta.ri += limited_src.meta.ri;
+
+    if (status.repr == wuffs_gzip__suspension__member_boundary) {
+      n_boundaries++;
+      if (n_boundaries >= 3) {
+        RETURN_FAIL("too many member boundaries");
+      } else if (src.meta.ri != src_offsets[n_boundaries]) {
+        RETURN_FAIL("boundary #%d: src position: have %zu, want %" PRIu64,
+                    n_boundaries, src.meta.ri, src_offsets[n_boundaries]);
+      } else if (have.meta.wi != dst_offsets[n_boundaries]) {
+        RETURN_FAIL("boundary #%d: dst position: have %zu, want %" PRIu64,
+                    n_boundaries, have.meta.wi, dst_offsets[n_boundaries]);
+      }
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    break;
+  }
+
+  int want_n_boundaries = multi_member ? 2 : 0;
+  if (n_boundaries != want_n_boundaries) {
+    RETURN_FAIL("member boundaries: have %d, want %d", n_boundaries,
+                want_n_boundaries);
+  }
+  uint64_t want_ri = multi_member ? src.meta.wi : src_offsets[1];
+  if (src.meta.ri != want_ri) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %" PRIu64, src.meta.ri, want_ri);
+  }
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_gzip_decode_multi_member() {
+  CHECK_FOCUS(__func__);
+  const uint64_t rlimits[3] = {UINT64_MAX, 4096, 13};
+  int i;
+  for (i = 0; i < 3; i++) {
+    const char* z = do_test_wuffs_gzip_multi_member(true, rlimits[i]);
+    if (z) {
+      RETURN_FAIL("rlimit=%" PRIu64 ": %s", rlimits[i], z);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_gzip_decode_multi_member_disabled() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_gzip_multi_member(false, UINT64_MAX);
+}
+
 const char*  //
 test_wuffs_gzip_decode_pi() {
   CHECK_FOCUS(__func__);
@@ -229,6 +456,24 @@ test_wuffs_gzip_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_gzip_decode_pi_fused_checksum() {
+  CHECK_FOCUS(__func__);
+  // The 20000 and 4096 wlimits are respectively more and less than the 16 KiB
+  // stride, so that the decoder's own "$short write"s (as it caps dst's
+  // length) mix with the test's ones.
+  const uint64_t wlimits[3] = {UINT64_MAX, 20000, 4096};
+  int i;
+  for (i = 0; i < 3; i++) {
+    const char* status = do_test_io_buffers(
+        wuffs_gzip_decode_fused_checksum, &gzip_pi_gt, wlimits[i], UINT64_MAX);
+    if (status) {
+      RETURN_FAIL("wlimit=%" PRIu64 ": %s", wlimits[i], status);
+    }
+  }
+  return NULL;
+}
+
   // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -267,6 +512,15 @@ bench_wuffs_gzip_decode_100k() {
       tcounter_dst, &gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_gzip_decode_100k_fused_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_decode_fused_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -295,13 +549,17 @@ bench_mimic_gzip_decode_100k() {
 // The empty comments forces clang-format to place one element per line.
 proc tests[] = {
 
-    test_wuffs_gzip_checksum_ignore,       //
-    test_wuffs_gzip_checksum_verify_bad0,  //
-    test_wuffs_gzip_checksum_verify_bad7,  //
-    test_wuffs_gzip_checksum_verify_good,  //
-    test_wuffs_gzip_decode_interface,      //
-    test_wuffs_gzip_decode_midsummer,      //
-    test_wuffs_gzip_decode_pi,             //
+    test_wuffs_gzip_checksum_ignore,               //
+    test_wuffs_gzip_checksum_verify_bad0,          //
+    test_wuffs_gzip_checksum_verify_bad7,          //
+    test_wuffs_gzip_checksum_verify_good,          //
+    test_wuffs_gzip_decode_bgzf,                   //
+    test_wuffs_gzip_decode_interface,              //
+    test_wuffs_gzip_decode_midsummer,              //
+    test_wuffs_gzip_decode_multi_member,           //
+    test_wuffs_gzip_decode_multi_member_disabled,  //
+    test_wuffs_gzip_decode_pi,                     //
+    test_wuffs_gzip_decode_pi_fused_checksum,      //
 
 #ifdef WUFFS_MIMIC
 
@@ -316,8 +574,9 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_gzip_decode_10k,   //
-    bench_wuffs_gzip_decode_100k,  //
+    bench_wuffs_gzip_decode_10k,                  //
+    bench_wuffs_gzip_decode_100k,                 //
+    bench_wuffs_gzip_decode_100k_fused_checksum,  //
 
 #ifdef WUFFS_MIMIC
 
@@ -382,6 +382,204 @@ test_wuffs_lzw_decode_width_1() {
   return do_test_wuffs_lzw_decode_width(1, src, want);
 }
 
+// ---------------- LZW Encoder Tests
+
+const char*  //
+test_wuffs_lzw_encode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_lzw__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__io_transformer(
+      wuffs_lzw__encoder__upcast_as__wuffs_base__io_transformer(&enc),
+      "test/data/bricks-nodither.indexes", 0, SIZE_MAX, 13393, 0x04);
+}
+
+const char*  //
+wuffs_lzw_encode(wuffs_base__io_buffer* dst,
+                 wuffs_base__io_buffer* src,
+                 uint32_t wuffs_initialize_flags,
+                 uint64_t wlimit,
+                 uint64_t rlimit,
+                 uint32_t literal_width) {
+  wuffs_lzw__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__encoder__initialize(&enc, sizeof enc, WUFFS_VERSION,
+                                              wuffs_initialize_flags));
+  wuffs_lzw__encoder__set_literal_width(&enc, literal_width);
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_lzw__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, global_work_slice);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+// do_test_wuffs_lzw_encode_round_trip encodes src, which should be closed,
+// and checks that decoding that gives src again.
+const char*  //
+do_test_wuffs_lzw_encode_round_trip(wuffs_base__io_buffer src,
+                                    uint32_t literal_width,
+                                    uint64_t wlimit,
+                                    uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+
+  CHECK_STRING(wuffs_lzw_encode(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                wlimit, rlimit, literal_width));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  have.meta.closed = true;
+
+  wuffs_lzw__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_lzw__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_lzw__decoder__set_literal_width(&dec, literal_width);
+  CHECK_STATUS("transform_io", wuffs_lzw__decoder__transform_io(
+                                   &dec, &want, &have, global_work_slice));
+  if (have.meta.ri != have.meta.wi) {
+    RETURN_FAIL("have ri: have %zu, want %zu", have.meta.ri, have.meta.wi);
+  }
+  src.meta.ri = 0;
+  return check_io_buffers_equal("", &want, &src);
+}
+
+const char*  //
+do_test_wuffs_lzw_encode_round_trip_file(const char* src_filename,
+                                         uint64_t wlimit,
+                                         uint64_t rlimit) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+  return do_test_wuffs_lzw_encode_round_trip(src, 8, wlimit, rlimit);
+}
+
+const char*  //
+test_wuffs_lzw_encode_bad_literal() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // With a literal width of 7, the 0x80 byte has no literal code.
+  src.meta.wi = 4;
+  src.meta.closed = true;
+  src.data.ptr[0] = 0x41;
+  src.data.ptr[1] = 0x42;
+  src.data.ptr[2] = 0x80;
+  src.data.ptr[3] = 0x43;
+
+  const char* have_status =
+      wuffs_lzw_encode(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                       UINT64_MAX, UINT64_MAX, 7);
+  if (have_status != wuffs_lzw__error__bad_literal) {
+    RETURN_FAIL("transform_io: have \"%s\", want \"%s\"", have_status,
+                wuffs_lzw__error__bad_literal);
+  }
+  if (src.meta.ri != 2) {
+    RETURN_FAIL("src.meta.ri: have %d, want 2", (int)(src.meta.ri));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lzw_encode_empty() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  src.meta.closed = true;
+
+  // A 9-bit clear code 0x100 and then a 9-bit end code 0x101.
+  CHECK_STRING(wuffs_lzw_encode(&have, &src, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                                UINT64_MAX, UINT64_MAX, 8));
+  if ((have.meta.wi != 3) || (have.data.ptr[0] != 0x00) ||
+      (have.data.ptr[1] != 0x03) || (have.data.ptr[2] != 0x02)) {
+    RETURN_FAIL("have: wi=%zu, want 3 bytes: 00 03 02", have.meta.wi);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_lzw_encode_round_trip_bricks_dither() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lzw_encode_round_trip_file(
+      "test/data/bricks-dither.indexes", UINT64_MAX, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_lzw_encode_round_trip_many_small_writes_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lzw_encode_round_trip_file(
+      "test/data/bricks-gray.indexes", 41, 43);
+}
+
+const char*  //
+test_wuffs_lzw_encode_round_trip_pi_one_byte_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_lzw_encode_round_trip_file("test/data/pi.txt", 1,
+                                                  UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_lzw_encode_round_trip_widths() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer pi = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+  CHECK_STRING(read_file(&pi, "test/data/pi.txt"));
+
+  // Narrow the pi digits to each literal width. The decimal digits are
+  // 0x30 ..= 0x39, so "% 10" gives 10 distinct bytes for the wider widths.
+  uint8_t narrow[4096];
+  uint32_t lw;
+  for (lw = 0; lw <= 8; lw++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = wuffs_base__make_slice_u8(narrow, sizeof narrow),
+    });
+    size_t i;
+    for (i = 0; i < sizeof narrow; i++) {
+      narrow[i] = (uint8_t)((pi.data.ptr[i] % 10) & ((1 << lw) - 1));
+    }
+    src.meta.wi = sizeof narrow;
+    src.meta.closed = true;
+    const char* status = do_test_wuffs_lzw_encode_round_trip(src, lw, 5, 7);
+    if (status) {
+      RETURN_FAIL("lw=%" PRIu32 ": %s", lw, status);
+    }
+  }
+  return NULL;
+}
+
 // ---------------- LZW Benches
 
 const char*  //
@@ -429,27 +627,97 @@ bench_wuffs_lzw_decode_20k() {
   return do_bench_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw", 50);
 }
 
+const char*  //
+bench_wuffs_lzw_decode_20k_dither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode("test/data/bricks-dither.indexes.giflzw",
+                                   50);
+}
+
+const char*  //
+bench_wuffs_lzw_decode_20k_nodither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode("test/data/bricks-nodither.indexes.giflzw",
+                                   50);
+}
+
 const char*  //
 bench_wuffs_lzw_decode_100k() {
   CHECK_FOCUS(__func__);
   return do_bench_wuffs_lzw_decode("test/data/pi.txt.giflzw", 10);
 }
 
+const char*  //
+do_bench_wuffs_lzw_encode(const char* filename, uint64_t iters_unscaled) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  CHECK_STRING(read_file(&src, filename));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t i;
+  uint64_t iters = iters_unscaled * flags.iterscale;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    src.meta.ri = 0;
+    wuffs_lzw__encoder enc;
+    CHECK_STATUS("initialize",
+                 wuffs_lzw__encoder__initialize(
+                     &enc, sizeof enc, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("transform_io", wuffs_lzw__encoder__transform_io(
+                                     &enc, &have, &src, global_work_slice));
+    n_bytes += src.meta.ri;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_lzw_encode_20k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_encode("test/data/bricks-gray.indexes", 50);
+}
+
+const char*  //
+bench_wuffs_lzw_encode_20k_dither() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_encode("test/data/bricks-dither.indexes", 50);
+}
+
+const char*  //
+bench_wuffs_lzw_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_encode("test/data/pi.txt", 10);
+}
+
 // ---------------- Manifest
 
 // The empty comments forces clang-format to place one element per line.
 proc tests[] = {
 
-    test_wuffs_lzw_decode_bricks_dither,            //
-    test_wuffs_lzw_decode_bricks_nodither,          //
-    test_wuffs_lzw_decode_interface,                //
-    test_wuffs_lzw_decode_many_big_reads,           //
-    test_wuffs_lzw_decode_many_small_writes_reads,  //
-    test_wuffs_lzw_decode_output_bad,               //
-    test_wuffs_lzw_decode_output_empty,             //
-    test_wuffs_lzw_decode_pi,                       //
-    test_wuffs_lzw_decode_width_0,                  //
-    test_wuffs_lzw_decode_width_1,                  //
+    test_wuffs_lzw_decode_bricks_dither,                       //
+    test_wuffs_lzw_decode_bricks_nodither,                     //
+    test_wuffs_lzw_decode_interface,                           //
+    test_wuffs_lzw_decode_many_big_reads,                      //
+    test_wuffs_lzw_decode_many_small_writes_reads,             //
+    test_wuffs_lzw_decode_output_bad,                          //
+    test_wuffs_lzw_decode_output_empty,                        //
+    test_wuffs_lzw_decode_pi,                                  //
+    test_wuffs_lzw_decode_width_0,                             //
+    test_wuffs_lzw_decode_width_1,                             //
+    test_wuffs_lzw_encode_bad_literal,                         //
+    test_wuffs_lzw_encode_empty,                               //
+    test_wuffs_lzw_encode_interface,                           //
+    test_wuffs_lzw_encode_round_trip_bricks_dither,            //
+    test_wuffs_lzw_encode_round_trip_many_small_writes_reads,  //
+    test_wuffs_lzw_encode_round_trip_pi_one_byte_writes,       //
+    test_wuffs_lzw_encode_round_trip_widths,                   //
 
     NULL,
 };
@@ -457,8 +725,13 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_lzw_decode_20k,   //
-    bench_wuffs_lzw_decode_100k,  //
+    bench_wuffs_lzw_decode_20k,           //
+    bench_wuffs_lzw_decode_20k_dither,    //
+    bench_wuffs_lzw_decode_20k_nodither,  //
+    bench_wuffs_lzw_decode_100k,          //
+    bench_wuffs_lzw_encode_20k,           //
+    bench_wuffs_lzw_encode_20k_dither,    //
+    bench_wuffs_lzw_encode_100k,          //
 
     NULL,
 };
@@ -92,6 +92,15 @@ const size_t zlib_sheep_dict_len = 8;
 const char* zlib_sheep_want_ptr = "Two sheep.\n";
 const size_t zlib_sheep_want_len = 11;
 
+// This zlib-encoded data is bytes 4000 to 4400 of test/data/midsummer.txt,
+// compressed (by Python's zlib module) with all of that file as a preset
+// dictionary. That dictionary's Adler-32 checksum is 0x7E98F58E.
+const char* zlib_midsummer_excerpt_src_ptr =
+    "\x78\xf9\x7e\x98\xf5\x8e\x1b\x9d\x98\x1b\x5c\x13\x73\x00\x36\x9d\x87\x4e";
+const size_t zlib_midsummer_excerpt_src_len = 18;
+const size_t zlib_midsummer_excerpt_want_offset = 4000;
+const size_t zlib_midsummer_excerpt_want_len = 400;
+
 // ---------------- Zlib Tests
 
 const char*  //
@@ -108,15 +117,17 @@ test_wuffs_zlib_decode_interface() {
 }
 
 const char*  //
-wuffs_zlib_decode(wuffs_base__io_buffer* dst,
-                  wuffs_base__io_buffer* src,
-                  uint32_t wuffs_initialize_flags,
-                  uint64_t wlimit,
-                  uint64_t rlimit) {
+do_wuffs_zlib_decode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     uint32_t wuffs_initialize_flags,
+                     uint64_t wlimit,
+                     uint64_t rlimit,
+                     bool fused_checksum) {
   wuffs_zlib__decoder dec;
   CHECK_STATUS("initialize",
                wuffs_zlib__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
                                                wuffs_initialize_flags));
+  wuffs_zlib__decoder__set_fused_checksum(&dec, fused_checksum);
 
   while (true) {
     wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
@@ -138,6 +149,26 @@ wuffs_zlib_decode(wuffs_base__io_buffer* dst,
   }
 }
 
+const char*  //
+wuffs_zlib_decode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  return do_wuffs_zlib_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              false);
+}
+
+const char*  //
+wuffs_zlib_decode_fused_checksum(wuffs_base__io_buffer* dst,
+                                 wuffs_base__io_buffer* src,
+                                 uint32_t wuffs_initialize_flags,
+                                 uint64_t wlimit,
+                                 uint64_t rlimit) {
+  return do_wuffs_zlib_decode(dst, src, wuffs_initialize_flags, wlimit, rlimit,
+                              true);
+}
+
 const char*  //
 do_test_wuffs_zlib_checksum(bool ignore_checksum, uint32_t bad_checksum) {
   wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
@@ -233,6 +264,124 @@ test_wuffs_zlib_decode_midsummer() {
                             UINT64_MAX);
 }
 
+const char*  //
+do_test_wuffs_zlib_multi_member(uint64_t rlimit) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = global_src_slice,
+  });
+
+  // Concatenate midsummer, sheep (which needs a dictionary) and pi, recording
+  // where each member starts.
+  uint64_t src_offsets[3] = {0};
+  uint64_t dst_offsets[3] = {0};
+  CHECK_STRING(read_file(&src, zlib_midsummer_gt.src_filename));
+  CHECK_STRING(read_file(&want, zlib_midsummer_gt.want_filename));
+  src_offsets[1] = src.meta.wi;
+  dst_offsets[1] = want.meta.wi;
+  if (((src.data.len - src.meta.wi) < zlib_sheep_src_len) ||
+      ((want.data.len - want.meta.wi) < zlib_sheep_want_len)) {
+    RETURN_FAIL("not enough buffer space");
+  }
+  memcpy(src.data.ptr + src.meta.wi, zlib_sheep_src_ptr, zlib_sheep_src_len);
+  src.meta.wi += zlib_sheep_src_len;
+  memcpy(want.data.ptr + want.meta.wi, zlib_sheep_want_ptr,
+         zlib_sheep_want_len);
+  want.meta.wi += zlib_sheep_want_len;
+  src_offsets[2] = src.meta.wi;
+  dst_offsets[2] = want.meta.wi;
+  src.meta.closed = false;
+  want.meta.closed = false;
+  CHECK_STRING(read_file(&src, zlib_pi_gt.src_filename));
+  CHECK_STRING(read_file(&want, zlib_pi_gt.want_filename));
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_zlib__decoder__set_multi_member(&dec, true);
+  wuffs_zlib__decoder__set_report_member_boundaries(&dec, true);
+
+  // have_offset is the number of bytes decoded before have.data.ptr.
+  uint64_t have_offset = 0;
+  int n_boundaries = 0;
+  int n_dictionaries = 0;
+  while (true) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+    wuffs_base__status status = wuffs_zlib__decoder__transform_io(
+        &dec, &have, &limited_src, global_work_slice);
+    src.meta.ri += limited_src.meta.ri;
+
+    if (status.repr == wuffs_zlib__suspension__member_boundary) {
+      n_boundaries++;
+      if (n_boundaries >= 3) {
+        RETURN_FAIL("too many member boundaries");
+      } else if (src.meta.ri != src_offsets[n_boundaries]) {
+        RETURN_FAIL("boundary #%d: src position: have %zu, want %" PRIu64,
+                    n_boundaries, src.meta.ri, src_offsets[n_boundaries]);
+      } else if ((have_offset + have.meta.wi) != dst_offsets[n_boundaries]) {
+        RETURN_FAIL("boundary #%d: dst position: have %" PRIu64
+                    ", want %" PRIu64,
+                    n_boundaries, have_offset + have.meta.wi,
+                    dst_offsets[n_boundaries]);
+      }
+      continue;
+    } else if (status.repr == wuffs_zlib__note__dictionary_required) {
+      n_dictionaries++;
+      if (n_boundaries != 1) {
+        RETURN_FAIL("dictionary required by member #%d", n_boundaries);
+      }
+      // Hide the earlier members' output, so that the decoder uses the
+      // dictionary (not those bytes) as this member's history.
+      have_offset += have.meta.wi;
+      have.data.ptr += have.meta.wi;
+      have.data.len -= have.meta.wi;
+      have.meta.wi = 0;
+      wuffs_zlib__decoder__add_dictionary(
+          &dec, ((wuffs_base__slice_u8){
+                    .ptr = ((uint8_t*)(zlib_sheep_dict_ptr)),
+                    .len = zlib_sheep_dict_len,
+                }));
+      continue;
+    } else if (status.repr == wuffs_base__suspension__short_read) {
+      continue;
+    }
+    CHECK_STATUS("transform_io", status);
+    break;
+  }
+
+  if (n_boundaries != 2) {
+    RETURN_FAIL("member boundaries: have %d, want 2", n_boundaries);
+  } else if (n_dictionaries != 1) {
+    RETURN_FAIL("dictionaries: have %d, want 1", n_dictionaries);
+  } else if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  }
+  have.data = global_have_slice;
+  have.meta.wi += have_offset;
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_zlib_decode_multi_member() {
+  CHECK_FOCUS(__func__);
+  const uint64_t rlimits[3] = {UINT64_MAX, 4096, 13};
+  int i;
+  for (i = 0; i < 3; i++) {
+    const char* z = do_test_wuffs_zlib_multi_member(rlimits[i]);
+    if (z) {
+      RETURN_FAIL("rlimit=%" PRIu64 ": %s", rlimits[i], z);
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_zlib_decode_pi() {
   CHECK_FOCUS(__func__);
@@ -240,6 +389,115 @@ test_wuffs_zlib_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_zlib_decode_pi_fused_checksum() {
+  CHECK_FOCUS(__func__);
+  // As per test_wuffs_gzip_decode_pi_fused_checksum, the wlimits straddle
+  // the 16 KiB stride.
+  const uint64_t wlimits[3] = {UINT64_MAX, 20000, 4096};
+  int i;
+  for (i = 0; i < 3; i++) {
+    const char* status = do_test_io_buffers(
+        wuffs_zlib_decode_fused_checksum, &zlib_pi_gt, wlimits[i], UINT64_MAX);
+    if (status) {
+      RETURN_FAIL("wlimit=%" PRIu64 ": %s", wlimits[i], status);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_zlib_decode_pi_fused_checksum_stride_edges() {
+  CHECK_FOCUS(__func__);
+  // The decoder caps dst's length only when dst has more room than the
+  // stride. These wlimits are just below, at and just above the stride (and
+  // twice the stride), where each DEFLATE decoder call switches between a
+  // capped dst and an uncapped one.
+  const uint64_t s = WUFFS_DEFLATE__CAPPED_DST_STRIDE;
+  const uint64_t wlimits[7] = {s - 1,       s,     s + 1,      s + 2,
+                               (2 * s) - 1, 2 * s, (2 * s) + 1};
+  int i;
+  for (i = 0; i < 7; i++) {
+    const char* status = do_test_io_buffers(
+        wuffs_zlib_decode_fused_checksum, &zlib_pi_gt, wlimits[i], UINT64_MAX);
+    if (status) {
+      RETURN_FAIL("wlimit=%" PRIu64 ": %s", wlimits[i], status);
+    }
+  }
+  return NULL;
+}
+
+// do_wuffs_zlib_decode_midsummer_excerpt decodes the midsummer excerpt,
+// adding the dictionary when asked for it, with add_dictionary_with_id if
+// dict_id is non-zero and with add_dictionary otherwise.
+const char*  //
+do_wuffs_zlib_decode_midsummer_excerpt(wuffs_base__io_buffer* have,
+                                       wuffs_base__slice_u8 dict,
+                                       uint32_t dict_id) {
+  wuffs_base__io_buffer src = make_io_buffer_from_string(
+      zlib_midsummer_excerpt_src_ptr, zlib_midsummer_excerpt_src_len);
+
+  wuffs_zlib__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__status status =
+      wuffs_zlib__decoder__transform_io(&dec, have, &src, global_work_slice);
+  if (status.repr != wuffs_zlib__note__dictionary_required) {
+    RETURN_FAIL("transform_io (before dict): have \"%s\", want \"%s\"",
+                status.repr, wuffs_zlib__note__dictionary_required);
+  }
+  if (dict_id) {
+    wuffs_zlib__decoder__add_dictionary_with_id(&dec, dict, dict_id);
+  } else {
+    wuffs_zlib__decoder__add_dictionary(&dec, dict);
+  }
+  return wuffs_zlib__decoder__transform_io(&dec, have, &src, global_work_slice)
+      .repr;
+}
+
+const char*  //
+test_wuffs_zlib_decode_prepared_dictionary() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer dict = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&dict, zlib_midsummer_gt.want_filename));
+  wuffs_base__slice_u8 dict_slice =
+      wuffs_base__make_slice_u8(dict.data.ptr, dict.meta.wi);
+
+  // Prepare the dictionary: compute its Adler-32 checksum once.
+  wuffs_adler32__hasher hasher;
+  CHECK_STATUS("initialize", wuffs_adler32__hasher__initialize(
+                                 &hasher, sizeof hasher, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  uint32_t dict_id = wuffs_adler32__hasher__update_u32(&hasher, dict_slice);
+  if (dict_id != 0x7E98F58E) {
+    RETURN_FAIL("dict_id: have 0x%08" PRIX32 ", want 0x7E98F58E", dict_id);
+  }
+
+  CHECK_STRING(
+      do_wuffs_zlib_decode_midsummer_excerpt(&have, dict_slice, dict_id));
+  wuffs_base__io_buffer want = make_io_buffer_from_string(
+      (const char*)(dict.data.ptr + zlib_midsummer_excerpt_want_offset),
+      zlib_midsummer_excerpt_want_len);
+  CHECK_STRING(check_io_buffers_equal("", &have, &want));
+
+  // A wrong id is rejected, as for a wrong dictionary.
+  have.meta.wi = 0;
+  const char* have_z =
+      do_wuffs_zlib_decode_midsummer_excerpt(&have, dict_slice, dict_id + 1);
+  if (have_z != wuffs_zlib__error__incorrect_dictionary) {
+    RETURN_FAIL("wrong id: have \"%s\", want \"%s\"", have_z,
+                wuffs_zlib__error__incorrect_dictionary);
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_zlib_decode_sheep() {
   CHECK_FOCUS(__func__);
@@ -346,6 +604,54 @@ bench_wuffs_zlib_decode_100k() {
       tcounter_dst, &zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_zlib_decode_100k_fused_checksum() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_decode_fused_checksum,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_dst,
+      &zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+do_bench_wuffs_zlib_decode_dictionary(bool prepared) {
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = global_have_slice,
+  });
+  wuffs_base__io_buffer dict = ((wuffs_base__io_buffer){
+      .data = global_want_slice,
+  });
+  CHECK_STRING(read_file(&dict, zlib_midsummer_gt.want_filename));
+  wuffs_base__slice_u8 dict_slice =
+      wuffs_base__make_slice_u8(dict.data.ptr, dict.meta.wi);
+  uint32_t dict_id = prepared ? 0x7E98F58E : 0;
+
+  uint64_t n_bytes = 0;
+  uint64_t iters = 1000 * flags.iterscale;
+  bench_start();
+  uint64_t i;
+  for (i = 0; i < iters; i++) {
+    have.meta.wi = 0;
+    CHECK_STRING(
+        do_wuffs_zlib_decode_midsummer_excerpt(&have, dict_slice, dict_id));
+    n_bytes += have.meta.wi;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_zlib_decode_dictionary_hashed() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_zlib_decode_dictionary(false);
+}
+
+const char*  //
+bench_wuffs_zlib_decode_dictionary_prepared() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_zlib_decode_dictionary(true);
+}
+
   // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -371,14 +677,18 @@ bench_mimic_zlib_decode_100k() {
 // The empty comments forces clang-format to place one element per line.
 proc tests[] = {
 
-    test_wuffs_zlib_checksum_ignore,       //
-    test_wuffs_zlib_checksum_verify_bad0,  //
-    test_wuffs_zlib_checksum_verify_bad3,  //
-    test_wuffs_zlib_checksum_verify_good,  //
-    test_wuffs_zlib_decode_interface,      //
-    test_wuffs_zlib_decode_midsummer,      //
-    test_wuffs_zlib_decode_pi,             //
-    test_wuffs_zlib_decode_sheep,          //
+    test_wuffs_zlib_checksum_ignore,                        //
+    test_wuffs_zlib_checksum_verify_bad0,                   //
+    test_wuffs_zlib_checksum_verify_bad3,                   //
+    test_wuffs_zlib_checksum_verify_good,                   //
+    test_wuffs_zlib_decode_interface,                       //
+    test_wuffs_zlib_decode_midsummer,                       //
+    test_wuffs_zlib_decode_multi_member,                    //
+    test_wuffs_zlib_decode_pi,                              //
+    test_wuffs_zlib_decode_pi_fused_checksum,               //
+    test_wuffs_zlib_decode_pi_fused_checksum_stride_edges,  //
+    test_wuffs_zlib_decode_prepared_dictionary,             //
+    test_wuffs_zlib_decode_sheep,                           //
 
 #ifdef WUFFS_MIMIC
 
@@ -394,8 +704,11 @@ proc tests[] = {
 // The empty comments forces clang-format to place one element per line.
 proc benches[] = {
 
-    bench_wuffs_zlib_decode_10k,   //
-    bench_wuffs_zlib_decode_100k,  //
+    bench_wuffs_zlib_decode_10k,                  //
+    bench_wuffs_zlib_decode_100k,                 //
+    bench_wuffs_zlib_decode_100k_fused_checksum,  //
+    bench_wuffs_zlib_decode_dictionary_hashed,    //
+    bench_wuffs_zlib_decode_dictionary_prepared,  //
 
 #ifdef WUFFS_MIMIC
 
@@ -342,6 +342,29 @@ bench_finish(uint64_t iters, uint64_t n_bytes) {
   fflush(stdout);
 }
 
+// set_cpu_arch_portable sets whether to force Wuffs' portable code paths, even
+// if the CPU supports faster (e.g. SIMD) code paths. Tests and benchmarks can
+// then exercise both code paths on the same machine.
+void  //
+set_cpu_arch_portable(bool portable) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  wuffs_base__cpu_arch__x86_features =
+      portable ? WUFFS_BASE__CPU_ARCH__X86__CHECKED : 0;
+#endif
+}
+
+// set_cpu_arch_x86_avoid forces Wuffs to avoid the given x86 features (a
+// bitmask of WUFFS_BASE__CPU_ARCH__X86__ETC values), even if the CPU supports
+// them, so that tests can exercise the intermediate (e.g. SSSE3 instead of
+// AVX2) code paths. Call set_cpu_arch_portable(false) to undo this.
+void  //
+set_cpu_arch_x86_avoid(uint32_t features) {
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  wuffs_base__cpu_arch__x86_features =
+      wuffs_base__cpu_arch__x86_features_check() & ~features;
+#endif
+}
+
 const char*  //
 chdir_to_the_wuffs_root_directory() {
   // Chdir to the Wuffs root directory, assuming that we're starting from